@@ -28,6 +28,195 @@
 #include <JuceHeader.h>
 #include <mutex>
 
+//==============================================================================
+/*  Measures how many synth voices a single core can render in real time, with and
+    without batched voice rendering.
+
+    The voices are simple sine oscillators. When rendered one at a time, each one runs
+    a short serial loop per sub-block. When rendered as a batch, the state of all the
+    voices is kept in a structure-of-arrays layout and the oscillators are advanced
+    together, a fixed number of lanes at a time, which the compiler turns into SIMD
+    operations.
+*/
+struct SynthesiserBenchmark
+{
+    struct Sound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    class Voice final : public SynthesiserVoice
+    {
+    public:
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            const auto angle = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+            rotationCos = (float) std::cos (angle);
+            rotationSin = (float) std::sin (angle);
+            sinValue = 0.0f;
+            cosValue = 1.0f;
+            gain = 0.02f * velocity;
+        }
+
+        void stopNote (float, bool) override
+        {
+            clearCurrentNote();
+        }
+
+        void pitchWheelMoved (int) override {}
+        void controllerMoved (int, int) override {}
+
+        using SynthesiserVoice::renderNextBlock;
+        using SynthesiserVoice::renderVoiceBatch;
+
+        void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            if (! isVoiceActive())
+                return;
+
+            auto* left  = output.getWritePointer (0, startSample);
+            auto* right = output.getWritePointer (1, startSample);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto sample = sinValue * gain;
+                left[i]  += sample;
+                right[i] += sample;
+
+                const auto newSin = sinValue * rotationCos + cosValue * rotationSin;
+                cosValue = cosValue * rotationCos - sinValue * rotationSin;
+                sinValue = newSin;
+            }
+        }
+
+        bool renderVoiceBatch (Span<SynthesiserVoice* const> group,
+                               AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            auto* left  = output.getWritePointer (0, startSample);
+            auto* right = output.getWritePointer (1, startSample);
+
+            for (size_t first = 0; first < group.size(); first += numLanes)
+            {
+                const auto numVoices = jmin (numLanes, group.size() - first);
+
+                alignas (32) float sinValues[numLanes] {}, cosValues[numLanes] {},
+                                   rotationCosines[numLanes] {}, rotationSines[numLanes] {}, gains[numLanes] {};
+
+                for (size_t lane = 0; lane < numVoices; ++lane)
+                {
+                    auto& voice = *static_cast<Voice*> (group[first + lane]);
+                    sinValues[lane]       = voice.sinValue;
+                    cosValues[lane]       = voice.cosValue;
+                    rotationCosines[lane] = voice.rotationCos;
+                    rotationSines[lane]   = voice.rotationSin;
+                    gains[lane]           = voice.gain;
+                }
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    alignas (32) float samples[numLanes];
+
+                    for (size_t lane = 0; lane < numLanes; ++lane)
+                    {
+                        samples[lane] = sinValues[lane] * gains[lane];
+
+                        const auto newSin = sinValues[lane] * rotationCosines[lane] + cosValues[lane] * rotationSines[lane];
+                        cosValues[lane] = cosValues[lane] * rotationCosines[lane] - sinValues[lane] * rotationSines[lane];
+                        sinValues[lane] = newSin;
+                    }
+
+                    auto sum = 0.0f;
+
+                    for (auto sample : samples)
+                        sum += sample;
+
+                    left[i]  += sum;
+                    right[i] += sum;
+                }
+
+                for (size_t lane = 0; lane < numVoices; ++lane)
+                {
+                    auto& voice = *static_cast<Voice*> (group[first + lane]);
+                    voice.sinValue = sinValues[lane];
+                    voice.cosValue = cosValues[lane];
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        static constexpr size_t numLanes = 8;
+
+        float rotationCos = 1.0f, rotationSin = 0.0f, sinValue = 0.0f, cosValue = 1.0f, gain = 0.0f;
+    };
+
+    /*  Renders a few seconds of audio with every voice playing, and a note change every
+        32 samples, returning the number of voices that could be rendered in real time.
+    */
+    static double measureVoicesPerCore (bool useBatches, int minimumSubBlockSize)
+    {
+        constexpr int numVoices = 64;
+        constexpr int blockSize = 512;
+        constexpr int numBlocks = 400;
+        constexpr double sampleRate = 44100.0;
+
+        Synthesiser synth;
+        synth.addSound (new Sound());
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new Voice());
+
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+        synth.setNoteStealingEnabled (true);
+        synth.setBatchedVoiceRenderingEnabled (useBatches);
+        synth.setMinimumRenderingSubdivisionSize (minimumSubBlockSize, true);
+
+        AudioBuffer<float> output (2, blockSize);
+        MidiBuffer midi;
+
+        for (int i = 0; i < numVoices; ++i)
+            midi.addEvent (MidiMessage::noteOn (1, 30 + i, 0.8f), 0);
+
+        synth.renderNextBlock (output, midi, 0, blockSize);
+
+        int nextNote = 0;
+        double seconds = 0.0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            midi.clear();
+
+            for (int pos = 0; pos < blockSize; pos += 32, ++nextNote)
+            {
+                midi.addEvent (MidiMessage::noteOff (1, 30 + (nextNote % numVoices)), pos);
+                midi.addEvent (MidiMessage::noteOn  (1, 30 + (nextNote % numVoices), 0.8f), pos);
+            }
+
+            output.clear();
+
+            const auto start = Time::getHighResolutionTicks();
+            synth.renderNextBlock (output, midi, 0, blockSize);
+            seconds += Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+        }
+
+        const auto audioSeconds = numBlocks * blockSize / sampleRate;
+        return numVoices * audioSeconds / jmax (seconds, 1.0e-9);
+    }
+
+    static void run()
+    {
+        Logger::writeToLog ("Synthesiser voices / core, 64 voices with a note change every 32 samples:");
+        Logger::writeToLog ("  rendered individually:                     " + String (measureVoicesPerCore (false, 32), 0));
+        Logger::writeToLog ("  rendered in batches:                       " + String (measureVoicesPerCore (true, 32), 0));
+        Logger::writeToLog ("  rendered in batches, 64 sample sub-blocks: " + String (measureVoicesPerCore (true, 64), 0));
+        Logger::writeToLog ("");
+    }
+};
+
 //==============================================================================
 class MainContentComponent final : public AudioAppComponent,
                                    private Timer
@@ -36,6 +225,8 @@ public:
     //==============================================================================
     MainContentComponent()
     {
+        SynthesiserBenchmark::run();
+
         setSize (400, 400);
         setAudioChannels (0, 2);
 
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include "Benchmark.h"
+
+//==============================================================================
+/*  These use whichever instruction set FloatVectorOperations picks for this CPU, and compare
+    it with a plain loop doing the same work.
+*/
+class FloatVectorOperationsBenchmark final : public Benchmark
+{
+public:
+    FloatVectorOperationsBenchmark() : Benchmark ("FloatVectorOperations") {}
+
+    void run() override
+    {
+        constexpr int numSamples = 4096, numIterations = 2000;
+        Random random (1234);
+
+        HeapBlock<float> src1 (numSamples), src2 (numSamples), dest (numSamples);
+        HeapBlock<int> ints (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            src1[i] = random.nextFloat();
+            src2[i] = random.nextFloat();
+            dest[i] = random.nextFloat();
+            ints[i] = random.nextInt();
+        }
+
+        struct Operation
+        {
+            const char* name;
+            std::function<void()> vectorised, loop;
+        };
+
+        const Operation operations[]
+        {
+            { "add",
+              [&] { FloatVectorOperations::add (dest, src1, numSamples); },
+              [&] { for (int i = 0; i < numSamples; ++i) dest[i] += src1[i]; } },
+
+            { "multiply",
+              [&] { FloatVectorOperations::multiply (dest, src1, src2, numSamples); },
+              [&] { for (int i = 0; i < numSamples; ++i) dest[i] = src1[i] * src2[i]; } },
+
+            { "addWithMultiply",
+              [&] { FloatVectorOperations::addWithMultiply (dest, src1, 0.5f, numSamples); },
+              [&] { for (int i = 0; i < numSamples; ++i) dest[i] += src1[i] * 0.5f; } },
+
+            { "clip",
+              [&] { FloatVectorOperations::clip (dest, src1, 0.2f, 0.8f, numSamples); },
+              [&] { for (int i = 0; i < numSamples; ++i) dest[i] = jlimit (0.2f, 0.8f, src1[i]); } },
+
+            { "findMinAndMax",
+              [&] { dest[0] = FloatVectorOperations::findMinAndMax (src1, numSamples).getLength(); },
+              [&] { dest[0] = Range<float>::findMinAndMax (src1.get(), numSamples).getLength(); } },
+
+            { "convertFixedToFloat",
+              [&] { FloatVectorOperations::convertFixedToFloat (dest, ints, 0.001f, numSamples); },
+              [&] { for (int i = 0; i < numSamples; ++i) dest[i] = (float) ints[i] * 0.001f; } }
+        };
+
+        const auto megasamplesPerSecond = [&] (const std::function<void()>& fn)
+        {
+            return (double) numSamples / (timeInMilliseconds (numIterations, fn) * 1000.0);
+        };
+
+        for (const auto& op : operations)
+            log (String (op.name).paddedRight (' ', 20)
+                   + "loop: " + String (roundToInt (megasamplesPerSecond (op.loop))) + " Msamples/s   "
+                   + "vectorised: " + String (roundToInt (megasamplesPerSecond (op.vectorised))) + " Msamples/s");
+    }
+};
+
+static FloatVectorOperationsBenchmark floatVectorOperationsBenchmark;
+
+//==============================================================================
+class AudioDataConvertersBenchmark final : public Benchmark
+{
+public:
+    AudioDataConvertersBenchmark() : Benchmark ("AudioDataConverters") {}
+
+    void run() override
+    {
+        constexpr int numSamples = 1021, numIterations = 2000;
+        Random random (1234);
+
+        HeapBlock<float> source (numSamples), floats (numSamples);
+        HeapBlock<int16> shorts (numSamples);
+        HeapBlock<int32> ints (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            source[i] = random.nextFloat() * 2.4f - 1.2f;
+            shorts[i] = (int16) random.nextInt();
+        }
+
+        JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
+        JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
+
+        const std::pair<const char*, std::function<void()>> conversions[]
+        {
+            { "Float to Int16LE", [&] { AudioDataConverters::convertFloatToInt16LE (source, shorts, numSamples); } },
+            { "Float to Int32LE", [&] { AudioDataConverters::convertFloatToInt32LE (source, ints, numSamples); } },
+            { "Int16LE to Float", [&] { AudioDataConverters::convertInt16LEToFloat (shorts, floats, numSamples); } }
+        };
+
+        JUCE_END_IGNORE_WARNINGS_MSVC
+        JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+
+        for (const auto& [conversionName, convert] : conversions)
+            log (String (conversionName).paddedRight (' ', 20)
+                   + String (roundToInt ((double) numSamples / (timeInMilliseconds (numIterations, convert) * 1000.0))) + " Msamples/s");
+    }
+};
+
+static AudioDataConvertersBenchmark audioDataConvertersBenchmark;
+
+//==============================================================================
+/*  Merges one block of MPE data from 15 member channels, then walks through it one sample
+    at a time, the way a synth's render loop would.
+*/
+class MidiEventBufferBenchmark final : public Benchmark
+{
+public:
+    MidiEventBufferBenchmark() : Benchmark ("MidiEventBuffer") {}
+
+    static Array<Array<MidiMessage>> createMPEStreams (int numChannels, int blockSize, int interval)
+    {
+        Array<Array<MidiMessage>> streams;
+
+        for (int channel = 2; channel < numChannels + 2; ++channel)
+        {
+            Array<MidiMessage> stream;
+            stream.add (MidiMessage::noteOn (channel, 48 + channel, (uint8) 100));
+
+            for (int time = channel % interval; time < blockSize; time += interval)
+            {
+                stream.add (MidiMessage::pitchWheel (channel, 8192 + time).withTimeStamp (time));
+                stream.add (MidiMessage::channelPressureChange (channel, time % 128).withTimeStamp (time));
+                stream.add (MidiMessage::controllerEvent (channel, 74, time % 128).withTimeStamp (time));
+            }
+
+            streams.add (stream);
+        }
+
+        return streams;
+    }
+
+    void run() override
+    {
+        constexpr int blockSize = 512, numBlocks = 200;
+        const auto streams = createMPEStreams (15, blockSize, 4);
+
+        int totalEvents = 0;
+
+        for (auto& stream : streams)
+            totalEvents += stream.size();
+
+        MidiBuffer midiBuffer;
+        midiBuffer.ensureSize ((size_t) totalEvents * 16);
+        MidiEventBuffer eventBuffer (totalEvents);
+
+        int midiBufferSum = 0, eventBufferSum = 0;
+
+        const auto midiBufferTime = timeInMilliseconds (numBlocks, [&]
+        {
+            midiBuffer.clear();
+
+            for (auto& stream : streams)
+                for (auto& m : stream)
+                    midiBuffer.addEvent (m, (int) m.getTimeStamp());
+
+            for (int sample = 0; sample < blockSize; ++sample)
+                for (auto i = midiBuffer.findNextSamplePosition (sample); i != midiBuffer.cend() && (*i).samplePosition == sample; ++i)
+                    midiBufferSum += (*i).data[0];
+        });
+
+        const auto eventBufferTime = timeInMilliseconds (numBlocks, [&]
+        {
+            eventBuffer.clear();
+
+            for (auto& stream : streams)
+                for (auto& m : stream)
+                    eventBuffer.addEvent (m, (int) m.getTimeStamp());
+
+            for (int sample = 0; sample < blockSize; ++sample)
+                for (const auto metadata : eventBuffer.getEventsInRange (sample, 1))
+                    eventBufferSum += metadata.data[0];
+        });
+
+        jassert (midiBufferSum == eventBufferSum);
+
+        log ("Merging and reading " + String (totalEvents) + " MPE events per block:");
+        log ("    MidiBuffer: " + String (midiBufferTime, 3) + " ms");
+        log ("    MidiEventBuffer: " + String (eventBufferTime, 3) + " ms");
+    }
+};
+
+static MidiEventBufferBenchmark midiEventBufferBenchmark;
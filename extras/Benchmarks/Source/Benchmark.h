@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  A timing measurement that's too slow, or depends too much on the machine it's
+    running on, to be part of the unit tests.
+
+    Each benchmark registers itself when it's created, in the same way as a UnitTest,
+    and logs its results rather than passing or failing.
+*/
+class Benchmark
+{
+public:
+    explicit Benchmark (String nameIn) : name (std::move (nameIn))
+    {
+        getAllBenchmarks().add (this);
+    }
+
+    virtual ~Benchmark()
+    {
+        getAllBenchmarks().removeFirstMatchingValue (this);
+    }
+
+    /*  Runs the benchmark, and logs what it measured. */
+    virtual void run() = 0;
+
+    const String& getName() const noexcept      { return name; }
+
+    static Array<Benchmark*>& getAllBenchmarks()
+    {
+        static Array<Benchmark*> benchmarks;
+        return benchmarks;
+    }
+
+protected:
+    static void log (const String& message)
+    {
+        Logger::writeToLog (message);
+    }
+
+    /*  Returns the average time taken to call a function, in milliseconds. */
+    template <typename Fn>
+    static double timeInMilliseconds (int numRepeats, Fn&& fn)
+    {
+        const auto start = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numRepeats; ++i)
+            fn();
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0 / numRepeats;
+    }
+
+private:
+    String name;
+
+    JUCE_DECLARE_NON_COPYABLE (Benchmark)
+};
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include "Benchmark.h"
+
+//==============================================================================
+class ConvolutionBenchmark final : public Benchmark
+{
+public:
+    ConvolutionBenchmark() : Benchmark ("Convolution") {}
+
+    void run() override
+    {
+        const dsp::ProcessSpec spec { 44100.0, 64, 2 };
+        Random random (1234);
+
+        AudioBuffer<float> ir (2, 2 * (int) spec.sampleRate);
+
+        for (auto channel = 0; channel != ir.getNumChannels(); ++channel)
+            for (auto sample = 0; sample != ir.getNumSamples(); ++sample)
+                ir.setSample (channel, sample, (random.nextFloat() * 2.0f - 1.0f) * std::exp ((float) -sample / 20000.0f));
+
+        dsp::Convolution uniform (dsp::Convolution::Latency { 0 });
+        dsp::Convolution staged (dsp::Convolution::NonUniform { 256, 16384 });
+
+        for (auto* convolution : { &uniform, &staged })
+        {
+            auto copiedIr = ir;
+            convolution->loadImpulseResponse (std::move (copiedIr),
+                                              spec.sampleRate,
+                                              dsp::Convolution::Stereo::yes,
+                                              dsp::Convolution::Trim::no,
+                                              dsp::Convolution::Normalise::yes);
+            convolution->prepare (spec);
+        }
+
+        AudioBuffer<float> buffer (2, (int) spec.maximumBlockSize);
+        const auto numBlocks = 3 * ir.getNumSamples() / (int) spec.maximumBlockSize;
+
+        const auto timeProcessing = [&] (dsp::Convolution& convolution)
+        {
+            return timeInMilliseconds (1, [&]
+            {
+                for (auto i = 0; i < numBlocks; ++i)
+                {
+                    for (auto channel = 0; channel != buffer.getNumChannels(); ++channel)
+                        for (auto sample = 0; sample != buffer.getNumSamples(); ++sample)
+                            buffer.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+                    dsp::AudioBlock<float> block (buffer);
+                    convolution.process (dsp::ProcessContextReplacing<float> (block));
+                }
+            });
+        };
+
+        const auto uniformTime = timeProcessing (uniform);
+        const auto stagedTime = timeProcessing (staged);
+
+        log ("Time spent processing a " + String (ir.getNumSamples()) + " sample IR in "
+             + String (spec.maximumBlockSize) + " sample blocks:");
+        log ("    Uniform:                        " + String (uniformTime, 1) + " ms");
+        log ("    Non-uniform, background stages: " + String (stagedTime, 1) + " ms");
+    }
+};
+
+static ConvolutionBenchmark convolutionBenchmark;
+
+//==============================================================================
+class FFTBenchmark final : public Benchmark
+{
+public:
+    FFTBenchmark() : Benchmark ("FFT") {}
+
+    void run() override
+    {
+        Random random (378272);
+
+        for (auto order : { 9, 11, 13 })
+        {
+            const auto size = 1 << order;
+            const auto numIterations = (1 << 22) >> order;
+
+            dsp::FFT fft (order);
+            HeapBlock<float> data (2 * (size_t) size);
+
+            for (int i = 0; i < 2 * size; ++i)
+                data[i] = random.nextFloat() * 2.0f - 1.0f;
+
+            const auto milliseconds = timeInMilliseconds (numIterations, [&]
+            {
+                fft.performRealOnlyForwardTransform (data, true);
+                fft.performRealOnlyInverseTransform (data);
+            });
+
+            log (String (size).paddedRight (' ', 6) + ": " + String (milliseconds * 1000.0, 2)
+                   + " us for a real-only forward and inverse transform");
+        }
+    }
+};
+
+static FFTBenchmark fftBenchmark;
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include "Benchmark.h"
+
+//==============================================================================
+class FlacMemoryMappedReaderBenchmark final : public Benchmark
+{
+public:
+    FlacMemoryMappedReaderBenchmark() : Benchmark ("FLAC memory-mapped reader") {}
+
+    void run() override
+    {
+        FlacAudioFormat format;
+        TemporaryFile tempFile (".flac");
+        Random random (1234);
+
+        AudioBuffer<float> original (2, 10 * 44100);
+
+        for (int channel = 0; channel < original.getNumChannels(); ++channel)
+            for (int sample = 0; sample < original.getNumSamples(); ++sample)
+                original.setSample (channel, sample, 0.5f * std::sin ((float) sample * 0.01f * (float) (channel + 1))
+                                                       + 0.1f * (random.nextFloat() - 0.5f));
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (tempFile.getFile().createOutputStream().release(),
+                                                                               44100.0, 2, 16, {}, 0));
+            writer->writeFromAudioSampleBuffer (original, 0, original.getNumSamples());
+        }
+
+        const auto timeToOpen = [&]
+        {
+            return timeInMilliseconds (1, [&]
+            {
+                std::unique_ptr<AudioFormatReader> reader (format.createMemoryMappedReader (tempFile.getFile()));
+            });
+        };
+
+        FlacAudioFormat::clearSeekIndexCache();
+        const auto withoutIndex = timeToOpen();
+        const auto withIndex = timeToOpen();
+
+        log ("Time to open a " + String (original.getNumSamples()) + " sample memory-mapped FLAC file:");
+        log ("    Building seek index:  " + String (withoutIndex, 2) + " ms");
+        log ("    Using cached index:   " + String (withIndex, 2) + " ms");
+
+        constexpr auto numReads = 2000;
+        constexpr auto samplesPerRead = 256;
+
+        AudioBuffer<float> destination (2, samplesPerRead);
+        std::vector<int64> positions;
+
+        for (int i = 0; i < numReads; ++i)
+            positions.push_back (random.nextInt (original.getNumSamples() - samplesPerRead));
+
+        const auto timeReads = [&] (AudioFormatReader& reader)
+        {
+            return timeInMilliseconds (1, [&]
+            {
+                for (auto pos : positions)
+                    reader.read (&destination, 0, samplesPerRead, pos, true, true);
+            });
+        };
+
+        std::unique_ptr<AudioFormatReader> streamReader (format.createReaderFor (tempFile.getFile().createInputStream().release(), true));
+        std::unique_ptr<AudioFormatReader> mappedReader (format.createMemoryMappedReader (tempFile.getFile()));
+
+        const auto streamTime = timeReads (*streamReader);
+        const auto mappedTime = timeReads (*mappedReader);
+
+        log (String (numReads) + " reads of " + String (samplesPerRead) + " samples at random positions:");
+        log ("    Stream reader:         " + String (streamTime, 1) + " ms");
+        log ("    Memory-mapped reader:  " + String (mappedTime, 1) + " ms");
+    }
+};
+
+static FlacMemoryMappedReaderBenchmark flacMemoryMappedReaderBenchmark;
+
+//==============================================================================
+class AudioFormatReaderPipelineBenchmark final : public Benchmark
+{
+public:
+    AudioFormatReaderPipelineBenchmark() : Benchmark ("AudioFormatReaderPipeline") {}
+
+    void run() override
+    {
+        constexpr auto numFiles = 32;
+        constexpr auto numThreads = 4;
+
+        FlacAudioFormat flac;
+        Random random (1234);
+        std::vector<MemoryBlock> flacFiles;
+
+        for (int i = 0; i < numFiles; ++i)
+        {
+            AudioBuffer<float> audio (1 + (i % 2), 20000 + random.nextInt (30000));
+
+            for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+                for (int sample = 0; sample < audio.getNumSamples(); ++sample)
+                    audio.setSample (channel, sample, (float) random.nextInt ({ -32768, 32768 }) / 32768.0f);
+
+            auto& file = flacFiles.emplace_back();
+            std::unique_ptr<AudioFormatWriter> writer (flac.createWriterFor (new MemoryOutputStream (file, false),
+                                                                             44100.0, (unsigned int) audio.getNumChannels(), 16, {}, 0));
+            writer->writeFromAudioSampleBuffer (audio, 0, audio.getNumSamples());
+        }
+
+        const auto createStreams = [&]
+        {
+            std::vector<std::unique_ptr<InputStream>> result;
+
+            for (auto& file : flacFiles)
+                result.push_back (std::make_unique<MemoryInputStream> (file, false));
+
+            return result;
+        };
+
+        AudioFormatManager manager;
+        manager.registerBasicFormats();
+
+        AudioBuffer<float> destination;
+        int64 numSamples = 0;
+
+        const auto serialTime = timeInMilliseconds (1, [&]
+        {
+            for (auto& file : createStreams())
+            {
+                std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (std::move (file)));
+
+                for (int64 pos = 0; pos < reader->lengthInSamples; pos += destination.getNumSamples())
+                {
+                    const auto numToRead = (int) jmin ((int64) 8192, reader->lengthInSamples - pos);
+                    destination.setSize ((int) reader->numChannels, numToRead, false, false, true);
+                    reader->read (&destination, 0, numToRead, pos, true, true);
+                    numSamples += numToRead;
+                }
+            }
+        });
+
+        const auto pipelineTime = timeInMilliseconds (1, [&]
+        {
+            AudioFormatReaderPipeline pipeline (manager,
+                                                createStreams(),
+                                                AudioFormatReaderPipeline::Options{}.withNumberOfThreads (numThreads));
+
+            for (int i = 0; i < pipeline.getNumSources(); ++i)
+                while (pipeline.readNextBlock (i, destination) > 0) {}
+        });
+
+        log ("Decoded " + String (numFiles) + " FLAC files (" + String (numSamples) + " samples):");
+        log ("    One by one:                  " + String (serialTime, 1) + " ms");
+        log ("    Pipeline with " + String (numThreads) + " threads:     " + String (pipelineTime, 1) + " ms");
+    }
+};
+
+static AudioFormatReaderPipelineBenchmark audioFormatReaderPipelineBenchmark;
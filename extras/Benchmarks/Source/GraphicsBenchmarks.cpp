@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+//==============================================================================
+/*  Draws something like a busy plugin editor, with gradients, paths, images, text
+    and a transparency layer.
+*/
+static void drawGraphicsBenchmarkScene (Graphics& g, int width, int height, const Image& sprite)
+{
+    const auto w = (float) width, h = (float) height;
+
+    g.fillAll (Colours::darkgrey);
+
+    g.setGradientFill (ColourGradient (Colours::yellow, 0.0f, 0.0f, Colours::purple.withAlpha (0.5f), w, h, false));
+    g.fillRect (Rectangle<float> (w * 0.1f, h * 0.1f, w * 0.5f, h * 0.6f));
+
+    g.setGradientFill (ColourGradient (Colours::white, w * 0.5f, h * 0.5f, Colours::transparentBlack, w * 0.8f, h * 0.5f, true));
+    g.fillEllipse (w * 0.3f, h * 0.2f, w * 0.5f, h * 0.6f);
+
+    Path star;
+    star.addStar ({ w * 0.7f, h * 0.3f }, 7, h * 0.1f, h * 0.25f, 0.3f);
+
+    g.setColour (Colours::orange.withAlpha (0.7f));
+    g.fillPath (star);
+    g.setColour (Colours::black);
+    g.strokePath (star, PathStrokeType (3.5f));
+
+    for (int i = 0; i < 40; ++i)
+    {
+        g.setColour (Colour::fromHSV ((float) i / 40.0f, 0.8f, 0.9f, 0.6f));
+        g.drawLine (0.0f, (float) i * h / 40.0f, w, h - (float) i * h / 40.0f, 1.3f);
+    }
+
+    {
+        Graphics::ScopedSaveState save (g);
+        g.reduceClipRegion (Rectangle<int> (width / 8, height / 2, width / 2, height / 3));
+        g.setTiledImageFill (sprite, 3, 5, 0.9f);
+        g.fillAll();
+    }
+
+    g.drawImageTransformed (sprite, AffineTransform::rotation (-0.7f).scaled (2.5f).translated (w * 0.7f, h * 0.8f));
+    g.drawImageAt (sprite, width / 3, height / 7);
+
+    {
+        Graphics::ScopedSaveState save (g);
+        g.beginTransparencyLayer (0.6f);
+        g.setColour (Colours::cyan);
+        g.fillRoundedRectangle (w * 0.2f, h * 0.4f, w * 0.6f, h * 0.3f, 10.0f);
+        g.endTransparencyLayer();
+    }
+
+    g.setColour (Colours::white);
+    g.setFont (h / 12.0f);
+    g.drawText ("The quick brown fox jumps over the lazy dog", 0, height / 20, width, height / 10, Justification::centred);
+}
+
+static Image createGraphicsBenchmarkSprite()
+{
+    Image sprite (Image::ARGB, 37, 29, true);
+    Graphics g (sprite);
+    g.setGradientFill (ColourGradient (Colours::red.withAlpha (0.8f), 0.0f, 0.0f,
+                                       Colours::blue.withAlpha (0.3f), 37.0f, 29.0f, false));
+    g.fillEllipse (sprite.getBounds().toFloat());
+    return sprite;
+}
+
+//==============================================================================
+class TiledSoftwareRendererBenchmark final : public Benchmark
+{
+public:
+    TiledSoftwareRendererBenchmark() : Benchmark ("LowLevelGraphicsTiledSoftwareRenderer") {}
+
+    void run() override
+    {
+        // The speed-up depends on how many CPUs there are, so this also shows the overhead
+        // of replaying the drawing for a fixed number of bands
+        for (auto numBands : { 0, 4 })
+        {
+            measure (800, 600, numBands);
+            measure (1920, 1080, numBands);
+            measure (3840, 2160, numBands);
+        }
+    }
+
+private:
+    static void measure (int width, int height, int numBandsToUse)
+    {
+        constexpr int numRepeats = 5;
+
+        const auto sprite = createGraphicsBenchmarkSprite();
+        Image image (Image::ARGB, width, height, true, SoftwareImageType());
+        int numBands = 0;
+
+        const auto serial = timeInMilliseconds (numRepeats, [&]
+        {
+            Graphics g (image);
+            drawGraphicsBenchmarkScene (g, width, height, sprite);
+        });
+
+        const auto tiled = timeInMilliseconds (numRepeats, [&]
+        {
+            LowLevelGraphicsTiledSoftwareRenderer context (image, numBandsToUse);
+            numBands = context.getNumBands();
+            Graphics g (context);
+            drawGraphicsBenchmarkScene (g, width, height, sprite);
+        });
+
+        log ("    " + String (width) + "x" + String (height) + ": " + String (serial, 2) + " ms -> "
+               + String (tiled, 2) + " ms with " + String (numBands) + " bands (" + String (serial / tiled, 1) + "x)");
+    }
+};
+
+static TiledSoftwareRendererBenchmark tiledSoftwareRendererBenchmark;
+
+//==============================================================================
+class GraphicsDisplayListBenchmark final : public Benchmark
+{
+public:
+    GraphicsDisplayListBenchmark() : Benchmark ("GraphicsDisplayList") {}
+
+    void run() override
+    {
+        constexpr int width = 300, height = 200, numRepeats = 200;
+
+        const auto sprite = createGraphicsBenchmarkSprite();
+        Image image (Image::ARGB, width, height, true, SoftwareImageType());
+        GraphicsDisplayList list;
+
+        const auto painting = timeInMilliseconds (numRepeats, [&]
+        {
+            Graphics g (image);
+            drawGraphicsBenchmarkScene (g, width, height, sprite);
+        });
+
+        const auto recording = timeInMilliseconds (numRepeats, [&]
+        {
+            auto context = list.createRecordingContext ({ width, height });
+            Graphics g (*context);
+            drawGraphicsBenchmarkScene (g, width, height, sprite);
+        });
+
+        const auto replaying = timeInMilliseconds (numRepeats, [&]
+        {
+            LowLevelGraphicsSoftwareRenderer context (image);
+            list.replay (context);
+        });
+
+        log ("    Painting: " + String (painting * 1000.0, 1) + " us, recording: " + String (recording * 1000.0, 1)
+               + " us, replaying: " + String (replaying * 1000.0, 1) + " us (" + String (painting / replaying, 1) + "x)");
+    }
+};
+
+static GraphicsDisplayListBenchmark graphicsDisplayListBenchmark;
+
+//==============================================================================
+class PixelSpansBenchmark final : public Benchmark
+{
+public:
+    PixelSpansBenchmark() : Benchmark ("RenderingHelpers::PixelSpans") {}
+
+    void run() override
+    {
+        Random r (1234);
+        run<PixelARGB> (r, "ARGB");
+        run<PixelRGB> (r, "RGB");
+        run<PixelAlpha> (r, "Alpha");
+    }
+
+private:
+    static PixelARGB createPixel (Random& r)
+    {
+        const auto alpha = (uint8) jlimit (0, 255, r.nextInt (300) - 20);
+        PixelARGB p (alpha, (uint8) r.nextInt (256), (uint8) r.nextInt (256), (uint8) r.nextInt (256));
+        p.premultiply();
+        return p;
+    }
+
+    template <class PixelType>
+    static std::vector<PixelType> createPixels (Random& r, int num)
+    {
+        std::vector<PixelType> pixels ((size_t) num);
+
+        for (auto& p : pixels)
+            p.set (createPixel (r));
+
+        return pixels;
+    }
+
+    template <class DestPixelType>
+    static void run (Random& r, const String& formatName)
+    {
+        using namespace RenderingHelpers;
+
+        // A span about as wide as a typical window
+        constexpr int numPixels = 1024, numRepeats = 2000;
+        const auto src = createPixels<PixelARGB> (r, numPixels);
+        auto dest = createPixels<DestPixelType> (r, numPixels);
+        auto colour = createPixel (r);
+        colour.setAlpha (0x80);
+
+        const auto nanosecondsPerPixel = [] (auto&& fn)
+        {
+            return timeInMilliseconds (numRepeats, fn) * 1.0e6 / numPixels;
+        };
+
+        const auto logResult = [&formatName] (const char* what, double scalar, double vectorised)
+        {
+            log (formatName + " " + what + ": " + String (scalar, 3) + " ns/pixel -> "
+                   + String (vectorised, 3) + " ns/pixel (" + String (scalar / vectorised, 1) + "x)");
+        };
+
+        logResult ("solid colour",
+                   nanosecondsPerPixel ([&] { for (auto& d : dest) d.blend (colour); }),
+                   nanosecondsPerPixel ([&] { PixelSpans::blendSolid (dest.data(), colour, numPixels); }));
+
+        logResult ("image",
+                   nanosecondsPerPixel ([&] { for (int i = 0; i < numPixels; ++i) dest[(size_t) i].blend (src[(size_t) i]); }),
+                   nanosecondsPerPixel ([&] { PixelSpans::blend (dest.data(), src.data(), numPixels); }));
+
+        logResult ("image with opacity",
+                   nanosecondsPerPixel ([&] { for (int i = 0; i < numPixels; ++i) dest[(size_t) i].blend (src[(size_t) i], 0x80); }),
+                   nanosecondsPerPixel ([&] { PixelSpans::blend (dest.data(), src.data(), numPixels, 0x80); }));
+    }
+};
+
+static PixelSpansBenchmark pixelSpansBenchmark;
+
+//==============================================================================
+class GlyphCacheBenchmark final : public Benchmark
+{
+public:
+    GlyphCacheBenchmark() : Benchmark ("RenderingHelpers::GlyphCache") {}
+
+    // Stands in for a real glyph type, so that only the cache lookups are measured
+    struct Glyph final : public ReferenceCountedObject
+    {
+        void draw (int&, Point<float>) const {}
+        void generate (const Font& newFont, int glyphNumber)  { font = newFont; glyph = glyphNumber; }
+
+        Font font;
+        int glyph = 0, lastAccessCount = 0;
+    };
+
+    void run() override
+    {
+        // Roughly what a mixer window full of labels and meters draws per repaint
+        constexpr int numRepaints = 200, glyphsPerRepaint = 5000;
+
+        const Font fonts[] { Font ("Test A", 12.0f, Font::plain),
+                             Font ("Test A", 13.0f, Font::plain),
+                             Font ("Test A", 12.0f, Font::bold),
+                             Font ("Test B", 12.0f, Font::plain),
+                             Font ("Test B", 12.0f, Font::plain).withHorizontalScale (0.8f) };
+
+        RenderingHelpers::GlyphCache<Glyph, int> cache;
+        Random r (1);
+
+        const auto repaintTime = timeInMilliseconds (numRepaints, [&]
+        {
+            for (int i = 0; i < glyphsPerRepaint; ++i)
+                cache.findOrCreateGlyph (fonts[i % numElementsInArray (fonts)], 32 + r.nextInt (95));
+        });
+
+        const auto stats = cache.getStatistics();
+
+        log (String (stats.numGlyphs) + " glyphs cached, hit rate " + String (stats.getHitRate() * 100.0, 2) + "%, "
+               + String (repaintTime * 1.0e6 / glyphsPerRepaint, 1) + " ns per lookup");
+    }
+};
+
+static GlyphCacheBenchmark glyphCacheBenchmark;
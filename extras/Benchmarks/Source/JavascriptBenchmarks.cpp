@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+//==============================================================================
+class JavascriptEngineBenchmark final : public Benchmark
+{
+public:
+    JavascriptEngineBenchmark() : Benchmark ("JavascriptEngine") {}
+
+    struct Script
+    {
+        const char* name;
+        const char* setup;
+        const char* expression;
+        var expectedResult;
+    };
+
+    static std::vector<Script> getScripts()
+    {
+        return {
+            { "Arithmetic loop",
+              "function run() { var total = 0; for (var i = 0; i < 200000; ++i) total += (i * 3) % 7; return total; }",
+              "run()", 600000 },
+
+            { "Floating point",
+              "function run() { var x = 0.5, total = 0.0; for (var i = 0; i < 100000; ++i) { x = x * 3.7 * (1.0 - x); total += x; } return total > 0; }",
+              "run()", true },
+
+            { "Function calls",
+              "function add (a, b) { return a + b; }"
+              "function run() { var total = 0; for (var i = 0; i < 50000; ++i) total = add (total, i); return total; }",
+              "run()", (int64) 1249975000 },
+
+            { "Recursion",
+              "function fib (n) { return n < 2 ? n : fib (n - 1) + fib (n - 2); }",
+              "fib (20)", 6765 },
+
+            { "Property access",
+              "function run() { var o = { x: 0, y: 2 }; for (var i = 0; i < 50000; ++i) o.x = o.x + o.y; return o.x; }",
+              "run()", 100000 },
+
+            { "Method calls",
+              "function Counter() { this.count = 0; this.add = function (n) { this.count = this.count + n; }; }"
+              "function run() { var c = new Counter(); for (var i = 0; i < 50000; ++i) c.add (2); return c.count; }",
+              "run()", 100000 },
+
+            { "Array access",
+              "function run() { var a = []; for (var i = 0; i < 10000; ++i) a.push (i);"
+              "  var total = 0; for (var j = 0; j < 5; ++j) for (var i = 0; i < a.length; ++i) total += a[i]; return total; }",
+              "run()", 249975000 },
+
+            { "Global variables",
+              "var counter = 0; function bump() { counter = counter + 1; }"
+              "function run() { counter = 0; for (var i = 0; i < 50000; ++i) bump(); return counter; }",
+              "run()", 50000 },
+
+            { "MIDI transform",
+              "function transform (e) { var n = e.note + 12; if (n > 127) n = 127;"
+              "  return { note: n, velocity: Math.min (127, e.velocity * 1.5), channel: e.channel }; }"
+              "function run() { var events = []; for (var i = 0; i < 256; ++i) events.push ({ note: i % 128, velocity: i % 100, channel: 1 });"
+              "  var total = 0; for (var pass = 0; pass < 40; ++pass) for (var i = 0; i < events.length; ++i) { var t = transform (events[i]); total += t.note; }"
+              "  return total; }",
+              "run()", 766880 },
+
+            { "String building",
+              "function run() { var s = \"\"; for (var i = 0; i < 5000; ++i) s = s + \"ab\"; return s.length; }",
+              "run()", 10000 }
+        };
+    }
+
+    void run() override
+    {
+        constexpr int numRepeats = 5;
+
+        for (auto& script : getScripts())
+        {
+            JavascriptEngine engine;
+            engine.maximumExecutionTime = RelativeTime::seconds (60);
+
+            if (engine.execute (script.setup).failed())
+            {
+                log ("    " + String (script.name) + ": setup failed");
+                continue;
+            }
+
+            var value;
+            Result result (Result::ok());
+
+            const auto time = timeInMilliseconds (numRepeats, [&]
+            {
+                value = engine.evaluate (script.expression, &result);
+            });
+
+            if (result.failed() || value != script.expectedResult)
+            {
+                log ("    " + String (script.name) + ": wrong result " + value.toString() + " " + result.getErrorMessage());
+                continue;
+            }
+
+            log ("    " + String (script.name).paddedRight (' ', 20) + String (time, 2) + " ms");
+        }
+    }
+};
+
+static JavascriptEngineBenchmark javascriptEngineBenchmark;
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+//==============================================================================
+class IdentifierBenchmark final : public Benchmark
+{
+public:
+    IdentifierBenchmark() : Benchmark ("Identifier") {}
+
+    void run() override
+    {
+        constexpr int numNames = 500;
+        constexpr int numRepeats = 200;
+
+        StringArray names;
+
+        for (int i = 0; i < numNames; ++i)
+            names.add ("benchmarkProperty" + String (i));
+
+        log ("Creating Identifiers from " + String (numNames) + " names, on several threads at once:");
+
+        for (auto numThreads : { 1, 4, 16 })
+        {
+            std::vector<std::thread> threads;
+            const auto start = Time::getHighResolutionTicks();
+
+            for (int t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back ([&names]
+                {
+                    for (int r = 0; r < numRepeats; ++r)
+                        for (auto& n : names)
+                            ignoreUnused (Identifier (n));
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+
+            const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+            const auto numLookups = (double) numThreads * numRepeats * numNames;
+
+            log ("    " + String (numThreads) + " threads: "
+                   + String (numLookups / seconds / 1.0e6, 2) + " million per second");
+        }
+    }
+};
+
+static IdentifierBenchmark identifierBenchmark;
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include "Benchmark.h"
+
+//==============================================================================
+class TaskSchedulerBenchmark final : public Benchmark
+{
+public:
+    TaskSchedulerBenchmark() : Benchmark ("TaskScheduler") {}
+
+    void run() override
+    {
+        constexpr auto numJobs = 100000;
+        constexpr auto numThreads = 4;
+        std::atomic<int> count { 0 };
+
+        const auto schedulerTime = [&]
+        {
+            TaskScheduler scheduler (TaskScheduler::Options{}.withNumberOfThreads (numThreads));
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            TaskScheduler::TaskGroup group (scheduler);
+
+            for (int i = 0; i < numJobs; ++i)
+                group.run ([&count] { count.fetch_add (1, std::memory_order_relaxed); });
+
+            group.wait();
+            return Time::getMillisecondCounterHiRes() - start;
+        }();
+
+        count = 0;
+
+        const auto threadPoolTime = [&]
+        {
+            ThreadPool pool (ThreadPoolOptions{}.withNumberOfThreads (numThreads));
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numJobs; ++i)
+                pool.addJob ([&count] { count.fetch_add (1, std::memory_order_relaxed); });
+
+            while (pool.getNumJobs() > 0)
+                Thread::yield();
+
+            return Time::getMillisecondCounterHiRes() - start;
+        }();
+
+        log ("Ran " + String (numJobs) + " tiny jobs on " + String (numThreads) + " threads:");
+        log ("    TaskScheduler: " + String (schedulerTime, 1) + " ms");
+        log ("    ThreadPool:    " + String (threadPoolTime, 1) + " ms");
+    }
+};
+
+static TaskSchedulerBenchmark taskSchedulerBenchmark;
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+//==============================================================================
+class ValueTreeArchiveBenchmark final : public Benchmark
+{
+public:
+    ValueTreeArchiveBenchmark() : Benchmark ("ValueTreeArchive") {}
+
+    static ValueTree createLargeTree (int numNodes)
+    {
+        ValueTree root ("STATE");
+
+        for (int i = 0; i < numNodes; ++i)
+        {
+            ValueTree node ("PARAMETER");
+            node.setProperty ("id", "parameter" + String (i), nullptr);
+            node.setProperty ("value", i * 0.001, nullptr);
+            node.setProperty ("index", i, nullptr);
+            node.setProperty ("automatable", (i & 1) != 0, nullptr);
+
+            ValueTree mapping ("MAPPING");
+            mapping.setProperty ("channel", i % 16, nullptr);
+            mapping.setProperty ("controller", i % 128, nullptr);
+            node.appendChild (mapping, nullptr);
+
+            root.appendChild (node, nullptr);
+        }
+
+        return root;
+    }
+
+    static MemoryBlock writeArchive (const ValueTree& tree, const ValueTreeArchive::Options& options)
+    {
+        MemoryOutputStream mo;
+        ValueTreeArchive::write (tree, mo, options);
+        return mo.getMemoryBlock();
+    }
+
+    void run() override
+    {
+        constexpr int numNodes = 20000;
+        constexpr int numRepeats = 5;
+        const auto tree = createLargeTree (numNodes);
+        const auto compressed = ValueTreeArchive::Options{}.withCompression (true);
+
+        MemoryOutputStream binary, xml;
+        tree.writeToStream (binary);
+        tree.createXml()->writeTo (xml);
+        const auto archive = writeArchive (tree, {});
+        const auto zipped = writeArchive (tree, compressed);
+
+        const auto report = [] (const String& format, size_t numBytes, double writeTime, double readTime)
+        {
+            log ("    " + format + ": " + String ((double) numBytes / 1024.0, 1) + " KB, written in "
+                   + String (writeTime, 2) + " ms, read in " + String (readTime, 2) + " ms");
+        };
+
+        log ("Writing and reading a tree with " + String (numNodes) + " nodes:");
+
+        report ("writeToStream",
+                binary.getDataSize(),
+                timeInMilliseconds (numRepeats, [&] { MemoryOutputStream mo; tree.writeToStream (mo); }),
+                timeInMilliseconds (numRepeats, [&] { ignoreUnused (ValueTree::readFromData (binary.getData(), binary.getDataSize())); }));
+
+        report ("XML",
+                xml.getDataSize(),
+                timeInMilliseconds (numRepeats, [&] { MemoryOutputStream mo; tree.createXml()->writeTo (mo); }),
+                timeInMilliseconds (numRepeats, [&] { ignoreUnused (ValueTree::fromXml (xml.toString())); }));
+
+        report ("ValueTreeArchive",
+                archive.getSize(),
+                timeInMilliseconds (numRepeats, [&] { ignoreUnused (writeArchive (tree, {})); }),
+                timeInMilliseconds (numRepeats, [&] { ignoreUnused (ValueTreeArchive::readFromData (archive.getData(), archive.getSize())); }));
+
+        report ("ValueTreeArchive (compressed)",
+                zipped.getSize(),
+                timeInMilliseconds (numRepeats, [&] { ignoreUnused (writeArchive (tree, compressed)); }),
+                timeInMilliseconds (numRepeats, [&] { ignoreUnused (ValueTreeArchive::readFromData (zipped.getData(), zipped.getSize())); }));
+
+        const auto lookupTime = timeInMilliseconds (numRepeats, [&]
+        {
+            ValueTreeArchive a (archive.getData(), archive.getSize());
+            ignoreUnused (a.getRoot().getChild (12345).createValueTree());
+        });
+
+        log ("Opening an archive and reading one subtree: " + String (lookupTime, 3) + " ms");
+    }
+};
+
+static ValueTreeArchiveBenchmark valueTreeArchiveBenchmark;
+
+//==============================================================================
+class ValueTreeSnapshotBenchmark final : public Benchmark
+{
+public:
+    ValueTreeSnapshotBenchmark() : Benchmark ("ValueTreeSnapshot") {}
+
+    void run() override
+    {
+        constexpr int numGroups = 100;
+        constexpr int numParametersPerGroup = 100;
+        constexpr int numRepeats = 100;
+
+        ValueTree tree ("Root");
+
+        for (int i = 0; i < numGroups; ++i)
+        {
+            ValueTree group ("Group");
+
+            for (int j = 0; j < numParametersPerGroup; ++j)
+                group.appendChild (ValueTree ("Parameter", { { "id", "p" + String (i * numParametersPerGroup + j) }, { "value", 0.5 } }), nullptr);
+
+            tree.appendChild (group, nullptr);
+        }
+
+        ValueTreeSnapshotPublisher publisher (tree);
+        publisher.setPublishesAutomatically (false);
+
+        int edit = 0;
+
+        const auto publishTime = timeInMilliseconds (numRepeats, [&]
+        {
+            ++edit;
+            tree.getChild (edit % numGroups).getChild (edit % numParametersPerGroup).setProperty ("value", edit, nullptr);
+            ignoreUnused (publisher.publish());
+        });
+
+        const auto copyTime = timeInMilliseconds (numRepeats, [&]
+        {
+            ++edit;
+            tree.getChild (edit % numGroups).getChild (edit % numParametersPerGroup).setProperty ("value", edit, nullptr);
+            ignoreUnused (tree.createCopy());
+        });
+
+        log ("Publishing a tree with " + String (numGroups * numParametersPerGroup) + " nodes after one edit:");
+        log ("    ValueTreeSnapshotPublisher::publish: " + String (publishTime, 4) + " ms");
+        log ("    ValueTree::createCopy: " + String (copyTime, 4) + " ms");
+    }
+};
+
+static ValueTreeSnapshotBenchmark valueTreeSnapshotBenchmark;
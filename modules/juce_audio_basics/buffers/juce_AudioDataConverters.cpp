@@ -33,7 +33,10 @@ void AudioDataConverters::convertFloatToInt16LE (const float* source, void* dest
 
     if (dest != (void*) source || destBytesPerSample <= 4)
     {
-        for (int i = 0; i < numSamples; ++i)
+        auto i = destBytesPerSample == 2 ? FloatVectorHelpers::convertFloatToInt16 (source, dest, numSamples, maxVal) : 0;
+        intData += i * destBytesPerSample;
+
+        for (; i < numSamples; ++i)
         {
             *unalignedPointerCast<uint16*> (intData) = ByteOrder::swapIfBigEndian ((uint16) (short) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
             intData += destBytesPerSample;
@@ -133,7 +136,10 @@ void AudioDataConverters::convertFloatToInt32LE (const float* source, void* dest
 
     if (dest != (void*) source || destBytesPerSample <= 4)
     {
-        for (int i = 0; i < numSamples; ++i)
+        auto i = destBytesPerSample == 4 ? FloatVectorHelpers::convertFloatToInt32 (source, dest, numSamples, maxVal) : 0;
+        intData += i * destBytesPerSample;
+
+        for (; i < numSamples; ++i)
         {
             *unalignedPointerCast<uint32*> (intData) = ByteOrder::swapIfBigEndian ((uint32) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
             intData += destBytesPerSample;
@@ -220,7 +226,10 @@ void AudioDataConverters::convertInt16LEToFloat (const void* source, float* dest
 
     if (source != (void*) dest || srcBytesPerSample >= 4)
     {
-        for (int i = 0; i < numSamples; ++i)
+        auto i = srcBytesPerSample == 2 ? FloatVectorHelpers::convertInt16ToFloat (source, dest, numSamples, scale) : 0;
+        intData += i * srcBytesPerSample;
+
+        for (; i < numSamples; ++i)
         {
             dest[i] = scale * (short) ByteOrder::swapIfBigEndian (*unalignedPointerCast<const uint16*> (intData));
             intData += srcBytesPerSample;
@@ -622,6 +631,50 @@ public:
                 for (int i = 0; i < numSamples; ++i)
                     expectEquals (sourceBuffer.getSample (0, ch + (i * numChannels)), destBuffer.getSample (ch, i));
         }
+
+        beginTest ("Vectorised conversions match on every instruction set");
+        {
+            constexpr auto numSamples = 1021;
+
+            HeapBlock<float> source (numSamples);
+            HeapBlock<int16> shorts (numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                source[i] = r.nextFloat() * 2.4f - 1.2f;
+                shorts[i] = (int16) r.nextInt();
+            }
+
+            const auto convertAll = [&]
+            {
+                MemoryBlock result (numSamples * (4 + 4 + 4 + 2));
+                auto* floats  = static_cast<float*> (result.getData());
+                auto* inPlace = floats + numSamples;
+                auto* int32s  = inPlace + numSamples;
+                auto* int16s  = int32s + numSamples;
+
+                AudioDataConverters::convertFloatToInt16LE (source, int16s, numSamples);
+                AudioDataConverters::convertFloatToInt32LE (source, int32s, numSamples);
+                AudioDataConverters::convertInt16LEToFloat (shorts, floats, numSamples);
+
+                std::copy (source.get(), source.get() + numSamples, inPlace);
+                AudioDataConverters::convertFloatToInt16LE (inPlace, inPlace, numSamples);
+
+                return result;
+            };
+
+            const auto expected = [&]
+            {
+                const FloatVectorHelpers::ScopedInstructionSet scope (FloatVectorHelpers::InstructionSet::sse);
+                return convertAll();
+            }();
+
+            for (auto set : FloatVectorHelpers::getAvailableInstructionSets())
+            {
+                const FloatVectorHelpers::ScopedInstructionSet scope (set);
+                expect (convertAll() == expected, FloatVectorHelpers::getInstructionSetName (set));
+            }
+        }
     }
 };
 
@@ -25,9 +25,9 @@ namespace juce
 
 namespace FloatVectorHelpers
 {
-    #define JUCE_INCREMENT_SRC_DEST         dest += (16 / sizeof (*dest)); src += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += (16 / sizeof (*dest)); src1 += (16 / sizeof (*dest)); src2 += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_DEST             dest += (16 / sizeof (*dest));
+    #define JUCE_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+    #define JUCE_INCREMENT_DEST             dest += Mode::numParallel;
 
    #if JUCE_USE_SSE_INTRINSICS
     static bool isAligned (const void* p) noexcept
@@ -63,6 +63,8 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm_or_ps (a, b); }
         static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm_xor_ps (a, b); }
 
+        static forcedinline ParallelType convertIntsU (const int* v) noexcept           { return _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (v))); }
+
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
     };
@@ -102,7 +104,7 @@ namespace FloatVectorHelpers
 
 
     #define JUCE_BEGIN_VEC_OP \
-        using Mode = FloatVectorHelpers::ModeType<sizeof(*dest)>::Mode; \
+        using Mode = ModeType<sizeof(*dest)>::Mode; \
         { \
             const auto numLongOps = num / Mode::numParallel;
 
@@ -115,21 +117,21 @@ namespace FloatVectorHelpers
     #define JUCE_PERFORM_VEC_OP_DEST(normalOp, vecOp, locals, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest))   JUCE_VEC_LOOP (vecOp, dummy, Mode::loadA, Mode::storeA, locals, JUCE_INCREMENT_DEST) \
+        if (isAligned (dest))   JUCE_VEC_LOOP (vecOp, dummy, Mode::loadA, Mode::storeA, locals, JUCE_INCREMENT_DEST) \
         else                                        JUCE_VEC_LOOP (vecOp, dummy, Mode::loadU, Mode::storeU, locals, JUCE_INCREMENT_DEST) \
         JUCE_FINISH_VEC_OP (normalOp)
 
     #define JUCE_PERFORM_VEC_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest)) \
+        if (isAligned (dest)) \
         { \
-            if (FloatVectorHelpers::isAligned (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+            if (isAligned (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
             else                                     JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
         }\
         else \
         { \
-            if (FloatVectorHelpers::isAligned (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
+            if (isAligned (src)) JUCE_VEC_LOOP (vecOp, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
             else                                     JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
         } \
         JUCE_FINISH_VEC_OP (normalOp)
@@ -137,29 +139,29 @@ namespace FloatVectorHelpers
     #define JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest)) \
+        if (isAligned (dest)) \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (isAligned (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadU, Mode::storeA, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeA, locals, increment) \
             } \
         } \
         else \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (isAligned (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeU, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadA, Mode::storeU, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeU, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadA, Mode::storeU, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
             } \
         } \
@@ -168,29 +170,29 @@ namespace FloatVectorHelpers
     #define JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
-        if (FloatVectorHelpers::isAligned (dest)) \
+        if (isAligned (dest)) \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (isAligned (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadA, Mode::storeA, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadA, Mode::storeA, locals, increment) \
             } \
         } \
         else \
         { \
-            if (FloatVectorHelpers::isAligned (src1)) \
+            if (isAligned (src1)) \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadA, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
             } \
             else \
             { \
-                if (FloatVectorHelpers::isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
+                if (isAligned (src2))   JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadA, Mode::loadU, Mode::storeU, locals, increment) \
                 else                                        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
             } \
         } \
@@ -265,7 +267,7 @@ namespace FloatVectorHelpers
     };
 
     #define JUCE_BEGIN_VEC_OP \
-        using Mode = FloatVectorHelpers::ModeType<sizeof(*dest)>::Mode; \
+        using Mode = ModeType<sizeof(*dest)>::Mode; \
         if (Mode::numParallel > 1) \
         { \
             const auto numLongOps = num / Mode::numParallel;
@@ -355,820 +357,397 @@ namespace FloatVectorHelpers
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
     template <>             struct ModeType<8> { using Mode = BasicOps64; };
-
-    template <typename Mode>
-    struct MinMax
-    {
-        using Type = typename Mode::Type;
-        using ParallelType = typename Mode::ParallelType;
-
-        template <typename Size>
-        static Type findMinOrMax (const Type* src, Size num, const bool isMinimum) noexcept
-        {
-            auto numLongOps = num / Mode::numParallel;
-
-            if (numLongOps > 1)
-            {
-                ParallelType val;
-
-               #if ! JUCE_USE_ARM_NEON
-                if (isAligned (src))
-                {
-                    val = Mode::loadA (src);
-
-                    if (isMinimum)
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::min (val, Mode::loadA (src));
-                        }
-                    }
-                    else
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::max (val, Mode::loadA (src));
-                        }
-                    }
-                }
-                else
-               #endif
-                {
-                    val = Mode::loadU (src);
-
-                    if (isMinimum)
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::min (val, Mode::loadU (src));
-                        }
-                    }
-                    else
-                    {
-                        while (--numLongOps > 0)
-                        {
-                            src += Mode::numParallel;
-                            val = Mode::max (val, Mode::loadU (src));
-                        }
-                    }
-                }
-
-                Type result = isMinimum ? Mode::min (val)
-                                        : Mode::max (val);
-
-                num &= (Mode::numParallel - 1);
-                src += Mode::numParallel;
-
-                for (auto i = (decltype (num)) 0; i < num; ++i)
-                    result = isMinimum ? jmin (result, src[i])
-                                       : jmax (result, src[i]);
-
-                return result;
-            }
-
-            if (num <= 0)
-                return 0;
-
-            return isMinimum ? *std::min_element (src, src + num)
-                             : *std::max_element (src, src + num);
-        }
-
-        template <typename Size>
-        static Range<Type> findMinAndMax (const Type* src, Size num) noexcept
-        {
-            auto numLongOps = num / Mode::numParallel;
-
-            if (numLongOps > 1)
-            {
-                ParallelType mn, mx;
-
-               #if ! JUCE_USE_ARM_NEON
-                if (isAligned (src))
-                {
-                    mn = Mode::loadA (src);
-                    mx = mn;
-
-                    while (--numLongOps > 0)
-                    {
-                        src += Mode::numParallel;
-                        const ParallelType v = Mode::loadA (src);
-                        mn = Mode::min (mn, v);
-                        mx = Mode::max (mx, v);
-                    }
-                }
-                else
-               #endif
-                {
-                    mn = Mode::loadU (src);
-                    mx = mn;
-
-                    while (--numLongOps > 0)
-                    {
-                        src += Mode::numParallel;
-                        const ParallelType v = Mode::loadU (src);
-                        mn = Mode::min (mn, v);
-                        mx = Mode::max (mx, v);
-                    }
-                }
-
-                Range<Type> result (Mode::min (mn),
-                                    Mode::max (mx));
-
-                num &= (Mode::numParallel - 1);
-                src += Mode::numParallel;
-
-                for (auto i = (decltype (num)) 0; i < num; ++i)
-                    result = result.getUnionWith (src[i]);
-
-                return result;
-            }
-
-            return Range<Type>::findMinAndMax (src, num);
-        }
-    };
    #endif
 
-//==============================================================================
-namespace
-{
-    template <typename Size>
-    void clear (float* dest, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vclr (dest, 1, (vDSP_Length) num);
-       #else
-        zeromem (dest, (size_t) num * sizeof (float));
-       #endif
-    }
-
-    template <typename Size>
-    void clear (double* dest, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vclrD (dest, 1, (vDSP_Length) num);
-       #else
-        zeromem (dest, (size_t) num * sizeof (double));
-       #endif
-    }
-
-    template <typename Size>
-    void fill (float* dest, float valueToFill, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vfill (&valueToFill, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill,
-                                  val,
-                                  JUCE_LOAD_NONE,
-                                  const Mode::ParallelType val = Mode::load1 (valueToFill);)
-       #endif
-    }
-
-    template <typename Size>
-    void fill (double* dest, double valueToFill, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vfillD (&valueToFill, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill,
-                                  val,
-                                  JUCE_LOAD_NONE,
-                                  const Mode::ParallelType val = Mode::load1 (valueToFill);)
-       #endif
-    }
-
-    template <typename Size>
-    void copyWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
-                                      Mode::mul (mult, s),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-       #endif
-    }
-
-    template <typename Size>
-    void copyWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
-                                      Mode::mul (mult, s),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-       #endif
-    }
-
-    template <typename Size>
-    void add (float* dest, float amount, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
-                                  Mode::add (d, amountToAdd),
-                                  JUCE_LOAD_DEST,
-                                  const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
-       #endif
-    }
-
-    template <typename Size>
-    void add (double* dest, double amount, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
-                                  Mode::add (d, amountToAdd),
-                                  JUCE_LOAD_DEST,
-                                  const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
-    }
-
-    template <typename Size>
-    void add (float* dest, const float* src, float amount, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsadd (src, 1, &amount, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
-                                      Mode::add (am, s),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType am = Mode::load1 (amount);)
-       #endif
-    }
-
-    template <typename Size>
-    void add (double* dest, const double* src, double amount, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsaddD (src, 1, &amount, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
-                                      Mode::add (am, s),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType am = Mode::load1 (amount);)
-       #endif
-    }
-
-    template <typename Size>
-    void add (float* dest, const float* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
-                                      Mode::add (d, s),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST, )
-       #endif
-    }
+    #include "juce_FloatVectorOperations_Impl.h"
 
-    template <typename Size>
-    void add (double* dest, const double* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
-                                      Mode::add (d, s),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST, )
-       #endif
-    }
-
-    template <typename Size>
-    void add (float* dest, const float* src1, const float* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
-                                            Mode::add (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
-
-    template <typename Size>
-    void add (double* dest, const double* src1, const double* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
-                                            Mode::add (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
-
-    template <typename Size>
-    void subtract (float* dest, const float* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
-                                      Mode::sub (d, s),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST, )
-       #endif
-    }
-
-    template <typename Size>
-    void subtract (double* dest, const double* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
-                                      Mode::sub (d, s),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST, )
-       #endif
-    }
-
-    template <typename Size>
-    void subtract (float* dest, const float* src1, const float* src2, Size num) noexcept
+    //==============================================================================
+    /*  The instruction sets that FloatVectorOperations can choose between at runtime. When the
+        wider instruction sets are available, every operation is compiled again in its own
+        namespace, using the same code as the SSE version but with wider registers.
+
+        The wider versions deliberately don't use FMA, so that every instruction set gives
+        bit-identical results.
+    */
+    enum class InstructionSet
     {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
-                                            Mode::sub (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+        sse,
+        avx2,
+        avx512
+    };
 
-    template <typename Size>
-    void subtract (double* dest, const double* src1, const double* src2, Size num) noexcept
+   #if JUCE_USE_AVX_INTRINSICS
+    static InstructionSet detectInstructionSet() noexcept
     {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
-                                            Mode::sub (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+        if (SystemStats::hasAVX512F())  return InstructionSet::avx512;
+        if (SystemStats::hasAVX2())     return InstructionSet::avx2;
 
-    template <typename Size>
-    void addWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
-                                      Mode::add (d, Mode::mul (mult, s)),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-       #endif
+        return InstructionSet::sse;
     }
 
-    template <typename Size>
-    void addWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
-                                      Mode::add (d, Mode::mul (mult, s)),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-       #endif
-    }
+    // This is zero-initialised to InstructionSet::sse before the detection runs, so any calls
+    // made during static initialisation will safely use the SSE versions.
+    static std::atomic<InstructionSet> activeInstructionSet { detectInstructionSet() };
 
-    template <typename Size>
-    void addWithMultiply (float* dest, const float* src1, const float* src2, Size num) noexcept
+    static InstructionSet getInstructionSet() noexcept
     {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
-                                                 Mode::add (d, Mode::mul (s1, s2)),
-                                                 JUCE_LOAD_SRC1_SRC2_DEST,
-                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
+        return activeInstructionSet.load (std::memory_order_relaxed);
     }
 
-    template <typename Size>
-    void addWithMultiply (double* dest, const double* src1, const double* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
-                                                 Mode::add (d, Mode::mul (s1, s2)),
-                                                 JUCE_LOAD_SRC1_SRC2_DEST,
-                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+    //==============================================================================
+    JUCE_BEGIN_TARGET_INSTRUCTION_SET ("avx2")
 
-    template <typename Size>
-    void subtractWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
+    namespace AVX2
     {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
-                                      Mode::sub (d, Mode::mul (mult, s)),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-    }
+        static bool isAligned (const void* p) noexcept
+        {
+            return (((pointer_sized_int) p) & 31) == 0;
+        }
 
-    template <typename Size>
-    void subtractWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
-                                      Mode::sub (d, Mode::mul (mult, s)),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-    }
+        struct BasicOps32
+        {
+            using Type = float;
+            using ParallelType = __m256;
+            using IntegerType  = __m256;
+            enum { numParallel = 8 };
+
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return v; }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return v; }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm256_load_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm256_store_ps (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_ps (a, b); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_ps (a, b); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm256_or_ps (a, b); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm256_xor_ps (a, b); }
+
+            static forcedinline ParallelType convertIntsU (const int* v) noexcept           { return _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+
+            static forcedinline Type max (ParallelType a) noexcept { return FloatVectorHelpers::BasicOps32::max (_mm_max_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1))); }
+            static forcedinline Type min (ParallelType a) noexcept { return FloatVectorHelpers::BasicOps32::min (_mm_min_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1))); }
+        };
+
+        struct BasicOps64
+        {
+            using Type = double;
+            using ParallelType = __m256d;
+            using IntegerType  = __m256d;
+            enum { numParallel = 4 };
+
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return v; }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return v; }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm256_load_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm256_store_pd (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_pd (a, b); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_pd (a, b); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm256_or_pd (a, b); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm256_xor_pd (a, b); }
+
+            static forcedinline Type max (ParallelType a) noexcept  { return FloatVectorHelpers::BasicOps64::max (_mm_max_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1))); }
+            static forcedinline Type min (ParallelType a) noexcept  { return FloatVectorHelpers::BasicOps64::min (_mm_min_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1))); }
+        };
+
+        template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
+        template <>             struct ModeType<8> { using Mode = BasicOps64; };
+
+        #include "juce_FloatVectorOperations_Impl.h"
+
+        //==============================================================================
+        // These use the same arithmetic in double precision as the scalar versions in
+        // AudioDataConverters, so the results are identical.
+        static int convertFloatToInt16 (const float* src, void* dest, int num, double maxValue) noexcept
+        {
+            const auto hi = _mm256_set1_pd (maxValue), lo = _mm256_set1_pd (-maxValue);
+            auto d = static_cast<char*> (dest);
+            int i = 0;
 
-    template <typename Size>
-    void subtractWithMultiply (float* dest, const float* src1, const float* src2, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
-                                                 Mode::sub (d, Mode::mul (s1, s2)),
-                                                 JUCE_LOAD_SRC1_SRC2_DEST,
-                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
-    }
+            for (; i + BasicOps32::numParallel <= num; i += BasicOps32::numParallel)
+            {
+                const auto s = _mm256_loadu_ps (src + i);
+                const auto a = _mm256_cvtpd_epi32 (_mm256_max_pd (_mm256_min_pd (_mm256_mul_pd (_mm256_cvtps_pd (_mm256_castps256_ps128 (s)), hi), hi), lo));
+                const auto b = _mm256_cvtpd_epi32 (_mm256_max_pd (_mm256_min_pd (_mm256_mul_pd (_mm256_cvtps_pd (_mm256_extractf128_ps (s, 1)), hi), hi), lo));
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (d + i * 2), _mm_packs_epi32 (a, b));
+            }
 
-    template <typename Size>
-    void subtractWithMultiply (double* dest, const double* src1, const double* src2, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
-                                                 Mode::sub (d, Mode::mul (s1, s2)),
-                                                 JUCE_LOAD_SRC1_SRC2_DEST,
-                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
-    }
+            return i;
+        }
 
-    template <typename Size>
-    void multiply (float* dest, const float* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
-                                      Mode::mul (d, s),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST, )
-       #endif
-    }
+        static int convertFloatToInt32 (const float* src, void* dest, int num, double maxValue) noexcept
+        {
+            const auto hi = _mm256_set1_pd (maxValue), lo = _mm256_set1_pd (-maxValue);
+            auto d = static_cast<char*> (dest);
+            int i = 0;
 
-    template <typename Size>
-    void multiply (double* dest, const double* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
-                                      Mode::mul (d, s),
-                                      JUCE_LOAD_SRC_DEST,
-                                      JUCE_INCREMENT_SRC_DEST, )
-       #endif
-    }
+            for (; i + BasicOps32::numParallel <= num; i += BasicOps32::numParallel)
+            {
+                const auto s = _mm256_loadu_ps (src + i);
+                const auto a = _mm256_cvtpd_epi32 (_mm256_max_pd (_mm256_min_pd (_mm256_mul_pd (_mm256_cvtps_pd (_mm256_castps256_ps128 (s)), hi), hi), lo));
+                const auto b = _mm256_cvtpd_epi32 (_mm256_max_pd (_mm256_min_pd (_mm256_mul_pd (_mm256_cvtps_pd (_mm256_extractf128_ps (s, 1)), hi), hi), lo));
+                _mm256_storeu_si256 (reinterpret_cast<__m256i*> (d + i * 4), _mm256_set_m128i (b, a));
+            }
 
-    template <typename Size>
-    void multiply (float* dest, const float* src1, const float* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
-                                            Mode::mul (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+            return i;
+        }
 
-    template <typename Size>
-    void multiply (double* dest, const double* src1, const double* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
-                                            Mode::mul (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+        static int convertInt16ToFloat (const void* src, float* dest, int num, float scale) noexcept
+        {
+            const auto mult = _mm256_set1_ps (scale);
+            auto s = static_cast<const char*> (src);
+            int i = 0;
 
-    template <typename Size>
-    void multiply (float* dest, float multiplier, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
-                                  Mode::mul (d, mult),
-                                  JUCE_LOAD_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
-       #endif
-    }
+            for (; i + BasicOps32::numParallel <= num; i += BasicOps32::numParallel)
+            {
+                const auto ints = _mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (s + i * 2)));
+                _mm256_storeu_ps (dest + i, _mm256_mul_ps (mult, _mm256_cvtepi32_ps (ints)));
+            }
 
-    template <typename Size>
-    void multiply (double* dest, double multiplier, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
-                                  Mode::mul (d, mult),
-                                  JUCE_LOAD_DEST,
-                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
-       #endif
+            return i;
+        }
     }
 
-    template <typename Size>
-    void multiply (float* dest, const float* src, float multiplier, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
-                                      Mode::mul (mult, s),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-    }
+    JUCE_END_TARGET_INSTRUCTION_SET
 
-    template <typename Size>
-    void multiply (double* dest, const double* src, double multiplier, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
-                                      Mode::mul (mult, s),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-    }
+    //==============================================================================
+    JUCE_BEGIN_TARGET_INSTRUCTION_SET ("avx512f")
 
-    template <typename Size>
-    void negate (float* dest, const float* src, Size num) noexcept
+    namespace AVX512
     {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vneg ((float*) src, 1, dest, 1, (vDSP_Length) num);
-       #else
-        copyWithMultiply (dest, src, -1.0f, num);
-       #endif
-    }
+        static bool isAligned (const void* p) noexcept
+        {
+            return (((pointer_sized_int) p) & 63) == 0;
+        }
 
-    template <typename Size>
-    void negate (double* dest, const double* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vnegD ((double*) src, 1, dest, 1, (vDSP_Length) num);
-       #else
-        copyWithMultiply (dest, src, -1.0f, num);
-       #endif
-    }
+        // GCC implements many of the unmasked AVX-512 intrinsics as masked ones that take an
+        // uninitialised register for the lanes that aren't written, which makes -Wmaybe-uninitialized
+        // complain wherever they're inlined. The zero-masking versions with every lane enabled
+        // compile to exactly the same instructions without that.
+        constexpr __mmask8  allLanes8  = 0xff;
+        constexpr __mmask16 allLanes16 = 0xffff;
 
-    template <typename Size>
-    void abs (float* dest, const float* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vabs ((float*) src, 1, dest, 1, (vDSP_Length) num);
-       #else
-        [[maybe_unused]] FloatVectorHelpers::signMask32 signMask;
-        signMask.i = 0x7fffffffUL;
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]),
-                                      Mode::bit_and (s, mask),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mask = Mode::load1 (signMask.f);)
-       #endif
-    }
+        static forcedinline __m256d getLowerHalf (__m512d a) noexcept   { return _mm512_maskz_extractf64x4_pd (allLanes8, a, 0); }
+        static forcedinline __m256d getUpperHalf (__m512d a) noexcept   { return _mm512_maskz_extractf64x4_pd (allLanes8, a, 1); }
 
-    template <typename Size>
-    void abs (double* dest, const double* src, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vabsD ((double*) src, 1, dest, 1, (vDSP_Length) num);
-       #else
-        [[maybe_unused]] FloatVectorHelpers::signMask64 signMask;
-        signMask.i = 0x7fffffffffffffffULL;
-
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]),
-                                      Mode::bit_and (s, mask),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mask = Mode::load1 (signMask.d);)
-       #endif
-    }
+        static forcedinline __m512i combine (__m256i lo, __m256i hi) noexcept
+        {
+            return _mm512_maskz_inserti64x4 (allLanes8, _mm512_maskz_inserti64x4 (allLanes8, _mm512_setzero_si512(), lo, 0), hi, 1);
+        }
 
-    template <typename Size>
-    void min (float* dest, const float* src, float comp, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
-                                      Mode::min (s, cmp),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
-    }
+        struct BasicOps32
+        {
+            using Type = float;
+            using ParallelType = __m512;
+            using IntegerType  = __m512i;
+            enum { numParallel = 16 };
+
+            // AVX-512F only provides bitwise operations on integer registers
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return _mm512_castps_si512 (v); }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return _mm512_castsi512_ps (v); }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm512_load_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm512_store_ps (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_maskz_max_ps (allLanes16, a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_maskz_min_ps (allLanes16, a, b); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_and_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_andnot_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_or_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_xor_si512 (toint (a), toint (b))); }
+
+            static forcedinline ParallelType convertIntsU (const int* v) noexcept           { return _mm512_maskz_cvtepi32_ps (allLanes16, _mm512_loadu_si512 (v)); }
+
+            static forcedinline Type max (ParallelType a) noexcept { return AVX2::BasicOps32::max (_mm256_max_ps (lowerHalf (a), upperHalf (a))); }
+            static forcedinline Type min (ParallelType a) noexcept { return AVX2::BasicOps32::min (_mm256_min_ps (lowerHalf (a), upperHalf (a))); }
+
+            static forcedinline __m256 lowerHalf (ParallelType a) noexcept                  { return _mm256_castpd_ps (getLowerHalf (_mm512_castps_pd (a))); }
+            static forcedinline __m256 upperHalf (ParallelType a) noexcept                  { return _mm256_castpd_ps (getUpperHalf (_mm512_castps_pd (a))); }
+        };
+
+        struct BasicOps64
+        {
+            using Type = double;
+            using ParallelType = __m512d;
+            using IntegerType  = __m512i;
+            enum { numParallel = 8 };
+
+            // AVX-512F only provides bitwise operations on integer registers
+            static forcedinline IntegerType toint (ParallelType v) noexcept                 { return _mm512_castpd_si512 (v); }
+            static forcedinline ParallelType toflt (IntegerType v) noexcept                 { return _mm512_castsi512_pd (v); }
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+            static forcedinline ParallelType loadA (const Type* v) noexcept                 { return _mm512_load_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+            static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm512_store_pd (dest, a); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+            static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_maskz_max_pd (allLanes8, a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_maskz_min_pd (allLanes8, a, b); }
+
+            static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_and_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_andnot_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_or_si512 (toint (a), toint (b))); }
+            static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_xor_si512 (toint (a), toint (b))); }
+
+            static forcedinline Type max (ParallelType a) noexcept  { return AVX2::BasicOps64::max (_mm256_max_pd (getLowerHalf (a), getUpperHalf (a))); }
+            static forcedinline Type min (ParallelType a) noexcept  { return AVX2::BasicOps64::min (_mm256_min_pd (getLowerHalf (a), getUpperHalf (a))); }
+        };
+
+        template <int typeSize> struct ModeType    { using Mode = BasicOps32; };
+        template <>             struct ModeType<8> { using Mode = BasicOps64; };
+
+        #include "juce_FloatVectorOperations_Impl.h"
+
+        //==============================================================================
+        static forcedinline __m256i convertToInts (__m256 s, __m512d hi, __m512d lo) noexcept
+        {
+            const auto scaled = _mm512_mul_pd (_mm512_maskz_cvtps_pd (allLanes8, s), hi);
+            return _mm512_maskz_cvtpd_epi32 (allLanes8, BasicOps64::max (BasicOps64::min (scaled, hi), lo));
+        }
 
-    template <typename Size>
-    void min (double* dest, const double* src, double comp, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
-                                      Mode::min (s, cmp),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
-    }
+        static int convertFloatToInt16 (const float* src, void* dest, int num, double maxValue) noexcept
+        {
+            const auto hi = _mm512_set1_pd (maxValue), lo = _mm512_set1_pd (-maxValue);
+            auto d = static_cast<char*> (dest);
+            int i = 0;
 
-    template <typename Size>
-    void min (float* dest, const float* src1, const float* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
-                                            Mode::min (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+            for (; i + BasicOps32::numParallel <= num; i += BasicOps32::numParallel)
+            {
+                const auto s = _mm512_loadu_ps (src + i);
+                const auto a = convertToInts (BasicOps32::lowerHalf (s), hi, lo);
+                const auto b = convertToInts (BasicOps32::upperHalf (s), hi, lo);
+                _mm256_storeu_si256 (reinterpret_cast<__m256i*> (d + i * 2), _mm512_maskz_cvtepi32_epi16 (allLanes16, combine (a, b)));
+            }
 
-    template <typename Size>
-    void min (double* dest, const double* src1, const double* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
-                                            Mode::min (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+            return i;
+        }
 
-    template <typename Size>
-    void max (float* dest, const float* src, float comp, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
-                                      Mode::max (s, cmp),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
-    }
+        static int convertFloatToInt32 (const float* src, void* dest, int num, double maxValue) noexcept
+        {
+            const auto hi = _mm512_set1_pd (maxValue), lo = _mm512_set1_pd (-maxValue);
+            auto d = static_cast<char*> (dest);
+            int i = 0;
 
-    template <typename Size>
-    void max (double* dest, const double* src, double comp, Size num) noexcept
-    {
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
-                                      Mode::max (s, cmp),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
-    }
+            for (; i + BasicOps32::numParallel <= num; i += BasicOps32::numParallel)
+            {
+                const auto s = _mm512_loadu_ps (src + i);
+                const auto a = convertToInts (BasicOps32::lowerHalf (s), hi, lo);
+                const auto b = convertToInts (BasicOps32::upperHalf (s), hi, lo);
+                _mm512_storeu_si512 (d + i * 4, combine (a, b));
+            }
 
-    template <typename Size>
-    void max (float* dest, const float* src1, const float* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
-                                            Mode::max (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+            return i;
+        }
 
-    template <typename Size>
-    void max (double* dest, const double* src1, const double* src2, Size num) noexcept
-    {
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
-                                            Mode::max (s1, s2),
-                                            JUCE_LOAD_SRC1_SRC2,
-                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
-       #endif
-    }
+        static int convertInt16ToFloat (const void* src, float* dest, int num, float scale) noexcept
+        {
+            const auto mult = _mm512_set1_ps (scale);
+            auto s = static_cast<const char*> (src);
+            int i = 0;
 
-    template <typename Size>
-    void clip (float* dest, const float* src, float low, float high, Size num) noexcept
-    {
-        jassert (high >= low);
+            for (; i + BasicOps32::numParallel <= num; i += BasicOps32::numParallel)
+            {
+                const auto ints = _mm512_maskz_cvtepi16_epi32 (allLanes16, _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (s + i * 2)));
+                _mm512_storeu_ps (dest + i, _mm512_mul_ps (mult, _mm512_maskz_cvtepi32_ps (allLanes16, ints)));
+            }
 
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
-                                      Mode::max (Mode::min (s, hi), lo),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType lo = Mode::load1 (low);
-                                      const Mode::ParallelType hi = Mode::load1 (high);)
-       #endif
+            return i;
+        }
     }
 
-    template <typename Size>
-    void clip (double* dest, const double* src, double low, double high, Size num) noexcept
-    {
-        jassert (high >= low);
+    JUCE_END_TARGET_INSTRUCTION_SET
 
-       #if JUCE_USE_VDSP_FRAMEWORK
-        vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
-                                      Mode::max (Mode::min (s, hi), lo),
-                                      JUCE_LOAD_SRC,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType lo = Mode::load1 (low);
-                                      const Mode::ParallelType hi = Mode::load1 (high);)
-       #endif
-    }
+    #define JUCE_DISPATCH_VEC_OP(functionCall) \
+        switch (FloatVectorHelpers::getInstructionSet()) \
+        { \
+            case FloatVectorHelpers::InstructionSet::avx512:    return FloatVectorHelpers::AVX512::functionCall; \
+            case FloatVectorHelpers::InstructionSet::avx2:      return FloatVectorHelpers::AVX2::functionCall; \
+            case FloatVectorHelpers::InstructionSet::sse:       break; \
+        } \
+        return FloatVectorHelpers::functionCall;
 
-    template <typename Size>
-    Range<float> findMinAndMax (const float* src, Size num) noexcept
-    {
-       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-        return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
-       #else
-        return Range<float>::findMinAndMax (src, num);
-       #endif
-    }
+   #else
+    #define JUCE_DISPATCH_VEC_OP(functionCall) \
+        return FloatVectorHelpers::functionCall;
+   #endif
 
-    template <typename Size>
-    Range<double> findMinAndMax (const double* src, Size num) noexcept
+    //==============================================================================
+    /*  These convert as many whole vectors of samples as the active instruction set allows, and
+        return the number of samples converted, leaving the rest for the caller to convert.
+    */
+    static int convertFloatToInt16 (const float* src, void* dest, int num, double maxValue) noexcept
     {
-       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-        return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
-       #else
-        return Range<double>::findMinAndMax (src, num);
+       #if JUCE_USE_AVX_INTRINSICS
+        switch (getInstructionSet())
+        {
+            case InstructionSet::avx512:    return AVX512::convertFloatToInt16 (src, dest, num, maxValue);
+            case InstructionSet::avx2:      return AVX2::convertFloatToInt16 (src, dest, num, maxValue);
+            case InstructionSet::sse:       break;
+        }
        #endif
-    }
 
-    template <typename Size>
-    float findMinimum (const float* src, Size num) noexcept
-    {
-       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-        return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
-       #else
-        return juce::findMinimum (src, num);
-       #endif
+        ignoreUnused (src, dest, num, maxValue);
+        return 0;
     }
 
-    template <typename Size>
-    double findMinimum (const double* src, Size num) noexcept
+    static int convertFloatToInt32 (const float* src, void* dest, int num, double maxValue) noexcept
     {
-       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-        return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
-       #else
-        return juce::findMinimum (src, num);
+       #if JUCE_USE_AVX_INTRINSICS
+        switch (getInstructionSet())
+        {
+            case InstructionSet::avx512:    return AVX512::convertFloatToInt32 (src, dest, num, maxValue);
+            case InstructionSet::avx2:      return AVX2::convertFloatToInt32 (src, dest, num, maxValue);
+            case InstructionSet::sse:       break;
+        }
        #endif
-    }
 
-    template <typename Size>
-    float findMaximum (const float* src, Size num) noexcept
-    {
-       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-        return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
-       #else
-        return juce::findMaximum (src, num);
-       #endif
+        ignoreUnused (src, dest, num, maxValue);
+        return 0;
     }
 
-    template <typename Size>
-    double findMaximum (const double* src, Size num) noexcept
+    static int convertInt16ToFloat (const void* src, float* dest, int num, float scale) noexcept
     {
-       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
-        return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
-       #else
-        return juce::findMaximum (src, num);
+       #if JUCE_USE_AVX_INTRINSICS
+        switch (getInstructionSet())
+        {
+            case InstructionSet::avx512:    return AVX512::convertInt16ToFloat (src, dest, num, scale);
+            case InstructionSet::avx2:      return AVX2::convertInt16ToFloat (src, dest, num, scale);
+            case InstructionSet::sse:       break;
+        }
        #endif
-    }
 
-    template <typename Size>
-    void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
-    {
-       #if JUCE_USE_ARM_NEON
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
-                                  vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
-                                  JUCE_LOAD_NONE,
-                                  JUCE_INCREMENT_SRC_DEST, )
-       #else
-        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
-                                      Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src)))),
-                                      JUCE_LOAD_NONE,
-                                      JUCE_INCREMENT_SRC_DEST,
-                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
-       #endif
+        ignoreUnused (src, dest, num, scale);
+        return 0;
     }
-
-} // namespace
 } // namespace FloatVectorHelpers
 
 //==============================================================================
@@ -1184,7 +763,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::fill (FloatT
                                                                           FloatType valueToFill,
                                                                           CountType numValues) noexcept
 {
-    FloatVectorHelpers::fill (dest, valueToFill, numValues);
+    JUCE_DISPATCH_VEC_OP (fill (dest, valueToFill, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1201,7 +780,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::copyWithMult
                                                                                       FloatType multiplier,
                                                                                       CountType numValues) noexcept
 {
-    FloatVectorHelpers::copyWithMultiply (dest, src, multiplier, numValues);
+    JUCE_DISPATCH_VEC_OP (copyWithMultiply (dest, src, multiplier, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1209,7 +788,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          FloatType amountToAdd,
                                                                          CountType numValues) noexcept
 {
-    FloatVectorHelpers::add (dest, amountToAdd, numValues);
+    JUCE_DISPATCH_VEC_OP (add (dest, amountToAdd, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1218,7 +797,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          FloatType amount,
                                                                          CountType numValues) noexcept
 {
-    FloatVectorHelpers::add (dest, src, amount, numValues);
+    JUCE_DISPATCH_VEC_OP (add (dest, src, amount, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1226,7 +805,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          const FloatType* src,
                                                                          CountType numValues) noexcept
 {
-    FloatVectorHelpers::add (dest, src, numValues);
+    JUCE_DISPATCH_VEC_OP (add (dest, src, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1235,7 +814,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          const FloatType* src2,
                                                                          CountType num) noexcept
 {
-    FloatVectorHelpers::add (dest, src1, src2, num);
+    JUCE_DISPATCH_VEC_OP (add (dest, src1, src2, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1243,7 +822,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtract (Fl
                                                                               const FloatType* src,
                                                                               CountType numValues) noexcept
 {
-    FloatVectorHelpers::subtract (dest, src, numValues);
+    JUCE_DISPATCH_VEC_OP (subtract (dest, src, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1252,7 +831,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtract (Fl
                                                                               const FloatType* src2,
                                                                               CountType num) noexcept
 {
-    FloatVectorHelpers::subtract (dest, src1, src2, num);
+    JUCE_DISPATCH_VEC_OP (subtract (dest, src1, src2, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1261,7 +840,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithMulti
                                                                                      FloatType multiplier,
                                                                                      CountType numValues) noexcept
 {
-    FloatVectorHelpers::addWithMultiply (dest, src, multiplier, numValues);
+    JUCE_DISPATCH_VEC_OP (addWithMultiply (dest, src, multiplier, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1270,7 +849,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithMulti
                                                                                      const FloatType* src2,
                                                                                      CountType num) noexcept
 {
-    FloatVectorHelpers::addWithMultiply (dest, src1, src2, num);
+    JUCE_DISPATCH_VEC_OP (addWithMultiply (dest, src1, src2, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1279,7 +858,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtractWith
                                                                                           FloatType multiplier,
                                                                                           CountType numValues) noexcept
 {
-    FloatVectorHelpers::subtractWithMultiply (dest, src, multiplier, numValues);
+    JUCE_DISPATCH_VEC_OP (subtractWithMultiply (dest, src, multiplier, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1288,7 +867,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtractWith
                                                                                           const FloatType* src2,
                                                                                           CountType num) noexcept
 {
-    FloatVectorHelpers::subtractWithMultiply (dest, src1, src2, num);
+    JUCE_DISPATCH_VEC_OP (subtractWithMultiply (dest, src1, src2, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1296,7 +875,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               const FloatType* src,
                                                                               CountType numValues) noexcept
 {
-    FloatVectorHelpers::multiply (dest, src, numValues);
+    JUCE_DISPATCH_VEC_OP (multiply (dest, src, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1305,7 +884,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               const FloatType* src2,
                                                                               CountType numValues) noexcept
 {
-    FloatVectorHelpers::multiply (dest, src1, src2, numValues);
+    JUCE_DISPATCH_VEC_OP (multiply (dest, src1, src2, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1313,7 +892,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               FloatType multiplier,
                                                                               CountType numValues) noexcept
 {
-    FloatVectorHelpers::multiply (dest, multiplier, numValues);
+    JUCE_DISPATCH_VEC_OP (multiply (dest, multiplier, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1322,7 +901,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               FloatType multiplier,
                                                                               CountType num) noexcept
 {
-    FloatVectorHelpers::multiply (dest, src, multiplier, num);
+    JUCE_DISPATCH_VEC_OP (multiply (dest, src, multiplier, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1330,7 +909,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::negate (Floa
                                                                             const FloatType* src,
                                                                             CountType numValues) noexcept
 {
-    FloatVectorHelpers::negate (dest, src, numValues);
+    JUCE_DISPATCH_VEC_OP (negate (dest, src, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1338,7 +917,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::abs (FloatTy
                                                                          const FloatType* src,
                                                                          CountType numValues) noexcept
 {
-    FloatVectorHelpers::abs (dest, src, numValues);
+    JUCE_DISPATCH_VEC_OP (abs (dest, src, numValues))
 }
 
 template <typename FloatType, typename CountType>
@@ -1347,7 +926,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::min (FloatTy
                                                                          FloatType comp,
                                                                          CountType num) noexcept
 {
-    FloatVectorHelpers::min (dest, src, comp, num);
+    JUCE_DISPATCH_VEC_OP (min (dest, src, comp, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1356,7 +935,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::min (FloatTy
                                                                          const FloatType* src2,
                                                                          CountType num) noexcept
 {
-    FloatVectorHelpers::min (dest, src1, src2, num);
+    JUCE_DISPATCH_VEC_OP (min (dest, src1, src2, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1365,7 +944,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::max (FloatTy
                                                                          FloatType comp,
                                                                          CountType num) noexcept
 {
-    FloatVectorHelpers::max (dest, src, comp, num);
+    JUCE_DISPATCH_VEC_OP (max (dest, src, comp, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1374,7 +953,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::max (FloatTy
                                                                          const FloatType* src2,
                                                                          CountType num) noexcept
 {
-    FloatVectorHelpers::max (dest, src1, src2, num);
+    JUCE_DISPATCH_VEC_OP (max (dest, src1, src2, num))
 }
 
 template <typename FloatType, typename CountType>
@@ -1384,28 +963,28 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::clip (FloatT
                                                                           FloatType high,
                                                                           CountType num) noexcept
 {
-    FloatVectorHelpers::clip (dest, src, low, high, num);
+    JUCE_DISPATCH_VEC_OP (clip (dest, src, low, high, num))
 }
 
 template <typename FloatType, typename CountType>
 Range<FloatType> JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMinAndMax (const FloatType* src,
                                                                                                CountType numValues) noexcept
 {
-    return FloatVectorHelpers::findMinAndMax (src, numValues);
+    JUCE_DISPATCH_VEC_OP (findMinAndMax (src, numValues))
 }
 
 template <typename FloatType, typename CountType>
 FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMinimum (const FloatType* src,
                                                                                       CountType numValues) noexcept
 {
-    return FloatVectorHelpers::findMinimum (src, numValues);
+    JUCE_DISPATCH_VEC_OP (findMinimum (src, numValues))
 }
 
 template <typename FloatType, typename CountType>
 FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMaximum (const FloatType* src,
                                                                                       CountType numValues) noexcept
 {
-    return FloatVectorHelpers::findMaximum (src, numValues);
+    JUCE_DISPATCH_VEC_OP (findMaximum (src, numValues))
 }
 
 template struct FloatVectorOperationsBase<float, int>;
@@ -1415,12 +994,12 @@ template struct FloatVectorOperationsBase<double, size_t>;
 
 void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, const int* src, float multiplier, size_t num) noexcept
 {
-   FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
+    JUCE_DISPATCH_VEC_OP (convertFixedToFloat (dest, src, multiplier, num))
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept
 {
-    FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
+    JUCE_DISPATCH_VEC_OP (convertFixedToFloat (dest, src, multiplier, num))
 }
 
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
@@ -1555,6 +1134,63 @@ ScopedNoDenormals::~ScopedNoDenormals() noexcept
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
+namespace FloatVectorHelpers
+{
+    static Array<InstructionSet> getAvailableInstructionSets()
+    {
+        Array<InstructionSet> result { InstructionSet::sse };
+
+       #if JUCE_USE_AVX_INTRINSICS
+        if (SystemStats::hasAVX2())     result.add (InstructionSet::avx2);
+        if (SystemStats::hasAVX512F())  result.add (InstructionSet::avx512);
+       #endif
+
+        return result;
+    }
+
+    static String getInstructionSetName (InstructionSet set)
+    {
+        switch (set)
+        {
+            case InstructionSet::avx512:    return "AVX-512";
+            case InstructionSet::avx2:      return "AVX2";
+            case InstructionSet::sse:       break;
+        }
+
+       #if JUCE_USE_ARM_NEON
+        return "NEON";
+       #elif JUCE_USE_SSE_INTRINSICS
+        return "SSE";
+       #else
+        return "Scalar";
+       #endif
+    }
+
+    /*  Temporarily makes FloatVectorOperations use a particular instruction set. */
+    struct ScopedInstructionSet
+    {
+        explicit ScopedInstructionSet ([[maybe_unused]] InstructionSet set)
+        {
+           #if JUCE_USE_AVX_INTRINSICS
+            activeInstructionSet.store (set);
+           #endif
+        }
+
+        ~ScopedInstructionSet()
+        {
+           #if JUCE_USE_AVX_INTRINSICS
+            activeInstructionSet.store (previous);
+           #endif
+        }
+
+       #if JUCE_USE_AVX_INTRINSICS
+        const InstructionSet previous = activeInstructionSet.load();
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedInstructionSet)
+    };
+}
+
 class FloatVectorOperationsTests final : public UnitTest
 {
 public:
@@ -1697,6 +1333,102 @@ public:
         }
     };
 
+    //==============================================================================
+    template <typename ValueType>
+    struct InstructionSetComparison
+    {
+        using Operation = std::function<void (ValueType*, const ValueType*, const ValueType*, const int*, int)>;
+
+        static std::vector<std::pair<String, Operation>> getOperations()
+        {
+            using FVO = FloatVectorOperations;
+
+            std::vector<std::pair<String, Operation>> ops
+            {
+                { "fill",                       [] (ValueType* d, const ValueType*,    const ValueType*,    const int*, int n) { FVO::fill (d, (ValueType) 0.3, n); } },
+                { "add (value)",                [] (ValueType* d, const ValueType*,    const ValueType*,    const int*, int n) { FVO::add (d, (ValueType) 0.3, n); } },
+                { "add (src)",                  [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::add (d, s1, n); } },
+                { "add (src, value)",           [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::add (d, s1, (ValueType) 0.3, n); } },
+                { "add (src1, src2)",           [] (ValueType* d, const ValueType* s1, const ValueType* s2, const int*, int n) { FVO::add (d, s1, s2, n); } },
+                { "subtract (src)",             [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::subtract (d, s1, n); } },
+                { "subtract (src1, src2)",      [] (ValueType* d, const ValueType* s1, const ValueType* s2, const int*, int n) { FVO::subtract (d, s1, s2, n); } },
+                { "copyWithMultiply",           [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::copyWithMultiply (d, s1, (ValueType) 0.3, n); } },
+                { "addWithMultiply (value)",    [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::addWithMultiply (d, s1, (ValueType) 0.3, n); } },
+                { "addWithMultiply (src2)",     [] (ValueType* d, const ValueType* s1, const ValueType* s2, const int*, int n) { FVO::addWithMultiply (d, s1, s2, n); } },
+                { "subtractWithMultiply",       [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::subtractWithMultiply (d, s1, (ValueType) 0.3, n); } },
+                { "subtractWithMultiply (src2)",[] (ValueType* d, const ValueType* s1, const ValueType* s2, const int*, int n) { FVO::subtractWithMultiply (d, s1, s2, n); } },
+                { "multiply (value)",           [] (ValueType* d, const ValueType*,    const ValueType*,    const int*, int n) { FVO::multiply (d, (ValueType) 0.3, n); } },
+                { "multiply (src)",             [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::multiply (d, s1, n); } },
+                { "multiply (src, value)",      [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::multiply (d, s1, (ValueType) 0.3, n); } },
+                { "multiply (src1, src2)",      [] (ValueType* d, const ValueType* s1, const ValueType* s2, const int*, int n) { FVO::multiply (d, s1, s2, n); } },
+                { "negate",                     [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::negate (d, s1, n); } },
+                { "abs",                        [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::abs (d, s1, n); } },
+                { "min (value)",                [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::min (d, s1, (ValueType) 0.3, n); } },
+                { "min (src1, src2)",           [] (ValueType* d, const ValueType* s1, const ValueType* s2, const int*, int n) { FVO::min (d, s1, s2, n); } },
+                { "max (value)",                [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::max (d, s1, (ValueType) 0.3, n); } },
+                { "max (src1, src2)",           [] (ValueType* d, const ValueType* s1, const ValueType* s2, const int*, int n) { FVO::max (d, s1, s2, n); } },
+                { "clip",                       [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { FVO::clip (d, s1, (ValueType) -0.2, (ValueType) 0.4, n); } },
+                { "findMinAndMax",              [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { auto r = FVO::findMinAndMax (s1, n); d[0] = r.getStart(); d[1] = r.getEnd(); } },
+                { "findMinimum",                [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { d[0] = FVO::findMinimum (s1, n); } },
+                { "findMaximum",                [] (ValueType* d, const ValueType* s1, const ValueType*,    const int*, int n) { d[0] = FVO::findMaximum (s1, n); } }
+            };
+
+            if constexpr (std::is_same_v<ValueType, float>)
+                ops.push_back ({ "convertFixedToFloat", [] (float* d, const float*, const float*, const int* i, int n) { FVO::convertFixedToFloat (d, i, 0.001f, n); } });
+
+            return ops;
+        }
+
+        static void run (UnitTest& u, Random& random)
+        {
+            for (const auto& [opName, op] : getOperations())
+            {
+                for (int trial = 0; trial < 50; ++trial)
+                {
+                    const auto num = random.nextInt (300) + 1;
+                    const auto paddedSize = (size_t) num + 16;
+                    HeapBlock<ValueType> src1 (paddedSize), src2 (paddedSize), initial (paddedSize), expected (paddedSize), actual (paddedSize);
+                    HeapBlock<int> ints (paddedSize);
+
+                    // Use misaligned pointers so that all the load and store variants get tested
+                    auto* s1 = src1.get() + random.nextInt (16);
+                    auto* s2 = src2.get() + random.nextInt (16);
+                    auto* d1 = expected.get() + random.nextInt (16);
+                    auto* d2 = actual.get() + random.nextInt (16);
+                    auto* i1 = ints.get() + random.nextInt (16);
+
+                    for (int i = 0; i < num; ++i)
+                    {
+                        s1[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+                        s2[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+                        initial[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+                        i1[i] = random.nextInt();
+                    }
+
+                    std::copy (initial.get(), initial.get() + num, d1);
+
+                    {
+                        const FloatVectorHelpers::ScopedInstructionSet scope (FloatVectorHelpers::InstructionSet::sse);
+                        op (d1, s1, s2, i1, num);
+                    }
+
+                    for (auto set : FloatVectorHelpers::getAvailableInstructionSets())
+                    {
+                        std::copy (initial.get(), initial.get() + num, d2);
+
+                        {
+                            const FloatVectorHelpers::ScopedInstructionSet scope (set);
+                            op (d2, s1, s2, i1, num);
+                        }
+
+                        u.expect (std::memcmp (d1, d2, (size_t) num * sizeof (ValueType)) == 0,
+                                  opName + " gives different results using " + FloatVectorHelpers::getInstructionSetName (set));
+                    }
+                }
+            }
+        }
+    };
+
     void runTest() override
     {
         beginTest ("FloatVectorOperations");
@@ -1706,6 +1438,13 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+        beginTest ("Every instruction set gives identical results");
+        {
+            auto random = getRandom();
+            InstructionSetComparison<float>::run (*this, random);
+            InstructionSetComparison<double>::run (*this, random);
+        }
     }
 };
 
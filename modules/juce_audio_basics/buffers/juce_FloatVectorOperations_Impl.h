@@ -0,0 +1,841 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  This file is included by juce_FloatVectorOperations.cpp once for each instruction set that
+    FloatVectorOperations can use. Each time, the surrounding namespace provides the isAligned()
+    and ModeType definitions, along with the JUCE_PERFORM_VEC_OP macros, for that instruction set.
+*/
+
+   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    template <typename Mode>
+    struct MinMax
+    {
+        using Type = typename Mode::Type;
+        using ParallelType = typename Mode::ParallelType;
+
+        template <typename Size>
+        static Type findMinOrMax (const Type* src, Size num, const bool isMinimum) noexcept
+        {
+            auto numLongOps = num / Mode::numParallel;
+
+            if (numLongOps > 1)
+            {
+                ParallelType val;
+
+               #if ! JUCE_USE_ARM_NEON
+                if (isAligned (src))
+                {
+                    val = Mode::loadA (src);
+
+                    if (isMinimum)
+                    {
+                        while (--numLongOps > 0)
+                        {
+                            src += Mode::numParallel;
+                            val = Mode::min (val, Mode::loadA (src));
+                        }
+                    }
+                    else
+                    {
+                        while (--numLongOps > 0)
+                        {
+                            src += Mode::numParallel;
+                            val = Mode::max (val, Mode::loadA (src));
+                        }
+                    }
+                }
+                else
+               #endif
+                {
+                    val = Mode::loadU (src);
+
+                    if (isMinimum)
+                    {
+                        while (--numLongOps > 0)
+                        {
+                            src += Mode::numParallel;
+                            val = Mode::min (val, Mode::loadU (src));
+                        }
+                    }
+                    else
+                    {
+                        while (--numLongOps > 0)
+                        {
+                            src += Mode::numParallel;
+                            val = Mode::max (val, Mode::loadU (src));
+                        }
+                    }
+                }
+
+                Type result = isMinimum ? Mode::min (val)
+                                        : Mode::max (val);
+
+                num &= (Mode::numParallel - 1);
+                src += Mode::numParallel;
+
+                for (auto i = (decltype (num)) 0; i < num; ++i)
+                    result = isMinimum ? jmin (result, src[i])
+                                       : jmax (result, src[i]);
+
+                return result;
+            }
+
+            if (num <= 0)
+                return 0;
+
+            return isMinimum ? *std::min_element (src, src + num)
+                             : *std::max_element (src, src + num);
+        }
+
+        template <typename Size>
+        static Range<Type> findMinAndMax (const Type* src, Size num) noexcept
+        {
+            auto numLongOps = num / Mode::numParallel;
+
+            if (numLongOps > 1)
+            {
+                ParallelType mn, mx;
+
+               #if ! JUCE_USE_ARM_NEON
+                if (isAligned (src))
+                {
+                    mn = Mode::loadA (src);
+                    mx = mn;
+
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        const ParallelType v = Mode::loadA (src);
+                        mn = Mode::min (mn, v);
+                        mx = Mode::max (mx, v);
+                    }
+                }
+                else
+               #endif
+                {
+                    mn = Mode::loadU (src);
+                    mx = mn;
+
+                    while (--numLongOps > 0)
+                    {
+                        src += Mode::numParallel;
+                        const ParallelType v = Mode::loadU (src);
+                        mn = Mode::min (mn, v);
+                        mx = Mode::max (mx, v);
+                    }
+                }
+
+                Range<Type> result (Mode::min (mn),
+                                    Mode::max (mx));
+
+                num &= (Mode::numParallel - 1);
+                src += Mode::numParallel;
+
+                for (auto i = (decltype (num)) 0; i < num; ++i)
+                    result = result.getUnionWith (src[i]);
+
+                return result;
+            }
+
+            return Range<Type>::findMinAndMax (src, num);
+        }
+    };
+   #endif
+
+//==============================================================================
+namespace
+{
+    template <typename Size>
+    void clear (float* dest, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vclr (dest, 1, (vDSP_Length) num);
+       #else
+        zeromem (dest, (size_t) num * sizeof (float));
+       #endif
+    }
+
+    template <typename Size>
+    void clear (double* dest, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vclrD (dest, 1, (vDSP_Length) num);
+       #else
+        zeromem (dest, (size_t) num * sizeof (double));
+       #endif
+    }
+
+    template <typename Size>
+    void fill (float* dest, float valueToFill, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vfill (&valueToFill, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill,
+                                  val,
+                                  JUCE_LOAD_NONE,
+                                  const Mode::ParallelType val = Mode::load1 (valueToFill);)
+       #endif
+    }
+
+    template <typename Size>
+    void fill (double* dest, double valueToFill, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vfillD (&valueToFill, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill,
+                                  val,
+                                  JUCE_LOAD_NONE,
+                                  const Mode::ParallelType val = Mode::load1 (valueToFill);)
+       #endif
+    }
+
+    template <typename Size>
+    void copyWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
+                                      Mode::mul (mult, s),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+       #endif
+    }
+
+    template <typename Size>
+    void copyWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
+                                      Mode::mul (mult, s),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+       #endif
+    }
+
+    template <typename Size>
+    void add (float* dest, float amount, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
+                                  Mode::add (d, amountToAdd),
+                                  JUCE_LOAD_DEST,
+                                  const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
+       #endif
+    }
+
+    template <typename Size>
+    void add (double* dest, double amount, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount,
+                                  Mode::add (d, amountToAdd),
+                                  JUCE_LOAD_DEST,
+                                  const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
+    }
+
+    template <typename Size>
+    void add (float* dest, const float* src, float amount, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsadd (src, 1, &amount, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
+                                      Mode::add (am, s),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType am = Mode::load1 (amount);)
+       #endif
+    }
+
+    template <typename Size>
+    void add (double* dest, const double* src, double amount, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsaddD (src, 1, &amount, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount,
+                                      Mode::add (am, s),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType am = Mode::load1 (amount);)
+       #endif
+    }
+
+    template <typename Size>
+    void add (float* dest, const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
+                                      Mode::add (d, s),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void add (double* dest, const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
+                                      Mode::add (d, s),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void add (float* dest, const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
+                                            Mode::add (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void add (double* dest, const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
+                                            Mode::add (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void subtract (float* dest, const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
+                                      Mode::sub (d, s),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void subtract (double* dest, const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
+                                      Mode::sub (d, s),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void subtract (float* dest, const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
+                                            Mode::sub (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void subtract (double* dest, const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i],
+                                            Mode::sub (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void addWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
+                                      Mode::add (d, Mode::mul (mult, s)),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+       #endif
+    }
+
+    template <typename Size>
+    void addWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
+                                      Mode::add (d, Mode::mul (mult, s)),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+       #endif
+    }
+
+    template <typename Size>
+    void addWithMultiply (float* dest, const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
+                                                 Mode::add (d, Mode::mul (s1, s2)),
+                                                 JUCE_LOAD_SRC1_SRC2_DEST,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void addWithMultiply (double* dest, const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
+                                                 Mode::add (d, Mode::mul (s1, s2)),
+                                                 JUCE_LOAD_SRC1_SRC2_DEST,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void subtractWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
+                                      Mode::sub (d, Mode::mul (mult, s)),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    template <typename Size>
+    void subtractWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier,
+                                      Mode::sub (d, Mode::mul (mult, s)),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    template <typename Size>
+    void subtractWithMultiply (float* dest, const float* src1, const float* src2, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
+                                                 Mode::sub (d, Mode::mul (s1, s2)),
+                                                 JUCE_LOAD_SRC1_SRC2_DEST,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    template <typename Size>
+    void subtractWithMultiply (double* dest, const double* src1, const double* src2, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i],
+                                                 Mode::sub (d, Mode::mul (s1, s2)),
+                                                 JUCE_LOAD_SRC1_SRC2_DEST,
+                                                 JUCE_INCREMENT_SRC1_SRC2_DEST, )
+    }
+
+    template <typename Size>
+    void multiply (float* dest, const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
+                                      Mode::mul (d, s),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void multiply (double* dest, const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
+                                      Mode::mul (d, s),
+                                      JUCE_LOAD_SRC_DEST,
+                                      JUCE_INCREMENT_SRC_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void multiply (float* dest, const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
+                                            Mode::mul (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void multiply (double* dest, const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
+                                            Mode::mul (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void multiply (float* dest, float multiplier, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
+                                  Mode::mul (d, mult),
+                                  JUCE_LOAD_DEST,
+                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+       #endif
+    }
+
+    template <typename Size>
+    void multiply (double* dest, double multiplier, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
+                                  Mode::mul (d, mult),
+                                  JUCE_LOAD_DEST,
+                                  const Mode::ParallelType mult = Mode::load1 (multiplier);)
+       #endif
+    }
+
+    template <typename Size>
+    void multiply (float* dest, const float* src, float multiplier, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
+                                      Mode::mul (mult, s),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    template <typename Size>
+    void multiply (double* dest, const double* src, double multiplier, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
+                                      Mode::mul (mult, s),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+    }
+
+    template <typename Size>
+    void negate (float* dest, const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vneg ((float*) src, 1, dest, 1, (vDSP_Length) num);
+       #else
+        copyWithMultiply (dest, src, -1.0f, num);
+       #endif
+    }
+
+    template <typename Size>
+    void negate (double* dest, const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vnegD ((double*) src, 1, dest, 1, (vDSP_Length) num);
+       #else
+        copyWithMultiply (dest, src, -1.0f, num);
+       #endif
+    }
+
+    template <typename Size>
+    void abs (float* dest, const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vabs ((float*) src, 1, dest, 1, (vDSP_Length) num);
+       #else
+        [[maybe_unused]] FloatVectorHelpers::signMask32 signMask;
+        signMask.i = 0x7fffffffUL;
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]),
+                                      Mode::bit_and (s, mask),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mask = Mode::load1 (signMask.f);)
+       #endif
+    }
+
+    template <typename Size>
+    void abs (double* dest, const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vabsD ((double*) src, 1, dest, 1, (vDSP_Length) num);
+       #else
+        [[maybe_unused]] FloatVectorHelpers::signMask64 signMask;
+        signMask.i = 0x7fffffffffffffffULL;
+
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]),
+                                      Mode::bit_and (s, mask),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mask = Mode::load1 (signMask.d);)
+       #endif
+    }
+
+    template <typename Size>
+    void min (float* dest, const float* src, float comp, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
+                                      Mode::min (s, cmp),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
+    }
+
+    template <typename Size>
+    void min (double* dest, const double* src, double comp, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp),
+                                      Mode::min (s, cmp),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
+    }
+
+    template <typename Size>
+    void min (float* dest, const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
+                                            Mode::min (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void min (double* dest, const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]),
+                                            Mode::min (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void max (float* dest, const float* src, float comp, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
+                                      Mode::max (s, cmp),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
+    }
+
+    template <typename Size>
+    void max (double* dest, const double* src, double comp, Size num) noexcept
+    {
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp),
+                                      Mode::max (s, cmp),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType cmp = Mode::load1 (comp);)
+    }
+
+    template <typename Size>
+    void max (float* dest, const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
+                                            Mode::max (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void max (double* dest, const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]),
+                                            Mode::max (s1, s2),
+                                            JUCE_LOAD_SRC1_SRC2,
+                                            JUCE_INCREMENT_SRC1_SRC2_DEST, )
+       #endif
+    }
+
+    template <typename Size>
+    void clip (float* dest, const float* src, float low, float high, Size num) noexcept
+    {
+        jassert (high >= low);
+
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
+                                      Mode::max (Mode::min (s, hi), lo),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType lo = Mode::load1 (low);
+                                      const Mode::ParallelType hi = Mode::load1 (high);)
+       #endif
+    }
+
+    template <typename Size>
+    void clip (double* dest, const double* src, double low, double high, Size num) noexcept
+    {
+        jassert (high >= low);
+
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
+                                      Mode::max (Mode::min (s, hi), lo),
+                                      JUCE_LOAD_SRC,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType lo = Mode::load1 (low);
+                                      const Mode::ParallelType hi = Mode::load1 (high);)
+       #endif
+    }
+
+    template <typename Size>
+    Range<float> findMinAndMax (const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return MinMax<BasicOps32>::findMinAndMax (src, num);
+       #else
+        return Range<float>::findMinAndMax (src, num);
+       #endif
+    }
+
+    template <typename Size>
+    Range<double> findMinAndMax (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return MinMax<BasicOps64>::findMinAndMax (src, num);
+       #else
+        return Range<double>::findMinAndMax (src, num);
+       #endif
+    }
+
+    template <typename Size>
+    float findMinimum (const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return MinMax<BasicOps32>::findMinOrMax (src, num, true);
+       #else
+        return juce::findMinimum (src, num);
+       #endif
+    }
+
+    template <typename Size>
+    double findMinimum (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return MinMax<BasicOps64>::findMinOrMax (src, num, true);
+       #else
+        return juce::findMinimum (src, num);
+       #endif
+    }
+
+    template <typename Size>
+    float findMaximum (const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return MinMax<BasicOps32>::findMinOrMax (src, num, false);
+       #else
+        return juce::findMaximum (src, num);
+       #endif
+    }
+
+    template <typename Size>
+    double findMaximum (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return MinMax<BasicOps64>::findMinOrMax (src, num, false);
+       #else
+        return juce::findMaximum (src, num);
+       #endif
+    }
+
+    template <typename Size>
+    void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
+    {
+       #if JUCE_USE_ARM_NEON
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
+                                  vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
+                                  JUCE_LOAD_NONE,
+                                  JUCE_INCREMENT_SRC_DEST, )
+       #else
+        JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
+                                      Mode::mul (mult, Mode::convertIntsU (src)),
+                                      JUCE_LOAD_NONE,
+                                      JUCE_INCREMENT_SRC_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+       #endif
+    }
+
+} // namespace
@@ -39,6 +39,10 @@
  #include <emmintrin.h>
 #endif
 
+#if JUCE_USE_AVX_INTRINSICS
+ #include <immintrin.h>
+#endif
+
 #if JUCE_MAC || JUCE_IOS
  #ifndef JUCE_USE_VDSP_FRAMEWORK
   #define JUCE_USE_VDSP_FRAMEWORK 1
@@ -58,8 +62,8 @@
  #include <arm_neon.h>
 #endif
 
-#include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
+#include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
 #include "buffers/juce_AudioProcessLoadMeasurer.cpp"
 #include "utilities/juce_IIRFilter.cpp"
@@ -68,6 +72,7 @@
 #include "utilities/juce_Interpolators.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
 #include "midi/juce_MidiBuffer.cpp"
+#include "midi/juce_MidiEventBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
@@ -105,4 +110,5 @@
 #if JUCE_UNIT_TESTS
  #include "utilities/juce_ADSR_test.cpp"
  #include "midi/ump/juce_UMP_test.cpp"
+ #include "synthesisers/juce_Synthesiser_test.cpp"
 #endif
@@ -70,6 +70,16 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
+// The AVX2 and AVX-512 versions of FloatVectorOperations are chosen at runtime, so
+// they don't need the rest of the project to be built for those instruction sets
+#if JUCE_USE_SSE_INTRINSICS && ! defined (JUCE_USE_AVX_INTRINSICS)
+ #define JUCE_USE_AVX_INTRINSICS 1
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX_INTRINSICS
+#endif
+
 #if __ARM_NEON__ && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
  #define JUCE_USE_ARM_NEON 1
 #endif
@@ -98,6 +108,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "utilities/juce_ADSR.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
+#include "midi/juce_MidiEventBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
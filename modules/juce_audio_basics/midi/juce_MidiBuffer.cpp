@@ -77,6 +77,37 @@ namespace MidiBufferHelpers
 
         return d;
     }
+
+    // Inserts an event after any others with the same time, searching from searchOffset,
+    // which is then moved to the end of the new event
+    static bool insertEvent (Array<uint8>& data, int& searchOffset, const void* newData, int maxBytes, int sampleNumber)
+    {
+        auto numBytes = findActualEventLength (static_cast<const uint8*> (newData), maxBytes);
+
+        if (numBytes <= 0)
+            return true;
+
+        if (std::numeric_limits<uint16>::max() < numBytes)
+        {
+            // This method only supports messages smaller than (1 << 16) bytes
+            return false;
+        }
+
+        auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
+        auto offset = (int) (findEventAfter (data.begin() + searchOffset, data.end(), sampleNumber) - data.begin());
+
+        data.insertMultiple (offset, 0, (int) newItemSize);
+
+        auto* d = data.begin() + offset;
+        writeUnaligned<int32>  (d, sampleNumber);
+        d += sizeof (int32);
+        writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
+        d += sizeof (uint16);
+        memcpy (d, newData, (size_t) numBytes);
+
+        searchOffset = offset + (int) newItemSize;
+        return true;
+    }
 }
 
 //==============================================================================
@@ -126,35 +157,17 @@ bool MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
 
 bool MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
 {
-    auto numBytes = MidiBufferHelpers::findActualEventLength (static_cast<const uint8*> (newData), maxBytes);
-
-    if (numBytes <= 0)
-        return true;
-
-    if (std::numeric_limits<uint16>::max() < numBytes)
-    {
-        // This method only supports messages smaller than (1 << 16) bytes
-        return false;
-    }
-
-    auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
-    auto offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
-
-    data.insertMultiple (offset, 0, (int) newItemSize);
-
-    auto* d = data.begin() + offset;
-    writeUnaligned<int32>  (d, sampleNumber);
-    d += sizeof (int32);
-    writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
-    d += sizeof (uint16);
-    memcpy (d, newData, (size_t) numBytes);
-
-    return true;
+    int searchOffset = 0;
+    return MidiBufferHelpers::insertEvent (data, searchOffset, newData, maxBytes, sampleNumber);
 }
 
 void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             int startSample, int numSamples, int sampleDeltaToAdd)
 {
+    // The source events are in order, so each one goes after the previous one, and
+    // the search for its position can start there rather than at the beginning
+    int searchOffset = 0;
+
     for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
     {
         const auto metadata = *i;
@@ -162,7 +175,8 @@ void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
         if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
             break;
 
-        addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd);
+        MidiBufferHelpers::insertEvent (data, searchOffset, metadata.data, metadata.numBytes,
+                                        metadata.samplePosition + sampleDeltaToAdd);
     }
 }
 
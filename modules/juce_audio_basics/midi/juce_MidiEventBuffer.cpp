@@ -0,0 +1,550 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+MidiEventBuffer::MidiEventBuffer (int maxEvents, int maxLongMessageBytes)
+{
+    ensureSize (maxEvents, maxLongMessageBytes);
+}
+
+MidiEventBuffer::MidiEventBuffer (const MidiBuffer& other)
+{
+    int total = 0, totalLongMessageBytes = 0;
+
+    for (const auto metadata : other)
+    {
+        ++total;
+
+        if (metadata.numBytes > Event::maxInlineBytes)
+            totalLongMessageBytes += metadata.numBytes;
+    }
+
+    ensureSize (total, totalLongMessageBytes);
+    addEvents (other, 0, -1, 0);
+}
+
+MidiEventBuffer::MidiEventBuffer (const MidiEventBuffer& other)
+{
+    operator= (other);
+}
+
+MidiEventBuffer& MidiEventBuffer::operator= (const MidiEventBuffer& other)
+{
+    if (this != &other)
+    {
+        clear();
+        ensureSize (other.maxNumEvents, other.maxNumLongMessageBytes);
+
+        std::copy (other.events.get(), other.events.get() + other.numEvents, events.get());
+        std::copy (other.longMessageData.get(), other.longMessageData.get() + other.numLongMessageBytes, longMessageData.get());
+
+        numEvents = other.numEvents;
+        numLongMessageBytes = other.numLongMessageBytes;
+        nextSequenceNumber = other.nextSequenceNumber;
+        needsSorting = other.needsSorting;
+    }
+
+    return *this;
+}
+
+MidiEventBuffer::MidiEventBuffer (MidiEventBuffer&& other) noexcept
+{
+    swapWith (other);
+}
+
+MidiEventBuffer& MidiEventBuffer::operator= (MidiEventBuffer&& other) noexcept
+{
+    MidiEventBuffer temp (std::move (other));
+    swapWith (temp);
+    return *this;
+}
+
+void MidiEventBuffer::swapWith (MidiEventBuffer& other) noexcept
+{
+    events.swapWith (other.events);
+    longMessageData.swapWith (other.longMessageData);
+    std::swap (maxNumEvents, other.maxNumEvents);
+    std::swap (maxNumLongMessageBytes, other.maxNumLongMessageBytes);
+    std::swap (numEvents, other.numEvents);
+    std::swap (numLongMessageBytes, other.numLongMessageBytes);
+    std::swap (nextSequenceNumber, other.nextSequenceNumber);
+    std::swap (needsSorting, other.needsSorting);
+}
+
+void MidiEventBuffer::ensureSize (int newMaxNumEvents, int newMaxNumLongMessageBytes)
+{
+    if (newMaxNumEvents > maxNumEvents)
+    {
+        events.realloc ((size_t) newMaxNumEvents);
+        maxNumEvents = newMaxNumEvents;
+    }
+
+    if (newMaxNumLongMessageBytes > maxNumLongMessageBytes)
+    {
+        longMessageData.realloc ((size_t) newMaxNumLongMessageBytes);
+        maxNumLongMessageBytes = newMaxNumLongMessageBytes;
+    }
+}
+
+//==============================================================================
+void MidiEventBuffer::clear() noexcept
+{
+    numEvents = 0;
+    numLongMessageBytes = 0;
+    nextSequenceNumber = 0;
+    needsSorting = false;
+}
+
+void MidiEventBuffer::clear (int start, int numSamples) noexcept
+{
+    const auto range = getEventsInRange (start, numSamples);
+
+    if (range.isEmpty())
+        return;
+
+    auto* first = events.get() + (range.first - begin());
+    auto* last  = events.get() + (range.last  - begin());
+
+    std::move (last, events.get() + numEvents, first);
+    numEvents -= (int) (last - first);
+
+    if (numEvents == 0)
+        clear();
+}
+
+bool MidiEventBuffer::addEvent (const MidiMessage& m, int sampleNumber) noexcept
+{
+    return addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
+}
+
+bool MidiEventBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber) noexcept
+{
+    auto* data = static_cast<const uint8*> (newData);
+    auto numBytes = MidiBufferHelpers::findActualEventLength (data, maxBytes);
+
+    if (numBytes <= 0)
+        return true;
+
+    return addEventUnchecked (data, numBytes, sampleNumber);
+}
+
+bool MidiEventBuffer::addEventUnchecked (const uint8* data, int numBytes, int sampleNumber) noexcept
+{
+    if (numEvents >= maxNumEvents || std::numeric_limits<uint16>::max() < numBytes)
+        return false;
+
+    auto& e = events[numEvents];
+    e.samplePosition = sampleNumber;
+    e.sequenceNumber = nextSequenceNumber;
+    e.numBytes = (uint16) numBytes;
+
+    if (numBytes <= Event::maxInlineBytes)
+    {
+        memcpy (e.inlineData, data, (size_t) numBytes);
+    }
+    else
+    {
+        if (numLongMessageBytes + numBytes > maxNumLongMessageBytes)
+            return false;
+
+        e.offset = (uint32) numLongMessageBytes;
+        memcpy (longMessageData + numLongMessageBytes, data, (size_t) numBytes);
+        numLongMessageBytes += numBytes;
+    }
+
+    if (numEvents > 0 && sampleNumber < events[numEvents - 1].samplePosition)
+        needsSorting = true;
+
+    ++numEvents;
+    ++nextSequenceNumber;
+    return true;
+}
+
+bool MidiEventBuffer::addEvents (const MidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept
+{
+    bool allAdded = true;
+
+    for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
+    {
+        const auto metadata = *i;
+
+        if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
+            break;
+
+        allAdded = addEventUnchecked (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd) && allAdded;
+    }
+
+    return allAdded;
+}
+
+bool MidiEventBuffer::addEvents (const MidiEventBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept
+{
+    const auto range = numSamples >= 0 ? otherBuffer.getEventsInRange (startSample, numSamples)
+                                       : EventRange { otherBuffer.findNextSamplePosition (startSample), otherBuffer.end() };
+    bool allAdded = true;
+
+    for (const auto metadata : range)
+        allAdded = addEventUnchecked (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd) && allAdded;
+
+    return allAdded;
+}
+
+void MidiEventBuffer::copyTo (MidiBuffer& destination) const
+{
+    constexpr auto headerSize = (int) (sizeof (int32) + sizeof (uint16));
+    int totalSize = 0;
+
+    for (const auto metadata : *this)
+        totalSize += headerSize + metadata.numBytes;
+
+    // The events are already sorted, so they can be written straight into the buffer's data
+    destination.data.resize (totalSize);
+    auto* d = destination.data.begin();
+
+    for (const auto metadata : *this)
+    {
+        writeUnaligned<int32>  (d, metadata.samplePosition);
+        writeUnaligned<uint16> (d + sizeof (int32), static_cast<uint16> (metadata.numBytes));
+        memcpy (d + headerSize, metadata.data, (size_t) metadata.numBytes);
+        d += headerSize + metadata.numBytes;
+    }
+}
+
+int MidiEventBuffer::getFirstEventTime() const noexcept
+{
+    sortIfNeeded();
+    return numEvents > 0 ? events[0].samplePosition : 0;
+}
+
+int MidiEventBuffer::getLastEventTime() const noexcept
+{
+    sortIfNeeded();
+    return numEvents > 0 ? events[numEvents - 1].samplePosition : 0;
+}
+
+//==============================================================================
+void MidiEventBuffer::sortIfNeeded() const noexcept
+{
+    if (! needsSorting)
+        return;
+
+    // Comparing the sequence numbers keeps events with the same time in the order in which
+    // they were added, without needing the temporary storage that std::stable_sort uses
+    std::sort (events.get(), events.get() + numEvents, [] (const Event& a, const Event& b)
+    {
+        return a.samplePosition != b.samplePosition ? a.samplePosition < b.samplePosition
+                                                    : a.sequenceNumber < b.sequenceNumber;
+    });
+
+    needsSorting = false;
+}
+
+MidiEventBuffer::Iterator MidiEventBuffer::begin() const noexcept
+{
+    sortIfNeeded();
+    return { events.get(), longMessageData.get() };
+}
+
+MidiEventBuffer::Iterator MidiEventBuffer::end() const noexcept
+{
+    return { events.get() + numEvents, longMessageData.get() };
+}
+
+MidiEventBuffer::Iterator MidiEventBuffer::findNextSamplePosition (int samplePosition) const noexcept
+{
+    sortIfNeeded();
+
+    auto* e = std::lower_bound (events.get(), events.get() + numEvents, samplePosition,
+                                [] (const Event& event, int position) { return event.samplePosition < position; });
+
+    return { e, longMessageData.get() };
+}
+
+MidiEventBuffer::EventRange MidiEventBuffer::getEventsInRange (int start, int numSamples) const noexcept
+{
+    auto first = findNextSamplePosition (start);
+
+    if (numSamples <= 0)
+        return { first, first };
+
+    const Event* endOfEvents = events.get() + numEvents;
+    auto* last = std::lower_bound (first.event, endOfEvents, start + numSamples,
+                                   [] (const Event& event, int position) { return event.samplePosition < position; });
+
+    return { first, Iterator (last, longMessageData.get()) };
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiEventBufferTest final : public UnitTest
+{
+    MidiEventBufferTest()
+        : UnitTest ("MidiEventBuffer", UnitTestCategories::midi)
+    {}
+
+    static Array<MidiMessage> getMessages (const MidiBuffer& buffer)
+    {
+        Array<MidiMessage> result;
+
+        for (const auto metadata : buffer)
+            result.add (metadata.getMessage());
+
+        return result;
+    }
+
+    static Array<MidiMessage> getMessages (const MidiEventBuffer& buffer)
+    {
+        Array<MidiMessage> result;
+
+        for (const auto metadata : buffer)
+            result.add (metadata.getMessage());
+
+        return result;
+    }
+
+    void expectSameMessages (const Array<MidiMessage>& a, const Array<MidiMessage>& b)
+    {
+        expectEquals (a.size(), b.size());
+
+        for (int i = 0; i < jmin (a.size(), b.size()); ++i)
+        {
+            expectEquals (a[i].getTimeStamp(), b[i].getTimeStamp());
+            expect (a[i].getRawDataSize() == b[i].getRawDataSize()
+                     && memcmp (a[i].getRawData(), b[i].getRawData(), (size_t) a[i].getRawDataSize()) == 0);
+        }
+    }
+
+    static MidiMessage createRandomMessage (Random& r)
+    {
+        if (r.nextInt (20) == 0)
+        {
+            uint8 sysexData[32];
+
+            for (auto& b : sysexData)
+                b = (uint8) r.nextInt (128);
+
+            return MidiMessage::createSysExMessage (sysexData, 1 + r.nextInt (numElementsInArray (sysexData) - 1));
+        }
+
+        switch (r.nextInt (4))
+        {
+            case 0:  return MidiMessage::noteOn (1 + r.nextInt (16), r.nextInt (128), (uint8) r.nextInt (128));
+            case 1:  return MidiMessage::controllerEvent (1 + r.nextInt (16), r.nextInt (128), r.nextInt (128));
+            case 2:  return MidiMessage::pitchWheel (1 + r.nextInt (16), r.nextInt (16384));
+            default: return MidiMessage::channelPressureChange (1 + r.nextInt (16), r.nextInt (128));
+        }
+    }
+
+    // Builds the events of a block of an MPE performance, with each channel's events
+    // generated as a separate stream, as if they came from separate sources
+    static Array<Array<MidiMessage>> createMPEStreams (int numChannels, int blockSize, int interval)
+    {
+        Array<Array<MidiMessage>> streams;
+
+        for (int channel = 2; channel < numChannels + 2; ++channel)
+        {
+            Array<MidiMessage> stream;
+            stream.add (MidiMessage::noteOn (channel, 48 + channel, (uint8) 100));
+
+            for (int time = channel % interval; time < blockSize; time += interval)
+            {
+                stream.add (MidiMessage::pitchWheel (channel, 8192 + time).withTimeStamp (time));
+                stream.add (MidiMessage::channelPressureChange (channel, time % 128).withTimeStamp (time));
+                stream.add (MidiMessage::controllerEvent (channel, 74, time % 128).withTimeStamp (time));
+            }
+
+            streams.add (stream);
+        }
+
+        return streams;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Adding and iterating");
+        {
+            MidiEventBuffer buffer (8, 16);
+            expect (buffer.isEmpty());
+
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 10));
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 61, (uint8) 100), 5));
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 62, (uint8) 100), 10));
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 63, (uint8) 100), 0));
+
+            const uint8 sysex[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+            expect (buffer.addEvent (MidiMessage::createSysExMessage (sysex, numElementsInArray (sysex)), 5));
+
+            expectEquals (buffer.getNumEvents(), 5);
+            expectEquals (buffer.getFirstEventTime(), 0);
+            expectEquals (buffer.getLastEventTime(), 10);
+
+            Array<int> notes, times;
+
+            for (const auto metadata : buffer)
+            {
+                const auto m = metadata.getMessage();
+                notes.add (m.isSysEx() ? m.getSysExDataSize() : m.getNoteNumber());
+                times.add (metadata.samplePosition);
+            }
+
+            expect (notes == Array<int> { 63, 61, 8, 60, 62 });
+            expect (times == Array<int> { 0, 5, 5, 10, 10 });
+
+            expectEquals (buffer.getEventsInRange (5, 1).size(), 2);
+            expectEquals (buffer.getEventsInRange (6, 4).size(), 0);
+            expectEquals (buffer.getEventsInRange (0, 100).size(), 5);
+            expectEquals ((*buffer.findNextSamplePosition (6)).samplePosition, 10);
+            expect (buffer.findNextSamplePosition (11) == buffer.end());
+        }
+
+        beginTest ("Capacity");
+        {
+            MidiEventBuffer buffer (2, 4);
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 0));
+
+            const uint8 sysex[] = { 1, 2, 3, 4, 5, 6 };
+            expect (! buffer.addEvent (MidiMessage::createSysExMessage (sysex, numElementsInArray (sysex)), 0));
+            expect (buffer.addEvent (MidiMessage::noteOff (1, 60), 1));
+            expect (! buffer.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 2));
+            expectEquals (buffer.getNumEvents(), 2);
+
+            buffer.ensureSize (3, 16);
+            expect (buffer.addEvent (MidiMessage::createSysExMessage (sysex, numElementsInArray (sysex)), 0));
+            expectEquals (buffer.getNumEvents(), 3);
+            expect (getMessages (buffer)[1].isSysEx());
+
+            buffer.clear();
+            expect (buffer.isEmpty());
+            expectEquals (buffer.getMaxNumEvents(), 3);
+        }
+
+        beginTest ("Clear range");
+        {
+            const auto message = MidiMessage::noteOn (1, 64, 0.5f);
+            MidiEventBuffer buffer (4);
+
+            for (auto time : { 30, 0, 20, 10 })
+                buffer.addEvent (message, time);
+
+            auto copy = buffer;
+            copy.clear (10, 0);
+            expectEquals (copy.getNumEvents(), 4);
+
+            copy.clear (10, 11);
+            expectEquals (copy.getNumEvents(), 2);
+            expectEquals (copy.getFirstEventTime(), 0);
+            expectEquals (copy.getLastEventTime(), 30);
+
+            copy.clear (0, 300);
+            expect (copy.isEmpty());
+            expectEquals (buffer.getNumEvents(), 4);
+        }
+
+        beginTest ("Matches MidiBuffer");
+        {
+            auto r = getRandom();
+
+            for (int i = 0; i < 20; ++i)
+            {
+                MidiBuffer midiBuffer;
+                MidiEventBuffer eventBuffer (200, 200 * 32);
+
+                for (int j = 0; j < 200; ++j)
+                {
+                    const auto message = createRandomMessage (r);
+                    const auto time = r.nextInt (64);
+                    midiBuffer.addEvent (message, time);
+                    expect (eventBuffer.addEvent (message, time));
+                }
+
+                expectSameMessages (getMessages (midiBuffer), getMessages (eventBuffer));
+                expectSameMessages (getMessages (midiBuffer), getMessages (MidiEventBuffer (midiBuffer)));
+
+                MidiBuffer converted;
+                eventBuffer.copyTo (converted);
+                expect (converted.data == midiBuffer.data);
+
+                const auto start = r.nextInt (64), length = r.nextInt (64);
+                midiBuffer.clear (start, length);
+                eventBuffer.clear (start, length);
+                expectSameMessages (getMessages (midiBuffer), getMessages (eventBuffer));
+
+                MidiBuffer mergedMidiBuffer;
+                mergedMidiBuffer.addEvents (midiBuffer, 10, 30, 5);
+                mergedMidiBuffer.addEvents (midiBuffer, 0, -1, 0);
+
+                MidiEventBuffer mergedEventBuffer (400, 400 * 32);
+                mergedEventBuffer.addEvents (eventBuffer, 10, 30, 5);
+                mergedEventBuffer.addEvents (midiBuffer, 0, -1, 0);
+                expectSameMessages (getMessages (mergedMidiBuffer), getMessages (mergedEventBuffer));
+            }
+        }
+
+        beginTest ("Merging MPE streams matches MidiBuffer");
+        {
+            constexpr int blockSize = 512;
+            const auto streams = createMPEStreams (15, blockSize, 4);
+
+            int totalEvents = 0;
+
+            for (auto& stream : streams)
+                totalEvents += stream.size();
+
+            MidiBuffer midiBuffer;
+            MidiEventBuffer eventBuffer (totalEvents);
+
+            for (auto& stream : streams)
+            {
+                for (auto& m : stream)
+                {
+                    midiBuffer.addEvent (m, (int) m.getTimeStamp());
+                    expect (eventBuffer.addEvent (m, (int) m.getTimeStamp()));
+                }
+            }
+
+            // Walks through the block one sample at a time, as a synth would
+            int midiBufferSum = 0, eventBufferSum = 0;
+
+            for (int sample = 0; sample < blockSize; ++sample)
+            {
+                for (auto i = midiBuffer.findNextSamplePosition (sample); i != midiBuffer.cend() && (*i).samplePosition == sample; ++i)
+                    midiBufferSum += (*i).data[0];
+
+                for (const auto metadata : eventBuffer.getEventsInRange (sample, 1))
+                    eventBufferSum += metadata.data[0];
+            }
+
+            expectEquals (eventBufferSum, midiBufferSum);
+            expectSameMessages (getMessages (midiBuffer), getMessages (eventBuffer));
+        }
+    }
+};
+
+static MidiEventBufferTest midiEventBufferTest;
+
+#endif
+
+} // namespace juce
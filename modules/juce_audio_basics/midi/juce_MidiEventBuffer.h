@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fixed-capacity buffer of time-stamped midi events, designed for merging
+    many streams of events on the audio thread.
+
+    This holds the same kind of data as a MidiBuffer, but stores it differently:
+    each event lives in a fixed-size slot in a preallocated array, with short
+    messages stored inside the slot itself and longer ones (e.g. sysex) copied
+    into a separate preallocated block of bytes.
+
+    That means that:
+    - Adding an event never allocates or moves other events - it just fills in
+      the next slot. If the buffer is full, addEvent() returns false.
+    - Events can be added in any order. Sorting is deferred until the events are
+      next read, and is stable, so events with the same sample position are
+      kept in the order in which they were added, just like in a MidiBuffer.
+    - Finding the events at a particular sample position is a binary search, so
+      walking through a block one sample or sub-block at a time with
+      getEventsInRange() doesn't rescan the buffer each time.
+
+    Because reading the buffer may sort it, you shouldn't read the same buffer
+    from more than one thread at once unless it's already been sorted by a
+    previous read.
+
+    @see MidiBuffer
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiEventBuffer
+{
+public:
+    //==============================================================================
+    /** Creates an empty buffer with no space for any events.
+        Call ensureSize() before adding events to it.
+    */
+    MidiEventBuffer() noexcept = default;
+
+    /** Creates an empty buffer with space for the given number of events.
+
+        @param maxNumEvents         the maximum number of events the buffer can hold
+        @param maxNumLongMessageBytes   the total number of bytes available for messages
+                                    that are too long to be held in an event's slot,
+                                    such as sysex messages
+    */
+    MidiEventBuffer (int maxNumEvents, int maxNumLongMessageBytes = 0);
+
+    /** Creates a buffer containing the events in a MidiBuffer, with just enough
+        space to hold them.
+    */
+    explicit MidiEventBuffer (const MidiBuffer&);
+
+    /** Creates a copy of another buffer, with the same capacity. */
+    MidiEventBuffer (const MidiEventBuffer&);
+
+    /** Replaces this buffer's contents with a copy of another one's. */
+    MidiEventBuffer& operator= (const MidiEventBuffer&);
+
+    /** Move constructor */
+    MidiEventBuffer (MidiEventBuffer&&) noexcept;
+
+    /** Move assignment operator */
+    MidiEventBuffer& operator= (MidiEventBuffer&&) noexcept;
+
+    //==============================================================================
+    /** Makes sure that the buffer can hold at least the given number of events and
+        long message bytes, keeping its existing contents.
+        This is the only method that may allocate memory.
+    */
+    void ensureSize (int maxNumEvents, int maxNumLongMessageBytes = 0);
+
+    /** Returns the maximum number of events that the buffer can hold. */
+    int getMaxNumEvents() const noexcept                        { return maxNumEvents; }
+
+    /** Returns the number of bytes available for messages that don't fit in an event's slot. */
+    int getMaxNumLongMessageBytes() const noexcept              { return maxNumLongMessageBytes; }
+
+    /** Exchanges the contents of this buffer with another one, without copying anything. */
+    void swapWith (MidiEventBuffer&) noexcept;
+
+    //==============================================================================
+    /** Removes all events from the buffer. */
+    void clear() noexcept;
+
+    /** Removes all events between two times from the buffer.
+
+        All events for which (start <= event position < start + numSamples) will
+        be removed. The space used by any long messages that are removed isn't
+        reclaimed until the buffer is cleared or becomes empty.
+    */
+    void clear (int start, int numSamples) noexcept;
+
+    /** Returns true if the buffer is empty. */
+    bool isEmpty() const noexcept                               { return numEvents == 0; }
+
+    /** Returns the number of events in the buffer. */
+    int getNumEvents() const noexcept                           { return numEvents; }
+
+    /** Adds an event to the buffer.
+
+        The MidiMessage's timestamp is ignored, and the sample number is used instead.
+        If an event is added whose sample position is the same as one or more events
+        already in the buffer, the new event will be placed after the existing ones.
+
+        Returns false if the buffer didn't have space for the event.
+    */
+    bool addEvent (const MidiMessage& midiMessage, int sampleNumber) noexcept;
+
+    /** Adds an event to the buffer from raw midi data.
+
+        As with MidiBuffer::addEvent(), the data is inspected to find the real length
+        of the message, which may be less than maxBytesOfMidiData, and invalid data
+        may not produce an event at all.
+
+        Returns false if the buffer didn't have space for the event.
+    */
+    bool addEvent (const void* rawMidiData, int maxBytesOfMidiData, int sampleNumber) noexcept;
+
+    /** Adds some events from a MidiBuffer to this one.
+
+        The parameters have the same meaning as in MidiBuffer::addEvents(). Returns false
+        if the buffer ran out of space, in which case some of the events will be missing.
+    */
+    bool addEvents (const MidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    /** Adds some events from another MidiEventBuffer to this one.
+
+        The parameters have the same meaning as in MidiBuffer::addEvents(). Returns false
+        if the buffer ran out of space, in which case some of the events will be missing.
+    */
+    bool addEvents (const MidiEventBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    /** Replaces the contents of a MidiBuffer with the events in this buffer. */
+    void copyTo (MidiBuffer& destination) const;
+
+    /** Returns the sample number of the first event in the buffer.
+        If the buffer's empty, this will just return 0.
+    */
+    int getFirstEventTime() const noexcept;
+
+    /** Returns the sample number of the last event in the buffer.
+        If the buffer's empty, this will just return 0.
+    */
+    int getLastEventTime() const noexcept;
+
+private:
+    struct Event
+    {
+        static constexpr int maxInlineBytes = 4;
+
+        int32 samplePosition;
+        uint32 sequenceNumber;
+        uint16 numBytes;
+        uint8 inlineData[maxInlineBytes];
+        uint32 offset;
+    };
+
+public:
+    //==============================================================================
+    /** An iterator over the events in a MidiEventBuffer. */
+    class JUCE_API  Iterator
+    {
+    public:
+        Iterator() = default;
+
+        using difference_type   = ptrdiff_t;
+        using value_type        = MidiMessageMetadata;
+        using reference         = MidiMessageMetadata;
+        using pointer           = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+        Iterator& operator++() noexcept                                 { ++event; return *this; }
+        Iterator operator++ (int) noexcept                              { auto copy = *this; ++event; return copy; }
+        Iterator& operator--() noexcept                                 { --event; return *this; }
+        Iterator operator-- (int) noexcept                              { auto copy = *this; --event; return copy; }
+        Iterator& operator+= (difference_type n) noexcept               { event += n; return *this; }
+        Iterator& operator-= (difference_type n) noexcept               { event -= n; return *this; }
+        Iterator operator+ (difference_type n) const noexcept           { return { event + n, longMessageData }; }
+        Iterator operator- (difference_type n) const noexcept           { return { event - n, longMessageData }; }
+        difference_type operator- (const Iterator& other) const noexcept { return event - other.event; }
+        reference operator[] (difference_type n) const noexcept         { return *(*this + n); }
+
+        bool operator== (const Iterator& other) const noexcept          { return event == other.event; }
+        bool operator!= (const Iterator& other) const noexcept          { return event != other.event; }
+        bool operator<  (const Iterator& other) const noexcept          { return event <  other.event; }
+        bool operator>  (const Iterator& other) const noexcept          { return event >  other.event; }
+        bool operator<= (const Iterator& other) const noexcept          { return event <= other.event; }
+        bool operator>= (const Iterator& other) const noexcept          { return event >= other.event; }
+
+        /** Returns a description of the event to which the iterator is pointing.
+            The data it points to remains valid until the buffer is next modified.
+        */
+        reference operator*() const noexcept
+        {
+            return { event->numBytes <= Event::maxInlineBytes ? event->inlineData
+                                                              : longMessageData + event->offset,
+                     event->numBytes,
+                     event->samplePosition };
+        }
+
+    private:
+        friend class MidiEventBuffer;
+
+        Iterator (const Event* e, const uint8* longData) noexcept
+            : event (e), longMessageData (longData) {}
+
+        const Event* event = nullptr;
+        const uint8* longMessageData = nullptr;
+    };
+
+    /** A range of events within a MidiEventBuffer, which can be used in a range-based for loop. */
+    struct EventRange
+    {
+        Iterator begin() const noexcept     { return first; }
+        Iterator end() const noexcept       { return last; }
+        bool isEmpty() const noexcept       { return first == last; }
+        int size() const noexcept           { return (int) (last - first); }
+
+        Iterator first, last;
+    };
+
+    /** Returns an iterator pointing to the first event in the buffer. */
+    Iterator begin() const noexcept;
+
+    /** Returns an iterator pointing one past the last event in the buffer. */
+    Iterator end() const noexcept;
+
+    /** Returns an iterator pointing to the first event in the buffer. */
+    Iterator cbegin() const noexcept                            { return begin(); }
+
+    /** Returns an iterator pointing one past the last event in the buffer. */
+    Iterator cend() const noexcept                              { return end(); }
+
+    /** Returns an iterator pointing to the first event with a timestamp greater-than or
+        equal-to `samplePosition`. This is a binary search.
+    */
+    Iterator findNextSamplePosition (int samplePosition) const noexcept;
+
+    /** Returns the events for which (start <= event position < start + numSamples). */
+    EventRange getEventsInRange (int start, int numSamples) const noexcept;
+
+private:
+    //==============================================================================
+    void sortIfNeeded() const noexcept;
+    bool addEventUnchecked (const uint8* data, int numBytes, int sampleNumber) noexcept;
+
+    mutable HeapBlock<Event> events;
+    HeapBlock<uint8> longMessageData;
+    int maxNumEvents = 0, maxNumLongMessageBytes = 0;
+    int numEvents = 0, numLongMessageBytes = 0;
+    uint32 nextSequenceNumber = 0;
+    mutable bool needsSorting = false;
+
+    JUCE_LEAK_DETECTOR (MidiEventBuffer)
+};
+
+} // namespace juce
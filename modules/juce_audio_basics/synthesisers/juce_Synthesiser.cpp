@@ -72,6 +72,16 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+bool SynthesiserVoice::renderVoiceBatch (Span<SynthesiserVoice* const>, AudioBuffer<float>&, int, int)
+{
+    return false;
+}
+
+bool SynthesiserVoice::renderVoiceBatch (Span<SynthesiserVoice* const>, AudioBuffer<double>&, int, int)
+{
+    return false;
+}
+
 //==============================================================================
 Synthesiser::Synthesiser()
 {
@@ -104,6 +114,7 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
         const ScopedLock sl (lock);
         newVoice->setCurrentPlaybackSampleRate (sampleRate);
         voice = voices.add (newVoice);
+        voicesToRenderInBatches.ensureStorageAllocated (voices.size());
     }
 
     {
@@ -150,6 +161,12 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setBatchedVoiceRenderingEnabled (bool shouldRenderInBatches) noexcept
+{
+    const ScopedLock sl (lock);
+    renderVoicesInBatches = shouldRenderInBatches;
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -241,16 +258,60 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (renderVoicesInBatches)
+    {
+        renderVoiceBatches (buffer, startSample, numSamples);
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (renderVoicesInBatches)
+    {
+        renderVoiceBatches (buffer, startSample, numSamples);
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
+template <typename floatType>
+void Synthesiser::renderVoiceBatches (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
+{
+    // The storage for this array is reserved in addVoice(), so filling it won't allocate
+    voicesToRenderInBatches.clearQuick();
+
+    for (auto* voice : voices)
+        if (voice->isVoiceActive())
+            voicesToRenderInBatches.add (voice);
+
+    auto* groupStart = voicesToRenderInBatches.begin();
+    auto* const end = voicesToRenderInBatches.end();
+
+    while (groupStart != end)
+    {
+        const std::type_index type (typeid (**groupStart));
+
+        auto* const groupEnd = std::partition (groupStart, end, [&type] (SynthesiserVoice* v)
+        {
+            return std::type_index (typeid (*v)) == type;
+        });
+
+        const Span<SynthesiserVoice* const> group (groupStart, (size_t) (groupEnd - groupStart));
+
+        if (! group.front()->renderVoiceBatch (group, buffer, startSample, numSamples))
+            for (auto* voice : group)
+                voice->renderNextBlock (buffer, startSample, numSamples);
+
+        groupStart = groupEnd;
+    }
+}
+
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
 {
     const int channel = m.getChannel();
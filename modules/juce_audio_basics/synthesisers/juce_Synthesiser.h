@@ -192,6 +192,36 @@ public:
                                   int startSample,
                                   int numSamples);
 
+    /** Renders the next block of data for a group of voices that all have the same class.
+
+        When batched rendering has been turned on with Synthesiser::setBatchedVoiceRenderingEnabled(),
+        the synthesiser sorts its active voices into groups whose dynamic type is the same,
+        and calls this method on the first voice of each group, instead of calling
+        renderNextBlock() on each of the voices in turn.
+
+        By overriding this, a voice class can keep the state of all its voices in a
+        structure-of-arrays layout and render them together, e.g. with one voice in each
+        lane of a dsp::SIMDRegister. The same rules apply as for renderNextBlock(): the output
+        must be added to the buffer, and any voice that finishes during the block must have
+        clearCurrentNote() called on it.
+
+        The voices in the group are all active, and may be in any order.
+
+        @returns true if the voices have been rendered, or false if they should each be
+                 rendered by calling renderNextBlock() instead, which is what the default
+                 implementation does
+    */
+    virtual bool renderVoiceBatch (Span<SynthesiserVoice* const> voicesToRender,
+                                   AudioBuffer<float>& outputBuffer,
+                                   int startSample,
+                                   int numSamples);
+
+    /** A double-precision version of renderVoiceBatch() */
+    virtual bool renderVoiceBatch (Span<SynthesiserVoice* const> voicesToRender,
+                                   AudioBuffer<double>& outputBuffer,
+                                   int startSample,
+                                   int numSamples);
+
     /** Changes the voice's reference sample rate.
 
         The rate is set so that subclasses know the output rate and can set their pitch
@@ -557,6 +587,30 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Enables or disables batched voice rendering.
+
+        When this is enabled, the default implementation of renderVoices() skips any voices
+        that aren't active, gathers the remaining ones into groups of the same class, and
+        hands each group to SynthesiserVoice::renderVoiceBatch() in a single call. A voice
+        class that implements that method can then render all of its voices together with
+        SIMD operations, rather than paying for a virtual call and a short loop for every
+        voice in every sub-block.
+
+        Each sub-block still costs one call per group of voices, so with dense midi it's
+        worth combining this with a larger minimum sub-block size, set with
+        setMinimumRenderingSubdivisionSize(). Events will then be accurate to that number
+        of samples.
+
+        Voice classes that don't override renderVoiceBatch() are rendered individually, so
+        it's always safe to turn this on. It's disabled by default.
+    */
+    void setBatchedVoiceRenderingEnabled (bool shouldRenderInBatches) noexcept;
+
+    /** Returns true if batched voice rendering is enabled.
+        @see setBatchedVoiceRenderingEnabled
+    */
+    bool isBatchedVoiceRenderingEnabled() const noexcept            { return renderVoicesInBatches; }
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -569,8 +623,8 @@ protected:
     int lastPitchWheelValues [16];
 
     /** Renders the voices for the given range.
-        By default this just calls renderNextBlock() on each voice, but you may need
-        to override it to handle custom cases.
+        By default this just calls renderNextBlock() on each voice, or renders them in groups
+        if batched rendering is enabled, but you may need to override it to handle custom cases.
     */
     virtual void renderVoices (AudioBuffer<float>& outputAudio,
                                int startSample, int numSamples);
@@ -626,13 +680,18 @@ private:
     int minimumSubBlockSize = 32;
     bool subBlockSubdivisionIsStrict = false;
     bool shouldStealNotes = true;
+    bool renderVoicesInBatches = false;
     BigInteger sustainPedalsDown;
     mutable CriticalSection stealLock;
     mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
+    Array<SynthesiserVoice*> voicesToRenderInBatches;
 
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
+    template <typename floatType>
+    void renderVoiceBatches (AudioBuffer<floatType>&, int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Synthesiser)
 };
 
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct SynthesiserTests final : public UnitTest
+{
+    SynthesiserTests()  : UnitTest ("Synthesiser", UnitTestCategories::audio)  {}
+
+    struct TestSound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // Plays a decaying sawtooth, and finishes by itself once it has decayed.
+    template <bool canRenderInBatches>
+    struct TestVoice final : public SynthesiserVoice
+    {
+        explicit TestVoice (std::vector<int>& batchSizesIn)  : batchSizes (batchSizesIn) {}
+
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            level = velocity;
+            phase = 0.0f;
+            increment = (float) (MidiMessage::getMidiNoteInHertz (note) / getSampleRate());
+        }
+
+        void stopNote (float, bool) override
+        {
+            level = 0.0f;
+            clearCurrentNote();
+        }
+
+        void pitchWheelMoved (int) override {}
+        void controllerMoved (int, int) override {}
+
+        template <typename floatType>
+        void render (AudioBuffer<floatType>& output, int startSample, int numSamples)
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto sample = (floatType) (level * (2.0f * phase - 1.0f));
+
+                for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                    output.addSample (ch, i, sample);
+
+                phase += increment;
+                phase -= std::floor (phase);
+                level *= 0.999f;
+
+                if (level < 0.05f)
+                {
+                    stopNote (0.0f, false);
+                    return;
+                }
+            }
+        }
+
+        template <typename floatType>
+        bool renderBatch (Span<SynthesiserVoice* const> group, AudioBuffer<floatType>& output, int startSample, int numSamples)
+        {
+            if (! canRenderInBatches)
+                return false;
+
+            batchSizes.push_back ((int) group.size());
+
+            for (auto* voice : group)
+                static_cast<TestVoice*> (voice)->render (output, startSample, numSamples);
+
+            return true;
+        }
+
+        void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            render (output, startSample, numSamples);
+        }
+
+        void renderNextBlock (AudioBuffer<double>& output, int startSample, int numSamples) override
+        {
+            render (output, startSample, numSamples);
+        }
+
+        bool renderVoiceBatch (Span<SynthesiserVoice* const> group, AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            return renderBatch (group, output, startSample, numSamples);
+        }
+
+        bool renderVoiceBatch (Span<SynthesiserVoice* const> group, AudioBuffer<double>& output, int startSample, int numSamples) override
+        {
+            return renderBatch (group, output, startSample, numSamples);
+        }
+
+        std::vector<int>& batchSizes;
+        float level = 0.0f, phase = 0.0f, increment = 0.0f;
+    };
+
+    template <typename floatType>
+    AudioBuffer<floatType> renderSynth (bool useBatches, std::vector<int>& batchSizes)
+    {
+        Synthesiser synth;
+        synth.addSound (new TestSound());
+
+        for (int i = 0; i < 8; ++i)
+        {
+            if ((i % 3) == 2)
+                synth.addVoice (new TestVoice<false> (batchSizes));
+            else
+                synth.addVoice (new TestVoice<true> (batchSizes));
+        }
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.setBatchedVoiceRenderingEnabled (useBatches);
+
+        constexpr int blockSize = 512;
+        constexpr int numBlocks = 8;
+
+        MidiBuffer midi;
+
+        for (int i = 0; i < 12; ++i)
+        {
+            midi.addEvent (MidiMessage::noteOn (1, 48 + i * 3, 0.8f), i * 173);
+            midi.addEvent (MidiMessage::noteOff (1, 48 + i * 3), i * 173 + 900);
+        }
+
+        AudioBuffer<floatType> output (2, blockSize * numBlocks);
+        output.clear();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            MidiBuffer blockMidi;
+            blockMidi.addEvents (midi, block * blockSize, blockSize, -block * blockSize);
+            synth.renderNextBlock (output, blockMidi, block * blockSize, blockSize);
+        }
+
+        return output;
+    }
+
+    template <typename floatType>
+    void testBatchedOutputMatches()
+    {
+        std::vector<int> batchSizes;
+        const auto unbatched = renderSynth<floatType> (false, batchSizes);
+        expect (batchSizes.empty());
+
+        const auto batched = renderSynth<floatType> (true, batchSizes);
+        expect (! batchSizes.empty());
+        expect (std::all_of (batchSizes.begin(), batchSizes.end(), [] (int size) { return size > 0 && size <= 6; }));
+
+        auto maxError = 0.0;
+
+        for (int ch = 0; ch < batched.getNumChannels(); ++ch)
+            for (int i = 0; i < batched.getNumSamples(); ++i)
+                maxError = jmax (maxError, (double) std::abs (batched.getSample (ch, i) - unbatched.getSample (ch, i)));
+
+        expectLessThan (maxError, 1.0e-5);
+        expectGreaterThan ((double) unbatched.getMagnitude (0, unbatched.getNumSamples()), 0.1);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Batched rendering produces the same output as rendering each voice");
+        {
+            testBatchedOutputMatches<float>();
+        }
+
+        beginTest ("Batched rendering works with double precision buffers");
+        {
+            testBatchedOutputMatches<double>();
+        }
+
+        beginTest ("Batched rendering is disabled by default");
+        {
+            Synthesiser synth;
+            expect (! synth.isBatchedVoiceRenderingEnabled());
+
+            synth.setBatchedVoiceRenderingEnabled (true);
+            expect (synth.isBatchedVoiceRenderingEnabled());
+        }
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+} // namespace juce
@@ -192,6 +192,82 @@ static const char* const flacFormatName = "FLAC file";
 template <typename Item>
 auto emptyRange (Item item) { return Range<Item>::emptyRange (item); }
 
+//==============================================================================
+// The first sample and byte position of every frame in a FLAC stream
+struct FlacSeekIndex
+{
+    size_t findFrameContaining (int64 sample) const noexcept
+    {
+        jassert (! frameStarts.empty());
+
+        if (fixedBlockSize > 0)
+            return (size_t) jmin ((int64) frameStarts.size() - 1, sample / fixedBlockSize);
+
+        const auto next = std::upper_bound (frameStarts.begin(), frameStarts.end(), sample);
+        return (size_t) jmax ((int64) 0, (int64) std::distance (frameStarts.begin(), next) - 1);
+    }
+
+    std::vector<int64> frameStarts, frameOffsets;
+
+    // If every frame apart from the last one has the same length, this holds that length,
+    // so that frames can be found without searching
+    int64 fixedBlockSize = 0;
+};
+
+class FlacSeekIndexCache
+{
+public:
+    static FlacSeekIndexCache& getInstance()
+    {
+        static FlacSeekIndexCache cache;
+        return cache;
+    }
+
+    template <typename CreateIndex>
+    std::shared_ptr<const FlacSeekIndex> getOrCreate (const File& file, CreateIndex&& createIndex)
+    {
+        const auto modificationTime = file.getLastModificationTime();
+        const auto size = file.getSize();
+
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+            const auto iter = indexes.find (file.getFullPathName());
+
+            if (iter != indexes.end() && iter->second.modificationTime == modificationTime && iter->second.size == size)
+                return iter->second.index;
+        }
+
+        // Several threads could end up building the same index here, but that's better
+        // than making them all wait for one of them
+        std::shared_ptr<const FlacSeekIndex> index = createIndex();
+
+        if (index != nullptr)
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+            indexes[file.getFullPathName()] = { modificationTime, size, index };
+        }
+
+        return index;
+    }
+
+    void clear()
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        indexes.clear();
+    }
+
+private:
+    struct Entry
+    {
+        Time modificationTime;
+        int64 size;
+        std::shared_ptr<const FlacSeekIndex> index;
+    };
+
+    std::map<String, Entry> indexes;
+    std::mutex mutex;
+};
+
 //==============================================================================
 class FlacReader final : public AudioFormatReader
 {
@@ -231,6 +307,62 @@ public:
         FlacNamespace::FLAC__stream_decoder_delete (decoder);
     }
 
+    // Scans through the frames of the stream without decoding their audio, and returns
+    // the position of each of them. The decoder is left at the start of the first frame.
+    std::shared_ptr<const FlacSeekIndex> createSeekIndex()
+    {
+        if (! ok)
+            return {};
+
+        auto index = std::make_shared<FlacSeekIndex>();
+        FlacNamespace::FLAC__uint64 firstFramePosition = 0;
+
+        if (! FLAC__stream_decoder_get_decode_position (decoder, &firstFramePosition))
+            return {};
+
+        for (int64 nextFrameStart = 0;;)
+        {
+            FlacNamespace::FLAC__uint64 framePosition = 0;
+
+            if (! FLAC__stream_decoder_get_decode_position (decoder, &framePosition)
+                || ! FLAC__stream_decoder_skip_single_frame (decoder))
+                return {};
+
+            if (FLAC__stream_decoder_get_state (decoder) == FlacNamespace::FLAC__STREAM_DECODER_END_OF_STREAM)
+                break;
+
+            index->frameStarts.push_back (nextFrameStart);
+            index->frameOffsets.push_back ((int64) framePosition);
+            nextFrameStart += (int64) FLAC__stream_decoder_get_blocksize (decoder);
+        }
+
+        FLAC__stream_decoder_flush (decoder);
+        input->setPosition ((int64) firstFramePosition);
+
+        if (index->frameStarts.empty())
+            return {};
+
+        if (index->frameStarts.size() > 1)
+        {
+            const auto firstBlockSize = index->frameStarts[1];
+            auto isFixed = true;
+
+            for (size_t i = 1; i + 1 < index->frameStarts.size() && isFixed; ++i)
+                isFixed = index->frameStarts[i + 1] - index->frameStarts[i] == firstBlockSize;
+
+            index->fixedBlockSize = isFixed ? firstBlockSize : 0;
+        }
+
+        return index;
+    }
+
+    void useSeekIndex (std::shared_ptr<const FlacSeekIndex> newIndex)
+    {
+        seekIndex = std::move (newIndex);
+    }
+
+    std::shared_ptr<const FlacSeekIndex> getSeekIndex() const noexcept     { return seekIndex; }
+
     void useMetadata (const FlacNamespace::FLAC__StreamMetadata_StreamInfo& info)
     {
         sampleRate = info.sample_rate;
@@ -273,6 +405,24 @@ public:
                 return;
             }
 
+            if (seekIndex != nullptr)
+            {
+                const auto frame = seekIndex->findFrameContaining (requestedStart);
+                const auto frameStart = seekIndex->frameStarts[frame];
+
+                // If the requested sample isn't in the next frame, jump straight to the frame that
+                // contains it, rather than letting the decoder search for it
+                if (requestedStart < bufferedRange.getStart() || frameStart != bufferedRange.getEnd())
+                {
+                    FLAC__stream_decoder_flush (decoder);
+                    input->setPosition (seekIndex->frameOffsets[frame]);
+                }
+
+                bufferedRange = emptyRange (frameStart);
+                FLAC__stream_decoder_process_single (decoder);
+                return;
+            }
+
             if (requestedStart < bufferedRange.getStart()
                 || jmax (bufferedRange.getEnd(), bufferedRange.getStart() + (int64) 511) < requestedStart)
             {
@@ -344,7 +494,7 @@ public:
 
     static FlacNamespace::FLAC__StreamDecoderSeekStatus seekCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__uint64 absolute_byte_offset, void* client_data)
     {
-        static_cast<const FlacReader*> (client_data)->input->setPosition ((int) absolute_byte_offset);
+        static_cast<const FlacReader*> (client_data)->input->setPosition ((int64) absolute_byte_offset);
         return FlacNamespace::FLAC__STREAM_DECODER_SEEK_STATUS_OK;
     }
 
@@ -385,15 +535,68 @@ public:
     {
     }
 
+    bool isOk() const noexcept          { return ok; }
+
 private:
     FlacNamespace::FLAC__StreamDecoder* decoder;
     AudioBuffer<float> reservoir;
     Range<int64> bufferedRange;
     bool ok = false, scanningForLength = false;
+    std::shared_ptr<const FlacSeekIndex> seekIndex;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
 };
 
+//==============================================================================
+// Decodes a FLAC file from a memory-mapped view of it.
+//
+// Unlike the PCM formats, there's no simple way to work out where a sample lives in the file,
+// so the whole file is always mapped, whatever section is asked for. This also means that
+// touchSample() can only touch the start of the file, and getSample() has to decode the frame
+// that contains the sample.
+class MemoryMappedFlacReader final : public MemoryMappedAudioFormatReader
+{
+public:
+    MemoryMappedFlacReader (const File& f, std::unique_ptr<MemoryMappedFile> mappedFile, std::unique_ptr<FlacReader> reader)
+        : MemoryMappedAudioFormatReader (f, *reader, 0, (int64) mappedFile->getSize(), 0),
+          decoder (std::move (reader))
+    {
+        map = std::move (mappedFile);
+        mappedSection = { 0, lengthInSamples };
+    }
+
+    bool mapSectionOfFile (Range<int64>) override
+    {
+        return map != nullptr;
+    }
+
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        return decoder->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+    }
+
+    void getSample (int64 sampleIndex, float* result) const noexcept override
+    {
+        // FLAC streams can't have more than 8 channels
+        float* channels[8] {};
+        const auto numChannelsToRead = jmin ((int) numChannels, (int) std::size (channels));
+
+        for (int i = 0; i < numChannelsToRead; ++i)
+            channels[i] = result + i;
+
+        decoder->read (channels, numChannelsToRead, sampleIndex, 1);
+    }
+
+    std::shared_ptr<const FlacSeekIndex> getSeekIndex() const noexcept     { return decoder->getSeekIndex(); }
+
+private:
+    // This decodes from the memory that's mapped by the base class, so it must be deleted first
+    std::unique_ptr<FlacReader> decoder;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedFlacReader)
+};
+
 
 //==============================================================================
 class FlacWriter final : public AudioFormatWriter
@@ -577,6 +780,7 @@ Array<int> FlacAudioFormat::getPossibleBitDepths()
 bool FlacAudioFormat::canDoStereo()     { return true; }
 bool FlacAudioFormat::canDoMono()       { return true; }
 bool FlacAudioFormat::isCompressed()    { return true; }
+bool FlacAudioFormat::canUseReadersConcurrently() { return true; }
 
 AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails)
 {
@@ -591,6 +795,33 @@ AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool
     return nullptr;
 }
 
+MemoryMappedAudioFormatReader* FlacAudioFormat::createMemoryMappedReader (const File& file)
+{
+    auto mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() == nullptr)
+        return nullptr;
+
+    auto r = std::make_unique<FlacReader> (new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false));
+
+    if (! r->isOk() || r->sampleRate <= 0)
+        return nullptr;
+
+    r->useSeekIndex (FlacSeekIndexCache::getInstance().getOrCreate (file, [&r] { return r->createSeekIndex(); }));
+    return new MemoryMappedFlacReader (file, std::move (mappedFile), std::move (r));
+}
+
+MemoryMappedAudioFormatReader* FlacAudioFormat::createMemoryMappedReader (FileInputStream* fin)
+{
+    const std::unique_ptr<FileInputStream> stream (fin);
+    return stream != nullptr ? createMemoryMappedReader (stream->getFile()) : nullptr;
+}
+
+void FlacAudioFormat::clearSeekIndexCache()
+{
+    FlacSeekIndexCache::getInstance().clear();
+}
+
 AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
@@ -614,6 +845,177 @@ StringArray FlacAudioFormat::getQualityOptions()
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FlacAudioFormatTests final : public UnitTest
+{
+public:
+    FlacAudioFormatTests()
+        : UnitTest ("FLAC audio format", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        FlacAudioFormat format;
+        TemporaryFile tempFile (".flac");
+
+        // A tone with some noise on top, so that the frames compress by different amounts
+        AudioBuffer<float> original (2, 10 * 44100 + random.nextInt (4096));
+
+        for (int channel = 0; channel < original.getNumChannels(); ++channel)
+        {
+            for (int sample = 0; sample < original.getNumSamples(); ++sample)
+            {
+                const auto value = 0.5f * std::sin ((float) sample * 0.01f * (float) (channel + 1))
+                                 + 0.1f * (random.nextFloat() - 0.5f);
+                original.setSample (channel, sample, (float) roundToInt (value * 32767.0f) / 32768.0f);
+            }
+        }
+
+        beginTest ("Memory-mapped readers report the same properties as stream readers");
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (tempFile.getFile().createOutputStream().release(),
+                                                                               44100.0, 2, 16, {}, 0));
+            expect (writer != nullptr);
+            writer->writeFromAudioSampleBuffer (original, 0, original.getNumSamples());
+        }
+
+        std::unique_ptr<AudioFormatReader> streamReader (format.createReaderFor (tempFile.getFile().createInputStream().release(), true));
+        std::unique_ptr<MemoryMappedAudioFormatReader> mappedReader (format.createMemoryMappedReader (tempFile.getFile()));
+
+        expect (streamReader != nullptr);
+        expect (mappedReader != nullptr);
+
+        if (streamReader == nullptr || mappedReader == nullptr)
+            return;
+
+        {
+            expectEquals (mappedReader->lengthInSamples, (int64) original.getNumSamples());
+            expectEquals (mappedReader->lengthInSamples, streamReader->lengthInSamples);
+            expect (mappedReader->numChannels == streamReader->numChannels);
+            expectEquals (mappedReader->sampleRate, streamReader->sampleRate);
+        }
+
+        beginTest ("Memory-mapped readers read the same audio as stream readers");
+        {
+            AudioBuffer<float> fromStream (2, 5000), fromMapped (2, 5000);
+
+            // Reads at random positions, some of which overlap the end of the file
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto numSamples = random.nextInt ({ 1, fromStream.getNumSamples() + 1 });
+                const auto start = (int64) random.nextInt (original.getNumSamples() + 1000) - 500;
+
+                streamReader->read (&fromStream, 0, numSamples, start, true, true);
+                mappedReader->read (&fromMapped, 0, numSamples, start, true, true);
+
+                auto matches = true;
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    for (int sample = 0; sample < numSamples; ++sample)
+                    {
+                        const auto pos = start + sample;
+                        const auto expected = isPositiveAndBelow (pos, (int64) original.getNumSamples())
+                                                ? original.getSample (channel, (int) pos)
+                                                : 0.0f;
+
+                        matches = matches
+                               && exactlyEqual (fromMapped.getSample (channel, sample), fromStream.getSample (channel, sample))
+                               && std::abs (fromMapped.getSample (channel, sample) - expected) < 1.0e-4f;
+                    }
+                }
+
+                expect (matches, "Mismatch reading " + String (numSamples) + " samples from " + String (start));
+            }
+        }
+
+        beginTest ("Memory-mapped readers can read single samples");
+        {
+            std::vector<float> sample (2);
+            AudioBuffer<float> fromStream (2, 1);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                const auto pos = random.nextInt (original.getNumSamples());
+                mappedReader->getSample (pos, sample.data());
+                streamReader->read (&fromStream, 0, 1, pos, true, true);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    expectEquals (sample[(size_t) channel], fromStream.getSample (channel, 0));
+            }
+        }
+
+        beginTest ("Readers for the same file share a seek index");
+        {
+            const auto getIndex = [&]
+            {
+                std::unique_ptr<MemoryMappedAudioFormatReader> reader (format.createMemoryMappedReader (tempFile.getFile()));
+                auto* flacReader = dynamic_cast<MemoryMappedFlacReader*> (reader.get());
+                expect (flacReader != nullptr);
+                return flacReader != nullptr ? flacReader->getSeekIndex() : nullptr;
+            };
+
+            const auto index = getIndex();
+            expect (index != nullptr);
+            expect (getIndex() == index);
+            expect (dynamic_cast<MemoryMappedFlacReader*> (mappedReader.get())->getSeekIndex() == index);
+
+            FlacAudioFormat::clearSeekIndexCache();
+            const auto rebuiltIndex = getIndex();
+            expect (rebuiltIndex != nullptr && rebuiltIndex != index);
+            expect (getIndex() == rebuiltIndex);
+        }
+
+        beginTest ("The seek index finds the frame that contains each sample");
+        {
+            const auto index = dynamic_cast<MemoryMappedFlacReader*> (mappedReader.get())->getSeekIndex();
+            const auto& starts = index->frameStarts;
+
+            expectEquals (starts.front(), (int64) 0);
+            expectEquals (starts.size(), index->frameOffsets.size());
+            expect (std::is_sorted (index->frameOffsets.begin(), index->frameOffsets.end()));
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                const auto pos = (int64) random.nextInt (original.getNumSamples());
+                const auto frame = index->findFrameContaining (pos);
+                const auto frameEnd = frame + 1 < starts.size() ? starts[frame + 1] : mappedReader->lengthInSamples;
+
+                expect (starts[frame] <= pos && pos < frameEnd);
+            }
+        }
+
+        beginTest ("The generic memory-mapped reader path uses the FLAC reader");
+        {
+            AudioFormatManager manager;
+            manager.registerFormat (new FlacAudioFormat(), true);
+
+            auto* flac = manager.findFormatForFileExtension ("flac");
+            expect (flac != nullptr);
+
+            std::unique_ptr<MemoryMappedAudioFormatReader> reader (flac->createMemoryMappedReader (tempFile.getFile().createInputStream().release()));
+            expect (reader != nullptr);
+
+            if (reader != nullptr)
+            {
+                expect (reader->mapEntireFile());
+                expect (reader->getMappedSection() == Range<int64> (0, reader->lengthInSamples));
+            }
+        }
+    }
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
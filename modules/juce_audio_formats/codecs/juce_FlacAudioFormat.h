@@ -51,12 +51,41 @@ public:
     bool canDoStereo() override;
     bool canDoMono() override;
     bool isCompressed() override;
+    bool canUseReadersConcurrently() override;
     StringArray getQualityOptions() override;
 
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader that decodes a FLAC file directly from a memory-mapped view of it.
+
+        This is intended for situations where many readers are jumping around inside the
+        same files, e.g. a StreamingSamplerSound. The decoder pulls its data straight from
+        the mapped file rather than through a FileInputStream. As FLAC data is compressed,
+        the whole file is always mapped, and MemoryMappedAudioFormatReader::getSample()
+        has to decode the frame that contains the sample, so it's much slower than read().
+
+        The first time that a file is opened in this way, the position of each of its
+        frames is recorded in a seek index. This index is kept in memory and used by any
+        other readers that are created for the same file, until the file is modified. Reads
+        from arbitrary positions will then jump straight to the frame that contains the
+        first sample, rather than having to search the file for it.
+
+        Returns nullptr if the file can't be mapped, or doesn't contain valid FLAC data.
+
+        @see clearSeekIndexCache
+    */
+    MemoryMappedAudioFormatReader* createMemoryMappedReader (const File& file) override;
+    MemoryMappedAudioFormatReader* createMemoryMappedReader (FileInputStream* fin) override;
+
+    /** Releases any seek indexes that have been built by createMemoryMappedReader().
+
+        Readers that are currently open will keep using their indexes, but new readers
+        will have to rebuild them.
+    */
+    static void clearSeekIndexCache();
+
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
@@ -3149,6 +3149,7 @@ Array<int> MP3AudioFormat::getPossibleBitDepths()   { return {}; }
 bool MP3AudioFormat::canDoStereo()                  { return true; }
 bool MP3AudioFormat::canDoMono()                    { return true; }
 bool MP3AudioFormat::isCompressed()                 { return true; }
+bool MP3AudioFormat::canUseReadersConcurrently()    { return true; }
 StringArray MP3AudioFormat::getQualityOptions()     { return {}; }
 
 AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, const bool deleteStreamIfOpeningFails)
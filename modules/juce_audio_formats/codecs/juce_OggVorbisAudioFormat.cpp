@@ -442,6 +442,7 @@ Array<int> OggVorbisAudioFormat::getPossibleBitDepths()
 bool OggVorbisAudioFormat::canDoStereo()    { return true; }
 bool OggVorbisAudioFormat::canDoMono()      { return true; }
 bool OggVorbisAudioFormat::isCompressed()   { return true; }
+bool OggVorbisAudioFormat::canUseReadersConcurrently() { return true; }
 
 AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool deleteStreamIfOpeningFails)
 {
@@ -51,6 +51,7 @@ public:
     bool canDoStereo() override;
     bool canDoMono() override;
     bool isCompressed() override;
+    bool canUseReadersConcurrently() override;
     StringArray getQualityOptions() override;
 
     //==============================================================================
@@ -1956,6 +1956,7 @@ Array<int> WavAudioFormat::getPossibleBitDepths()
 
 bool WavAudioFormat::canDoStereo()  { return true; }
 bool WavAudioFormat::canDoMono()    { return true; }
+bool WavAudioFormat::canUseReadersConcurrently() { return true; }
 
 bool WavAudioFormat::isChannelLayoutSupported (const AudioChannelSet& channelSet)
 {
@@ -279,6 +279,7 @@ public:
     Array<int> getPossibleBitDepths() override;
     bool canDoStereo() override;
     bool canDoMono() override;
+    bool canUseReadersConcurrently() override;
     bool isChannelLayoutSupported (const AudioChannelSet& channelSet) override;
 
     //==============================================================================
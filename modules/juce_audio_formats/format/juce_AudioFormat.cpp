@@ -52,6 +52,7 @@ bool AudioFormat::canHandleFile (const File& f)
 const String& AudioFormat::getFormatName() const                { return formatName; }
 StringArray AudioFormat::getFileExtensions() const              { return fileExtensions; }
 bool AudioFormat::isCompressed()                                { return false; }
+bool AudioFormat::canUseReadersConcurrently()                   { return false; }
 StringArray AudioFormat::getQualityOptions()                    { return {}; }
 
 MemoryMappedAudioFormatReader* AudioFormat::createMemoryMappedReader (const File&)
@@ -78,6 +78,17 @@ public:
     /** Returns true if the format uses compressed data. */
     virtual bool isCompressed();
 
+    /** Returns true if separate readers created by this format can safely be used on
+        different threads at the same time.
+
+        Each reader must still only be used by one thread at a time, but if this returns
+        true, the format doesn't share any decoder state between its readers, so several
+        files can be decoded in parallel. The default implementation returns false.
+
+        @see AudioFormatReaderPipeline
+    */
+    virtual bool canUseReadersConcurrently();
+
     /** Returns true if the channel layout is supported by this format. */
     virtual bool isChannelLayoutSupported (const AudioChannelSet& channelSet);
 
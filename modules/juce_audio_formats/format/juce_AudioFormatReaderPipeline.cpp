@@ -0,0 +1,709 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioFormatReaderPipeline::Source
+{
+    Source (const File& f, int numBlocks)                      : file (f), fifo (numBlocks + 1), blocks ((size_t) numBlocks + 1) {}
+    Source (std::unique_ptr<InputStream> s, int numBlocks)     : stream (std::move (s)), fifo (numBlocks + 1), blocks ((size_t) numBlocks + 1) {}
+
+    struct Block
+    {
+        AudioBuffer<float> buffer;
+        int numSamples = 0;
+    };
+
+    // Only used by the thread that is currently decoding this source
+    File file;
+    std::unique_ptr<InputStream> stream;
+    std::unique_ptr<AudioFormatReader> reader;
+    std::mutex* formatLock = nullptr;
+    int64 nextSampleToDecode = 0;
+
+    // The decoder thread writes blocks, and the consumer reads them
+    AbstractFifo fifo;
+    std::vector<Block> blocks;
+    WaitableEvent blockReady;
+
+    std::atomic<SourceState> state { SourceState::opening };
+    std::atomic<AudioFormatReader*> openedReader { nullptr };
+
+    // A source is open from when it's started until all of its audio has been read, or it
+    // fails to open. Only a limited number of sources can be open at once.
+    std::atomic<bool> isStarted { false }, isClosed { false };
+
+    // Set when decoding has stopped because the fifo was full. Whichever thread
+    // clears it is responsible for restarting the decoding.
+    std::atomic<bool> isStalled { false };
+    std::atomic<int64> stallStartTicks { 0 };
+
+    std::atomic<int64> numSamplesDecoded { 0 }, decodingTicks { 0 }, stallTicks { 0 }, consumerWaitTicks { 0 };
+    std::atomic<int> numStalls { 0 };
+};
+
+//==============================================================================
+AudioFormatReaderPipeline::AudioFormatReaderPipeline (AudioFormatManager& manager,
+                                                      const Array<File>& filesToDecode,
+                                                      const Options& optionsIn)
+    : AudioFormatReaderPipeline (manager, [&]
+      {
+          std::vector<std::unique_ptr<Source>> result;
+
+          for (auto& f : filesToDecode)
+              result.push_back (std::make_unique<Source> (f, jmax (1, optionsIn.numBlocksPerSource)));
+
+          return result;
+      }(), optionsIn)
+{
+}
+
+AudioFormatReaderPipeline::AudioFormatReaderPipeline (AudioFormatManager& manager,
+                                                      std::vector<std::unique_ptr<InputStream>> streamsToDecode,
+                                                      const Options& optionsIn)
+    : AudioFormatReaderPipeline (manager, [&]
+      {
+          std::vector<std::unique_ptr<Source>> result;
+
+          for (auto& s : streamsToDecode)
+              result.push_back (std::make_unique<Source> (std::move (s), jmax (1, optionsIn.numBlocksPerSource)));
+
+          return result;
+      }(), optionsIn)
+{
+}
+
+AudioFormatReaderPipeline::AudioFormatReaderPipeline (AudioFormatManager& manager,
+                                                      std::vector<std::unique_ptr<Source>> sourcesToDecode,
+                                                      const Options& optionsIn)
+    : formatManager (manager),
+      options (optionsIn),
+      sources (std::move (sourcesToDecode)),
+      scheduler (TaskScheduler::Options{}.withThreadName ("Audio Decoder")
+                                         .withNumberOfThreads (jmax (1, optionsIn.numberOfThreads))
+                                         .withMaxQueuedTasksPerThread (jmax (16, (int) sources.size())))
+{
+    // you need to actually register some formats before the pipeline can
+    // use them to open a file!
+    jassert (formatManager.getNumKnownFormats() > 0);
+    jassert (options.blockSize > 0);
+
+    for (auto* format : formatManager)
+        if (! format->canUseReadersConcurrently())
+            formatLocks[format];
+
+    startMoreSources (nullptr);
+}
+
+AudioFormatReaderPipeline::~AudioFormatReaderPipeline()
+{
+    shouldExit = true;
+    tasks.wait();
+}
+
+//==============================================================================
+int AudioFormatReaderPipeline::getNumSources() const noexcept
+{
+    return (int) sources.size();
+}
+
+AudioFormatReaderPipeline::SourceState AudioFormatReaderPipeline::getSourceState (int sourceIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (sourceIndex, getNumSources()));
+    return sources[(size_t) sourceIndex]->state.load();
+}
+
+const AudioFormatReader* AudioFormatReaderPipeline::getReader (int sourceIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (sourceIndex, getNumSources()));
+    return sources[(size_t) sourceIndex]->openedReader.load();
+}
+
+AudioFormatReaderPipeline::SourceStatistics AudioFormatReaderPipeline::getStatistics (int sourceIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (sourceIndex, getNumSources()));
+    const auto& source = *sources[(size_t) sourceIndex];
+
+    SourceStatistics result;
+    result.numSamplesDecoded   = source.numSamplesDecoded.load();
+    result.decodingSeconds     = Time::highResolutionTicksToSeconds (source.decodingTicks.load());
+    result.numStalls           = source.numStalls.load();
+    result.stallSeconds        = Time::highResolutionTicksToSeconds (source.stallTicks.load());
+    result.consumerWaitSeconds = Time::highResolutionTicksToSeconds (source.consumerWaitTicks.load());
+    return result;
+}
+
+bool AudioFormatReaderPipeline::isFinished() const noexcept
+{
+    return std::all_of (sources.begin(), sources.end(), [] (const auto& source)
+    {
+        const auto state = source->state.load();
+        return state == SourceState::finished || state == SourceState::failed;
+    });
+}
+
+//==============================================================================
+int AudioFormatReaderPipeline::readNextBlock (int sourceIndex, AudioBuffer<float>& destination)
+{
+    jassert (isPositiveAndBelow (sourceIndex, getNumSources()));
+    auto& source = *sources[(size_t) sourceIndex];
+
+    if (! source.isStarted)
+        startMoreSources (&source);
+
+    const auto waitStart = Time::getHighResolutionTicks();
+    auto hasWaited = false;
+
+    for (;;)
+    {
+        // The state must be checked before the fifo, as the decoder only marks the
+        // source as finished after it has written the final block
+        const auto state = source.state.load();
+
+        if (source.fifo.getNumReady() > 0)
+            break;
+
+        if (state == SourceState::finished || state == SourceState::failed)
+        {
+            closeSource (source);
+            return 0;
+        }
+
+        source.blockReady.wait();
+        hasWaited = true;
+    }
+
+    if (hasWaited)
+        source.consumerWaitTicks += Time::getHighResolutionTicks() - waitStart;
+
+    auto numSamples = 0;
+
+    {
+        const auto scope = source.fifo.read (1);
+        const auto& block = source.blocks[(size_t) scope.startIndex1];
+
+        numSamples = block.numSamples;
+        destination.setSize (block.buffer.getNumChannels(), numSamples, false, false, true);
+
+        for (int channel = 0; channel < block.buffer.getNumChannels(); ++channel)
+            destination.copyFrom (channel, 0, block.buffer, channel, 0, numSamples);
+    }
+
+    if (source.isStalled.exchange (false))
+    {
+        source.stallTicks += Time::getHighResolutionTicks() - source.stallStartTicks.load();
+        queueDecoding (source);
+    }
+
+    return numSamples;
+}
+
+//==============================================================================
+void AudioFormatReaderPipeline::queueDecoding (Source& source)
+{
+    tasks.run ([this, &source] { decodeNextBlock (source); });
+}
+
+void AudioFormatReaderPipeline::startMoreSources (Source* sourceNeededNow)
+{
+    std::vector<Source*> sourcesToStart;
+
+    {
+        const std::lock_guard<std::mutex> sl (startLock);
+
+        const auto start = [&] (Source& source)
+        {
+            if (source.isStarted.exchange (true))
+                return;
+
+            ++numOpenSources;
+            sourcesToStart.push_back (&source);
+        };
+
+        if (sourceNeededNow != nullptr)
+            start (*sourceNeededNow);
+
+        for (; nextSourceToStart < sources.size(); ++nextSourceToStart)
+        {
+            if (options.maxNumOpenSources > 0 && numOpenSources >= options.maxNumOpenSources)
+                break;
+
+            start (*sources[nextSourceToStart]);
+        }
+    }
+
+    // The scheduler may run a task on this thread if its queues are full, and that
+    // task may need to take the lock, so the decoding is queued after releasing it
+    for (auto* source : sourcesToStart)
+        queueDecoding (*source);
+}
+
+void AudioFormatReaderPipeline::closeSource (Source& source)
+{
+    if (source.isClosed.exchange (true))
+        return;
+
+    // The decoder has finished with the blocks, and the consumer has read them all
+    std::vector<Source::Block>().swap (source.blocks);
+
+    {
+        const std::lock_guard<std::mutex> sl (startLock);
+        --numOpenSources;
+    }
+
+    startMoreSources (nullptr);
+}
+
+bool AudioFormatReaderPipeline::openReader (Source& source)
+{
+    const auto useFile = source.stream == nullptr;
+
+    if (useFile)
+        source.stream = source.file.createInputStream();
+
+    if (source.stream == nullptr)
+        return false;
+
+    const auto originalStreamPos = source.stream->getPosition();
+
+    for (auto* format : formatManager)
+    {
+        if (useFile && ! format->canHandleFile (source.file))
+            continue;
+
+        const auto iter = formatLocks.find (format);
+        auto* lock = iter != formatLocks.end() ? &iter->second : nullptr;
+
+        {
+            std::unique_lock<std::mutex> sl;
+
+            if (lock != nullptr)
+                sl = std::unique_lock<std::mutex> (*lock);
+
+            source.reader.reset (format->createReaderFor (source.stream.get(), false));
+        }
+
+        if (source.reader != nullptr)
+        {
+            source.stream.release();
+            source.formatLock = lock;
+            return true;
+        }
+
+        source.stream->setPosition (originalStreamPos);
+
+        // the stream that is passed-in must be capable of being repositioned so
+        // that all the formats can have a go at opening it.
+        jassert (source.stream->getPosition() == originalStreamPos);
+    }
+
+    source.stream.reset();
+    return false;
+}
+
+void AudioFormatReaderPipeline::decodeNextBlock (Source& source)
+{
+    if (shouldExit)
+        return;
+
+    const auto startTicks = Time::getHighResolutionTicks();
+
+    if (source.state == SourceState::opening)
+    {
+        if (! openReader (source))
+        {
+            source.state = SourceState::failed;
+            source.blockReady.signal();
+            closeSource (source);
+            return;
+        }
+
+        const auto numChannels = (int) source.reader->numChannels;
+
+        for (auto& block : source.blocks)
+            block.buffer.setSize (numChannels, options.blockSize);
+
+        source.openedReader = source.reader.get();
+        source.state = SourceState::decoding;
+    }
+
+    const auto numSamples = (int) jmin ((int64) options.blockSize,
+                                        source.reader->lengthInSamples - source.nextSampleToDecode);
+
+    if (numSamples > 0)
+    {
+        const auto scope = source.fifo.write (1);
+        jassert (scope.blockSize1 == 1);
+
+        auto& block = source.blocks[(size_t) scope.startIndex1];
+        block.numSamples = numSamples;
+
+        std::unique_lock<std::mutex> sl;
+
+        if (source.formatLock != nullptr)
+            sl = std::unique_lock<std::mutex> (*source.formatLock);
+
+        source.reader->read (block.buffer.getArrayOfWritePointers(),
+                             block.buffer.getNumChannels(),
+                             source.nextSampleToDecode,
+                             numSamples);
+
+        source.nextSampleToDecode += numSamples;
+        source.numSamplesDecoded += numSamples;
+    }
+
+    source.decodingTicks += Time::getHighResolutionTicks() - startTicks;
+
+    if (source.nextSampleToDecode >= source.reader->lengthInSamples)
+    {
+        source.state = SourceState::finished;
+        source.blockReady.signal();
+        return;
+    }
+
+    source.blockReady.signal();
+
+    if (source.fifo.getFreeSpace() > 0)
+    {
+        queueDecoding (source);
+        return;
+    }
+
+    // The consumer may have read a block since we checked the free space, so after marking
+    // the source as stalled we need to check again, and restart it ourselves if it looks like
+    // the consumer didn't see the flag.
+    ++source.numStalls;
+    source.stallStartTicks = Time::getHighResolutionTicks();
+    source.isStalled = true;
+
+    if (source.fifo.getFreeSpace() > 0 && source.isStalled.exchange (false))
+    {
+        source.stallTicks += Time::getHighResolutionTicks() - source.stallStartTicks.load();
+        queueDecoding (source);
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioFormatReaderPipelineTests final : public UnitTest
+{
+public:
+    AudioFormatReaderPipelineTests()
+        : UnitTest ("AudioFormatReaderPipeline", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        std::vector<AudioBuffer<float>> sourceAudio;
+
+        for (int i = 0; i < 12; ++i)
+        {
+            AudioBuffer<float> audio (1 + (i % 2), 20000 + random.nextInt (30000));
+
+            for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+                for (int sample = 0; sample < audio.getNumSamples(); ++sample)
+                    audio.setSample (channel, sample, (float) random.nextInt ({ -32768, 32768 }) / 32768.0f);
+
+            sourceAudio.push_back (std::move (audio));
+        }
+
+        WavAudioFormat wav;
+        std::vector<MemoryBlock> wavFiles;
+
+        for (const auto& audio : sourceAudio)
+            wavFiles.push_back (encode (wav, audio));
+
+        beginTest ("All sources are decoded correctly");
+        {
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+
+            AudioFormatReaderPipeline pipeline (manager,
+                                                createStreams (wavFiles),
+                                                Options{}.withNumberOfThreads (4)
+                                                         .withBlockSize (1000)
+                                                         .withNumBlocksPerSource (3)
+                                                         .withMaxNumOpenSources (0));
+
+            expectEquals (pipeline.getNumSources(), (int) wavFiles.size());
+
+            for (int i = 0; i < pipeline.getNumSources(); ++i)
+                expect (matches (readAll (pipeline, i), sourceAudio[(size_t) i]));
+
+            expect (pipeline.isFinished());
+
+            for (int i = 0; i < pipeline.getNumSources(); ++i)
+            {
+                const auto stats = pipeline.getStatistics (i);
+                expectEquals (stats.numSamplesDecoded, (int64) sourceAudio[(size_t) i].getNumSamples());
+                expect (pipeline.getSourceState (i) == SourceState::finished);
+                expect (pipeline.getReader (i) != nullptr);
+            }
+
+            // The later sources must have filled their queues while the earlier ones were being read
+            expectGreaterThan (pipeline.getStatistics (pipeline.getNumSources() - 1).numStalls, 0);
+        }
+
+        beginTest ("Only a limited number of sources are opened ahead of the consumer");
+        {
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+
+            AudioFormatReaderPipeline pipeline (manager,
+                                                createStreams (wavFiles),
+                                                Options{}.withNumberOfThreads (2)
+                                                         .withBlockSize (1000)
+                                                         .withNumBlocksPerSource (2)
+                                                         .withMaxNumOpenSources (2));
+
+            // Wait for the first two sources to fill their queues
+            for (int i = 0; i < 2; ++i)
+                while (pipeline.getStatistics (i).numStalls == 0)
+                    Thread::sleep (1);
+
+            for (int i = 2; i < pipeline.getNumSources(); ++i)
+                expect (pipeline.getSourceState (i) == SourceState::opening);
+
+            // Asking for a source out of order opens it anyway
+            expect (matches (readAll (pipeline, 7), sourceAudio[7]));
+
+            for (int i = 0; i < pipeline.getNumSources(); ++i)
+                if (i != 7)
+                    expect (matches (readAll (pipeline, i), sourceAudio[(size_t) i]));
+
+            expect (pipeline.isFinished());
+        }
+
+        beginTest ("Sources can be read from several threads at once");
+        {
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+
+            AudioFormatReaderPipeline pipeline (manager,
+                                                createStreams (wavFiles),
+                                                Options{}.withNumberOfThreads (3)
+                                                         .withBlockSize (512)
+                                                         .withNumBlocksPerSource (2));
+
+            std::vector<AudioBuffer<float>> results (wavFiles.size());
+            std::vector<std::thread> consumers;
+
+            for (size_t i = 0; i < wavFiles.size(); ++i)
+                consumers.emplace_back ([&, i] { results[i] = readAll (pipeline, (int) i); });
+
+            for (auto& consumer : consumers)
+                consumer.join();
+
+            for (size_t i = 0; i < results.size(); ++i)
+                expect (matches (results[i], sourceAudio[i]));
+        }
+
+        beginTest ("Sources that can't be opened are reported as failures");
+        {
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+
+            std::vector<std::unique_ptr<InputStream>> streams;
+            streams.push_back (std::make_unique<MemoryInputStream> (wavFiles.front(), false));
+            streams.push_back (std::make_unique<MemoryInputStream> ("not an audio file", 17, false));
+
+            AudioFormatReaderPipeline pipeline (manager, std::move (streams));
+
+            AudioBuffer<float> destination;
+            expectEquals (pipeline.readNextBlock (1, destination), 0);
+            expect (pipeline.getSourceState (1) == SourceState::failed);
+            expect (pipeline.getReader (1) == nullptr);
+            expect (matches (readAll (pipeline, 0), sourceAudio.front()));
+        }
+
+        beginTest ("Readers from formats that aren't reentrant are never used concurrently");
+        {
+            std::atomic<int> numActiveReads { 0 };
+            std::atomic<bool> readersWereUsedConcurrently { false };
+
+            AudioFormatManager manager;
+            manager.registerFormat (new NonReentrantFormat (numActiveReads, readersWereUsedConcurrently), true);
+
+            AudioFormatReaderPipeline pipeline (manager,
+                                                createStreams (wavFiles),
+                                                Options{}.withNumberOfThreads (4)
+                                                         .withBlockSize (4096));
+
+            for (int i = 0; i < pipeline.getNumSources(); ++i)
+                expect (matches (readAll (pipeline, i), sourceAudio[(size_t) i]));
+
+            expect (! readersWereUsedConcurrently);
+        }
+
+        beginTest ("FLAC files are decoded the same as by a reader on its own");
+        {
+            FlacAudioFormat flac;
+            std::vector<MemoryBlock> flacFiles;
+
+            for (const auto& audio : sourceAudio)
+                flacFiles.push_back (encode (flac, audio));
+
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+
+            AudioFormatReaderPipeline pipeline (manager, createStreams (flacFiles), Options{}.withNumberOfThreads (4));
+            auto streams = createStreams (flacFiles);
+
+            for (int i = 0; i < pipeline.getNumSources(); ++i)
+            {
+                std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (std::move (streams[(size_t) i])));
+                expect (reader != nullptr);
+
+                if (reader == nullptr)
+                    continue;
+
+                AudioBuffer<float> expected ((int) reader->numChannels, (int) reader->lengthInSamples);
+                reader->read (&expected, 0, expected.getNumSamples(), 0, true, true);
+
+                expect (matches (readAll (pipeline, i), expected));
+            }
+        }
+    }
+
+private:
+    using Options = AudioFormatReaderPipeline::Options;
+    using SourceState = AudioFormatReaderPipeline::SourceState;
+
+    static MemoryBlock encode (AudioFormat& format, const AudioBuffer<float>& audio)
+    {
+        MemoryBlock result;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (result, false),
+                                                                               44100.0,
+                                                                               (unsigned int) audio.getNumChannels(),
+                                                                               16, {}, 0));
+            writer->writeFromAudioSampleBuffer (audio, 0, audio.getNumSamples());
+        }
+
+        return result;
+    }
+
+    static std::vector<std::unique_ptr<InputStream>> createStreams (const std::vector<MemoryBlock>& files)
+    {
+        std::vector<std::unique_ptr<InputStream>> result;
+
+        for (auto& file : files)
+            result.push_back (std::make_unique<MemoryInputStream> (file, false));
+
+        return result;
+    }
+
+    static bool matches (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        if (a.getNumChannels() != b.getNumChannels() || a.getNumSamples() != b.getNumSamples())
+            return false;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int sample = 0; sample < a.getNumSamples(); ++sample)
+                if (std::abs (a.getSample (channel, sample) - b.getSample (channel, sample)) > 1.0e-4f)
+                    return false;
+
+        return true;
+    }
+
+    static AudioBuffer<float> readAll (AudioFormatReaderPipeline& pipeline, int sourceIndex)
+    {
+        AudioBuffer<float> result, destination;
+
+        while (const auto numRead = pipeline.readNextBlock (sourceIndex, destination))
+        {
+            const auto numChannels = destination.getNumChannels();
+            const auto position = result.getNumSamples();
+            result.setSize (numChannels, position + numRead, true);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                result.copyFrom (channel, position, destination, channel, 0, numRead);
+        }
+
+        return result;
+    }
+
+    struct NonReentrantFormat final : public WavAudioFormat
+    {
+        NonReentrantFormat (std::atomic<int>& active, std::atomic<bool>& concurrent)
+            : numActiveReads (active), readersWereUsedConcurrently (concurrent) {}
+
+        bool canUseReadersConcurrently() override { return false; }
+
+        AudioFormatReader* createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails) override
+        {
+            if (auto* reader = WavAudioFormat::createReaderFor (sourceStream, deleteStreamIfOpeningFails))
+                return new CheckingReader (reader, *this);
+
+            return nullptr;
+        }
+
+        struct CheckingReader final : public AudioFormatReader
+        {
+            CheckingReader (AudioFormatReader* sourceReader, NonReentrantFormat& f)
+                : AudioFormatReader (nullptr, sourceReader->getFormatName()), source (sourceReader), format (f)
+            {
+                sampleRate            = source->sampleRate;
+                bitsPerSample         = source->bitsPerSample;
+                lengthInSamples       = source->lengthInSamples;
+                numChannels           = source->numChannels;
+                usesFloatingPointData = source->usesFloatingPointData;
+            }
+
+            bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                              int64 startSampleInFile, int numSamples) override
+            {
+                if (++format.numActiveReads > 1)
+                    format.readersWereUsedConcurrently = true;
+
+                Thread::yield();
+
+                const auto result = source->readSamples (destChannels, numDestChannels, startOffsetInDestBuffer,
+                                                         startSampleInFile, numSamples);
+                --format.numActiveReads;
+                return result;
+            }
+
+            std::unique_ptr<AudioFormatReader> source;
+            NonReentrantFormat& format;
+        };
+
+        std::atomic<int>& numActiveReads;
+        std::atomic<bool>& readersWereUsedConcurrently;
+    };
+};
+
+static AudioFormatReaderPipelineTests audioFormatReaderPipelineTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Options used to construct an AudioFormatReaderPipeline.
+
+    @see AudioFormatReaderPipeline
+
+    @tags{Audio}
+*/
+struct AudioFormatReaderPipelineOptions
+{
+    /** The number of threads to use for decoding. */
+    [[nodiscard]] AudioFormatReaderPipelineOptions withNumberOfThreads (int newNumberOfThreads) const
+    {
+        return withMember (*this, &AudioFormatReaderPipelineOptions::numberOfThreads, newNumberOfThreads);
+    }
+
+    /** The maximum number of samples in each block that is handed to the consumer. */
+    [[nodiscard]] AudioFormatReaderPipelineOptions withBlockSize (int newBlockSize) const
+    {
+        return withMember (*this, &AudioFormatReaderPipelineOptions::blockSize, newBlockSize);
+    }
+
+    /** The number of decoded blocks that can be waiting to be read from each source.
+        When a source's queue is full, decoding of that source pauses until the consumer
+        has read another block from it.
+    */
+    [[nodiscard]] AudioFormatReaderPipelineOptions withNumBlocksPerSource (int newNumBlocksPerSource) const
+    {
+        return withMember (*this, &AudioFormatReaderPipelineOptions::numBlocksPerSource, newNumBlocksPerSource);
+    }
+
+    /** The maximum number of sources that can be open at once, or 0 for no limit.
+
+        Sources are opened in the order they were supplied, and each one stays open until
+        the consumer has read all of its audio, or it has failed to open. A source that the
+        consumer asks for is always opened straight away, even if this means going over the
+        limit, so reading the sources in any order is safe.
+    */
+    [[nodiscard]] AudioFormatReaderPipelineOptions withMaxNumOpenSources (int newMaxNumOpenSources) const
+    {
+        return withMember (*this, &AudioFormatReaderPipelineOptions::maxNumOpenSources, newMaxNumOpenSources);
+    }
+
+    int numberOfThreads { SystemStats::getNumCpus() };
+    int blockSize { 8192 };
+    int numBlocksPerSource { 8 };
+    int maxNumOpenSources { 2 * SystemStats::getNumCpus() };
+};
+
+//==============================================================================
+/**
+    Decodes a batch of audio files in parallel.
+
+    The pipeline opens each of its sources using the formats registered with an
+    AudioFormatManager, and then decodes them on a set of background threads. The
+    decoded audio is split into blocks, which are placed in a bounded lock-free queue
+    for each source, and can be collected by calling readNextBlock(). If the consumer
+    falls behind, decoding of a source pauses while its queue is full.
+
+    While it's open, each source holds its AudioFormatReader and a queue of
+    (numBlocksPerSource + 1) blocks of blockSize samples for each channel, which is
+    about 590KB for a stereo source with the default options. The queue is freed once
+    all of the source's audio has been read, and only maxNumOpenSources sources are
+    opened ahead of the consumer, so the memory used depends on those options, but not
+    on how long the files are or how many of them there are.
+
+    Files whose AudioFormat returns true from AudioFormat::canUseReadersConcurrently()
+    are decoded fully in parallel. Formats that don't make that guarantee are still
+    handled, but only one thread at a time will use a reader created by each of them.
+
+    Blocks from each source are delivered in order, and each source may be read on a
+    different thread. Reading the sources in the order they were supplied is always
+    safe, because a source that has finished decoding frees up its thread for the next
+    one.
+
+    @code
+    AudioFormatReaderPipeline pipeline (formatManager, files);
+    AudioBuffer<float> block;
+
+    for (int i = 0; i < pipeline.getNumSources(); ++i)
+        while (pipeline.readNextBlock (i, block) > 0)
+            writers[i]->writeFromAudioSampleBuffer (block, 0, block.getNumSamples());
+    @endcode
+
+    @see AudioFormatManager, AudioFormatReader
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioFormatReaderPipeline
+{
+public:
+    using Options = AudioFormatReaderPipelineOptions;
+
+    //==============================================================================
+    /** Creates a pipeline that will decode a list of files.
+
+        Decoding starts straight away. The files are opened on the background threads,
+        so this constructor returns quickly even for large batches.
+    */
+    AudioFormatReaderPipeline (AudioFormatManager& formatManager,
+                               const Array<File>& filesToDecode,
+                               const Options& options = {});
+
+    /** Creates a pipeline that will decode a list of streams.
+
+        The streams must be capable of being repositioned, so that each of the registered
+        formats can have a go at opening them.
+    */
+    AudioFormatReaderPipeline (AudioFormatManager& formatManager,
+                               std::vector<std::unique_ptr<InputStream>> streamsToDecode,
+                               const Options& options = {});
+
+    /** Destructor.
+
+        This will stop any decoding that is still in progress. Make sure that no other
+        threads are still calling readNextBlock() when the pipeline is deleted.
+    */
+    ~AudioFormatReaderPipeline();
+
+    //==============================================================================
+    /** The state of one of the pipeline's sources. */
+    enum class SourceState
+    {
+        opening,    /**< The source hasn't been opened yet. */
+        decoding,   /**< The source has been opened and its audio is being decoded. */
+        finished,   /**< All of the source's audio has been decoded. */
+        failed      /**< None of the registered formats could open the source. */
+    };
+
+    /** Details about the progress of one of the pipeline's sources. */
+    struct SourceStatistics
+    {
+        /** The number of samples that have been decoded so far. */
+        int64 numSamplesDecoded = 0;
+
+        /** The total time that the background threads have spent decoding this source. */
+        double decodingSeconds = 0.0;
+
+        /** The number of times that decoding paused because this source's queue was full. */
+        int numStalls = 0;
+
+        /** The total time that decoding was paused waiting for the consumer to read blocks. */
+        double stallSeconds = 0.0;
+
+        /** The total time that calls to readNextBlock() spent waiting for this source. */
+        double consumerWaitSeconds = 0.0;
+
+        /** Returns the number of samples decoded per second of decoding time. */
+        double getSamplesPerSecond() const noexcept
+        {
+            return decodingSeconds > 0.0 ? (double) numSamplesDecoded / decodingSeconds : 0.0;
+        }
+    };
+
+    //==============================================================================
+    /** Returns the number of sources that this pipeline is decoding. */
+    int getNumSources() const noexcept;
+
+    /** Returns the current state of one of the sources. */
+    SourceState getSourceState (int sourceIndex) const noexcept;
+
+    /** Returns the reader that is being used to decode one of the sources.
+
+        This will return nullptr until the source has been opened, or if it couldn't be
+        opened. It can be used to find out the sample rate, length, metadata etc. of the
+        source, but must not be used to read any audio.
+    */
+    const AudioFormatReader* getReader (int sourceIndex) const noexcept;
+
+    /** Returns statistics about the progress of one of the sources. */
+    SourceStatistics getStatistics (int sourceIndex) const noexcept;
+
+    /** Returns true once every source has either finished decoding or failed to open. */
+    bool isFinished() const noexcept;
+
+    //==============================================================================
+    /** Waits for the next block of audio from one of the sources, and copies it into a
+        buffer.
+
+        The destination buffer will be resized to fit the number of channels and samples
+        in the block. Its storage is only reallocated if it isn't already large enough.
+
+        Only one thread at a time may read from any given source.
+
+        @returns the number of samples in the block, or 0 if all of the source's audio has
+                 already been read, or if it couldn't be opened
+    */
+    int readNextBlock (int sourceIndex, AudioBuffer<float>& destination);
+
+private:
+    //==============================================================================
+    struct Source;
+
+    AudioFormatReaderPipeline (AudioFormatManager&, std::vector<std::unique_ptr<Source>>, const Options&);
+
+    bool openReader (Source&);
+    void decodeNextBlock (Source&);
+    void queueDecoding (Source&);
+    void startMoreSources (Source* sourceNeededNow);
+    void closeSource (Source&);
+
+    AudioFormatManager& formatManager;
+    const Options options;
+    std::vector<std::unique_ptr<Source>> sources;
+    std::map<AudioFormat*, std::mutex> formatLocks;
+    std::atomic<bool> shouldExit { false };
+
+    std::mutex startLock;
+    size_t nextSourceToStart = 0;
+    int numOpenSources = 0;
+
+    TaskScheduler scheduler;
+    TaskScheduler::TaskGroup tasks { scheduler };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatReaderPipeline)
+};
+
+} // namespace juce
@@ -59,6 +59,7 @@
 #include "format/juce_AudioFormatWriter.cpp"
 #include "format/juce_AudioSubsectionReader.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
+#include "format/juce_AudioFormatReaderPipeline.cpp"
 #include "sampler/juce_Sampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
@@ -162,4 +162,480 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
     }
 }
 
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              std::unique_ptr<AudioFormatReader> source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double preloadTimeSecs)
+    : name (soundName),
+      reader (std::move (source)),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (reader != nullptr && reader->sampleRate > 0 && reader->lengthInSamples > 0)
+    {
+        if (auto* mapped = dynamic_cast<MemoryMappedAudioFormatReader*> (reader.get()))
+            mapped->mapEntireFile();
+
+        sourceSampleRate = reader->sampleRate;
+        length = reader->lengthInSamples;
+        preloadLength = (int) jmin (length, (int64) (preloadTimeSecs * sourceSampleRate));
+
+        preloadedData.setSize (jmin (2, (int) reader->numChannels), preloadLength);
+        reader->read (&preloadedData, 0, preloadLength, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+void StreamingSamplerSound::readFromSource (AudioBuffer<float>& destination, int startSampleInDestBuffer,
+                                            int numSamples, int64 startSampleInSource)
+{
+    const ScopedLock sl (readerLock);
+    reader->read (&destination, startSampleInDestBuffer, numSamples, startSampleInSource, true, true);
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (TimeSliceThread& backgroundThread, int bufferSizeSamples)
+    : thread (backgroundThread),
+      fifo (jmax (1024, bufferSizeSamples)),
+      ringBuffer (2, fifo.getTotalSize())
+{
+    thread.addTimeSliceClient (this);
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (getSampleRate());
+        adsr.setParameters (sound->params);
+
+        adsr.noteOn();
+
+        // Start streaming the part of the sound after the preloaded section straight away,
+        // so that it's ready by the time the preloaded section has finished playing
+        requestStream (sound);
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+    }
+    else
+    {
+        clearCurrentNote();
+        adsr.reset();
+        requestStream (nullptr);
+    }
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+void StreamingSamplerVoice::requestStream (SynthesiserSound::Ptr sound)
+{
+    SynthesiserSound::Ptr previousSound;
+
+    {
+        const SpinLock::ScopedLockType sl (requestLock);
+        previousSound = std::exchange (requestedSound, std::move (sound));
+        ++requestedGeneration;
+    }
+
+    ringBufferIsLive = false;
+}
+
+//==============================================================================
+int StreamingSamplerVoice::useTimeSlice()
+{
+    {
+        const SpinLock::ScopedLockType sl (requestLock);
+
+        if (streamingGeneration != requestedGeneration)
+        {
+            streamingSound = requestedSound;
+            streamingGeneration = requestedGeneration;
+        }
+    }
+
+    auto* sound = static_cast<StreamingSamplerSound*> (streamingSound.get());
+
+    if (streamedGeneration.load (std::memory_order_relaxed) != streamingGeneration)
+    {
+        // The audio thread won't touch the fifo until we've published the new generation
+        fifo.reset();
+        nextSampleToStream = sound != nullptr ? sound->preloadLength : 0;
+        streamedGeneration.store (streamingGeneration, std::memory_order_release);
+    }
+
+    if (sound == nullptr)
+        return 20;
+
+    // Leave a few samples of silence after the end, for the interpolator
+    const auto samplesLeft = sound->length + 4 - nextSampleToStream;
+
+    if (samplesLeft <= 0)
+        return 20;
+
+    const auto numToRead = (int) jmin ((int64) fifo.getFreeSpace(), (int64) 8192, samplesLeft);
+
+    if (numToRead < jmin (1024, (int) samplesLeft))
+        return 2;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        sound->readFromSource (ringBuffer, start1, size1, nextSampleToStream);
+
+    if (size2 > 0)
+        sound->readFromSource (ringBuffer, start2, size2, nextSampleToStream + size1);
+
+    fifo.finishedWrite (size1 + size2);
+    nextSampleToStream += size1 + size2;
+    return 0;
+}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        const auto& preloaded = playingSound->preloadedData;
+        const auto preloadLength = (int64) playingSound->preloadLength;
+        const auto numSourceChannels = preloaded.getNumChannels();
+
+        if (! ringBufferIsLive && streamedGeneration.load (std::memory_order_acquire) == requestedGeneration)
+        {
+            ringBufferIsLive = true;
+            ringBufferStart = preloadLength;
+        }
+
+        int readStart = 0, numReady = 0;
+
+        if (ringBufferIsLive)
+        {
+            int start2, size2;
+            fifo.prepareToRead (fifo.getNumReady(), readStart, numReady, start2, size2);
+            numReady += size2;
+        }
+
+        const auto ringSize = ringBuffer.getNumSamples();
+        auto sampleWasMissing = false;
+        int64 numMissingSamples = 0;
+
+        const auto getSourceSample = [&] (int channel, int64 index)
+        {
+            if (index < preloadLength)
+                return preloaded.getSample (channel, (int) index);
+
+            const auto offset = index - ringBufferStart;
+
+            if (offset >= 0 && offset < numReady)
+                return ringBuffer.getSample (channel, (int) ((readStart + offset) % ringSize));
+
+            sampleWasMissing = sampleWasMissing || index < playingSound->length;
+            return 0.0f;
+        };
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int64) sourceSamplePosition;
+            auto alpha = (float) (sourceSamplePosition - (double) pos);
+            auto invAlpha = 1.0f - alpha;
+
+            // just using a very simple linear interpolation here..
+            float l = (getSourceSample (0, pos) * invAlpha + getSourceSample (0, pos + 1) * alpha);
+            float r = (numSourceChannels > 1) ? (getSourceSample (1, pos) * invAlpha + getSourceSample (1, pos + 1) * alpha)
+                                              : l;
+
+            if (std::exchange (sampleWasMissing, false))
+                ++numMissingSamples;
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > (double) playingSound->length)
+            {
+                stopNote (0.0f, false);
+                break;
+            }
+        }
+
+        if (numMissingSamples > 0)
+            numUnderrunSamples.fetch_add (numMissingSamples, std::memory_order_relaxed);
+
+        // Release the part of the ring buffer that has been played. (If the note has just
+        // stopped, the background thread will reset the whole buffer instead.)
+        if (ringBufferIsLive)
+        {
+            const auto numPlayed = (int) jlimit ((int64) 0, (int64) numReady, (int64) sourceSamplePosition - ringBufferStart);
+            fifo.finishedRead (numPlayed);
+            ringBufferStart += numPlayed;
+        }
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StreamingSamplerTests final : public UnitTest
+{
+public:
+    StreamingSamplerTests()
+        : UnitTest ("StreamingSampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        // This thread is never started. Instead, the tests call each voice's useTimeSlice()
+        // themselves, so that they always know exactly how much has been streamed
+        TimeSliceThread thread ("Sampler streaming thread");
+
+        constexpr auto sampleRate = 44100.0;
+        constexpr auto rootNote = 60;
+        constexpr auto blockSize = 512;
+        constexpr auto sourceLength = (int) sampleRate * 3;
+
+        beginTest ("Streamed notes play the whole source");
+        {
+            Synthesiser synth;
+            auto* voice = new StreamingSamplerVoice (thread);
+            synth.addVoice (voice);
+            synth.addSound (new StreamingSamplerSound ("ramp", std::make_unique<RampReader> (sourceLength),
+                                                       getAllNotes(), rootNote, 0.0, 0.0, 0.5));
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+
+            const auto output = play (synth, rootNote, sourceLength + blockSize, [voice] { fillRingBuffer (*voice); });
+
+            expectEquals (voice->getNumUnderrunSamples(), (int64) 0);
+            expect (! voice->isVoiceActive());
+
+            auto matches = true;
+
+            for (int channel = 0; channel < output.getNumChannels(); ++channel)
+                for (int i = 0; i < output.getNumSamples(); ++i)
+                    matches = matches && exactlyEqual (output.getSample (channel, i), RampReader::getValue (i, sourceLength));
+
+            expect (matches);
+        }
+
+        beginTest ("Samples that arrive too late are counted as underruns");
+        {
+            Synthesiser synth;
+            auto* voice = new StreamingSamplerVoice (thread);
+            synth.addVoice (voice);
+
+            const auto preloadSeconds = 0.1;
+            const auto preloadLength = (int) (preloadSeconds * sampleRate);
+            synth.addSound (new StreamingSamplerSound ("ramp", std::make_unique<RampReader> (sourceLength),
+                                                       getAllNotes(), rootNote, 0.0, 0.0, preloadSeconds));
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+
+            // Nothing is streamed, so everything after the preloaded section is missing
+            const auto output = play (synth, rootNote, sourceLength + blockSize, [] {});
+
+            expectGreaterOrEqual (voice->getNumUnderrunSamples(), (int64) (sourceLength - preloadLength));
+
+            auto preloadedSectionMatches = true;
+
+            for (int i = 0; i < preloadLength; ++i)
+                preloadedSectionMatches = preloadedSectionMatches && exactlyEqual (output.getSample (0, i), RampReader::getValue (i, sourceLength));
+
+            expect (preloadedSectionMatches);
+        }
+
+        beginTest ("Voices can be restarted while they are streaming");
+        {
+            Synthesiser synth;
+            auto* voice = new StreamingSamplerVoice (thread);
+            synth.addVoice (voice);
+            synth.addSound (new StreamingSamplerSound ("ramp", std::make_unique<RampReader> (sourceLength),
+                                                       getAllNotes(), rootNote, 0.0, 0.0, 0.5));
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+
+            for (int i = 0; i < 5; ++i)
+            {
+                // Play part of the note, then steal the voice and start again from the beginning
+                const auto output = play (synth, rootNote, (i + 1) * 20000, [voice] { fillRingBuffer (*voice); });
+
+                auto matches = true;
+
+                for (int sample = 0; sample < output.getNumSamples(); ++sample)
+                    matches = matches && exactlyEqual (output.getSample (0, sample), RampReader::getValue (sample, sourceLength));
+
+                expect (matches);
+                synth.allNotesOff (0, false);
+            }
+
+            expectEquals (voice->getNumUnderrunSamples(), (int64) 0);
+        }
+
+        beginTest ("Starting a note starts streaming on the background thread");
+        {
+            TimeSliceThread backgroundThread ("Sampler streaming thread");
+            backgroundThread.startThread (Thread::Priority::normal);
+
+            WaitableEvent streamingStarted;
+
+            {
+                Synthesiser synth;
+                synth.addVoice (new StreamingSamplerVoice (backgroundThread));
+                synth.addSound (new StreamingSamplerSound ("ramp", std::make_unique<RampReader> (sourceLength, &streamingStarted),
+                                                           getAllNotes(), rootNote, 0.0, 0.0, 0.5));
+                synth.setCurrentPlaybackSampleRate (sampleRate);
+
+                play (synth, rootNote, blockSize, [] {});
+
+                expect (streamingStarted.wait (10000));
+            }
+
+            backgroundThread.stopThread (-1);
+        }
+    }
+
+private:
+    struct RampReader final : public AudioFormatReader
+    {
+        RampReader (int length, WaitableEvent* eventToSignalWhenStreaming = nullptr)
+            : AudioFormatReader (nullptr, "Ramp"), streamingEvent (eventToSignalWhenStreaming)
+        {
+            sampleRate            = 44100.0;
+            bitsPerSample         = 32;
+            usesFloatingPointData = true;
+            lengthInSamples       = length;
+            numChannels           = 1;
+        }
+
+        static float getValue (int64 index, int64 length)
+        {
+            return index < length ? (float) index / (float) length : 0.0f;
+        }
+
+        bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            // The preloaded section is the only part that's read from the start of the file
+            if (streamingEvent != nullptr && startSampleInFile > 0)
+                streamingEvent->signal();
+
+            for (int channel = 0; channel < numDestChannels; ++channel)
+                if (auto* dest = reinterpret_cast<float*> (destChannels[channel]))
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = getValue (startSampleInFile + i, lengthInSamples);
+
+            return true;
+        }
+
+        WaitableEvent* const streamingEvent;
+    };
+
+    // Does the background thread's work until the voice's ring buffer is full, or until
+    // the whole sound has been streamed
+    static void fillRingBuffer (StreamingSamplerVoice& voice)
+    {
+        while (voice.useTimeSlice() == 0) {}
+    }
+
+    static BigInteger getAllNotes()
+    {
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+        return notes;
+    }
+
+    template <typename BetweenBlocks>
+    static AudioBuffer<float> play (Synthesiser& synth, int note, int numSamples, BetweenBlocks&& betweenBlocks)
+    {
+        constexpr auto blockSize = 512;
+        AudioBuffer<float> result (2, numSamples), block (2, blockSize);
+
+        for (int pos = 0; pos < numSamples; pos += blockSize)
+        {
+            const auto numThisTime = jmin (blockSize, numSamples - pos);
+
+            MidiBuffer midi;
+
+            if (pos == 0)
+                midi.addEvent (MidiMessage::noteOn (1, note, 1.0f), 0);
+
+            block.clear();
+            synth.renderNextBlock (block, midi, 0, numThisTime);
+
+            for (int channel = 0; channel < result.getNumChannels(); ++channel)
+                result.copyFrom (channel, pos, block, channel, 0, numThisTime);
+
+            betweenBlocks();
+        }
+
+        return result;
+    }
+};
+
+static StreamingSamplerTests streamingSamplerTests;
+
+#endif
+
 } // namespace juce
@@ -150,4 +150,186 @@ private:
     JUCE_LEAK_DETECTOR (SamplerVoice)
 };
 
+
+//==============================================================================
+/**
+    A subclass of SynthesiserSound that plays a sampled audio clip by streaming it
+    from disk.
+
+    Unlike SamplerSound, only the first part of the sample is loaded into memory.
+    The rest is read from the source on demand by any StreamingSamplerVoice that
+    plays the sound, so very large sample libraries can be used without having
+    to fit them into memory.
+
+    The preloaded section needs to be long enough to cover the time it takes for a
+    voice's background thread to start streaming the rest of the sample after a note
+    starts. If the source is a MemoryMappedAudioFormatReader, the whole file will be
+    mapped, so streaming will read directly from the mapped memory.
+
+    @see StreamingSamplerVoice, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a sound that streams audio from a reader.
+
+        @param name                     a name for the sample
+        @param source                   the audio to play. This object will keep the reader
+                                        and use it to stream audio from background threads
+        @param midiNotes                the set of midi keys that this sound should be played on
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate
+        @param attackTimeSecs           the attack (fade-in) time, in seconds
+        @param releaseTimeSecs          the decay (fade-out) time, in seconds
+        @param preloadTimeSecs          the length of audio to load into memory from the
+                                        start of the source, in seconds
+    */
+    StreamingSamplerSound (const String& name,
+                           std::unique_ptr<AudioFormatReader> source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double preloadTimeSecs);
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the section of the sample that has been loaded into memory. */
+    const AudioBuffer<float>& getPreloadedData() const noexcept { return preloadedData; }
+
+    /** Returns the total length of the sample, in samples. */
+    int64 getLengthInSamples() const noexcept               { return length; }
+
+    //==============================================================================
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    void readFromSource (AudioBuffer<float>& destination, int startSampleInDestBuffer,
+                         int numSamples, int64 startSampleInSource);
+
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    AudioBuffer<float> preloadedData;
+    double sourceSampleRate = 0;
+    BigInteger midiNotes;
+    int64 length = 0;
+    int preloadLength = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+
+//==============================================================================
+/**
+    A subclass of SynthesiserVoice that can play a StreamingSamplerSound.
+
+    When a note starts, the voice plays the preloaded start of the sound straight
+    away, while a TimeSliceThread begins reading the rest of the sample into a ring
+    buffer that belongs to the voice. The voice then carries on playing from the ring
+    buffer, and the background thread keeps it topped up.
+
+    The same TimeSliceThread can be shared by all of the voices in a Synthesiser, and
+    must be kept running for as long as the voices exist. If the thread can't keep up,
+    the voice will output silence for the samples that haven't arrived yet, and
+    record them in its underrun count.
+
+    @see StreamingSamplerSound, SamplerVoice, Synthesiser, TimeSliceThread
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice,
+                                           private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a StreamingSamplerVoice.
+
+        @param backgroundThread     the thread that will stream audio for this voice. Make
+                                    sure that the thread you supply is running, and won't
+                                    be deleted while the voice still exists.
+        @param bufferSizeSamples    the number of samples that will be read ahead of the
+                                    playback position
+    */
+    explicit StreamingSamplerVoice (TimeSliceThread& backgroundThread, int bufferSizeSamples = 32768);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    /** Returns the number of samples that this voice has had to skip because they
+        hadn't been read from disk in time.
+    */
+    int64 getNumUnderrunSamples() const noexcept        { return numUnderrunSamples.load (std::memory_order_relaxed); }
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerTests;
+
+    int useTimeSlice() override;
+    void requestStream (SynthesiserSound::Ptr);
+
+    TimeSliceThread& thread;
+
+    // The ring buffer is written by the background thread and read by the audio thread
+    AbstractFifo fifo;
+    AudioBuffer<float> ringBuffer;
+
+    // Each new note increments the requested generation. The background thread resets
+    // the ring buffer when it sees a new request, and then publishes the generation that
+    // the ring buffer now holds, so that the audio thread knows when it can use it.
+    SpinLock requestLock;
+    SynthesiserSound::Ptr requestedSound;
+    int requestedGeneration = 0;
+    std::atomic<int> streamedGeneration { 0 };
+
+    // Only used by the background thread
+    SynthesiserSound::Ptr streamingSound;
+    int streamingGeneration = 0;
+    int64 nextSampleToStream = 0;
+
+    // Only used by the audio thread
+    bool ringBufferIsLive = false;
+    int64 ringBufferStart = 0;
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0;
+
+    std::atomic<int64> numUnderrunSamples { 0 };
+
+    ADSR adsr;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
 } // namespace juce
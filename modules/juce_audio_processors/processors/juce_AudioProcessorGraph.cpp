@@ -304,6 +304,19 @@ public:
             return false;
         }
 
+        bool isSourceConnectedToOtherNode (const NodeAndChannel& source, NodeID nodeToIgnore) const
+        {
+            if (const auto destIter = map.find (source); destIter != map.cend())
+            {
+                return std::any_of (destIter->second.begin(), destIter->second.end(), [&] (const NodeAndChannel& dest)
+                {
+                    return dest.nodeID != nodeToIgnore;
+                });
+            }
+
+            return false;
+        }
+
     private:
         Map map;
     };
@@ -494,6 +507,132 @@ private:
     std::optional<PrepareSettings> current, next;
 };
 
+//==============================================================================
+/*  A set of high-priority threads that help the audio thread to work through the tasks of a
+    render sequence.
+
+    The audio thread publishes a Job, wakes the workers, and then works on the job itself until
+    every task is complete, so a worker that is slow to wake up only reduces the amount of
+    parallelism - it can never stall the audio callback. Once the job is complete, the audio
+    thread waits for any workers that are still inside the job to leave it. Only atomics are used
+    to hand out work and to join; the only call that may touch a mutex on the audio thread is the
+    WaitableEvent::signal() used to wake sleeping workers.
+*/
+class RenderWorkerPool
+{
+public:
+    /*  A unit of parallel work. runNextTask() and isComplete() will be called concurrently from
+        the audio thread and from every worker thread.
+    */
+    struct Job
+    {
+        virtual ~Job() = default;
+
+        /*  Runs one ready task, returning false if no task was ready. */
+        virtual bool runNextTask() = 0;
+
+        /*  Returns true once every task in the job has finished. */
+        virtual bool isComplete() const = 0;
+    };
+
+    explicit RenderWorkerPool (int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            workers.push_back (std::make_unique<Worker> (*this, i));
+
+        for (auto& worker : workers)
+            worker->start();
+    }
+
+    ~RenderWorkerPool()
+    {
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto& worker : workers)
+        {
+            worker->wakeUp();
+            worker->stopThread (-1);
+        }
+    }
+
+    int getNumThreads() const noexcept { return (int) workers.size(); }
+
+    /*  Call from the audio thread only.
+        Returns once every task in the job has completed and no worker is referencing the job.
+    */
+    void perform (Job& job)
+    {
+        currentJob.store (&job);
+
+        for (auto& worker : workers)
+            worker->wakeUp();
+
+        helpWith (job);
+
+        currentJob.store (nullptr);
+
+        while (numActiveWorkers.load() != 0)
+            Thread::yield();
+    }
+
+private:
+    static void helpWith (Job& job)
+    {
+        while (! job.isComplete())
+            if (! job.runNextTask())
+                Thread::yield();
+    }
+
+    void helpWithCurrentJob()
+    {
+        ++numActiveWorkers;
+
+        if (auto* job = currentJob.load())
+            helpWith (*job);
+
+        --numActiveWorkers;
+    }
+
+    class Worker final : public Thread
+    {
+    public:
+        Worker (RenderWorkerPool& p, int index)
+            : Thread ("Graph render worker " + String (index + 1)), pool (p) {}
+
+        void start()
+        {
+            if (! startRealtimeThread (RealtimeOptions{}.withPriority (9)))
+                startThread (Priority::highest);
+        }
+
+        void wakeUp() { wakeEvent.signal(); }
+
+        void run() override
+        {
+            const ScopedNoDenormals noDenormals;
+
+            while (! threadShouldExit())
+            {
+                wakeEvent.wait (-1.0);
+
+                if (! threadShouldExit())
+                    pool.helpWithCurrentJob();
+            }
+        }
+
+    private:
+        RenderWorkerPool& pool;
+        WaitableEvent wakeEvent;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (RenderWorkerPool)
+};
+
 //==============================================================================
 template <typename FloatType>
 struct GraphRenderSequence
@@ -513,9 +652,14 @@ struct GraphRenderSequence
         GlobalIO globalIO;
         AudioPlayHead* audioPlayHead;
         int numSamples;
+        bool shouldTimeTasks;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer,
+                  MidiBuffer& midiMessages,
+                  AudioPlayHead* audioPlayHead,
+                  RenderWorkerPool* workerPool,
+                  bool shouldTimeTasks)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -534,7 +678,7 @@ struct GraphRenderSequence
 
                 // Splitting up the buffer like this will cause the play head and host time to be
                 // invalid for all but the first chunk...
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, audioPlayHead, workerPool, shouldTimeTasks);
 
                 chunkStartSample += maxSamples;
             }
@@ -552,10 +696,18 @@ struct GraphRenderSequence
                                       midiMessages,
                                       currentMidiOutputBuffer },
                                     audioPlayHead,
-                                    numSamples };
+                                    numSamples,
+                                    shouldTimeTasks };
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            if (workerPool != nullptr && parallelJob != nullptr)
+            {
+                parallelJob->perform (context, *workerPool);
+            }
+            else
+            {
+                for (size_t i = 0; i < tasks.size(); ++i)
+                    runTask (context, i);
+            }
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -587,7 +739,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), { Access::writeAudio (index) });
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -612,7 +764,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { Access::readAudio (srcIndex), Access::writeAudio (dstIndex) });
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -637,7 +789,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { Access::readAudio (srcIndex), Access::writeAudio (dstIndex) });
     }
 
     JUCE_END_IGNORE_WARNINGS_MSVC
@@ -662,7 +814,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), { Access::writeMidi (index) });
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
@@ -687,7 +839,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { Access::readMidi (srcIndex), Access::writeMidi (dstIndex) });
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
@@ -712,7 +864,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { Access::readMidi (srcIndex), Access::writeMidi (dstIndex) });
     }
 
     void addDelayChannelOp (int chan, int delaySize)
@@ -751,14 +903,22 @@ struct GraphRenderSequence
             int readIndex = 0, writeIndex;
         };
 
-        renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
+        addOp (std::make_unique<DelayChannelOp> (chan, delaySize), { Access::writeAudio (chan) });
     }
 
     void addProcessOp (const Node::Ptr& node,
                        const Array<int>& audioChannelsUsed,
                        int totalNumChans,
-                       int midiBuffer)
+                       int midiBuffer,
+                       int latencySamples)
     {
+        std::vector<Access> accesses;
+
+        for (const auto channel : audioChannelsUsed)
+            accesses.push_back (Access::writeAudio (channel));
+
+        accesses.push_back (Access::writeMidi (midiBuffer));
+
         auto op = [&]() -> std::unique_ptr<NodeOp>
         {
             if (auto* ioNode = dynamic_cast<const AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()))
@@ -769,12 +929,14 @@ struct GraphRenderSequence
                         return std::make_unique<AudioInOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode:
+                        accesses.push_back (Access::writeGlobalAudioOut());
                         return std::make_unique<AudioOutOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode:
                         return std::make_unique<MidiInOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode:
+                        accesses.push_back (Access::writeGlobalMidiOut());
                         return std::make_unique<MidiOutOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
                 }
             }
@@ -782,7 +944,17 @@ struct GraphRenderSequence
             return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
         }();
 
-        renderOps.push_back (std::move (op));
+        addOp (std::move (op), accesses);
+
+        // Each node's process op completes a task containing the node and all of the ops that
+        // gather its inputs.
+        Task task;
+        task.firstOp = tasks.empty() ? 0 : tasks.back().endOp;
+        task.endOp = renderOps.size();
+        task.nodeID = node->nodeID;
+        task.latencySamples = latencySamples;
+        task.accesses = std::exchange (pendingAccesses, {});
+        tasks.push_back (std::move (task));
     }
 
     void prepareBuffers (int blockSize)
@@ -806,6 +978,55 @@ struct GraphRenderSequence
 
         for (const auto& op : renderOps)
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
+
+        buildTaskGraph();
+    }
+
+    /*  Call from the main thread only. */
+    AudioProcessorGraph::RenderProfile getRenderProfile() const
+    {
+        AudioProcessorGraph::RenderProfile result;
+        std::vector<double> finishTimes (tasks.size(), 0.0);
+
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            const auto& task = tasks[i];
+
+            AudioProcessorGraph::NodeRenderProfile node;
+            node.nodeID = task.nodeID;
+            node.latencySamples = task.latencySamples;
+            node.averageProcessingTimeMs = taskTimers[i].getAverageMs();
+
+            for (const auto dependency : task.dependencies)
+                node.earliestStartMs = jmax (node.earliestStartMs, finishTimes[dependency]);
+
+            finishTimes[i] = node.earliestStartMs + node.averageProcessingTimeMs;
+            result.totalProcessingTimeMs += node.averageProcessingTimeMs;
+            result.criticalPathMs = jmax (result.criticalPathMs, finishTimes[i]);
+            result.nodes.push_back (node);
+        }
+
+        // Walk backwards from the last node to finish, following the dependencies that determined
+        // each node's start time.
+        auto last = std::max_element (finishTimes.begin(), finishTimes.end());
+
+        for (auto index = last != finishTimes.end() ? std::optional<size_t> ((size_t) std::distance (finishTimes.begin(), last))
+                                                    : std::nullopt;
+             index.has_value();)
+        {
+            auto& node = result.nodes[*index];
+            node.isOnCriticalPath = true;
+
+            const auto& dependencies = tasks[*index].dependencies;
+            const auto critical = std::find_if (dependencies.begin(), dependencies.end(), [&] (auto dependency)
+            {
+                return exactlyEqual (finishTimes[dependency], node.earliestStartMs);
+            });
+
+            index = critical != dependencies.end() ? std::optional<size_t> (*critical) : std::nullopt;
+        }
+
+        return result;
     }
 
     int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
@@ -826,6 +1047,234 @@ private:
         virtual void process (const Context&) = 0;
     };
 
+    //==============================================================================
+    /*  Describes a buffer that a render op reads or writes, so that the ops that can safely run
+        at the same time can be worked out.
+    */
+    struct Access
+    {
+        enum class Resource { audioBuffer, midiBuffer, globalAudioOut, globalMidiOut };
+
+        static Access readAudio  (int index)    { return { Resource::audioBuffer, index, false }; }
+        static Access writeAudio (int index)    { return { Resource::audioBuffer, index, true }; }
+        static Access readMidi   (int index)    { return { Resource::midiBuffer,  index, false }; }
+        static Access writeMidi  (int index)    { return { Resource::midiBuffer,  index, true }; }
+        static Access writeGlobalAudioOut()     { return { Resource::globalAudioOut, 0, true }; }
+        static Access writeGlobalMidiOut()      { return { Resource::globalMidiOut,  0, true }; }
+
+        int64 getKey() const { return ((int64) resource << 32) | (int64) (uint32) index; }
+
+        Resource resource;
+        int index;
+        bool isWrite;
+    };
+
+    /*  A contiguous run of render ops, ending with the op that processes a single node. */
+    struct Task
+    {
+        size_t firstOp = 0, endOp = 0;
+        AudioProcessorGraph::NodeID nodeID;
+        int latencySamples = 0;
+
+        std::vector<Access> accesses;
+        std::vector<size_t> dependencies;   // tasks that must finish before this one can start
+        std::vector<size_t> dependents;     // tasks that may only start once this one has finished
+    };
+
+    struct TaskTimer
+    {
+        void add (int64 ticks) noexcept
+        {
+            totalTicks.fetch_add (ticks, std::memory_order_relaxed);
+            numRuns.fetch_add (1, std::memory_order_relaxed);
+        }
+
+        double getAverageMs() const noexcept
+        {
+            const auto runs = numRuns.load (std::memory_order_relaxed);
+            return runs > 0 ? Time::highResolutionTicksToSeconds (totalTicks.load (std::memory_order_relaxed)) * 1000.0 / (double) runs
+                            : 0.0;
+        }
+
+        std::atomic<int64> totalTicks { 0 }, numRuns { 0 };
+    };
+
+    /*  Hands the tasks of this sequence out to the threads of a RenderWorkerPool, starting each
+        task once all of the tasks it depends on have finished.
+        All storage is allocated up-front, so perform() neither allocates nor locks.
+    */
+    class ParallelJob final : public RenderWorkerPool::Job
+    {
+    public:
+        explicit ParallelJob (GraphRenderSequence& s)
+            : sequence (s),
+              numTasks (s.tasks.size()),
+              pendingDependencies (std::make_unique<std::atomic<int>[]> (numTasks)),
+              readyTasks (std::make_unique<std::atomic<int>[]> (numTasks))
+        {
+        }
+
+        void perform (const Context& c, RenderWorkerPool& pool)
+        {
+            context = &c;
+            readIndex.store (0, std::memory_order_relaxed);
+            writeIndex.store (0, std::memory_order_relaxed);
+            numRemaining.store ((int) numTasks, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < numTasks; ++i)
+            {
+                pendingDependencies[i].store ((int) sequence.tasks[i].dependencies.size(), std::memory_order_relaxed);
+                readyTasks[i].store (-1, std::memory_order_relaxed);
+            }
+
+            for (size_t i = 0; i < numTasks; ++i)
+                if (sequence.tasks[i].dependencies.empty())
+                    pushReadyTask (i);
+
+            pool.perform (*this);
+        }
+
+        bool runNextTask() override
+        {
+            const auto index = popReadyTask();
+
+            if (index < 0)
+                return false;
+
+            sequence.runTask (*context, (size_t) index);
+
+            for (const auto dependent : sequence.tasks[(size_t) index].dependents)
+                if (pendingDependencies[dependent].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                    pushReadyTask (dependent);
+
+            numRemaining.fetch_sub (1, std::memory_order_acq_rel);
+            return true;
+        }
+
+        bool isComplete() const override
+        {
+            return numRemaining.load (std::memory_order_acquire) == 0;
+        }
+
+    private:
+        // Every task becomes ready exactly once per block, so the queue never needs to wrap.
+        void pushReadyTask (size_t index)
+        {
+            const auto slot = writeIndex.fetch_add (1, std::memory_order_acq_rel);
+            readyTasks[(size_t) slot].store ((int) index, std::memory_order_release);
+        }
+
+        int popReadyTask()
+        {
+            auto slot = readIndex.load (std::memory_order_acquire);
+
+            while (slot < writeIndex.load (std::memory_order_acquire))
+            {
+                if (readIndex.compare_exchange_weak (slot, slot + 1, std::memory_order_acq_rel))
+                {
+                    // The slot has been claimed, but the task might still be in the process of
+                    // being written.
+                    for (;;)
+                    {
+                        const auto index = readyTasks[(size_t) slot].load (std::memory_order_acquire);
+
+                        if (index >= 0)
+                            return index;
+
+                        Thread::yield();
+                    }
+                }
+            }
+
+            return -1;
+        }
+
+        GraphRenderSequence& sequence;
+        const size_t numTasks;
+        std::unique_ptr<std::atomic<int>[]> pendingDependencies, readyTasks;
+        std::atomic<int> readIndex { 0 }, writeIndex { 0 }, numRemaining { 0 };
+        const Context* context = nullptr;
+    };
+
+    void addOp (std::unique_ptr<RenderOp> op, const std::vector<Access>& accesses)
+    {
+        renderOps.push_back (std::move (op));
+        pendingAccesses.insert (pendingAccesses.end(), accesses.begin(), accesses.end());
+    }
+
+    /*  Works out which tasks must wait for others, by finding tasks that touch the same buffer
+        where at least one of them writes to it. The tasks are already in a valid serial order,
+        so dependencies always point forwards.
+    */
+    void buildTaskGraph()
+    {
+        std::unordered_map<int64, size_t> lastWriters;
+        std::unordered_map<int64, std::vector<size_t>> readersSinceLastWrite;
+
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            auto& task = tasks[i];
+            auto& dependencies = task.dependencies;
+
+            for (const auto& access : task.accesses)
+            {
+                const auto key = access.getKey();
+
+                if (const auto iter = lastWriters.find (key); iter != lastWriters.end())
+                    dependencies.push_back (iter->second);
+
+                if (access.isWrite)
+                    if (const auto iter = readersSinceLastWrite.find (key); iter != readersSinceLastWrite.end())
+                        dependencies.insert (dependencies.end(), iter->second.begin(), iter->second.end());
+            }
+
+            for (const auto& access : task.accesses)
+                if (! access.isWrite)
+                    readersSinceLastWrite[access.getKey()].push_back (i);
+
+            for (const auto& access : task.accesses)
+            {
+                if (access.isWrite)
+                {
+                    lastWriters[access.getKey()] = i;
+
+                    if (const auto iter = readersSinceLastWrite.find (access.getKey()); iter != readersSinceLastWrite.end())
+                        iter->second.clear();
+                }
+            }
+
+            std::sort (dependencies.begin(), dependencies.end());
+            dependencies.erase (std::unique (dependencies.begin(), dependencies.end()), dependencies.end());
+            dependencies.erase (std::remove (dependencies.begin(), dependencies.end(), i), dependencies.end());
+
+            for (const auto dependency : dependencies)
+                tasks[dependency].dependents.push_back (i);
+        }
+
+        taskTimers = std::make_unique<TaskTimer[]> (tasks.size());
+        parallelJob = std::make_unique<ParallelJob> (*this);
+    }
+
+    void runTask (const Context& c, size_t index)
+    {
+        const auto& task = tasks[index];
+
+        if (! c.shouldTimeTasks)
+        {
+            for (auto i = task.firstOp; i < task.endOp; ++i)
+                renderOps[i]->process (c);
+
+            return;
+        }
+
+        const auto startTicks = Time::getHighResolutionTicks();
+
+        for (auto i = task.firstOp; i < task.endOp; ++i)
+            renderOps[i]->process (c);
+
+        taskTimers[index].add (Time::getHighResolutionTicks() - startTicks);
+    }
+
     struct NodeOp : public RenderOp
     {
         NodeOp (const Node::Ptr& n,
@@ -987,6 +1436,10 @@ private:
     };
 
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::vector<Access> pendingAccesses;
+    std::vector<Task> tasks;
+    std::unique_ptr<TaskTimer[]> taskTimers;
+    std::unique_ptr<ParallelJob> parallelJob;
 };
 
 //==============================================================================
@@ -1010,17 +1463,22 @@ public:
 
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
+    /*  If buildForParallelRendering is true, buffers are never shared between nodes that aren't
+        connected to one another, so that independent branches of the graph don't end up
+        waiting for each other. This uses more memory than the serial sequence.
+    */
     template <typename FloatType>
-    static SequenceAndLatency build (const Nodes& n, const Connections& c)
+    static SequenceAndLatency build (const Nodes& n, const Connections& c, bool buildForParallelRendering)
     {
         GraphRenderSequence<FloatType> sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
+        const RenderSequenceBuilder builder (n, c, sequence, buildForParallelRendering);
         return { std::move (sequence), builder.totalLatency };
     }
 
 private:
     //==============================================================================
     const Array<Node*> orderedNodes;
+    const bool isParallel;
 
     struct AssignedBuffer
     {
@@ -1134,11 +1592,17 @@ private:
         // Handle an unconnected input channel...
         if (sources.empty())
         {
-            if (inputChan >= numOuts)
+            // When rendering in parallel, an input-only channel gets a buffer of its own, so that
+            // a processor that writes to it can't affect nodes running on other threads.
+            if (inputChan >= numOuts && ! isParallel)
                 return readOnlyEmptyBufferIndex;
 
             auto index = getFreeBuffer (audioBuffers);
             sequence.addClearChannelOp (index);
+
+            if (inputChan >= numOuts)
+                audioBuffers.getReference (index).setAssignedToNonExistentNode();
+
             return index;
         }
 
@@ -1157,13 +1621,16 @@ private:
                 jassert (bufIndex >= 0);
             }
 
-            if (inputChan < numOuts && isBufferNeededLater (reversed, ourRenderingIndex, inputChan, src))
+            if ((inputChan < numOuts || isParallel) && isSourceBufferShared (reversed, ourRenderingIndex, inputChan, node.nodeID, src))
             {
-                // can't mess up this channel because it's needed later by another node,
+                // can't mess up this channel because it's needed by another node,
                 // so we need to use a copy of it..
                 auto newFreeBuffer = getFreeBuffer (audioBuffers);
                 sequence.addCopyChannelOp (bufIndex, newFreeBuffer);
                 bufIndex = newFreeBuffer;
+
+                if (inputChan >= numOuts)
+                    audioBuffers.getReference (bufIndex).setAssignedToNonExistentNode();
             }
 
             auto nodeDelay = getNodeDelay (src.nodeID);
@@ -1184,7 +1651,7 @@ private:
             {
                 auto sourceBufIndex = getBufferContaining (src);
 
-                if (sourceBufIndex >= 0 && ! isBufferNeededLater (reversed, ourRenderingIndex, inputChan, src))
+                if (sourceBufIndex >= 0 && ! isSourceBufferShared (reversed, ourRenderingIndex, inputChan, node.nodeID, src))
                 {
                     // we've found one of our input chans that can be re-used..
                     reusableInputIndex = i;
@@ -1238,7 +1705,7 @@ private:
 
                         if (nodeDelay < maxLatency)
                         {
-                            if (! isBufferNeededLater (reversed, ourRenderingIndex, inputChan, src))
+                            if (! isSourceBufferShared (reversed, ourRenderingIndex, inputChan, node.nodeID, src))
                             {
                                 sequence.addDelayChannelOp (srcIndex, maxLatency - nodeDelay);
                             }
@@ -1246,6 +1713,11 @@ private:
                             {
                                 auto bufferToDelay = getFreeBuffer (audioBuffers);
                                 sequence.addCopyChannelOp (srcIndex, bufferToDelay);
+
+                                // Stops a node on another thread from being given the same buffer
+                                if (isParallel)
+                                    audioBuffers.getReference (bufferToDelay).setAssignedToNonExistentNode();
+
                                 sequence.addDelayChannelOp (bufferToDelay, maxLatency - nodeDelay);
                                 srcIndex = bufferToDelay;
                             }
@@ -1291,9 +1763,9 @@ private:
 
             if (midiBufferToUse >= 0)
             {
-                if (isBufferNeededLater (reversed, ourRenderingIndex, midiChannelIndex, src))
+                if (isSourceBufferShared (reversed, ourRenderingIndex, midiChannelIndex, node.nodeID, src))
                 {
-                    // can't mess up this channel because it's needed later by another node, so we
+                    // can't mess up this channel because it's needed by another node, so we
                     // need to use a copy of it..
                     auto newFreeBuffer = getFreeBuffer (midiBuffers);
                     sequence.addCopyMidiBufferOp (midiBufferToUse, newFreeBuffer);
@@ -1320,7 +1792,7 @@ private:
                 auto sourceBufIndex = getBufferContaining (src);
 
                 if (sourceBufIndex >= 0
-                    && ! isBufferNeededLater (reversed, ourRenderingIndex, midiChannelIndex, src))
+                    && ! isSourceBufferShared (reversed, ourRenderingIndex, midiChannelIndex, node.nodeID, src))
                 {
                     // we've found one of our input buffers that can be re-used..
                     reusableInputIndex = i;
@@ -1413,6 +1885,8 @@ private:
 
         if (processor.producesMidi())
             midiBuffers.getReference (midiBufferToUse).channel = { node.nodeID, midiChannelIndex };
+        else if (isParallel)
+            midiBuffers.getReference (midiBufferToUse).setAssignedToNonExistentNode(); // every node still writes to its MIDI buffer
 
         const auto thisNodeLatency = maxInputLatency + processor.getLatencySamples();
         delays[node.nodeID.uid] = thisNodeLatency;
@@ -1420,7 +1894,11 @@ private:
         if (numOuts == 0)
             totalLatency = jmax (totalLatency, thisNodeLatency);
 
-        sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse);
+        sequence.addProcessOp (node,
+                               audioChannelsToUse,
+                               totalChans,
+                               midiBufferToUse,
+                               thisNodeLatency);
     }
 
     //==============================================================================
@@ -1453,6 +1931,9 @@ private:
                                      Array<AssignedBuffer>& buffers,
                                      const int stepIndex)
     {
+        if (isParallel)
+            return;
+
         for (auto& b : buffers)
             if (b.isAssigned() && ! isBufferNeededLater (c, stepIndex, -1, b.channel))
                 b.setFree();
@@ -1479,9 +1960,27 @@ private:
         });
     }
 
+    /*  Returns true if the node at stepIndex mustn't write to the buffer holding a source's output.
+
+        In a serial sequence, that's only the case if a later node still needs the buffer. When
+        rendering in parallel, a node that wrote to it would also have to wait for every earlier
+        node that reads it, so the nodes that a source fans out to would never run at the same
+        time. Instead, each of them gets a copy of its own.
+    */
+    bool isSourceBufferShared (const Connections::DestinationsForSources& c,
+                               const int stepIndex,
+                               const int inputChannel,
+                               const NodeID nodeID,
+                               const NodeAndChannel output) const
+    {
+        return isBufferNeededLater (c, stepIndex, inputChannel, output)
+            || (isParallel && c.isSourceConnectedToOtherNode (output, nodeID));
+    }
+
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
-        : orderedNodes (createOrderedNodeList (n, c))
+    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence, bool parallel)
+        : orderedNodes (createOrderedNodeList (n, c)),
+          isParallel (parallel)
     {
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
         midiBuffers .add (AssignedBuffer::createReadOnlyEmpty());
@@ -1512,18 +2011,23 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    std::shared_ptr<RenderWorkerPool> pool)
+        : RenderSequence (s,
+                          s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                              ? RenderSequenceBuilder::build<float>  (n, c, pool != nullptr)
+                              : RenderSequenceBuilder::build<double> (n, c, pool != nullptr),
+                          pool) // not moved, as the arguments may be evaluated in any order
     {
     }
 
     template <typename FloatType>
-    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead, bool shouldTimeNodes)
     {
         if (auto* s = std::get_if<GraphRenderSequence<FloatType>> (&sequence.sequence))
-            s->perform (audio, midi, playHead);
+            s->perform (audio, midi, playHead, workerPool.get(), shouldTimeNodes);
         else
             jassertfalse; // Not prepared for this audio format!
     }
@@ -1531,6 +2035,13 @@ public:
     int getLatencySamples() const { return sequence.latencySamples; }
     PrepareSettings getSettings() const { return settings; }
 
+    AudioProcessorGraph::RenderProfile getRenderProfile() const
+    {
+        AudioProcessorGraph::RenderProfile result;
+        visitRenderSequence (*this, [&] (auto& seq) { result = seq.getRenderProfile(); });
+        return result;
+    }
+
 private:
     template <typename This, typename Callback>
     static void visitRenderSequence (This& t, Callback&& callback)
@@ -1540,14 +2051,15 @@ private:
         jassertfalse;
     }
 
-    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built)
-        : settings (s), sequence (std::move (built))
+    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built, std::shared_ptr<RenderWorkerPool> pool)
+        : settings (s), sequence (std::move (built)), workerPool (std::move (pool))
     {
         visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize); });
     }
 
     PrepareSettings settings;
     SequenceAndLatency sequence;
+    std::shared_ptr<RenderWorkerPool> workerPool;
 };
 
 //==============================================================================
@@ -1576,11 +2088,11 @@ public:
 */
 class RenderSequenceSignature
 {
-    auto tie() const { return std::tie (settings, connections, nodes); }
+    auto tie() const { return std::tie (settings, connections, nodes, numWorkerThreads); }
 
 public:
-    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : settings (s), connections (c), nodes (getNodeMap (n)) {}
+    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c, int numThreads)
+        : settings (s), connections (c), nodes (getNodeMap (n)), numWorkerThreads (numThreads) {}
 
     bool operator== (const RenderSequenceSignature& other) const { return tie() == other.tie(); }
     bool operator!= (const RenderSequenceSignature& other) const { return tie() != other.tie(); }
@@ -1607,6 +2119,7 @@ private:
     PrepareSettings settings;
     Connections connections;
     NodeMap nodes;
+    int numWorkerThreads = 0;
 };
 
 //==============================================================================
@@ -1653,6 +2166,17 @@ public:
     /*  Call from the audio thread only. */
     RenderSequence* getAudioThreadState() const { return audioThreadState.get(); }
 
+    /*  Call from the main thread only.
+        Sequences are only ever deleted on the main thread, so the sequence passed to the
+        callback will stay alive until the callback returns.
+    */
+    template <typename Callback>
+    void visitAudioThreadState (Callback&& callback)
+    {
+        const SpinLock::ScopedLockType lock (mutex);
+        callback (audioThreadState.get());
+    }
+
 private:
     void timerCallback() override
     {
@@ -1890,7 +2414,7 @@ public:
         // Only process if the graph has the correct blockSize, sampleRate etc.
         if (state != nullptr && state->getSettings() == nodeStates.getLastRequestedSettings())
         {
-            state->process (audio, midi, playHead);
+            state->process (audio, midi, playHead, renderProfilingEnabled.load (std::memory_order_relaxed));
         }
         else
         {
@@ -1902,6 +2426,45 @@ public:
     /*  Call from the audio thread only. */
     auto* getAudioThreadState() const { return renderSequenceExchange.getAudioThreadState(); }
 
+    void setNumWorkerThreads (int numThreads)
+    {
+        numThreads = jmax (0, numThreads);
+
+        if (numThreads == getNumWorkerThreads())
+            return;
+
+        workerPool = numThreads > 0 ? std::make_shared<RenderWorkerPool> (numThreads) : nullptr;
+        rebuild (UpdateKind::sync);
+    }
+
+    int getNumWorkerThreads() const noexcept
+    {
+        return workerPool != nullptr ? workerPool->getNumThreads() : 0;
+    }
+
+    RenderProfile getRenderProfile()
+    {
+        RenderProfile result;
+
+        renderSequenceExchange.visitAudioThreadState ([&] (const RenderSequence* sequence)
+        {
+            if (sequence != nullptr)
+                result = sequence->getRenderProfile();
+        });
+
+        return result;
+    }
+
+    void setRenderProfilingEnabled (bool shouldBeEnabled) noexcept
+    {
+        renderProfilingEnabled.store (shouldBeEnabled, std::memory_order_relaxed);
+    }
+
+    bool isRenderProfilingEnabled() const noexcept
+    {
+        return renderProfilingEnabled.load (std::memory_order_relaxed);
+    }
+
 private:
     void setParentGraph (AudioProcessor* p) const
     {
@@ -1922,11 +2485,11 @@ private:
             for (const auto node : nodes.getNodes())
                 setParentGraph (node->getProcessor());
 
-            const RenderSequenceSignature newSignature (*newSettings, nodes, connections);
+            const RenderSequenceSignature newSignature (*newSettings, nodes, connections, getNumWorkerThreads());
 
             if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
             {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections, workerPool);
                 owner->setLatencySamples (sequence->getLatencySamples());
                 renderSequenceExchange.set (std::move (sequence));
             }
@@ -1942,6 +2505,8 @@ private:
     Nodes nodes;
     Connections connections;
     NodeStates nodeStates;
+    std::shared_ptr<RenderWorkerPool> workerPool;
+    std::atomic<bool> renderProfilingEnabled { false };
     RenderSequenceExchange renderSequenceExchange;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
@@ -1974,6 +2539,11 @@ void AudioProcessorGraph::releaseResources()
 bool AudioProcessorGraph::removeIllegalConnections (UpdateKind updateKind)                                  { return pimpl->removeIllegalConnections (updateKind); }
 void AudioProcessorGraph::rebuild()                                                                         { return pimpl->rebuild (UpdateKind::sync); }
 void AudioProcessorGraph::reset()                                                                           { return pimpl->reset(); }
+void AudioProcessorGraph::setNumWorkerThreads (int numThreads)                                              { return pimpl->setNumWorkerThreads (numThreads); }
+int AudioProcessorGraph::getNumWorkerThreads() const noexcept                                               { return pimpl->getNumWorkerThreads(); }
+AudioProcessorGraph::RenderProfile AudioProcessorGraph::getRenderProfile() const                            { return pimpl->getRenderProfile(); }
+void AudioProcessorGraph::setRenderProfilingEnabled (bool shouldBeEnabled) noexcept                         { return pimpl->setRenderProfilingEnabled (shouldBeEnabled); }
+bool AudioProcessorGraph::isRenderProfilingEnabled() const noexcept                                         { return pimpl->isRenderProfilingEnabled(); }
 bool AudioProcessorGraph::canConnect (const Connection& c) const                                            { return pimpl->canConnect (c); }
 bool AudioProcessorGraph::isConnected (const Connection& c) const noexcept                                  { return pimpl->isConnected (c); }
 bool AudioProcessorGraph::isConnected (NodeID a, NodeID b) const noexcept                                   { return pimpl->isConnected (a, b); }
@@ -2294,12 +2864,203 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("rendering with worker threads produces the same output as serial rendering");
+        {
+            const auto serial = renderBranchingGraph (0);
+
+            for (const auto numThreads : { 1, 3 })
+            {
+                const auto parallel = renderBranchingGraph (numThreads);
+
+                expectEquals (parallel.getNumChannels(), serial.getNumChannels());
+                expectEquals (parallel.getNumSamples(),  serial.getNumSamples());
+
+                for (auto channel = 0; channel < serial.getNumChannels(); ++channel)
+                    expect (std::equal (serial.getReadPointer (channel),
+                                        serial.getReadPointer (channel) + serial.getNumSamples(),
+                                        parallel.getReadPointer (channel)));
+            }
+        }
+
+        beginTest ("render profile reports every node and the critical path");
+        {
+            AudioProcessorGraph graph;
+            graph.setNumWorkerThreads (2);
+            expectEquals (graph.getNumWorkerThreads(), 2);
+
+            const auto nodeA = graph.addNode (GainProcessor::make (1.0f))->nodeID;
+            const auto nodeB = graph.addNode (GainProcessor::make (1.0f))->nodeID;
+            const auto nodeC = graph.addNode (GainProcessor::make (1.0f))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+                expect (graph.addConnection ({ { nodeA, channel }, { nodeB, channel } }));
+
+            const auto latency = 64;
+            graph.getNodeForId (nodeA)->getProcessor()->setLatencySamples (latency);
+
+            graph.prepareToPlay (44100.0, 64);
+
+            AudioBuffer<float> audio (2, 64);
+            MidiBuffer midi;
+
+            graph.processBlock (audio, midi);
+            expect (! graph.isRenderProfilingEnabled());
+            expectEquals (graph.getRenderProfile().totalProcessingTimeMs, 0.0);
+
+            graph.setRenderProfilingEnabled (true);
+            expect (graph.isRenderProfilingEnabled());
+
+            for (auto i = 0; i < 4; ++i)
+                graph.processBlock (audio, midi);
+
+            const auto profile = graph.getRenderProfile();
+            expectEquals ((int) profile.nodes.size(), 3);
+
+            const auto findNode = [&] (AudioProcessorGraph::NodeID id)
+            {
+                return *std::find_if (profile.nodes.begin(), profile.nodes.end(), [&] (const auto& n) { return n.nodeID == id; });
+            };
+
+            expectEquals (findNode (nodeB).latencySamples, latency);
+            expect (findNode (nodeB).earliestStartMs >= findNode (nodeA).averageProcessingTimeMs);
+            expectEquals (findNode (nodeC).earliestStartMs, 0.0);
+            expect (profile.criticalPathMs <= profile.totalProcessingTimeMs);
+            expect (profile.getMaximumSpeedup() >= 1.0);
+
+            graph.setNumWorkerThreads (0);
+            expectEquals (graph.getNumWorkerThreads(), 0);
+        }
+
+        beginTest ("nodes that share a source are rendered at the same time");
+        {
+            // Each branch waits inside its processBlock() until the other one has started, so the
+            // branches can only both get in if they're running on different threads.
+            std::atomic<int> numInside { 0 }, maxInside { 0 };
+
+            const auto waitForOtherBranch = [&]
+            {
+                const auto inside = ++numInside;
+
+                for (auto current = maxInside.load(); current < inside && ! maxInside.compare_exchange_weak (current, inside);)
+                    ;
+
+                for (auto i = 0; i < 1000 && maxInside.load() < 2; ++i)
+                    Thread::sleep (1);
+
+                --numInside;
+            };
+
+            AudioProcessorGraph graph;
+            graph.setNumWorkerThreads (1);
+            graph.setPlayConfigDetails (2, 2, 44100.0, 64);
+            graph.setRenderProfilingEnabled (true);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input   = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+            const auto branchA = graph.addNode (GainProcessor::make (0.5f, waitForOtherBranch))->nodeID;
+            const auto branchB = graph.addNode (GainProcessor::make (0.25f, waitForOtherBranch))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                for (const auto branch : { branchA, branchB })
+                {
+                    expect (graph.addConnection ({ { input,  channel }, { branch, channel } }));
+                    expect (graph.addConnection ({ { branch, channel }, { output, channel } }));
+                }
+            }
+
+            graph.prepareToPlay (44100.0, 64);
+
+            AudioBuffer<float> audio (2, 64);
+            MidiBuffer midi;
+
+            for (auto channel = 0; channel < 2; ++channel)
+                FloatVectorOperations::fill (audio.getWritePointer (channel), 1.0f, 64);
+
+            graph.processBlock (audio, midi);
+
+            expectEquals (maxInside.load(), 2);
+
+            for (auto channel = 0; channel < 2; ++channel)
+                expectEquals (audio.getSample (channel, 10), 0.75f);
+
+            // Neither branch has to wait for the other, so they could both start at the same time
+            const auto profile = graph.getRenderProfile();
+
+            const auto findNode = [&] (AudioProcessorGraph::NodeID id)
+            {
+                return *std::find_if (profile.nodes.begin(), profile.nodes.end(), [&] (const auto& n) { return n.nodeID == id; });
+            };
+
+            expectEquals (findNode (branchA).earliestStartMs, findNode (branchB).earliestStartMs);
+            expect (findNode (branchA).isOnCriticalPath != findNode (branchB).isOnCriticalPath);
+        }
     }
 
 private:
     enum class MidiIn  { no, yes };
     enum class MidiOut { no, yes };
 
+    /*  Renders a few blocks through a graph in which the input fans out to several branches
+        with different gains and latencies, which are then mixed back together.
+    */
+    static AudioBuffer<float> renderBranchingGraph (int numWorkerThreads)
+    {
+        constexpr auto numChannels = 2, blockSize = 128, numBlocks = 8, numBranches = 6;
+
+        AudioProcessorGraph graph;
+        graph.setNumWorkerThreads (numWorkerThreads);
+        graph.setPlayConfigDetails (numChannels, numChannels, 44100.0, blockSize);
+
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+        const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+        const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+        const auto mix    = graph.addNode (GainProcessor::make (0.5f))->nodeID;
+
+        for (auto i = 0; i < numBranches; ++i)
+        {
+            const auto first  = graph.addNode (GainProcessor::make (0.25f * (float) (i + 1)))->nodeID;
+            const auto second = graph.addNode (GainProcessor::make (1.0f - 0.1f * (float) i))->nodeID;
+            graph.getNodeForId (second)->getProcessor()->setLatencySamples (i * 7);
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+            {
+                graph.addConnection ({ { input,  channel }, { first,  channel } });
+                graph.addConnection ({ { first,  channel }, { second, channel } });
+                graph.addConnection ({ { second, channel }, { mix,    channel } });
+
+                // Some branches also feed the output directly
+                if (i % 2 == 0)
+                    graph.addConnection ({ { first, channel }, { output, channel } });
+            }
+        }
+
+        for (auto channel = 0; channel < numChannels; ++channel)
+            graph.addConnection ({ { mix, channel }, { output, channel } });
+
+        graph.prepareToPlay (44100.0, blockSize);
+
+        AudioBuffer<float> result (numChannels, blockSize * numBlocks);
+        AudioBuffer<float> block (numChannels, blockSize);
+        MidiBuffer midi;
+
+        for (auto b = 0; b < numBlocks; ++b)
+        {
+            for (auto channel = 0; channel < numChannels; ++channel)
+                for (auto i = 0; i < blockSize; ++i)
+                    block.setSample (channel, i, std::sin ((float) (b * blockSize + i) * 0.01f * (float) (channel + 1)));
+
+            graph.processBlock (block, midi);
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+                result.copyFrom (channel, b * blockSize, block, channel, 0, blockSize);
+        }
+
+        return result;
+    }
+
     class BasicProcessor final : public AudioProcessor
     {
     public:
@@ -2357,6 +3118,50 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    class GainProcessor final : public AudioProcessor
+    {
+    public:
+        GainProcessor (float g, std::function<void()> onProcessIn)
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())),
+              gain (g),
+              onProcess (std::move (onProcessIn)) {}
+
+        const String getName() const override                         { return "Gain Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>& audio, MidiBuffer&) override
+        {
+            if (onProcess != nullptr)
+                onProcess();
+
+            audio.applyGain (gain);
+        }
+
+        using AudioProcessor::processBlock;
+
+        static std::unique_ptr<AudioProcessor> make (float gain, std::function<void()> onProcess = nullptr)
+        {
+            return std::make_unique<GainProcessor> (gain, std::move (onProcess));
+        }
+
+    private:
+        float gain = 1.0f;
+        std::function<void()> onProcess;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
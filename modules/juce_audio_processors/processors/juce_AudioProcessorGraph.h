@@ -323,6 +323,112 @@ public:
     */
     void rebuild();
 
+    //==============================================================================
+    /** Sets the number of worker threads that help to render the graph.
+
+        By default this is 0, and processBlock() renders every node in turn on the thread
+        that calls it. With one or more worker threads, each node and the operations that
+        gather its inputs become a separate task, and the dependencies between these tasks
+        are worked out from the buffers that they share. During processBlock(), tasks are
+        started as soon as the tasks they depend on have finished, and are shared between the
+        calling thread and the worker threads. processBlock() returns once every task is done.
+
+        Handing out and joining tasks doesn't lock or allocate, and the calling thread never
+        waits for a worker to wake up, but processors in the graph will have their
+        processBlock() methods called on several different threads, and at the same time as
+        other processors in the graph. Each processor is still only processed by one thread at
+        a time, and the same AudioPlayHead will be shared by all of them.
+
+        A parallel render sequence also uses more memory than a serial one, because channel
+        buffers are no longer reused between unconnected nodes, and nodes that are fed by the
+        same output each get a copy of it, so that they don't have to wait for one another.
+
+        Changing the number of threads will cause the graph to be rebuilt.
+
+        @see getRenderProfile
+    */
+    void setNumWorkerThreads (int numThreads);
+
+    /** Returns the number of worker threads set with setNumWorkerThreads(). */
+    int getNumWorkerThreads() const noexcept;
+
+    /** Timing information about a single node, as returned by getRenderProfile(). */
+    struct NodeRenderProfile
+    {
+        /** The node that this profile describes. */
+        NodeID nodeID;
+
+        /** The average time taken to render this node in each block, including the time spent
+            mixing, copying and delaying its inputs.
+        */
+        double averageProcessingTimeMs = 0.0;
+
+        /** The earliest point in each block, measured from the start of the block, at which this
+            node could start if there were always a free thread for it once every node that it
+            depends on had finished.
+        */
+        double earliestStartMs = 0.0;
+
+        /** The latency of this node's outputs, in samples, including the latency of every node
+            that feeds into it.
+        */
+        int latencySamples = 0;
+
+        /** True if this node is on the longest chain of nodes that depend on one another. */
+        bool isOnCriticalPath = false;
+    };
+
+    /** Timing information about the whole graph, as returned by getRenderProfile(). */
+    struct RenderProfile
+    {
+        /** The profiles of each node in the graph, in the order that they are rendered. */
+        std::vector<NodeRenderProfile> nodes;
+
+        /** The total time taken to render every node in each block. */
+        double totalProcessingTimeMs = 0.0;
+
+        /** The time taken to render the longest chain of dependent nodes in each block.
+            No number of threads can render the graph faster than this.
+        */
+        double criticalPathMs = 0.0;
+
+        /** Returns the best speedup that parallel rendering could achieve for this graph. */
+        double getMaximumSpeedup() const noexcept
+        {
+            return criticalPathMs > 0.0 ? totalProcessingTimeMs / criticalPathMs : 1.0;
+        }
+    };
+
+    /** Returns timing information about the nodes in the graph, averaged over all the blocks
+        that have been profiled since the graph was last rebuilt.
+
+        Nodes are only timed while profiling is enabled with setRenderProfilingEnabled(), so
+        until then every time will be zero.
+
+        A node depends on another if it uses its output, or if it has to wait for it to finish
+        with a buffer that they share. This is available whether or not the graph is using worker
+        threads, but a graph without them reuses buffers between unconnected nodes, which makes
+        more nodes depend on one another. The maximum speedup reported for a graph without worker
+        threads may therefore be lower than what adding them would achieve.
+
+        Call this from the message thread.
+
+        @see setRenderProfilingEnabled, setNumWorkerThreads
+    */
+    RenderProfile getRenderProfile() const;
+
+    /** Enables or disables the timing of each node that getRenderProfile() reports.
+
+        This is disabled by default, because it reads the high-resolution clock twice for
+        every node in every block.
+
+        @see getRenderProfile
+    */
+    void setRenderProfilingEnabled (bool shouldBeEnabled) noexcept;
+
+    /** Returns true if setRenderProfilingEnabled() has been used to enable profiling. */
+    bool isRenderProfilingEnabled() const noexcept;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
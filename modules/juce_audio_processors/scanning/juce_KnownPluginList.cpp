@@ -395,6 +395,82 @@ void KnownPluginList::recreateFromXml (const XmlElement& xml)
     }
 }
 
+void KnownPluginList::writeXml (OutputStream& output, const XmlElement::TextFormat& format) const
+{
+    XmlStreamWriter writer (output, format);
+    writer.startElement ("KNOWNPLUGINS");
+
+    {
+        ScopedLock lock (typesArrayLock);
+
+        for (auto& type : types)
+            writer.writeElement (*type.createXml());
+    }
+
+    for (auto& b : blacklist)
+    {
+        writer.startElement ("BLACKLISTED");
+        writer.writeAttribute ("id", b);
+        writer.endElement();
+    }
+
+    writer.endElement();
+}
+
+bool KnownPluginList::recreateFromXml (InputStream& input)
+{
+    clear();
+    clearBlacklistedFiles();
+
+    XmlStreamReader reader (input);
+
+    if (reader.next() != XmlStreamReader::Event::startElement
+         || reader.getTagName() != StringRef ("KNOWNPLUGINS"))
+        return false;
+
+    for (;;)
+    {
+        switch (reader.next())
+        {
+            case XmlStreamReader::Event::startElement:
+            {
+                if (reader.getTagName() == StringRef ("BLACKLISTED"))
+                {
+                    blacklist.add (reader.getAttributeValue ("id"));
+
+                    if (! reader.skipElement())
+                        return false;
+
+                    break;
+                }
+
+                auto e = reader.readElement();
+
+                if (e == nullptr)
+                    return false;
+
+                PluginDescription info;
+
+                if (info.loadFromXml (*e))
+                    addType (info);
+
+                break;
+            }
+
+            case XmlStreamReader::Event::text:
+                break;
+
+            case XmlStreamReader::Event::endElement:
+                return true;
+
+            case XmlStreamReader::Event::endOfDocument:
+            case XmlStreamReader::Event::error:
+            default:
+                return false;
+        }
+    }
+}
+
 //==============================================================================
 struct PluginTreeUtils
 {
@@ -638,5 +714,107 @@ std::unique_ptr<KnownPluginList::PluginTree> KnownPluginList::createTree (const
     return createTree (getTypes(), sortMethod);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class KnownPluginListTests final : public UnitTest
+{
+public:
+    KnownPluginListTests()
+        : UnitTest ("KnownPluginList", UnitTestCategories::audioProcessors)
+    {}
+
+    static PluginDescription createDescription (int index)
+    {
+        PluginDescription d;
+        d.name = "Plugin " + String (index) + " <Reverb> & \"Delay\"";
+        d.descriptiveName = d.name + " (Stereo)";
+        d.pluginFormatName = index % 2 == 0 ? "VST3" : "AudioUnit";
+        d.category = CharPointer_UTF8 ("Effect|R\xc3\xa9verb");
+        d.manufacturerName = "Manufacturer " + String (index);
+        d.version = "1." + String (index);
+        d.fileOrIdentifier = "/Library/Audio/Plug-Ins/Plugin " + String (index) + ".vst3";
+        d.lastFileModTime = Time (1600000000000 + index);
+        d.lastInfoUpdateTime = Time (1700000000000 + index);
+        d.uniqueId = 0x1000 + index;
+        d.deprecatedUid = 0x2000 + index;
+        d.isInstrument = index % 3 == 0;
+        d.numInputChannels = index % 4;
+        d.numOutputChannels = 2;
+        d.hasSharedContainer = index == 5;
+        d.hasARAExtension = index == 7;
+        return d;
+    }
+
+    void runTest() override
+    {
+        KnownPluginList original;
+
+        for (int i = 0; i < 10; ++i)
+            original.addType (createDescription (i));
+
+        original.addToBlacklist ("/Library/Audio/Plug-Ins/Crashes.vst3");
+        original.addToBlacklist ("/Library/Audio/Plug-Ins/Hangs & Crashes.vst3");
+
+        beginTest ("writeXml writes the same XML as createXml");
+        {
+            for (auto format : { XmlElement::TextFormat(), XmlElement::TextFormat().singleLine().withoutHeader() })
+            {
+                MemoryOutputStream streamed, built;
+                original.writeXml (streamed, format);
+                original.createXml()->writeTo (built, format);
+
+                expectEquals (streamed.toString(), built.toString());
+            }
+        }
+
+        beginTest ("Round trip through a stream");
+        {
+            MemoryOutputStream mo;
+            original.writeXml (mo);
+
+            KnownPluginList restored;
+            restored.addType (createDescription (100));
+
+            MemoryInputStream mi (mo.getData(), mo.getDataSize(), false);
+            expect (restored.recreateFromXml (mi));
+
+            expectEquals (restored.getNumTypes(), original.getNumTypes());
+            expect (restored.getBlacklistedFiles() == original.getBlacklistedFiles());
+
+            // addType() puts each new type first, so the order isn't preserved
+            for (const auto& type : original.getTypes())
+            {
+                auto restoredType = restored.getTypeForIdentifierString (type.createIdentifierString());
+                expect (restoredType != nullptr && restoredType->createXml()->isEquivalentTo (type.createXml().get(), false));
+            }
+
+            KnownPluginList fromElement;
+            fromElement.recreateFromXml (*original.createXml());
+            expect (restored.createXml()->isEquivalentTo (fromElement.createXml().get(), false));
+        }
+
+        beginTest ("Incomplete or unexpected XML is rejected");
+        {
+            MemoryOutputStream mo;
+            original.writeXml (mo);
+
+            KnownPluginList restored;
+
+            MemoryInputStream truncated (mo.getData(), mo.getDataSize() / 2, false);
+            expect (! restored.recreateFromXml (truncated));
+
+            MemoryInputStream wrongTag ("<PLUGINS></PLUGINS>", 19, false);
+            expect (! restored.recreateFromXml (wrongTag));
+            expectEquals (restored.getNumTypes(), 0);
+        }
+    }
+};
+
+static KnownPluginListTests knownPluginListTests;
+
+#endif
+
 
 } // namespace juce
@@ -164,6 +164,21 @@ public:
     /** Recreates the state of this list from its stored XML format. */
     void recreateFromXml (const XmlElement& xml);
 
+    /** Writes the state of this list to a stream, in the same XML format as createXml().
+
+        The XML is written one plugin at a time, so this avoids building the XmlElement
+        tree for a large list.
+    */
+    void writeXml (OutputStream& output, const XmlElement::TextFormat& format = {}) const;
+
+    /** Recreates the state of this list from XML in a stream, in the format written by
+        writeXml() or createXml().
+
+        The stream is read one plugin at a time, so this avoids building the XmlElement
+        tree for a large list. Returns false if the XML couldn't be parsed.
+    */
+    bool recreateFromXml (InputStream& input);
+
     //==============================================================================
     /** A structure that recursively holds a tree of plugins.
         @see KnownPluginList::createTree()
@@ -55,35 +55,99 @@ bool NamedValueSet::NamedValue::operator== (const NamedValue& other) const noexc
 bool NamedValueSet::NamedValue::operator!= (const NamedValue& other) const noexcept   { return ! operator== (other); }
 
 //==============================================================================
+// Sets with more values than this keep a hash index of their names
+static constexpr int minNumValuesForHashIndex = 16;
+
 NamedValueSet::NamedValueSet() noexcept {}
 NamedValueSet::~NamedValueSet() noexcept {}
 
-NamedValueSet::NamedValueSet (const NamedValueSet& other)  : values (other.values) {}
+NamedValueSet::NamedValueSet (const NamedValueSet& other)
+   : values (other.values), hashIndex (other.hashIndex) {}
 
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-   : values (std::move (other.values)) {}
+   : values (std::move (other.values)), hashIndex (std::move (other.hashIndex)) {}
 
 NamedValueSet::NamedValueSet (std::initializer_list<NamedValue> list)
    : values (std::move (list))
 {
+    rebuildHashIndex();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
     clear();
     values = other.values;
+    hashIndex = other.hashIndex;
     return *this;
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    other.hashIndex.swap (hashIndex);
     return *this;
 }
 
 void NamedValueSet::clear()
 {
     values.clear();
+    hashIndex.clear();
+}
+
+//==============================================================================
+// The hash index is an open-addressed table of indexes into the values array, with
+// -1 marking an empty slot. Because Identifiers are pooled, a name can be matched by
+// comparing its pointer, and its hash code was already calculated when it was created.
+int NamedValueSet::findIndex (const Identifier& name) const noexcept
+{
+    if (hashIndex.empty())
+    {
+        auto numValues = values.size();
+
+        for (int i = 0; i < numValues; ++i)
+            if (values.getReference (i).name == name)
+                return i;
+
+        return -1;
+    }
+
+    const auto mask = hashIndex.size() - 1;
+
+    for (auto slot = (size_t) name.getHashCode() & mask;; slot = (slot + 1) & mask)
+    {
+        auto valueIndex = hashIndex[slot];
+
+        if (valueIndex < 0 || values.getReference (valueIndex).name == name)
+            return valueIndex;
+    }
+}
+
+void NamedValueSet::addToHashIndex (int valueIndex) noexcept
+{
+    const auto mask = hashIndex.size() - 1;
+    auto slot = (size_t) values.getReference (valueIndex).name.getHashCode() & mask;
+
+    while (hashIndex[slot] >= 0)
+        slot = (slot + 1) & mask;
+
+    hashIndex[slot] = valueIndex;
+}
+
+void NamedValueSet::rebuildHashIndex()
+{
+    auto numValues = values.size();
+
+    if (numValues <= minNumValuesForHashIndex)
+    {
+        hashIndex.clear();
+        return;
+    }
+
+    // keep the table at most half full, so that probe sequences stay short
+    hashIndex.assign ((size_t) nextPowerOfTwo (numValues * 2), -1);
+
+    for (int i = 0; i < numValues; ++i)
+        addToHashIndex (i);
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const noexcept
@@ -149,20 +213,12 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 {
-    for (auto& i : values)
-        if (i.name == name)
-            return &(i.value);
-
-    return {};
+    return getVarPointerAt (findIndex (name));
 }
 
 const var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
-    for (auto& i : values)
-        if (i.name == name)
-            return &(i.value);
-
-    return {};
+    return getVarPointerAt (findIndex (name));
 }
 
 bool NamedValueSet::set (const Identifier& name, var&& newValue)
@@ -177,6 +233,12 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
     }
 
     values.add ({ name, std::move (newValue) });
+
+    if ((size_t) values.size() * 2 > hashIndex.size())
+        rebuildHashIndex();
+    else
+        addToHashIndex (values.size() - 1);
+
     return true;
 }
 
@@ -192,6 +254,12 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
     }
 
     values.add ({ name, newValue });
+
+    if ((size_t) values.size() * 2 > hashIndex.size())
+        rebuildHashIndex();
+    else
+        addToHashIndex (values.size() - 1);
+
     return true;
 }
 
@@ -202,29 +270,20 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
-    auto numValues = values.size();
-
-    for (int i = 0; i < numValues; ++i)
-        if (values.getReference (i).name == name)
-            return i;
-
-    return -1;
+    return findIndex (name);
 }
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    auto numValues = values.size();
+    auto index = findIndex (name);
 
-    for (int i = 0; i < numValues; ++i)
-    {
-        if (values.getReference (i).name == name)
-        {
-            values.remove (i);
-            return true;
-        }
-    }
+    if (index < 0)
+        return false;
 
-    return false;
+    // removing shifts the indexes of all the later values, so the index has to be rebuilt
+    values.remove (index);
+    rebuildHashIndex();
+    return true;
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -280,6 +339,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add ({ att->name, var (att->value) });
     }
+
+    rebuildHashIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
@@ -303,4 +364,99 @@ void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class NamedValueSetTests final : public UnitTest
+{
+public:
+    NamedValueSetTests()
+        : UnitTest ("NamedValueSet", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Large sets keep their order and find every value");
+        {
+            constexpr int numValues = 200;
+
+            NamedValueSet set;
+            Array<Identifier> names;
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                names.add ("value" + String (i));
+                expect (set.set (names.getLast(), i));
+            }
+
+            expectEquals (set.size(), numValues);
+            expect (! set.set (names[10], 10));
+            expect (! set.contains ("missingValue"));
+
+            bool allFound = true;
+
+            for (int i = 0; i < numValues; ++i)
+                allFound = allFound && set.indexOf (names[i]) == i
+                                    && set.getName (i) == names[i]
+                                    && (int) set[names[i]] == i;
+
+            expect (allFound);
+        }
+
+        beginTest ("Removing values from a large set");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 100; ++i)
+                set.set ("value" + String (i), i);
+
+            for (int i = 0; i < 100; i += 2)
+                expect (set.remove ("value" + String (i)));
+
+            expect (! set.remove ("value0"));
+            expectEquals (set.size(), 50);
+
+            bool allCorrect = true;
+
+            for (int i = 0; i < 100; ++i)
+                allCorrect = allCorrect && set.contains ("value" + String (i)) == ((i & 1) != 0);
+
+            expect (allCorrect);
+            expectEquals (set.indexOf ("value1"), 0);
+            expectEquals (set.indexOf ("value99"), 49);
+        }
+
+        beginTest ("Copies and comparisons of large sets");
+        {
+            NamedValueSet a, b;
+
+            for (int i = 0; i < 50; ++i)
+            {
+                a.set ("value" + String (i), i);
+                b.set ("value" + String (49 - i), 49 - i);
+            }
+
+            expect (a == b);
+
+            NamedValueSet c (a);
+            c.set ("value25", "changed");
+            expect (a != c);
+            expectEquals (c["value25"].toString(), String ("changed"));
+            expectEquals ((int) a["value25"], 25);
+
+            c = std::move (a);
+            expect (c == b);
+
+            c.clear();
+            expect (c.isEmpty());
+            expect (! c.contains ("value0"));
+        }
+    }
+};
+
+static NamedValueSetTests namedValueSetTests;
+
+#endif
+
 } // namespace juce
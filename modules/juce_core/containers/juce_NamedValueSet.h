@@ -29,6 +29,10 @@ namespace juce
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
 
+    The values are kept in the order in which they were added. Small sets are searched
+    linearly, but once a set grows beyond a few entries it also builds a hash index of
+    its names, so that looking up a value in a large set stays fast.
+
     @tags{Core}
 */
 class JUCE_API  NamedValueSet
@@ -179,7 +183,12 @@ public:
 
 private:
     //==============================================================================
+    int findIndex (const Identifier&) const noexcept;
+    void addToHashIndex (int valueIndex) noexcept;
+    void rebuildHashIndex();
+
     Array<NamedValue> values;
+    std::vector<int> hashIndex;
 };
 
 } // namespace juce
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::detail
+{
+
+/*  Reads text from an InputStream as a sequence of UTF-8 bytes, one at a time, for
+    the streaming parsers.
+
+    The stream is read in blocks, and UTF-16 text that starts with a byte-order mark
+    is converted to UTF-8 as it's read. A UTF-8 byte-order mark is skipped. The end
+    of the stream is returned as -1.
+
+    The line and column of the most recently read character are kept, so that parse
+    errors can be reported.
+*/
+class UTF8StreamDecoder
+{
+public:
+    explicit UTF8StreamDecoder (InputStream& in)  : input (in)
+    {
+        detectEncoding();
+    }
+
+    int peekByte()
+    {
+        if (! hasLookahead)
+        {
+            lookahead = readDecodedByte();
+            hasLookahead = true;
+        }
+
+        return lookahead;
+    }
+
+    int readByte()
+    {
+        auto c = peekByte();
+        hasLookahead = false;
+
+        lastLine = line;
+        lastColumn = column;
+
+        if (c == '\n')
+        {
+            ++line;
+            column = 1;
+        }
+        else if ((c & 0xc0) != 0x80)
+        {
+            ++column;
+        }
+
+        return c;
+    }
+
+    bool matchIf (char c)
+    {
+        if (peekByte() != c)
+            return false;
+
+        readByte();
+        return true;
+    }
+
+    int getLine() const noexcept        { return lastLine; }
+    int getColumn() const noexcept      { return lastColumn; }
+
+private:
+    enum class Encoding { utf8, utf16LittleEndian, utf16BigEndian };
+
+    int readRawByte()
+    {
+        if (bufferPos == bufferEnd)
+        {
+            bufferPos = 0;
+            bufferEnd = jmax (0, input.read (buffer, bufferSize));
+
+            if (bufferEnd == 0)
+                return -1;
+        }
+
+        return buffer[bufferPos++];
+    }
+
+    void detectEncoding()
+    {
+        while (bufferEnd < 3)
+        {
+            auto numRead = input.read (buffer + bufferEnd, 3 - bufferEnd);
+
+            if (numRead <= 0)
+                break;
+
+            bufferEnd += numRead;
+        }
+
+        if (bufferEnd >= 2 && CharPointer_UTF16::isByteOrderMarkLittleEndian (buffer))
+        {
+            encoding = Encoding::utf16LittleEndian;
+            bufferPos = 2;
+        }
+        else if (bufferEnd >= 2 && CharPointer_UTF16::isByteOrderMarkBigEndian (buffer))
+        {
+            encoding = Encoding::utf16BigEndian;
+            bufferPos = 2;
+        }
+        else if (bufferEnd >= 3 && CharPointer_UTF8::isByteOrderMark (buffer))
+        {
+            bufferPos = 3;
+        }
+    }
+
+    int readUTF16Unit()
+    {
+        auto b1 = readRawByte();
+        auto b2 = readRawByte();
+
+        if (b1 < 0 || b2 < 0)
+            return -1;
+
+        return encoding == Encoding::utf16LittleEndian ? (b2 << 8) | b1
+                                                       : (b1 << 8) | b2;
+    }
+
+    int readDecodedByte()
+    {
+        if (encoding == Encoding::utf8)
+            return readRawByte();
+
+        if (pendingPos < numPending)
+            return pendingBytes[pendingPos++];
+
+        auto unit = pendingUnit >= 0 ? std::exchange (pendingUnit, -1) : readUTF16Unit();
+
+        if (unit < 0)
+            return -1;
+
+        auto c = (juce_wchar) unit;
+
+        if (unit >= 0xd800 && unit <= 0xdbff)
+        {
+            auto next = readUTF16Unit();
+
+            if (next >= 0xdc00 && next <= 0xdfff)
+                c = (juce_wchar) (0x10000 + ((unit - 0xd800) << 10) + (next - 0xdc00));
+            else
+                pendingUnit = next;
+        }
+
+        auto* dest = reinterpret_cast<CharPointer_UTF8::CharType*> (pendingBytes);
+        CharPointer_UTF8 writer (dest);
+        writer.write (c);
+        numPending = (int) (writer.getAddress() - dest);
+        pendingPos = 1;
+        return pendingBytes[0];
+    }
+
+    static constexpr int bufferSize = 8192;
+
+    InputStream& input;
+    HeapBlock<uint8> buffer { bufferSize };
+    int bufferPos = 0, bufferEnd = 0;
+
+    Encoding encoding = Encoding::utf8;
+    uint8 pendingBytes[8];
+    int pendingPos = 0, numPending = 0, pendingUnit = -1;
+
+    int lookahead = -1;
+    bool hasLookahead = false;
+    int line = 1, column = 1, lastLine = 1, lastColumn = 1;
+
+    JUCE_DECLARE_NON_COPYABLE (UTF8StreamDecoder)
+};
+
+} // namespace juce::detail
@@ -311,52 +311,51 @@ struct JSONFormatter
         out << "\\u" << String::toHexString ((int) value).paddedLeft ('0', 4);
     }
 
-    static void writeString (OutputStream& out, String::CharPointerType t)
+    static void writeChar (OutputStream& out, juce_wchar c)
     {
-        for (;;)
+        switch (c)
         {
-            auto c = t.getAndAdvance();
+            case '\"':  out << "\\\""; break;
+            case '\\':  out << "\\\\"; break;
+            case '\a':  out << "\\a";  break;
+            case '\b':  out << "\\b";  break;
+            case '\f':  out << "\\f";  break;
+            case '\t':  out << "\\t";  break;
+            case '\r':  out << "\\r";  break;
+            case '\n':  out << "\\n";  break;
 
-            switch (c)
-            {
-                case 0:  return;
-
-                case '\"':  out << "\\\""; break;
-                case '\\':  out << "\\\\"; break;
-                case '\a':  out << "\\a";  break;
-                case '\b':  out << "\\b";  break;
-                case '\f':  out << "\\f";  break;
-                case '\t':  out << "\\t";  break;
-                case '\r':  out << "\\r";  break;
-                case '\n':  out << "\\n";  break;
-
-                default:
-                    if (c >= 32 && c < 127)
+            default:
+                if (c >= 32 && c < 127)
+                {
+                    out << (char) c;
+                }
+                else
+                {
+                    if (CharPointer_UTF16::getBytesRequiredFor (c) > 2)
                     {
-                        out << (char) c;
+                        CharPointer_UTF16::CharType chars[2];
+                        CharPointer_UTF16 utf16 (chars);
+                        utf16.write (c);
+
+                        for (int i = 0; i < 2; ++i)
+                            writeEscapedChar (out, (unsigned short) chars[i]);
                     }
                     else
                     {
-                        if (CharPointer_UTF16::getBytesRequiredFor (c) > 2)
-                        {
-                            CharPointer_UTF16::CharType chars[2];
-                            CharPointer_UTF16 utf16 (chars);
-                            utf16.write (c);
-
-                            for (int i = 0; i < 2; ++i)
-                                writeEscapedChar (out, (unsigned short) chars[i]);
-                        }
-                        else
-                        {
-                            writeEscapedChar (out, (unsigned short) c);
-                        }
+                        writeEscapedChar (out, (unsigned short) c);
                     }
+                }
 
-                    break;
-            }
+                break;
         }
     }
 
+    static void writeString (OutputStream& out, String::CharPointerType t)
+    {
+        for (auto c = t.getAndAdvance(); c != 0; c = t.getAndAdvance())
+            writeChar (out, c);
+    }
+
     static void writeSpaces (OutputStream& out, int numSpaces)
     {
         out.writeRepeatedByte (' ', (size_t) numSpaces);
@@ -488,12 +487,74 @@ var JSON::fromString (StringRef text)
 
 var JSON::parse (InputStream& input)
 {
-    return parse (input.readEntireStreamAsString());
+    // Builds the var tree directly from the stream, so the text never has to be held in memory
+    struct Builder final : public JSONStreamReader::Handler
+    {
+        void onBeginObject() override       { beginContainer (new DynamicObject()); }
+        void onBeginArray() override        { beginContainer (Array<var>()); }
+        void onEndObject() override         { openContainers.removeLast(); }
+        void onEndArray() override          { openContainers.removeLast(); }
+
+        void onKey (StringRef name) override
+        {
+            propertyName = Identifier (name.text, name.text.findTerminatingNull());
+        }
+
+        void onString (StringRef value) override    { addValue (String (value.text)); }
+        void onNumber (double value) override       { addValue (value); }
+        void onBool (bool value) override           { addValue (value); }
+        void onNull() override                      { addValue ({}); }
+
+        void onNumber (int64 value) override
+        {
+            if (value > -0x80000000LL && value < 0x80000000LL)
+                addValue ((int) value);
+            else
+                addValue (value);
+        }
+
+        void beginContainer (var container)
+        {
+            if (openContainers.isEmpty())
+                isObjectOrArray = true;
+
+            addValue (container);
+            openContainers.add (std::move (container));
+        }
+
+        void addValue (var value)
+        {
+            if (openContainers.isEmpty())
+                result = std::move (value);
+            else if (auto* array = openContainers.getReference (openContainers.size() - 1).getArray())
+                array->add (std::move (value));
+            else if (auto* object = openContainers.getReference (openContainers.size() - 1).getDynamicObject())
+                object->setProperty (propertyName, std::move (value));
+        }
+
+        var result;
+        Array<var> openContainers;
+        Identifier propertyName;
+        bool isObjectOrArray = false;
+    };
+
+    Builder builder;
+
+    // Like parse (const String&), this only accepts an object or an array
+    if (JSONStreamReader::parse (input, builder).failed() || ! builder.isObjectOrArray)
+        return {};
+
+    return builder.result;
 }
 
 var JSON::parse (const File& file)
 {
-    return parse (file.loadFileAsString());
+    FileInputStream in (file);
+
+    if (! in.openedOk())
+        return {};
+
+    return parse (in);
 }
 
 Result JSON::parse (const String& text, var& result)
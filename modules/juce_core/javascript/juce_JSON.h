@@ -69,8 +69,9 @@ public:
     /** Attempts to parse some JSON-formatted text from a file, and returns the result
         as a var object.
 
-        Note that this is just a short-cut for reading the entire file into a string and
-        parsing the result.
+        The file is read a piece at a time, so its text never has to be held in memory
+        all at once. Like the other parse() methods, this only accepts an object or an
+        array definition.
 
         If the parsing fails, this simply returns var() - if you need to find out more
         detail about the parse error, use the alternative parse() method which returns a Result.
@@ -80,8 +81,10 @@ public:
     /** Attempts to parse some JSON-formatted text from a stream, and returns the result
         as a var object.
 
-        Note that this is just a short-cut for reading the entire stream into a string and
-        parsing the result.
+        The stream is read a piece at a time, so its text never has to be held in memory
+        all at once. Like the other parse() methods, this only accepts an object or an
+        array definition. If you don't need the whole var tree either, use a
+        JSONStreamReader instead.
 
         If the parsing fails, this simply returns var() - if you need to find out more
         detail about the parse error, use the alternative parse() method which returns a Result.
@@ -240,6 +240,215 @@ private:
     };
 };
 
+//==============================================================================
+/**
+    Allows writing an object of arbitrary type directly to a JSONStreamWriter.
+
+    This produces the same JSON as converting the object with ToVar and then writing the
+    resulting var with JSON::writeToStream(), but the intermediate var is never built, so
+    it's a better choice for large objects.
+
+    The type must be set up for serialisation in the same way as for ToVar. For details,
+    see the docs for SerialisationTraits.
+
+    @see ToVar, JSONStreamWriter
+
+    @tags{Core}
+*/
+class ToJSON
+{
+public:
+    using Options = ToVarOptions;
+
+    /** Attempts to write the argument to the writer, using the serialisation utilities
+        specified for that type.
+
+        Returns true if the conversion succeeds. If it fails, this returns false, and some
+        of the object may already have been written, so the output should be discarded.
+    */
+    template <typename T>
+    static bool write (JSONStreamWriter& writer, const T& t, const Options& options = {})
+    {
+        return Visitor::write (writer, t, options);
+    }
+
+    /** Writes the argument to a stream as JSON, using the given formatting.
+
+        Returns true if the conversion succeeds. If it fails, this returns false, and some
+        of the object may already have been written, so the output should be discarded.
+    */
+    template <typename T>
+    static bool write (OutputStream& stream,
+                       const T& t,
+                       const JSON::FormatOptions& format = {},
+                       const Options& options = {})
+    {
+        JSONStreamWriter writer (stream, format);
+        return write (writer, t, options) && writer.getDepth() == 0;
+    }
+
+private:
+    class Visitor
+    {
+    public:
+        template <typename T>
+        static bool write (JSONStreamWriter& writer, const T& t, const Options& options)
+        {
+            constexpr auto fallbackVersion = detail::ForwardingSerialisationTraits<T>::marshallingVersion;
+            const auto versionToUse = options.getExplicitVersion()
+                                             .value_or (fallbackVersion);
+
+            if (versionToUse > fallbackVersion)
+            {
+                // The requested explicit version is higher than the declared version of the type.
+                return false;
+            }
+
+            Visitor visitor { writer, versionToUse, options.getVersionIncluded() };
+            detail::doSave (visitor, t);
+            return visitor.finish();
+        }
+
+        std::optional<int> getVersion() const { return version; }
+
+        template <typename... Ts>
+        void operator() (Ts&&... ts)
+        {
+            (visit (std::forward<Ts> (ts)), ...);
+        }
+
+    private:
+        // Mirrors the shapes that ToVar builds: a single value, an array, or an object
+        enum class State { empty, value, array, object, failed };
+
+        Visitor (JSONStreamWriter& w, const std::optional<int>& explicitVersion, bool includeVersion)
+            : writer (w), version (explicitVersion), versionIncluded (includeVersion)
+        {
+            if (version.has_value() && includeVersion)
+            {
+                writer.beginObject();
+                writer.writeKey ("__version__");
+                writer.writeInt64 (*version);
+                state = State::object;
+            }
+        }
+
+        bool finish()
+        {
+            switch (state)
+            {
+                case State::empty:   writer.writeNull(); return true;
+                case State::array:   writer.endArray();  return true;
+                case State::object:  writer.endObject(); return true;
+                case State::value:   return true;
+                case State::failed:  return false;
+            }
+
+            return false;
+        }
+
+        template <typename T>
+        void visit (const T& t)
+        {
+            if (! canPush())
+                return;
+
+            if constexpr (std::is_integral_v<T>)
+                writer.writeInt64 ((int64) t);
+            else if constexpr (std::is_floating_point_v<T>)
+                writer.writeDouble ((double) t);
+            else if (! write (writer, t, Options{}.withVersionIncluded (versionIncluded)))
+                state = State::failed;
+        }
+
+        template <typename T>
+        void visit (const Named<T>& named)
+        {
+            if (state == State::failed)
+                return;
+
+            if (state == State::empty)
+            {
+                writer.beginObject();
+                state = State::object;
+            }
+
+            if (state != State::object)
+            {
+                // Serialisation failure! This may be caused by archiving a primitive or
+                // SerialisationSize, and then attempting to archive a named pair to the same
+                // archive instance.
+                // When using named pairs, *all* items serialised with a particular archiver must be
+                // named pairs.
+                jassertfalse;
+
+                state = State::failed;
+                return;
+            }
+
+            writer.writeKey (CharPointer_UTF8 (named.name.data()),
+                             CharPointer_UTF8 (named.name.data() + named.name.size()));
+
+            if (! write (writer, named.value, Options{}.withVersionIncluded (versionIncluded)))
+                state = State::failed;
+        }
+
+        template <typename T>
+        void visit (const SerialisationSize<T>&)
+        {
+            if (state == State::empty)
+            {
+                writer.beginArray();
+                state = State::array;
+            }
+            else if (canPush())
+            {
+                writer.beginArray();
+                writer.endArray();
+            }
+        }
+
+        void visit (const bool& t)
+        {
+            if (canPush())
+                writer.writeBool (t);
+        }
+
+        void visit (const String& t)
+        {
+            if (canPush())
+                writer.writeString (t);
+        }
+
+        void visit (const var& t)
+        {
+            if (canPush())
+                writer.writeVar (t);
+        }
+
+        // Returns true if another value can be written at this point
+        bool canPush()
+        {
+            if (state == State::empty)
+            {
+                state = State::value;
+                return true;
+            }
+
+            if (state == State::array)
+                return true;
+
+            state = State::failed;
+            return false;
+        }
+
+        JSONStreamWriter& writer;
+        std::optional<int> version;
+        bool versionIncluded = true;
+        State state = State::empty;
+    };
+};
+
 //==============================================================================
 /**
     Allows converting a var to an object of arbitrary type.
@@ -497,6 +497,34 @@ public:
                              JSONUtils::makeObject ({ { "eventId", 404 }, { "payload", payload } }));
         }
 
+        beginTest ("ToJSON");
+        {
+            expectSameAsToVar (false);
+            expectSameAsToVar (1);
+            expectSameAsToVar (5.0f);
+            expectSameAsToVar (6LL);
+            expectSameAsToVar (String ("hello world"));
+            expectSameAsToVar (std::vector<int> { 1, 2, 3 });
+            expectSameAsToVar (std::vector<int>{});
+            expectSameAsToVar (TypeWithExternalUnifiedSerialisation { 7, "hello world", { 5, 6, 7 }, { { "foo", 4 }, { "bar", 5 } } });
+            expectSameAsToVar (TypeWithInternalUnifiedSerialisation { 7.89, 4.321f, "custom string", { "foo", "bar", "baz" } });
+            expectSameAsToVar (TypeWithExternalSplitSerialisation { "string", { 1, 2, 3 } });
+            expectSameAsToVar (TypeWithInternalSplitSerialisation { "string", { 16, 32, 48 } });
+            expectSameAsToVar (TypeWithVersionedSerialisation { 1, 2, 3, 4 });
+            expectSameAsToVar (TypeWithVersionedSerialisation { 1, 2, 3, 4 }, ToVar::Options{}.withVersionIncluded (false));
+            expectSameAsToVar (TypeWithVersionedSerialisation { 1, 2, 3, 4 }, ToVar::Options{}.withExplicitVersion (1));
+            expectSameAsToVar (TypeWithVersionedSerialisation { 1, 2, 3, 4 }, ToVar::Options{}.withExplicitVersion (std::nullopt));
+            expectSameAsToVar (TypeWithRawVarLast { 200, "success", JSONUtils::makeObject ({ { "status", 123.456 }, { "extended", true } }) });
+            expectSameAsToVar (TypeWithInnerVar { 404, JSONUtils::makeObject ({ { "foo", 1 }, { "bar", 2 } }) });
+
+            MemoryOutputStream stream;
+            expect (! ToJSON::write (stream, TypeWithBrokenObjectSerialisation { 1, 2 }));
+            expect (! ToJSON::write (stream, TypeWithBrokenPrimitiveSerialisation { 1, 2 }));
+            expect (! ToJSON::write (stream, TypeWithBrokenArraySerialisation {}));
+            expect (! ToJSON::write (stream, TypeWithBrokenNestedSerialisation {}));
+            expect (! ToJSON::write (stream, TypeWithVersionedSerialisation { 1, 2, 3, 4 }, {}, ToVar::Options{}.withExplicitVersion (4)));
+        }
+
         beginTest ("FromVar");
         {
             expect (FromVar::convert<bool> (JSON::fromString ("false")) == false);
@@ -603,6 +631,22 @@ private:
         expect (deepEqual (a, b), text);
     }
 
+    template <typename T>
+    void expectSameAsToVar (const T& t, const ToVar::Options& options = {})
+    {
+        const auto converted = ToVar::convert (t, options);
+        expect (converted.has_value());
+
+        for (auto spacing : { JSON::Spacing::none, JSON::Spacing::singleLine, JSON::Spacing::multiLine })
+        {
+            const auto format = JSON::FormatOptions{}.withSpacing (spacing);
+
+            MemoryOutputStream stream;
+            expect (ToJSON::write (stream, t, format, options));
+            expectEquals (stream.toString(), JSON::toString (converted.value_or (var()), format));
+        }
+    }
+
     static bool deepEqual (const std::optional<var>& a, const std::optional<var>& b)
     {
         if (a.has_value() && b.has_value())
@@ -0,0 +1,767 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+struct JSONStreamParser
+{
+    JSONStreamParser (InputStream& in, JSONStreamReader::Handler& h)  : input (in), handler (h) {}
+
+    using ErrorException = JSONParser::ErrorException;
+
+    [[noreturn]] void throwError (String message) const
+    {
+        ErrorException e;
+        e.message = std::move (message);
+        e.line = input.getLine();
+        e.column = input.getColumn();
+        throw e;
+    }
+
+    int peekByte()          { return input.peekByte(); }
+    int readByte()          { return input.readByte(); }
+    bool matchIf (char c)   { return input.matchIf (c); }
+
+    static bool isWhitespace (int c) noexcept    { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+    static bool isDigit (int c) noexcept         { return c >= '0' && c <= '9'; }
+
+    void skipWhitespace()
+    {
+        while (isWhitespace (peekByte()))
+            readByte();
+    }
+
+    void expectLiteral (const char* rest)
+    {
+        while (*rest != 0)
+            if (readByte() != *rest++)
+                throwError ("Syntax error");
+    }
+
+    //==============================================================================
+    template <typename Callback>
+    void sendString (Callback&& callback)
+    {
+        text.writeByte (0);
+        CharPointer_UTF8 utf8 (static_cast<const CharPointer_UTF8::CharType*> (text.getData()));
+
+       #if JUCE_STRING_UTF_TYPE == 8
+        callback (StringRef (utf8));
+       #else
+        const String copy (utf8);
+        callback (StringRef (copy));
+       #endif
+    }
+
+    int readHexDigits()
+    {
+        int result = 0;
+
+        for (int i = 4; --i >= 0;)
+        {
+            auto digitValue = CharacterFunctions::getHexDigitValue ((juce_wchar) readByte());
+
+            if (digitValue < 0)
+                throwError ("Syntax error in unicode escape sequence");
+
+            result = (result << 4) + digitValue;
+        }
+
+        return result;
+    }
+
+    void readString (int quoteChar)
+    {
+        text.reset();
+
+        for (;;)
+        {
+            auto c = readByte();
+
+            if (c == quoteChar)
+                return;
+
+            if (c <= 0)
+                throwError ("Unexpected EOF in string constant");
+
+            if (c != '\\')
+            {
+                text.writeByte ((char) c);
+                continue;
+            }
+
+            auto escaped = (juce_wchar) readByte();
+
+            switch (escaped)
+            {
+                case '"':
+                case '\'':
+                case '\\':
+                case '/':  break;
+
+                case 'a':  escaped = '\a'; break;
+                case 'b':  escaped = '\b'; break;
+                case 'f':  escaped = '\f'; break;
+                case 'n':  escaped = '\n'; break;
+                case 'r':  escaped = '\r'; break;
+                case 't':  escaped = '\t'; break;
+
+                case 'u':
+                {
+                    escaped = (juce_wchar) readHexDigits();
+
+                    // Characters outside the BMP are written as a pair of escaped UTF-16 surrogates
+                    if (escaped >= 0xd800 && escaped <= 0xdbff && matchIf ('\\'))
+                    {
+                        if (readByte() != 'u')
+                            throwError ("Syntax error in unicode escape sequence");
+
+                        auto low = (juce_wchar) readHexDigits();
+
+                        if (low >= 0xdc00 && low <= 0xdfff)
+                        {
+                            escaped = 0x10000 + ((escaped - 0xd800) << 10) + (low - 0xdc00);
+                        }
+                        else
+                        {
+                            text.appendUTF8Char (escaped);
+                            escaped = low;
+                        }
+                    }
+
+                    break;
+                }
+
+                default:  break;
+            }
+
+            if (escaped == 0)
+                throwError ("Unexpected EOF in string constant");
+
+            text.appendUTF8Char (escaped);
+        }
+    }
+
+    void readNumber (bool isNegative)
+    {
+        text.reset();
+        bool isFloatingPoint = false;
+
+        for (;;)
+        {
+            auto c = peekByte();
+
+            if (isDigit (c))
+            {
+                text.writeByte ((char) readByte());
+            }
+            else if (c == '.' || c == 'e' || c == 'E' || ((c == '+' || c == '-') && isFloatingPoint))
+            {
+                isFloatingPoint = true;
+                text.writeByte ((char) readByte());
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        auto next = peekByte();
+
+        if (! (isWhitespace (next) || next == ',' || next == '}' || next == ']' || next < 0))
+        {
+            readByte();
+            throwError ("Syntax error in number");
+        }
+
+        if (isFloatingPoint)
+        {
+            text.writeByte (0);
+            CharPointer_ASCII start (static_cast<const char*> (text.getData()));
+            auto value = CharacterFunctions::readDoubleValue (start);
+            handler.onNumber (isNegative ? -value : value);
+            return;
+        }
+
+        auto* digits = static_cast<const char*> (text.getData());
+        auto numDigits = text.getDataSize();
+        uint64 value = 0;
+
+        for (size_t i = 0; i < numDigits; ++i)
+            value = value * 10 + (uint64) (digits[i] - '0');
+
+        handler.onNumber (isNegative ? -(int64) value : (int64) value);
+    }
+
+    //==============================================================================
+    // Reads one primitive value, or the opening bracket of an object or array
+    void readValue()
+    {
+        skipWhitespace();
+
+        if (isDigit (peekByte()))
+        {
+            readNumber (false);
+            return;
+        }
+
+        auto c = readByte();
+
+        switch (c)
+        {
+            case '{':
+                handler.onBeginObject();
+                openContainers.push_back (true);
+                expectingKey = true;
+                return;
+
+            case '[':
+                handler.onBeginArray();
+                openContainers.push_back (false);
+                return;
+
+            case '"':
+            case '\'':
+                readString (c);
+                sendString ([this] (StringRef s) { handler.onString (s); });
+                return;
+
+            case '-':
+                skipWhitespace();
+
+                if (! isDigit (peekByte()))
+                {
+                    readByte();
+                    throwError ("Syntax error");
+                }
+
+                readNumber (true);
+                return;
+
+            case 't':   expectLiteral ("rue");   handler.onBool (true);   return;
+            case 'f':   expectLiteral ("alse");  handler.onBool (false);  return;
+            case 'n':   expectLiteral ("ull");   handler.onNull();        return;
+
+            case -1:    throwError ("Unexpected EOF");
+
+            default:    throwError ("Syntax error");
+        }
+    }
+
+    void readKey()
+    {
+        skipWhitespace();
+        auto c = readByte();
+
+        if (c != '"')
+            throwError ("Expected a property name in double-quotes");
+
+        readString ('"');
+
+        if (text.getDataSize() == 0)
+            throwError ("Invalid property name");
+
+        sendString ([this] (StringRef s) { handler.onKey (s); });
+
+        skipWhitespace();
+
+        if (readByte() != ':')
+            throwError ("Expected ':'");
+
+        expectingKey = false;
+    }
+
+    // Returns true if the container was closed by the bracket at the current position
+    bool closeIfEnded()
+    {
+        skipWhitespace();
+        const auto isObject = openContainers.back();
+
+        if (! matchIf (isObject ? '}' : ']'))
+        {
+            if (peekByte() < 0)
+            {
+                readByte();
+                throwError (isObject ? "Unexpected EOF in object declaration"
+                                     : "Unexpected EOF in array declaration");
+            }
+
+            return false;
+        }
+
+        closeContainer();
+        return true;
+    }
+
+    void closeContainer()
+    {
+        const auto isObject = openContainers.back();
+        openContainers.pop_back();
+
+        if (isObject)
+            handler.onEndObject();
+        else
+            handler.onEndArray();
+    }
+
+    // Reads the ',' or closing brackets that follow a value inside a container
+    void readAfterValue()
+    {
+        while (! openContainers.empty())
+        {
+            skipWhitespace();
+            const auto isObject = openContainers.back();
+            auto c = readByte();
+
+            if (c == ',')
+            {
+                expectingKey = isObject;
+                return;
+            }
+
+            if (c < 0)
+                throwError (isObject ? "Unexpected EOF in object declaration"
+                                     : "Unexpected EOF in array declaration");
+
+            if (c != (isObject ? '}' : ']'))
+                throwError (isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+
+            closeContainer();
+        }
+    }
+
+    void parse()
+    {
+        readValue();
+
+        while (! openContainers.empty())
+        {
+            // an empty container, or a trailing comma before the closing bracket
+            if (closeIfEnded())
+            {
+                readAfterValue();
+                continue;
+            }
+
+            if (expectingKey)
+                readKey();
+
+            const auto depth = openContainers.size();
+            readValue();
+
+            if (openContainers.size() == depth)
+                readAfterValue();
+        }
+    }
+
+    //==============================================================================
+    detail::UTF8StreamDecoder input;
+    JSONStreamReader::Handler& handler;
+
+    MemoryOutputStream text { 256 };
+    std::vector<bool> openContainers;
+    bool expectingKey = false;
+};
+
+Result JSONStreamReader::parse (InputStream& input, Handler& handler)
+{
+    try
+    {
+        JSONStreamParser (input, handler).parse();
+    }
+    catch (const JSONStreamParser::ErrorException& error)
+    {
+        return error.getResult();
+    }
+
+    return Result::ok();
+}
+
+//==============================================================================
+JSONStreamWriter::JSONStreamWriter (OutputStream& output, const JSON::FormatOptions& formatOptions)
+    : out (output), format (formatOptions)
+{
+}
+
+int JSONStreamWriter::getIndentLevel() const noexcept
+{
+    return format.getIndentLevel() + levels.size() * JSONFormatter::indentSize;
+}
+
+void JSONStreamWriter::writeSeparator()
+{
+    auto& level = levels.getReference (levels.size() - 1);
+
+    if (! level.isEmpty)
+    {
+        out << ',';
+
+        if (format.getSpacing() == JSON::Spacing::singleLine)
+            out << ' ';
+    }
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        // an object's first newline is written by beginObject()
+        if (! (level.isEmpty && level.isObject))
+            out << newLine;
+
+        JSONFormatter::writeSpaces (out, getIndentLevel());
+    }
+
+    level.isEmpty = false;
+}
+
+void JSONStreamWriter::startValue()
+{
+    if (levels.isEmpty())
+        return;
+
+    if (levels.getReference (levels.size() - 1).isObject)
+    {
+        // Inside an object, each value must follow a call to writeKey()!
+        jassert (expectingValueForKey);
+        expectingValueForKey = false;
+        return;
+    }
+
+    writeSeparator();
+}
+
+void JSONStreamWriter::startKey()
+{
+    // Keys can only be written inside an object, and each key must be followed by a value!
+    jassert (! levels.isEmpty() && levels.getReference (levels.size() - 1).isObject);
+    jassert (! expectingValueForKey);
+
+    writeSeparator();
+    expectingValueForKey = true;
+    out << '"';
+}
+
+void JSONStreamWriter::writeKey (StringRef name)
+{
+    startKey();
+    JSONFormatter::writeString (out, name.text);
+    out << (format.getSpacing() != JSON::Spacing::none ? "\": " : "\":");
+}
+
+void JSONStreamWriter::writeKey (CharPointer_UTF8 nameStart, CharPointer_UTF8 nameEnd)
+{
+    startKey();
+
+    while (nameStart < nameEnd)
+        JSONFormatter::writeChar (out, nameStart.getAndAdvance());
+
+    out << (format.getSpacing() != JSON::Spacing::none ? "\": " : "\":");
+}
+
+void JSONStreamWriter::beginObject()
+{
+    startValue();
+    out << '{';
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+        out << newLine;
+
+    levels.add ({ true, true });
+}
+
+void JSONStreamWriter::endObject()
+{
+    // There's no object to close here, or the last key had no value!
+    jassert (! levels.isEmpty() && levels.getReference (levels.size() - 1).isObject);
+    jassert (! expectingValueForKey);
+
+    const auto wasEmpty = levels.removeAndReturn (levels.size() - 1).isEmpty;
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        if (! wasEmpty)
+            out << newLine;
+
+        JSONFormatter::writeSpaces (out, getIndentLevel());
+    }
+
+    out << '}';
+}
+
+void JSONStreamWriter::beginArray()
+{
+    startValue();
+    out << '[';
+    levels.add ({ false, true });
+}
+
+void JSONStreamWriter::endArray()
+{
+    // There's no array to close here!
+    jassert (! levels.isEmpty() && ! levels.getReference (levels.size() - 1).isObject);
+
+    const auto wasEmpty = levels.removeAndReturn (levels.size() - 1).isEmpty;
+
+    if (! wasEmpty && format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        out << newLine;
+        JSONFormatter::writeSpaces (out, getIndentLevel());
+    }
+
+    out << ']';
+}
+
+void JSONStreamWriter::writeString (StringRef value)
+{
+    startValue();
+    out << '"';
+    JSONFormatter::writeString (out, value.text);
+    out << '"';
+}
+
+void JSONStreamWriter::writeInt64 (int64 value)
+{
+    startValue();
+    out << value;
+}
+
+void JSONStreamWriter::writeDouble (double value)
+{
+    startValue();
+
+    if (juce_isfinite (value))
+        out << serialiseDouble (value);
+    else
+        out << "null";
+}
+
+void JSONStreamWriter::writeBool (bool value)
+{
+    startValue();
+    out << (value ? "true" : "false");
+}
+
+void JSONStreamWriter::writeNull()
+{
+    startValue();
+    out << "null";
+}
+
+void JSONStreamWriter::writeVar (const var& value)
+{
+    startValue();
+    JSON::writeToStream (out, value, format.withIndentLevel (getIndentLevel()));
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONStreamTests final : public UnitTest
+{
+public:
+    JSONStreamTests()
+        : UnitTest ("JSONStream", UnitTestCategories::json)
+    {}
+
+    struct EventLogger final : public JSONStreamReader::Handler
+    {
+        void onBeginObject() override           { log << "{ "; }
+        void onEndObject() override             { log << "} "; }
+        void onBeginArray() override            { log << "[ "; }
+        void onEndArray() override              { log << "] "; }
+        void onKey (StringRef name) override    { log << "key:" << name << " "; }
+        void onString (StringRef s) override    { log << "string:" << s << " "; }
+        void onNumber (int64 n) override        { log << "int:" << n << " "; }
+        void onNumber (double n) override       { log << "double:" << n << " "; }
+        void onBool (bool b) override           { log << "bool:" << (b ? "true" : "false") << " "; }
+        void onNull() override                  { log << "null "; }
+
+        String log;
+    };
+
+    static Result parseText (const String& text, EventLogger& logger)
+    {
+        MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+        return JSONStreamReader::parse (stream, logger);
+    }
+
+    static String getEvents (const String& text)
+    {
+        EventLogger logger;
+        const auto result = parseText (text, logger);
+        return result.wasOk() ? logger.log.trimEnd() : result.getErrorMessage();
+    }
+
+    static var parseFromStream (const String& text)
+    {
+        MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+        return JSON::parse (stream);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Reader events");
+        {
+            expectEquals (getEvents (R"({"a": [1, -2.5, "x"], "b": {"c": true, "d": null}, "e": []})"),
+                          String ("{ key:a [ int:1 double:-2.5 string:x ] key:b { key:c bool:true key:d null } key:e [ ] }"));
+            expectEquals (getEvents ("  12345678901234 "), String ("int:12345678901234"));
+            expectEquals (getEvents ("- 3"), String ("int:-3"));
+            expectEquals (getEvents ("1.5e3"), String ("double:1500"));
+            expectEquals (getEvents ("'single'"), String ("string:single"));
+            expectEquals (getEvents (R"([1, 2,])"), String ("[ int:1 int:2 ]"));
+            expectEquals (getEvents (R"([[[]], {}] trailing text)"), String ("[ [ [ ] ] { } ]"));
+            expectEquals (getEvents (R"("\u00e9\ud83d\ude00\tx")"), "string:" + String (CharPointer_UTF8 ("\xc3\xa9\xf0\x9f\x98\x80\tx")));
+        }
+
+        beginTest ("Reader errors");
+        {
+            expectEquals (getEvents (""), String ("1:1: error: Unexpected EOF"));
+            expectEquals (getEvents ("[1, 2"), String ("1:6: error: Unexpected EOF in array declaration"));
+            expectEquals (getEvents ("{\n  \"a\" 1}"), String ("2:7: error: Expected ':'"));
+            expectEquals (getEvents ("{1: 2}"), String ("1:2: error: Expected a property name in double-quotes"));
+            expectEquals (getEvents ("[1 2]"), String ("1:4: error: Expected ',' or ']'"));
+            expectEquals (getEvents ("[12a]"), String ("1:4: error: Syntax error in number"));
+            expectEquals (getEvents ("[tru]"), String ("1:5: error: Syntax error"));
+            expectEquals (getEvents ("{\"\": 1}"), String ("1:3: error: Invalid property name"));
+        }
+
+        beginTest ("UTF-16 input");
+        {
+            const String text (CharPointer_UTF8 ("{\"n\xc3\xa4me\": \"\xf0\x9f\x98\x80\"}"));
+
+            for (auto bigEndian : { false, true })
+            {
+                MemoryOutputStream utf16;
+                utf16.writeByte ((char) (bigEndian ? 0xfe : 0xff));
+                utf16.writeByte ((char) (bigEndian ? 0xff : 0xfe));
+
+                for (auto* c = text.toUTF16().getAddress(); *c != 0; ++c)
+                {
+                    if (bigEndian)
+                        utf16.writeShortBigEndian ((short) *c);
+                    else
+                        utf16.writeShort ((short) *c);
+                }
+
+                MemoryInputStream stream (utf16.getData(), utf16.getDataSize(), false);
+                EventLogger logger;
+                expect (JSONStreamReader::parse (stream, logger).wasOk());
+                expectEquals (logger.log.trimEnd(), "{ key:" + String (CharPointer_UTF8 ("n\xc3\xa4me"))
+                                                      + " string:" + String (CharPointer_UTF8 ("\xf0\x9f\x98\x80")) + " }");
+            }
+        }
+
+        beginTest ("JSON::parse from a stream");
+        {
+            auto r = getRandom();
+
+            expect (parseFromStream ("").isVoid());
+            expect (parseFromStream ("1234").isVoid());
+            expect (parseFromStream ("[ 1234 ]")[0].isInt());
+            expect (parseFromStream ("[ -2147483647 ]")[0].isInt());
+            expect (parseFromStream ("[ -2147483648 ]")[0].isInt64());
+            expect (parseFromStream ("[ 12345678901234 ]")[0].isInt64());
+            expect (parseFromStream ("[ 1.123e3 ]")[0].isDouble());
+            expect (parseFromStream ("{ \"a\": 1, \"b\": [ {} ] }")["b"][0].isObject());
+
+            for (int i = 100; --i >= 0;)
+            {
+                const auto v = JSONTests::createRandomVar (r, 0);
+
+                if (! (v.isObject() || v.isArray()))
+                    continue;
+
+                const auto oneLine = r.nextBool();
+                const auto asString = JSON::toString (v, oneLine);
+                expectEquals (JSON::toString (parseFromStream (asString), oneLine), asString);
+            }
+        }
+
+        beginTest ("Writer");
+        {
+            auto r = getRandom();
+
+            // JSONUtils::makeObject() sorts its keys, so the properties are added one by one to keep their order
+            auto* object = new DynamicObject();
+            const var expected (object);
+            object->setProperty ("name", "Bass\nline");
+            object->setProperty ("steps", Array<var> { 1, 2.5, true, var() });
+            object->setProperty ("empty", Array<var>{});
+            object->setProperty ("nested", JSONUtils::makeObject ({ { "a", 12345678901234LL } }));
+            object->setProperty ("emptyObject", new DynamicObject());
+
+            for (auto spacing : { JSON::Spacing::none, JSON::Spacing::singleLine, JSON::Spacing::multiLine })
+            {
+                const auto format = JSON::FormatOptions{}.withSpacing (spacing).withIndentLevel (r.nextInt (4));
+
+                MemoryOutputStream stream;
+
+                {
+                    JSONStreamWriter writer (stream, format);
+                    writer.beginObject();
+                    writer.writeKey ("name");
+                    writer.writeString ("Bass\nline");
+                    writer.writeKey ("steps");
+                    writer.beginArray();
+                    writer.writeInt64 (1);
+                    writer.writeDouble (2.5);
+                    writer.writeBool (true);
+                    writer.writeNull();
+                    writer.endArray();
+                    writer.writeKey ("empty");
+                    writer.beginArray();
+                    writer.endArray();
+                    writer.writeKey ("nested");
+                    writer.writeVar (JSONUtils::makeObject ({ { "a", 12345678901234LL } }));
+                    writer.writeKey ("emptyObject");
+                    writer.beginObject();
+                    writer.endObject();
+                    writer.endObject();
+                    expectEquals (writer.getDepth(), 0);
+                }
+
+                expectEquals (stream.toString(), JSON::toString (expected, format));
+            }
+
+            for (int i = 20; --i >= 0;)
+            {
+                const auto v = JSONTests::createRandomVar (r, 0);
+                const auto format = JSON::FormatOptions{}.withSpacing (r.nextBool() ? JSON::Spacing::multiLine : JSON::Spacing::none);
+
+                MemoryOutputStream stream;
+                JSONStreamWriter writer (stream, format);
+                writer.beginArray();
+                writer.writeVar (v);
+                writer.endArray();
+
+                expectEquals (stream.toString(), JSON::toString (Array<var> { v }, format));
+            }
+        }
+    }
+};
+
+static JSONStreamTests jsonStreamTests;
+
+#endif
+
+} // namespace juce
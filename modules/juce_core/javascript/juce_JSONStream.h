@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads JSON-formatted text from a stream, and reports each item to a Handler as
+    it's found, without building a tree of var objects.
+
+    This is useful for very large files, where JSON::parse() would need to hold the
+    whole text and the whole var tree in memory at the same time. The reader keeps
+    only a small buffer of the input, plus one level of state for each object or
+    array that is currently open.
+
+    The input should be UTF-8, or UTF-16 with a byte-order mark.
+
+    @see JSONStreamWriter, JSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONStreamReader
+{
+public:
+    //==============================================================================
+    /** Receives the items found by JSONStreamReader::parse().
+
+        The StringRef objects passed to onKey() and onString() point into the reader's
+        own buffer, so they're only valid until the callback returns. If you need to
+        keep them, copy them into a String or Identifier.
+    */
+    struct JUCE_API  Handler
+    {
+        virtual ~Handler() = default;
+
+        /** Called when a '{' is read. */
+        virtual void onBeginObject() {}
+
+        /** Called when the '}' that closes an object is read. */
+        virtual void onEndObject() {}
+
+        /** Called when a '[' is read. */
+        virtual void onBeginArray() {}
+
+        /** Called when the ']' that closes an array is read. */
+        virtual void onEndArray() {}
+
+        /** Called with the name of an object's property. The next callback will be
+            for the property's value.
+        */
+        virtual void onKey (StringRef name)             { ignoreUnused (name); }
+
+        /** Called when a string value is read. */
+        virtual void onString (StringRef value)         { ignoreUnused (value); }
+
+        /** Called when a number without a fractional part or exponent is read. */
+        virtual void onNumber (int64 value)             { ignoreUnused (value); }
+
+        /** Called when a number with a fractional part or exponent is read. */
+        virtual void onNumber (double value)            { ignoreUnused (value); }
+
+        /** Called when 'true' or 'false' is read. */
+        virtual void onBool (bool value)                { ignoreUnused (value); }
+
+        /** Called when 'null' is read. */
+        virtual void onNull() {}
+    };
+
+    //==============================================================================
+    /** Reads a single JSON value from the stream, which may be an object, an array,
+        or a primitive value, and passes its contents to the handler.
+
+        Parsing stops at the end of the first complete value, and anything after it
+        in the stream is ignored. If there's a syntax error, this returns a failed
+        Result containing the line and column of the error, and the handler will
+        already have been sent the items that came before it.
+    */
+    static Result parse (InputStream& input, Handler& handler);
+
+private:
+    //==============================================================================
+    JSONStreamReader() = delete; // This class can't be instantiated - just use its static methods.
+};
+
+//==============================================================================
+/**
+    Writes JSON-formatted text directly to an OutputStream, one item at a time.
+
+    This produces the same text as JSON::writeToStream() would produce for the
+    equivalent var, but doesn't need the var to be built first. Commas, spacing and
+    indentation are added automatically.
+
+    @code
+    JSONStreamWriter writer (stream, JSON::FormatOptions{}.withSpacing (JSON::Spacing::none));
+
+    writer.beginObject();
+    writer.writeKey ("name");
+    writer.writeString ("Bassline");
+    writer.writeKey ("steps");
+    writer.beginArray();
+
+    for (auto step : steps)
+        writer.writeInt64 (step);
+
+    writer.endArray();
+    writer.endObject();
+    @endcode
+
+    Every object or array that is begun must also be ended, and inside an object,
+    every value must be preceded by a call to writeKey().
+
+    @see JSONStreamReader, JSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONStreamWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer that will write to the given stream.
+        The stream must remain valid for the lifetime of this writer.
+    */
+    explicit JSONStreamWriter (OutputStream& output,
+                               const JSON::FormatOptions& formatOptions = {});
+
+    //==============================================================================
+    /** Writes a '{' and starts a new object. */
+    void beginObject();
+
+    /** Closes the object that was most recently begun. */
+    void endObject();
+
+    /** Writes a '[' and starts a new array. */
+    void beginArray();
+
+    /** Closes the array that was most recently begun. */
+    void endArray();
+
+    /** Writes the name of the next property in the current object. */
+    void writeKey (StringRef name);
+
+    /** Writes the name of the next property in the current object, taking the name
+        from a range of UTF-8 characters that doesn't need to be null-terminated.
+    */
+    void writeKey (CharPointer_UTF8 nameStart, CharPointer_UTF8 nameEnd);
+
+    //==============================================================================
+    /** Writes a string value. */
+    void writeString (StringRef value);
+
+    /** Writes an integer value. */
+    void writeInt64 (int64 value);
+
+    /** Writes a floating-point value. Values that aren't finite are written as null. */
+    void writeDouble (double value);
+
+    /** Writes 'true' or 'false'. */
+    void writeBool (bool value);
+
+    /** Writes 'null'. */
+    void writeNull();
+
+    /** Writes a var, in the same way as JSON::writeToStream(). */
+    void writeVar (const var& value);
+
+    //==============================================================================
+    /** Returns the number of objects and arrays that are currently open.
+        Once everything has been written, this should be zero.
+    */
+    int getDepth() const noexcept               { return levels.size(); }
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        bool isObject = false, isEmpty = true;
+    };
+
+    void startValue();
+    void writeSeparator();
+    void startKey();
+    int getIndentLevel() const noexcept;
+
+    OutputStream& out;
+    const JSON::FormatOptions format;
+    Array<Level> levels;
+    bool expectingValueForKey = false;
+
+    JUCE_DECLARE_NON_COPYABLE (JSONStreamWriter)
+};
+
+} // namespace juce
@@ -71,6 +71,9 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     }
 
     Time timeout;
+    std::atomic<bool> interrupted { false };
+    int64 lastClockReading = 0;
+    int checksBetweenClockReadings = 1, checksUntilClockReading = 1;
 
     using Args = const var::NativeFunctionArgs&;
     using TokenType = const char*;
@@ -78,15 +81,49 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     void execute (const String& code)
     {
         ExpressionTreeBuilder tb (code);
-        std::unique_ptr<BlockStatement> (tb.parseStatementList())->perform (Scope ({}, *this, *this), nullptr);
+        std::unique_ptr<BlockStatement> statements (tb.parseStatementList());
+        Scope scope ({}, *this, *this);
+        run (scope, *Compiler::compileScript (*statements));
     }
 
     var evaluate (const String& code)
     {
         ExpressionTreeBuilder tb (code);
-        return ExpPtr (tb.parseExpression())->getResult (Scope ({}, *this, *this));
+        ExpPtr expression (tb.parseExpression());
+        Scope scope ({}, *this, *this);
+        return run (scope, *Compiler::compileExpression (*expression));
     }
 
+    void prepareTimeout (Time newTimeout) noexcept
+    {
+        timeout = newTimeout;
+        interrupted = false;
+        lastClockReading = 0;
+        checksBetweenClockReadings = checksUntilClockReading = 1;
+    }
+
+    // Returns an error message if the script should stop
+    const char* checkTimeOut() noexcept
+    {
+        if (interrupted)
+            return "Interrupted";
+
+        if (--checksUntilClockReading > 0)
+            return nullptr;
+
+        // Reading the clock costs more than a simple loop iteration, so while the
+        // clock hasn't moved on since the last reading, it gets read less often
+        const auto now = Time::currentTimeMillis();
+        checksBetweenClockReadings = now == lastClockReading ? jmin (64, checksBetweenClockReadings * 2) : 1;
+        checksUntilClockReading = checksBetweenClockReadings;
+        lastClockReading = now;
+
+        return now > timeout.toMilliseconds() ? "Execution timed-out" : nullptr;
+    }
+
+    // A native function could have taken any amount of time, so the clock needs checking
+    void nativeFunctionWasCalled() noexcept     { checksUntilClockReading = 1; }
+
     //==============================================================================
     static bool areTypeEqual (const var& a, const var& b)
     {
@@ -100,8 +137,29 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     static bool isNumericOrUndefined (const var& v) noexcept  { return isNumeric (v) || v.isUndefined(); }
     static int64 getOctalValue (const String& s)              { BigInteger b; b.parseString (s.initialSectionContainingOnly ("01234567"), 8); return b.toInt64(); }
     static Identifier getPrototypeIdentifier()                { static const Identifier i ("prototype"); return i; }
+    static Identifier getThisIdentifier()                     { static const Identifier i ("this"); return i; }
     static var* getPropertyPointer (DynamicObject& o, const Identifier& i) noexcept   { return o.getProperties().getVarPointer (i); }
 
+    // Looks up a property, trying the index at which this lookup last found it before
+    // searching. Scopes and objects that are built by the same code tend to have their
+    // properties in the same order, so the cached index is usually right.
+    static var* getPropertyPointer (DynamicObject& o, const Identifier& i, int& cachedIndex) noexcept
+    {
+        auto& props = o.getProperties();
+
+        if (! (isPositiveAndBelow (cachedIndex, props.size()) && props.begin()[cachedIndex].name == i))
+        {
+            auto index = props.indexOf (i);
+
+            if (index < 0)
+                return nullptr;
+
+            cachedIndex = index;
+        }
+
+        return props.getVarPointerAt (cachedIndex);
+    }
+
     //==============================================================================
     struct CodeLocation
     {
@@ -125,120 +183,1324 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         String::CharPointerType location;
     };
 
+    //==============================================================================
+    // Scripts and function bodies are compiled into these instructions, which work on a
+    // stack of values. The comments show what each one takes from the top of the stack,
+    // and what it leaves there.
+    enum class OpCode : uint8
+    {
+        pushConstant,       // [] -> [constant]
+        pushUndefined,      // [] -> [undefined]
+        pop,                // [a] -> []
+        loadName,           // [] -> [value]        a name that isn't one of the function's variables
+        storeName,          // [v] -> [v]
+        declareName,        // [v] -> []            a var statement outside a function
+        loadThis,           // [] -> [this]
+        loadLocal,          // [] -> [value]        one of the function's variables
+        storeLocal,         // [v] -> [v]
+        moveToLocal,        // [v] -> []
+        declareLocal,       // [v] -> []
+        getMember,          // [object] -> [object.name]
+        getLocalMember,     // [] -> [variable.name]
+        getLength,          // [object] -> [object.length]
+        setMember,          // [v, object] -> [v]
+        getIndex,           // [object, key] -> [object[key]]
+        setIndex,           // [v, object, key] -> [v]
+        equals, notEquals, lessThan, lessThanOrEqual, greaterThan, greaterThanOrEqual,
+        add, subtract, multiply, divide, modulo,
+        bitwiseOr, bitwiseAnd, bitwiseXor, leftShift, rightShift, rightShiftUnsigned,
+        typeEquals, typeNotEquals,  // [a, b] -> [a op b], or [a] -> [a op constant] if there's a constant index + 1
+        logicalAnd,         // [a] -> [] if a is true, otherwise [false] and jumps
+        logicalOr,          // [a] -> [] if a is false, otherwise [true] and jumps
+        toBool,             // [a] -> [bool (a)]
+        jump,
+        jumpIfFalse,        // [a] -> []
+        jumpIfTrue,         // [a] -> []
+        checkTimeOut,
+        call,               // [function, args...] -> [result]      with the scope as 'this'
+        findMethod,         // [object] -> [object, function]
+        callMethod,         // [object, function, args...] -> [result]
+        beginNew,           // [function] -> [new object, function], or jumps with [new object or undefined]
+        construct,          // [new object, function, args...] -> [new object]
+        createObject,       // [values...] -> [object]
+        createArray,        // [values...] -> [array]
+        returnValue,        // [v] ->
+        returnVoid,
+        throwError          // throws the message held in a constant
+    };
+
+    struct Instruction
+    {
+        OpCode opCode;
+        int operand, extra;
+    };
+
+    //==============================================================================
+    struct CompiledCode
+    {
+        CompiledCode (const String& code) : program (code) {}
+
+        CodeLocation getLocation (const Instruction& i) const
+        {
+            CodeLocation l (program);
+            l.location = locations[(size_t) (&i - instructions.data())];
+            return l;
+        }
+
+        // A name used by an instruction, and where it was last found. Looking a name up can search
+        // the variables of every function in the call stack, and in recursive code they're mostly
+        // the same function's.
+        struct NameReference
+        {
+            Identifier name;
+            mutable int cachedIndex;                                // in an object's properties
+            mutable const CompiledCode* cachedCode = nullptr;       // in a function's variables
+            mutable int cachedVariableIndex = -1;
+        };
+
+        int getVariableIndex (const NameReference& ref) const
+        {
+            if (ref.cachedCode != this)
+            {
+                ref.cachedCode = this;
+                ref.cachedVariableIndex = variables.indexOf (ref.name);
+            }
+
+            return ref.cachedVariableIndex;
+        }
+
+        String program;
+        std::vector<Instruction> instructions;
+        std::vector<String::CharPointerType> locations;
+        std::vector<NameReference> names;
+        Array<var> constants;
+        int maxStackSize = 0;
+
+        // A function's variables are 'this', its parameters, and any that it declares with var
+        Array<Identifier> variables;
+        Array<int> parameterIndexes;
+        bool hasParameterCalledThis = false;
+    };
+
+    //==============================================================================
+    // Uninitialised space for some objects, which only uses the heap if there are a lot of them
+    template <typename Type, int numPreallocated>
+    struct LocalStorage
+    {
+        explicit LocalStorage (int size)
+        {
+            if (size > numPreallocated)
+                heap.malloc (size);
+        }
+
+        Type* get() noexcept    { return heap != nullptr ? heap.get() : reinterpret_cast<Type*> (preallocated); }
+
+    private:
+        alignas (Type) char preallocated[sizeof (Type) * numPreallocated];
+        HeapBlock<Type> heap;
+    };
+
+    struct ValueStack
+    {
+        explicit ValueStack (int capacity) : storage (capacity), base (storage.get()), top (base) {}
+        ~ValueStack()                               { pop ((int) (top - base)); }
+
+        template <typename... Args>
+        void push (Args&&... args)                  { new (top++) var (std::forward<Args> (args)...); }
+        void pop() noexcept                         { (--top)->~var(); }
+        void pop (int num) noexcept                 { while (--num >= 0) pop(); }
+
+        LocalStorage<var, 16> storage;
+        var* const base;
+        var* top;
+    };
+
+    struct Variable
+    {
+        var value;
+        int definitionIndex = -1; // the order in which the variables were first set, or -1 if this one hasn't been
+    };
+
+    struct VariableArray
+    {
+        explicit VariableArray (int num) : storage (num), data (storage.get()), size (num)
+        {
+            for (int i = 0; i < size; ++i)
+                new (data + i) Variable();
+        }
+
+        ~VariableArray()
+        {
+            for (int i = 0; i < size; ++i)
+                data[i].~Variable();
+        }
+
+        LocalStorage<Variable, 16> storage;
+        Variable* const data;
+        const int size;
+    };
+
     //==============================================================================
     struct Scope
     {
-        Scope (const Scope* p, ReferenceCountedObjectPtr<RootObject> rt, DynamicObject::Ptr scp) noexcept
-            : parent (p), root (std::move (rt)),
-              scope (std::move (scp)) {}
+        // A scope whose variables are the properties of an object
+        Scope (Scope* p, RootObject& rt, DynamicObject::Ptr scp) noexcept
+            : parent (p), root (rt), scope (std::move (scp)) {}
+
+        // A function call, whose variables are kept in slots until something needs them to be
+        // the properties of an object
+        Scope (Scope* p, RootObject& rt, const CompiledCode& c, Variable* v, int numDefined, Scope* thisScope) noexcept
+            : parent (p), root (rt), code (&c), variables (v), numDefinedVariables (numDefined), pendingThisScope (thisScope) {}
 
-        const Scope* const parent;
-        ReferenceCountedObjectPtr<RootObject> root;
+        Scope* const parent;
+        RootObject& root;
         DynamicObject::Ptr scope;
 
-        var findFunctionCall (const CodeLocation& location, const var& targetObject, const Identifier& functionName) const
+        const CompiledCode* const code = nullptr;
+        Variable* const variables = nullptr;
+        int numDefinedVariables = 0;
+
+        // When a function is called without an object, 'this' is the caller's scope. Rather than
+        // giving that scope an object straight away, this points to it until 'this' is used.
+        Scope* pendingThisScope = nullptr;
+
+        DynamicObject& getScopeObject()
+        {
+            if (scope == nullptr)
+            {
+                resolvePendingThis();
+
+                // the variables are added in the order that they were set, as they would have been
+                // if they'd been properties all along
+                Array<int> order;
+                order.insertMultiple (0, -1, numDefinedVariables);
+
+                for (int i = 0; i < code->variables.size(); ++i)
+                    if (variables[i].definitionIndex >= 0)
+                        order.set (variables[i].definitionIndex, i);
+
+                DynamicObject::Ptr object (new DynamicObject());
+
+                for (auto i : order)
+                    object->getProperties().set (code->variables.getReference (i), std::move (variables[i].value));
+
+                scope = std::move (object);
+            }
+
+            return *scope;
+        }
+
+        void resolvePendingThis()
+        {
+            if (auto* s = std::exchange (pendingThisScope, nullptr))
+                variables[0].value = &s->getScopeObject();
+        }
+
+        // Once nothing else is using a function call's scope object, its variables can go back into slots
+        void releaseScopeObjectIfUnused()
+        {
+            if (code == nullptr || scope == nullptr || scope->getReferenceCount() > 1)
+                return;
+
+            auto& properties = scope->getProperties();
+
+            for (auto& p : properties)
+                if (! code->variables.contains (p.name))
+                    return;
+
+            for (int i = 0; i < code->variables.size(); ++i)
+                variables[i].definitionIndex = -1;
+
+            numDefinedVariables = 0;
+
+            for (int i = 0; i < properties.size(); ++i)
+            {
+                auto& v = variables[code->variables.indexOf (properties.getName (i))];
+                v.value = std::move (*properties.getVarPointerAt (i));
+                v.definitionIndex = numDefinedVariables++;
+            }
+
+            scope = nullptr;
+        }
+
+        var* findVariable (const CompiledCode::NameReference& ref)
+        {
+            if (scope != nullptr)
+                return getPropertyPointer (*scope, ref.name, ref.cachedIndex);
+
+            auto index = code->getVariableIndex (ref);
+
+            if (index < 0 || variables[index].definitionIndex < 0)
+                return nullptr;
+
+            if (index == 0)
+                resolvePendingThis();
+
+            return &variables[index].value;
+        }
+
+        var findSymbolInParentScopes (const CompiledCode::NameReference& ref)
+        {
+            for (auto* s = this; s != nullptr; s = s->parent)
+                if (auto* v = s->findVariable (ref))
+                    return *v;
+
+            return var::undefined();
+        }
+
+        // Looks up a name that isn't one of the function's own variables
+        var findNonLocalSymbol (const CompiledCode::NameReference& ref)
+        {
+            auto* s = (code != nullptr && scope == nullptr) ? parent : this;
+            return s != nullptr ? s->findSymbolInParentScopes (ref) : var::undefined();
+        }
+
+        // Looks up one of the function's own variables, which hasn't been set, or is in an object
+        var findLocalSymbol (const CompiledCode::NameReference& ref)
+        {
+            if (scope != nullptr)
+                if (auto* v = getPropertyPointer (*scope, ref.name, ref.cachedIndex))
+                    return *v;
+
+            return parent != nullptr ? parent->findSymbolInParentScopes (ref) : var::undefined();
+        }
+
+        void setVariable (const CompiledCode::NameReference& ref, const var& newValue)
+        {
+            if (scope != nullptr)
+            {
+                if (auto* v = getPropertyPointer (*scope, ref.name, ref.cachedIndex))
+                {
+                    *v = newValue;
+                    return;
+                }
+            }
+
+            // the same as root.setProperty(), but without searching for the property
+            if (auto* v = getPropertyPointer (root, ref.name, ref.cachedIndex))
+            {
+                if (! v->equalsWithSameType (newValue))
+                    *v = newValue;
+            }
+            else
+            {
+                root.setProperty (ref.name, newValue);
+            }
+        }
+
+        bool findFunctionCall (const var& targetObject, const CompiledCode::NameReference& function, var& result) const
         {
             if (auto* o = targetObject.getDynamicObject())
             {
-                if (auto* prop = getPropertyPointer (*o, functionName))
-                    return *prop;
+                if (auto* prop = getPropertyPointer (*o, function.name, function.cachedIndex))
+                {
+                    result = *prop;
+                    return true;
+                }
 
                 for (auto* p = o->getProperty (getPrototypeIdentifier()).getDynamicObject(); p != nullptr;
                      p = p->getProperty (getPrototypeIdentifier()).getDynamicObject())
                 {
-                    if (auto* prop = getPropertyPointer (*p, functionName))
-                        return *prop;
+                    if (auto* prop = getPropertyPointer (*p, function.name))
+                    {
+                        result = *prop;
+                        return true;
+                    }
                 }
 
                 // if there's a class with an overridden DynamicObject::hasMethod, this avoids an error
-                if (o->hasMethod (functionName))
-                    return {};
+                if (o->hasMethod (function.name))
+                    return true;
             }
 
+            var* m = nullptr;
+
             if (targetObject.isString())
-                if (auto* m = findRootClassProperty (StringClass::getClassName(), functionName))
-                    return *m;
+                m = findRootClassProperty (StringClass::getClassName(), function.name);
 
-            if (targetObject.isArray())
-                if (auto* m = findRootClassProperty (ArrayClass::getClassName(), functionName))
-                    return *m;
+            if (m == nullptr && targetObject.isArray())
+                m = findRootClassProperty (ArrayClass::getClassName(), function.name);
 
-            if (auto* m = findRootClassProperty (ObjectClass::getClassName(), functionName))
-                return *m;
+            if (m == nullptr)
+                m = findRootClassProperty (ObjectClass::getClassName(), function.name);
 
-            location.throwError ("Unknown function '" + functionName.toString() + "'");
-            return {};
+            if (m == nullptr)
+                return false;
+
+            result = *m;
+            return true;
         }
 
         var* findRootClassProperty (const Identifier& className, const Identifier& propName) const
         {
-            if (auto* cls = root->getProperty (className).getDynamicObject())
+            if (auto* cls = root.getProperty (className).getDynamicObject())
                 return getPropertyPointer (*cls, propName);
 
             return nullptr;
         }
 
-        var findSymbolInParentScopes (const Identifier& name) const
+        // Calls a function without an object, so that 'this' is the scope
+        var callWithScopeAsThis (const var& function, var* args, int numArgs, const CompiledCode& c, const Instruction& i)
+        {
+            if (function.isMethod())
+            {
+                if (auto nativeFunction = function.getNativeFunction())
+                {
+                    var result;
+
+                    {
+                        const var thisObject (scope != nullptr ? var (scope.get())
+                                                               : (ignoresThisObject (nativeFunction) ? var() : var (&getScopeObject())));
+
+                        result = nativeFunction (var::NativeFunctionArgs (thisObject, args, numArgs));
+                        root.nativeFunctionWasCalled();
+                    }
+
+                    releaseScopeObjectIfUnused();
+                    return result;
+                }
+            }
+
+            if (auto* fo = dynamic_cast<FunctionObject*> (function.getObject()))
+            {
+                auto result = scope != nullptr ? fo->invoke (*this, var (scope.get()), nullptr, args, numArgs)
+                                               : fo->invoke (*this, {}, this, args, numArgs);
+                releaseScopeObjectIfUnused();
+                return result;
+            }
+
+            c.getLocation (i).throwError ("This expression is not a function!");
+            return {};
+        }
+
+        // The root object's own functions don't use 'this', so there's no need to give a scope an object for them
+        static bool ignoresThisObject (const var::NativeFunction& f)
+        {
+            if (auto* fn = f.target<var (*) (Args)>())
+                return *fn == exec || *fn == eval || *fn == charToInt || *fn == IntegerClass::parseInt
+                        || *fn == typeof_internal || *fn == parseFloat;
+
+            return false;
+        }
+
+        bool findAndInvokeMethod (const Identifier& function, const var::NativeFunctionArgs& args, var& result)
+        {
+            auto* target = args.thisObject.getDynamicObject();
+
+            if (target == nullptr || target == scope.get())
+            {
+                if (auto* m = getPropertyPointer (*scope, function))
+                {
+                    if (auto fo = dynamic_cast<FunctionObject*> (m->getObject()))
+                    {
+                        result = fo->invoke (*this, args);
+                        return true;
+                    }
+                }
+            }
+
+            const auto& props = scope->getProperties();
+
+            for (int i = 0; i < props.size(); ++i)
+                if (auto* o = props.getValueAt (i).getDynamicObject())
+                    if (Scope (this, root, *o).findAndInvokeMethod (function, args, result))
+                        return true;
+
+            return false;
+        }
+
+        bool invokeMethod (const var& m, const var::NativeFunctionArgs& args, var& result)
+        {
+            if (isFunction (m))
+            {
+                auto* target = args.thisObject.getDynamicObject();
+
+                if (target == nullptr || target == scope.get())
+                {
+                    if (auto fo = dynamic_cast<FunctionObject*> (m.getObject()))
+                    {
+                        result = fo->invoke (*this, args);
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Scope)
+    };
+
+    //==============================================================================
+    // What each binary operator does with each type of operand. The types that an operator
+    // doesn't define are errors.
+    struct BinaryOperation
+    {
+        struct NotAllowed {};
+
+        static var getWithUndefinedArg()                                    { return var::undefined(); }
+        static NotAllowed getWithDoubles (double, double)                   { return {}; }
+        static NotAllowed getWithInts (int64, int64)                        { return {}; }
+        static NotAllowed getWithArrayOrObject (const var&, const var&)     { return {}; }
+        static NotAllowed getWithStrings (const String&, const String&)     { return {}; }
+    };
+
+    struct Equals final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::equals;
+        static TokenType getToken()                                         { return TokenTypes::equals; }
+        static var getWithUndefinedArg()                                    { return true; }
+        static var getWithDoubles (double a, double b)                      { return exactlyEqual (a, b); }
+        static var getWithInts (int64 a, int64 b)                           { return a == b; }
+        static var getWithStrings (const String& a, const String& b)        { return a == b; }
+        static var getWithArrayOrObject (const var& a, const var& b)        { return a == b; }
+    };
+
+    struct NotEquals final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::notEquals;
+        static TokenType getToken()                                         { return TokenTypes::notEquals; }
+        static var getWithUndefinedArg()                                    { return false; }
+        static var getWithDoubles (double a, double b)                      { return ! exactlyEqual (a, b); }
+        static var getWithInts (int64 a, int64 b)                           { return a != b; }
+        static var getWithStrings (const String& a, const String& b)        { return a != b; }
+        static var getWithArrayOrObject (const var& a, const var& b)        { return a != b; }
+    };
+
+    struct LessThan final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::lessThan;
+        static TokenType getToken()                                         { return TokenTypes::lessThan; }
+        static var getWithDoubles (double a, double b)                      { return a < b; }
+        static var getWithInts (int64 a, int64 b)                           { return a < b; }
+        static var getWithStrings (const String& a, const String& b)        { return a < b; }
+    };
+
+    struct LessThanOrEqual final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::lessThanOrEqual;
+        static TokenType getToken()                                         { return TokenTypes::lessThanOrEqual; }
+        static var getWithDoubles (double a, double b)                      { return a <= b; }
+        static var getWithInts (int64 a, int64 b)                           { return a <= b; }
+        static var getWithStrings (const String& a, const String& b)        { return a <= b; }
+    };
+
+    struct GreaterThan final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::greaterThan;
+        static TokenType getToken()                                         { return TokenTypes::greaterThan; }
+        static var getWithDoubles (double a, double b)                      { return a > b; }
+        static var getWithInts (int64 a, int64 b)                           { return a > b; }
+        static var getWithStrings (const String& a, const String& b)        { return a > b; }
+    };
+
+    struct GreaterThanOrEqual final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::greaterThanOrEqual;
+        static TokenType getToken()                                         { return TokenTypes::greaterThanOrEqual; }
+        static var getWithDoubles (double a, double b)                      { return a >= b; }
+        static var getWithInts (int64 a, int64 b)                           { return a >= b; }
+        static var getWithStrings (const String& a, const String& b)        { return a >= b; }
+    };
+
+    struct Addition final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::add;
+        static TokenType getToken()                                         { return TokenTypes::plus; }
+        static var getWithDoubles (double a, double b)                      { return a + b; }
+        static var getWithInts (int64 a, int64 b)                           { return a + b; }
+        static var getWithStrings (const String& a, const String& b)        { return a + b; }
+    };
+
+    struct Subtraction final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::subtract;
+        static TokenType getToken()                                         { return TokenTypes::minus; }
+        static var getWithDoubles (double a, double b)                      { return a - b; }
+        static var getWithInts (int64 a, int64 b)                           { return a - b; }
+    };
+
+    struct Multiply final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::multiply;
+        static TokenType getToken()                                         { return TokenTypes::times; }
+        static var getWithDoubles (double a, double b)                      { return a * b; }
+        static var getWithInts (int64 a, int64 b)                           { return a * b; }
+    };
+
+    struct Divide final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::divide;
+        static TokenType getToken()                                         { return TokenTypes::divide; }
+        static var getWithDoubles (double a, double b)                      { return exactlyEqual (b, 0.0) ? std::numeric_limits<double>::infinity() : a / b; }
+        static var getWithInts (int64 a, int64 b)                           { return b != 0 ? var ((double) a / (double) b) : var (std::numeric_limits<double>::infinity()); }
+    };
+
+    struct Modulo final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::modulo;
+        static TokenType getToken()                                         { return TokenTypes::modulo; }
+        static var getWithDoubles (double a, double b)                      { return exactlyEqual (b, 0.0) ? std::numeric_limits<double>::infinity() : fmod (a, b); }
+        static var getWithInts (int64 a, int64 b)                           { return b != 0 ? var (a % b) : var (std::numeric_limits<double>::infinity()); }
+    };
+
+    struct BitwiseOr final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::bitwiseOr;
+        static TokenType getToken()                                         { return TokenTypes::bitwiseOr; }
+        static var getWithInts (int64 a, int64 b)                           { return a | b; }
+    };
+
+    struct BitwiseAnd final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::bitwiseAnd;
+        static TokenType getToken()                                         { return TokenTypes::bitwiseAnd; }
+        static var getWithInts (int64 a, int64 b)                           { return a & b; }
+    };
+
+    struct BitwiseXor final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::bitwiseXor;
+        static TokenType getToken()                                         { return TokenTypes::bitwiseXor; }
+        static var getWithInts (int64 a, int64 b)                           { return a ^ b; }
+    };
+
+    struct LeftShift final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::leftShift;
+        static TokenType getToken()                                         { return TokenTypes::leftShift; }
+        static var getWithInts (int64 a, int64 b)                           { return ((int) a) << (int) b; }
+    };
+
+    struct RightShift final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::rightShift;
+        static TokenType getToken()                                         { return TokenTypes::rightShift; }
+        static var getWithInts (int64 a, int64 b)                           { return ((int) a) >> (int) b; }
+    };
+
+    struct RightShiftUnsigned final : public BinaryOperation
+    {
+        static constexpr auto opCode = OpCode::rightShiftUnsigned;
+        static TokenType getToken()                                         { return TokenTypes::rightShiftUnsigned; }
+        static var getWithInts (int64 a, int64 b)                           { return (int) (((uint32) a) >> (int) b); }
+    };
+
+    template <typename Operation>
+    static var applyOperator (const var& a, const var& b, const CompiledCode& code, const Instruction& i)
+    {
+        const auto check = [&] (auto result, const char* typeName) -> var
+        {
+            if constexpr (std::is_same_v<decltype (result), BinaryOperation::NotAllowed>)
+            {
+                code.getLocation (i).throwError (getTokenName (Operation::getToken()) + " is not allowed on the " + typeName + " type");
+                return {};
+            }
+            else
+            {
+                return result;
+            }
+        };
+
+        if ((a.isInt64() || a.isInt()) && (b.isInt64() || b.isInt()))
+            return check (Operation::getWithInts (a, b), "Integer");
+
+        if (a.isDouble() && b.isDouble())
+            return check (Operation::getWithDoubles (a, b), "Double");
+
+        if ((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid()))
+            return Operation::getWithUndefinedArg();
+
+        if (isNumericOrUndefined (a) && isNumericOrUndefined (b))
+            return (a.isDouble() || b.isDouble()) ? check (Operation::getWithDoubles (a, b), "Double")
+                                                  : check (Operation::getWithInts (a, b), "Integer");
+
+        if (a.isArray() || a.isObject())
+            return check (Operation::getWithArrayOrObject (a, b), a.isArray() ? "Array" : "Object");
+
+        return check (Operation::getWithStrings (a.toString(), b.toString()), "String");
+    }
+
+    template <typename Operation>
+    static void applyOperator (ValueStack& stack, const CompiledCode& code, const Instruction& i)
+    {
+        if (i.operand > 0)
+        {
+            auto& a = stack.top[-1];
+            a = applyOperator<Operation> (a, code.constants.getReference (i.operand - 1), code, i);
+            return;
+        }
+
+        auto& a = stack.top[-2];
+        a = applyOperator<Operation> (a, stack.top[-1], code, i);
+        stack.pop();
+    }
+
+    static var getMember (const var& object, const CompiledCode::NameReference& ref)
+    {
+        if (auto* o = object.getDynamicObject())
+            if (auto* v = getPropertyPointer (*o, ref.name, ref.cachedIndex))
+                return *v;
+
+        return var::undefined();
+    }
+
+    static var getSubscript (const var& arrayVar, const var& key)
+    {
+        if (const auto* array = arrayVar.getArray())
+            if (key.isInt() || key.isInt64() || key.isDouble())
+                return (*array) [static_cast<int> (key)];
+
+        if (auto* o = arrayVar.getDynamicObject())
+            if (key.isString())
+                if (auto* v = getPropertyPointer (*o, Identifier (key)))
+                    return *v;
+
+        return var::undefined();
+    }
+
+    static bool setSubscript (const var& arrayVar, const var& key, const var& newValue)
+    {
+        if (auto* array = arrayVar.getArray())
+        {
+            if (key.isInt() || key.isInt64() || key.isDouble())
+            {
+                const int i = key;
+                while (array->size() < i)
+                    array->add (var::undefined());
+
+                array->set (i, newValue);
+                return true;
+            }
+        }
+
+        if (auto* o = arrayVar.getDynamicObject())
+        {
+            if (key.isString())
+            {
+                o->setProperty (Identifier (key), newValue);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //==============================================================================
+    static var run (Scope& s, const CompiledCode& code)
+    {
+        ValueStack stack (code.maxStackSize);
+        auto* const instructions = code.instructions.data();
+        auto* ip = instructions;
+
+        for (;;)
+        {
+            const auto& i = *ip++;
+
+            switch (i.opCode)
+            {
+                case OpCode::pushConstant:      stack.push (code.constants.getReference (i.operand)); break;
+                case OpCode::pushUndefined:     stack.push (var::undefined()); break;
+                case OpCode::pop:               stack.pop(); break;
+                case OpCode::loadName:          stack.push (s.findNonLocalSymbol (code.names[(size_t) i.operand])); break;
+                case OpCode::storeName:         s.setVariable (code.names[(size_t) i.operand], stack.top[-1]); break;
+
+                case OpCode::declareName:
+                    s.scope->setProperty (code.names[(size_t) i.operand].name, stack.top[-1]);
+                    stack.pop();
+                    break;
+
+                case OpCode::loadThis:
+                    s.resolvePendingThis();
+                    [[fallthrough]];
+
+                case OpCode::loadLocal:
+                {
+                    auto& v = s.variables[i.operand];
+
+                    if (s.scope == nullptr && v.definitionIndex >= 0)
+                        stack.push (v.value);
+                    else
+                        stack.push (s.findLocalSymbol (code.names[(size_t) i.extra]));
+
+                    break;
+                }
+
+                case OpCode::storeLocal:
+                {
+                    if (i.operand == 0)
+                        s.resolvePendingThis();
+
+                    auto& v = s.variables[i.operand];
+
+                    if (s.scope == nullptr && v.definitionIndex >= 0)
+                        v.value = stack.top[-1];
+                    else
+                        s.setVariable (code.names[(size_t) i.extra], stack.top[-1]);
+
+                    break;
+                }
+
+                case OpCode::moveToLocal:
+                {
+                    if (i.operand == 0)
+                        s.resolvePendingThis();
+
+                    auto& v = s.variables[i.operand];
+
+                    if (s.scope == nullptr && v.definitionIndex >= 0)
+                        v.value = std::move (stack.top[-1]);
+                    else
+                        s.setVariable (code.names[(size_t) i.extra], stack.top[-1]);
+
+                    stack.pop();
+                    break;
+                }
+
+                case OpCode::declareLocal:
+                {
+                    if (i.operand == 0)
+                        s.resolvePendingThis();
+
+                    auto& v = s.variables[i.operand];
+                    auto& newValue = stack.top[-1];
+
+                    if (s.scope != nullptr)
+                    {
+                        s.scope->setProperty (code.variables.getReference (i.operand), newValue);
+                    }
+                    else if (v.definitionIndex < 0)
+                    {
+                        v.value = std::move (newValue);
+                        v.definitionIndex = s.numDefinedVariables++;
+                    }
+                    else if (! v.value.equalsWithSameType (newValue))
+                    {
+                        v.value = std::move (newValue);
+                    }
+
+                    stack.pop();
+                    break;
+                }
+
+                case OpCode::getLength:
+                {
+                    auto& object = stack.top[-1];
+
+                    if (auto* array = object.getArray())    { object = array->size(); break; }
+                    if (object.isString())                  { object = object.toString().length(); break; }
+
+                    [[fallthrough]];
+                }
+
+                case OpCode::getMember:
+                {
+                    auto& object = stack.top[-1];
+                    object = getMember (object, code.names[(size_t) i.operand]);
+                    break;
+                }
+
+                case OpCode::getLocalMember:
+                {
+                    // the variable's name follows the member's
+                    if (i.operand == 0)
+                        s.resolvePendingThis();
+
+                    auto& v = s.variables[i.operand];
+
+                    if (s.scope == nullptr && v.definitionIndex >= 0)
+                        stack.push (getMember (v.value, code.names[(size_t) i.extra]));
+                    else
+                        stack.push (getMember (s.findLocalSymbol (code.names[(size_t) i.extra + 1]), code.names[(size_t) i.extra]));
+
+                    break;
+                }
+
+                case OpCode::setMember:
+                {
+                    if (auto* o = stack.top[-1].getDynamicObject())
+                        o->setProperty (code.names[(size_t) i.operand].name, stack.top[-2]);
+                    else
+                        code.getLocation (i).throwError ("Cannot assign to this expression!");
+
+                    stack.pop();
+                    break;
+                }
+
+                case OpCode::getIndex:
+                {
+                    auto& object = stack.top[-2];
+                    object = getSubscript (object, stack.top[-1]);
+                    stack.pop();
+                    break;
+                }
+
+                case OpCode::setIndex:
+                {
+                    if (! setSubscript (stack.top[-2], stack.top[-1], stack.top[-3]))
+                        code.getLocation (i).throwError ("Cannot assign to this expression!");
+
+                    stack.pop (2);
+                    break;
+                }
+
+                case OpCode::equals:                applyOperator<Equals>             (stack, code, i); break;
+                case OpCode::notEquals:             applyOperator<NotEquals>          (stack, code, i); break;
+                case OpCode::lessThan:              applyOperator<LessThan>           (stack, code, i); break;
+                case OpCode::lessThanOrEqual:       applyOperator<LessThanOrEqual>    (stack, code, i); break;
+                case OpCode::greaterThan:           applyOperator<GreaterThan>        (stack, code, i); break;
+                case OpCode::greaterThanOrEqual:    applyOperator<GreaterThanOrEqual> (stack, code, i); break;
+                case OpCode::add:                   applyOperator<Addition>           (stack, code, i); break;
+                case OpCode::subtract:              applyOperator<Subtraction>        (stack, code, i); break;
+                case OpCode::multiply:              applyOperator<Multiply>           (stack, code, i); break;
+                case OpCode::divide:                applyOperator<Divide>             (stack, code, i); break;
+                case OpCode::modulo:                applyOperator<Modulo>             (stack, code, i); break;
+                case OpCode::bitwiseOr:             applyOperator<BitwiseOr>          (stack, code, i); break;
+                case OpCode::bitwiseAnd:            applyOperator<BitwiseAnd>         (stack, code, i); break;
+                case OpCode::bitwiseXor:            applyOperator<BitwiseXor>         (stack, code, i); break;
+                case OpCode::leftShift:             applyOperator<LeftShift>          (stack, code, i); break;
+                case OpCode::rightShift:            applyOperator<RightShift>         (stack, code, i); break;
+                case OpCode::rightShiftUnsigned:    applyOperator<RightShiftUnsigned> (stack, code, i); break;
+
+                case OpCode::typeEquals:
+                case OpCode::typeNotEquals:
+                {
+                    auto& a = stack.top[-2];
+                    a = areTypeEqual (a, stack.top[-1]) == (i.opCode == OpCode::typeEquals);
+                    stack.pop();
+                    break;
+                }
+
+                case OpCode::logicalAnd:
+                case OpCode::logicalOr:
+                {
+                    auto& a = stack.top[-1];
+                    const bool value = a;
+
+                    if (value == (i.opCode == OpCode::logicalOr))
+                    {
+                        a = value;
+                        ip = instructions + i.operand;
+                    }
+                    else
+                    {
+                        stack.pop();
+                    }
+
+                    break;
+                }
+
+                case OpCode::toBool:
+                {
+                    auto& a = stack.top[-1];
+                    a = (bool) a;
+                    break;
+                }
+
+                case OpCode::jump:
+                    ip = instructions + i.operand;
+                    break;
+
+                case OpCode::jumpIfFalse:
+                case OpCode::jumpIfTrue:
+                {
+                    const bool condition = stack.top[-1];
+                    stack.pop();
+
+                    if (condition == (i.opCode == OpCode::jumpIfTrue))
+                        ip = instructions + i.operand;
+
+                    break;
+                }
+
+                case OpCode::checkTimeOut:
+                    if (auto* error = s.root.checkTimeOut())
+                        code.getLocation (i).throwError (error);
+
+                    break;
+
+                case OpCode::call:
+                {
+                    auto* args = stack.top - i.operand;
+                    auto result = s.callWithScopeAsThis (args[-1], args, i.operand, code, i);
+                    stack.pop (i.operand);
+                    stack.top[-1] = std::move (result);
+                    break;
+                }
+
+                case OpCode::findMethod:
+                {
+                    auto& ref = code.names[(size_t) i.operand];
+                    stack.push();
+
+                    if (! s.findFunctionCall (stack.top[-2], ref, stack.top[-1]))
+                        code.getLocation (i).throwError ("Unknown function '" + ref.name.toString() + "'");
+
+                    break;
+                }
+
+                case OpCode::callMethod:
+                {
+                    const auto numArgs = i.extra;
+                    auto* args = stack.top - numArgs;
+                    auto& function = args[-1];
+                    auto& thisObject = args[-2];
+                    var result;
+
+                    if (auto nativeFunction = function.isMethod() ? function.getNativeFunction() : var::NativeFunction())
+                    {
+                        result = nativeFunction (var::NativeFunctionArgs (thisObject, args, numArgs));
+                        s.root.nativeFunctionWasCalled();
+                    }
+                    else if (auto* fo = dynamic_cast<FunctionObject*> (function.getObject()))
+                    {
+                        result = fo->invoke (s, thisObject, nullptr, args, numArgs);
+                    }
+                    else
+                    {
+                        auto& name = code.names[(size_t) i.operand].name;
+                        auto* o = thisObject.getDynamicObject();
+
+                        // allow an overridden DynamicObject::invokeMethod to accept a method call
+                        if (o == nullptr || ! o->hasMethod (name))
+                            code.getLocation (i).throwError ("This expression is not a function!");
+
+                        result = o->invokeMethod (name, var::NativeFunctionArgs (thisObject, args, numArgs));
+                        s.root.nativeFunctionWasCalled();
+                    }
+
+                    stack.pop (numArgs + 1);
+                    stack.top[-1] = std::move (result);
+                    break;
+                }
+
+                case OpCode::beginNew:
+                {
+                    auto& classOrFunc = stack.top[-1];
+
+                    if (isFunction (classOrFunc))
+                    {
+                        var function (std::move (classOrFunc));
+                        classOrFunc = new DynamicObject();
+                        stack.push (std::move (function));
+                        break;
+                    }
+
+                    if (classOrFunc.getDynamicObject() != nullptr)
+                    {
+                        DynamicObject::Ptr newObject (new DynamicObject());
+                        newObject->setProperty (getPrototypeIdentifier(), classOrFunc);
+                        classOrFunc = newObject.get();
+                    }
+                    else
+                    {
+                        classOrFunc = var::undefined();
+                    }
+
+                    ip = instructions + i.operand;
+                    break;
+                }
+
+                case OpCode::construct:
+                {
+                    auto* args = stack.top - i.operand;
+
+                    if (auto* fo = dynamic_cast<FunctionObject*> (args[-1].getObject()))
+                        fo->invoke (s, args[-2], nullptr, args, i.operand);
+
+                    stack.pop (i.operand + 1);
+                    break;
+                }
+
+                case OpCode::createObject:
+                {
+                    DynamicObject::Ptr newObject (new DynamicObject());
+                    auto* values = stack.top - i.extra;
+
+                    for (int n = 0; n < i.extra; ++n)
+                        newObject->setProperty (code.names[(size_t) (i.operand + n)].name, values[n]);
+
+                    stack.pop (i.extra);
+                    stack.push (newObject.get());
+                    break;
+                }
+
+                case OpCode::createArray:
+                {
+                    Array<var> a;
+                    auto* values = stack.top - i.operand;
+
+                    for (int n = 0; n < i.operand; ++n)
+                        a.add (std::move (values[n]));
+
+                    stack.pop (i.operand);
+                    stack.push (std::move (a));
+                    break;
+                }
+
+                case OpCode::returnValue:   return std::move (stack.top[-1]);
+                case OpCode::returnVoid:    return {};
+
+                case OpCode::throwError:
+                    code.getLocation (i).throwError (code.constants.getReference (i.operand).toString());
+                    break;
+
+                default:
+                    jassertfalse;
+                    break;
+            }
+        }
+    }
+
+    //==============================================================================
+    struct Statement;
+    struct Expression;
+
+    // Turns the parsed statements and expressions into instructions
+    struct Compiler
+    {
+        Compiler (CompiledCode& c, bool isFunction) noexcept : code (c), isFunctionBody (isFunction) {}
+
+        static std::unique_ptr<CompiledCode> compileScript (const Statement& statements)
+        {
+            auto code = std::make_unique<CompiledCode> (statements.location.program);
+            Compiler compiler (*code, false);
+            statements.compile (compiler);
+            compiler.emit (OpCode::returnVoid, statements.location);
+            return code;
+        }
+
+        static std::unique_ptr<CompiledCode> compileExpression (const Expression& expression)
+        {
+            auto code = std::make_unique<CompiledCode> (expression.location.program);
+            Compiler compiler (*code, false);
+            expression.compileValue (compiler);
+            compiler.emit (OpCode::returnValue, expression.location);
+            return code;
+        }
+
+        static std::unique_ptr<CompiledCode> compileFunction (const Array<Identifier>& parameters,
+                                                             const Array<Identifier>& variableNames,
+                                                             const Statement& body)
+        {
+            auto code = std::make_unique<CompiledCode> (body.location.program);
+            code->variables.add (getThisIdentifier());
+
+            for (auto& p : parameters)
+            {
+                code->variables.addIfNotAlreadyThere (p);
+                code->parameterIndexes.add (code->variables.indexOf (p));
+            }
+
+            code->hasParameterCalledThis = code->parameterIndexes.contains (0);
+
+            for (auto& v : variableNames)
+                code->variables.addIfNotAlreadyThere (v);
+
+            Compiler compiler (*code, true);
+            body.compile (compiler);
+            compiler.emit (OpCode::returnVoid, body.location);
+            return code;
+        }
+
+        void emit (OpCode op, const CodeLocation& location, int operand = 0, int extra = 0)
+        {
+            code.instructions.push_back ({ op, operand, extra });
+            code.locations.push_back (location.location);
+            adjustStackSize (getStackSizeChange (op, operand, extra));
+        }
+
+        void emitError (const String& message, const CodeLocation& location)
+        {
+            emit (OpCode::throwError, location, addConstant (message));
+        }
+
+        int emitJump (OpCode op, const CodeLocation& location)
+        {
+            emit (op, location, -1);
+            return getPosition() - 1;
+        }
+
+        // A value that's assigned to a local variable and then discarded can be moved into it,
+        // unless something jumps to the instruction that would discard it
+        void emitPop (const CodeLocation& location)
+        {
+            if (getPosition() != lastJumpTarget && ! code.instructions.empty()
+                 && code.instructions.back().opCode == OpCode::storeLocal)
+            {
+                code.instructions.back().opCode = OpCode::moveToLocal;
+                adjustStackSize (-1);
+                return;
+            }
+
+            emit (OpCode::pop, location);
+        }
+
+        int getPosition() const noexcept                        { return (int) code.instructions.size(); }
+
+        void setJumpTarget (int jump, int target) noexcept
+        {
+            code.instructions[(size_t) jump].operand = target;
+            lastJumpTarget = jmax (lastJumpTarget, target);
+        }
+
+        void setJumpTarget (int jump) noexcept                  { setJumpTarget (jump, getPosition()); }
+
+        void setJumpTargets (const Array<int>& jumps, int target) noexcept
+        {
+            for (auto jump : jumps)
+                setJumpTarget (jump, target);
+        }
+
+        // This is also used after a jump, where the code that follows is reached with a different number of values
+        void adjustStackSize (int change) noexcept
+        {
+            stackSize += change;
+            jassert (stackSize >= 0);
+            code.maxStackSize = jmax (code.maxStackSize, stackSize);
+        }
+
+        int addConstant (const var& value)
+        {
+            code.constants.add (value);
+            return code.constants.size() - 1;
+        }
+
+        int addName (const Identifier& name)
+        {
+            code.names.push_back ({ name, -1, nullptr, -1 });
+            return (int) code.names.size() - 1;
+        }
+
+        // Returns the slot of one of the function's own variables, or -1 if the name isn't one
+        int getVariableIndex (const Identifier& name) const
+        {
+            return isFunctionBody ? code.variables.indexOf (name) : -1;
+        }
+
+        // The places that break, continue and return statements jump to. A loop's initialiser is also
+        // one of these, because any of those statements in it only end the initialiser.
+        struct JumpTargets
+        {
+            bool isLoop;
+            Array<int> breaks, continues;
+        };
+
+        void compileBreak (const CodeLocation& location)
+        {
+            if (auto* targets = jumpTargets.getLast())
+                targets->breaks.add (emitJump (OpCode::jump, location));
+            else
+                emit (OpCode::returnVoid, location);
+        }
+
+        void compileContinue (const CodeLocation& location)
         {
-            if (auto v = getPropertyPointer (*scope, name))
-                return *v;
-
-            return parent != nullptr ? parent->findSymbolInParentScopes (name)
-                                     : var::undefined();
+            if (auto* targets = jumpTargets.getLast())
+                (targets->isLoop ? targets->continues : targets->breaks).add (emitJump (OpCode::jump, location));
+            else
+                emit (OpCode::returnVoid, location);
         }
 
-        bool findAndInvokeMethod (const Identifier& function, const var::NativeFunctionArgs& args, var& result) const
+        void compileReturn (const Expression& value, const CodeLocation& location)
         {
-            auto* target = args.thisObject.getDynamicObject();
-
-            if (target == nullptr || target == scope.get())
+            for (int i = jumpTargets.size(); --i >= 0;)
             {
-                if (auto* m = getPropertyPointer (*scope, function))
+                if (! jumpTargets.getUnchecked (i)->isLoop)
                 {
-                    if (auto fo = dynamic_cast<FunctionObject*> (m->getObject()))
-                    {
-                        result = fo->invoke (*this, args);
-                        return true;
-                    }
+                    jumpTargets.getUnchecked (i)->breaks.add (emitJump (OpCode::jump, location));
+                    return;
                 }
             }
 
-            const auto& props = scope->getProperties();
-
-            for (int i = 0; i < props.size(); ++i)
-                if (auto* o = props.getValueAt (i).getDynamicObject())
-                    if (Scope (this, *root, *o).findAndInvokeMethod (function, args, result))
-                        return true;
-
-            return false;
+            // a script's return value is ignored, so it isn't evaluated
+            if (isFunctionBody)
+            {
+                value.compileValue (*this);
+                emit (OpCode::returnValue, location);
+            }
+            else
+            {
+                emit (OpCode::returnVoid, location);
+            }
         }
 
-        bool invokeMethod (const var& m, const var::NativeFunctionArgs& args, var& result) const
+        static int getStackSizeChange (OpCode op, int operand, int extra) noexcept
         {
-            if (isFunction (m))
+            switch (op)
             {
-                auto* target = args.thisObject.getDynamicObject();
-
-                if (target == nullptr || target == scope.get())
-                {
-                    if (auto fo = dynamic_cast<FunctionObject*> (m.getObject()))
-                    {
-                        result = fo->invoke (*this, args);
-                        return true;
-                    }
-                }
+                case OpCode::pushConstant:
+                case OpCode::pushUndefined:
+                case OpCode::loadName:
+                case OpCode::loadThis:
+                case OpCode::loadLocal:
+                case OpCode::getLocalMember:
+                case OpCode::findMethod:
+                case OpCode::beginNew:
+                    return 1;
+
+                case OpCode::pop:
+                case OpCode::declareName:
+                case OpCode::declareLocal:
+                case OpCode::moveToLocal:
+                case OpCode::setMember:
+                case OpCode::getIndex:
+                case OpCode::logicalAnd:
+                case OpCode::logicalOr:
+                case OpCode::jumpIfFalse:
+                case OpCode::jumpIfTrue:
+                case OpCode::returnValue:
+                    return -1;
+
+                case OpCode::setIndex:      return -2;
+                case OpCode::call:          return -operand;
+                case OpCode::callMethod:    return -(extra + 1);
+                case OpCode::construct:     return -(operand + 1);
+                case OpCode::createObject:  return 1 - extra;
+                case OpCode::createArray:   return 1 - operand;
+
+                case OpCode::storeName:
+                case OpCode::storeLocal:
+                case OpCode::getMember:
+                case OpCode::getLength:
+                case OpCode::toBool:
+                case OpCode::jump:
+                case OpCode::checkTimeOut:
+                case OpCode::returnVoid:
+                case OpCode::throwError:
+                    return 0;
+
+                // binary operators pop one value less when their right-hand side is a constant
+                case OpCode::equals:
+                case OpCode::notEquals:
+                case OpCode::lessThan:
+                case OpCode::lessThanOrEqual:
+                case OpCode::greaterThan:
+                case OpCode::greaterThanOrEqual:
+                case OpCode::add:
+                case OpCode::subtract:
+                case OpCode::multiply:
+                case OpCode::divide:
+                case OpCode::modulo:
+                case OpCode::bitwiseOr:
+                case OpCode::bitwiseAnd:
+                case OpCode::bitwiseXor:
+                case OpCode::leftShift:
+                case OpCode::rightShift:
+                case OpCode::rightShiftUnsigned:
+                case OpCode::typeEquals:
+                case OpCode::typeNotEquals:
+                    return operand > 0 ? 0 : -1;
             }
 
-            return false;
-        }
-
-        void checkTimeOut (const CodeLocation& location) const
-        {
-            if (Time::getCurrentTime() > root->timeout)
-                location.throwError (root->timeout == Time() ? "Interrupted" : "Execution timed-out");
+            jassertfalse;
+            return 0;
         }
 
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Scope)
+        CompiledCode& code;
+        const bool isFunctionBody;
+        Array<JumpTargets*> jumpTargets;
+        int stackSize = 0, lastJumpTarget = -1;
     };
 
     //==============================================================================
@@ -247,8 +1509,7 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         Statement (const CodeLocation& l) noexcept : location (l) {}
         virtual ~Statement() = default;
 
-        enum ResultCode  { ok = 0, returnWasHit, breakWasHit, continueWasHit };
-        virtual ResultCode perform (const Scope&, var*) const  { return ok; }
+        virtual void compile (Compiler&) const {}
 
         CodeLocation location;
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Statement)
@@ -258,10 +1519,17 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         Expression (const CodeLocation& l) noexcept : Statement (l) {}
 
-        virtual var getResult (const Scope&) const            { return var::undefined(); }
-        virtual void assign (const Scope&, const var&) const  { location.throwError ("Cannot assign to this expression!"); }
+        // Leaves the expression's value on the stack
+        virtual void compileValue (Compiler& c) const       { c.emit (OpCode::pushUndefined, location); }
 
-        ResultCode perform (const Scope& s, var*) const override  { getResult (s); return ok; }
+        // Assigns the value on the stack to the expression, leaving the value there
+        virtual void compileAssignment (Compiler& c) const  { c.emitError ("Cannot assign to this expression!", location); }
+
+        void compile (Compiler& c) const override
+        {
+            compileValue (c);
+            c.emitPop (location);
+        }
     };
 
     using ExpPtr = std::unique_ptr<Expression>;
@@ -270,13 +1538,10 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         BlockStatement (const CodeLocation& l) noexcept : Statement (l) {}
 
-        ResultCode perform (const Scope& s, var* returnedValue) const override
+        void compile (Compiler& c) const override
         {
             for (auto* statement : statements)
-                if (auto r = statement->perform (s, returnedValue))
-                    return r;
-
-            return ok;
+                statement->compile (c);
         }
 
         OwnedArray<Statement> statements;
@@ -286,9 +1551,15 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         IfStatement (const CodeLocation& l) noexcept : Statement (l) {}
 
-        ResultCode perform (const Scope& s, var* returnedValue) const override
+        void compile (Compiler& c) const override
         {
-            return (condition->getResult (s) ? trueBranch : falseBranch)->perform (s, returnedValue);
+            condition->compileValue (c);
+            auto jumpToFalseBranch = c.emitJump (OpCode::jumpIfFalse, location);
+            trueBranch->compile (c);
+            auto jumpToEnd = c.emitJump (OpCode::jump, location);
+            c.setJumpTarget (jumpToFalseBranch);
+            falseBranch->compile (c);
+            c.setJumpTarget (jumpToEnd);
         }
 
         ExpPtr condition;
@@ -299,10 +1570,15 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         VarStatement (const CodeLocation& l) noexcept : Statement (l) {}
 
-        ResultCode perform (const Scope& s, var*) const override
+        void compile (Compiler& c) const override
         {
-            s.scope->setProperty (name, initialiser->getResult (s));
-            return ok;
+            initialiser->compileValue (c);
+            auto index = c.getVariableIndex (name);
+
+            if (index >= 0)
+                c.emit (OpCode::declareLocal, location, index);
+            else
+                c.emit (OpCode::declareName, location, c.addName (name));
         }
 
         Identifier name;
@@ -313,25 +1589,48 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         LoopStatement (const CodeLocation& l, bool isDo) noexcept : Statement (l), isDoLoop (isDo) {}
 
-        ResultCode perform (const Scope& s, var* returnedValue) const override
+        void compile (Compiler& c) const override
         {
-            initialiser->perform (s, nullptr);
+            Compiler::JumpTargets initialiserTargets { false, {}, {} };
+            c.jumpTargets.add (&initialiserTargets);
+            initialiser->compile (c);
+            c.jumpTargets.removeLast();
+            c.setJumpTargets (initialiserTargets.breaks, c.getPosition());
 
-            while (isDoLoop || condition->getResult (s))
-            {
-                s.checkTimeOut (location);
-                auto r = body->perform (s, returnedValue);
-
-                if (r == returnWasHit)   return r;
-                if (r == breakWasHit)    break;
+            Compiler::JumpTargets loopTargets { true, {}, {} };
+            c.jumpTargets.add (&loopTargets);
 
-                iterator->perform (s, nullptr);
-
-                if (isDoLoop && r != continueWasHit && ! condition->getResult (s))
-                    break;
+            if (isDoLoop)
+            {
+                // a continue statement skips the condition
+                auto top = c.getPosition();
+                c.emit (OpCode::checkTimeOut, location);
+                body->compile (c);
+                iterator->compile (c);
+                condition->compileValue (c);
+                c.setJumpTarget (c.emitJump (OpCode::jumpIfTrue, location), top);
+                auto jumpToEnd = c.emitJump (OpCode::jump, location);
+                c.setJumpTargets (loopTargets.continues, c.getPosition());
+                iterator->compile (c);
+                c.setJumpTarget (c.emitJump (OpCode::jump, location), top);
+                c.setJumpTarget (jumpToEnd);
+            }
+            else
+            {
+                // the condition goes after the body, so that each iteration only needs one jump
+                auto jumpToCondition = c.emitJump (OpCode::jump, location);
+                auto top = c.getPosition();
+                c.emit (OpCode::checkTimeOut, location);
+                body->compile (c);
+                c.setJumpTargets (loopTargets.continues, c.getPosition());
+                iterator->compile (c);
+                c.setJumpTarget (jumpToCondition);
+                condition->compileValue (c);
+                c.setJumpTarget (c.emitJump (OpCode::jumpIfTrue, location), top);
             }
 
-            return ok;
+            c.jumpTargets.removeLast();
+            c.setJumpTargets (loopTargets.breaks, c.getPosition());
         }
 
         std::unique_ptr<Statement> initialiser, iterator, body;
@@ -343,11 +1642,7 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         ReturnStatement (const CodeLocation& l, Expression* v) noexcept : Statement (l), returnValue (v) {}
 
-        ResultCode perform (const Scope& s, var* ret) const override
-        {
-            if (ret != nullptr)  *ret = returnValue->getResult (s);
-            return returnWasHit;
-        }
+        void compile (Compiler& c) const override   { c.compileReturn (*returnValue, location); }
 
         ExpPtr returnValue;
     };
@@ -355,19 +1650,19 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     struct BreakStatement final : public Statement
     {
         BreakStatement (const CodeLocation& l) noexcept : Statement (l) {}
-        ResultCode perform (const Scope&, var*) const override  { return breakWasHit; }
+        void compile (Compiler& c) const override   { c.compileBreak (location); }
     };
 
     struct ContinueStatement final : public Statement
     {
         ContinueStatement (const CodeLocation& l) noexcept : Statement (l) {}
-        ResultCode perform (const Scope&, var*) const override  { return continueWasHit; }
+        void compile (Compiler& c) const override   { c.compileContinue (location); }
     };
 
     struct LiteralValue final : public Expression
     {
         LiteralValue (const CodeLocation& l, const var& v) noexcept : Expression (l), value (v) {}
-        var getResult (const Scope&) const override   { return value; }
+        void compileValue (Compiler& c) const override  { c.emit (OpCode::pushConstant, location, c.addConstant (value)); }
         var value;
     };
 
@@ -375,14 +1670,21 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         UnqualifiedName (const CodeLocation& l, const Identifier& n) noexcept : Expression (l), name (n) {}
 
-        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name); }
+        void compileValue (Compiler& c) const override
+        {
+            auto index = c.getVariableIndex (name);
+
+            if (index == 0)     c.emit (OpCode::loadThis,  location, 0, c.addName (name));
+            else if (index > 0) c.emit (OpCode::loadLocal, location, index, c.addName (name));
+            else                c.emit (OpCode::loadName,  location, c.addName (name));
+        }
 
-        void assign (const Scope& s, const var& newValue) const override
+        void compileAssignment (Compiler& c) const override
         {
-            if (auto* v = getPropertyPointer (*s.scope, name))
-                *v = newValue;
-            else
-                s.root->setProperty (name, newValue);
+            auto index = c.getVariableIndex (name);
+
+            if (index >= 0)     c.emit (OpCode::storeLocal, location, index, c.addName (name));
+            else                c.emit (OpCode::storeName,  location, c.addName (name));
         }
 
         Identifier name;
@@ -392,30 +1694,38 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         DotOperator (const CodeLocation& l, ExpPtr& p, const Identifier& c) noexcept : Expression (l), parent (p.release()), child (c) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            auto p = parent->getResult (s);
             static const Identifier lengthID ("length");
 
             if (child == lengthID)
             {
-                if (auto* array = p.getArray())   return array->size();
-                if (p.isString())                 return p.toString().length();
+                parent->compileValue (c);
+                c.emit (OpCode::getLength, location, c.addName (child));
+                return;
             }
 
-            if (auto* o = p.getDynamicObject())
-                if (auto* v = getPropertyPointer (*o, child))
-                    return *v;
+            if (auto* variable = dynamic_cast<UnqualifiedName*> (parent.get()))
+            {
+                auto index = c.getVariableIndex (variable->name);
 
-            return var::undefined();
+                if (index >= 0)
+                {
+                    auto name = c.addName (child);
+                    c.addName (variable->name);
+                    c.emit (OpCode::getLocalMember, location, index, name);
+                    return;
+                }
+            }
+
+            parent->compileValue (c);
+            c.emit (OpCode::getMember, location, c.addName (child));
         }
 
-        void assign (const Scope& s, const var& newValue) const override
+        void compileAssignment (Compiler& c) const override
         {
-            if (auto* o = parent->getResult (s).getDynamicObject())
-                o->setProperty (child, newValue);
-            else
-                Expression::assign (s, newValue);
+            parent->compileValue (c);
+            c.emit (OpCode::setMember, location, c.addName (child));
         }
 
         ExpPtr parent;
@@ -426,51 +1736,18 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         ArraySubscript (const CodeLocation& l) noexcept : Expression (l) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            auto arrayVar = object->getResult (s); // must stay alive for the scope of this method
-            auto key = index->getResult (s);
-
-            if (const auto* array = arrayVar.getArray())
-                if (key.isInt() || key.isInt64() || key.isDouble())
-                    return (*array) [static_cast<int> (key)];
-
-            if (auto* o = arrayVar.getDynamicObject())
-                if (key.isString())
-                    if (auto* v = getPropertyPointer (*o, Identifier (key)))
-                        return *v;
-
-            return var::undefined();
+            object->compileValue (c);
+            index->compileValue (c);
+            c.emit (OpCode::getIndex, location);
         }
 
-        void assign (const Scope& s, const var& newValue) const override
+        void compileAssignment (Compiler& c) const override
         {
-            auto arrayVar = object->getResult (s); // must stay alive for the scope of this method
-            auto key = index->getResult (s);
-
-            if (auto* array = arrayVar.getArray())
-            {
-                if (key.isInt() || key.isInt64() || key.isDouble())
-                {
-                    const int i = key;
-                    while (array->size() < i)
-                        array->add (var::undefined());
-
-                    array->set (i, newValue);
-                    return;
-                }
-            }
-
-            if (auto* o = arrayVar.getDynamicObject())
-            {
-                if (key.isString())
-                {
-                    o->setProperty (Identifier (key), newValue);
-                    return;
-                }
-            }
-
-            Expression::assign (s, newValue);
+            object->compileValue (c);
+            index->compileValue (c);
+            c.emit (OpCode::setIndex, location);
         }
 
         ExpPtr object, index;
@@ -481,195 +1758,120 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         BinaryOperatorBase (const CodeLocation& l, ExpPtr& a, ExpPtr& b, TokenType op) noexcept
             : Expression (l), lhs (a.release()), rhs (b.release()), operation (op) {}
 
+        void compileOperands (Compiler& c) const
+        {
+            lhs->compileValue (c);
+            rhs->compileValue (c);
+        }
+
         ExpPtr lhs, rhs;
         TokenType operation;
     };
 
-    struct BinaryOperator : public BinaryOperatorBase
+    template <typename Operation>
+    struct BinaryOperator final : public BinaryOperatorBase
     {
-        BinaryOperator (const CodeLocation& l, ExpPtr& a, ExpPtr& b, TokenType op) noexcept
-            : BinaryOperatorBase (l, a, b, op) {}
+        BinaryOperator (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept
+            : BinaryOperatorBase (l, a, b, Operation::getToken()) {}
 
-        virtual var getWithUndefinedArg() const                           { return var::undefined(); }
-        virtual var getWithDoubles (double, double) const                 { return throwError ("Double"); }
-        virtual var getWithInts (int64, int64) const                      { return throwError ("Integer"); }
-        virtual var getWithArrayOrObject (const var& a, const var&) const { return throwError (a.isArray() ? "Array" : "Object"); }
-        virtual var getWithStrings (const String&, const String&) const   { return throwError ("String"); }
-
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            var a (lhs->getResult (s)), b (rhs->getResult (s));
-
-            if ((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid()))
-                return getWithUndefinedArg();
-
-            if (isNumericOrUndefined (a) && isNumericOrUndefined (b))
-                return (a.isDouble() || b.isDouble()) ? getWithDoubles (a, b) : getWithInts (a, b);
-
-            if (a.isArray() || a.isObject())
-                return getWithArrayOrObject (a, b);
+            if (auto* constant = dynamic_cast<LiteralValue*> (rhs.get()))
+            {
+                lhs->compileValue (c);
+                c.emit (Operation::opCode, location, c.addConstant (constant->value) + 1);
+                return;
+            }
 
-            return getWithStrings (a.toString(), b.toString());
+            compileOperands (c);
+            c.emit (Operation::opCode, location);
         }
-
-        var throwError (const char* typeName) const
-            { location.throwError (getTokenName (operation) + " is not allowed on the " + typeName + " type"); return {}; }
-    };
-
-    struct EqualsOp final : public BinaryOperator
-    {
-        EqualsOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::equals) {}
-        var getWithUndefinedArg() const override                               { return true; }
-        var getWithDoubles (double a, double b) const override                 { return exactlyEqual (a, b); }
-        var getWithInts (int64 a, int64 b) const override                      { return a == b; }
-        var getWithStrings (const String& a, const String& b) const override   { return a == b; }
-        var getWithArrayOrObject (const var& a, const var& b) const override   { return a == b; }
-    };
-
-    struct NotEqualsOp final : public BinaryOperator
-    {
-        NotEqualsOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::notEquals) {}
-        var getWithUndefinedArg() const override                               { return false; }
-        var getWithDoubles (double a, double b) const override                 { return ! exactlyEqual (a, b); }
-        var getWithInts (int64 a, int64 b) const override                      { return a != b; }
-        var getWithStrings (const String& a, const String& b) const override   { return a != b; }
-        var getWithArrayOrObject (const var& a, const var& b) const override   { return a != b; }
-    };
-
-    struct LessThanOp final : public BinaryOperator
-    {
-        LessThanOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::lessThan) {}
-        var getWithDoubles (double a, double b) const override                 { return a < b; }
-        var getWithInts (int64 a, int64 b) const override                      { return a < b; }
-        var getWithStrings (const String& a, const String& b) const override   { return a < b; }
-    };
-
-    struct LessThanOrEqualOp final : public BinaryOperator
-    {
-        LessThanOrEqualOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::lessThanOrEqual) {}
-        var getWithDoubles (double a, double b) const override                 { return a <= b; }
-        var getWithInts (int64 a, int64 b) const override                      { return a <= b; }
-        var getWithStrings (const String& a, const String& b) const override   { return a <= b; }
-    };
-
-    struct GreaterThanOp final : public BinaryOperator
-    {
-        GreaterThanOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::greaterThan) {}
-        var getWithDoubles (double a, double b) const override                 { return a > b; }
-        var getWithInts (int64 a, int64 b) const override                      { return a > b; }
-        var getWithStrings (const String& a, const String& b) const override   { return a > b; }
-    };
-
-    struct GreaterThanOrEqualOp final : public BinaryOperator
-    {
-        GreaterThanOrEqualOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::greaterThanOrEqual) {}
-        var getWithDoubles (double a, double b) const override                 { return a >= b; }
-        var getWithInts (int64 a, int64 b) const override                      { return a >= b; }
-        var getWithStrings (const String& a, const String& b) const override   { return a >= b; }
-    };
-
-    struct AdditionOp final : public BinaryOperator
-    {
-        AdditionOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::plus) {}
-        var getWithDoubles (double a, double b) const override                 { return a + b; }
-        var getWithInts (int64 a, int64 b) const override                      { return a + b; }
-        var getWithStrings (const String& a, const String& b) const override   { return a + b; }
-    };
-
-    struct SubtractionOp final : public BinaryOperator
-    {
-        SubtractionOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::minus) {}
-        var getWithDoubles (double a, double b) const override { return a - b; }
-        var getWithInts (int64 a, int64 b) const override      { return a - b; }
-    };
-
-    struct MultiplyOp final : public BinaryOperator
-    {
-        MultiplyOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::times) {}
-        var getWithDoubles (double a, double b) const override { return a * b; }
-        var getWithInts (int64 a, int64 b) const override      { return a * b; }
     };
 
-    struct DivideOp final : public BinaryOperator
-    {
-        DivideOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::divide) {}
-        var getWithDoubles (double a, double b) const override  { return exactlyEqual (b, 0.0) ? std::numeric_limits<double>::infinity() : a / b; }
-        var getWithInts (int64 a, int64 b) const override       { return b != 0 ? var ((double) a / (double) b) : var (std::numeric_limits<double>::infinity()); }
-    };
-
-    struct ModuloOp final : public BinaryOperator
-    {
-        ModuloOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::modulo) {}
-        var getWithDoubles (double a, double b) const override  { return exactlyEqual (b, 0.0) ? std::numeric_limits<double>::infinity() : fmod (a, b); }
-        var getWithInts (int64 a, int64 b) const override       { return b != 0 ? var (a % b) : var (std::numeric_limits<double>::infinity()); }
-    };
-
-    struct BitwiseOrOp final : public BinaryOperator
-    {
-        BitwiseOrOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::bitwiseOr) {}
-        var getWithInts (int64 a, int64 b) const override   { return a | b; }
-    };
-
-    struct BitwiseAndOp final : public BinaryOperator
-    {
-        BitwiseAndOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::bitwiseAnd) {}
-        var getWithInts (int64 a, int64 b) const override   { return a & b; }
-    };
-
-    struct BitwiseXorOp final : public BinaryOperator
-    {
-        BitwiseXorOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::bitwiseXor) {}
-        var getWithInts (int64 a, int64 b) const override   { return a ^ b; }
-    };
-
-    struct LeftShiftOp final : public BinaryOperator
-    {
-        LeftShiftOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::leftShift) {}
-        var getWithInts (int64 a, int64 b) const override   { return ((int) a) << (int) b; }
-    };
-
-    struct RightShiftOp final : public BinaryOperator
-    {
-        RightShiftOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::rightShift) {}
-        var getWithInts (int64 a, int64 b) const override   { return ((int) a) >> (int) b; }
-    };
-
-    struct RightShiftUnsignedOp final : public BinaryOperator
-    {
-        RightShiftUnsignedOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator (l, a, b, TokenTypes::rightShiftUnsigned) {}
-        var getWithInts (int64 a, int64 b) const override   { return (int) (((uint32) a) >> (int) b); }
-    };
+    using EqualsOp              = BinaryOperator<Equals>;
+    using NotEqualsOp           = BinaryOperator<NotEquals>;
+    using LessThanOp            = BinaryOperator<LessThan>;
+    using LessThanOrEqualOp     = BinaryOperator<LessThanOrEqual>;
+    using GreaterThanOp         = BinaryOperator<GreaterThan>;
+    using GreaterThanOrEqualOp  = BinaryOperator<GreaterThanOrEqual>;
+    using AdditionOp            = BinaryOperator<Addition>;
+    using SubtractionOp         = BinaryOperator<Subtraction>;
+    using MultiplyOp            = BinaryOperator<Multiply>;
+    using DivideOp              = BinaryOperator<Divide>;
+    using ModuloOp              = BinaryOperator<Modulo>;
+    using BitwiseOrOp           = BinaryOperator<BitwiseOr>;
+    using BitwiseAndOp          = BinaryOperator<BitwiseAnd>;
+    using BitwiseXorOp          = BinaryOperator<BitwiseXor>;
+    using LeftShiftOp           = BinaryOperator<LeftShift>;
+    using RightShiftOp          = BinaryOperator<RightShift>;
+    using RightShiftUnsignedOp  = BinaryOperator<RightShiftUnsigned>;
 
     struct LogicalAndOp final : public BinaryOperatorBase
     {
         LogicalAndOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::logicalAnd) {}
-        var getResult (const Scope& s) const override       { return lhs->getResult (s) && rhs->getResult (s); }
+
+        void compileValue (Compiler& c) const override
+        {
+            lhs->compileValue (c);
+            auto jumpToEnd = c.emitJump (OpCode::logicalAnd, location);
+            rhs->compileValue (c);
+            c.emit (OpCode::toBool, location);
+            c.setJumpTarget (jumpToEnd);
+        }
     };
 
     struct LogicalOrOp final : public BinaryOperatorBase
     {
         LogicalOrOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::logicalOr) {}
-        var getResult (const Scope& s) const override       { return lhs->getResult (s) || rhs->getResult (s); }
+
+        void compileValue (Compiler& c) const override
+        {
+            lhs->compileValue (c);
+            auto jumpToEnd = c.emitJump (OpCode::logicalOr, location);
+            rhs->compileValue (c);
+            c.emit (OpCode::toBool, location);
+            c.setJumpTarget (jumpToEnd);
+        }
     };
 
     struct TypeEqualsOp final : public BinaryOperatorBase
     {
         TypeEqualsOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::typeEquals) {}
-        var getResult (const Scope& s) const override       { return areTypeEqual (lhs->getResult (s), rhs->getResult (s)); }
+        void compileValue (Compiler& c) const override      { compileOperands (c); c.emit (OpCode::typeEquals, location); }
     };
 
     struct TypeNotEqualsOp final : public BinaryOperatorBase
     {
         TypeNotEqualsOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::typeNotEquals) {}
-        var getResult (const Scope& s) const override       { return ! areTypeEqual (lhs->getResult (s), rhs->getResult (s)); }
+        void compileValue (Compiler& c) const override      { compileOperands (c); c.emit (OpCode::typeNotEquals, location); }
     };
 
     struct ConditionalOp final : public Expression
     {
         ConditionalOp (const CodeLocation& l) noexcept : Expression (l) {}
 
-        var getResult (const Scope& s) const override              { return (condition->getResult (s) ? trueBranch : falseBranch)->getResult (s); }
-        void assign (const Scope& s, const var& v) const override  { (condition->getResult (s) ? trueBranch : falseBranch)->assign (s, v); }
+        void compileValue (Compiler& c) const override
+        {
+            condition->compileValue (c);
+            auto jumpToFalseBranch = c.emitJump (OpCode::jumpIfFalse, location);
+            trueBranch->compileValue (c);
+            auto jumpToEnd = c.emitJump (OpCode::jump, location);
+            c.adjustStackSize (-1);
+            c.setJumpTarget (jumpToFalseBranch);
+            falseBranch->compileValue (c);
+            c.setJumpTarget (jumpToEnd);
+        }
+
+        void compileAssignment (Compiler& c) const override
+        {
+            condition->compileValue (c);
+            auto jumpToFalseBranch = c.emitJump (OpCode::jumpIfFalse, location);
+            trueBranch->compileAssignment (c);
+            auto jumpToEnd = c.emitJump (OpCode::jump, location);
+            c.setJumpTarget (jumpToFalseBranch);
+            falseBranch->compileAssignment (c);
+            c.setJumpTarget (jumpToEnd);
+        }
 
         ExpPtr condition, trueBranch, falseBranch;
     };
@@ -678,11 +1880,10 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         Assignment (const CodeLocation& l, ExpPtr& dest, ExpPtr& source) noexcept : Expression (l), target (dest.release()), newValue (source.release()) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            auto value = newValue->getResult (s);
-            target->assign (s, value);
-            return value;
+            newValue->compileValue (c);
+            target->compileAssignment (c);
         }
 
         ExpPtr target, newValue;
@@ -693,11 +1894,10 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         SelfAssignment (const CodeLocation& l, Expression* dest, Expression* source) noexcept
             : Expression (l), target (dest), newValue (source) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            auto value = newValue->getResult (s);
-            target->assign (s, value);
-            return value;
+            newValue->compileValue (c);
+            target->compileAssignment (c);
         }
 
         Expression* target; // Careful! this pointer aliases a sub-term of newValue!
@@ -709,11 +1909,25 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         PostAssignment (const CodeLocation& l, Expression* dest, Expression* source) noexcept : SelfAssignment (l, dest, source) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
+        {
+            target->compileValue (c);
+            newValue->compileValue (c);
+            target->compileAssignment (c);
+            c.emitPop (location);
+        }
+
+        // When the old value isn't needed, a variable doesn't need reading first
+        void compile (Compiler& c) const override
         {
-            auto oldValue = target->getResult (s);
-            target->assign (s, newValue->getResult (s));
-            return oldValue;
+            if (dynamic_cast<UnqualifiedName*> (target) == nullptr)
+            {
+                Expression::compile (c);
+                return;
+            }
+
+            SelfAssignment::compileValue (c);
+            c.emitPop (location);
         }
     };
 
@@ -721,43 +1935,34 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         FunctionCall (const CodeLocation& l) noexcept : Expression (l) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            if (auto* dot = dynamic_cast<DotOperator*> (object.get()))
+            if (auto* dot = dotOperator)
             {
-                auto thisObject = dot->parent->getResult (s);
-                return invokeFunction (s, s.findFunctionCall (location, thisObject, dot->child), thisObject);
+                dot->parent->compileValue (c);
+                auto name = c.addName (dot->child);
+                c.emit (OpCode::findMethod, location, name);
+                compileArguments (c);
+                c.emit (OpCode::callMethod, location, name, arguments.size());
+            }
+            else
+            {
+                object->compileValue (c);
+                compileArguments (c);
+                c.emit (OpCode::call, location, arguments.size());
             }
-
-            auto function = object->getResult (s);
-            return invokeFunction (s, function, var (s.scope.get()));
         }
 
-        var invokeFunction (const Scope& s, const var& function, const var& thisObject) const
+        void compileArguments (Compiler& c) const
         {
-            s.checkTimeOut (location);
-            Array<var> argVars;
-
-            for (auto* a : arguments)
-                argVars.add (a->getResult (s));
-
-            const var::NativeFunctionArgs args (thisObject, argVars.begin(), argVars.size());
-
-            if (var::NativeFunction nativeFunction = function.getNativeFunction())
-                return nativeFunction (args);
-
-            if (auto* fo = dynamic_cast<FunctionObject*> (function.getObject()))
-                return fo->invoke (s, args);
-
-            if (auto* dot = dynamic_cast<DotOperator*> (object.get()))
-                if (auto* o = thisObject.getDynamicObject())
-                    if (o->hasMethod (dot->child)) // allow an overridden DynamicObject::invokeMethod to accept a method call.
-                        return o->invokeMethod (dot->child, args);
+            c.emit (OpCode::checkTimeOut, location);
 
-            location.throwError ("This expression is not a function!"); return {};
+            for (auto* argument : arguments)
+                argument->compileValue (c);
         }
 
         ExpPtr object;
+        const DotOperator* dotOperator = nullptr; // the object as a DotOperator, if it is one
         OwnedArray<Expression> arguments;
     };
 
@@ -765,22 +1970,13 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         NewOperator (const CodeLocation& l) noexcept : FunctionCall (l) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            var classOrFunc = object->getResult (s);
-            const bool isFunc = isFunction (classOrFunc);
-
-            if (! (isFunc || classOrFunc.getDynamicObject() != nullptr))
-                return var::undefined();
-
-            DynamicObject::Ptr newObject (new DynamicObject());
-
-            if (isFunc)
-                invokeFunction (s, classOrFunc, newObject.get());
-            else
-                newObject->setProperty (getPrototypeIdentifier(), classOrFunc);
-
-            return newObject.get();
+            object->compileValue (c);
+            auto jumpToEnd = c.emitJump (OpCode::beginNew, location);
+            compileArguments (c);
+            c.emit (OpCode::construct, location, arguments.size());
+            c.setJumpTarget (jumpToEnd);
         }
     };
 
@@ -788,14 +1984,17 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         ObjectDeclaration (const CodeLocation& l) noexcept : Expression (l) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            DynamicObject::Ptr newObject (new DynamicObject());
+            for (auto* initialiser : initialisers)
+                initialiser->compileValue (c);
+
+            const auto firstName = (int) c.code.names.size();
 
-            for (int i = 0; i < names.size(); ++i)
-                newObject->setProperty (names.getUnchecked (i), initialisers.getUnchecked (i)->getResult (s));
+            for (auto& name : names)
+                c.addName (name);
 
-            return newObject.get();
+            c.emit (OpCode::createObject, location, firstName, names.size());
         }
 
         Array<Identifier> names;
@@ -806,17 +2005,12 @@ struct JavascriptEngine::RootObject final : public DynamicObject
     {
         ArrayDeclaration (const CodeLocation& l) noexcept : Expression (l) {}
 
-        var getResult (const Scope& s) const override
+        void compileValue (Compiler& c) const override
         {
-            Array<var> a;
+            for (auto* value : values)
+                value->compileValue (c);
 
-            for (int i = 0; i < values.size(); ++i)
-                a.add (values.getUnchecked (i)->getResult (s));
-
-            // std::move() needed here for older compilers
-            JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wredundant-move")
-            return std::move (a);
-            JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+            c.emit (OpCode::createArray, location, values.size());
         }
 
         OwnedArray<Expression> values;
@@ -840,25 +2034,67 @@ struct JavascriptEngine::RootObject final : public DynamicObject
             out << "function " << functionCode;
         }
 
-        var invoke (const Scope& s, const var::NativeFunctionArgs& args) const
+        var invoke (Scope& s, const var::NativeFunctionArgs& args) const
         {
-            DynamicObject::Ptr functionRoot (new DynamicObject());
-
-            static const Identifier thisIdent ("this");
-            functionRoot->setProperty (thisIdent, args.thisObject);
-
-            for (int i = 0; i < parameters.size(); ++i)
-                functionRoot->setProperty (parameters.getReference (i),
-                                           i < args.numArguments ? args.arguments[i] : var::undefined());
+            return invokeWithArguments (s, args.thisObject, nullptr, args.numArguments,
+                           [&] (int i) -> const var& { return args.arguments[i]; });
+        }
 
-            var result;
-            body->perform (Scope (&s, s.root, functionRoot), &result);
-            return result;
+        // The arguments are on the caller's stack, so they can be moved rather than copied. If
+        // thisScope isn't null, 'this' is that scope's object, which is only created if it's needed.
+        var invoke (Scope& s, const var& thisObject, Scope* thisScope, var* args, int numArgs) const
+        {
+            return invokeWithArguments (s, thisObject, thisScope, numArgs,
+                           [args] (int i) -> var&& { return std::move (args[i]); });
         }
 
         String functionCode;
-        Array<Identifier> parameters;
-        std::unique_ptr<Statement> body;
+        std::unique_ptr<CompiledCode> code;
+
+    private:
+        template <typename GetArgument>
+        var invokeWithArguments (Scope& s, const var& thisObject, Scope* thisScope, int numArgs, GetArgument&& getArgument) const
+        {
+            const auto& c = *code;
+            VariableArray variables (c.variables.size());
+            int numDefined = 0;
+
+            const auto setVariable = [&] (int index, auto&& value)
+            {
+                auto& v = variables.data[index];
+
+                if (v.definitionIndex < 0)
+                {
+                    v.value = std::forward<decltype (value)> (value);
+                    v.definitionIndex = numDefined++;
+                }
+                else if (! v.value.equalsWithSameType (value))
+                {
+                    v.value = std::forward<decltype (value)> (value);
+                }
+            };
+
+            if (thisScope != nullptr && c.hasParameterCalledThis)
+            {
+                setVariable (0, var (&thisScope->getScopeObject()));
+                thisScope = nullptr;
+            }
+            else
+            {
+                setVariable (0, thisObject);
+            }
+
+            for (int i = 0; i < c.parameterIndexes.size(); ++i)
+            {
+                if (i < numArgs)
+                    setVariable (c.parameterIndexes.getUnchecked (i), getArgument (i));
+                else
+                    setVariable (c.parameterIndexes.getUnchecked (i), var::undefined());
+            }
+
+            Scope scope (&s, s.root, c, variables.data, numDefined, thisScope);
+            return run (scope, c);
+        }
     };
 
     //==============================================================================
@@ -1073,19 +2309,25 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         void parseFunctionParamsAndBody (FunctionObject& fo)
         {
             match (TokenTypes::openParen);
+            Array<Identifier> parameters, variableNames;
 
             while (currentType != TokenTypes::closeParen)
             {
                 auto paramName = currentValue.toString();
                 match (TokenTypes::identifier);
-                fo.parameters.add (paramName);
+                parameters.add (paramName);
 
                 if (currentType != TokenTypes::closeParen)
                     match (TokenTypes::comma);
             }
 
             match (TokenTypes::closeParen);
-            fo.body.reset (parseBlock());
+
+            auto* enclosingFunctionVariables = std::exchange (functionVariables, &variableNames);
+            std::unique_ptr<Statement> body (parseBlock());
+            functionVariables = enclosingFunctionVariables;
+
+            fo.code = Compiler::compileFunction (parameters, variableNames, *body);
         }
 
         Expression* parseExpression()
@@ -1106,6 +2348,9 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         }
 
     private:
+        // While parsing a function's body, this collects the names that it declares with var
+        Array<Identifier>* functionVariables = nullptr;
+
         void throwError (const String& err) const  { location.throwError (err); }
 
         template <typename OpType>
@@ -1178,6 +2423,9 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         {
             std::unique_ptr<VarStatement> s (new VarStatement (location));
             s->name = parseIdentifier();
+
+            if (functionVariables != nullptr)
+                functionVariables->addIfNotAlreadyThere (s->name);
             s->initialiser.reset (matchIf (TokenTypes::assign) ? parseExpression() : new Expression (location));
 
             if (matchIf (TokenTypes::comma))
@@ -1279,6 +2527,7 @@ struct JavascriptEngine::RootObject final : public DynamicObject
         {
             std::unique_ptr<FunctionCall> s (call);
             s->object = std::move (function);
+            s->dotOperator = dynamic_cast<DotOperator*> (s->object.get());
             match (TokenTypes::openParen);
 
             while (currentType != TokenTypes::closeParen)
@@ -1833,8 +3082,8 @@ JavascriptEngine::JavascriptEngine()  : maximumExecutionTime (15.0), root (new R
 
 JavascriptEngine::~JavascriptEngine() {}
 
-void JavascriptEngine::prepareTimeout() const noexcept   { root->timeout = Time::getCurrentTime() + maximumExecutionTime; }
-void JavascriptEngine::stop() noexcept                   { root->timeout = {}; }
+void JavascriptEngine::prepareTimeout() const noexcept   { root->prepareTimeout (Time::getCurrentTime() + maximumExecutionTime); }
+void JavascriptEngine::stop() noexcept                   { root->interrupted = true; }
 
 void JavascriptEngine::registerNativeObject (const Identifier& name, DynamicObject* object)
 {
@@ -1918,4 +3167,157 @@ const NamedValueSet& JavascriptEngine::getRootObjectProperties() const noexcept
 
 JUCE_END_IGNORE_WARNINGS_MSVC
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JavascriptEngineTests final : public UnitTest
+{
+public:
+    JavascriptEngineTests()
+        : UnitTest ("JavascriptEngine", UnitTestCategories::javascript)
+    {}
+
+    void expectResult (JavascriptEngine& engine, const String& code, const var& expected)
+    {
+        Result result (Result::ok());
+        auto value = engine.evaluate (code, &result);
+        expect (result.wasOk(), code + ": " + result.getErrorMessage());
+        expect (value == expected && value.isString() == expected.isString(),
+                code + ": expected " + expected.toString() + ", got " + value.toString());
+    }
+
+    // Counts the calls made to its method, which runs the given function each time
+    struct CountingNativeObject final : public DynamicObject
+    {
+        explicit CountingNativeObject (std::function<void()> onCallIn)
+            : onCall (std::move (onCallIn))
+        {
+            setMethod ("call", [this] (const var::NativeFunctionArgs&) { ++numCalls; onCall(); return var(); });
+        }
+
+        std::function<void()> onCall;
+        int numCalls = 0;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Expressions");
+        {
+            JavascriptEngine engine;
+            expectResult (engine, "1 + 2 * 3", 7);
+            expectResult (engine, "7 / 2", 3.5);
+            expectResult (engine, "7 % 3", 1);
+            expectResult (engine, "\"a\" + 1", "a1");
+            expectResult (engine, "1 < 2 && 3 >= 3", true);
+            expectResult (engine, "1 == 1.0", true);
+            expectResult (engine, "1 === \"1\"", false);
+            expectResult (engine, "(5 | 2) ^ 1", 6);
+            expectResult (engine, "-8 >> 1", -4);
+            expectResult (engine, "true ? \"yes\" : \"no\"", "yes");
+            expectResult (engine, "typeof (function() {})", "function");
+        }
+
+        beginTest ("Scopes");
+        {
+            JavascriptEngine engine;
+            expect (engine.execute ("var g = 1;"
+                                    "function setG (x) { g = x; }"
+                                    "function readCallerLocal() { return callerLocal; }"
+                                    "function caller() { var callerLocal = 5; return readCallerLocal(); }"
+                                    "function shadow (g) { g = g + 1; return g; }"
+                                    "function counter() { var n = 0; for (var i = 0; i < 10; ++i) { n++; n += 2; } return n; }").wasOk());
+
+            engine.evaluate ("setG (3)");
+            expectResult (engine, "g", 3);
+            expectResult (engine, "caller()", 5);
+            expectResult (engine, "shadow (10)", 11);
+            expectResult (engine, "g", 3);
+            expectResult (engine, "counter()", 30);
+
+            expect (engine.execute ("function assignUndeclared() { newGlobal = 7; } assignUndeclared();").wasOk());
+            expectResult (engine, "newGlobal", 7);
+
+            expect (engine.execute ("function late (flag) { if (flag) { var x = 1; } return typeof (x); }").wasOk());
+            expectResult (engine, "late (false)", "undefined");
+            expectResult (engine, "late (true)", "number");
+        }
+
+        beginTest ("Objects and arrays");
+        {
+            JavascriptEngine engine;
+            expect (engine.execute ("var o = { a: 1, b: { c: 2 } };"
+                                    "function Point (x, y) { this.x = x; this.y = y; this.len = function() { return this.x + this.y; }; }"
+                                    "var p = new Point (3, 4);"
+                                    "var arr = [1, 2, 3]; arr[5] = 6;").wasOk());
+
+            expectResult (engine, "o.b.c", 2);
+            expectResult (engine, "o.b.c = 9", 9);
+            expectResult (engine, "o.b.c", 9);
+            expectResult (engine, "o[\"a\"]", 1);
+            expectResult (engine, "p.len()", 7);
+            expectResult (engine, "arr.length", 6);
+            expectResult (engine, "arr[1] + arr[5]", 8);
+            expectResult (engine, "\"hello\".substring (1, 3)", "el");
+            expectResult (engine, "Math.max (2, 5)", 5);
+
+            // the same lookup applied to objects whose properties are laid out differently
+            expect (engine.execute ("function getY (obj) { return obj.y; }"
+                                    "var objects = [ { x: 1, y: 2 }, { y: 3 }, { z: 0, x: 0, y: 4 }, { x: 5 } ];"
+                                    "var total = 0;"
+                                    "for (var i = 0; i < 4; ++i) { var y = getY (objects[i]); if (typeof y != \"undefined\") total += y; }").wasOk());
+            expectResult (engine, "total", 9);
+
+            const var args[] = { 2, 3 };
+            expect (engine.execute ("function sum (a, b) { return a + b; }").wasOk());
+            expect (engine.callFunction ("sum", var::NativeFunctionArgs ({}, args, 2)) == var (5));
+        }
+
+        beginTest ("Errors and timeouts");
+        {
+            JavascriptEngine engine;
+            expect (engine.execute ("var x = ;").failed());
+            expect (engine.execute ("undefinedFunction();").failed());
+
+            engine.maximumExecutionTime = RelativeTime::milliseconds (50);
+            const auto result = engine.execute ("while (true) {}");
+            expect (result.failed());
+            expect (result.getErrorMessage().contains ("timed-out"));
+        }
+
+        beginTest ("Timeouts and stop() are noticed as soon as a native function returns");
+        {
+            JavascriptEngine engine;
+
+            // the first call outlasts the timeout, so there mustn't be a second one
+            auto* slow = new CountingNativeObject ([] { Thread::sleep (50); });
+            engine.registerNativeObject ("Slow", slow);
+            engine.maximumExecutionTime = RelativeTime::milliseconds (20);
+
+            auto result = engine.execute ("while (true) Slow.call();");
+            expect (result.getErrorMessage().contains ("timed-out"));
+            expectEquals (slow->numCalls, 1);
+
+            // the first call doesn't return until stop() has been called
+            WaitableEvent called, stopped (true);
+            auto* stopping = new CountingNativeObject ([&] { called.signal(); stopped.wait(); });
+            engine.registerNativeObject ("Stopping", stopping);
+            engine.maximumExecutionTime = RelativeTime::seconds (60);
+
+            std::thread stopper ([&] { called.wait(); engine.stop(); stopped.signal(); });
+            result = engine.execute ("while (true) Stopping.call();");
+            stopper.join();
+            expect (result.getErrorMessage().contains ("Interrupted"));
+            expectEquals (stopping->numCalls, 1);
+
+            // a script that has been stopped can be run again
+            expectResult (engine, "1 + 1", 2);
+        }
+    }
+};
+
+static JavascriptEngineTests javascriptEngineTests;
+
+#endif
+
 } // namespace juce
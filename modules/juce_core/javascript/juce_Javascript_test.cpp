@@ -0,0 +1,1465 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Each of these scripts was run by the tree-walking interpreter that the bytecode compiler
+    replaced, and its transcript records what happened: the result of executing the script,
+    the value of each expression on a line starting with '?' evaluated afterwards, the calls
+    made to Log.write(), and the properties that the script left in the root object.
+*/
+class JavascriptEngineEquivalenceTests final : public UnitTest
+{
+public:
+    JavascriptEngineEquivalenceTests()
+        : UnitTest ("JavascriptEngine equivalence", UnitTestCategories::javascript)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Scripts behave as they did in the tree-walking interpreter");
+
+        for (const auto& c : getCases())
+        {
+            const auto expected = StringArray::fromLines (c.expected);
+            const auto actual = StringArray::fromLines (getTranscript (c.script));
+
+            auto mismatch = 0;
+
+            while (mismatch < jmin (expected.size(), actual.size()) && expected[mismatch] == actual[mismatch])
+                ++mismatch;
+
+            expect (mismatch == expected.size() && mismatch == actual.size(),
+                    String (c.script).upToFirstOccurrenceOf ("\n", false, false)
+                      + "...\nexpected: " + expected[mismatch] + "\nactual:   " + actual[mismatch]);
+        }
+    }
+
+private:
+    struct Case
+    {
+        const char* script;
+        const char* expected;
+    };
+
+    static Span<const Case> getCases();
+
+    static String dump (const var& v, const NamedValueSet& rootProperties, int depth)
+    {
+        if (depth > 3)
+            return "...";
+
+        if (auto* array = v.getArray())
+        {
+            String s ("[");
+
+            for (auto& element : *array)
+                s << dump (element, rootProperties, depth + 1) << ",";
+
+            return s + "]";
+        }
+
+        if (auto* object = v.getDynamicObject())
+        {
+            if (&object->getProperties() == &rootProperties)
+                return "{root}";
+
+            String s ("{");
+
+            for (auto& p : object->getProperties())
+                s << p.name.toString() << ":" << dump (p.value, rootProperties, depth + 1) << ",";
+
+            return s + "}";
+        }
+
+        if (v.isMethod())   return "<native>";
+        if (v.isObject())   return "<obj>";
+
+        return JSON::toString (v, true);
+    }
+
+    static String describe (const var& v, const NamedValueSet& rootProperties)
+    {
+        const auto type = v.isVoid() ? "void" : v.isUndefined() ? "undefined" : v.isInt() ? "int" : v.isInt64() ? "int64"
+                        : v.isBool() ? "bool" : v.isDouble() ? "double" : v.isString() ? "string" : v.isArray() ? "array"
+                        : v.isMethod() ? "method" : v.isObject() ? "object" : "other";
+
+        if (v.isDouble())
+            return type + (":" + String ((double) v, 17)) + (std::signbit ((double) v) ? "(neg)" : "");
+
+        return type + (":" + dump (v, rootProperties, 0));
+    }
+
+    static String getTranscript (const String& script)
+    {
+        String code;
+        StringArray expressions;
+
+        for (auto& line : StringArray::fromLines (script))
+        {
+            if (line.startsWith ("?"))
+                expressions.add (line.substring (1).trim());
+            else
+                code << line << "\n";
+        }
+
+        JavascriptEngine engine;
+        engine.maximumExecutionTime = RelativeTime::seconds (1);
+        const auto& rootProperties = engine.getRootObjectProperties();
+
+        StringArray builtIns;
+
+        for (auto& p : rootProperties)
+            builtIns.add (p.name.toString());
+
+        String transcript, log;
+
+        auto* logObject = new DynamicObject();
+        logObject->setMethod ("write", [&] (const var::NativeFunctionArgs& args)
+        {
+            log << "[this:" << (args.thisObject.isVoid() ? "void" : dump (args.thisObject, rootProperties, 0)) << "]";
+
+            for (int i = 0; i < args.numArguments; ++i)
+                log << describe (args.arguments[i], rootProperties) << " ";
+
+            log << "\n";
+            return var (args.numArguments);
+        });
+
+        engine.registerNativeObject ("Log", logObject);
+        builtIns.add ("Log");
+
+        const auto result = engine.execute (code);
+        transcript << "exec: " << (result.wasOk() ? String ("ok") : result.getErrorMessage()) << "\n";
+
+        for (auto& expression : expressions)
+        {
+            auto evaluated = Result::ok();
+            const auto value = engine.evaluate (expression, &evaluated);
+            transcript << "eval " << expression << " => "
+                       << (evaluated.wasOk() ? describe (value, rootProperties) : "ERROR " + evaluated.getErrorMessage()) << "\n";
+        }
+
+        transcript << log;
+
+        for (auto& p : rootProperties)
+            if (! builtIns.contains (p.name.toString()))
+                transcript << "  " << p.name.toString() << " = " << describe (p.value, rootProperties) << "\n";
+
+        return transcript;
+    }
+};
+
+Span<const JavascriptEngineEquivalenceTests::Case> JavascriptEngineEquivalenceTests::getCases()
+{
+    static const Case cases[]
+    {
+        { R"js(var a = 1 + 2 * 3; var b = 7 / 2; var c = 7 % 3; var d = "a" + 1; var e = 1 < 2 && 3 >= 3;
+var f = 1 == 1.0; var g = 1 === "1"; var h = (5 | 2) ^ 1; var i = -8 >> 1; var j = true ? "yes" : "no";
+var k = typeof (function() {}); var l = 1 === 1; var m = (1 + 1) === 2; var n = true + 1; var o = 0.1 + 0.2;
+var p = 5 / 0; var q = 5 % 0; var r = 5.5 % 0.0; var s = -1 >>> 28; var t = 1 << 33; var u = "abc" < "abd";
+var v = undefined == undefined; var w = null == null; var x = undefined === null; var y = !0; var z = !"";
+?1 + 2
+?"x" + undefined
+?undefined + 1
+?null + 1
+?true && 0
+?0 || "s"
+?[1,2] == [1,2]
+?typeof undefined
+?typeof null
+?typeof 1.5
+?typeof "s"
+?typeof {}
+?typeof []
+?typeof Math.sin
+?-0.0
+?0 - 0.0
+?1 / -0.0)js",
+          R"js(exec: ok
+eval 1 + 2 => int64:3
+eval "x" + undefined => string:"xundefined"
+eval undefined + 1 => int64:1
+eval null + 1 => string:"1"
+eval true && 0 => bool:false
+eval 0 || "s" => bool:false
+eval [1,2] == [1,2] => bool:true
+eval typeof undefined => string:"undefined"
+eval typeof null => string:"void"
+eval typeof 1.5 => string:"number"
+eval typeof "s" => string:"string"
+eval typeof {} => string:"object"
+eval typeof [] => string:"object"
+eval typeof Math.sin => string:"function"
+eval -0.0 => double:0.00000000000000000
+eval 0 - 0.0 => double:0.00000000000000000
+eval 1 / -0.0 => double:inf
+  a = int64:7
+  b = double:3.50000000000000000
+  c = int64:1
+  d = string:"a1"
+  e = bool:true
+  f = bool:true
+  g = bool:false
+  h = int64:6
+  i = int:-4
+  j = string:"yes"
+  k = string:"function"
+  l = bool:true
+  m = bool:true
+  n = int64:2
+  o = double:0.30000000000000004
+  p = double:inf
+  q = double:inf
+  r = double:inf
+  s = int:15
+  t = int:2
+  u = bool:true
+  v = bool:true
+  w = bool:true
+  x = bool:false
+  y = bool:true
+  z = bool:false
+)js" },
+
+        { R"js(var o = {}; o.x = 1;
+function f() { return this; }
+var r1 = typeof f();
+function g() { var loc = 3; return h(); }
+function h() { return this.loc; }
+var r2 = g();
+function k() { var q = 1; m(); return q; }
+function m() { this.q = 99; this.extra = 7; }
+var r3 = k();
+function keep() { saved = this; }
+function a2() { var x = 1; keep(); saved.x = 5; return x; }
+var r4 = a2();
+var r5 = saved.x;)js",
+          R"js(exec: ok
+  o = object:{x:1,}
+  f = object:{}
+  r1 = string:"object"
+  g = object:{}
+  h = object:{}
+  r2 = int64:3
+  k = object:{}
+  m = object:{}
+  r3 = int64:99
+  keep = object:{}
+  a2 = object:{}
+  saved = object:{this:{root},x:5,}
+  r4 = int64:5
+  r5 = int64:5
+)js" },
+
+        { R"js(function late (flag) { if (flag) { var x = 1; } return typeof (x); }
+var x = "global";
+var r1 = late (false); var r2 = late (true);
+function readOuter() { return y; }
+function outer() { var y = "outer"; return readOuter(); }
+var y = "g";
+var r3 = outer(); var r4 = readOuter();
+function setUndeclared() { undeclared = 5; }
+setUndeclared();
+function assignCallerLocal() { cl = 9; }
+function caller() { var cl = 1; assignCallerLocal(); return cl; }
+var r5 = caller();
+?cl)js",
+          R"js(exec: ok
+eval cl => int64:9
+  late = object:{}
+  x = string:"global"
+  r1 = string:"string"
+  r2 = string:"number"
+  readOuter = object:{}
+  outer = object:{}
+  y = string:"g"
+  r3 = string:"outer"
+  r4 = string:"g"
+  setUndeclared = object:{}
+  undeclared = int64:5
+  assignCallerLocal = object:{}
+  caller = object:{}
+  cl = int64:9
+  r5 = int64:1
+)js" },
+
+        { R"js(function f() {}
+function g() { return; }
+function h() { break; }
+function k() { for (var i = 0; i < 5; ++i) { if (i == 3) return i; } return -1; }
+function m() { var i = 0; while (true) { i++; if (i > 5) break; } return i; }
+function n() { var t = 0; for (var i = 0; i < 10; ++i) { if (i % 2) continue; t += i; } return t; }
+function p() { var t = 0; var i = 0; do { i++; t += i; } while (i < 4); return t; }
+function q() { continue; return 5; }
+var r1 = typeof f(); var r2 = typeof g(); var r3 = typeof h(); var r4 = k(); var r5 = m(); var r6 = n(); var r7 = p(); var r8 = typeof q();
+var r9 = f(); var r10 = g();)js",
+          R"js(exec: ok
+  f = object:{}
+  g = object:{}
+  h = object:{}
+  k = object:{}
+  m = object:{}
+  n = object:{}
+  p = object:{}
+  q = object:{}
+  r1 = string:"void"
+  r2 = string:"undefined"
+  r3 = string:"void"
+  r4 = int64:3
+  r5 = int64:6
+  r6 = int64:20
+  r7 = int64:10
+  r8 = string:"void"
+  r9 = void:null
+  r10 = undefined:undefined
+)js" },
+
+        { R"js(var before = 1;
+return 5;
+var after = 2;)js",
+          R"js(exec: ok
+  before = int64:1
+)js" },
+
+        { R"js(var x = 1;
+{ var y = 2; break; var z = 3; }
+var w = 4;)js",
+          R"js(exec: ok
+  x = int64:1
+  y = int64:2
+)js" },
+
+        { R"js(var calls = 0;
+function side() { calls++; return 1; }
+for (return side(); calls < 3; ) { side(); }
+var done = 1;)js",
+          R"js(exec: ok
+  calls = int64:3
+  side = object:{}
+  done = int64:1
+)js" },
+
+        { R"js(var n = 0;
+for ({ n = 10; break; n = 20; }; n < 12; n++) {}
+var after = n;)js",
+          R"js(exec: Line 2, column 40 : Found ';' when expecting ')'
+)js" },
+
+        { R"js(var t = 0;
+function inc() { t++; return t; }
+var arr = [0,0,0,0,0];
+arr[inc()] += 10;
+var o = { a: 1 }; function key() { t++; return "a"; }
+o[key()] += 5;
+var post = arr[inc()]++;)js",
+          R"js(exec: ok
+  t = int64:7
+  inc = object:{}
+  arr = array:[0,0,10,0,0,undefined,undefined,"1",]
+  o = object:{a:6,}
+  key = object:{}
+  post = void:null
+)js" },
+
+        { R"js(var o = { x: 1 };
+var a = o.x++; var b = ++o.x; var c = o.x--; var d = --o.x;
+var i = 5; var e = i++; var f = ++i; var g = i--; var h = --i;
+var j = 10; j += 2; j -= 1; j *= 3; j /= 2; j %= 5; 
+var k = 1; k <<= 4; k >>= 2;)js",
+          R"js(exec: ok
+  o = object:{x:1,}
+  a = int64:1
+  b = int64:3
+  c = int64:3
+  d = int64:1
+  i = int64:5
+  e = int64:5
+  f = int64:7
+  g = int64:7
+  h = int64:5
+  j = double:1.50000000000000000
+  k = int:4
+)js" },
+
+        { R"js(var c = true;
+var a = 1, b = 2;
+(c ? a : b) = 10;
+c = false;
+(c ? a : b) = 20;)js",
+          R"js(exec: Line 3, column 13 : Found '=' when expecting ';'
+)js" },
+
+        { R"js(var x = 3;
+function f() { return 1; }
+f() = 5;
+var y = 4;)js",
+          R"js(exec: Line 3, column 2 : Cannot assign to this expression!
+  x = int64:3
+  f = object:{}
+)js" },
+
+        { R"js(var x = 3;
+5 = 2;)js",
+          R"js(exec: Line 2, column 3 : Cannot assign to this expression!
+  x = int64:3
+)js" },
+
+        { R"js(var s = "hello";
+var u = undefined;
+u.x = 5;
+var after = 1;)js",
+          R"js(exec: Line 3, column 5 : Cannot assign to this expression!
+  s = string:"hello"
+  u = undefined:undefined
+)js" },
+
+        { R"js(var arr = [1, 2, 3];
+arr[6] = 7;
+var l = arr.length;
+var e = arr[4];
+var te = typeof arr[4];
+var oob = arr[100];
+var neg = arr[-1];
+var s = "abc";
+var sl = s.length;
+var si = s[1];
+var o = { length: 5 };
+var ol = o.length;
+var keyed = {}; keyed["k" + 1] = 3; var kv = keyed.k1;
+var numKeyed = {}; var nk = numKeyed[1];
+arr[1.7] = "x";
+var dbl = arr[1];)js",
+          R"js(exec: ok
+  arr = array:[1,"x",3,undefined,undefined,undefined,7,]
+  l = int:7
+  e = undefined:undefined
+  te = string:"undefined"
+  oob = void:null
+  neg = void:null
+  s = string:"abc"
+  sl = int:3
+  si = undefined:undefined
+  o = object:{length:5,}
+  ol = int64:5
+  keyed = object:{k1:3,}
+  kv = int64:3
+  numKeyed = object:{}
+  nk = undefined:undefined
+  dbl = string:"x"
+)js" },
+
+        { R"js(var arr = [1,2];
+arr[true] = 5;)js",
+          R"js(exec: ok
+  arr = array:[1,5,]
+)js" },
+
+        { R"js(var o = {};
+o[5] = 1;)js",
+          R"js(exec: Line 2, column 3 : Cannot assign to this expression!
+  o = object:{}
+)js" },
+
+        { R"js(function Point (x, y) { this.x = x; this.y = y; this.len = function() { return this.x + this.y; }; }
+var p = new Point (3, 4);
+var l = p.len();
+var proto = { greet: function() { return "hi " + this.name; } };
+var q = new proto();
+q.name = "q";
+var gr = q.greet();
+var nu = new undefinedThing();
+var tn = typeof nu;
+var ns = { inner: { make: function (v) { this.v = v; } } };
+var made = new ns.inner.make (5);
+var mv = made.v;
+var notObj = 5;
+var nn = new notObj (side());
+function side() { sideCalled = 1; return 0; })js",
+          R"js(exec: ok
+  Point = object:{}
+  p = object:{x:3,y:4,len:{},}
+  l = int64:7
+  proto = object:{greet:{},}
+  q = object:{prototype:{greet:{},},name:"q",}
+  gr = string:"hi q"
+  nu = undefined:undefined
+  tn = string:"undefined"
+  ns = object:{inner:{make:{},},}
+  made = object:{v:5,}
+  mv = int64:5
+  notObj = int64:5
+  nn = undefined:undefined
+  side = object:{}
+)js" },
+
+        { R"js(var s = "a,b,c";
+var parts = s.split (",");
+var j = parts.join ("-");
+var idx = s.indexOf ("b");
+var sub = "hello".substring (1, 3);
+var ch = "hello".charAt (1);
+var code = "A".charCodeAt (0);
+var from = String.fromCharCode (66);
+var arr = [3, 1, 2];
+arr.push (4, 5);
+var con = arr.contains (2);
+arr.remove (1);
+var io = arr.indexOf (4);
+var sp = arr.splice (1, 2, "x", "y");
+var mx = Math.max (3, 9); var mn = Math.min (2.5, 1); var ab = Math.abs (-3); var rd = Math.round (2.5);
+var pi = Math.PI; var sq = Math.sqrt (16); var pw = Math.pow (2, 10);
+var pi2 = parseInt ("42"); var ph = parseInt ("0x1F"); var po = parseInt ("017"); var pf = parseFloat ("1.5");
+var ci = charToInt ("a");
+var js = JSON.stringify ({ a: [1, 2], b: "c" });
+var cl = { a: 1 }.clone();
+var ilp = Integer.parseInt ("12");)js",
+          R"js(exec: ok
+  s = string:"a,b,c"
+  parts = array:["a","b","c",]
+  j = string:"a-b-c"
+  idx = int:2
+  sub = string:"el"
+  ch = string:"e"
+  code = int:65
+  from = string:"B"
+  arr = array:[3,"x","y",5,]
+  con = bool:true
+  io = int:2
+  sp = array:[2,4,]
+  mx = int:9
+  mn = double:1.00000000000000000
+  ab = int:3
+  rd = int:2
+  pi = double:3.14159265358979312
+  sq = double:4.00000000000000000
+  pw = double:1024.00000000000000000
+  pi2 = int64:42
+  ph = int64:31
+  po = int64:15
+  pf = double:1.50000000000000000
+  ci = int:97
+  js = string:"{\r\n  \"a\": [\r\n    1,\r\n    2\r\n  ],\r\n  \"b\": \"c\"\r\n}"
+  cl = object:{a:1,}
+  ilp = int64:12
+)js" },
+
+        { R"js(var o = { a: 1 };
+o.nosuch();)js",
+          R"js(exec: Line 2, column 9 : Unknown function 'nosuch'
+  o = object:{a:1,}
+)js" },
+
+        { R"js(undefinedFunction (sideEffect = 1);)js",
+          R"js(exec: Line 1, column 19 : This expression is not a function!
+  sideEffect = int64:1
+)js" },
+
+        { R"js(var notFn = 5;
+notFn (sideEffect = 1);)js",
+          R"js(exec: Line 2, column 7 : This expression is not a function!
+  notFn = int64:5
+  sideEffect = int64:1
+)js" },
+
+        { R"js(var o = { a: 5 };
+o.a();)js",
+          R"js(exec: Line 2, column 4 : This expression is not a function!
+  o = object:{a:5,}
+)js" },
+
+        { R"js(function f (a, b, c) { return typeof c; }
+var r = f (1);
+function g (a, a) { return a; }
+var r2 = g (1, 2);
+var r3 = g (1, 1.0);
+function h (this) { return this; }
+var r4 = h (5);
+function many (a,b,c,d,e,f2,g2,h2,i,j,k) { return a+b+c+d+e+f2+g2+h2+i+j+k; }
+var r5 = many (1,2,3,4,5,6,7,8,9,10,11);
+var r6 = many (1,2);
+function extra (a) { return a; }
+var r7 = extra (1, 2, 3);)js",
+          R"js(exec: ok
+  f = object:{}
+  r = string:"undefined"
+  g = object:{}
+  r2 = int64:2
+  r3 = double:1.00000000000000000
+  h = object:{}
+  r4 = int64:5
+  many = object:{}
+  r5 = int64:66
+  r6 = int64:3
+  extra = object:{}
+  r7 = int64:1
+)js" },
+
+        { R"js(function outer() { function inner() { return 5; } return inner(); }
+var r = outer();
+var ti = typeof inner;)js",
+          R"js(exec: ok
+  outer = object:{}
+  inner = object:{}
+  r = int64:5
+  ti = string:"function"
+)js" },
+
+        { R"js(var f = function (x) { return x * 2; };
+var r = f (4);
+var r2 = (function() { return 7; })();
+var arr = [function() { return this; }];
+var r3 = typeof arr[0]();
+var obj = { m: function() { return this.v; }, v: 3 };
+var r4 = obj["m"]();
+var r5 = typeof r4;)js",
+          R"js(exec: ok
+  f = object:{}
+  r = int64:8
+  r2 = int64:7
+  arr = array:[{},]
+  r3 = string:"object"
+  obj = object:{m:{},v:3,}
+  r4 = undefined:undefined
+  r5 = string:"undefined"
+)js" },
+
+        { R"js(var x = 0;
+if (x) x = 1; else x = 2;
+if ("") x = 3;
+if ("0") y = 1; else y = 2;
+if ("true") z = 1; else z = 2;
+if ([]) w = 1; else w = 2;
+if ({}) v = 1; else v = 2;
+if (0.0) u = 1; else u = 2;
+if (null) t = 1; else t = 2;
+if (undefined) s = 1; else s = 2;)js",
+          R"js(exec: ok
+  x = int64:2
+  y = int64:2
+  z = int64:1
+  w = int64:1
+  v = int64:1
+  u = int64:2
+  t = int64:2
+  s = int64:2
+)js" },
+
+        { R"js(function f() { var a = 1; var a = 2; return a; }
+var r = f();
+function g() { var b = 0.0; var b = -0.0; return 1 / b; }
+var r2 = g();
+function h() { var c = 0.0; c = -0.0; return 1 / c; }
+var r3 = h();
+var gz = 0.0; gz = -0.0; var r4 = 1 / gz;
+function k() { gz2 = 0.0; gz2 = -0.0; return 1 / gz2; }
+var r5 = k();)js",
+          R"js(exec: ok
+  f = object:{}
+  r = int64:2
+  g = object:{}
+  r2 = double:inf
+  h = object:{}
+  r3 = double:inf
+  gz = double:0.00000000000000000
+  r4 = double:inf
+  k = object:{}
+  gz2 = double:0.00000000000000000
+  r5 = double:inf
+)js" },
+
+        { R"js(function f() { var x = 1; return trace (x); }
+var r = f();
+function g() { var y = 2; return Log.write (y); }
+var r2 = g();)js",
+          R"js(exec: ok
+[this:{write:<native>,}]int64:2 
+  f = object:{}
+  r = undefined:undefined
+  g = object:{}
+  r2 = int:1
+)js" },
+
+        { R"js(var t = typeof trace;
+function shadowTypeof() { var typeof = function (x) { return "mine"; }; return typeof (1); }
+var r = shadowTypeof();)js",
+          R"js(exec: Line 2, column 31 : Found 'typeof' when expecting identifier
+)js" },
+
+        { R"js(var count = 0;
+function rec (n) { count++; if (n > 0) rec (n - 1); }
+rec (50);
+function fib (n) { return n < 2 ? n : fib (n - 1) + fib (n - 2); }
+var f15 = fib (15);)js",
+          R"js(exec: ok
+  count = int64:51
+  rec = object:{}
+  fib = object:{}
+  f15 = int64:610
+)js" },
+
+        { R"js(var a = [1, 2, 3];
+var b = a;
+b.push (4);
+var l = a.length;
+var o = { arr: [1] };
+o.arr.push (2);
+var ol = o.arr.length;
+var nested = [[1, 2], [3]];
+nested[0][1] = 9;
+var n01 = nested[0][1];)js",
+          R"js(exec: ok
+  a = array:[1,2,3,4,]
+  b = array:[1,2,3,4,]
+  l = int:4
+  o = object:{arr:[1,2,],}
+  ol = int:2
+  nested = array:[[1,9,],[3,],]
+  n01 = int64:9
+)js" },
+
+        { R"js(var s = "x";
+s += 1;
+s += 1.5;
+var t = 1;
+t += "a";
+var u = [1] + 1;)js",
+          R"js(exec: Line 6, column 16 : '+' is not allowed on the Array type
+  s = string:"x11.5"
+  t = string:"1a"
+)js" },
+
+        { R"js(var r1 = "a" - 1;)js",
+          R"js(exec: Line 1, column 17 : '-' is not allowed on the String type
+)js" },
+
+        { R"js(var r1 = {} * 2;)js",
+          R"js(exec: Line 1, column 16 : '*' is not allowed on the Object type
+)js" },
+
+        { R"js(var r1 = [1] < 2;)js",
+          R"js(exec: Line 1, column 17 : '<' is not allowed on the Array type
+)js" },
+
+        { R"js(var r1 = 1 & 1.5;)js",
+          R"js(exec: Line 1, column 17 : '&' is not allowed on the Double type
+)js" },
+
+        { R"js(var r1 = true << 2;
+var r2 = 2.5 | 0;)js",
+          R"js(exec: Line 2, column 17 : '|' is not allowed on the Double type
+  r1 = int:4
+)js" },
+
+        { R"js(var x = eval ("1 + 2");
+exec ("var y = 5;");
+function f() { return eval ("3"); }
+var r = typeof f();
+function g() { exec ("var z = 1;"); return typeof z; }
+var r2 = g();)js",
+          R"js(exec: ok
+  x = int64:3
+  y = int64:5
+  f = object:{}
+  r = string:"undefined"
+  g = object:{}
+  r2 = string:"undefined"
+)js" },
+
+        { R"js(var log = [];
+function a() { log.push ("a"); return 1; }
+function b() { log.push ("b"); return 2; }
+function c() { log.push ("c"); return 3; }
+var r = a() + b() * c();
+var r2 = a() < b() == c();
+var r3 = [a(), b(), c()];
+var r4 = { x: c(), y: a() };
+var j = log.join ("");
+var tobj = {};
+function tgt() { log.push ("t"); return tobj; }
+tgt()["p"] = b();
+var j2 = log.join ("");)js",
+          R"js(exec: ok
+  log = array:["a","b","c","a","b","c","a","b","c","c","a","b","t",]
+  a = object:{}
+  b = object:{}
+  c = object:{}
+  r = int64:7
+  r2 = bool:false
+  r3 = array:[1,2,3,]
+  r4 = object:{x:3,y:1,}
+  j = string:"abcabcabcca"
+  tobj = object:{p:2,}
+  tgt = object:{}
+  j2 = string:"abcabcabccabt"
+)js" },
+
+        { R"js(var x = 1;
+x.y = 2;)js",
+          R"js(exec: Line 2, column 5 : Cannot assign to this expression!
+  x = int64:1
+)js" },
+
+        { R"js(var o = {};
+o.f = function() { return this === o; };
+var r = o.f();
+function ctor() { this.self = this; }
+var count = 0;)js",
+          R"js(exec: ok
+  o = object:{f:{},}
+  r = bool:true
+  ctor = object:{}
+  count = int64:0
+)js" },
+
+        { R"js(function f() { var args = 0; return g (1); }
+function g (n) { return n + this.args; }
+var r = f();)js",
+          R"js(exec: ok
+  f = object:{}
+  g = object:{}
+  r = int64:1
+)js" },
+
+        { R"js(var q = 5;
+function f() { return q; }
+var o = { m: function() { var q = 10; return f(); } };
+var r = o.m();)js",
+          R"js(exec: ok
+  q = int64:5
+  f = object:{}
+  o = object:{m:{},}
+  r = int64:10
+)js" },
+
+        { R"js(var a = 1;
+var b = a++ + a++;
+var c = a;
+var d = ++a + ++a;)js",
+          R"js(exec: ok
+  a = int64:5
+  b = int64:3
+  c = int64:3
+  d = int64:9
+)js" },
+
+        { R"js(var i = 0;
+while (i < 5) i++;
+var j = 10;
+do j--; while (j > 5);)js",
+          R"js(exec: Line 4, column 4 : Found identifier when expecting '{'
+)js" },
+
+        { R"js(var x = 3; var y = x === 3.0; var z = x !== 3; var w = undefined !== undefined; var v = null === null;
+var f1 = function() {}; var f2 = f1; var ff = f1 === f2; var fg = f1 == f2;
+var s1 = "a" === "a"; var n1 = 1 === true; var n2 = 1 == true;)js",
+          R"js(exec: ok
+  x = int64:3
+  y = bool:false
+  z = bool:false
+  w = bool:false
+  v = bool:true
+  f1 = object:{}
+  f2 = object:{}
+  ff = bool:true
+  fg = bool:true
+  s1 = bool:true
+  n1 = bool:false
+  n2 = bool:true
+)js" },
+
+        { R"js(var x;
+var y = x;
+var tx = typeof x;
+var z = typeof notDefinedAnywhere;)js",
+          R"js(exec: ok
+  x = undefined:undefined
+  y = undefined:undefined
+  tx = string:"undefined"
+  z = string:"undefined"
+)js" },
+
+        { R"js(function f() { for (var i = 0; i < 3; ++i) { var inner = i; } return inner + i; }
+var r = f();)js",
+          R"js(exec: ok
+  f = object:{}
+  r = int64:5
+)js" },
+
+        { R"js(function f() { return this.zz; }
+var zz = 7;
+var r = f();
+var o = { zz: 8, f: f };
+var r2 = o.f();)js",
+          R"js(exec: ok
+  f = object:{}
+  zz = int64:7
+  r = int64:7
+  o = object:{zz:8,f:{},}
+  r2 = int64:8
+)js" },
+
+        { R"js(var counter = 0;
+function Obj() { this.n = 0; this.bump = function() { this.n++; counter++; return this.n; }; }
+var a = new Obj();
+a.bump(); a.bump();
+var r = a.n;)js",
+          R"js(exec: ok
+  counter = int64:2
+  Obj = object:{}
+  a = object:{n:2,bump:{},}
+  r = int64:2
+)js" },
+
+        { R"js(var arr = [5, 6];
+for (var i = 0; i < arr.length; i++) arr[i] = arr[i] * 2;
+var s = 0;
+var k = 0;
+for (;;) { k++; if (k == 4) break; }
+for (var q = 0; ; q++) { if (q > 2) break; }
+for (var m = 0; m < 2;) { m++; })js",
+          R"js(exec: ok
+  arr = array:[10,12,]
+  i = int64:2
+  s = int64:0
+  k = int64:4
+  q = int64:3
+  m = int64:2
+)js" },
+
+        { R"js(function f() { var p = 5; var g = function() { return p; }; return g(); }
+var r = f();
+function h() { var p = 6; return { get: function() { return p; } }.get(); }
+var r2 = h();)js",
+          R"js(exec: ok
+  f = object:{}
+  r = int64:5
+  h = object:{}
+  r2 = int64:6
+)js" },
+
+        { R"js(var o = { a: { b: { c: 1 } } };
+o.a.b.c += 5;
+o.a.b.d = o.a.b.c * 2;
+var r = o.a.b.d;)js",
+          R"js(exec: ok
+  o = object:{a:{b:{c:6,d:12,},},}
+  r = int64:12
+)js" },
+
+        { R"js(function f (x) { x = x + 1; return x; }
+var r = f (1);
+function g (x) { var x = 5; return x; }
+var r2 = g (1);
+function h (x) { var x; return typeof x; }
+var r3 = h (1);)js",
+          R"js(exec: ok
+  f = object:{}
+  r = int64:2
+  g = object:{}
+  r2 = int64:5
+  h = object:{}
+  r3 = string:"undefined"
+)js" },
+
+        { R"js(function v() { var u = undefined; var u2; return typeof u + typeof u2; }
+var r = v();)js",
+          R"js(exec: ok
+  v = object:{}
+  r = string:"undefinedundefined"
+)js" },
+
+        { R"js(var o = { 'quoted': 1, "dq": 2, plain: 3 };
+var s = o.quoted + o.dq + o.plain;)js",
+          R"js(exec: ok
+  o = object:{quoted:1,dq:2,plain:3,}
+  s = int64:6
+)js" },
+
+        { R"js(var big = 9007199254740993; var hex = 0xFFFFFFFF; var oct = 0777; var flt = 1.5e3; var dot = .5;
+var sum = hex + 1; var mul = 100000 * 100000; var ov = 3000000000 * 3;)js",
+          R"js(exec: ok
+  big = int64:9007199254740993
+  hex = int64:4294967295
+  oct = int64:511
+  flt = double:1500.00000000000000000
+  dot = double:0.50000000000000000
+  sum = int64:4294967296
+  mul = int64:10000000000
+  ov = int64:9000000000
+)js" },
+
+        { R"js(var r = 1;
+var q = r.length;
+var a = [1,2];
+var z = a.foo;
+var e = "".length;)js",
+          R"js(exec: ok
+  r = int64:1
+  q = undefined:undefined
+  a = array:[1,2,]
+  z = undefined:undefined
+  e = int:0
+)js" },
+
+        { R"js(function f() { return g(); }
+function g() { return h; }
+function h() {}
+var r = typeof f();)js",
+          R"js(exec: ok
+  f = object:{}
+  g = object:{}
+  h = object:{}
+  r = string:"function"
+)js" },
+
+        { R"js(var s = 0;
+for (var i = 0; i < 3; i++) for (var j = 0; j < 3; j++) { if (j == 1) continue; if (i == 2) break; s += i * 10 + j; })js",
+          R"js(exec: ok
+  s = int64:24
+  i = int64:3
+  j = int64:0
+)js" },
+
+        { R"js(function outer() {
+  var total = 0;
+  for (var i = 0; i < 3; ++i) {
+    var x = i;
+    total += helper();
+  }
+  return total;
+}
+function helper() { return x * 2; }
+var r = outer();)js",
+          R"js(exec: ok
+  outer = object:{}
+  helper = object:{}
+  r = int64:6
+)js" },
+
+        { R"js(function a() { var v = 1; return b(); }
+function b() { return c(); }
+function c() { return v; }
+var r = a();
+function d() { return c(); }
+var v = "root";
+var r2 = d();)js",
+          R"js(exec: ok
+  a = object:{}
+  b = object:{}
+  c = object:{}
+  r = int64:1
+  d = object:{}
+  v = string:"root"
+  r2 = string:"root"
+)js" },
+
+        { R"js(var obj = { f: function() { return typeof this; } };
+var r1 = obj.f();
+var g = obj.f;
+var r2 = g();
+function wrapper() { var g2 = obj.f; return g2(); }
+var r3 = wrapper();)js",
+          R"js(exec: ok
+  obj = object:{f:{},}
+  r1 = string:"object"
+  g = object:{}
+  r2 = string:"object"
+  wrapper = object:{}
+  r3 = string:"object"
+)js" },
+
+        { R"js(function ThisStore() { stored = this; return 1; }
+function holder() { var secret = 42; ThisStore(); return 0; }
+holder();
+var s = stored.secret;
+stored.secret = 1;)js",
+          R"js(exec: ok
+  ThisStore = object:{}
+  holder = object:{}
+  stored = object:{this:{root},secret:1,}
+  s = int64:42
+)js" },
+
+        { R"js(function f() { var a = 1; var b = 2; Log.write (a, b); return g(); }
+function g() { return this.a + this.b; }
+var r = f();)js",
+          R"js(exec: ok
+[this:{write:<native>,}]int64:1 int64:2 
+  f = object:{}
+  g = object:{}
+  r = int64:3
+)js" },
+
+        { R"js(function f() { var a = 1; var r = g(); return a + r; }
+function g() { this.a = 10; return 0; }
+var r = f();)js",
+          R"js(exec: ok
+  f = object:{}
+  g = object:{}
+  r = int64:10
+)js" },
+
+        { R"js(function f() { var a = 1; g(); var b = 2; g(); return JSON.stringify (this) + a + b; }
+function g() { this.a = this.a + 1; }
+var r = f();)js",
+          R"js(exec: ok
+  f = object:{}
+  g = object:{}
+  r = string:"{\r\n  \"exec\": Method,\r\n  \"eval\": Method,\r\n  \"trace\": Method,\r\n  \"charToInt\": Method,\r\n  \"parseInt\": Method,\r\n  \"typeof\": Method,\r\n  \"parseFloat\": Method,\r\n  \"Object\": {\r\n    \"dump\": Method,\r\n    \"clone\": Method\r\n  },\r\n  \"Array\": {\r\n    \"contains\": Method,\r\n    \"remove\": Method,\r\n    \"join\": Method,\r\n    \"push\": Method,\r\n    \"splice\": Method,\r\n    \"indexOf\": Method\r\n  },\r\n  \"String\": {\r\n    \"substring\": Method,\r\n    \"indexOf\": Method,\r\n    \"charAt\": Method,\r\n    \"charCodeAt\": Method,\r\n    \"fromCharCode\": Method,\r\n    \"split\": Method\r\n  },\r\n  \"Math\": {\r\n    \"abs\": Method,\r\n    \"round\": Method,\r\n    \"random\": Method,\r\n    \"randInt\": Method,\r\n    \"min\": Method,\r\n    \"max\": Method,\r\n    \"range\": Method,\r\n    \"sign\": Method,\r\n    \"toDegrees\": Method,\r\n    \"toRadians\": Method,\r\n    \"sin\": Method,\r\n    \"asin\": Method,\r\n    \"sinh\": Method,\r\n    \"asinh\": Method,\r\n    \"cos\": Method,\r\n    \"acos\": Method,\r\n    \"cosh\": Method,\r\n    \"acosh\": Method,\r\n    \"tan\": Method,\r\n    \"atan\": Method,\r\n    \"tanh\": Method,\r\n    \"atanh\": Method,\r\n    \"log\": Method,\r\n    \"log10\": Method,\r\n    \"exp\": Method,\r\n    \"pow\": Method,\r\n    \"sqr\": Method,\r\n    \"sqrt\": Method,\r\n    \"ceil\": Method,\r\n    \"floor\": Method,\r\n    \"hypot\": Method,\r\n    \"PI\": 3.141592653589793,\r\n    \"E\": 2.718281828459045,\r\n    \"SQRT2\": 1.414213562373095,\r\n    \"SQRT1_2\": 0.7071067811865476,\r\n    \"LN2\": 0.6931471805599453,\r\n    \"LN10\": 2.302585092994046,\r\n    \"LOG2E\": 1.442695040888963,\r\n    \"LOG10E\": 0.4342944819032518\r\n  },\r\n  \"JSON\": {\r\n    \"stringify\": Method\r\n  },\r\n  \"Integer\": {\r\n    \"parseInt\": Method\r\n  },\r\n  \"Log\": {\r\n    \"write\": Method\r\n  },\r\n  \"f\": function f() { var a = 1; g(); var b = 2; g(); return JSON.stringify (this) + a + b; }\n,\r\n  \"g\": function g() { this.a = this.a + 1; }\n\r\n}32"
+)js" },
+
+        { R"js(var r = Math.nonexistent;
+var r2 = typeof Math.sin (0);
+var s = "abc".nosuchmethod;)js",
+          R"js(exec: ok
+  r = undefined:undefined
+  r2 = string:"number"
+  s = undefined:undefined
+)js" },
+
+        { R"js(var a = "abc".nosuchmethod();)js",
+          R"js(exec: Line 1, column 27 : Unknown function 'nosuchmethod'
+)js" },
+
+        { R"js(var o = { a: 1 };
+var r = o.hasOwnProperty;)js",
+          R"js(exec: ok
+  o = object:{a:1,}
+  r = undefined:undefined
+)js" },
+
+        { R"js(var arr = [];
+arr[2] = 1;
+var l = arr.length;
+var s = JSON.stringify (arr);)js",
+          R"js(exec: ok
+  arr = array:[undefined,undefined,1,]
+  l = int:3
+  s = string:"[\r\n  undefined,\r\n  undefined,\r\n  1\r\n]"
+)js" },
+
+        { R"js(var a = 1;
+a = a = 2;
+var b = (a = 3) + a;)js",
+          R"js(exec: ok
+  a = int64:3
+  b = int64:6
+)js" },
+
+        { R"js(var o = {};
+o.x = o.y = 5;)js",
+          R"js(exec: ok
+  o = object:{y:5,x:5,}
+)js" },
+
+        { R"js(var r1 = 10 > 9 > 8;
+var r2 = "10" > "9";
+var r3 = "10" > 9;
+var r4 = 1 + "2" + 3;
+var r5 = 1 + 2 + "3";)js",
+          R"js(exec: ok
+  r1 = bool:false
+  r2 = bool:false
+  r3 = bool:false
+  r4 = string:"123"
+  r5 = string:"33"
+)js" },
+
+        { R"js(var x = 5;
+var y = -x;
+var z = - -x;
+var w = -"3";
+var v = !x;
+var u = !!x;)js",
+          R"js(exec: Line 4, column 13 : '-' is not allowed on the String type
+  x = int64:5
+  y = int64:-5
+  z = int64:5
+)js" },
+
+        { R"js(function f() { return arguments; }
+var r = typeof f();)js",
+          R"js(exec: ok
+  f = object:{}
+  r = string:"undefined"
+)js" },
+
+        { R"js(while (true) {})js",
+          R"js(exec: Line 1, column 7 : Execution timed-out
+)js" },
+
+        { R"js(function f() { f(); }
+var before = 1;)js",
+          R"js(exec: ok
+  f = object:{}
+  before = int64:1
+)js" },
+
+        { R"js(function setOnThis() { this.a = 10; this.extra = 3; }
+function f() { var a = 1; setOnThis(); return a + extra; }
+var r1 = f();
+function d() { var t = 0; var i = 0; do { i++; if (i == 2) continue; t += i; } while (i < 5); return t; }
+var r2 = d();
+var kept;
+function keep() { kept = this; }
+function g() { var v = 4; keep(); v = 5; return kept.v; }
+var r3 = g();
+function rec (n) { var x = n; if (n > 0) rec (n - 1); return this.x; }
+var r4 = rec (3);
+function h() { var z; z = 2; var z = 7; return z; }
+var r5 = h();
+function both() { return this.q; }
+var q = 9; var obj = { q: 1, both: both };
+var r6 = both(); var r7 = obj.both();
+function usesArgsLater (a, a) { return a; }
+var r8 = usesArgsLater (1, 2);
+function w() { var i = 0; while (true) { if (++i > 3) break; } for (;;) { i += 10; if (i > 50) break; } return i; }
+var r9 = w();
+function cond (p) { var a = 0, b = 0; p ? a : b = 5; return a * 10 + b; }
+var r10 = cond (true) + cond (false);
+function noret() { for (var i = 0; i < 3; ++i) { if (i == 1) return i * 7; } }
+var r11 = noret();
+function deep() { var l = 1; return inner1(); }
+function inner1() { return inner2(); }
+function inner2() { return l + typeof this.l; }
+var r12 = deep();
+function logical() { var a = 0; var b = (a++ || a++) && a++; return a * 100 + b; }
+var r13 = logical();
+function post() { var o = { c: 1 }; var arr = [5]; var x = o.c++; var y = arr[0]--; return x + y * 10 + o.c * 100 + arr[0] * 1000; }
+var r14 = post();
+var sides = 0; function side() { sides++; }
+function newer (v) { this.v = v; }
+var n1 = new newer (3); var proto = { k: 1 }; var n2 = new proto(); var five = 5; var n3 = new five (side());
+var r15 = n1.v;
+?r1
+?r2
+?r3
+?r4
+?r5
+?r6
+?r7
+?r8
+?r9
+?r10
+?r11
+?r12
+?r13
+?r14
+?r15
+?typeof n2
+?typeof n3
+?sides)js",
+          R"js(exec: ok
+eval r1 => int64:13
+eval r2 => int64:13
+eval r3 => int64:5
+eval r4 => undefined:undefined
+eval r5 => int64:7
+eval r6 => int64:9
+eval r7 => int64:1
+eval r8 => int64:2
+eval r9 => int64:54
+eval r10 => int64:5
+eval r11 => int64:7
+eval r12 => string:"1undefined"
+eval r13 => int64:301
+eval r14 => int64:4251
+eval r15 => int64:3
+eval typeof n2 => string:"object"
+eval typeof n3 => string:"undefined"
+eval sides => int64:0
+  setOnThis = object:{}
+  f = object:{}
+  r1 = int64:13
+  d = object:{}
+  r2 = int64:13
+  kept = object:{this:{root},v:5,}
+  keep = object:{}
+  g = object:{}
+  r3 = int64:5
+  rec = object:{}
+  r4 = undefined:undefined
+  h = object:{}
+  r5 = int64:7
+  both = object:{}
+  q = int64:9
+  obj = object:{q:1,both:{},}
+  r6 = int64:9
+  r7 = int64:1
+  usesArgsLater = object:{}
+  r8 = int64:2
+  w = object:{}
+  r9 = int64:54
+  cond = object:{}
+  r10 = int64:5
+  noret = object:{}
+  r11 = int64:7
+  deep = object:{}
+  inner1 = object:{}
+  inner2 = object:{}
+  r12 = string:"1undefined"
+  logical = object:{}
+  r13 = int64:301
+  post = object:{}
+  r14 = int64:4251
+  sides = int64:0
+  side = object:{}
+  newer = object:{}
+  n1 = object:{v:3,}
+  proto = object:{k:1,}
+  n2 = object:{prototype:{k:1,},}
+  five = int64:5
+  n3 = undefined:undefined
+  r15 = int64:3
+)js" },
+
+        { R"js(function setOnThis() { this.a = 10; this.extra = 3; }
+function f() { var a = 1; setOnThis(); return a + extra; }
+var r1 = f();
+function d() { var t = 0; var i = 0; do { i++; if (i == 2) continue; t += i; } while (i < 5); return t; }
+var r2 = d();
+var kept;
+function keep() { kept = this; }
+function g() { var v = 4; keep(); v = 5; return kept.v; }
+var r3 = g();
+function rec (n) { var x = n; if (n > 0) rec (n - 1); return this.x; }
+var r4 = rec (3);
+function h() { var z; z = 2; var z = 7; return z; }
+var r5 = h();
+function both() { return this.q; }
+var q = 9; var obj = { q: 1, both: both };
+var r6 = both(); var r7 = obj.both();
+function usesArgsLater (a, a) { return a; }
+var r8 = usesArgsLater (1, 2);
+function w() { var i = 0; while (true) { if (++i > 3) break; } for (;;) { i += 10; if (i > 50) break; } return i; }
+var r9 = w();
+function cond (p) { var a = 0, b = 0; p ? a : b = 5; return a * 10 + b; }
+var r10 = cond (true) + cond (false);
+function noret() { for (var i = 0; i < 3; ++i) { if (i == 1) return i * 7; } }
+var r11 = noret();
+function deep() { var l = 1; return inner1(); }
+function inner1() { return inner2(); }
+function inner2() { return l + typeof this.l; }
+var r12 = deep();
+function logical() { var a = 0; var b = (a++ || a++) && a++; return a * 100 + b; }
+var r13 = logical();
+function post() { var o = { c: 1 }; var arr = [5]; var x = o.c++; var y = arr[0]--; return x + y * 10 + o.c * 100 + arr[0] * 1000; }
+var r14 = post();
+var sides = 0; function side() { sides++; }
+function newer (v) { this.v = v; }
+var n1 = new newer (3); var proto = { k: 1 }; var n2 = new proto(); var five = 5; var n3 = new five (side());
+var r15 = n1.v;
+?r1
+?r2
+?r3
+?r4
+?r5
+?r6
+?r7
+?r8
+?r9
+?r10
+?r11
+?r12
+?r13
+?r14
+?r15
+?typeof n2
+?typeof n3
+?sides
+)js",
+          R"js(exec: ok
+eval r1 => int64:13
+eval r2 => int64:13
+eval r3 => int64:5
+eval r4 => undefined:undefined
+eval r5 => int64:7
+eval r6 => int64:9
+eval r7 => int64:1
+eval r8 => int64:2
+eval r9 => int64:54
+eval r10 => int64:5
+eval r11 => int64:7
+eval r12 => string:"1undefined"
+eval r13 => int64:301
+eval r14 => int64:4251
+eval r15 => int64:3
+eval typeof n2 => string:"object"
+eval typeof n3 => string:"undefined"
+eval sides => int64:0
+  setOnThis = object:{}
+  f = object:{}
+  r1 = int64:13
+  d = object:{}
+  r2 = int64:13
+  kept = object:{this:{root},v:5,}
+  keep = object:{}
+  g = object:{}
+  r3 = int64:5
+  rec = object:{}
+  r4 = undefined:undefined
+  h = object:{}
+  r5 = int64:7
+  both = object:{}
+  q = int64:9
+  obj = object:{q:1,both:{},}
+  r6 = int64:9
+  r7 = int64:1
+  usesArgsLater = object:{}
+  r8 = int64:2
+  w = object:{}
+  r9 = int64:54
+  cond = object:{}
+  r10 = int64:5
+  noret = object:{}
+  r11 = int64:7
+  deep = object:{}
+  inner1 = object:{}
+  inner2 = object:{}
+  r12 = string:"1undefined"
+  logical = object:{}
+  r13 = int64:301
+  post = object:{}
+  r14 = int64:4251
+  sides = int64:0
+  side = object:{}
+  newer = object:{}
+  n1 = object:{v:3,}
+  proto = object:{k:1,}
+  n2 = object:{prototype:{k:1,},}
+  five = int64:5
+  n3 = undefined:undefined
+  r15 = int64:3
+)js" }
+    };
+
+    return cases;
+}
+
+static JavascriptEngineEquivalenceTests javascriptEngineEquivalenceTests;
+
+} // namespace juce
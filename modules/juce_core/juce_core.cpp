@@ -171,18 +171,22 @@
 #include "threads/juce_ReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_TaskScheduler.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
 #include "containers/juce_Variant.cpp"
+#include "detail/juce_UTF8StreamDecoder.h"
 #include "javascript/juce_JSON.cpp"
+#include "javascript/juce_JSONStream.cpp"
 #include "javascript/juce_JSONUtils.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlStream.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
@@ -285,7 +289,9 @@
  #include "misc/juce_EnumHelpers_test.cpp"
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "javascript/juce_JSONSerialisation_test.cpp"
+ #include "javascript/juce_Javascript_test.cpp"
  #include "memory/juce_SharedResourcePointer_test.cpp"
+ #include "threads/juce_TaskScheduler_test.cpp"
  #if JUCE_MAC || JUCE_IOS
   #include "native/juce_ObjCHelpers_mac_test.mm"
  #endif
@@ -252,6 +252,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "memory/juce_WeakReference.h"
 #include "threads/juce_ScopedLock.h"
 #include "threads/juce_CriticalSection.h"
+#include "threads/juce_SpinLock.h"
 #include "maths/juce_Range.h"
 #include "maths/juce_NormalisableRange.h"
 #include "maths/juce_StatisticsAccumulator.h"
@@ -310,6 +311,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "files/juce_WildcardFileFilter.h"
 #include "streams/juce_FileInputSource.h"
 #include "logging/juce_FileLogger.h"
+#include "javascript/juce_JSONStream.h"
 #include "javascript/juce_JSONUtils.h"
 #include "serialisation/juce_Serialisation.h"
 #include "javascript/juce_JSONSerialisation.h"
@@ -323,12 +325,12 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "threads/juce_DynamicLibrary.h"
 #include "threads/juce_InterProcessLock.h"
 #include "threads/juce_Process.h"
-#include "threads/juce_SpinLock.h"
 #include "threads/juce_WaitableEvent.h"
 #include "threads/juce_Thread.h"
 #include "threads/juce_HighResolutionTimer.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
+#include "threads/juce_TaskScheduler.h"
 #include "threads/juce_TimeSliceThread.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
@@ -344,6 +346,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "unit_tests/juce_UnitTest.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlStream.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
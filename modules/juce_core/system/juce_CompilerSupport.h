@@ -100,6 +100,30 @@
  #error "JUCE requires C++17 or later"
 #endif
 
+//==============================================================================
+/** Code between JUCE_BEGIN_TARGET_INSTRUCTION_SET ("name") and
+    JUCE_END_TARGET_INSTRUCTION_SET is compiled for an instruction set that the rest of
+    the build may not target, e.g. "avx2", so that it can use that set's intrinsics.
+    Only call it after checking that the CPU supports the instruction set, e.g. with
+    SystemStats::hasAVX2().
+
+    Multiplies and adds in the code are never fused, even if the instruction set has
+    FMA, so that its floating point results match the code outside it.
+*/
+#if JUCE_CLANG
+ #define JUCE_BEGIN_TARGET_INSTRUCTION_SET(name)    _Pragma (JUCE_STRINGIFY (clang attribute push (__attribute__ ((target (name))), apply_to = function))) \
+                                                    _Pragma ("float_control (push)") _Pragma ("clang fp contract (off)")
+ #define JUCE_END_TARGET_INSTRUCTION_SET            _Pragma ("float_control (pop)") _Pragma ("clang attribute pop")
+#elif JUCE_GCC
+ #define JUCE_BEGIN_TARGET_INSTRUCTION_SET(name)    _Pragma ("GCC push_options") _Pragma (JUCE_STRINGIFY (GCC target (name))) \
+                                                    _Pragma ("GCC optimize (\"fp-contract=off\")")
+ #define JUCE_END_TARGET_INSTRUCTION_SET            _Pragma ("GCC pop_options")
+#else
+ // MSVC allows any intrinsics to be used without changing the target
+ #define JUCE_BEGIN_TARGET_INSTRUCTION_SET(name)
+ #define JUCE_END_TARGET_INSTRUCTION_SET
+#endif
+
 //==============================================================================
 #ifndef DOXYGEN
  // These are old flags that are now supported on all compatible build targets
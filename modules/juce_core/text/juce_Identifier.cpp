@@ -26,38 +26,46 @@ namespace juce
 Identifier::Identifier() noexcept {}
 Identifier::~Identifier() noexcept {}
 
-Identifier::Identifier (const Identifier& other) noexcept  : name (other.name) {}
+Identifier::Identifier (const Identifier& other) noexcept  : name (other.name), hash (other.hash) {}
 
-Identifier::Identifier (Identifier&& other) noexcept : name (std::move (other.name)) {}
+Identifier::Identifier (Identifier&& other) noexcept
+    : name (std::move (other.name)), hash (std::exchange (other.hash, 0u)) {}
 
 Identifier& Identifier::operator= (Identifier&& other) noexcept
 {
     name = std::move (other.name);
+    hash = std::exchange (other.hash, 0u);
     return *this;
 }
 
 Identifier& Identifier::operator= (const Identifier& other) noexcept
 {
     name = other.name;
+    hash = other.hash;
     return *this;
 }
 
+Identifier::Identifier (StringPool::HashedString pooled) noexcept
+    : name (std::move (pooled.text)), hash (pooled.hash)
+{
+}
+
 Identifier::Identifier (const String& nm)
-    : name (StringPool::getGlobalPool().getPooledString (nm))
+    : Identifier (StringPool::getGlobalPool().getPooledStringWithHash (nm))
 {
     // An Identifier cannot be created from an empty string!
     jassert (nm.isNotEmpty());
 }
 
 Identifier::Identifier (const char* nm)
-    : name (StringPool::getGlobalPool().getPooledString (nm))
+    : Identifier (StringPool::getGlobalPool().getPooledStringWithHash (nm))
 {
     // An Identifier cannot be created from an empty string!
     jassert (nm != nullptr && nm[0] != 0);
 }
 
 Identifier::Identifier (String::CharPointerType start, String::CharPointerType end)
-    : name (StringPool::getGlobalPool().getPooledString (start, end))
+    : Identifier (StringPool::getGlobalPool().getPooledStringWithHash (start, end))
 {
     // An Identifier cannot be created from an empty string!
     jassert (start < end);
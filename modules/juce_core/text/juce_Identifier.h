@@ -116,6 +116,13 @@ public:
     /** Returns true if this Identifier is null */
     bool isNull() const noexcept                                        { return name.isEmpty(); }
 
+    /** Returns a hash code for this identifier.
+        This is calculated once when the identifier is created, so it's very fast to call.
+        It's the same value that StringPool::getHashCode() returns for the identifier's name,
+        and is 0 for a null identifier.
+    */
+    uint32 getHashCode() const noexcept                                 { return hash; }
+
     /** A null identifier. */
     static Identifier null;
 
@@ -126,7 +133,10 @@ public:
     static bool isValidIdentifier (const String& possibleIdentifier) noexcept;
 
 private:
+    explicit Identifier (StringPool::HashedString) noexcept;
+
     String name;
+    uint32 hash = 0;
 };
 
 } // namespace juce
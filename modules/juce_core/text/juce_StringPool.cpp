@@ -23,136 +23,144 @@
 namespace juce
 {
 
-static const int minNumberOfStringsForGarbageCollection = 300;
-static const uint32 garbageCollectionInterval = 30000;
+static constexpr size_t minNumberOfStringsForGarbageCollection = 300;
+static constexpr uint32 garbageCollectionInterval = 30000;
 
 
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
+StringPool::StringPool() noexcept {}
 
-struct StartEndString
+// 32-bit FNV-1a, over the bytes of the string in its internal encoding
+static uint32 hashStringBytes (const void* data, size_t numBytes) noexcept
 {
-    StartEndString (String::CharPointerType s, String::CharPointerType e) noexcept : start (s), end (e) {}
-    operator String() const   { return String (start, end); }
+    auto* bytes = static_cast<const uint8*> (data);
+    uint32 hash = 2166136261u;
 
-    String::CharPointerType start, end;
-};
+    for (size_t i = 0; i < numBytes; ++i)
+        hash = (hash ^ bytes[i]) * 16777619u;
 
-static int compareStrings (const String& s1, const String& s2) noexcept     { return s1.compare (s2); }
-static int compareStrings (CharPointer_UTF8 s1, const String& s2) noexcept  { return s1.compare (s2.getCharPointer()); }
+    return hash;
+}
 
-static int compareStrings (const StartEndString& string1, const String& string2) noexcept
+static size_t getNumBytesWithoutTerminator (String::CharPointerType text) noexcept
 {
-    String::CharPointerType s1 (string1.start), s2 (string2.getCharPointer());
-
-    for (;;)
-    {
-        const int c1 = s1 < string1.end ? (int) s1.getAndAdvance() : 0;
-        const int c2 = (int) s2.getAndAdvance();
-        const int diff = c1 - c2;
-
-        if (diff != 0)  return diff < 0 ? -1 : 1;
-        if (c1 == 0)    break;
-    }
-
-    return 0;
+    return text.sizeInBytes() - sizeof (String::CharPointerType::CharType);
 }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+static bool stringMatches (const String& pooled, const void* data, size_t numBytes) noexcept
 {
-    int start = 0;
-    int end = strings.size();
+    const auto text = pooled.getCharPointer();
+    return getNumBytesWithoutTerminator (text) == numBytes
+            && std::memcmp (text.getAddress(), data, numBytes) == 0;
+}
 
-    while (start < end)
-    {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+template <typename CreateString>
+StringPool::HashedString StringPool::addPooledString (String::CharPointerType text, size_t numBytes, CreateString&& createString)
+{
+    const auto hash = hashStringBytes (text.getAddress(), numBytes);
+    auto& shard = shards[hash % numShards];
 
-        if (startComp == 0)
-            return startString;
+    const ScopedLock sl (shard.lock);
 
-        const int halfway = (start + end) / 2;
+    for (auto [it, end] = shard.strings.equal_range (hash); it != end; ++it)
+        if (stringMatches (it->second, text.getAddress(), numBytes))
+            return { it->second, hash };
 
-        if (halfway == start)
-        {
-            if (startComp > 0)
-                ++start;
+    garbageCollectIfNeeded (shard);
+    return { shard.strings.emplace (hash, createString())->second, hash };
+}
 
-            break;
-        }
+String StringPool::getPooledString (const char* const newString)
+{
+    return getPooledStringWithHash (newString).text;
+}
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
+{
+    return getPooledStringWithHash (start, end).text;
+}
 
-        if (halfwayComp == 0)
-            return halfwayString;
+String StringPool::getPooledString (StringRef newString)
+{
+    return getPooledStringWithHash (newString).text;
+}
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
-    }
+String StringPool::getPooledString (const String& newString)
+{
+    if (newString.isEmpty())
+        return {};
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    const auto text = newString.getCharPointer();
+    return addPooledString (text, getNumBytesWithoutTerminator (text),
+                            [&newString] { return newString; }).text;
 }
 
-String StringPool::getPooledString (const char* const newString)
+StringPool::HashedString StringPool::getPooledStringWithHash (const char* const newString)
 {
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    if constexpr (std::is_same_v<String::CharPointerType, CharPointer_UTF8>)
+        return addPooledString (CharPointer_UTF8 (newString), std::strlen (newString),
+                                [newString] { return String (CharPointer_UTF8 (newString)); });
+    else
+        return getPooledStringWithHash (String (CharPointer_UTF8 (newString)));
 }
 
-String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
+StringPool::HashedString StringPool::getPooledStringWithHash (StringRef newString)
 {
-    if (start.isEmpty() || start == end)
+    if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return addPooledString (newString.text, getNumBytesWithoutTerminator (newString.text),
+                            [newString] { return String (newString.text); });
 }
 
-String StringPool::getPooledString (StringRef newString)
+StringPool::HashedString StringPool::getPooledStringWithHash (String::CharPointerType start, String::CharPointerType end)
 {
-    if (newString.isEmpty())
+    if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    const auto numBytes = (size_t) (end.getAddress() - start.getAddress()) * sizeof (String::CharPointerType::CharType);
+
+    return addPooledString (start, numBytes,
+                            [start, end] { return String (start, end); });
 }
 
-String StringPool::getPooledString (const String& newString)
+uint32 StringPool::getHashCode (StringRef text) noexcept
 {
-    if (newString.isEmpty())
-        return {};
+    if (text.isEmpty())
+        return 0;
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
+    return hashStringBytes (text.text.getAddress(), getNumBytesWithoutTerminator (text.text));
 }
 
-void StringPool::garbageCollectIfNeeded()
+void StringPool::garbageCollectIfNeeded (Shard& shard)
 {
-    if (strings.size() > minNumberOfStringsForGarbageCollection
-         && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
-        garbageCollect();
+    if (shard.strings.size() > minNumberOfStringsForGarbageCollection / numShards
+         && Time::getApproximateMillisecondCounter() > shard.lastGarbageCollectionTime + garbageCollectionInterval)
+        garbageCollect (shard);
 }
 
-void StringPool::garbageCollect()
+void StringPool::garbageCollect (Shard& shard)
 {
-    const ScopedLock sl (lock);
+    for (auto it = shard.strings.begin(); it != shard.strings.end();)
+    {
+        if (it->second.getReferenceCount() == 1)
+            it = shard.strings.erase (it);
+        else
+            ++it;
+    }
 
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference (i).getReferenceCount() == 1)
-            strings.remove (i);
+    shard.lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+}
 
-    lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+void StringPool::garbageCollect()
+{
+    for (auto& shard : shards)
+    {
+        const ScopedLock sl (shard.lock);
+        garbageCollect (shard);
+    }
 }
 
 StringPool& StringPool::getGlobalPool() noexcept
@@ -161,4 +169,134 @@ StringPool& StringPool::getGlobalPool() noexcept
     return pool;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StringPoolTests final : public UnitTest
+{
+public:
+    StringPoolTests()
+        : UnitTest ("StringPool", UnitTestCategories::text)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Matching strings are pooled into the same object");
+        {
+            StringPool pool;
+
+            const String original ("someName");
+            const auto a = pool.getPooledString (original);
+            const auto b = pool.getPooledString ("someName");
+            const auto c = pool.getPooledString (StringRef ("someName"));
+
+            const String longer ("someNameThatIsLonger");
+            const auto d = pool.getPooledString (longer.getCharPointer(), longer.getCharPointer() + 8);
+
+            expect (a.getCharPointer() == b.getCharPointer());
+            expect (a.getCharPointer() == c.getCharPointer());
+            expect (a.getCharPointer() == d.getCharPointer());
+            expectEquals (d, original);
+
+            const auto e = pool.getPooledString ("someNam");
+            const auto f = pool.getPooledString ("someNamex");
+            expect (e.getCharPointer() != a.getCharPointer());
+            expect (f.getCharPointer() != a.getCharPointer());
+            expectEquals (e, String ("someNam"));
+
+            expect (pool.getPooledString (String()).isEmpty());
+            expect (pool.getPooledString ((const char*) nullptr).isEmpty());
+        }
+
+        beginTest ("Unreferenced strings are garbage collected");
+        {
+            StringPool pool;
+
+            // When a pool is given a String that it doesn't already have, it keeps that
+            // String's own text, so a pooled string is only new if it shares its text
+            const auto isNewlyPooled = [&pool] (const String& s)
+            {
+                return pool.getPooledString (s).getCharPointer() == s.getCharPointer();
+            };
+
+            const auto makeTemporary = [] { return String ("temporary") + String (1234); };
+
+            {
+                const auto s = makeTemporary();
+                expect (isNewlyPooled (s));
+                expectEquals (s.getReferenceCount(), 2);
+            }
+
+            const auto kept = pool.getPooledString (String ("kept"));
+            expect (! isNewlyPooled (makeTemporary()));
+
+            pool.garbageCollect();
+
+            expect (isNewlyPooled (makeTemporary()));
+            expect (! isNewlyPooled (String ("kept")));
+            expect (kept.getCharPointer() == pool.getPooledString ("kept").getCharPointer());
+            expectEquals (kept.getReferenceCount(), 2);
+        }
+
+        beginTest ("Identifiers store the hash of their name");
+        {
+            const Identifier a ("someProperty"), b (String ("someProperty")), c ("someOtherProperty");
+
+            expect (a == b);
+            expect (a.getHashCode() == b.getHashCode());
+            expect (a.getHashCode() == StringPool::getHashCode ("someProperty"));
+            expect (a.getHashCode() != c.getHashCode());
+            expect (Identifier().getHashCode() == 0);
+
+            Identifier moved (std::move (c));
+            expect (moved.getHashCode() == StringPool::getHashCode ("someOtherProperty"));
+
+            HashMap<Identifier, int> map;
+            map.set (a, 1);
+            map.set (moved, 2);
+            expectEquals (map[b], 1);
+            expectEquals (map[Identifier ("someOtherProperty")], 2);
+        }
+
+        beginTest ("Identifiers can be created from many threads at once");
+        {
+            constexpr int numThreads = 8;
+            constexpr int numNames = 2000;
+
+            StringArray names;
+
+            for (int i = 0; i < numNames; ++i)
+                names.add ("property_" + String (i * 7919));
+
+            std::vector<std::vector<Identifier>> results ((size_t) numThreads);
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back ([&names, &result = results[(size_t) t]]
+                {
+                    for (auto& n : names)
+                        result.emplace_back (n);
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+
+            bool allMatch = true;
+
+            for (int i = 0; i < numNames; ++i)
+                for (int t = 1; t < numThreads; ++t)
+                    allMatch = allMatch && results[(size_t) t][(size_t) i] == results[0][(size_t) i];
+
+            expect (allMatch);
+        }
+    }
+};
+
+static StringPoolTests stringPoolTests;
+
+#endif
+
 } // namespace juce
@@ -34,6 +34,10 @@ namespace juce
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
 
+    The strings are kept in a hash table that is split into a number of shards, each with
+    its own lock, so many threads can look up strings at the same time without all waiting
+    for each other.
+
     @tags{Core}
 */
 class JUCE_API  StringPool
@@ -64,6 +68,37 @@ public:
     */
     String getPooledString (String::CharPointerType start, String::CharPointerType end);
 
+    //==============================================================================
+    /** A pooled string, along with the hash code that the pool used to find it. */
+    struct HashedString
+    {
+        String text;
+        uint32 hash = 0;
+    };
+
+    /** Returns a shared copy of the string that is passed in, along with its hash code.
+        This does the same thing as getPooledString(), but saves having to calculate the
+        hash again if the caller needs it.
+    */
+    HashedString getPooledStringWithHash (const char* original);
+
+    /** Returns a shared copy of the string that is passed in, along with its hash code.
+        This does the same thing as getPooledString(), but saves having to calculate the
+        hash again if the caller needs it.
+    */
+    HashedString getPooledStringWithHash (StringRef original);
+
+    /** Returns a shared copy of the string that is passed in, along with its hash code.
+        This does the same thing as getPooledString(), but saves having to calculate the
+        hash again if the caller needs it.
+    */
+    HashedString getPooledStringWithHash (String::CharPointerType start, String::CharPointerType end);
+
+    /** Returns the hash code that a pool will use for a given string.
+        An empty string always has a hash code of 0.
+    */
+    static uint32 getHashCode (StringRef text) noexcept;
+
     //==============================================================================
     /** Scans the pool, and removes any strings that are unreferenced.
         You don't generally need to call this - it'll be called automatically when the pool grows
@@ -75,11 +110,21 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    struct alignas (64) Shard
+    {
+        std::unordered_multimap<uint32, String> strings;
+        CriticalSection lock;
+        uint32 lastGarbageCollectionTime = 0;
+    };
+
+    static constexpr uint32 numShards = 32;
+    std::array<Shard, numShards> shards;
+
+    template <typename CreateString>
+    HashedString addPooledString (String::CharPointerType text, size_t numBytes, CreateString&&);
 
-    void garbageCollectIfNeeded();
+    static void garbageCollect (Shard&);
+    static void garbageCollectIfNeeded (Shard&);
 
     JUCE_DECLARE_NON_COPYABLE (StringPool)
 };
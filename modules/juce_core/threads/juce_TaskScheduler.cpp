@@ -0,0 +1,491 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+struct TaskScheduler::TaskSlot
+{
+    Task task;
+    TaskGroup* group = nullptr;
+    std::atomic<bool> inUse { false };
+};
+
+//==============================================================================
+/*  A fixed number of task slots. Any thread may claim or release a slot. */
+class TaskScheduler::TaskStorage
+{
+public:
+    explicit TaskStorage (size_t numSlots)
+        : slots (std::make_unique<TaskSlot[]> (numSlots)), size (numSlots) {}
+
+    TaskSlot* allocate() noexcept
+    {
+        const auto start = nextSlot.load (std::memory_order_relaxed);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const auto index = (start + i) % size;
+            auto& slot = slots[index];
+            auto expected = false;
+
+            if (! slot.inUse.load (std::memory_order_relaxed)
+                && slot.inUse.compare_exchange_strong (expected, true, std::memory_order_acquire))
+            {
+                nextSlot.store (index + 1, std::memory_order_relaxed);
+                return &slot;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static void release (TaskSlot& slot) noexcept
+    {
+        slot.task = nullptr;
+        slot.group = nullptr;
+        slot.inUse.store (false, std::memory_order_release);
+    }
+
+private:
+    std::unique_ptr<TaskSlot[]> slots;
+    const size_t size;
+    std::atomic<size_t> nextSlot { 0 };
+};
+
+//==============================================================================
+/*  A fixed-capacity Chase-Lev work-stealing deque.
+
+    The owning thread pushes and pops at the bottom, other threads steal from the top.
+    See "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al, 2013).
+*/
+class TaskScheduler::WorkDeque
+{
+public:
+    explicit WorkDeque (size_t capacityPowerOfTwo)
+        : items (std::make_unique<std::atomic<TaskSlot*>[]> (capacityPowerOfTwo)),
+          capacity ((int64) capacityPowerOfTwo)
+    {
+        jassert (isPowerOfTwo (capacity));
+    }
+
+    /*  Call from the owning thread only. Returns false if the deque is full. */
+    bool push (TaskSlot* slot) noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed);
+        const auto t = top.load (std::memory_order_acquire);
+
+        if (b - t >= capacity)
+            return false;
+
+        getItem (b).store (slot, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        bottom.store (b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /*  Call from the owning thread only. */
+    TaskSlot* pop() noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed) - 1;
+        bottom.store (b, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        auto t = top.load (std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store (b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* slot = getItem (b).load (std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            // This is the last item, so we may be racing with a thief
+            if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                slot = nullptr;
+
+            bottom.store (b + 1, std::memory_order_relaxed);
+        }
+
+        return slot;
+    }
+
+    /*  May be called from any thread. */
+    TaskSlot* steal() noexcept
+    {
+        auto t = top.load (std::memory_order_acquire);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        const auto b = bottom.load (std::memory_order_acquire);
+
+        if (t >= b)
+            return nullptr;
+
+        auto* slot = getItem (t).load (std::memory_order_relaxed);
+
+        if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return slot;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return bottom.load (std::memory_order_acquire) <= top.load (std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<TaskSlot*>& getItem (int64 index) const noexcept { return items[(size_t) (index & (capacity - 1))]; }
+
+    std::unique_ptr<std::atomic<TaskSlot*>[]> items;
+    const int64 capacity;
+    std::atomic<int64> top { 0 }, bottom { 0 };
+};
+
+//==============================================================================
+/*  A bounded lock-free queue which any thread may push to or pop from, used for tasks that
+    are submitted from threads that don't belong to the scheduler.
+    See Dmitry Vyukov's "Bounded MPMC queue".
+*/
+class TaskScheduler::SharedQueue
+{
+public:
+    explicit SharedQueue (size_t capacityPowerOfTwo)
+        : cells (std::make_unique<Cell[]> (capacityPowerOfTwo)),
+          mask (capacityPowerOfTwo - 1)
+    {
+        jassert (isPowerOfTwo (capacityPowerOfTwo));
+
+        for (size_t i = 0; i < capacityPowerOfTwo; ++i)
+            cells[i].sequence.store (i, std::memory_order_relaxed);
+    }
+
+    bool push (TaskSlot* slot) noexcept
+    {
+        auto position = writePosition.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[position & mask];
+            const auto sequence = cell.sequence.load (std::memory_order_acquire);
+            const auto difference = (intptr_t) sequence - (intptr_t) position;
+
+            if (difference == 0)
+            {
+                if (writePosition.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.slot = slot;
+                    cell.sequence.store (position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = writePosition.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    TaskSlot* pop() noexcept
+    {
+        auto position = readPosition.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[position & mask];
+            const auto sequence = cell.sequence.load (std::memory_order_acquire);
+            const auto difference = (intptr_t) sequence - (intptr_t) (position + 1);
+
+            if (difference == 0)
+            {
+                if (readPosition.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                {
+                    auto* slot = cell.slot;
+                    cell.sequence.store (position + mask + 1, std::memory_order_release);
+                    return slot;
+                }
+            }
+            else if (difference < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                position = readPosition.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return readPosition.load (std::memory_order_acquire) >= writePosition.load (std::memory_order_acquire);
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence { 0 };
+        TaskSlot* slot = nullptr;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    const size_t mask;
+    std::atomic<size_t> writePosition { 0 }, readPosition { 0 };
+};
+
+//==============================================================================
+static thread_local void* currentTaskSchedulerWorker = nullptr;
+
+struct TaskScheduler::WorkerThread final : public Thread
+{
+    WorkerThread (TaskScheduler& s, const Options& options, size_t queueSize)
+        : Thread (options.threadName, options.threadStackSizeBytes),
+          scheduler (s),
+          storage (queueSize),
+          deque (queueSize)
+    {
+    }
+
+    void run() override
+    {
+        currentTaskSchedulerWorker = this;
+
+        while (! threadShouldExit())
+        {
+            if (auto* slot = scheduler.findTask (this))
+            {
+                execute (*slot);
+                numIdleLoops = 0;
+                continue;
+            }
+
+            // Stay awake for a short while, as more work is likely to arrive soon
+            if (++numIdleLoops < 64)
+            {
+                Thread::yield();
+                continue;
+            }
+
+            isSleeping.store (true);
+
+            if (! scheduler.hasQueuedTasks())
+                wait (100);
+
+            isSleeping.store (false);
+            numIdleLoops = 0;
+        }
+
+        currentTaskSchedulerWorker = nullptr;
+    }
+
+    TaskScheduler& scheduler;
+    TaskStorage storage;
+    WorkDeque deque;
+    std::atomic<bool> isSleeping { false };
+    int numIdleLoops = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerThread)
+};
+
+//==============================================================================
+TaskScheduler::TaskScheduler (const Options& options)
+{
+    // not much point having a scheduler without any threads!
+    jassert (options.numberOfThreads > 0);
+
+    const auto queueSize = (size_t) nextPowerOfTwo (jmax (16, options.maxQueuedTasksPerThread));
+    const auto numThreads = jmax (1, options.numberOfThreads);
+
+    sharedStorage = std::make_unique<TaskStorage> (queueSize);
+    sharedQueue = std::make_unique<SharedQueue> (queueSize);
+
+    for (int i = 0; i < numThreads; ++i)
+        threads.add (new WorkerThread (*this, options, queueSize));
+
+    for (auto* t : threads)
+        t->startThread (options.desiredThreadPriority);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    // Make sure that all of your TaskGroups have finished before deleting the scheduler!
+    jassert (! hasQueuedTasks());
+
+    for (auto* t : threads)
+    {
+        t->signalThreadShouldExit();
+        t->notify();
+    }
+
+    // Each worker finishes the task it's running before it exits, so this never has to
+    // kill a thread. A task that's waiting on a group keeps running the group's tasks,
+    // so it can't get stuck waiting for a thread that has already stopped.
+    for (auto* t : threads)
+        t->stopThread (-1);
+
+    // Anything that was left in the queues still has a group counting on it, so run it here
+    while (runNextTask()) {}
+}
+
+int TaskScheduler::getNumThreads() const noexcept
+{
+    return threads.size();
+}
+
+TaskScheduler::WorkerThread* TaskScheduler::getCurrentWorker() const noexcept
+{
+    auto* worker = static_cast<WorkerThread*> (currentTaskSchedulerWorker);
+    return worker != nullptr && &worker->scheduler == this ? worker : nullptr;
+}
+
+void TaskScheduler::submit (Task&& task, TaskGroup& group)
+{
+    group.numPendingTasks.fetch_add (1, std::memory_order_relaxed);
+
+    auto* worker = getCurrentWorker();
+    auto& storage = worker != nullptr ? worker->storage : *sharedStorage;
+
+    if (auto* slot = storage.allocate())
+    {
+        slot->task = std::move (task);
+        slot->group = &group;
+
+        if (worker != nullptr ? worker->deque.push (slot) : sharedQueue->push (slot))
+        {
+            wakeSleepingThread();
+            return;
+        }
+
+        execute (*slot);
+        return;
+    }
+
+    // All the slots are in use, so just run the task here
+    TaskSlot slot;
+    slot.task = std::move (task);
+    slot.group = &group;
+    execute (slot);
+}
+
+void TaskScheduler::execute (TaskSlot& slot)
+{
+    try
+    {
+        slot.task();
+    }
+    catch (...)
+    {
+        jassertfalse; // Your tasks mustn't throw any exceptions!
+    }
+
+    auto* group = slot.group;
+    TaskStorage::release (slot);
+
+    // Once this is decremented, a thread waiting on the group may delete it
+    group->numPendingTasks.fetch_sub (1, std::memory_order_acq_rel);
+}
+
+TaskScheduler::TaskSlot* TaskScheduler::findTask (WorkerThread* worker)
+{
+    if (worker != nullptr)
+        if (auto* slot = worker->deque.pop())
+            return slot;
+
+    if (auto* slot = sharedQueue->pop())
+        return slot;
+
+    const auto numThreads = threads.size();
+    const auto firstVictim = worker != nullptr ? threads.indexOf (worker) + 1 : 0;
+
+    for (int i = 0; i < numThreads; ++i)
+    {
+        auto* victim = threads.getUnchecked ((firstVictim + i) % numThreads);
+
+        if (victim != worker)
+            if (auto* slot = victim->deque.steal())
+                return slot;
+    }
+
+    return nullptr;
+}
+
+bool TaskScheduler::runNextTask()
+{
+    if (auto* slot = findTask (getCurrentWorker()))
+    {
+        execute (*slot);
+        return true;
+    }
+
+    return false;
+}
+
+bool TaskScheduler::hasQueuedTasks() const noexcept
+{
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    return ! sharedQueue->isEmpty()
+        || std::any_of (threads.begin(), threads.end(), [] (const auto* t) { return ! t->deque.isEmpty(); });
+}
+
+void TaskScheduler::wakeSleepingThread()
+{
+    // Pairs with the check in hasQueuedTasks(), so that a thread that is about to go to sleep
+    // either sees the new task or is woken up. WaitableEvent stays signalled until the thread
+    // next waits, so a wake-up can't be missed in between.
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    for (auto* t : threads)
+    {
+        if (t->isSleeping.load (std::memory_order_relaxed))
+        {
+            t->notify();
+            return;
+        }
+    }
+}
+
+//==============================================================================
+TaskScheduler::TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+void TaskScheduler::TaskGroup::run (Task task)
+{
+    scheduler.submit (std::move (task), *this);
+}
+
+void TaskScheduler::TaskGroup::wait()
+{
+    while (! isFinished())
+        if (! scheduler.runNextTask())
+            Thread::yield();
+}
+
+} // namespace juce
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Options used to construct a TaskScheduler.
+
+    @see TaskScheduler
+
+    @tags{Core}
+*/
+struct TaskSchedulerOptions
+{
+    /** The name to give each thread in the scheduler. */
+    [[nodiscard]] TaskSchedulerOptions withThreadName (String newThreadName) const
+    {
+        return withMember (*this, &TaskSchedulerOptions::threadName, newThreadName);
+    }
+
+    /** The number of threads to run.
+        These will be started when the scheduler is created, and run until it is destroyed.
+    */
+    [[nodiscard]] TaskSchedulerOptions withNumberOfThreads (int newNumberOfThreads) const
+    {
+        return withMember (*this, &TaskSchedulerOptions::numberOfThreads, newNumberOfThreads);
+    }
+
+    /** The size of the stack of each thread in the scheduler. */
+    [[nodiscard]] TaskSchedulerOptions withThreadStackSizeBytes (size_t newThreadStackSizeBytes) const
+    {
+        return withMember (*this, &TaskSchedulerOptions::threadStackSizeBytes, newThreadStackSizeBytes);
+    }
+
+    /** The desired priority of each thread in the scheduler. */
+    [[nodiscard]] TaskSchedulerOptions withDesiredThreadPriority (Thread::Priority newDesiredThreadPriority) const
+    {
+        return withMember (*this, &TaskSchedulerOptions::desiredThreadPriority, newDesiredThreadPriority);
+    }
+
+    /** The number of tasks that each thread can have queued at once.
+        This will be rounded up to a power of two. Tasks that are submitted while a queue is
+        full will be run immediately on the thread that submits them.
+    */
+    [[nodiscard]] TaskSchedulerOptions withMaxQueuedTasksPerThread (int newMaxQueuedTasksPerThread) const
+    {
+        return withMember (*this, &TaskSchedulerOptions::maxQueuedTasksPerThread, newMaxQueuedTasksPerThread);
+    }
+
+    String threadName { "Task Scheduler" };
+    int numberOfThreads { SystemStats::getNumCpus() };
+    size_t threadStackSizeBytes { Thread::osDefaultStackSize };
+    Thread::Priority desiredThreadPriority { Thread::Priority::normal };
+    int maxQueuedTasksPerThread { 1024 };
+};
+
+//==============================================================================
+/**
+    A set of threads that run large numbers of small tasks with very little overhead.
+
+    Unlike a ThreadPool, which keeps a single locked list of heap-allocated jobs, each
+    thread in a TaskScheduler has its own lock-free work-stealing deque. A thread takes
+    the tasks that it queued itself from one end of its own deque, and when it runs out
+    of work it steals tasks from the other end of another thread's deque. Tasks submitted
+    from threads that don't belong to the scheduler go into a shared lock-free queue.
+
+    Every task is stored as a FixedSizeFunction in storage that is allocated when the
+    scheduler is created, so submitting and running tasks never allocates or locks.
+
+    Tasks are always submitted through a TaskGroup, which can be waited on. A thread that
+    waits on a group will run queued tasks until the group has finished, so groups may be
+    nested freely, and it's safe to wait on a group from inside a task.
+
+    @code
+    TaskScheduler scheduler;
+
+    scheduler.parallelFor (0, numVoices, 4, [&] (int voice)
+    {
+        renderVoice (voice);
+    });
+    @endcode
+
+    @see TaskScheduler::TaskGroup, ThreadPool
+
+    @tags{Core}
+*/
+class JUCE_API  TaskScheduler
+{
+public:
+    using Options = TaskSchedulerOptions;
+
+    /** The largest callable object, in bytes, that can be used as a task.
+        If you need to pass more state than this to a task, capture a pointer or reference
+        to it instead.
+    */
+    static constexpr size_t maxTaskSize = 64;
+
+    /** The type used to store each task. */
+    using Task = FixedSizeFunction<maxTaskSize, void()>;
+
+    //==============================================================================
+    /** Creates a scheduler based on the provided options. */
+    explicit TaskScheduler (const Options& options);
+
+    /** Creates a scheduler using the default arguments provided by TaskSchedulerOptions. */
+    TaskScheduler() : TaskScheduler { Options{} } {}
+
+    /** Destructor.
+
+        Make sure that every TaskGroup that uses this scheduler has finished before deleting it.
+    */
+    ~TaskScheduler();
+
+    /** Returns the number of threads belonging to this scheduler. */
+    int getNumThreads() const noexcept;
+
+    //==============================================================================
+    /**
+        A set of tasks that can be waited on as a whole.
+
+        The group's destructor waits for any unfinished tasks, so a group must always
+        outlive the tasks that it runs.
+
+        @tags{Core}
+    */
+    class JUCE_API  TaskGroup
+    {
+    public:
+        /** Creates a group that will run its tasks on the given scheduler. */
+        explicit TaskGroup (TaskScheduler& schedulerToUse) noexcept : scheduler (schedulerToUse) {}
+
+        /** Destructor. This will wait for all of the group's tasks to finish. */
+        ~TaskGroup();
+
+        /** Queues a task to be run by the scheduler.
+
+            If the scheduler's queues are full, the task will be run immediately on the
+            calling thread instead.
+        */
+        void run (Task task);
+
+        /** Runs queued tasks on the calling thread until every task in this group has
+            finished.
+        */
+        void wait();
+
+        /** Returns true if every task that has been added to this group has finished. */
+        bool isFinished() const noexcept        { return numPendingTasks.load (std::memory_order_acquire) == 0; }
+
+    private:
+        friend class TaskScheduler;
+
+        TaskScheduler& scheduler;
+        std::atomic<int> numPendingTasks { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE (TaskGroup)
+    };
+
+    //==============================================================================
+    /** Calls a function once for every index in the range [begin, end), using the threads of
+        the scheduler as well as the calling thread, and returns when every call has finished.
+
+        Indices are handed out in chunks of grainSize consecutive indices. The order in which
+        the chunks run is unspecified, but the indices within each chunk are visited in order.
+        Larger grain sizes reduce the scheduling overhead, and smaller ones balance the load
+        more evenly between the threads.
+    */
+    template <typename Function>
+    void parallelFor (int begin, int end, int grainSize, Function&& function)
+    {
+        if (end <= begin)
+            return;
+
+        const auto grain = jmax (1, grainSize);
+        const auto numChunks = ((int64) end - begin + grain - 1) / grain;
+        std::atomic<int64> nextIndex { begin };
+
+        const auto runChunks = [&]
+        {
+            for (;;)
+            {
+                const auto chunkStart = nextIndex.fetch_add (grain, std::memory_order_relaxed);
+
+                if (chunkStart >= end)
+                    return;
+
+                for (auto i = (int) chunkStart, chunkEnd = (int) jmin ((int64) end, chunkStart + grain); i < chunkEnd; ++i)
+                    function (i);
+            }
+        };
+
+        // The calling thread works on the chunks too, so only ask for as much help as is useful
+        const auto numHelpers = (int) jmin ((int64) getNumThreads(), numChunks - 1);
+        TaskGroup group (*this);
+
+        for (int i = 0; i < numHelpers; ++i)
+            group.run ([&runChunks] { runChunks(); });
+
+        runChunks();
+        group.wait();
+    }
+
+private:
+    //==============================================================================
+    struct TaskSlot;
+    class TaskStorage;
+    class WorkDeque;
+    class SharedQueue;
+    struct WorkerThread;
+
+    void submit (Task&&, TaskGroup&);
+    bool runNextTask();
+    TaskSlot* findTask (WorkerThread*);
+    bool hasQueuedTasks() const noexcept;
+    void wakeSleepingThread();
+    WorkerThread* getCurrentWorker() const noexcept;
+    static void execute (TaskSlot&);
+
+    OwnedArray<WorkerThread> threads;
+    std::unique_ptr<TaskStorage> sharedStorage;
+    std::unique_ptr<SharedQueue> sharedQueue;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TaskScheduler)
+};
+
+} // namespace juce
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class TaskSchedulerTests final : public UnitTest
+{
+public:
+    TaskSchedulerTests() : UnitTest ("TaskScheduler", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        const auto options = TaskScheduler::Options{}.withNumberOfThreads (4)
+                                                     .withMaxQueuedTasksPerThread (64);
+
+        beginTest ("All tasks in a group are run before wait returns");
+        {
+            TaskScheduler scheduler (options);
+            std::atomic<int> count { 0 };
+
+            {
+                TaskScheduler::TaskGroup group (scheduler);
+
+                for (int i = 0; i < 50; ++i)
+                    group.run ([&count] { ++count; });
+
+                group.wait();
+                expect (group.isFinished());
+                expectEquals (count.load(), 50);
+            }
+        }
+
+        beginTest ("Tasks that don't fit in the queues are run on the calling thread");
+        {
+            TaskScheduler scheduler (options);
+            const auto callingThread = Thread::getCurrentThreadId();
+            std::atomic<int> numOnCallingThread { 0 }, numOnWorkers { 0 };
+            WaitableEvent workersCanFinish (true);
+
+            TaskScheduler::TaskGroup group (scheduler);
+
+            for (int i = 0; i < 10000; ++i)
+            {
+                group.run ([&]
+                {
+                    if (Thread::getCurrentThreadId() == callingThread)
+                    {
+                        ++numOnCallingThread;
+                        return;
+                    }
+
+                    // Keeps each worker busy with its first task, so that the queue fills up
+                    ++numOnWorkers;
+                    workersCanFinish.wait (-1);
+                });
+            }
+
+            // Nothing has waited on the group yet, so the only tasks that can have run on this
+            // thread are the ones that didn't fit in the shared queue of 64 slots
+            expect (numOnCallingThread.load() >= 10000 - 64 - scheduler.getNumThreads());
+            expect (numOnWorkers.load() <= scheduler.getNumThreads());
+
+            workersCanFinish.signal();
+            group.wait();
+            expectEquals (numOnCallingThread.load() + numOnWorkers.load(), 10000);
+        }
+
+        beginTest ("Tasks can create and wait on nested groups");
+        {
+            TaskScheduler scheduler (options);
+            std::atomic<int> count { 0 };
+
+            TaskScheduler::TaskGroup outer (scheduler);
+
+            for (int i = 0; i < 16; ++i)
+            {
+                outer.run ([&scheduler, &count]
+                {
+                    TaskScheduler::TaskGroup inner (scheduler);
+
+                    for (int j = 0; j < 16; ++j)
+                        inner.run ([&count] { ++count; });
+
+                    inner.wait();
+                });
+            }
+
+            outer.wait();
+            expectEquals (count.load(), 16 * 16);
+        }
+
+        beginTest ("Tasks can be submitted from several threads at once");
+        {
+            TaskScheduler scheduler (options);
+            std::atomic<int> count { 0 };
+            constexpr auto numSubmitters = 4;
+            constexpr auto tasksPerSubmitter = 2000;
+
+            std::vector<std::thread> submitters;
+
+            for (int i = 0; i < numSubmitters; ++i)
+            {
+                submitters.emplace_back ([&scheduler, &count]
+                {
+                    TaskScheduler::TaskGroup group (scheduler);
+
+                    for (int j = 0; j < tasksPerSubmitter; ++j)
+                        group.run ([&count] { ++count; });
+
+                    group.wait();
+                });
+            }
+
+            for (auto& t : submitters)
+                t.join();
+
+            expectEquals (count.load(), numSubmitters * tasksPerSubmitter);
+        }
+
+        beginTest ("parallelFor visits every index exactly once");
+        {
+            TaskScheduler scheduler (options);
+
+            for (const auto grainSize : { 1, 7, 64, 5000 })
+            {
+                std::vector<std::atomic<int>> visits (1000);
+
+                scheduler.parallelFor (-200, 800, grainSize, [&visits] (int i)
+                {
+                    ++visits[(size_t) (i + 200)];
+                });
+
+                expect (std::all_of (visits.begin(), visits.end(), [] (const auto& v) { return v.load() == 1; }));
+            }
+
+            auto numCalls = 0;
+            scheduler.parallelFor (10, 10, 1, [&numCalls] (int) { ++numCalls; });
+            expectEquals (numCalls, 0);
+        }
+    }
+};
+
+static TaskSchedulerTests taskSchedulerTests;
+
+} // namespace juce
@@ -206,9 +206,9 @@ namespace XmlOutputFunctions
         }
     }
 
-    static void escapeIllegalXmlChars (OutputStream& outputStream, const String& text, bool changeNewLines)
+    static void escapeIllegalXmlChars (OutputStream& outputStream, StringRef text, bool changeNewLines)
     {
-        auto t = text.getCharPointer();
+        auto t = text.text;
 
         for (;;)
         {
@@ -306,7 +306,7 @@ void XmlElement::writeElementAsText (OutputStream& outputStream,
                         outputStream << newLineChars;
 
                     child->writeElementAsText (outputStream,
-                                               lastWasTextNode ? 0 : (indentationLevel + (indentationLevel >= 0 ? 2 : 0)), lineWrapLength,
+                                               (lastWasTextNode && indentationLevel >= 0) ? 0 : (indentationLevel + (indentationLevel >= 0 ? 2 : 0)), lineWrapLength,
                                                newLineChars);
                     lastWasTextNode = false;
                 }
@@ -774,6 +774,8 @@ private:
     };
 
     friend class XmlDocument;
+    friend class XmlStreamReader;
+    friend class XmlStreamWriter;
     friend class LinkedListPointer<XmlAttributeNode>;
     friend class LinkedListPointer<XmlElement>;
     friend class LinkedListPointer<XmlElement>::Appender;
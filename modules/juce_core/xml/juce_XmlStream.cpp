@@ -0,0 +1,1092 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct XmlStreamReader::Pimpl
+{
+    explicit Pimpl (InputStream& in)  : input (in) {}
+
+    using Event = XmlStreamReader::Event;
+
+    //==============================================================================
+    Event next()
+    {
+        if (failed)    return Event::error;
+        if (finished)  return Event::endOfDocument;
+
+        buffer.reset();
+        attributes.clearQuick();
+        textOffset = tagNameOffset = 0;
+
+       #if JUCE_STRING_UTF_TYPE != 8
+        convertedStrings.clearQuick();
+       #endif
+
+        if (isEmptyElementOpen)
+        {
+            isEmptyElementOpen = false;
+            return popElement();
+        }
+
+        return openTagStarts.empty() ? readDocumentElementStart()
+                                     : readContent();
+    }
+
+    StringRef getString (size_t offset) const noexcept
+    {
+        if (offset >= buffer.getDataSize())
+            return {};
+
+        CharPointer_UTF8 utf8 (static_cast<const CharPointer_UTF8::CharType*> (buffer.getData()) + offset);
+
+       #if JUCE_STRING_UTF_TYPE == 8
+        return StringRef (utf8);
+       #else
+        convertedStrings.add (String (utf8));
+        return StringRef (convertedStrings.getReference (convertedStrings.size() - 1));
+       #endif
+    }
+
+    int findAttribute (StringRef attributeName) const noexcept
+    {
+        for (int i = 0; i < attributes.size(); ++i)
+            if (getString (attributes.getReference (i).name) == attributeName)
+                return i;
+
+        return -1;
+    }
+
+    //==============================================================================
+    struct AttributeOffsets
+    {
+        size_t name, value;
+    };
+
+    detail::UTF8StreamDecoder input;
+    MemoryOutputStream buffer { 256 };
+    Array<AttributeOffsets> attributes;
+    size_t textOffset = 0, tagNameOffset = 0;
+
+    std::vector<char> openTags;
+    std::vector<size_t> openTagStarts;
+
+    String lastError;
+    bool ignoreEmptyTextElements = true, isEmptyElementOpen = false, finished = false, failed = false;
+
+   #if JUCE_STRING_UTF_TYPE != 8
+    mutable Array<String> convertedStrings;
+   #endif
+
+private:
+    enum class Markup { none, element, endTag, cdata };
+    Markup pendingMarkup = Markup::none;
+
+    Event fail (const String& message)
+    {
+        lastError = message;
+        failed = true;
+        return Event::error;
+    }
+
+    static bool isWhitespace (int c) noexcept    { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+    static bool isNameByte (int c) noexcept
+    {
+        // Any byte of a multi-byte UTF-8 sequence is accepted here, so non-ASCII
+        // characters are always treated as legal in names.
+        return c >= 0x80 || (c > 0 && XmlIdentifierChars::isIdentifierChar ((juce_wchar) c));
+    }
+
+    void skipWhitespace()
+    {
+        while (isWhitespace (input.peekByte()))
+            input.readByte();
+    }
+
+    bool readName()
+    {
+        auto start = buffer.getPosition();
+
+        while (isNameByte (input.peekByte()))
+            buffer.writeByte ((char) input.readByte());
+
+        return buffer.getPosition() != start;
+    }
+
+    bool matchSequence (const char* text)
+    {
+        while (*text != 0)
+            if (! input.matchIf (*text++))
+                return false;
+
+        return true;
+    }
+
+    // Reads up to and including the given terminator, optionally copying everything
+    // before it into the buffer. Returns false if the end of the input is reached first.
+    bool readPast (const char* terminator, bool copyToBuffer)
+    {
+        auto length = (int) strlen (terminator);
+        jassert (length <= 4);
+
+        uint32 target = 0, window = 0, mask = (uint32) ((1ull << (8 * length)) - 1);
+
+        for (int i = 0; i < length; ++i)
+            target = (target << 8) | (uint8) terminator[i];
+
+        for (int numRead = 1;; ++numRead)
+        {
+            auto c = input.readByte();
+
+            if (c < 0)
+                return false;
+
+            window = (window << 8) | (uint32) c;
+
+            if (numRead >= length && (window & mask) == target)
+            {
+                if (copyToBuffer)
+                    buffer.setPosition (buffer.getPosition() - (length - 1));
+
+                return true;
+            }
+
+            if (copyToBuffer)
+                buffer.writeByte ((char) c);
+        }
+    }
+
+    //==============================================================================
+    Event readDocumentElementStart()
+    {
+        for (;;)
+        {
+            skipWhitespace();
+
+            if (! input.matchIf ('<'))
+                return fail ("not enough input");
+
+            if (input.matchIf ('?'))
+            {
+                if (! readPast ("?>", false))
+                    return fail ("malformed header");
+            }
+            else if (input.matchIf ('!'))
+            {
+                if (input.matchIf ('-'))
+                {
+                    if (! (input.matchIf ('-') && readPast ("-->", false)))
+                        return fail ("unterminated comment");
+                }
+                else if (! (matchSequence ("DOCTYPE") && skipDTD()))
+                {
+                    return fail ("malformed DTD");
+                }
+            }
+            else
+            {
+                return readStartTag();
+            }
+        }
+    }
+
+    bool skipDTD()
+    {
+        for (int depth = 1; depth > 0;)
+        {
+            auto c = input.readByte();
+
+            if (c < 0)
+                return false;
+
+            if (c == '<')
+                ++depth;
+            else if (c == '>')
+                --depth;
+        }
+
+        return true;
+    }
+
+    Event readStartTag()
+    {
+        // allow for a gap after the '<', as XmlDocument does
+        skipWhitespace();
+        tagNameOffset = (size_t) buffer.getPosition();
+
+        if (! readName())
+            return fail ("tag name missing");
+
+        buffer.writeByte (0);
+
+        auto tagName = static_cast<const char*> (buffer.getData()) + tagNameOffset;
+        openTagStarts.push_back (openTags.size());
+        openTags.insert (openTags.end(), tagName, tagName + strlen (tagName));
+
+        for (;;)
+        {
+            skipWhitespace();
+            auto c = input.peekByte();
+
+            if (c == '>')
+            {
+                input.readByte();
+                return Event::startElement;
+            }
+
+            if (c == '/')
+            {
+                input.readByte();
+
+                if (! input.matchIf ('>'))
+                    return fail ("illegal character found in " + String (getString (tagNameOffset)) + ": '/'");
+
+                isEmptyElementOpen = true;
+                return Event::startElement;
+            }
+
+            if (c < 0)
+                return fail ("unmatched tags");
+
+            if (! isNameByte (c))
+                return fail ("illegal character found in " + String (getString (tagNameOffset)) + ": '" + String::charToString ((juce_wchar) c) + "'");
+
+            AttributeOffsets att;
+            att.name = (size_t) buffer.getPosition();
+            readName();
+            buffer.writeByte (0);
+
+            skipWhitespace();
+
+            if (! input.matchIf ('='))
+                return fail ("expected '=' after attribute '" + String (getString (att.name)) + "'");
+
+            skipWhitespace();
+            auto quote = input.peekByte();
+
+            if (quote != '"' && quote != '\'')
+                return fail ("expected a quoted value for attribute '" + String (getString (att.name)) + "'");
+
+            input.readByte();
+            att.value = (size_t) buffer.getPosition();
+
+            for (;;)
+            {
+                auto next = input.readByte();
+
+                if (next < 0)
+                    return fail ("unmatched quotes");
+
+                if (next == quote)
+                    break;
+
+                if (next == '&')
+                    readEntity();
+                else
+                    buffer.writeByte ((char) next);
+            }
+
+            buffer.writeByte (0);
+            attributes.add (att);
+        }
+    }
+
+    Event popElement()
+    {
+        buffer.reset();
+        tagNameOffset = 0;
+
+        auto start = openTagStarts.back();
+        buffer.write (openTags.data() + start, openTags.size() - start);
+        buffer.writeByte (0);
+
+        openTags.resize (start);
+        openTagStarts.pop_back();
+        finished = openTagStarts.empty();
+
+        return Event::endElement;
+    }
+
+    //==============================================================================
+    Event readContent()
+    {
+        auto markup = std::exchange (pendingMarkup, Markup::none);
+
+        if (markup == Markup::none)
+        {
+            bool isCharacterBlock = false, containsNonWhitespace = false;
+
+            for (;;)
+            {
+                auto c = input.readByte();
+
+                if (c < 0)
+                    return fail ("unmatched tags");
+
+                if (c == '<')
+                {
+                    if (input.matchIf ('/'))
+                    {
+                        markup = Markup::endTag;
+                    }
+                    else if (input.matchIf ('!'))
+                    {
+                        if (input.matchIf ('-'))
+                        {
+                            if (! (input.matchIf ('-') && readPast ("-->", false)))
+                                return fail ("unterminated comment");
+
+                            continue;
+                        }
+
+                        if (! matchSequence ("[CDATA["))
+                            return fail ("tag name missing");
+
+                        markup = Markup::cdata;
+                    }
+                    else if (input.matchIf ('?'))
+                    {
+                        if (! readPast ("?>", false))
+                            return fail ("unmatched tags");
+
+                        continue;
+                    }
+                    else
+                    {
+                        markup = Markup::element;
+                    }
+
+                    break;
+                }
+
+                if (c == '&')
+                {
+                    auto start = (size_t) buffer.getPosition();
+                    readEntity();
+                    isCharacterBlock = true;
+
+                    auto* data = static_cast<const char*> (buffer.getData());
+
+                    for (auto i = start; i < (size_t) buffer.getPosition(); ++i)
+                        containsNonWhitespace = containsNonWhitespace || ! isWhitespace (data[i]);
+
+                    continue;
+                }
+
+                if (c == '\r')
+                {
+                    if (input.peekByte() == '\n')
+                        continue;
+
+                    c = '\n';
+                }
+
+                if (! isWhitespace (c))
+                    isCharacterBlock = containsNonWhitespace = true;
+
+                buffer.writeByte ((char) c);
+            }
+
+            if (isCharacterBlock && (containsNonWhitespace || ! ignoreEmptyTextElements))
+            {
+                buffer.writeByte (0);
+                pendingMarkup = markup;
+                return Event::text;
+            }
+
+            buffer.reset();
+        }
+
+        switch (markup)
+        {
+            case Markup::endTag:
+                if (! readPast (">", false))
+                    return fail ("unmatched tags");
+
+                return popElement();
+
+            case Markup::cdata:
+                if (! readPast ("]]>", true))
+                    return fail ("unterminated CDATA section");
+
+                buffer.writeByte (0);
+                return Event::text;
+
+            case Markup::element:
+            case Markup::none:
+            default:
+                return readStartTag();
+        }
+    }
+
+    void readEntity()
+    {
+        char name[16];
+        int length = 0;
+        bool terminated = false;
+
+        for (;;)
+        {
+            auto c = input.peekByte();
+
+            if (c == ';')
+            {
+                input.readByte();
+                terminated = true;
+                break;
+            }
+
+            if (length == (int) sizeof (name) - 1 || ! (c == '#' || isNameByte (c)))
+                break;
+
+            name[length++] = (char) input.readByte();
+        }
+
+        name[length] = 0;
+
+        if (! terminated)
+        {
+            buffer.writeByte ('&');
+            buffer.write (name, (size_t) length);
+            return;
+        }
+
+        const CharPointer_ASCII entity (name);
+
+        if (entity.compareIgnoreCase (CharPointer_ASCII ("amp")) == 0)        { buffer.writeByte ('&');  return; }
+        if (entity.compareIgnoreCase (CharPointer_ASCII ("quot")) == 0)       { buffer.writeByte ('"');  return; }
+        if (entity.compareIgnoreCase (CharPointer_ASCII ("apos")) == 0)       { buffer.writeByte ('\''); return; }
+        if (entity.compareIgnoreCase (CharPointer_ASCII ("lt")) == 0)         { buffer.writeByte ('<');  return; }
+        if (entity.compareIgnoreCase (CharPointer_ASCII ("gt")) == 0)         { buffer.writeByte ('>');  return; }
+
+        if (name[0] == '#')
+        {
+            const bool isHex = (name[1] == 'x' || name[1] == 'X');
+            int64 charCode = 0;
+            bool isValid = name[isHex ? 2 : 1] != 0;
+
+            for (auto* p = name + (isHex ? 2 : 1); *p != 0 && isValid; ++p)
+            {
+                auto digit = isHex ? CharacterFunctions::getHexDigitValue ((juce_wchar) *p)
+                                   : (*p >= '0' && *p <= '9' ? *p - '0' : -1);
+
+                isValid = digit >= 0;
+                charCode = charCode * (isHex ? 16 : 10) + digit;
+            }
+
+            if (! isValid)
+            {
+                buffer.writeByte ('&');
+                return;
+            }
+
+            if (charCode > 0 && charCode <= 0x10ffff)
+                buffer.appendUTF8Char ((juce_wchar) charCode);
+
+            return;
+        }
+
+        // Entities declared in a DTD aren't supported, so like XmlDocument does for an
+        // unknown entity, this just uses the entity's name.
+        buffer.write (name, (size_t) length);
+    }
+};
+
+//==============================================================================
+XmlStreamReader::XmlStreamReader (InputStream& in)  : pimpl (std::make_unique<Pimpl> (in)) {}
+XmlStreamReader::~XmlStreamReader() = default;
+
+XmlStreamReader::Event XmlStreamReader::next()                      { return pimpl->next(); }
+
+StringRef XmlStreamReader::getTagName() const noexcept              { return pimpl->getString (pimpl->tagNameOffset); }
+int XmlStreamReader::getNumAttributes() const noexcept              { return pimpl->attributes.size(); }
+StringRef XmlStreamReader::getText() const noexcept                 { return pimpl->getString (pimpl->textOffset); }
+int XmlStreamReader::getDepth() const noexcept                      { return (int) pimpl->openTagStarts.size(); }
+const String& XmlStreamReader::getLastParseError() const noexcept   { return pimpl->lastError; }
+
+StringRef XmlStreamReader::getAttributeName (int attributeIndex) const noexcept
+{
+    if (isPositiveAndBelow (attributeIndex, pimpl->attributes.size()))
+        return pimpl->getString (pimpl->attributes.getReference (attributeIndex).name);
+
+    return {};
+}
+
+StringRef XmlStreamReader::getAttributeValue (int attributeIndex) const noexcept
+{
+    if (isPositiveAndBelow (attributeIndex, pimpl->attributes.size()))
+        return pimpl->getString (pimpl->attributes.getReference (attributeIndex).value);
+
+    return {};
+}
+
+bool XmlStreamReader::hasAttribute (StringRef attributeName) const noexcept
+{
+    return pimpl->findAttribute (attributeName) >= 0;
+}
+
+StringRef XmlStreamReader::getAttributeValue (StringRef attributeName) const noexcept
+{
+    return getAttributeValue (pimpl->findAttribute (attributeName));
+}
+
+void XmlStreamReader::setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept
+{
+    pimpl->ignoreEmptyTextElements = shouldBeIgnored;
+}
+
+bool XmlStreamReader::skipElement()
+{
+    for (int depth = 1; depth > 0;)
+    {
+        switch (next())
+        {
+            case Event::startElement:   ++depth; break;
+            case Event::endElement:     --depth; break;
+            case Event::text:           break;
+            case Event::endOfDocument:
+            case Event::error:
+            default:                    return false;
+        }
+    }
+
+    return true;
+}
+
+std::unique_ptr<XmlElement> XmlStreamReader::readElement()
+{
+    auto element = std::make_unique<XmlElement> (getTagName());
+
+    {
+        LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (element->attributes);
+
+        for (int i = 0; i < getNumAttributes(); ++i)
+        {
+            auto name = getAttributeName (i);
+            auto* att = new XmlElement::XmlAttributeNode (name.text, name.text.findTerminatingNull());
+            att->value = getAttributeValue (i);
+            attributeAppender.append (att);
+        }
+    }
+
+    LinkedListPointer<XmlElement>::Appender childAppender (element->firstChildElement);
+
+    for (;;)
+    {
+        switch (next())
+        {
+            case Event::startElement:
+                if (auto child = readElement())
+                {
+                    childAppender.append (child.release());
+                    break;
+                }
+
+                return {};
+
+            case Event::text:
+                childAppender.append (XmlElement::createTextElement (getText()));
+                break;
+
+            case Event::endElement:
+                return element;
+
+            case Event::endOfDocument:
+            case Event::error:
+            default:
+                return {};
+        }
+    }
+}
+
+//==============================================================================
+XmlStreamWriter::XmlStreamWriter (OutputStream& output, const XmlElement::TextFormat& formatToUse)
+    : out (output), format (formatToUse)
+{
+}
+
+void XmlStreamWriter::writeHeader()
+{
+    if (format.customHeader.isNotEmpty())
+    {
+        out << format.customHeader;
+
+        if (format.newLineChars == nullptr)
+            out.writeByte (' ');
+        else
+            out << format.newLineChars
+                << format.newLineChars;
+    }
+    else if (format.addDefaultHeader)
+    {
+        out << "<?xml version=\"1.0\" encoding=\"";
+
+        if (format.customEncoding.isNotEmpty())
+            out << format.customEncoding;
+        else
+            out << "UTF-8";
+
+        out << "\"?>";
+
+        if (format.newLineChars == nullptr)
+            out.writeByte (' ');
+        else
+            out << format.newLineChars
+                << format.newLineChars;
+    }
+
+    if (format.dtd.isNotEmpty())
+    {
+        out << format.dtd;
+
+        if (format.newLineChars == nullptr)
+            out.writeByte (' ');
+        else
+            out << format.newLineChars;
+    }
+}
+
+void XmlStreamWriter::closeStartTag()
+{
+    auto& level = levels.getReference (levels.size() - 1);
+
+    if (level.isTagOpen)
+    {
+        out.writeByte ('>');
+        level.isTagOpen = false;
+    }
+}
+
+int XmlStreamWriter::startChild()
+{
+    closeStartTag();
+    auto& parent = levels.getReference (levels.size() - 1);
+    auto indentationLevel = parent.indentationLevel;
+
+    if (indentationLevel >= 0 && ! parent.lastWasTextNode)
+        out << format.newLineChars;
+
+    auto childIndentation = (parent.lastWasTextNode && indentationLevel >= 0) ? 0 : (indentationLevel + (indentationLevel >= 0 ? 2 : 0));
+    parent.lastWasTextNode = false;
+    return childIndentation;
+}
+
+void XmlStreamWriter::startElement (StringRef tagName)
+{
+    jassert (tagName.isNotEmpty());
+
+    int indentationLevel;
+
+    if (levels.isEmpty())
+    {
+        writeHeader();
+        indentationLevel = format.newLineChars == nullptr ? -1 : 0;
+    }
+    else
+    {
+        indentationLevel = startChild();
+    }
+
+    if (indentationLevel >= 0)
+        XmlOutputFunctions::writeSpaces (out, (size_t) indentationLevel);
+
+    out.writeByte ('<');
+    out << tagName;
+
+    Level level;
+    level.tagName = tagName;
+    level.indentationLevel = indentationLevel;
+    levels.add (std::move (level));
+}
+
+void XmlStreamWriter::writeAttribute (StringRef attributeName, const String& value)
+{
+    // Attributes have to be written before any text or child elements!
+    jassert (! levels.isEmpty() && levels.getLast().isTagOpen);
+
+    auto& level = levels.getReference (levels.size() - 1);
+
+    if (level.lineLength > format.lineWrapLength && level.indentationLevel >= 0)
+    {
+        out << format.newLineChars;
+        XmlOutputFunctions::writeSpaces (out, (size_t) (level.indentationLevel + level.tagName.length() + 1));
+        level.lineLength = 0;
+    }
+
+    auto startPos = out.getPosition();
+    out.writeByte (' ');
+    out << attributeName;
+    out.write ("=\"", 2);
+    XmlOutputFunctions::escapeIllegalXmlChars (out, value, true);
+    out.writeByte ('"');
+    level.lineLength += (int) (out.getPosition() - startPos);
+}
+
+void XmlStreamWriter::writeAttribute (StringRef attributeName, int value)
+{
+    writeAttribute (attributeName, String (value));
+}
+
+void XmlStreamWriter::writeAttribute (StringRef attributeName, double value)
+{
+    writeAttribute (attributeName, serialiseDouble (value));
+}
+
+void XmlStreamWriter::writeText (StringRef text)
+{
+    // A text node has to go inside an element!
+    jassert (! levels.isEmpty());
+
+    closeStartTag();
+    XmlOutputFunctions::escapeIllegalXmlChars (out, text, false);
+    levels.getReference (levels.size() - 1).lastWasTextNode = true;
+}
+
+void XmlStreamWriter::writeElement (const XmlElement& element)
+{
+    if (element.isTextElement())
+    {
+        writeText (element.getText());
+        return;
+    }
+
+    startElement (element.getTagName());
+
+    for (auto* att = element.attributes.get(); att != nullptr; att = att->nextListItem)
+        writeAttribute (att->name.toString(), att->value);
+
+    for (auto* child = element.firstChildElement.get(); child != nullptr; child = child->nextListItem)
+        writeElement (*child);
+
+    endElement();
+}
+
+void XmlStreamWriter::endElement()
+{
+    // There's no element to end!
+    jassert (! levels.isEmpty());
+
+    auto level = levels.removeAndReturn (levels.size() - 1);
+
+    if (level.isTagOpen)
+    {
+        out.write ("/>", 2);
+    }
+    else
+    {
+        if (level.indentationLevel >= 0 && ! level.lastWasTextNode)
+        {
+            out << format.newLineChars;
+            XmlOutputFunctions::writeSpaces (out, (size_t) level.indentationLevel);
+        }
+
+        out.write ("</", 2);
+        out << level.tagName;
+        out.writeByte ('>');
+    }
+
+    if (levels.isEmpty() && format.newLineChars != nullptr)
+        out << format.newLineChars;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlStreamTests final : public UnitTest
+{
+public:
+    XmlStreamTests()
+        : UnitTest ("XmlStream", UnitTestCategories::xml)
+    {}
+
+    static String createRandomText (Random& r)
+    {
+        static const juce_wchar chars[] = { 'a', 'b', 'Z', '0', ' ', '\n', '\t', '&', '<', '>',
+                                            '"', '\'', ';', '#', 0xe9, 0x263a, 0x1f600 };
+
+        String s ("t");
+
+        for (int i = r.nextInt (12); --i >= 0;)
+            s << chars[r.nextInt (numElementsInArray (chars))];
+
+        return s;
+    }
+
+    static std::unique_ptr<XmlElement> createRandomElement (Random& r, int depth)
+    {
+        static const char* const names[] = { "A", "b", "Item", "x:y", "long_tag-name.1" };
+
+        auto e = std::make_unique<XmlElement> (names[r.nextInt (numElementsInArray (names))]);
+
+        for (int i = r.nextInt (8); --i >= 0;)
+            e->setAttribute (String ("att") + String (i), createRandomText (r));
+
+        bool lastWasText = false;
+
+        for (int i = depth < 4 ? r.nextInt (5) : 0; --i >= 0;)
+        {
+            if (! lastWasText && r.nextBool())
+            {
+                e->addTextElement (createRandomText (r));
+                lastWasText = true;
+            }
+            else
+            {
+                e->addChildElement (createRandomElement (r, depth + 1).release());
+                lastWasText = false;
+            }
+        }
+
+        return e;
+    }
+
+    static String write (const XmlElement& e, const XmlElement::TextFormat& format)
+    {
+        MemoryOutputStream mo;
+
+        {
+            XmlStreamWriter writer (mo, format);
+            writer.writeElement (e);
+        }
+
+        return mo.toUTF8();
+    }
+
+    static std::unique_ptr<XmlElement> read (const String& text)
+    {
+        MemoryInputStream mi (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+        XmlStreamReader reader (mi);
+
+        if (reader.next() != XmlStreamReader::Event::startElement)
+            return {};
+
+        return reader.readElement();
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Writer");
+        {
+            std::vector<XmlElement::TextFormat> formats (5);
+            formats[1] = formats[1].singleLine();
+            formats[2] = formats[2].withoutHeader();
+            formats[3].dtd = "<!DOCTYPE FOO>";
+            formats[3].customHeader = "<?xml version=\"1.0\"?>";
+            formats[4].lineWrapLength = 10;
+
+            for (int i = 100; --i >= 0;)
+            {
+                auto e = createRandomElement (r, 0);
+
+                for (auto& format : formats)
+                    expectEquals (write (*e, format), e->toString (format));
+            }
+
+            XmlElement expected ("ROOT");
+            expected.setAttribute ("name", "a & b");
+            expected.setAttribute ("size", 3);
+            expected.setAttribute ("gain", 0.5);
+            expected.createNewChildElement ("EMPTY");
+            expected.addTextElement ("text");
+            expected.createNewChildElement ("CHILD")->addTextElement ("<x>");
+
+            MemoryOutputStream mo;
+
+            {
+                XmlStreamWriter writer (mo);
+                writer.startElement ("ROOT");
+                writer.writeAttribute ("name", "a & b");
+                writer.writeAttribute ("size", 3);
+                writer.writeAttribute ("gain", 0.5);
+                writer.startElement ("EMPTY");
+                writer.endElement();
+                writer.writeText ("text");
+                writer.startElement ("CHILD");
+                writer.writeText ("<x>");
+                writer.endElement();
+                expectEquals (writer.getDepth(), 1);
+                writer.endElement();
+                expectEquals (writer.getDepth(), 0);
+            }
+
+            expectEquals (mo.toUTF8(), expected.toString());
+        }
+
+        beginTest ("Reader events");
+        {
+            const String text ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n"
+                               "<!DOCTYPE DOC [ <!ELEMENT DOC ANY> ]>\r\n"
+                               "<!-- comment -->\r\n"
+                               "<DOC a=\"1 &amp; 2\" b='&#x41;&#66;'>\r\n"
+                               "  <EMPTY/>\r\n"
+                               "  line &lt;1&gt;\r\nline 2 <!-- skipped --> end\r\n"
+                               "  <![CDATA[<raw> & ]]]]><ITEM>&unknown;</ITEM>"
+                               "</DOC> trailing junk <");
+
+            MemoryInputStream mi (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+            XmlStreamReader reader (mi);
+            using Event = XmlStreamReader::Event;
+
+            expect (reader.next() == Event::startElement);
+            expectEquals (String (reader.getTagName()), String ("DOC"));
+            expectEquals (reader.getNumAttributes(), 2);
+            expectEquals (String (reader.getAttributeName (1)), String ("b"));
+            expectEquals (String (reader.getAttributeValue ("a")), String ("1 & 2"));
+            expectEquals (String (reader.getAttributeValue ("b")), String ("AB"));
+            expect (! reader.hasAttribute ("c"));
+            expectEquals (reader.getDepth(), 1);
+
+            expect (reader.next() == Event::startElement);
+            expectEquals (String (reader.getTagName()), String ("EMPTY"));
+            expectEquals (reader.getDepth(), 2);
+            expect (reader.next() == Event::endElement);
+            expectEquals (String (reader.getTagName()), String ("EMPTY"));
+            expectEquals (reader.getDepth(), 1);
+
+            expect (reader.next() == Event::text);
+            expectEquals (String (reader.getText()), String ("\n  line <1>\nline 2  end\n  "));
+            expect (reader.next() == Event::text);
+            expectEquals (String (reader.getText()), String ("<raw> & ]]"));
+
+            expect (reader.next() == Event::startElement);
+            expect (reader.next() == Event::text);
+            expectEquals (String (reader.getText()), String ("unknown"));
+            expect (reader.next() == Event::endElement);
+            expectEquals (String (reader.getTagName()), String ("ITEM"));
+
+            expect (reader.next() == Event::endElement);
+            expectEquals (String (reader.getTagName()), String ("DOC"));
+            expectEquals (reader.getDepth(), 0);
+            expect (reader.next() == Event::endOfDocument);
+            expect (reader.next() == Event::endOfDocument);
+            expect (reader.getLastParseError().isEmpty());
+        }
+
+        beginTest ("Skipping elements");
+        {
+            const String text ("<A><B x=\"1\"><C/>text<D></D></B><E/></A>");
+            MemoryInputStream mi (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+            XmlStreamReader reader (mi);
+
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+            expect (reader.skipElement());
+            expectEquals (String (reader.getTagName()), String ("B"));
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+            expectEquals (String (reader.getTagName()), String ("E"));
+        }
+
+        beginTest ("readElement matches XmlDocument");
+        {
+            for (int i = 100; --i >= 0;)
+            {
+                auto text = createRandomElement (r, 0)->toString (r.nextBool() ? XmlElement::TextFormat()
+                                                                               : XmlElement::TextFormat().singleLine());
+                auto expected = parseXML (text);
+                auto actual = read (text);
+
+                expect (expected != nullptr && actual != nullptr);
+
+                if (expected != nullptr && actual != nullptr)
+                    expectEquals (actual->toString(), expected->toString());
+            }
+
+            const String text ("<A x=\"&quot;&apos;\">  <!-- c -->  text &amp; more<B/>  <![CDATA[  ]]>\r\n<C>\r</C></A>");
+            expectEquals (read (text)->toString(), parseXML (text)->toString());
+        }
+
+        beginTest ("Empty text elements");
+        {
+            const String text ("<A>&#32;<B/></A>");
+            MemoryInputStream mi (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+            XmlStreamReader reader (mi);
+            reader.setEmptyTextElementsIgnored (false);
+
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+            expect (reader.next() == XmlStreamReader::Event::text);
+            expectEquals (String (reader.getText()), String (" "));
+        }
+
+        beginTest ("UTF-16 input");
+        {
+            auto e = createRandomElement (r, 0);
+            MemoryOutputStream mo;
+            mo.writeText (e->toString(), true, true, nullptr);
+
+            MemoryInputStream mi (mo.getData(), mo.getDataSize(), false);
+            XmlStreamReader reader (mi);
+
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+
+            if (auto actual = reader.readElement())
+                expectEquals (actual->toString(), parseXML (e->toString())->toString());
+            else
+                expect (false);
+        }
+
+        beginTest ("Errors");
+        {
+            auto expectError = [this] (const char* text)
+            {
+                MemoryInputStream mi (text, strlen (text), false);
+                XmlStreamReader reader (mi);
+
+                for (int i = 0; i < 20; ++i)
+                {
+                    auto event = reader.next();
+
+                    if (event == XmlStreamReader::Event::error)
+                    {
+                        expect (reader.getLastParseError().isNotEmpty());
+                        expect (reader.next() == XmlStreamReader::Event::error);
+                        return;
+                    }
+
+                    expect (event != XmlStreamReader::Event::endOfDocument);
+                }
+
+                expect (false);
+            };
+
+            expectError ("");
+            expectError ("   ");
+            expectError ("<A><B></B>");
+            expectError ("<A x=1/>");
+            expectError ("<A x/>");
+            expectError ("<A x=\"1/>");
+            expectError ("<A><!-- </A>");
+            expectError ("<A><![CDATA[ </A>");
+            expectError ("<A></A");
+        }
+    }
+};
+
+static XmlStreamTests xmlStreamTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads an XML document from a stream one piece at a time, without building a
+    tree of XmlElement objects.
+
+    This is a "pull" parser: each call to next() reads just far enough to find the
+    next start tag, end tag or block of text, and returns an Event saying which one
+    it was. The details of that event can then be read with the other methods.
+
+    @code
+    XmlStreamReader reader (stream);
+
+    while (reader.next() == XmlStreamReader::Event::startElement)
+    {
+        if (reader.getTagName() == StringRef ("PLUGIN"))
+            if (auto e = reader.readElement())
+                loadPlugin (*e);
+    }
+
+    if (reader.getLastParseError().isNotEmpty())
+        DBG (reader.getLastParseError());
+    @endcode
+
+    The strings returned by getTagName(), getAttributeName(), getAttributeValue()
+    and getText() point into the reader's own buffer, which is reused for each event,
+    so they're only valid until the next call to next(), skipElement() or
+    readElement(). If you need to keep them, copy them into a String.
+
+    The rules for whitespace, entities, comments and CDATA sections are the same as
+    those used by XmlDocument, so readElement() will give the same XmlElement that
+    XmlDocument would have created for that part of the document. External entities
+    declared in a DTD aren't expanded. Reading stops at the end of the document's
+    outer element, so anything after that in the stream is ignored.
+
+    The input should be UTF-8, or UTF-16 with a byte-order mark.
+
+    @see XmlStreamWriter, XmlDocument
+
+    @tags{Core}
+*/
+class JUCE_API  XmlStreamReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader that will read from the given stream.
+        The stream must remain valid for the lifetime of this reader.
+    */
+    explicit XmlStreamReader (InputStream& input);
+
+    /** Destructor. */
+    ~XmlStreamReader();
+
+    //==============================================================================
+    /** The different kinds of item that next() can find. */
+    enum class Event
+    {
+        startElement,   /**< A start tag was read. Its name and attributes are available. */
+        endElement,     /**< An end tag was read, or the end of an empty element such as \<FOO/>. */
+        text,           /**< A block of text or a CDATA section was read. */
+        endOfDocument,  /**< The document's outer element has been closed. */
+        error           /**< The input wasn't valid - getLastParseError() describes the problem. */
+    };
+
+    /** Reads the next item from the stream.
+        Once this has returned endOfDocument or error, it will keep returning the same
+        value.
+    */
+    Event next();
+
+    //==============================================================================
+    /** Returns the tag name of the element that was started or ended by the last event. */
+    StringRef getTagName() const noexcept;
+
+    /** Returns the number of attributes in the tag read by the last startElement event. */
+    int getNumAttributes() const noexcept;
+
+    /** Returns the name of one of the current start tag's attributes. */
+    StringRef getAttributeName (int attributeIndex) const noexcept;
+
+    /** Returns the value of one of the current start tag's attributes. */
+    StringRef getAttributeValue (int attributeIndex) const noexcept;
+
+    /** Checks whether the current start tag contains an attribute with a certain name. */
+    bool hasAttribute (StringRef attributeName) const noexcept;
+
+    /** Returns the value of a named attribute in the current start tag, or an empty
+        string if there's no such attribute.
+    */
+    StringRef getAttributeValue (StringRef attributeName) const noexcept;
+
+    /** Returns the text read by the last text event, with any entities expanded. */
+    StringRef getText() const noexcept;
+
+    /** Returns the number of elements that are currently open.
+
+        After a startElement event, this includes the element that was just started;
+        after an endElement event, it doesn't include the element that was just ended.
+    */
+    int getDepth() const noexcept;
+
+    //==============================================================================
+    /** Reads and discards the rest of the element whose start tag was just read,
+        including all of its children, leaving the reader positioned after its end tag.
+        Returns false if an error occurred.
+    */
+    bool skipElement();
+
+    /** Reads the rest of the element whose start tag was just read, and returns it
+        as an XmlElement, including all of its children.
+
+        This lets you handle a large document one element at a time, only building
+        trees for the parts you actually need. Returns nullptr if an error occurred.
+    */
+    std::unique_ptr<XmlElement> readElement();
+
+    //==============================================================================
+    /** Returns a description of the error that stopped the reader, or an empty string
+        if there hasn't been an error.
+    */
+    const String& getLastParseError() const noexcept;
+
+    /** Sets a flag to change the treatment of empty text blocks.
+        If this is true (the default), text blocks that contain only whitespace are
+        skipped, in the same way as XmlDocument::setEmptyTextElementsIgnored().
+    */
+    void setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept;
+
+private:
+    //==============================================================================
+    struct Pimpl;
+    std::unique_ptr<Pimpl> pimpl;
+
+    JUCE_DECLARE_NON_COPYABLE (XmlStreamReader)
+};
+
+//==============================================================================
+/**
+    Writes an XML document directly to an OutputStream, one element at a time.
+
+    This produces exactly the same text as XmlElement::writeTo() would produce for
+    the equivalent XmlElement, using the same TextFormat options, but doesn't need
+    the whole tree to be built first.
+
+    @code
+    XmlStreamWriter writer (stream);
+
+    writer.startElement ("PLUGINS");
+
+    for (auto& plugin : plugins)
+        writer.writeElement (*plugin.createXml());
+
+    writer.endElement();
+    @endcode
+
+    Attributes must be written straight after the startElement() call for the element
+    they belong to, before any text or child elements. Every element that is started
+    must also be ended.
+
+    @see XmlStreamReader, XmlElement
+
+    @tags{Core}
+*/
+class JUCE_API  XmlStreamWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer that will write to the given stream.
+        The stream must remain valid for the lifetime of this writer.
+    */
+    explicit XmlStreamWriter (OutputStream& output,
+                              const XmlElement::TextFormat& format = {});
+
+    //==============================================================================
+    /** Writes the start of a new element.
+        If this is the document's outer element, the header and DTD from the TextFormat
+        are written first.
+    */
+    void startElement (StringRef tagName);
+
+    /** Adds an attribute to the element that was most recently started. */
+    void writeAttribute (StringRef attributeName, const String& value);
+
+    /** Adds an attribute to the element that was most recently started, setting it to
+        an integer value.
+    */
+    void writeAttribute (StringRef attributeName, int value);
+
+    /** Adds an attribute to the element that was most recently started, setting it to
+        a floating-point value.
+    */
+    void writeAttribute (StringRef attributeName, double value);
+
+    /** Writes a block of text inside the current element. */
+    void writeText (StringRef text);
+
+    /** Writes a complete element, including its attributes and children, inside the
+        current element. If no element has been started yet, this writes the whole
+        document.
+    */
+    void writeElement (const XmlElement& element);
+
+    /** Writes the end of the element that was most recently started. */
+    void endElement();
+
+    //==============================================================================
+    /** Returns the number of elements that are currently open.
+        Once everything has been written, this should be zero.
+    */
+    int getDepth() const noexcept               { return levels.size(); }
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        String tagName;
+        int indentationLevel = 0, lineLength = 0;
+        bool isTagOpen = true, hasChildren = false, lastWasTextNode = false;
+    };
+
+    void writeHeader();
+    void closeStartTag();
+    int startChild();
+
+    OutputStream& out;
+    const XmlElement::TextFormat format;
+    Array<Level> levels;
+
+    JUCE_DECLARE_NON_COPYABLE (XmlStreamWriter)
+};
+
+} // namespace juce
@@ -185,48 +185,117 @@ bool PropertiesFile::save()
 
 bool PropertiesFile::loadAsXml()
 {
-    if (auto doc = parseXMLIfTagMatches (file, PropertyFileConstants::fileTag))
+    FileInputStream in (file);
+
+    if (! in.openedOk())
+        return false;
+
+    // The file is read one VALUE element at a time, so the whole document never has to be held in memory
+    XmlStreamReader reader (in);
+
+    if (reader.next() != XmlStreamReader::Event::startElement
+         || reader.getTagName() != StringRef (PropertyFileConstants::fileTag))
+        return false;
+
+    // Nothing is changed until the whole file has been read, so that a corrupt file can't leave
+    // this object with only some of its properties
+    StringArray names, values;
+
+    for (;;)
     {
-        for (auto* e : doc->getChildWithTagNameIterator (PropertyFileConstants::valueTag))
+        switch (reader.next())
         {
-            auto name = e->getStringAttribute (PropertyFileConstants::nameAttribute);
+            case XmlStreamReader::Event::startElement:
+            {
+                if (reader.getTagName() != StringRef (PropertyFileConstants::valueTag))
+                {
+                    if (! reader.skipElement())
+                        return false;
 
-            if (name.isNotEmpty())
-                getAllProperties().set (name,
-                                        e->getFirstChildElement() != nullptr
-                                            ? e->getFirstChildElement()->toString (XmlElement::TextFormat().singleLine().withoutHeader())
-                                            : e->getStringAttribute (PropertyFileConstants::valueAttribute));
-        }
+                    break;
+                }
 
-        return true;
-    }
+                auto e = reader.readElement();
 
-    return false;
-}
+                if (e == nullptr)
+                    return false;
 
-bool PropertiesFile::saveAsXml()
-{
-    XmlElement doc (PropertyFileConstants::fileTag);
-    auto& props = getAllProperties();
+                auto name = e->getStringAttribute (PropertyFileConstants::nameAttribute);
 
-    for (int i = 0; i < props.size(); ++i)
-    {
-        auto* e = doc.createNewChildElement (PropertyFileConstants::valueTag);
-        e->setAttribute (PropertyFileConstants::nameAttribute, props.getAllKeys() [i]);
+                if (name.isNotEmpty())
+                {
+                    names.add (name);
+                    values.add (e->getFirstChildElement() != nullptr
+                                    ? e->getFirstChildElement()->toString (XmlElement::TextFormat().singleLine().withoutHeader())
+                                    : e->getStringAttribute (PropertyFileConstants::valueAttribute));
+                }
 
-        // if the value seems to contain xml, store it as such..
-        if (auto childElement = parseXML (props.getAllValues() [i]))
-            e->addChildElement (childElement.release());
-        else
-            e->setAttribute (PropertyFileConstants::valueAttribute, props.getAllValues() [i]);
+                break;
+            }
+
+            case XmlStreamReader::Event::text:
+                break;
+
+            case XmlStreamReader::Event::endElement:
+            {
+                auto& props = getAllProperties();
+
+                for (int i = 0; i < names.size(); ++i)
+                    props.set (names[i], values[i]);
+
+                return true;
+            }
+
+            case XmlStreamReader::Event::endOfDocument:
+            case XmlStreamReader::Event::error:
+            default:
+                return false;
+        }
     }
+}
 
+bool PropertiesFile::saveAsXml()
+{
     ProcessScopedLock pl (createProcessLock());
 
     if (pl != nullptr && ! pl->isLocked())
         return false; // locking failure..
 
-    if (doc.writeTo (file, {}))
+    TemporaryFile tempFile (file);
+
+    {
+        FileOutputStream out (tempFile.getFile());
+
+        if (! out.openedOk())
+            return false;
+
+        XmlStreamWriter writer (out);
+        writer.startElement (PropertyFileConstants::fileTag);
+
+        auto& props = getAllProperties();
+
+        for (int i = 0; i < props.size(); ++i)
+        {
+            writer.startElement (PropertyFileConstants::valueTag);
+            writer.writeAttribute (PropertyFileConstants::nameAttribute, props.getAllKeys() [i]);
+
+            // if the value seems to contain xml, store it as such..
+            if (auto childElement = parseXML (props.getAllValues() [i]))
+                writer.writeElement (*childElement);
+            else
+                writer.writeAttribute (PropertyFileConstants::valueAttribute, props.getAllValues() [i]);
+
+            writer.endElement();
+        }
+
+        writer.endElement();
+        out.flush(); // (called explicitly to force an fsync on posix)
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    if (tempFile.overwriteTargetFileWithTemporary())
     {
         needsWriting = false;
         return true;
@@ -355,4 +424,61 @@ void PropertiesFile::propertyChanged()
         saveIfNeeded();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PropertiesFileTests final : public UnitTest
+{
+public:
+    PropertiesFileTests()
+        : UnitTest ("PropertiesFile", UnitTestCategories::files)
+    {}
+
+    void runTest() override
+    {
+        PropertiesFile::Options options;
+        options.millisecondsBeforeSaving = -1;
+        options.storageFormat = PropertiesFile::storeAsXML;
+
+        const String validFile ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                "<PROPERTIES>\n"
+                                "  <VALUE name=\"first\" val=\"1\"/>\n"
+                                "  <VALUE name=\"second\"><NESTED a=\"b\"/></VALUE>\n"
+                                "</PROPERTIES>\n");
+
+        beginTest ("XML files are loaded");
+        {
+            TemporaryFile temp (".settings");
+            expect (temp.getFile().replaceWithText (validFile));
+
+            PropertiesFile props (temp.getFile(), options);
+
+            expect (props.isValidFile());
+            expectEquals (props.getAllProperties().size(), 2);
+            expectEquals (props.getValue ("first"), String ("1"));
+            expectEquals (props.getValue ("second"), String ("<NESTED a=\"b\"/>"));
+        }
+
+        beginTest ("A corrupt XML file doesn't change any properties");
+        {
+            TemporaryFile temp (".settings");
+            PropertiesFile props (temp.getFile(), options);
+            props.setValue ("first", "original");
+            props.setNeedsToBeSaved (false);
+
+            // This is cut off part way through the second value
+            expect (temp.getFile().replaceWithText (validFile.substring (0, validFile.indexOf ("<NESTED") + 5)));
+
+            expect (! props.reload());
+            expectEquals (props.getAllProperties().size(), 1);
+            expectEquals (props.getValue ("first"), String ("original"));
+        }
+    }
+};
+
+static PropertiesFileTests propertiesFileTests;
+
+#endif
+
 } // namespace juce
@@ -37,6 +37,8 @@
 #include "values/juce_Value.cpp"
 #include "values/juce_ValueTree.cpp"
 #include "values/juce_ValueTreeSynchroniser.cpp"
+#include "values/juce_ValueTreeArchive.cpp"
+#include "values/juce_ValueTreeSnapshot.cpp"
 #include "values/juce_CachedValue.cpp"
 #include "undomanager/juce_UndoManager.cpp"
 #include "undomanager/juce_UndoableAction.cpp"
@@ -60,6 +60,8 @@
 #include "values/juce_Value.h"
 #include "values/juce_ValueTree.h"
 #include "values/juce_ValueTreeSynchroniser.h"
+#include "values/juce_ValueTreeArchive.h"
+#include "values/juce_ValueTreeSnapshot.h"
 #include "values/juce_CachedValue.h"
 #include "values/juce_ValueTreePropertyWithDefault.h"
 #include "app_properties/juce_PropertiesFile.h"
@@ -129,11 +129,14 @@ bool UndoManager::perform (UndoableAction* newAction)
             {
                 if (auto* lastAction = actionSet->actions.getLast())
                 {
+                    // The last action may merge the new one into itself, which can change its size
+                    const auto lastActionSize = lastAction->getSizeInUnits();
+
                     if (auto coalescedAction = lastAction->createCoalescedAction (action.get()))
                     {
+                        totalUnitsStored -= lastActionSize;
+                        actionSet->actions.removeLast (1, coalescedAction != lastAction);
                         action.reset (coalescedAction);
-                        totalUnitsStored -= lastAction->getSizeInUnits();
-                        actionSet->actions.removeLast();
                     }
                 }
             }
@@ -44,6 +44,11 @@ namespace juce
     The UndoManager is a ChangeBroadcaster, so listeners can register to be told
     when actions are performed or undone.
 
+    The actions that ValueTree creates report their sizes in bytes, including the
+    memory used by old property values and removed subtrees that only the undo
+    history is keeping alive, so for a ValueTree-based document the limit passed to
+    setMaxNumberOfStoredUnits() is effectively a memory budget.
+
     @see UndoableAction
 
     @tags{DataStructures}
@@ -92,6 +92,11 @@ public:
         If possible, this method should create and return a single action that does the same job as
         this one followed by the supplied action.
 
+        Instead of creating a new action, it may also merge the supplied action into this one and
+        return this, which saves allocating a replacement. The UndoManager will then keep this
+        action, and delete the supplied one. Any change to the value returned by getSizeInUnits()
+        is taken into account.
+
         If it's not possible to merge the two actions, the method should return a nullptr.
     */
     virtual UndoableAction* createCoalescedAction (UndoableAction* nextAction);
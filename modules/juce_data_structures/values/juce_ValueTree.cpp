@@ -408,65 +408,200 @@ public:
     }
 
     //==============================================================================
+    // Estimates of the heap memory that's kept alive by a var or a tree, which the
+    // undo actions use so that UndoManager's size limit roughly tracks real bytes.
+    static size_t getHeapSize (const var& v, int depth = 0)
+    {
+        if (v.isString())
+        {
+            auto numBytes = v.toString().getNumBytesAsUTF8();
+            return numBytes > 0 ? numBytes + 1 + 2 * sizeof (size_t) : 0;
+        }
+
+        if (auto* mb = v.getBinaryData())
+            return sizeof (MemoryBlock) + mb->getSize();
+
+        if (depth > 16)
+            return 0;
+
+        size_t total = 0;
+
+        if (auto* array = v.getArray())
+        {
+            total += sizeof (Array<var>);
+
+            for (auto& element : *array)
+                total += sizeof (var) + getHeapSize (element, depth + 1);
+        }
+        else if (auto* object = v.getDynamicObject())
+        {
+            total += sizeof (DynamicObject);
+
+            for (auto& prop : object->getProperties())
+                total += sizeof (NamedValueSet::NamedValue) + getHeapSize (prop.value, depth + 1);
+        }
+
+        return total;
+    }
+
+    size_t getHeapSize() const
+    {
+        auto total = sizeof (*this);
+
+        for (auto& prop : properties)
+            total += sizeof (NamedValueSet::NamedValue) + getHeapSize (prop.value);
+
+        for (auto* c : children)
+            total += sizeof (c) + c->getHeapSize();
+
+        return total;
+    }
+
+    static int toSizeInUnits (size_t numBytes) noexcept
+    {
+        return (int) jmin (numBytes, (size_t) std::numeric_limits<int>::max());
+    }
+
+    //==============================================================================
+    // Holds a set of property changes, which may be on several different trees. A run
+    // of property changes within a transaction is merged into the first of these, so that
+    // e.g. a drag that keeps setting the same few properties only stores each property's
+    // original and final values, rather than keeping one action per mouse move.
     struct SetPropertyAction final : public UndoableAction
     {
         SetPropertyAction (Ptr targetObject, const Identifier& propertyName,
                            const var& newVal, const var& oldVal, bool isAdding, bool isDeleting,
                            ValueTree::Listener* listenerToExclude = nullptr)
-            : target (std::move (targetObject)),
-              name (propertyName), newValue (newVal), oldValue (oldVal),
-              isAddingNewProperty (isAdding), isDeletingProperty (isDeleting),
-              excludeListener (listenerToExclude)
+            : excludeListener (listenerToExclude)
         {
+            changes.add ({ std::move (targetObject), propertyName, newVal, oldVal, isAdding, isDeleting });
+            updateSize();
         }
 
         bool perform() override
         {
-            jassert (! (isAddingNewProperty && target->hasProperty (name)));
+            for (auto& c : changes)
+            {
+                jassert (! (c.isAddingNewProperty && c.target->hasProperty (c.name)));
 
-            if (isDeletingProperty)
-                target->removeProperty (name, nullptr);
-            else
-                target->setProperty (name, newValue, nullptr, excludeListener);
+                if (c.isDeletingProperty)
+                    c.target->removeProperty (c.name, nullptr);
+                else
+                    c.target->setProperty (c.name, c.newValue, nullptr, excludeListener);
+            }
 
             return true;
         }
 
         bool undo() override
         {
-            if (isAddingNewProperty)
-                target->removeProperty (name, nullptr);
-            else
-                target->setProperty (name, oldValue, nullptr);
+            for (int i = changes.size(); --i >= 0;)
+            {
+                auto& c = changes.getReference (i);
+
+                if (c.isAddingNewProperty)
+                    c.target->removeProperty (c.name, nullptr);
+                else
+                    c.target->setProperty (c.name, c.oldValue, nullptr);
+            }
 
             return true;
         }
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return sizeInBytes;
         }
 
+        // The next action's changes are merged into this one, which is then returned, so
+        // that the UndoManager keeps this action rather than having to replace it.
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
         {
-            if (! (isAddingNewProperty || isDeletingProperty))
+            if (auto* next = dynamic_cast<SetPropertyAction*> (nextAction))
             {
-                if (auto* next = dynamic_cast<SetPropertyAction*> (nextAction))
-                    if (next->target == target && next->name == name
-                          && ! (next->isAddingNewProperty || next->isDeletingProperty))
-                        return new SetPropertyAction (*target, name, next->newValue, oldValue, false, false);
+                int numNewChanges = 0;
+
+                for (auto& c : next->changes)
+                    if (indexOfChange (c) < 0)
+                        ++numNewChanges;
+
+                if (changes.size() + numNewChanges > maxNumChanges)
+                    return nullptr;
+
+                for (auto& c : next->changes)
+                    addChange (c);
+
+                excludeListener = nullptr;
+                updateSize();
+                return this;
             }
 
             return nullptr;
         }
 
     private:
-        const Ptr target;
-        const Identifier name;
-        const var newValue;
-        var oldValue;
-        const bool isAddingNewProperty : 1, isDeletingProperty : 1;
-        ValueTree::Listener* excludeListener;
+        struct Change
+        {
+            Ptr target;
+            Identifier name;
+            var newValue, oldValue;
+            bool isAddingNewProperty, isDeletingProperty;
+        };
+
+        int indexOfChange (const Change& other) const
+        {
+            for (int i = 0; i < changes.size(); ++i)
+                if (changes.getReference (i).target == other.target && changes.getReference (i).name == other.name)
+                    return i;
+
+            return -1;
+        }
+
+        // Folds a change that happens after all of the existing ones into this set. Changes
+        // to different properties are independent, so a later change to a property can
+        // simply replace the new value of an earlier change to the same one.
+        void addChange (const Change& next)
+        {
+            const auto index = indexOfChange (next);
+
+            if (index < 0)
+            {
+                changes.add (next);
+                return;
+            }
+
+            auto& c = changes.getReference (index);
+            const bool existedBefore = ! c.isAddingNewProperty;
+            const bool existsAfter = ! next.isDeletingProperty;
+
+            if (! (existedBefore || existsAfter))
+            {
+                changes.remove (index);
+                return;
+            }
+
+            c.newValue = next.newValue;
+            c.isAddingNewProperty = ! existedBefore;
+            c.isDeletingProperty = ! existsAfter;
+        }
+
+        // Only the old values are counted, because each new value is owned either by the
+        // tree, or by the old value of whichever action replaced it.
+        void updateSize()
+        {
+            auto total = sizeof (*this) + (size_t) changes.size() * sizeof (Change);
+
+            for (auto& c : changes)
+                total += getHeapSize (c.oldValue);
+
+            sizeInBytes = toSizeInUnits (total);
+        }
+
+        static constexpr int maxNumChanges = 64;
+
+        Array<Change> changes;
+        ValueTree::Listener* excludeListener = nullptr;
+        int sizeInBytes = 0;
 
         JUCE_DECLARE_NON_COPYABLE (SetPropertyAction)
     };
@@ -478,7 +613,9 @@ public:
             : target (std::move (parentObject)),
               child (newChild != nullptr ? newChild : target->children.getObjectPointer (index)),
               childIndex (index),
-              isDeleting (newChild == nullptr)
+              isDeleting (newChild == nullptr),
+              // a removed child is only kept alive by this action, so its size is counted
+              sizeInBytes (toSizeInUnits (sizeof (*this) + (isDeleting && child != nullptr ? child->getHeapSize() : 0)))
         {
             jassert (child != nullptr);
         }
@@ -512,13 +649,14 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return sizeInBytes;
         }
 
     private:
         const Ptr target, child;
         const int childIndex;
         const bool isDeleting;
+        const int sizeInBytes;
 
         JUCE_DECLARE_NON_COPYABLE (AddOrRemoveChildAction)
     };
@@ -545,7 +683,7 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) sizeof (*this);
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
@@ -1247,6 +1385,139 @@ public:
                 expectEquals (lines[numLines - 1], "<Test number=\"" + test.second + "\"/>");
             }
         }
+
+        {
+            beginTest ("Undo coalescing");
+
+            UndoManager undoManager;
+            ValueTree v ("Test"), child ("Child");
+            v.setProperty ("x", -1, nullptr);
+            v.appendChild (child, nullptr);
+
+            undoManager.beginNewTransaction();
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                v.setProperty ("x", i, &undoManager);
+                child.setProperty ("y", -i, &undoManager);
+            }
+
+            {
+                // The merged action should be counted exactly once, at its final size
+                UndoManager singleChangeManager;
+                ValueTree v2 ("Test"), child2 ("Child");
+                v2.setProperty ("x", -1, nullptr);
+                v2.appendChild (child2, nullptr);
+
+                singleChangeManager.beginNewTransaction();
+                v2.setProperty ("x", 999, &singleChangeManager);
+                child2.setProperty ("y", -999, &singleChangeManager);
+
+                expectEquals (undoManager.getNumberOfUnitsTakenUpByStoredCommands(),
+                              singleChangeManager.getNumberOfUnitsTakenUpByStoredCommands());
+            }
+
+            v.setProperty ("temp", 1, &undoManager);
+            v.removeProperty ("temp", &undoManager);
+
+            expectEquals (undoManager.getNumActionsInCurrentTransaction(), 1);
+
+            undoManager.undo();
+            expect ((int) v["x"] == -1);
+            expect (! child.hasProperty ("y"));
+            expect (! v.hasProperty ("temp"));
+
+            undoManager.redo();
+            expect ((int) v["x"] == 999);
+            expect ((int) child["y"] == -999);
+            expect (! v.hasProperty ("temp"));
+
+            undoManager.beginNewTransaction();
+            child.setProperty ("y", 1, &undoManager);
+            child.removeProperty ("y", &undoManager);
+            child.setProperty ("y", 2, &undoManager);
+            undoManager.undo();
+            expect ((int) child["y"] == -999);
+        }
+
+        {
+            beginTest ("Undo memory accounting");
+
+            UndoManager undoManager;
+            ValueTree v ("Test");
+            const String bigString = String::repeatedString ("x", 100000);
+
+            v.setProperty ("text", bigString, &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() < 1000);
+
+            undoManager.beginNewTransaction();
+            v.setProperty ("text", "short", &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() > 100000);
+
+            ValueTree child ("Child");
+            child.setProperty ("data", bigString + "y", nullptr);
+            v.appendChild (child, nullptr);
+            const auto sizeBeforeRemoval = undoManager.getNumberOfUnitsTakenUpByStoredCommands();
+
+            undoManager.beginNewTransaction();
+            v.removeChild (child, &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() > sizeBeforeRemoval + 100000);
+
+            undoManager.setMaxNumberOfStoredUnits (50000, 1);
+            undoManager.beginNewTransaction();
+            v.setProperty ("small", 1, &undoManager);
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() < 50000);
+        }
+
+        {
+            beginTest ("Undo random edits");
+
+            auto r = getRandom();
+
+            for (int i = 0; i < 20; ++i)
+            {
+                UndoManager undoManager (std::numeric_limits<int>::max(), 1000);
+                auto v = createRandomTree (nullptr, 0, r);
+                const auto original = v.createCopy();
+
+                for (int transaction = 0; transaction < 20; ++transaction)
+                {
+                    undoManager.beginNewTransaction();
+
+                    for (int j = 0; j < 30; ++j)
+                    {
+                        auto target = v;
+
+                        while (target.getNumChildren() > 0 && r.nextBool())
+                            target = target.getChild (r.nextInt (target.getNumChildren()));
+
+                        const Identifier property ("p" + String (r.nextInt (3)));
+
+                        switch (r.nextInt (5))
+                        {
+                            case 0:
+                            case 1:  target.setProperty (property, r.nextInt (10), &undoManager); break;
+                            case 2:  target.removeProperty (property, &undoManager); break;
+                            case 3:  target.appendChild (ValueTree ("Child"), &undoManager); break;
+                            case 4:  if (target.getNumChildren() > 0) target.removeChild (r.nextInt (target.getNumChildren()), &undoManager); break;
+                            default: break;
+                        }
+                    }
+                }
+
+                const auto edited = v.createCopy();
+
+                while (undoManager.canUndo())
+                    undoManager.undo();
+
+                expect (v.isEquivalentTo (original));
+
+                while (undoManager.canRedo())
+                    undoManager.redo();
+
+                expect (v.isEquivalentTo (edited));
+            }
+        }
     }
 };
 
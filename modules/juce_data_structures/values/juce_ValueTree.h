@@ -617,6 +617,9 @@ public:
 private:
     //==============================================================================
     friend class SharedObject;
+    friend class ValueTreeArchive;
+    friend class ValueTreeSnapshot;
+    friend class ValueTreeSnapshotPublisher;
 
     ReferenceCountedObjectPtr<SharedObject> object;
     ListenerList<Listener> listeners;
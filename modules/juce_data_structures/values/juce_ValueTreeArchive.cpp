@@ -0,0 +1,1034 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  The archive format, version 1. All fixed-size integers are little-endian, and
+    "varint" means an unsigned LEB128 integer.
+
+    header:     int32 magic, uint8 version, uint8 flags (bit 0 = compressed)
+    body:       (zlib-compressed if the flag is set)
+                varint numIdentifiers, then for each: varint numBytes, UTF-8 bytes
+                node records, in post-order so that children come before their parent
+                uint32 offset of the root node, or 0xffffffff for an invalid tree
+
+    node:       varint typeIndex
+                varint numChildren, then a uint32 offset for each child
+                varint numProperties, then for each: varint nameIndex, value
+
+    value:      uint8 tag, followed by data that depends on the tag (see ValueTag)
+
+    Node offsets are relative to the start of the first node record. Because children
+    are written before their parents, a child's offset is always lower than its
+    parent's, which is checked when reading so that corrupted data can't loop. As the
+    offsets are 32-bit, the node records can't be more than 4GB long.
+
+    Nothing stops corrupted data from giving several parents the same child, which could
+    make a small archive expand into a huge tree. But every node record is at least
+    minNodeSize bytes long, so a real tree can't have more nodes than that allows for,
+    and a tree that would have more than that is rejected.
+*/
+namespace ValueTreeArchiveConstants
+{
+    constexpr static const int magicNumber      = (int) ByteOrder::makeInt ('V', 'T', 'A', 'R');
+    constexpr static const uint8 version        = 1;
+    constexpr static const uint8 compressedFlag = 1;
+    constexpr static const size_t headerSize    = 6;
+    constexpr static const uint32 noRoot        = 0xffffffff;
+    constexpr static const size_t minNodeSize   = 3;
+
+    enum ValueTag : uint8
+    {
+        voidValue,
+        intValue,           // zig-zag varint
+        int64Value,         // zig-zag varint
+        falseValue,
+        trueValue,
+        doubleValue,        // 8 bytes
+        stringValue,        // varint numBytes, UTF-8 bytes
+        otherValue          // varint numBytes, then the bytes written by var::writeToStream()
+    };
+
+    static uint64 zigZagEncode (int64 n) noexcept   { return ((uint64) n << 1) ^ (uint64) (n >> 63); }
+    static int64 zigZagDecode (uint64 n) noexcept   { return (int64) (n >> 1) ^ -(int64) (n & 1); }
+}
+
+//==============================================================================
+struct ValueTreeArchive::Cursor
+{
+    const uint8* data;
+    const uint8* end;
+    bool failed = false;
+
+    uint64 readVarint() noexcept
+    {
+        uint64 result = 0;
+
+        for (int shift = 0; shift < 64 && data < end; shift += 7)
+        {
+            auto byte = *data++;
+            result |= (uint64) (byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0)
+                return result;
+        }
+
+        failed = true;
+        return 0;
+    }
+
+    int readCount() noexcept
+    {
+        auto n = readVarint();
+
+        if (n > (uint64) (end - data))
+        {
+            // every item takes at least one byte, so this can't be right
+            failed = true;
+            return 0;
+        }
+
+        return (int) n;
+    }
+
+    const uint8* readBytes (size_t numBytes) noexcept
+    {
+        if ((size_t) (end - data) < numBytes)
+        {
+            failed = true;
+            return nullptr;
+        }
+
+        auto* start = data;
+        data += numBytes;
+        return start;
+    }
+
+    uint32 readUInt32() noexcept
+    {
+        if (auto* bytes = readBytes (4))
+            return ByteOrder::littleEndianInt (bytes);
+
+        return 0;
+    }
+
+    uint8 readByte() noexcept
+    {
+        if (auto* bytes = readBytes (1))
+            return *bytes;
+
+        return 0;
+    }
+
+    String readString() noexcept
+    {
+        auto numBytes = (size_t) readCount();
+
+        if (auto* bytes = readBytes (numBytes))
+            return String::fromUTF8 (reinterpret_cast<const char*> (bytes), (int) numBytes);
+
+        return {};
+    }
+
+    var readValue()
+    {
+        using namespace ValueTreeArchiveConstants;
+
+        switch (readByte())
+        {
+            case voidValue:     return {};
+            case intValue:      return (int) zigZagDecode (readVarint());
+            case int64Value:    return zigZagDecode (readVarint());
+            case falseValue:    return false;
+            case trueValue:     return true;
+            case stringValue:   return readString();
+
+            case doubleValue:
+                if (auto* bytes = readBytes (8))
+                {
+                    double d;
+                    auto n = ByteOrder::littleEndianInt64 (bytes);
+                    memcpy (&d, &n, sizeof (d));
+                    return d;
+                }
+
+                return {};
+
+            case otherValue:
+            {
+                auto numBytes = (size_t) readCount();
+
+                if (auto* bytes = readBytes (numBytes))
+                {
+                    MemoryInputStream in (bytes, numBytes, false);
+                    return var::readFromStream (in);
+                }
+
+                return {};
+            }
+
+            default:
+                failed = true;
+                return {};
+        }
+    }
+
+    void skipValue() noexcept
+    {
+        using namespace ValueTreeArchiveConstants;
+
+        switch (readByte())
+        {
+            case voidValue:
+            case falseValue:
+            case trueValue:     break;
+            case intValue:
+            case int64Value:    readVarint(); break;
+            case doubleValue:   readBytes (8); break;
+            case stringValue:
+            case otherValue:    readBytes ((size_t) readCount()); break;
+            default:            failed = true; break;
+        }
+    }
+};
+
+//==============================================================================
+struct ValueTreeArchive::Writer
+{
+    explicit Writer (OutputStream& o)  : out (o) {}
+
+    // Most items are only a byte or two long, so they're collected in a buffer rather
+    // than being passed to the stream one at a time.
+    void flush()
+    {
+        if (numBuffered > 0 && ! out.write (buffer, numBuffered))
+            failed = true;
+
+        numBuffered = 0;
+    }
+
+    void writeByte (uint8 byte)
+    {
+        if (numBuffered == bufferSize)
+            flush();
+
+        buffer[numBuffered++] = byte;
+        ++position;
+    }
+
+    void writeBytes (const void* data, size_t numBytes)
+    {
+        if (numBuffered + numBytes > bufferSize)
+        {
+            flush();
+
+            if (numBytes > bufferSize)
+            {
+                if (! out.write (data, numBytes))
+                    failed = true;
+
+                position += numBytes;
+                return;
+            }
+        }
+
+        memcpy (buffer + numBuffered, data, numBytes);
+        numBuffered += numBytes;
+        position += numBytes;
+    }
+
+    void writeVarint (uint64 n)
+    {
+        uint8 bytes[10];
+        size_t numBytes = 0;
+
+        for (;;)
+        {
+            auto byte = (uint8) (n & 0x7f);
+            n >>= 7;
+
+            if (n == 0)
+            {
+                bytes[numBytes++] = byte;
+                break;
+            }
+
+            bytes[numBytes++] = (uint8) (byte | 0x80);
+        }
+
+        writeBytes (bytes, numBytes);
+    }
+
+    void writeUInt32 (uint32 n)
+    {
+        auto littleEndian = ByteOrder::swapIfBigEndian (n);
+        writeBytes (&littleEndian, sizeof (littleEndian));
+    }
+
+    void writeString (const String& s)
+    {
+        auto numBytes = s.getNumBytesAsUTF8();
+        writeVarint (numBytes);
+        writeBytes (s.toRawUTF8(), numBytes);
+    }
+
+    void writeValue (const var& v)
+    {
+        using namespace ValueTreeArchiveConstants;
+
+        if (v.isVoid())
+        {
+            writeByte (voidValue);
+        }
+        else if (v.isInt())
+        {
+            writeByte (intValue);
+            writeVarint (zigZagEncode ((int) v));
+        }
+        else if (v.isInt64())
+        {
+            writeByte (int64Value);
+            writeVarint (zigZagEncode ((int64) v));
+        }
+        else if (v.isBool())
+        {
+            writeByte ((bool) v ? trueValue : falseValue);
+        }
+        else if (v.isDouble())
+        {
+            writeByte (doubleValue);
+            auto d = (double) v;
+            uint64 n;
+            memcpy (&n, &d, sizeof (n));
+            n = ByteOrder::swapIfBigEndian (n);
+            writeBytes (&n, sizeof (n));
+        }
+        else if (v.isString())
+        {
+            writeByte (stringValue);
+            writeString (v.toString());
+        }
+        else
+        {
+            MemoryOutputStream mo (256);
+            v.writeToStream (mo);
+
+            writeByte (otherValue);
+            writeVarint (mo.getDataSize());
+            writeBytes (mo.getData(), mo.getDataSize());
+        }
+    }
+
+    //==============================================================================
+    // Identifiers are pooled, so their character data can be used as a key
+    static const void* getKey (const Identifier& id) noexcept   { return id.getCharPointer().getAddress(); }
+
+    void addIdentifier (const Identifier& id)
+    {
+        if (identifierIndices.emplace (getKey (id), identifiers.size()).second)
+            identifiers.add (id);
+    }
+
+    uint64 getIndex (const Identifier& id) const
+    {
+        return (uint64) identifierIndices.at (getKey (id));
+    }
+
+    void addIdentifiers (const ValueTree::SharedObject& node)
+    {
+        addIdentifier (node.type);
+
+        for (auto& property : node.properties)
+            addIdentifier (property.name);
+
+        for (auto* child : node.children)
+            addIdentifiers (*child);
+    }
+
+    uint32 writeNode (const ValueTree::SharedObject& node)
+    {
+        auto firstChild = childOffsets.size();
+
+        for (auto* child : node.children)
+            childOffsets.push_back (writeNode (*child));
+
+        auto offset = position - nodesStart;
+
+        if (offset >= ValueTreeArchiveConstants::noRoot)
+        {
+            // The node records have grown too large for their offsets to fit in 32 bits
+            jassertfalse;
+            failed = true;
+        }
+
+        writeVarint (getIndex (node.type));
+        writeVarint (childOffsets.size() - firstChild);
+
+        for (auto i = firstChild; i < childOffsets.size(); ++i)
+            writeUInt32 (childOffsets[i]);
+
+        childOffsets.resize (firstChild);
+
+        writeVarint ((uint64) node.properties.size());
+
+        for (auto& property : node.properties)
+        {
+            writeVarint (getIndex (property.name));
+            writeValue (property.value);
+        }
+
+        return (uint32) offset;
+    }
+
+    bool writeBody (const ValueTree::SharedObject* root)
+    {
+        if (root != nullptr)
+            addIdentifiers (*root);
+
+        writeVarint ((uint64) identifiers.size());
+
+        for (auto& id : identifiers)
+            writeString (id.toString());
+
+        nodesStart = position;
+        auto rootOffset = root != nullptr ? writeNode (*root) : ValueTreeArchiveConstants::noRoot;
+
+        // If the archive couldn't be written properly, this at least stops the wrong tree being read back
+        writeUInt32 (failed ? ValueTreeArchiveConstants::noRoot : rootOffset);
+        flush();
+
+        return ! failed;
+    }
+
+    static constexpr size_t bufferSize = 4096;
+
+    OutputStream& out;
+    uint8 buffer[bufferSize];
+    size_t numBuffered = 0;
+    uint64 position = 0, nodesStart = 0;
+    bool failed = false;
+    std::unordered_map<const void*, int> identifierIndices;
+    Array<Identifier> identifiers;
+    std::vector<uint32> childOffsets;
+};
+
+//==============================================================================
+bool ValueTreeArchive::write (const ValueTree& tree, OutputStream& output)
+{
+    return write (tree, output, Options{});
+}
+
+bool ValueTreeArchive::write (const ValueTree& tree, OutputStream& output, const Options& options)
+{
+    if (! (output.writeInt (ValueTreeArchiveConstants::magicNumber)
+            && output.writeByte ((char) ValueTreeArchiveConstants::version)
+            && output.writeByte ((char) (options.isCompressed() ? ValueTreeArchiveConstants::compressedFlag : 0))))
+        return false;
+
+    if (options.isCompressed())
+    {
+        // GZIPCompressorOutputStream writes the end of the compressed data when it's flushed,
+        // which can't report failures itself, so they're caught on the way to the output
+        struct CheckedOutputStream final : public OutputStream
+        {
+            explicit CheckedOutputStream (OutputStream& o)  : out (o) {}
+
+            void flush() override                               { out.flush(); }
+            bool setPosition (int64 newPosition) override       { return out.setPosition (newPosition); }
+            int64 getPosition() override                        { return out.getPosition(); }
+
+            bool write (const void* data, size_t numBytes) override
+            {
+                if (out.write (data, numBytes))
+                    return true;
+
+                failed = true;
+                return false;
+            }
+
+            OutputStream& out;
+            bool failed = false;
+        };
+
+        CheckedOutputStream checkedOutput (output);
+        GZIPCompressorOutputStream compressor (checkedOutput, options.getCompressionLevel());
+
+        if (! Writer (compressor).writeBody (tree.object.get()))
+            return false;
+
+        compressor.flush();
+        return ! checkedOutput.failed;
+    }
+
+    return Writer (output).writeBody (tree.object.get());
+}
+
+ValueTree ValueTreeArchive::readFromData (const void* data, size_t numBytes)
+{
+    return ValueTreeArchive (data, numBytes).createValueTree();
+}
+
+ValueTree ValueTreeArchive::readFromStream (InputStream& input)
+{
+    MemoryBlock data;
+    input.readIntoMemoryBlock (data);
+    return ValueTreeArchive (std::move (data)).createValueTree();
+}
+
+//==============================================================================
+ValueTreeArchive::ValueTreeArchive (const void* data, size_t numBytes)
+{
+    open (data, numBytes);
+}
+
+ValueTreeArchive::ValueTreeArchive (MemoryBlock data)  : ownedData (std::move (data))
+{
+    open (ownedData.getData(), ownedData.getSize());
+}
+
+ValueTreeArchive::~ValueTreeArchive() = default;
+
+void ValueTreeArchive::open (const void* data, size_t numBytes)
+{
+    using namespace ValueTreeArchiveConstants;
+
+    if (data == nullptr || numBytes < headerSize)
+        return;
+
+    auto* bytes = static_cast<const uint8*> (data);
+
+    if ((int) ByteOrder::littleEndianInt (bytes) != magicNumber || bytes[4] != version)
+    {
+        jassertfalse; // this isn't an archive that was written by ValueTreeArchive::write()
+        return;
+    }
+
+    if ((bytes[5] & compressedFlag) != 0)
+    {
+        MemoryInputStream in (bytes + headerSize, numBytes - headerSize, false);
+        GZIPDecompressorInputStream decompressor (in);
+
+        MemoryBlock decompressed;
+        decompressor.readIntoMemoryBlock (decompressed);
+        ownedData = std::move (decompressed);
+
+        bytes = static_cast<const uint8*> (ownedData.getData());
+        numBytes = ownedData.getSize();
+    }
+    else
+    {
+        bytes += headerSize;
+        numBytes -= headerSize;
+    }
+
+    Cursor cursor { bytes, bytes + numBytes };
+
+    // If this fails, the data is corrupted or truncated
+    if (! readStringTable (cursor) || (size_t) (cursor.end - cursor.data) < 4)
+    {
+        identifiers.clear();
+        return;
+    }
+
+    nodes = cursor.data;
+    nodesSize = (size_t) (cursor.end - cursor.data) - 4;
+    rootOffset = ByteOrder::littleEndianInt (cursor.end - 4);
+    hasRoot = rootOffset != noRoot && rootOffset < nodesSize;
+}
+
+bool ValueTreeArchive::readStringTable (Cursor& cursor)
+{
+    auto numIdentifiers = cursor.readCount();
+    identifiers.ensureStorageAllocated (numIdentifiers);
+
+    for (int i = 0; i < numIdentifiers; ++i)
+    {
+        auto name = cursor.readString();
+
+        if (cursor.failed || name.isEmpty())
+            return false;
+
+        identifiers.add (name);
+    }
+
+    return ! cursor.failed;
+}
+
+ValueTreeArchive::Cursor ValueTreeArchive::getNodeCursor (uint32 offset) const noexcept
+{
+    return { nodes + offset, nodes + nodesSize };
+}
+
+ValueTreeArchive::Node ValueTreeArchive::getRoot() const noexcept
+{
+    return hasRoot ? Node (*this, rootOffset) : Node();
+}
+
+ValueTree ValueTreeArchive::createValueTree() const
+{
+    return getRoot().createValueTree();
+}
+
+ValueTree ValueTreeArchive::createValueTree (uint32 offset) const
+{
+    auto numNodesLeft = nodesSize / ValueTreeArchiveConstants::minNodeSize + 1;
+    auto result = createValueTree (offset, numNodesLeft);
+
+    // If this runs out, the tree has more nodes than could possibly fit in the archive
+    return numNodesLeft > 0 ? result : ValueTree();
+}
+
+ValueTree ValueTreeArchive::createValueTree (uint32 offset, size_t& numNodesLeft) const
+{
+    if (numNodesLeft == 0)
+        return {};
+
+    --numNodesLeft;
+
+    auto cursor = getNodeCursor (offset);
+    auto typeIndex = (int) cursor.readVarint();
+
+    if (cursor.failed || ! isPositiveAndBelow (typeIndex, identifiers.size()))
+        return {};
+
+    ValueTree v (identifiers.getReference (typeIndex));
+
+    auto numChildren = cursor.readCount();
+    auto* childOffsets = cursor.readBytes ((size_t) numChildren * 4);
+    v.object->children.ensureStorageAllocated (numChildren);
+
+    for (int i = 0; i < numChildren && childOffsets != nullptr; ++i)
+    {
+        auto childOffset = ByteOrder::littleEndianInt (childOffsets + 4 * i);
+
+        if (childOffset >= offset)
+            return v;
+
+        auto child = createValueTree (childOffset, numNodesLeft);
+
+        if (! child.isValid())
+            return v;
+
+        v.object->children.add (child.object);
+        child.object->parent = v.object.get();
+    }
+
+    auto numProperties = cursor.readCount();
+
+    for (int i = 0; i < numProperties && ! cursor.failed; ++i)
+    {
+        auto nameIndex = (int) cursor.readVarint();
+        auto value = cursor.readValue();
+
+        if (cursor.failed || ! isPositiveAndBelow (nameIndex, identifiers.size()))
+            break;
+
+        v.object->properties.set (identifiers.getReference (nameIndex), std::move (value));
+    }
+
+    return v;
+}
+
+ValueTreeArchive::Cursor ValueTreeArchive::getPropertiesCursor (uint32 offset) const noexcept
+{
+    auto cursor = getNodeCursor (offset);
+    cursor.readVarint();
+    cursor.readBytes ((size_t) cursor.readCount() * 4);
+    return cursor;
+}
+
+//==============================================================================
+Identifier ValueTreeArchive::Node::getType() const
+{
+    if (archive == nullptr)
+        return {};
+
+    auto cursor = archive->getNodeCursor (offset);
+    auto typeIndex = (int) cursor.readVarint();
+
+    if (cursor.failed || ! isPositiveAndBelow (typeIndex, archive->identifiers.size()))
+        return {};
+
+    return archive->identifiers.getReference (typeIndex);
+}
+
+int ValueTreeArchive::Node::getNumChildren() const
+{
+    if (archive == nullptr)
+        return 0;
+
+    auto cursor = archive->getNodeCursor (offset);
+    cursor.readVarint();
+    auto numChildren = cursor.readCount();
+    return cursor.failed ? 0 : numChildren;
+}
+
+ValueTreeArchive::Node ValueTreeArchive::Node::getChild (int index) const
+{
+    if (archive == nullptr)
+        return {};
+
+    auto cursor = archive->getNodeCursor (offset);
+    cursor.readVarint();
+    auto numChildren = cursor.readCount();
+
+    if (! isPositiveAndBelow (index, numChildren))
+        return {};
+
+    cursor.readBytes ((size_t) index * 4);
+    auto childOffset = cursor.readUInt32();
+
+    if (cursor.failed || childOffset >= offset)
+        return {};
+
+    return { *archive, childOffset };
+}
+
+ValueTreeArchive::Node ValueTreeArchive::Node::getChildWithName (const Identifier& type) const
+{
+    for (int i = 0, numChildren = getNumChildren(); i < numChildren; ++i)
+    {
+        auto child = getChild (i);
+
+        if (child.getType() == type)
+            return child;
+    }
+
+    return {};
+}
+
+int ValueTreeArchive::Node::getNumProperties() const
+{
+    if (archive == nullptr)
+        return 0;
+
+    auto cursor = archive->getPropertiesCursor (offset);
+    auto numProperties = cursor.readCount();
+    return cursor.failed ? 0 : numProperties;
+}
+
+Identifier ValueTreeArchive::Node::getPropertyName (int index) const
+{
+    if (archive == nullptr)
+        return {};
+
+    auto cursor = archive->getPropertiesCursor (offset);
+    auto numProperties = cursor.readCount();
+
+    if (! isPositiveAndBelow (index, numProperties))
+        return {};
+
+    for (int i = 0; i < index; ++i)
+    {
+        cursor.readVarint();
+        cursor.skipValue();
+    }
+
+    auto nameIndex = (int) cursor.readVarint();
+
+    if (cursor.failed || ! isPositiveAndBelow (nameIndex, archive->identifiers.size()))
+        return {};
+
+    return archive->identifiers.getReference (nameIndex);
+}
+
+bool ValueTreeArchive::Node::hasProperty (const Identifier& name) const
+{
+    return findProperty (name) != nullptr;
+}
+
+var ValueTreeArchive::Node::getProperty (const Identifier& name, const var& defaultReturnValue) const
+{
+    if (auto* value = findProperty (name))
+    {
+        Cursor cursor { value, archive->nodes + archive->nodesSize };
+        auto result = cursor.readValue();
+
+        if (! cursor.failed)
+            return result;
+    }
+
+    return defaultReturnValue;
+}
+
+const uint8* ValueTreeArchive::Node::findProperty (const Identifier& name) const
+{
+    if (archive == nullptr)
+        return nullptr;
+
+    auto cursor = archive->getPropertiesCursor (offset);
+
+    for (int i = cursor.readCount(); --i >= 0 && ! cursor.failed;)
+    {
+        auto nameIndex = (int) cursor.readVarint();
+
+        if (isPositiveAndBelow (nameIndex, archive->identifiers.size())
+             && archive->identifiers.getReference (nameIndex) == name)
+            return cursor.data;
+
+        cursor.skipValue();
+    }
+
+    return nullptr;
+}
+
+ValueTree ValueTreeArchive::Node::createValueTree() const
+{
+    return archive != nullptr ? archive->createValueTree (offset) : ValueTree();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeArchiveTests final : public UnitTest
+{
+public:
+    ValueTreeArchiveTests()
+        : UnitTest ("ValueTreeArchive", UnitTestCategories::values)
+    {}
+
+    static MemoryBlock write (const ValueTree& v, const ValueTreeArchive::Options& options = ValueTreeArchive::Options{})
+    {
+        MemoryOutputStream mo;
+        ValueTreeArchive::write (v, mo, options);
+        return mo.getMemoryBlock();
+    }
+
+    static ValueTree createLargeTree (int numNodes)
+    {
+        ValueTree root ("STATE");
+
+        for (int i = 0; i < numNodes; ++i)
+        {
+            ValueTree node ("PARAMETER");
+            node.setProperty ("id", "parameter" + String (i), nullptr);
+            node.setProperty ("value", i * 0.001, nullptr);
+            node.setProperty ("index", i, nullptr);
+            node.setProperty ("automatable", (i & 1) != 0, nullptr);
+
+            ValueTree mapping ("MAPPING");
+            mapping.setProperty ("channel", i % 16, nullptr);
+            mapping.setProperty ("controller", i % 128, nullptr);
+            node.appendChild (mapping, nullptr);
+
+            root.appendChild (node, nullptr);
+        }
+
+        return root;
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Round trip");
+        {
+            for (int i = 20; --i >= 0;)
+            {
+                auto v1 = ValueTreeTests::createRandomTree (nullptr, 0, r);
+                v1.setProperty ("int64", (int64) r.nextInt64(), nullptr);
+                v1.setProperty ("array", Array<var> { 1, "two", 3.0 }, nullptr);
+
+                auto data = write (v1);
+                expect (v1.isEquivalentTo (ValueTreeArchive::readFromData (data.getData(), data.getSize())));
+
+                MemoryInputStream mi (data, false);
+                expect (v1.isEquivalentTo (ValueTreeArchive::readFromStream (mi)));
+
+                auto zipped = write (v1, ValueTreeArchive::Options{}.withCompression (true));
+                expect (v1.isEquivalentTo (ValueTreeArchive::readFromData (zipped.getData(), zipped.getSize())));
+            }
+
+            auto data = write ({});
+            ValueTreeArchive archive (data.getData(), data.getSize());
+            expect (archive.isValid());
+            expect (! archive.getRoot().isValid());
+            expect (! archive.createValueTree().isValid());
+        }
+
+        beginTest ("Random access");
+        {
+            for (int i = 20; --i >= 0;)
+            {
+                auto tree = ValueTreeTests::createRandomTree (nullptr, 0, r);
+                auto data = write (tree, ValueTreeArchive::Options{}.withCompression (r.nextBool()));
+                ValueTreeArchive archive (std::move (data));
+
+                std::function<void (const ValueTree&, const ValueTreeArchive::Node&)> check;
+                check = [this, &check] (const ValueTree& v, const ValueTreeArchive::Node& node)
+                {
+                    expect (node.isValid());
+                    expect (node.getType() == v.getType());
+                    expectEquals (node.getNumProperties(), v.getNumProperties());
+                    expectEquals (node.getNumChildren(), v.getNumChildren());
+
+                    for (int p = 0; p < v.getNumProperties(); ++p)
+                    {
+                        auto propertyName = v.getPropertyName (p);
+                        expect (node.getPropertyName (p) == propertyName);
+                        expect (node.hasProperty (propertyName));
+                        expect (node.getProperty (propertyName).equalsWithSameType (v[propertyName]));
+                    }
+
+                    expect (! node.hasProperty ("missingProperty"));
+                    expectEquals ((int) node.getProperty ("missingProperty", 42), 42);
+                    expect (! node.getChild (v.getNumChildren()).isValid());
+
+                    for (int c = 0; c < v.getNumChildren(); ++c)
+                    {
+                        expect (node.getChildWithName (v.getChild (c).getType()).getType() == v.getChild (c).getType());
+                        check (v.getChild (c), node.getChild (c));
+                    }
+
+                    expect (node.createValueTree().isEquivalentTo (v));
+                };
+
+                check (tree, archive.getRoot());
+            }
+        }
+
+        beginTest ("Size");
+        {
+            auto tree = createLargeTree (1000);
+
+            MemoryOutputStream original;
+            tree.writeToStream (original);
+
+            auto data = write (tree);
+            expect (data.getSize() < original.getDataSize());
+
+            auto zipped = write (tree, ValueTreeArchive::Options{}.withCompression (true));
+            expect (zipped.getSize() < data.getSize());
+        }
+
+        beginTest ("Corrupted data");
+        {
+            auto data = write (createLargeTree (20));
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto corrupted = data;
+                auto* bytes = static_cast<uint8*> (corrupted.getData());
+
+                for (int j = 0; j < 4; ++j)
+                    bytes[6 + r.nextInt ((int) corrupted.getSize() - 6)] = (uint8) r.nextInt (256);
+
+                ValueTreeArchive archive (corrupted.getData(), (size_t) r.nextInt ((int) corrupted.getSize() + 1));
+                auto root = archive.getRoot();
+
+                for (int c = 0; c < root.getNumChildren(); ++c)
+                    ignoreUnused (root.getChild (c).getProperty ("value"));
+            }
+        }
+
+        beginTest ("Children that are shared by several parents can't make the tree expand");
+        {
+            // Each node has two children, which are both the node before it, so creating a
+            // ValueTree from the root would need 2^64 nodes
+            MemoryOutputStream mo;
+            mo.writeInt (ValueTreeArchiveConstants::magicNumber);
+            mo.writeByte ((char) ValueTreeArchiveConstants::version);
+            mo.writeByte (0);
+
+            const uint8 stringTable[] { 1, 1, 'A' };
+            mo.write (stringTable, sizeof (stringTable));
+
+            const auto nodesStart = (int) mo.getDataSize();
+            const uint8 leaf[] { 0, 0, 0 };
+            mo.write (leaf, sizeof (leaf));
+
+            auto previous = 0;
+
+            for (int i = 0; i < 64; ++i)
+            {
+                const auto offset = (int) mo.getDataSize() - nodesStart;
+                mo.writeByte (0);
+                mo.writeByte (2);
+                mo.writeInt (previous);
+                mo.writeInt (previous);
+                mo.writeByte (0);
+                previous = offset;
+            }
+
+            mo.writeInt (previous);
+
+            ValueTreeArchive archive (mo.getData(), mo.getDataSize());
+            expect (archive.getRoot().isValid());
+            expectEquals (archive.getRoot().getChild (1).getChild (0).getNumChildren(), 2);
+            expect (! archive.createValueTree().isValid());
+
+            auto data = write (ValueTree ("A"));
+            expect (ValueTreeArchive::readFromData (data.getData(), data.getSize()).isEquivalentTo (ValueTree ("A")));
+        }
+
+        beginTest ("Write failures are reported");
+        {
+            struct FailingStream final : public MemoryOutputStream
+            {
+                explicit FailingStream (size_t limit)  : maxSize (limit) {}
+
+                bool write (const void* data, size_t numBytes) override
+                {
+                    return getDataSize() + numBytes <= maxSize && MemoryOutputStream::write (data, numBytes);
+                }
+
+                size_t maxSize;
+            };
+
+            const auto tree = createLargeTree (200);
+            const auto size = write (tree).getSize();
+
+            FailingStream enoughSpace (size);
+            expect (ValueTreeArchive::write (tree, enoughSpace));
+
+            for (auto limit : { (size_t) 0, (size_t) 3, size / 2, size - 1 })
+            {
+                FailingStream tooSmall (limit);
+                expect (! ValueTreeArchive::write (tree, tooSmall));
+            }
+
+            // Most of the compressed data is only written when the compressor is flushed
+            const auto compressed = ValueTreeArchive::Options{}.withCompression (true);
+            const auto compressedSize = write (tree, compressed).getSize();
+
+            FailingStream enoughSpaceForCompressed (compressedSize);
+            expect (ValueTreeArchive::write (tree, enoughSpaceForCompressed, compressed));
+
+            for (auto limit : { (size_t) 0, (size_t) 3, compressedSize / 2, compressedSize - 1 })
+            {
+                FailingStream tooSmall (limit);
+                expect (! ValueTreeArchive::write (tree, tooSmall, compressed));
+            }
+        }
+    }
+};
+
+static ValueTreeArchiveTests valueTreeArchiveTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Stores a ValueTree in a compact, versioned binary format that can be read back
+    lazily, one subtree at a time.
+
+    ValueTree::writeToStream() writes every property name in full for every node, and
+    ValueTree::readFromStream() has to rebuild the whole tree. This format instead
+    keeps a table of the tree's distinct Identifiers, so that each name is written
+    just once, and uses variable-length integers for indices, lengths and integer
+    values. Each node also stores the offsets of its children, so an archive that is
+    held in memory (for example in a MemoryBlock, or a MemoryMappedFile) can be
+    navigated with Node objects, and only the parts that are needed turned into
+    ValueTrees.
+
+    @code
+    MemoryOutputStream out;
+    ValueTreeArchive::write (state, out);
+
+    ValueTreeArchive archive (out.getData(), out.getDataSize());
+
+    if (auto presets = archive.getRoot().getChildWithName ("PRESETS"); presets.isValid())
+        loadPresets (presets.createValueTree());
+    @endcode
+
+    The archive can optionally be compressed with GZIPCompressorOutputStream. A
+    compressed archive has to be decompressed into memory before it can be read, but
+    can still be materialised one subtree at a time after that.
+
+    @see ValueTree
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeArchive
+{
+public:
+    //==============================================================================
+    /** Options that control how an archive is written. */
+    class [[nodiscard]] Options
+    {
+    public:
+        /** Returns a copy of these options with compression enabled or disabled. */
+        Options withCompression (bool x) const         { return withMember (*this, &Options::compressed, x); }
+
+        /** Returns a copy of these options with the given compression level, which is
+            passed to GZIPCompressorOutputStream.
+        */
+        Options withCompressionLevel (int x) const     { return withMember (*this, &Options::compressionLevel, x); }
+
+        /** Returns true if the archive will be compressed. */
+        bool isCompressed() const                       { return compressed; }
+
+        /** Returns the compression level that will be used if compression is enabled. */
+        int getCompressionLevel() const                 { return compressionLevel; }
+
+    private:
+        bool compressed = false;
+        int compressionLevel = -1;
+    };
+
+    /** Writes a tree (and all its children) to a stream in the archive format.
+
+        Returns false if the stream couldn't be written to, or if the tree is too large
+        for the format, which can't hold more than 4GB of nodes.
+    */
+    static bool write (const ValueTree& tree, OutputStream& output);
+
+    /** Writes a tree (and all its children) to a stream in the archive format, using
+        the given options.
+
+        Returns false if the stream couldn't be written to, or if the tree is too large
+        for the format, which can't hold more than 4GB of nodes.
+    */
+    static bool write (const ValueTree& tree, OutputStream& output, const Options& options);
+
+    /** Reads a whole tree from a block of data that was written with write(). */
+    static ValueTree readFromData (const void* data, size_t numBytes);
+
+    /** Reads a whole tree from a stream that contains data written with write(). */
+    static ValueTree readFromStream (InputStream& input);
+
+    //==============================================================================
+    /** Opens an archive that was written with write().
+
+        If the archive isn't compressed, the data is used in-place and isn't copied, so
+        it must remain valid for the lifetime of this object, and of any Node objects
+        that it returns.
+    */
+    ValueTreeArchive (const void* data, size_t numBytes);
+
+    /** Opens an archive that was written with write(), taking ownership of the data. */
+    explicit ValueTreeArchive (MemoryBlock data);
+
+    /** Destructor. */
+    ~ValueTreeArchive();
+
+    /** Returns true if the data was a readable archive. */
+    bool isValid() const noexcept               { return nodes != nullptr; }
+
+    //==============================================================================
+    /**
+        Refers to one node of the tree that is stored in a ValueTreeArchive.
+
+        Nothing is copied out of the archive until you ask for it, so these objects are
+        cheap to create and pass around. They must not outlive the archive.
+    */
+    class JUCE_API  Node
+    {
+    public:
+        /** Creates an invalid node. */
+        Node() = default;
+
+        /** Returns true if this refers to a node in an archive. */
+        bool isValid() const noexcept           { return archive != nullptr; }
+
+        /** Returns the type of this node. */
+        Identifier getType() const;
+
+        /** Returns the number of properties that this node has. */
+        int getNumProperties() const;
+
+        /** Returns the name of one of this node's properties. */
+        Identifier getPropertyName (int index) const;
+
+        /** Returns true if this node contains a property with the given name. */
+        bool hasProperty (const Identifier& name) const;
+
+        /** Returns the value of a named property, or defaultReturnValue if there's
+            no such property.
+        */
+        var getProperty (const Identifier& name, const var& defaultReturnValue = {}) const;
+
+        /** Returns the number of child nodes. */
+        int getNumChildren() const;
+
+        /** Returns one of this node's children, or an invalid node if the index is
+            out of range.
+        */
+        Node getChild (int index) const;
+
+        /** Returns the first child with the given type, or an invalid node if there
+            isn't one.
+        */
+        Node getChildWithName (const Identifier& type) const;
+
+        /** Creates a ValueTree containing this node, its properties, and all of its
+            children.
+
+            If the archive is corrupted, this may return an incomplete tree, or an
+            invalid one.
+        */
+        ValueTree createValueTree() const;
+
+    private:
+        friend class ValueTreeArchive;
+        Node (const ValueTreeArchive& a, uint32 o) noexcept  : archive (&a), offset (o) {}
+
+        const uint8* findProperty (const Identifier&) const;
+
+        const ValueTreeArchive* archive = nullptr;
+        uint32 offset = 0;
+    };
+
+    /** Returns the archive's root node, which will be invalid if the archive couldn't
+        be read, or if it contains an invalid ValueTree.
+    */
+    Node getRoot() const noexcept;
+
+    /** Creates a ValueTree containing the whole archive. */
+    ValueTree createValueTree() const;
+
+private:
+    //==============================================================================
+    struct Cursor;
+    struct Writer;
+
+    void open (const void* data, size_t numBytes);
+    bool readStringTable (Cursor&);
+    Cursor getNodeCursor (uint32 offset) const noexcept;
+    Cursor getPropertiesCursor (uint32 offset) const noexcept;
+    ValueTree createValueTree (uint32 offset) const;
+    ValueTree createValueTree (uint32 offset, size_t& numNodesLeft) const;
+
+    MemoryBlock ownedData;
+    Array<Identifier> identifiers;
+    const uint8* nodes = nullptr;
+    size_t nodesSize = 0;
+    uint32 rootOffset = 0;
+    bool hasRoot = false;
+
+    JUCE_DECLARE_NON_COPYABLE (ValueTreeArchive)
+};
+
+} // namespace juce
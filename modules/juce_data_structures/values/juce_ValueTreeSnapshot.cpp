@@ -0,0 +1,494 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ValueTreeSnapshot::Node final : public ReferenceCountedObject
+{
+    using Ptr = ReferenceCountedObjectPtr<Node>;
+
+    explicit Node (const ValueTree::SharedObject& source)
+        : type (source.type), properties (source.properties)
+    {
+        children.ensureStorageAllocated (source.children.size());
+    }
+
+    static Ptr createCopy (const ValueTree::SharedObject& source)
+    {
+        Ptr node (new Node (source));
+
+        for (auto* c : source.children)
+            node->children.add (createCopy (*c));
+
+        return node;
+    }
+
+    const Identifier type;
+    const NamedValueSet properties;
+    ReferenceCountedArray<Node> children;
+
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+//==============================================================================
+ValueTreeSnapshot::ValueTreeSnapshot() noexcept = default;
+ValueTreeSnapshot::ValueTreeSnapshot (ReferenceCountedObjectPtr<Node> n) noexcept  : node (std::move (n)) {}
+
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTree& tree)
+    : node (tree.object != nullptr ? Node::createCopy (*tree.object) : nullptr)
+{
+}
+
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept = default;
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (const ValueTreeSnapshot&) noexcept = default;
+ValueTreeSnapshot::ValueTreeSnapshot (ValueTreeSnapshot&&) noexcept = default;
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (ValueTreeSnapshot&&) noexcept = default;
+ValueTreeSnapshot::~ValueTreeSnapshot() = default;
+
+Identifier ValueTreeSnapshot::getType() const noexcept
+{
+    return node != nullptr ? node->type : Identifier();
+}
+
+bool ValueTreeSnapshot::hasType (const Identifier& typeName) const noexcept
+{
+    return node != nullptr && node->type == typeName;
+}
+
+int ValueTreeSnapshot::getNumProperties() const noexcept
+{
+    return node != nullptr ? node->properties.size() : 0;
+}
+
+Identifier ValueTreeSnapshot::getPropertyName (int index) const noexcept
+{
+    return node != nullptr ? node->properties.getName (index) : Identifier();
+}
+
+bool ValueTreeSnapshot::hasProperty (const Identifier& name) const noexcept
+{
+    return node != nullptr && node->properties.contains (name);
+}
+
+const var& ValueTreeSnapshot::getProperty (const Identifier& name) const noexcept
+{
+    return node == nullptr ? getNullVarRef() : node->properties[name];
+}
+
+var ValueTreeSnapshot::getProperty (const Identifier& name, const var& defaultReturnValue) const
+{
+    return node == nullptr ? defaultReturnValue : node->properties.getWithDefault (name, defaultReturnValue);
+}
+
+const var& ValueTreeSnapshot::operator[] (const Identifier& name) const noexcept
+{
+    return getProperty (name);
+}
+
+int ValueTreeSnapshot::getNumChildren() const noexcept
+{
+    return node != nullptr ? node->children.size() : 0;
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChild (int index) const
+{
+    return ValueTreeSnapshot (node != nullptr ? node->children[index] : nullptr);
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithName (const Identifier& typeToMatch) const
+{
+    if (node != nullptr)
+        for (auto* c : node->children)
+            if (c->type == typeToMatch)
+                return ValueTreeSnapshot (c);
+
+    return {};
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const
+{
+    if (node != nullptr)
+        for (auto* c : node->children)
+            if (c->properties[propertyName] == propertyValue)
+                return ValueTreeSnapshot (c);
+
+    return {};
+}
+
+bool ValueTreeSnapshot::isEquivalentTo (const ValueTree& tree) const
+{
+    if (node == nullptr || tree.object == nullptr)
+        return node == nullptr && tree.object == nullptr;
+
+    const auto& other = *tree.object;
+
+    if (node->type != other.type
+         || node->properties != other.properties
+         || node->children.size() != other.children.size())
+        return false;
+
+    for (int i = 0; i < node->children.size(); ++i)
+        if (! ValueTreeSnapshot (node->children.getObjectPointerUnchecked (i))
+                .isEquivalentTo (ValueTree (*other.children.getObjectPointerUnchecked (i))))
+            return false;
+
+    return true;
+}
+
+ValueTree ValueTreeSnapshot::createValueTree() const
+{
+    if (node == nullptr)
+        return {};
+
+    ValueTree v (node->type);
+    v.object->properties = node->properties;
+
+    for (int i = 0; i < node->children.size(); ++i)
+        v.appendChild (getChild (i).createValueTree(), nullptr);
+
+    return v;
+}
+
+//==============================================================================
+ValueTreeSnapshotPublisher::ValueTreeSnapshotPublisher (const ValueTree& treeToWatch)
+    : tree (treeToWatch)
+{
+    tree.addListener (this);
+    publish();
+}
+
+ValueTreeSnapshotPublisher::~ValueTreeSnapshotPublisher()
+{
+    cancelPendingUpdate();
+    tree.removeListener (this);
+}
+
+ValueTreeSnapshot ValueTreeSnapshotPublisher::publish()
+{
+    cancelPendingUpdate();
+
+    ValueTreeSnapshot snapshot (tree.object != nullptr ? getOrCreateNode (*tree.object) : nullptr);
+    ValueTreeSnapshot previous;
+
+    {
+        const SpinLock::ScopedLockType sl (latestLock);
+        previous = std::exchange (latest, snapshot);
+    }
+
+    // (the previous snapshot is released outside the lock, in case this was the last
+    // reference to it and it has to be deleted)
+    return snapshot;
+}
+
+ValueTreeSnapshot ValueTreeSnapshotPublisher::getLatest() const
+{
+    const SpinLock::ScopedLockType sl (latestLock);
+    return latest;
+}
+
+void ValueTreeSnapshotPublisher::setPublishesAutomatically (bool shouldPublishAutomatically)
+{
+    publishesAutomatically = shouldPublishAutomatically;
+
+    if (! publishesAutomatically)
+        cancelPendingUpdate();
+}
+
+ValueTreeSnapshotPublisher::NodePtr ValueTreeSnapshotPublisher::getOrCreateNode (const ValueTree::SharedObject& source)
+{
+    auto found = unchangedNodes.find (&source);
+
+    if (found != unchangedNodes.end())
+        return found->second;
+
+    NodePtr node (new ValueTreeSnapshot::Node (source));
+
+    for (auto* c : source.children)
+        node->children.add (getOrCreateNode (*c));
+
+    unchangedNodes.emplace (&source, node);
+    return node;
+}
+
+void ValueTreeSnapshotPublisher::markAsChanged (const ValueTree& changedTree)
+{
+    // A tree's parents are always removed from the map along with it, so once a tree
+    // is found that has already been removed, all of its parents will have been too.
+    for (auto* o = changedTree.object.get(); o != nullptr; o = o->parent)
+        if (unchangedNodes.erase (o) == 0)
+            break;
+
+    if (publishesAutomatically)
+        triggerAsyncUpdate();
+}
+
+void ValueTreeSnapshotPublisher::forgetSubtree (const ValueTree::SharedObject& removed)
+{
+    unchangedNodes.erase (&removed);
+
+    for (auto* c : removed.children)
+        forgetSubtree (*c);
+}
+
+void ValueTreeSnapshotPublisher::valueTreePropertyChanged (ValueTree& changedTree, const Identifier&)
+{
+    markAsChanged (changedTree);
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildAdded (ValueTree& parent, ValueTree&)
+{
+    markAsChanged (parent);
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildRemoved (ValueTree& parent, ValueTree& child, int)
+{
+    // The removed tree could be deleted, and its address reused by a new one
+    if (child.object != nullptr)
+        forgetSubtree (*child.object);
+
+    markAsChanged (parent);
+}
+
+void ValueTreeSnapshotPublisher::valueTreeChildOrderChanged (ValueTree& parent, int, int)
+{
+    markAsChanged (parent);
+}
+
+void ValueTreeSnapshotPublisher::handleAsyncUpdate()
+{
+    publish();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSnapshotTests final : public UnitTest
+{
+public:
+    ValueTreeSnapshotTests()
+        : UnitTest ("ValueTreeSnapshot", UnitTestCategories::values)
+    {}
+
+    static void makeRandomEdit (ValueTree root, Random& r)
+    {
+        auto v = root;
+
+        while (v.getNumChildren() > 0 && r.nextInt (3) != 0)
+            v = v.getChild (r.nextInt (v.getNumChildren()));
+
+        const Identifier property ("p" + String (r.nextInt (4)));
+
+        switch (r.nextInt (6))
+        {
+            case 0:
+            case 1:  v.setProperty (property, r.nextInt (100), nullptr); break;
+            case 2:  v.removeProperty (property, nullptr); break;
+            case 3:  v.addChild (ValueTreeTests::createRandomTree (nullptr, 4, r), r.nextInt (v.getNumChildren() + 1), nullptr); break;
+            case 4:  if (v.getNumChildren() > 0) v.removeChild (r.nextInt (v.getNumChildren()), nullptr); break;
+            case 5:  if (v.getNumChildren() > 1) v.moveChild (r.nextInt (v.getNumChildren()), r.nextInt (v.getNumChildren()), nullptr); break;
+            default: break;
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Snapshot contents");
+        {
+            for (int i = 0; i < 10; ++i)
+            {
+                auto tree = ValueTreeTests::createRandomTree (nullptr, 0, r);
+                ValueTreeSnapshot copy (tree);
+                ValueTreeSnapshotPublisher publisher (tree);
+                auto snapshot = publisher.getLatest();
+
+                expect (copy.isEquivalentTo (tree));
+                expect (snapshot.isEquivalentTo (tree));
+                expect (snapshot.createValueTree().isEquivalentTo (tree));
+                expect (snapshot.getType() == tree.getType());
+                expectEquals (snapshot.getNumProperties(), tree.getNumProperties());
+                expectEquals (snapshot.getNumChildren(), tree.getNumChildren());
+
+                for (int j = 0; j < tree.getNumProperties(); ++j)
+                    expect (snapshot[tree.getPropertyName (j)] == tree[tree.getPropertyName (j)]);
+            }
+
+            ValueTreeSnapshot invalid;
+            expect (! invalid.isValid());
+            expect (! invalid.getChild (0).isValid());
+            expect (invalid.getProperty ("x").isVoid());
+            expect (invalid.isEquivalentTo ({}));
+        }
+
+        beginTest ("Unchanged subtrees are shared");
+        {
+            ValueTree tree ("Root");
+            tree.appendChild (ValueTree ("A"), nullptr);
+            tree.appendChild (ValueTree ("B"), nullptr);
+            tree.getChild (1).appendChild (ValueTree ("C"), nullptr);
+
+            ValueTreeSnapshotPublisher publisher (tree);
+            publisher.setPublishesAutomatically (false);
+            auto first = publisher.getLatest();
+
+            tree.getChild (0).setProperty ("x", 1, nullptr);
+            expect (publisher.getLatest().isSameAs (first));
+
+            auto second = publisher.publish();
+            expect (publisher.getLatest().isSameAs (second));
+            expect (! second.isSameAs (first));
+            expect (! second.getChild (0).isSameAs (first.getChild (0)));
+            expect (second.getChild (1).isSameAs (first.getChild (1)));
+            expect (second.getChildWithName ("B").getChildWithName ("C").isSameAs (first.getChild (1).getChild (0)));
+
+            expect (! first.getChild (0).hasProperty ("x"));
+            expect ((int) second.getChild (0)["x"] == 1);
+            expect (second.getChildWithProperty ("x", 1).isSameAs (second.getChild (0)));
+
+            expect (publisher.publish().isSameAs (second));
+
+            tree.getChild (1).getChild (0).setProperty ("y", 2, nullptr);
+            auto third = publisher.publish();
+            expect (third.getChild (0).isSameAs (second.getChild (0)));
+            expect (! third.getChild (1).isSameAs (second.getChild (1)));
+        }
+
+        beginTest ("Random edits");
+        {
+            for (int i = 0; i < 10; ++i)
+            {
+                auto tree = ValueTreeTests::createRandomTree (nullptr, 0, r);
+                ValueTreeSnapshotPublisher publisher (tree);
+                publisher.setPublishesAutomatically (false);
+
+                Array<ValueTreeSnapshot> snapshots;
+                Array<ValueTree> copies;
+
+                for (int j = 0; j < 30; ++j)
+                {
+                    for (int k = r.nextInt (5); --k >= 0;)
+                        makeRandomEdit (tree, r);
+
+                    snapshots.add (publisher.publish());
+                    copies.add (tree.createCopy());
+                    expect (snapshots.getLast().isEquivalentTo (tree));
+                }
+
+                for (int j = 0; j < snapshots.size(); ++j)
+                    expect (snapshots.getReference (j).isEquivalentTo (copies.getReference (j)));
+            }
+        }
+
+        beginTest ("Concurrent readers");
+        {
+            ValueTree tree ("Root");
+            tree.setProperty ("a", 0, nullptr);
+            tree.setProperty ("b", 0, nullptr);
+
+            ValueTreeSnapshotPublisher publisher (tree);
+            publisher.setPublishesAutomatically (false);
+
+            std::atomic<bool> finished { false }, consistent { true };
+            std::atomic<int> numReads { 0 };
+
+            struct Reader final : public Thread
+            {
+                Reader (ValueTreeSnapshotPublisher& p, std::atomic<bool>& f, std::atomic<bool>& c, std::atomic<int>& n)
+                    : Thread ("ValueTreeSnapshot reader"), publisher (p), finished (f), consistent (c), numReads (n)
+                {}
+
+                void run() override
+                {
+                    while (! finished)
+                    {
+                        auto snapshot = publisher.getLatest();
+
+                        if (snapshot["a"] != snapshot["b"] || snapshot.getNumChildren() != (int) snapshot["a"])
+                            consistent = false;
+
+                        ++numReads;
+                    }
+                }
+
+                ValueTreeSnapshotPublisher& publisher;
+                std::atomic<bool>& finished;
+                std::atomic<bool>& consistent;
+                std::atomic<int>& numReads;
+            };
+
+            Reader reader (publisher, finished, consistent, numReads);
+            reader.startThread();
+
+            for (int i = 1; i <= 500; ++i)
+            {
+                tree.appendChild (ValueTree ("Child"), nullptr);
+                tree.setProperty ("a", i, nullptr);
+                tree.setProperty ("b", i, nullptr);
+                publisher.publish();
+            }
+
+            finished = true;
+            reader.stopThread (10000);
+
+            expect (consistent);
+            expect (numReads > 0);
+            expect (publisher.getLatest().isEquivalentTo (tree));
+        }
+
+        beginTest ("Publishing shares unchanged subtrees with the previous snapshot");
+        {
+            ValueTree tree ("Root");
+
+            for (int i = 0; i < 100; ++i)
+            {
+                ValueTree group ("Group");
+
+                for (int j = 0; j < 100; ++j)
+                    group.appendChild (ValueTree ("Parameter", { { "id", "p" + String (i * 100 + j) }, { "value", 0.5 } }), nullptr);
+
+                tree.appendChild (group, nullptr);
+            }
+
+            ValueTreeSnapshotPublisher publisher (tree);
+            publisher.setPublishesAutomatically (false);
+
+            auto before = publisher.publish();
+            tree.getChild (1).getChild (0).setProperty ("value", 2.0, nullptr);
+            auto after = publisher.publish();
+
+            expect (after.getChild (0).isSameAs (before.getChild (0)));
+            expect (after.isEquivalentTo (tree));
+        }
+    }
+};
+
+static ValueTreeSnapshotTests valueTreeSnapshotTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An immutable, thread-safe view of the state of a ValueTree at a particular moment.
+
+    A ValueTree can only be used safely from one thread, so reading it from a worker
+    thread normally means taking a copy with ValueTree::createCopy(), which costs time
+    proportional to the size of the tree. A ValueTreeSnapshot can be copied and read
+    on any thread, and never changes once it has been created.
+
+    Snapshots are created by a ValueTreeSnapshotPublisher, which shares any subtrees
+    that haven't changed between one snapshot and the next, so publishing a new version
+    after a small edit only costs time proportional to the depth of the edit.
+
+    Note that property values are copied in the same way as var objects, so any arrays
+    or objects that a property contains are shared with the original tree rather than
+    duplicated. Don't modify these in-place if the snapshot may be read on another thread.
+
+    @see ValueTreeSnapshotPublisher, ValueTree
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshot  final
+{
+public:
+    //==============================================================================
+    /** Creates an invalid snapshot. */
+    ValueTreeSnapshot() noexcept;
+
+    /** Creates a snapshot of a ValueTree by copying all of it.
+
+        This costs as much as ValueTree::createCopy(), so if you need to take snapshots
+        of a tree repeatedly, use a ValueTreeSnapshotPublisher instead.
+    */
+    explicit ValueTreeSnapshot (const ValueTree& tree);
+
+    /** Creates a reference to the same snapshot as another one. */
+    ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept;
+
+    /** Creates a reference to the same snapshot as another one. */
+    ValueTreeSnapshot& operator= (const ValueTreeSnapshot&) noexcept;
+
+    /** Move constructor. */
+    ValueTreeSnapshot (ValueTreeSnapshot&&) noexcept;
+
+    /** Move assignment operator. */
+    ValueTreeSnapshot& operator= (ValueTreeSnapshot&&) noexcept;
+
+    /** Destructor. */
+    ~ValueTreeSnapshot();
+
+    //==============================================================================
+    /** Returns true if this snapshot refers to a tree. */
+    bool isValid() const noexcept                                   { return node != nullptr; }
+
+    /** Returns the type of the tree. */
+    Identifier getType() const noexcept;
+
+    /** Returns true if the tree has the given type. */
+    bool hasType (const Identifier& typeName) const noexcept;
+
+    /** Returns the number of properties that the tree has. */
+    int getNumProperties() const noexcept;
+
+    /** Returns the name of one of the tree's properties. */
+    Identifier getPropertyName (int index) const noexcept;
+
+    /** Returns true if the tree contains the given property. */
+    bool hasProperty (const Identifier& name) const noexcept;
+
+    /** Returns the value of a property, or a void var if it doesn't exist. */
+    const var& getProperty (const Identifier& name) const noexcept;
+
+    /** Returns the value of a property, or the given default if it doesn't exist. */
+    var getProperty (const Identifier& name, const var& defaultReturnValue) const;
+
+    /** Returns the value of a property, or a void var if it doesn't exist. */
+    const var& operator[] (const Identifier& name) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of child trees. */
+    int getNumChildren() const noexcept;
+
+    /** Returns one of the child trees, or an invalid snapshot if the index is out of range. */
+    ValueTreeSnapshot getChild (int index) const;
+
+    /** Returns the first child tree with the given type, or an invalid snapshot if none is found. */
+    ValueTreeSnapshot getChildWithName (const Identifier& type) const;
+
+    /** Returns the first child tree that has the given property value, or an invalid
+        snapshot if none is found.
+    */
+    ValueTreeSnapshot getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const;
+
+    //==============================================================================
+    /** Returns true if both snapshots refer to the same version of the same tree.
+
+        Because unchanged subtrees are shared between the snapshots that a
+        ValueTreeSnapshotPublisher creates, this is a cheap way to find out whether a
+        part of the tree has changed between two snapshots. Note that two snapshots
+        that aren't the same may still have equivalent contents.
+    */
+    bool isSameAs (const ValueTreeSnapshot& other) const noexcept   { return node == other.node; }
+
+    /** Returns true if the snapshot has the same type, properties and children as a
+        ValueTree.
+    */
+    bool isEquivalentTo (const ValueTree& tree) const;
+
+    /** Creates a new ValueTree with the same contents as this snapshot. */
+    ValueTree createValueTree() const;
+
+private:
+    //==============================================================================
+    struct Node;
+    friend class ValueTreeSnapshotPublisher;
+
+    explicit ValueTreeSnapshot (ReferenceCountedObjectPtr<Node>) noexcept;
+
+    ReferenceCountedObjectPtr<Node> node;
+};
+
+//==============================================================================
+/**
+    Watches a ValueTree and publishes ValueTreeSnapshots of it for other threads to read.
+
+    The publisher is used on the thread that owns the ValueTree (usually the message
+    thread). It keeps track of which parts of the tree have changed since the last
+    snapshot, so that a new snapshot only needs to copy the trees that were modified
+    and their parents, and can share everything else with the previous one.
+
+    Any thread can then call getLatest() to get the most recently published snapshot.
+    This is a constant-time operation that only holds a lock for as long as it takes
+    to copy a pointer, so a reader will never be blocked by the owner of the tree
+    for long, and old snapshots are deleted when the last thread using them lets go.
+
+    @code
+    // on the message thread:
+    ValueTreeSnapshotPublisher publisher (state);
+
+    // on a background thread:
+    auto snapshot = publisher.getLatest();
+    writeAutosave (snapshot.createValueTree());
+    @endcode
+
+    @see ValueTreeSnapshot
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshotPublisher  : private ValueTree::Listener,
+                                              private AsyncUpdater
+{
+public:
+    //==============================================================================
+    /** Creates a publisher for the given tree, and publishes an initial snapshot of it. */
+    explicit ValueTreeSnapshotPublisher (const ValueTree& treeToWatch);
+
+    /** Destructor. */
+    ~ValueTreeSnapshotPublisher() override;
+
+    //==============================================================================
+    /** Creates a snapshot of the tree's current state, and makes it the one that
+        getLatest() returns.
+
+        This must be called on the thread that owns the tree. If nothing has changed
+        since the last call, this will return the same snapshot again.
+    */
+    ValueTreeSnapshot publish();
+
+    /** Returns the most recently published snapshot. This can be called on any thread. */
+    ValueTreeSnapshot getLatest() const;
+
+    /** By default, a new snapshot is published on the next message loop callback after
+        the tree changes. If you turn this off, you'll need to call publish() yourself.
+    */
+    void setPublishesAutomatically (bool shouldPublishAutomatically);
+
+    /** Returns the tree that is being watched. */
+    const ValueTree& getTree() const noexcept                       { return tree; }
+
+private:
+    //==============================================================================
+    using NodePtr = ReferenceCountedObjectPtr<ValueTreeSnapshot::Node>;
+
+    ValueTree tree;
+    std::unordered_map<const ValueTree::SharedObject*, NodePtr> unchangedNodes;
+    ValueTreeSnapshot latest;
+    mutable SpinLock latestLock;
+    bool publishesAutomatically = true;
+
+    NodePtr getOrCreateNode (const ValueTree::SharedObject&);
+    void markAsChanged (const ValueTree&);
+    void forgetSubtree (const ValueTree::SharedObject&);
+
+    void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
+    void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeSnapshotPublisher)
+};
+
+} // namespace juce
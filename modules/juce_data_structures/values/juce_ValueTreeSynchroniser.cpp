@@ -35,7 +35,9 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        deltaPacket      = 7,
+        snapshot         = 8
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -90,6 +92,22 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    static MemoryBlock createDeltaPacket (int64 sequenceNumber, const Array<MemoryBlock>& changes)
+    {
+        MemoryOutputStream m;
+        writeHeader (m, deltaPacket);
+        m.writeInt64 (sequenceNumber);
+        m.writeCompressedInt (changes.size());
+
+        for (auto& change : changes)
+        {
+            m.writeCompressedInt ((int) change.getSize());
+            m << change;
+        }
+
+        return m.getMemoryBlock();
+    }
 }
 
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
@@ -104,29 +122,176 @@ ValueTreeSynchroniser::~ValueTreeSynchroniser()
 
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    // Any queued changes are sent first, so that the delta log stays complete
+    flushPendingChanges();
+
     MemoryOutputStream m;
     writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
     valueTree.writeToStream (m);
     stateChanged (m.getData(), m.getDataSize());
 }
 
-void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
+//==============================================================================
+void ValueTreeSynchroniser::enableBatching (int intervalMilliseconds)
+{
+    jassert (intervalMilliseconds >= 0);
+
+    flushPendingChanges();
+    batchIntervalMs = jmax (0, intervalMilliseconds);
+}
+
+void ValueTreeSynchroniser::disableBatching()
+{
+    flushPendingChanges();
+    batchIntervalMs = -1;
+}
+
+void ValueTreeSynchroniser::flushPendingChanges()
+{
+    batchTimer.stopTimer();
+    batchUpdater.cancelPendingUpdate();
+
+    if (pendingChanges.isEmpty())
+        return;
+
+    const auto packet = ValueTreeSynchroniserHelpers::createDeltaPacket (++sequenceNumber, pendingChanges);
+
+    pendingChanges.clear();
+    pendingPropertyChanges.clear();
+
+    addToDeltaLog (packet);
+    stateChanged (packet.getData(), packet.getSize());
+}
+
+void ValueTreeSynchroniser::sendUnbatchedChange (const MemoryOutputStream& m)
 {
+    // The change is sent on its own as it always has been, but it still needs a sequence
+    // number, and a place in the log, so that getChangesSince() can't leave it out
+    ++sequenceNumber;
+
+    if (maxDeltaLogSize > 0)
+        addToDeltaLog (ValueTreeSynchroniserHelpers::createDeltaPacket (sequenceNumber, { m.getMemoryBlock() }));
+
+    stateChanged (m.getData(), m.getDataSize());
+}
+
+void ValueTreeSynchroniser::addToDeltaLog (const MemoryBlock& packet)
+{
+    if (maxDeltaLogSize > 0)
+    {
+        deltaLog.add (packet);
+        trimDeltaLog();
+    }
+}
+
+void ValueTreeSynchroniser::setDeltaLogSize (int maxNumPackets)
+{
+    maxDeltaLogSize = jmax (0, maxNumPackets);
+    trimDeltaLog();
+}
+
+void ValueTreeSynchroniser::trimDeltaLog()
+{
+    if (deltaLog.size() > maxDeltaLogSize)
+        deltaLog.removeRange (0, deltaLog.size() - maxDeltaLogSize);
+}
+
+MemoryBlock ValueTreeSynchroniser::createSnapshot()
+{
+    flushPendingChanges();
+
     MemoryOutputStream m;
+    writeHeader (m, ValueTreeSynchroniserHelpers::snapshot);
+    m.writeInt64 (sequenceNumber);
+    ValueTreeArchive::write (valueTree, m);
+    return m.getMemoryBlock();
+}
+
+bool ValueTreeSynchroniser::getChangesSince (int64 lastSequenceNumber, Array<MemoryBlock>& packets) const
+{
+    if (lastSequenceNumber > sequenceNumber || lastSequenceNumber < sequenceNumber - deltaLog.size())
+        return false;
 
-    if (auto* value = vt.getPropertyPointer (property))
+    for (auto i = deltaLog.size() - (int) (sequenceNumber - lastSequenceNumber); i < deltaLog.size(); ++i)
+        packets.add (deltaLog.getReference (i));
+
+    return true;
+}
+
+int64 ValueTreeSynchroniser::getPacketSequenceNumber (const void* data, size_t dataSize)
+{
+    MemoryInputStream input (data, dataSize, false);
+
+    const auto type = (ValueTreeSynchroniserHelpers::ChangeType) input.readByte();
+
+    if ((type == ValueTreeSynchroniserHelpers::deltaPacket || type == ValueTreeSynchroniserHelpers::snapshot)
+         && input.getNumBytesRemaining() >= (int64) sizeof (int64))
+        return input.readInt64();
+
+    return -1;
+}
+
+void ValueTreeSynchroniser::sendChange (const MemoryOutputStream& m)
+{
+    if (! isBatching())
     {
-        ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::propertyChanged, vt);
-        m.writeString (property.toString());
+        sendUnbatchedChange (m);
+        return;
+    }
+
+    // A structural change can move or replace the trees that queued property changes
+    // refer to, so later writes to those properties mustn't be merged into them.
+    pendingPropertyChanges.clear();
+    queueChange (m);
+}
+
+void ValueTreeSynchroniser::queueChange (const MemoryOutputStream& m)
+{
+    if (pendingChanges.isEmpty())
+    {
+        if (batchIntervalMs > 0)
+            batchTimer.startTimer (batchIntervalMs);
+        else
+            batchUpdater.triggerAsyncUpdate();
+    }
+
+    pendingChanges.add (m.getMemoryBlock());
+}
+
+//==============================================================================
+void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
+{
+    auto* value = vt.getPropertyPointer (property);
+
+    MemoryOutputStream m;
+    ValueTreeSynchroniserHelpers::writeHeader (*this, m, value != nullptr ? ValueTreeSynchroniserHelpers::propertyChanged
+                                                                           : ValueTreeSynchroniserHelpers::propertyRemoved, vt);
+    m.writeString (property.toString());
+
+    if (value != nullptr)
         value->writeToStream (m);
+
+    if (! isBatching())
+    {
+        sendUnbatchedChange (m);
+        return;
     }
-    else
+
+    // Until a structural change clears this list, a queued change to the same property of
+    // the same tree can simply be overwritten.
+    auto& queuedChanges = pendingPropertyChanges[property];
+
+    for (auto& queued : queuedChanges)
     {
-        ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::propertyRemoved, vt);
-        m.writeString (property.toString());
+        if (queued.tree == vt)
+        {
+            pendingChanges.getReference (queued.index) = m.getMemoryBlock();
+            return;
+        }
     }
 
-    stateChanged (m.getData(), m.getDataSize());
+    queuedChanges.add ({ vt, pendingChanges.size() });
+    queueChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTree& childTree)
@@ -138,7 +303,7 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
     childTree.writeToStream (m);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
@@ -146,7 +311,7 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
@@ -155,7 +320,7 @@ void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int o
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
     m.writeCompressedInt (newIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size_t dataSize, UndoManager* undoManager)
@@ -170,6 +335,43 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
+    if (type == ValueTreeSynchroniserHelpers::snapshot)
+    {
+        input.readInt64();
+        const auto position = (size_t) input.getPosition();
+        auto tree = ValueTreeArchive::readFromData (addBytesToPointer (data, position), dataSize - position);
+
+        if (! tree.isValid())
+            return false;
+
+        root = tree;
+        return true;
+    }
+
+    if (type == ValueTreeSynchroniserHelpers::deltaPacket)
+    {
+        input.readInt64();
+        const int numChanges = input.readCompressedInt();
+
+        if (numChanges < 0)
+            return false;
+
+        bool ok = true;
+
+        for (int i = 0; i < numChanges; ++i)
+        {
+            const int size = input.readCompressedInt();
+
+            if (size <= 0 || size > input.getNumBytesRemaining())
+                return false;
+
+            ok = applyChange (root, addBytesToPointer (data, input.getPosition()), (size_t) size, undoManager) && ok;
+            input.skipNextBytes (size);
+        }
+
+        return ok;
+    }
+
     ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
 
     if (! v.isValid())
@@ -229,6 +431,8 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         }
 
         case ValueTreeSynchroniserHelpers::fullSync:
+        case ValueTreeSynchroniserHelpers::deltaPacket:
+        case ValueTreeSynchroniserHelpers::snapshot:
             break;
 
         default:
@@ -239,4 +443,237 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
     return false;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSynchroniserTests final : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests()
+        : UnitTest ("ValueTreeSynchroniser", UnitTestCategories::values)
+    {}
+
+    struct RecordingSynchroniser final : public ValueTreeSynchroniser
+    {
+        using ValueTreeSynchroniser::ValueTreeSynchroniser;
+
+        void stateChanged (const void* data, size_t size) override
+        {
+            packets.add (MemoryBlock (data, size));
+        }
+
+        Array<MemoryBlock> packets;
+    };
+
+    static bool applyAll (ValueTree& target, const Array<MemoryBlock>& packets)
+    {
+        bool ok = true;
+
+        for (auto& p : packets)
+            ok = ValueTreeSynchroniser::applyChange (target, p.getData(), p.getSize(), nullptr) && ok;
+
+        return ok;
+    }
+
+    static void getAllNodes (const ValueTree& v, Array<ValueTree>& nodes)
+    {
+        nodes.add (v);
+
+        for (const auto& child : v)
+            getAllNodes (child, nodes);
+    }
+
+    static void makeRandomEdits (ValueTree& root, int numEdits, Random& r)
+    {
+        for (int i = 0; i < numEdits; ++i)
+        {
+            Array<ValueTree> nodes;
+            getAllNodes (root, nodes);
+            auto v = nodes[r.nextInt (nodes.size())];
+            const Identifier property ("p" + String (r.nextInt (4)));
+
+            switch (r.nextInt (6))
+            {
+                case 0:
+                case 1:  v.setProperty (property, r.nextInt (100), nullptr); break;
+                case 2:  v.removeProperty (property, nullptr); break;
+                case 3:  if (nodes.size() < 100) v.addChild (ValueTreeTests::createRandomTree (nullptr, 4, r), r.nextInt (v.getNumChildren() + 1), nullptr); break;
+                case 4:  if (v.getNumChildren() > 0) v.removeChild (r.nextInt (v.getNumChildren()), nullptr); break;
+                case 5:  if (v.getNumChildren() > 1) v.moveChild (r.nextInt (v.getNumChildren()), r.nextInt (v.getNumChildren()), nullptr); break;
+                default: break;
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Unbatched changes");
+        {
+            ValueTree source ("ROOT");
+            RecordingSynchroniser sync (source);
+            ValueTree target;
+
+            sync.sendFullSyncCallback();
+            source.setProperty ("a", 1, nullptr);
+            source.appendChild (ValueTree ("CHILD"), nullptr);
+
+            expectEquals (sync.packets.size(), 3);
+            expectEquals (sync.getSequenceNumber(), (int64) 2);
+            expect (applyAll (target, sync.packets));
+            expect (target.isEquivalentTo (source));
+
+            for (auto& p : sync.packets)
+                expectEquals (ValueTreeSynchroniser::getPacketSequenceNumber (p.getData(), p.getSize()), (int64) -1);
+        }
+
+        beginTest ("Repeated writes are collapsed");
+        {
+            ValueTree source ("ROOT");
+            source.appendChild (ValueTree ("CHILD"), nullptr);
+            auto target = source.createCopy();
+
+            RecordingSynchroniser sync (source);
+            sync.enableBatching (100000);
+            expect (sync.isBatching());
+
+            for (int i = 0; i < 100; ++i)
+            {
+                source.setProperty ("gain", i, nullptr);
+                source.getChild (0).setProperty ("gain", -i, nullptr);
+            }
+
+            expect (sync.packets.isEmpty());
+            sync.flushPendingChanges();
+
+            expectEquals (sync.packets.size(), 1);
+            expectEquals (ValueTreeSynchroniser::getPacketSequenceNumber (sync.packets[0].getData(), sync.packets[0].getSize()), (int64) 1);
+            expect (sync.packets[0].getSize() < 64);
+
+            expect (applyAll (target, sync.packets));
+            expect (target.isEquivalentTo (source));
+
+            sync.flushPendingChanges();
+            expectEquals (sync.packets.size(), 1);
+
+            source.removeProperty ("gain", nullptr);
+            sync.disableBatching();
+            expectEquals (sync.packets.size(), 2);
+            expectEquals (sync.getSequenceNumber(), (int64) 2);
+
+            expect (applyAll (target, { sync.packets[1] }));
+            expect (target.isEquivalentTo (source));
+
+            source.setProperty ("gain", 1, nullptr);
+            expectEquals (sync.packets.size(), 3);
+            expectEquals (sync.getSequenceNumber(), (int64) 3);
+        }
+
+        beginTest ("Batched random edits");
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                auto source = ValueTreeTests::createRandomTree (nullptr, 0, r);
+                auto target = source.createCopy();
+
+                RecordingSynchroniser sync (source);
+                sync.enableBatching();
+
+                for (int batch = 0; batch < 10; ++batch)
+                {
+                    makeRandomEdits (source, 30, r);
+                    sync.flushPendingChanges();
+                }
+
+                expect (applyAll (target, sync.packets));
+                expect (target.isEquivalentTo (source));
+
+                for (int j = 0; j < sync.packets.size(); ++j)
+                    expectEquals (ValueTreeSynchroniser::getPacketSequenceNumber (sync.packets[j].getData(), sync.packets[j].getSize()), (int64) j + 1);
+            }
+        }
+
+        beginTest ("Snapshot and delta log");
+        {
+            auto source = ValueTreeTests::createRandomTree (nullptr, 0, r);
+            RecordingSynchroniser sync (source);
+            sync.enableBatching();
+            sync.setDeltaLogSize (4);
+
+            ValueTree peerAtThree;
+            Array<MemoryBlock> packets;
+            expect (sync.getChangesSince (0, packets));
+            expect (packets.isEmpty());
+
+            for (int batch = 0; batch < 6; ++batch)
+            {
+                makeRandomEdits (source, 20, r);
+
+                if (batch == 2)
+                {
+                    auto snapshot = sync.createSnapshot();
+                    expectEquals (ValueTreeSynchroniser::getPacketSequenceNumber (snapshot.getData(), snapshot.getSize()), (int64) 3);
+                    expect (ValueTreeSynchroniser::applyChange (peerAtThree, snapshot.getData(), snapshot.getSize(), nullptr));
+                    expect (peerAtThree.isEquivalentTo (source));
+                    continue;
+                }
+
+                sync.flushPendingChanges();
+            }
+
+            expectEquals (sync.getSequenceNumber(), (int64) 6);
+            expect (! sync.getChangesSince (1, packets));
+            expect (! sync.getChangesSince (7, packets));
+            expect (packets.isEmpty());
+
+            expect (sync.getChangesSince (3, packets));
+            expectEquals (packets.size(), 3);
+            expect (applyAll (peerAtThree, packets));
+            expect (peerAtThree.isEquivalentTo (source));
+
+            ValueTree lateJoiner;
+            auto snapshot = sync.createSnapshot();
+            expect (ValueTreeSynchroniser::applyChange (lateJoiner, snapshot.getData(), snapshot.getSize(), nullptr));
+            expect (lateJoiner.isEquivalentTo (source));
+
+            expect (! ValueTreeSynchroniser::applyChange (lateJoiner, snapshot.getData(), 12, nullptr));
+            expectEquals (ValueTreeSynchroniser::getPacketSequenceNumber (snapshot.getData(), 4), (int64) -1);
+        }
+
+        beginTest ("The delta log includes changes that weren't batched");
+        {
+            auto source = ValueTreeTests::createRandomTree (nullptr, 0, r);
+            RecordingSynchroniser sync (source);
+            sync.setDeltaLogSize (100);
+
+            auto peer = source.createCopy();
+            const auto peerSequenceNumber = sync.getSequenceNumber();
+
+            makeRandomEdits (source, 10, r);
+
+            sync.enableBatching();
+            makeRandomEdits (source, 10, r);
+            sync.disableBatching();
+
+            makeRandomEdits (source, 10, r);
+
+            Array<MemoryBlock> packets;
+            expect (sync.getChangesSince (peerSequenceNumber, packets));
+            expectEquals ((int64) packets.size(), sync.getSequenceNumber() - peerSequenceNumber);
+            expect (applyAll (peer, packets));
+            expect (peer.isEquivalentTo (source));
+
+            for (int i = 0; i < packets.size(); ++i)
+                expectEquals (ValueTreeSynchroniser::getPacketSequenceNumber (packets[i].getData(), packets[i].getSize()),
+                              peerSequenceNumber + i + 1);
+        }
+    }
+};
+
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+#endif
+
 } // namespace juce
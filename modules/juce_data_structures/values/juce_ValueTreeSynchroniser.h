@@ -40,6 +40,14 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    By default, every change is sent as soon as it happens. If the tree is edited
+    in bursts, call enableBatching() to have the changes accumulated and sent as a
+    single delta packet instead, with repeated writes to the same property collapsed
+    into one. Each packet carries a sequence number, and a log of recent packets can
+    be kept so that a peer that falls behind or joins late can catch up with
+    createSnapshot() and getChangesSince(). Changes that are sent while batching is
+    off are numbered and logged too, so the log is complete whichever mode is used.
+
     @tags{DataStructures}
 */
 class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
@@ -83,9 +91,106 @@ public:
     /** Returns the root ValueTree that is being observed. */
     const ValueTree& getRoot() noexcept       { return valueTree; }
 
+    //==============================================================================
+    /** Makes the synchroniser collect changes and send them as batched delta packets.
+
+        Once batching is enabled, changes are no longer passed to stateChanged() as they
+        happen. Instead they're queued, and repeated changes to the same property of the
+        same tree are collapsed so that only the latest value is sent. The queue is sent
+        as a single packet either on the next message loop callback (if the interval is
+        zero) or when the given number of milliseconds has passed since the first queued
+        change. You can also send it at any time by calling flushPendingChanges().
+
+        Each packet is given a sequence number one higher than the previous one, which
+        a receiver can read with getPacketSequenceNumber() to detect lost packets. A
+        change that's sent while batching is off also uses up a sequence number, even
+        though the message itself doesn't contain one, so if batching is switched on
+        and off, a gap between two packets can also mean that such changes were sent
+        in between.
+
+        Note that any changes that are still queued when the synchroniser is deleted
+        will not be sent.
+
+        @see disableBatching, flushPendingChanges
+    */
+    void enableBatching (int intervalMilliseconds = 0);
+
+    /** Sends any queued changes and goes back to sending each change as it happens. */
+    void disableBatching();
+
+    /** Returns true if enableBatching() has been called. */
+    bool isBatching() const noexcept                    { return batchIntervalMs >= 0; }
+
+    /** Sends any changes that have been queued by the batching mode as a single packet. */
+    void flushPendingChanges();
+
+    /** Returns the sequence number of the last delta packet or unbatched change that
+        was sent, or 0 if nothing has been sent yet.
+    */
+    int64 getSequenceNumber() const noexcept            { return sequenceNumber; }
+
+    /** Sets the number of recently-sent delta packets that will be kept for
+        getChangesSince(). The default is 0, which keeps none.
+
+        While the log is enabled, each change that's sent while batching is off is also
+        kept, as a delta packet that contains just that change.
+    */
+    void setDeltaLogSize (int maxNumPackets);
+
+    /** Sends any queued changes, and then returns a message that contains the entire
+        state of the tree along with the current sequence number.
+
+        This can be passed to applyChange() on a peer that has just joined, after which
+        that peer can apply any delta packets with a higher sequence number. Unlike
+        sendFullSyncCallback(), this doesn't invoke stateChanged(), so it can be sent to
+        a single peer without disturbing the others. The state is stored in the
+        ValueTreeArchive format, which is more compact than ValueTree::writeToStream().
+    */
+    MemoryBlock createSnapshot();
+
+    /** Retrieves the delta packets that were sent after the one with the given sequence
+        number.
+
+        If the delta log still contains all of these packets, they're added to the array
+        in the order in which they should be applied and this returns true. If some of
+        them have already been dropped from the log, this returns false, and the peer
+        will need to be resynchronised with createSnapshot() instead.
+
+        @see setDeltaLogSize
+    */
+    bool getChangesSince (int64 sequenceNumber, Array<MemoryBlock>& packets) const;
+
+    /** Returns the sequence number of an encoded delta packet or snapshot, or -1 if the
+        data is some other kind of change message.
+    */
+    static int64 getPacketSequenceNumber (const void* encodedChangeData, size_t encodedChangeDataSize);
+
 private:
     ValueTree valueTree;
 
+    // A property change that's waiting in pendingChanges, at the given index
+    struct PendingPropertyChange
+    {
+        ValueTree tree;
+        int index;
+    };
+
+    int batchIntervalMs = -1;
+    Array<MemoryBlock> pendingChanges;
+    std::map<Identifier, Array<PendingPropertyChange>> pendingPropertyChanges;
+    int64 sequenceNumber = 0;
+    Array<MemoryBlock> deltaLog;
+    int maxDeltaLogSize = 0;
+
+    TimedCallback batchTimer { [this] { flushPendingChanges(); } };
+    LockingAsyncUpdater batchUpdater { [this] { flushPendingChanges(); } };
+
+    void sendChange (const MemoryOutputStream&);
+    void sendUnbatchedChange (const MemoryOutputStream&);
+    void queueChange (const MemoryOutputStream&);
+    void addToDeltaLog (const MemoryBlock&);
+    void trimDeltaLog();
+
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
     void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
@@ -143,6 +143,140 @@ ConvolutionMessageQueue::~ConvolutionMessageQueue() noexcept
 ConvolutionMessageQueue::ConvolutionMessageQueue (ConvolutionMessageQueue&&) noexcept = default;
 ConvolutionMessageQueue& ConvolutionMessageQueue::operator= (ConvolutionMessageQueue&&) noexcept = default;
 
+//==============================================================================
+// The frequency-domain partitions of an IR. These never change once they've been created,
+// so engines that use the same IR samples and block size can share a single copy.
+struct ImpulseResponsePartitions
+{
+    // The memory that each engine would need if it made its own partitions
+    size_t getPartitionSizeInBytes() const noexcept
+    {
+        return std::accumulate (segments.begin(), segments.end(), (size_t) 0, [] (auto sum, const auto& segment)
+        {
+            return sum + (size_t) segment.getNumSamples() * sizeof (float);
+        });
+    }
+
+    // The memory used by this object, including the copy of the IR samples
+    size_t getSizeInBytes() const noexcept
+    {
+        return getPartitionSizeInBytes() + samples.size() * sizeof (float);
+    }
+
+    std::vector<AudioBuffer<float>> segments;
+
+    // The IR samples that the partitions were made from. Different IRs can have the same hash,
+    // so these are compared before the partitions are shared.
+    std::vector<float> samples;
+};
+
+class ImpulseResponsePartitionCache
+{
+public:
+    struct Key
+    {
+        Key (const float* samples, size_t numSamplesIn, size_t blockSizeIn)
+            : Key (hashSamples (samples, numSamplesIn), numSamplesIn, blockSizeIn) {}
+
+        Key (uint64 hashIn, size_t numSamplesIn, size_t blockSizeIn)
+            : hash (hashIn), numSamples (numSamplesIn), blockSize (blockSizeIn) {}
+
+        auto tie() const noexcept { return std::tie (hash, numSamples, blockSize); }
+        bool operator< (const Key& other) const noexcept { return tie() < other.tie(); }
+
+        uint64 hash;
+        size_t numSamples, blockSize;
+
+    private:
+        // FNV-1a
+        static uint64 hashSamples (const float* samples, size_t numSamples) noexcept
+        {
+            const auto* bytes = reinterpret_cast<const uint8*> (samples);
+            auto result = (uint64) 0xcbf29ce484222325;
+
+            for (size_t i = 0; i < numSamples * sizeof (float); ++i)
+                result = (result ^ bytes[i]) * (uint64) 0x100000001b3;
+
+            return result;
+        }
+    };
+
+    static ImpulseResponsePartitionCache& getInstance()
+    {
+        static ImpulseResponsePartitionCache cache;
+        return cache;
+    }
+
+    // Returns the partitions for these samples if an engine is already using them, or otherwise
+    // creates them by calling the function provided.
+    template <typename CreatePartitions>
+    std::shared_ptr<const ImpulseResponsePartitions> getOrCreate (const Key& key, const float* samples, CreatePartitions&& create)
+    {
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (auto existing = findExisting (key, samples))
+                return existing;
+        }
+
+        // Creating the partitions takes a while, so this is done without holding the lock, which
+        // would stop other engines from loading at the same time.
+        std::shared_ptr<ImpulseResponsePartitions> result = create();
+        result->samples.assign (samples, samples + key.numSamples);
+
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        // Another engine may have created the same partitions in the meantime
+        if (auto existing = findExisting (key, samples))
+            return existing;
+
+        cache.emplace (key, result);
+        return result;
+    }
+
+    // Returns the number of bytes that would be needed for every engine to keep its own copy of
+    // its partitions, minus the number of bytes that are actually in use. The copies of the IR
+    // samples that the cache keeps count against this, so it may be zero if nothing is shared.
+    size_t getMemorySaved() const
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        const auto saved = std::accumulate (cache.begin(), cache.end(), (int64) 0, [] (auto sum, const auto& item)
+        {
+            if (const auto partitions = item.second.lock())
+            {
+                // Ignore the reference that we've just taken
+                const auto numUsers = (int64) jmax (1L, partitions.use_count() - 1);
+                return sum + numUsers * (int64) partitions->getPartitionSizeInBytes() - (int64) partitions->getSizeInBytes();
+            }
+
+            return sum;
+        });
+
+        return (size_t) jmax ((int64) 0, saved);
+    }
+
+private:
+    // The mutex must be locked when calling this.
+    std::shared_ptr<const ImpulseResponsePartitions> findExisting (const Key& key, const float* samples)
+    {
+        for (auto it = cache.begin(); it != cache.end();)
+            it = it->second.expired() ? cache.erase (it) : std::next (it);
+
+        const auto range = cache.equal_range (key);
+
+        for (auto it = range.first; it != range.second; ++it)
+            if (auto existing = it->second.lock())
+                if (key.numSamples == 0 || std::memcmp (existing->samples.data(), samples, key.numSamples * sizeof (float)) == 0)
+                    return existing;
+
+        return nullptr;
+    }
+
+    std::multimap<Key, std::weak_ptr<const ImpulseResponsePartitions>> cache;
+    mutable std::mutex mutex;
+};
+
 //==============================================================================
 struct ConvolutionEngine
 {
@@ -176,29 +310,36 @@ struct ConvolutionEngine
         };
 
         updateSegmentsIfNecessary (numInputSegments, buffersInputSegments);
-        updateSegmentsIfNecessary (numSegments,      buffersImpulseSegments);
-
-        auto FFTTempObject = std::make_unique<FFT> (roundToInt (std::log2 (fftSize)));
-        size_t currentPtr = 0;
 
-        for (auto& buf : buffersImpulseSegments)
+        impulseSegments = ImpulseResponsePartitionCache::getInstance().getOrCreate ({ samples, numSamples, blockSize }, samples, [&]
         {
-            buf.clear();
+            auto result = std::make_shared<ImpulseResponsePartitions>();
+            updateSegmentsIfNecessary (numSegments, result->segments);
+
+            auto FFTTempObject = std::make_unique<FFT> (roundToInt (std::log2 (fftSize)));
+            size_t currentPtr = 0;
 
-            auto* impulseResponse = buf.getWritePointer (0);
+            for (auto& buf : result->segments)
+            {
+                buf.clear();
 
-            if (&buf == &buffersImpulseSegments.front())
-                impulseResponse[0] = 1.0f;
+                auto* impulseResponse = buf.getWritePointer (0);
 
-            FloatVectorOperations::copy (impulseResponse,
-                                         samples + currentPtr,
-                                         static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+                if (&buf == &result->segments.front())
+                    impulseResponse[0] = 1.0f;
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+                FloatVectorOperations::copy (impulseResponse,
+                                             samples + currentPtr,
+                                             static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
 
-            currentPtr += (fftSize - blockSize);
-        }
+                FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
+                prepareForConvolution (impulseResponse);
+
+                currentPtr += (fftSize - blockSize);
+            }
+
+            return result;
+        });
 
         reset();
     }
@@ -257,7 +398,7 @@ struct ConvolutionEngine
                         index -= numInputSegments;
 
                     convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
+                                                        impulseSegments->segments[i].getReadPointer (0),
                                                         outputTempData);
                 }
             }
@@ -265,7 +406,7 @@ struct ConvolutionEngine
             FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
             convolutionProcessingAndAccumulate (inputSegmentData,
-                                                buffersImpulseSegments.front().getWritePointer (0),
+                                                impulseSegments->segments.front().getReadPointer (0),
                                                 outputData);
 
             updateSymmetricFrequencyDomainData (outputData);
@@ -302,12 +443,8 @@ struct ConvolutionEngine
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
-        auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
-        auto* overlapData    = bufferOverlap.getWritePointer (0);
+        auto* inputData  = bufferInput.getWritePointer (0);
+        auto* outputData = bufferOutput.getWritePointer (0);
 
         while (numSamplesProcessed < numSamples)
         {
@@ -323,60 +460,84 @@ struct ConvolutionEngine
             // processing itself when needed (with latency)
             if (inputDataPos == blockSize)
             {
-                // Copy input data in input segment
-                auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
-                FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
+                processInputBlock();
+                inputDataPos = 0;
+            }
+        }
+    }
 
-                fftObject->performRealOnlyForwardTransform (inputSegmentData);
-                prepareForConvolution (inputSegmentData);
+    // Convolves a whole block of input, and writes the block of output which follows it.
+    // This adds one block of latency, in the same way as processSamplesWithAddedLatency().
+    void processBlockWithAddedLatency (const float* input, float* output)
+    {
+        jassert (inputDataPos == 0);
 
-                // Complex multiplication
-                FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
+        FloatVectorOperations::copy (bufferInput.getWritePointer (0), input, static_cast<int> (blockSize));
+        processInputBlock();
+        FloatVectorOperations::copy (output, bufferOutput.getReadPointer (0), static_cast<int> (blockSize));
+    }
 
-                auto index = currentSegment;
+    // Called once there's a complete block of samples in bufferInput. This leaves the next
+    // block of output at the start of bufferOutput.
+    void processInputBlock()
+    {
+        auto indexStep = numInputSegments / numSegments;
 
-                for (size_t i = 1; i < numSegments; ++i)
-                {
-                    index += indexStep;
+        auto* inputData      = bufferInput.getWritePointer (0);
+        auto* outputTempData = bufferTempOutput.getWritePointer (0);
+        auto* outputData     = bufferOutput.getWritePointer (0);
+        auto* overlapData    = bufferOverlap.getWritePointer (0);
 
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
+        // Copy input data in input segment
+        auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
+        FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
-                }
+        fftObject->performRealOnlyForwardTransform (inputSegmentData);
+        prepareForConvolution (inputSegmentData);
 
-                FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
+        // Complex multiplication
+        FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
 
-                convolutionProcessingAndAccumulate (inputSegmentData,
-                                                    buffersImpulseSegments.front().getWritePointer (0),
-                                                    outputData);
+        auto index = currentSegment;
 
-                updateSymmetricFrequencyDomainData (outputData);
-                fftObject->performRealOnlyInverseTransform (outputData);
+        for (size_t i = 1; i < numSegments; ++i)
+        {
+            index += indexStep;
 
-                // Add overlap
-                FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
+            if (index >= numInputSegments)
+                index -= numInputSegments;
 
-                // Input buffer is empty again now
-                FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
+            convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
+                                                impulseSegments->segments[i].getReadPointer (0),
+                                                outputTempData);
+        }
 
-                // Extra step for segSize > blockSize
-                FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+        FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
-                // Save the overlap
-                FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+        convolutionProcessingAndAccumulate (inputSegmentData,
+                                            impulseSegments->segments.front().getReadPointer (0),
+                                            outputData);
 
-                currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+        updateSymmetricFrequencyDomainData (outputData);
+        fftObject->performRealOnlyInverseTransform (outputData);
 
-                inputDataPos = 0;
-            }
-        }
+        // Add overlap
+        FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
+
+        // Input buffer is empty again now
+        FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
+
+        // Extra step for segSize > blockSize
+        FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+
+        // Save the overlap
+        FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+
+        currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
     }
 
     // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
-    void prepareForConvolution (float *samples) noexcept
+    void prepareForConvolution (float *samples) const noexcept
     {
         auto FFTSizeDiv2 = fftSize / 2;
 
@@ -434,9 +595,203 @@ struct ConvolutionEngine
     size_t currentSegment = 0, inputDataPos = 0;
 
     AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-    std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+    std::vector<AudioBuffer<float>> buffersInputSegments;
+    std::shared_ptr<const ImpulseResponsePartitions> impulseSegments;
 };
 
+//==============================================================================
+class BackgroundConvolutionStage;
+
+// Processes the blocks that the stages of every MultichannelEngine have gathered. There's
+// a single instance of this, shared through a SharedResourcePointer, so that running many
+// convolutions doesn't mean running as many realtime threads.
+//
+// This is kept apart from the BackgroundMessageQueue, which loads IRs at a normal priority,
+// because the audio thread may have to wait for a block that this thread has already started.
+// It runs at a realtime priority when the system allows it, so that it can't be held up by
+// threads that the audio thread would never wait for.
+class BackgroundConvolutionThread final : private Thread
+{
+public:
+    BackgroundConvolutionThread()
+        : Thread ("Convolution background stages")
+    {
+        if (! startRealtimeThread (RealtimeOptions{}))
+            startThread (Priority::highest);
+    }
+
+    ~BackgroundConvolutionThread() override
+    {
+        stopThread (-1);
+    }
+
+    // These mustn't be called on the audio thread, because they may have to wait for this
+    // thread to finish a block. A stage must be removed before it's deleted.
+    void addStage (BackgroundConvolutionStage&);
+    void removeStage (BackgroundConvolutionStage&);
+
+    // Called by the stages when they have a block ready.
+    using Thread::notify;
+
+private:
+    void run() override;
+
+    CriticalSection stagesLock;
+    std::vector<BackgroundConvolutionStage*> stages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundConvolutionThread)
+};
+
+//==============================================================================
+// Convolves the input with a later part of the IR, using larger partitions than the head.
+//
+// The output of a stage is delayed by two of its blocks. As soon as a block of input has
+// been gathered, it's handed to the BackgroundConvolutionThread, which has until the end of
+// the following block to convolve it. If that thread hasn't started on it by then, the audio
+// thread will do the work itself, so the result is always the same as if everything had been
+// processed on the audio thread. In that case the audio callback has to pay for a whole block
+// of this stage, i.e. a forward and an inverse FFT of twice the partition size plus a complex
+// multiply for each partition, which is why the largest partition size is limited by
+// Convolution::NonUniform::maxPartitionSizeInSamples.
+class BackgroundConvolutionStage final
+{
+public:
+    BackgroundConvolutionStage (const float* samples,
+                                size_t numSamples,
+                                size_t partitionSize,
+                                BackgroundConvolutionThread& threadToUse)
+        : engine (samples, numSamples, partitionSize),
+          thread (threadToUse),
+          buffers (4, static_cast<int> (engine.blockSize))
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        waitForPendingBlock();
+
+        buffers.clear();
+        engine.reset();
+
+        gathering     = buffers.getWritePointer (0);
+        pendingInput  = buffers.getWritePointer (1);
+        playing       = buffers.getWritePointer (2);
+        pendingOutput = buffers.getWritePointer (3);
+        position = 0;
+    }
+
+    // Adds the output of this stage to the output buffer.
+    void processSamples (const float* input, float* output, size_t numSamples)
+    {
+        const auto blockSize = engine.blockSize;
+
+        for (size_t numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
+        {
+            const auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - position);
+
+            FloatVectorOperations::copy (gathering + position, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
+            FloatVectorOperations::add (output + numSamplesProcessed, playing + position, static_cast<int> (numSamplesToProcess));
+
+            numSamplesProcessed += numSamplesToProcess;
+            position += numSamplesToProcess;
+
+            if (position == blockSize)
+            {
+                // The output of the previous block is due now
+                waitForPendingBlock();
+
+                std::swap (gathering, pendingInput);
+                std::swap (playing, pendingOutput);
+                position = 0;
+
+                state.store (State::queued, std::memory_order_release);
+                thread.notify();
+            }
+        }
+    }
+
+    // Convolves the block that's been gathered, unless another thread has already started on
+    // it. Returns false if there was nothing to do.
+    bool processPendingBlock()
+    {
+        auto expected = State::queued;
+
+        if (! state.compare_exchange_strong (expected, State::running, std::memory_order_acquire))
+            return false;
+
+        engine.processBlockWithAddedLatency (pendingInput, pendingOutput);
+        state.store (State::idle, std::memory_order_release);
+        return true;
+    }
+
+    size_t getBlockSize() const noexcept     { return engine.blockSize; }
+
+private:
+    enum class State { idle, queued, running };
+
+    void waitForPendingBlock()
+    {
+        processPendingBlock();
+
+        // The background thread has started this block, and it won't be held up by anything
+        // that runs at a lower priority, so it'll be finished soon
+        while (state.load (std::memory_order_acquire) != State::idle)
+            Thread::yield();
+    }
+
+    ConvolutionEngine engine;
+    BackgroundConvolutionThread& thread;
+    AudioBuffer<float> buffers;
+
+    float* gathering = nullptr;
+    float* pendingInput = nullptr;
+    float* playing = nullptr;
+    float* pendingOutput = nullptr;
+    size_t position = 0;
+
+    std::atomic<State> state { State::idle };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundConvolutionStage)
+};
+
+void BackgroundConvolutionThread::addStage (BackgroundConvolutionStage& stage)
+{
+    const ScopedLock sl (stagesLock);
+
+    // Stages with smaller blocks are due sooner, so they're kept at the front
+    const auto position = std::upper_bound (stages.begin(), stages.end(), &stage, [] (auto* a, auto* b)
+    {
+        return a->getBlockSize() < b->getBlockSize();
+    });
+
+    stages.insert (position, &stage);
+}
+
+void BackgroundConvolutionThread::removeStage (BackgroundConvolutionStage& stage)
+{
+    const ScopedLock sl (stagesLock);
+    stages.erase (std::remove (stages.begin(), stages.end(), &stage), stages.end());
+}
+
+void BackgroundConvolutionThread::run()
+{
+    while (! threadShouldExit())
+    {
+        auto processedAnything = false;
+
+        {
+            const ScopedLock sl (stagesLock);
+
+            for (auto* stage : stages)
+                processedAnything = stage->processPendingBlock() || processedAnything;
+        }
+
+        if (! processedAnything)
+            wait (-1);
+    }
+}
+
 //==============================================================================
 class MultichannelEngine
 {
@@ -461,7 +816,44 @@ public:
                                                         static_cast<size_t> (thisBlockSize));
         };
 
-        if (headSizeIn.headSizeInSamples == 0)
+        if (headSizeIn.maxPartitionSizeInSamples > 0)
+        {
+            // The stages rely on the head having no latency
+            jassert (isZeroDelay);
+
+            // Each stage starts two of its partitions into the IR, and covers two partitions, so
+            // the first partition of each stage is twice the size of the one before
+            auto partitionSize = jmax (headSizeIn.headSizeInSamples / 2, nextPowerOfTwo (maxBufferSize));
+            const auto maxPartitionSize = jmax (partitionSize, headSizeIn.maxPartitionSizeInSamples);
+            auto offset = jmin (irSize, 2 * partitionSize);
+
+            for (int i = 0; i < numChannels; ++i)
+                head.emplace_back (makeEngine (i, 0, offset, static_cast<uint32> (maxBufferSize)));
+
+            stages.resize (numChannels);
+            stageThread.emplace();
+
+            while (offset < irSize)
+            {
+                const auto nextPartitionSize = jmin (2 * partitionSize, maxPartitionSize);
+                const auto end = nextPartitionSize == partitionSize ? irSize
+                                                                    : jmin (irSize, 2 * nextPartitionSize);
+
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    const auto* samples = buf.getReadPointer (jmin (buf.getNumChannels() - 1, i), offset);
+                    stages[(size_t) i].push_back (std::make_unique<BackgroundConvolutionStage> (samples,
+                                                                                                (size_t) (end - offset),
+                                                                                                (size_t) partitionSize,
+                                                                                                stageThread->get()));
+                    stageThread->get().addStage (*stages[(size_t) i].back());
+                }
+
+                offset = end;
+                partitionSize = nextPartitionSize;
+            }
+        }
+        else if (headSizeIn.headSizeInSamples == 0)
         {
             for (int i = 0; i < numChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
@@ -481,6 +873,13 @@ public:
         }
     }
 
+    ~MultichannelEngine()
+    {
+        for (const auto& channelStages : stages)
+            for (const auto& stage : channelStages)
+                stageThread->get().removeStage (*stage);
+    }
+
     void reset()
     {
         for (const auto& e : head)
@@ -488,6 +887,10 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        for (const auto& channelStages : stages)
+            for (const auto& stage : channelStages)
+                stage->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -498,15 +901,25 @@ public:
         const AudioBlock<float> fullTailBlock (tailBuffer);
         const auto tailBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples);
 
-        const auto isUniform = tail.empty();
+        const auto isUniform = tail.empty() && stages.empty();
 
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
-            if (! isUniform)
+            if (! tail.empty())
                 tail[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
                                                                tailBlock.getChannelPointer (0),
                                                                numSamples);
 
+            if (! stages.empty())
+            {
+                tailBlock.clear();
+
+                for (const auto& stage : stages[channel])
+                    stage->processSamples (input.getChannelPointer (channel),
+                                           tailBlock.getChannelPointer (0),
+                                           numSamples);
+            }
+
             if (isZeroDelay)
                 head[channel]->processSamples (input.getChannelPointer (channel),
                                                output.getChannelPointer (channel),
@@ -532,6 +945,11 @@ public:
 
 private:
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
+
+    // Only engines with background stages keep the shared thread running
+    std::optional<SharedResourcePointer<BackgroundConvolutionThread>> stageThread;
+    std::vector<std::vector<std::unique_ptr<BackgroundConvolutionStage>>> stages;
+
     AudioBuffer<float> tailBuffer;
 
     const int latency;
@@ -731,7 +1149,8 @@ public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
                               Convolution::NonUniform requiredHeadSize)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
-          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
+          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)),
+                     (requiredHeadSize.maxPartitionSizeInSamples <= 0) ? 0 : nextPowerOfTwo (requiredHeadSize.maxPartitionSizeInSamples) },
           shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
     {}
 
@@ -994,6 +1413,8 @@ public:
         }
     }
 
+    bool isTransitioning() const noexcept   { return smoother.isSmoothing(); }
+
     void beginTransition()
     {
         smoother.setCurrentAndTargetValue (1.0f);
@@ -1047,6 +1468,10 @@ public:
     {
         engineQueue->postPendingCommand();
 
+        // An engine that's finished with may still be waiting for room in the queue
+        if (previousEngine != nullptr && ! mixer.isTransitioning())
+            destroyPreviousEngine();
+
         if (previousEngine == nullptr)
             installPendingEngine();
 
@@ -1101,9 +1526,16 @@ public:
 private:
     void destroyPreviousEngine()
     {
-        // If the queue is full, we'll destroy this straight away
-        BackgroundMessageQueue::IncomingCommand command = [p = std::move (previousEngine)]() mutable { p = nullptr; };
-        messageQueue->pimpl->push (command);
+        // Deleting an engine can wait for the background stages, so it mustn't happen on the
+        // audio thread. If the queue is full, the engine is kept until there's room for it.
+        if (previousEngine == nullptr)
+            return;
+
+        auto* engine = previousEngine.release();
+        BackgroundMessageQueue::IncomingCommand command = [engine] { delete engine; };
+
+        if (! messageQueue->pimpl->push (command))
+            previousEngine.reset (engine);
     }
 
     void installNewEngine (std::unique_ptr<MultichannelEngine> newEngine)
@@ -1291,4 +1723,9 @@ int Convolution::getCurrentIRSize() const { return pimpl->getCurrentIRSize(); }
 
 int Convolution::getLatency() const { return pimpl->getLatency(); }
 
+size_t Convolution::getMemorySavedBySharingImpulseResponses()
+{
+    return ImpulseResponsePartitionCache::getInstance().getMemorySaved();
+}
+
 } // namespace juce::dsp
@@ -128,18 +128,49 @@ public:
     */
     explicit Convolution (const Latency& requiredLatency);
 
-    /** Contains configuration information for a non-uniform convolution. */
-    struct NonUniform { int headSizeInSamples; };
+    /** Contains configuration information for a non-uniform convolution.
+
+        By default, the IR is split into a head and a tail, which are each
+        convolved with uniform partitions.
+
+        If maxPartitionSizeInSamples is greater than zero, the IR after the
+        head is instead split into a series of stages, where the partitions of
+        each stage are twice the size of the ones before, up to
+        maxPartitionSizeInSamples. The stages are processed on a background
+        thread which runs at a realtime priority where the system allows it,
+        and this keeps the cost of each audio callback low for very long IRs.
+        All the convolutions in a process share a single background thread.
+
+        If the background thread hasn't started on a block by the time its
+        output is due, the audio thread will do the work itself, so the output
+        is always the same. When that happens, a single callback may have to
+        convolve a whole block of the largest stage, so maxPartitionSizeInSamples
+        also limits the worst-case cost of a callback.
+    */
+    struct NonUniform
+    {
+        int headSizeInSamples;
+        int maxPartitionSizeInSamples = 0;
+    };
 
     /** Initialises an object for performing convolution in the frequency domain
         using a non-uniform partitioned algorithm.
 
         A requiredHeadSize of 256 samples or greater will improve the
         efficiency of the processing for IR sizes of 4096 samples or greater
-        (recommended for reverberation IRs).
-
-        @param requiredHeadSize       the head IR size for two stage non-uniform
-                                      partitioned convolution
+        (recommended for reverberation IRs). For IRs that are several seconds
+        long, setting a maxPartitionSizeInSamples of 8192 samples or more is
+        recommended too.
+
+        @param requiredHeadSize       headSizeInSamples is the number of samples
+                                      at the start of the IR that are convolved
+                                      with partitions the size of the processing
+                                      block, rounded up to a power of two of at
+                                      least 64. maxPartitionSizeInSamples is the
+                                      largest partition size in samples used for
+                                      the rest of the IR, rounded up to a power
+                                      of two, or 0 to convolve the rest of the
+                                      IR with partitions of the head size.
      */
     explicit Convolution (const NonUniform& requiredHeadSize);
 
@@ -263,6 +294,20 @@ public:
     */
     int getLatency() const;
 
+    /** Returns the number of bytes of memory that are currently being saved by sharing
+        impulse responses between convolution engines.
+
+        Once an impulse response has been loaded and prepared, its frequency-domain
+        representation never changes. Any engines that end up with identical impulse
+        response data and block sizes (for example, several Convolution instances
+        loading the same file at the same sample rate, or a mono impulse response used
+        on both channels) will share a single copy of this data instead of each holding
+        their own. The value returned is the amount of memory that would have been
+        needed for those extra copies, less the memory used to keep a copy of each
+        impulse response so that identical ones can be recognised.
+    */
+    static size_t getMemorySavedBySharingImpulseResponses();
+
 private:
     //==============================================================================
     Convolution (const Latency&,
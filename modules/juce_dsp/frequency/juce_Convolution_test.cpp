@@ -546,6 +546,192 @@ public:
             }
         }
 
+        beginTest ("Non-uniform convolutions with background stages work");
+        {
+            const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 40);
+
+            for (const auto& config : { Convolution::NonUniform { 0, 2048 },
+                                        Convolution::NonUniform { 1024, 4096 },
+                                        Convolution::NonUniform { 2048, 1024 } })
+            {
+                testConvolution (spec,
+                                 config,
+                                 ramp,
+                                 spec.sampleRate,
+                                 Convolution::Stereo::yes,
+                                 Convolution::Trim::yes,
+                                 Convolution::Normalise::no,
+                                 ramp);
+            }
+        }
+
+        beginTest ("Non-uniform convolutions with background stages match uniform convolutions");
+        {
+            const ProcessSpec smallBlockSpec { 44100.0, 64, 2 };
+            auto random = getRandom();
+
+            AudioBuffer<float> ir (2, 2 * (int) smallBlockSpec.sampleRate);
+
+            for (auto channel = 0; channel != ir.getNumChannels(); ++channel)
+                for (auto sample = 0; sample != ir.getNumSamples(); ++sample)
+                    ir.setSample (channel, sample, (random.nextFloat() * 2.0f - 1.0f) * std::exp ((float) -sample / 20000.0f));
+
+            Convolution uniform (Convolution::Latency { 0 });
+            Convolution staged (Convolution::NonUniform { 256, 16384 });
+
+            for (auto* convolution : { &uniform, &staged })
+            {
+                auto copiedIr = ir;
+                convolution->loadImpulseResponse (std::move (copiedIr),
+                                                  smallBlockSpec.sampleRate,
+                                                  Convolution::Stereo::yes,
+                                                  Convolution::Trim::no,
+                                                  Convolution::Normalise::yes);
+                convolution->prepare (smallBlockSpec);
+            }
+
+            expectEquals (staged.getCurrentIRSize(), uniform.getCurrentIRSize());
+            expectEquals (staged.getLatency(), 0);
+
+            AudioBuffer<float> uniformBuffer (2, (int) smallBlockSpec.maximumBlockSize), stagedBuffer (uniformBuffer);
+            auto maxError = 0.0f;
+
+            const auto process = [] (Convolution& convolution, AudioBuffer<float>& bufferToProcess, int numSamples)
+            {
+                auto subBlock = AudioBlock<float> (bufferToProcess).getSubBlock (0, (size_t) numSamples);
+                convolution.process (ProcessContextReplacing<float> (subBlock));
+            };
+
+            for (auto processed = 0; processed < 3 * ir.getNumSamples();)
+            {
+                // Hosts don't always use the maximum block size
+                const auto numSamples = random.nextInt ({ 1, (int) smallBlockSpec.maximumBlockSize + 1 });
+
+                for (auto channel = 0; channel != uniformBuffer.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample != numSamples; ++sample)
+                        uniformBuffer.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+                stagedBuffer.makeCopyOf (uniformBuffer, true);
+
+                process (uniform, uniformBuffer, numSamples);
+                process (staged,  stagedBuffer,  numSamples);
+
+                for (auto channel = 0; channel != uniformBuffer.getNumChannels(); ++channel)
+                    for (auto sample = 0; sample != numSamples; ++sample)
+                        maxError = jmax (maxError, std::abs (uniformBuffer.getSample (channel, sample) - stagedBuffer.getSample (channel, sample)));
+
+                processed += numSamples;
+            }
+
+            expectLessThan (maxError, 1.0e-4f);
+        }
+
+        beginTest ("Only convolutions with background stages keep the shared thread alive");
+        {
+            using SharedThread = SharedResourcePointer<BackgroundConvolutionThread>;
+            const auto ramp = makeStereoRamp (static_cast<int> (spec.maximumBlockSize) * 40);
+
+            {
+                std::vector<std::unique_ptr<Convolution>> convolutions;
+
+                for (auto i = 0; i != 3; ++i)
+                {
+                    auto& convolution = convolutions.emplace_back (std::make_unique<Convolution> (Convolution::NonUniform { 0, 2048 }));
+                    auto copiedIr = ramp;
+                    convolution->loadImpulseResponse (std::move (copiedIr),
+                                                      spec.sampleRate,
+                                                      Convolution::Stereo::yes,
+                                                      Convolution::Trim::no,
+                                                      Convolution::Normalise::yes);
+                    convolution->prepare (spec);
+                }
+
+                expect (SharedThread::getSharedObjectWithoutCreating().has_value());
+            }
+
+            // the thread only exists while there are engines with background stages
+            expect (! SharedThread::getSharedObjectWithoutCreating().has_value());
+
+            Convolution uniform;
+            auto copiedIr = ramp;
+            uniform.loadImpulseResponse (std::move (copiedIr),
+                                         spec.sampleRate,
+                                         Convolution::Stereo::yes,
+                                         Convolution::Trim::no,
+                                         Convolution::Normalise::yes);
+            uniform.prepare (spec);
+            expect (! SharedThread::getSharedObjectWithoutCreating().has_value());
+        }
+
+        beginTest ("Convolutions using the same IR share their prepared partitions");
+        {
+            const auto baseline = Convolution::getMemorySavedBySharingImpulseResponses();
+            const auto ramp = makeStereoRamp (2048);
+            auto random = getRandom();
+
+            AudioBuffer<float> input (2, (int) spec.maximumBlockSize);
+
+            for (auto channel = 0; channel != input.getNumChannels(); ++channel)
+                for (auto sample = 0; sample != input.getNumSamples(); ++sample)
+                    input.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+            {
+                std::vector<std::unique_ptr<Convolution>> convolutions;
+                std::vector<size_t> savings;
+
+                for (auto i = 0; i != 4; ++i)
+                {
+                    auto convolution = std::make_unique<Convolution>();
+                    auto copiedIr = ramp;
+                    convolution->loadImpulseResponse (std::move (copiedIr),
+                                                      spec.sampleRate,
+                                                      Convolution::Stereo::yes,
+                                                      Convolution::Trim::no,
+                                                      Convolution::Normalise::yes);
+                    convolution->prepare (spec);
+                    convolutions.push_back (std::move (convolution));
+                    savings.push_back (Convolution::getMemorySavedBySharingImpulseResponses());
+                }
+
+                for (size_t i = 1; i != savings.size(); ++i)
+                    expectGreaterThan (savings[i], savings[i - 1]);
+
+                std::vector<AudioBuffer<float>> outputs;
+
+                for (auto& convolution : convolutions)
+                {
+                    auto& output = outputs.emplace_back (input);
+                    AudioBlock<float> outputBlock (output);
+                    convolution->process (ProcessContextReplacing<float> (outputBlock));
+                }
+
+                for (const auto& output : outputs)
+                    for (auto channel = 0; channel != output.getNumChannels(); ++channel)
+                        for (auto sample = 0; sample != output.getNumSamples(); ++sample)
+                            expectEquals (output.getSample (channel, sample), outputs.front().getSample (channel, sample));
+            }
+
+            expectEquals (Convolution::getMemorySavedBySharingImpulseResponses(), baseline);
+        }
+
+        beginTest ("Prepared partitions are only shared by IRs with the same samples");
+        {
+            auto& cache = ImpulseResponsePartitionCache::getInstance();
+            const std::vector<float> a { 1.0f, 0.5f, 0.25f }, b { 1.0f, 0.5f, 0.125f };
+
+            // Pretend that the hashes of these IRs collide
+            const ImpulseResponsePartitionCache::Key key { (uint64) 1234, a.size(), 64 };
+            const auto create = [] { return std::make_shared<ImpulseResponsePartitions>(); };
+
+            const auto first = cache.getOrCreate (key, a.data(), create);
+            expect (cache.getOrCreate (key, a.data(), create) == first);
+            expectEquals (first->getSizeInBytes(), a.size() * sizeof (float));
+
+            const auto second = cache.getOrCreate (key, b.data(), create);
+            expect (second != first);
+            expect (cache.getOrCreate (key, b.data(), create) == second);
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
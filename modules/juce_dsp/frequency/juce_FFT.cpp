@@ -429,6 +429,284 @@ struct FFTFallback final : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+#if JUCE_USE_SIMD
+/*  A radix-4 Stockham FFT, which is used when none of the platform's FFT libraries are
+    available.
+
+    The data is held with the real and imaginary parts in separate arrays, so that each pass
+    can process several butterflies at once using SIMDRegister. Real-only transforms are
+    done with a complex FFT of half the size, followed by a pass which splits the result
+    into the spectrum of the real signal.
+*/
+class StockhamFFT final : public FFT::Instance
+{
+public:
+    // faster than the fallback, but slower than any of the library engines
+    static constexpr int priority = 0;
+
+    static StockhamFFT* create (int order)
+    {
+        // The real-only transforms need a complex FFT of at least four points
+        if (order < 3)
+            return nullptr;
+
+        return new StockhamFFT (order);
+    }
+
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < size; ++i)
+        {
+            bufferA.re[i] = input[i].real();
+            bufferA.im[i] = input[i].imag();
+        }
+
+        const auto result = inverse ? performComplex<true>  (bufferA, bufferB, size)
+                                    : performComplex<false> (bufferA, bufferB, size);
+
+        const auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+        for (int i = 0; i < size; ++i)
+            output[i] = { result.re[i] * scale, result.im[i] * scale };
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        const auto half = size / 2;
+
+        // Treat the even samples as real parts and the odd samples as imaginary parts
+        for (int i = 0; i < half; ++i)
+        {
+            bufferA.re[i] = d[2 * i];
+            bufferA.im[i] = d[2 * i + 1];
+        }
+
+        const auto z = performComplex<false> (bufferA, bufferB, half);
+        auto* out = reinterpret_cast<Complex<float>*> (d);
+
+        out[0]    = { z.re[0] + z.im[0], 0.0f };
+        out[half] = { z.re[0] - z.im[0], 0.0f };
+
+        for (int k = 1; k < half; ++k)
+        {
+            const auto j = half - k;
+
+            // The even and odd halves of the spectrum, scaled by two
+            const auto er = z.re[k] + z.re[j], ei = z.im[k] - z.im[j];
+            const auto or_ = z.im[k] + z.im[j], oi = z.re[j] - z.re[k];
+
+            const auto wr = twiddles.re[k], wi = twiddles.im[k];
+
+            out[k] = { 0.5f * (er + or_ * wr - oi * wi),
+                       0.5f * (ei + or_ * wi + oi * wr) };
+        }
+
+        if (! ignoreNegativeFreqs)
+            for (int k = 1; k < half; ++k)
+                out[size - k] = std::conj (out[k]);
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        const auto half = size / 2;
+        const auto* in = reinterpret_cast<const Complex<float>*> (d);
+
+        for (int k = 0; k < half; ++k)
+        {
+            const auto j = half - k;
+
+            // The even and odd halves of the spectrum, scaled by two
+            const auto er = in[k].real() + in[j].real(), ei = in[k].imag() - in[j].imag();
+            const auto dr = in[k].real() - in[j].real(), di = in[k].imag() + in[j].imag();
+
+            const auto wr = twiddles.re[k], wi = -twiddles.im[k];
+            const auto or_ = dr * wr - di * wi, oi = dr * wi + di * wr;
+
+            bufferA.re[k] = er - oi;
+            bufferA.im[k] = ei + or_;
+        }
+
+        const auto z = performComplex<true> (bufferA, bufferB, half);
+
+        // Each pass of the spectrum above was scaled by two, so this also undoes that
+        const auto scale = 1.0f / (float) size;
+
+        for (int i = 0; i < half; ++i)
+        {
+            d[2 * i]     = z.re[i] * scale;
+            d[2 * i + 1] = z.im[i] * scale;
+        }
+    }
+
+private:
+    //==============================================================================
+    struct SplitComplex
+    {
+        float* re;
+        float* im;
+    };
+
+    /*  Lets the passes use the same code for the butterflies that can't be vectorised. */
+    struct ScalarRegister
+    {
+        static constexpr size_t size() noexcept                          { return 1; }
+        static ScalarRegister expand (float v) noexcept                  { return { v }; }
+        static ScalarRegister fromRawArray (const float* p) noexcept     { return { *p }; }
+        void copyToRawArray (float* p) const noexcept                    { *p = value; }
+
+        ScalarRegister operator+ (ScalarRegister other) const noexcept   { return { value + other.value }; }
+        ScalarRegister operator- (ScalarRegister other) const noexcept   { return { value - other.value }; }
+        ScalarRegister operator* (ScalarRegister other) const noexcept   { return { value * other.value }; }
+
+        float value;
+    };
+
+    explicit StockhamFFT (int order)
+        : size (1 << order),
+          storage ((size_t) (6 * size) + SIMDRegister<float>::size())
+    {
+        auto* data = SIMDRegister<float>::getNextSIMDAlignedPtr (storage.get());
+
+        for (auto* buffer : { &bufferA, &bufferB, &twiddles })
+        {
+            buffer->re = data;
+            buffer->im = data + size;
+            data += 2 * size;
+        }
+
+        for (int i = 0; i < size; ++i)
+        {
+            const auto phase = -MathConstants<double>::twoPi * i / size;
+            twiddles.re[i] = (float) std::cos (phase);
+            twiddles.im[i] = (float) std::sin (phase);
+        }
+    }
+
+    /*  Transforms the first n points in x, using y as a workspace, and returns whichever of
+        the two buffers holds the result.
+    */
+    template <bool inverse>
+    SplitComplex performComplex (SplitComplex x, SplitComplex y, int n) const noexcept
+    {
+        using Vector = SIMDRegister<float>;
+        constexpr auto vectorSize = (int) Vector::size();
+
+        int stride = 1;
+
+        for (auto length = n; length >= 4; length /= 4)
+        {
+            if (stride >= vectorSize)
+                radix4Pass<inverse, Vector> (x, y, length, stride);
+            else
+                radix4Pass<inverse, ScalarRegister> (x, y, length, stride);
+
+            std::swap (x, y);
+            stride *= 4;
+        }
+
+        if (stride < n)
+        {
+            if (stride >= vectorSize)
+                radix2Pass<Vector> (x, y, stride);
+            else
+                radix2Pass<ScalarRegister> (x, y, stride);
+
+            std::swap (x, y);
+        }
+
+        return x;
+    }
+
+    /*  One decimation-in-frequency pass over sub-transforms of the given length. The
+        butterflies of the sub-transforms that are interleaved with the given stride all use
+        the same twiddle factors, so they're processed side by side.
+    */
+    template <bool inverse, typename Vector>
+    void radix4Pass (SplitComplex x, SplitComplex y, int length, int stride) const noexcept
+    {
+        const auto quarter = length / 4;
+        const auto twiddleStep = size / length;
+        const auto sign = inverse ? -1.0f : 1.0f;
+        const auto step = (int) Vector::size();
+
+        for (int p = 0; p < quarter; ++p)
+        {
+            const auto w1r = Vector::expand (twiddles.re[p * twiddleStep]),     w1i = Vector::expand (sign * twiddles.im[p * twiddleStep]);
+            const auto w2r = Vector::expand (twiddles.re[2 * p * twiddleStep]), w2i = Vector::expand (sign * twiddles.im[2 * p * twiddleStep]);
+            const auto w3r = Vector::expand (twiddles.re[3 * p * twiddleStep]), w3i = Vector::expand (sign * twiddles.im[3 * p * twiddleStep]);
+
+            const auto in  = stride * p, inStep = stride * quarter;
+            const auto out = stride * 4 * p;
+
+            for (int q = 0; q < stride; q += step)
+            {
+                const auto ar = Vector::fromRawArray (x.re + in + q),              ai = Vector::fromRawArray (x.im + in + q);
+                const auto br = Vector::fromRawArray (x.re + in + inStep + q),     bi = Vector::fromRawArray (x.im + in + inStep + q);
+                const auto cr = Vector::fromRawArray (x.re + in + 2 * inStep + q), ci = Vector::fromRawArray (x.im + in + 2 * inStep + q);
+                const auto dr = Vector::fromRawArray (x.re + in + 3 * inStep + q), di = Vector::fromRawArray (x.im + in + 3 * inStep + q);
+
+                const auto sumACr  = ar + cr, sumACi  = ai + ci;
+                const auto diffACr = ar - cr, diffACi = ai - ci;
+                const auto sumBDr  = br + dr, sumBDi  = bi + di;
+                const auto diffBDr = br - dr, diffBDi = bi - di;
+
+                // (b - d) rotated by a quarter turn, in the direction of the transform
+                const auto rotr = inverse ? Vector::expand (0.0f) - diffBDi : diffBDi;
+                const auto roti = inverse ? diffBDr : Vector::expand (0.0f) - diffBDr;
+
+                const auto y1r = diffACr + rotr, y1i = diffACi + roti;
+                const auto y2r = sumACr - sumBDr, y2i = sumACi - sumBDi;
+                const auto y3r = diffACr - rotr, y3i = diffACi - roti;
+
+                (sumACr + sumBDr).copyToRawArray (y.re + out + q);
+                (sumACi + sumBDi).copyToRawArray (y.im + out + q);
+
+                (y1r * w1r - y1i * w1i).copyToRawArray (y.re + out + stride + q);
+                (y1r * w1i + y1i * w1r).copyToRawArray (y.im + out + stride + q);
+
+                (y2r * w2r - y2i * w2i).copyToRawArray (y.re + out + 2 * stride + q);
+                (y2r * w2i + y2i * w2r).copyToRawArray (y.im + out + 2 * stride + q);
+
+                (y3r * w3r - y3i * w3i).copyToRawArray (y.re + out + 3 * stride + q);
+                (y3r * w3i + y3i * w3r).copyToRawArray (y.im + out + 3 * stride + q);
+            }
+        }
+    }
+
+    /*  The final pass when the size isn't a power of four, which has no twiddle factors. */
+    template <typename Vector>
+    static void radix2Pass (SplitComplex x, SplitComplex y, int stride) noexcept
+    {
+        for (int q = 0; q < stride; q += (int) Vector::size())
+        {
+            const auto ar = Vector::fromRawArray (x.re + q),          ai = Vector::fromRawArray (x.im + q);
+            const auto br = Vector::fromRawArray (x.re + stride + q), bi = Vector::fromRawArray (x.im + stride + q);
+
+            (ar + br).copyToRawArray (y.re + q);
+            (ai + bi).copyToRawArray (y.im + q);
+            (ar - br).copyToRawArray (y.re + stride + q);
+            (ai - bi).copyToRawArray (y.im + stride + q);
+        }
+    }
+
+    //==============================================================================
+    const int size;
+    HeapBlock<float> storage;
+    SplitComplex bufferA, bufferB, twiddles;
+    SpinLock processLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StockhamFFT)
+};
+
+FFT::EngineImpl<StockhamFFT> stockhamFFT;
+#endif
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
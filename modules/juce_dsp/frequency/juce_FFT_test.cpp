@@ -194,6 +194,62 @@ struct FFTUnitTest final : public UnitTest
         }
     };
 
+   #if JUCE_USE_SIMD
+    struct StockhamTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 3; order <= 13; ++order)
+            {
+                const auto n = (size_t) 1 << order;
+
+                std::unique_ptr<FFT::Instance> fallback (FFTFallback::create (order));
+                std::unique_ptr<FFT::Instance> stockham (StockhamFFT::create (order));
+
+                HeapBlock<Complex<float>> input (n), expected (n), actual (n);
+
+                // The errors of both engines grow with the size of the transform
+                const auto tolerance = 1.0e-5f * (float) n;
+
+                const auto isSimilar = [tolerance] (const auto* a, const auto* b, size_t num)
+                {
+                    for (size_t i = 0; i < num; ++i)
+                        if (std::abs (a[i] - b[i]) > tolerance)
+                            return false;
+
+                    return true;
+                };
+
+                for (auto inverse : { false, true })
+                {
+                    fillRandom (random, input.getData(), n);
+                    fallback->perform (input.getData(), expected.getData(), inverse);
+                    stockham->perform (input.getData(), actual.getData(), inverse);
+                    u.expect (isSimilar (expected.getData(), actual.getData(), n));
+                }
+
+                for (auto ignoreNegative : { false, true })
+                {
+                    zeromem (expected.getData(), n * sizeof (Complex<float>));
+                    fillRandom (random, reinterpret_cast<float*> (expected.getData()), n);
+                    memcpy (actual.getData(), expected.getData(), n * sizeof (Complex<float>));
+
+                    fallback->performRealOnlyForwardTransform (reinterpret_cast<float*> (expected.getData()), ignoreNegative);
+                    stockham->performRealOnlyForwardTransform (reinterpret_cast<float*> (actual.getData()), ignoreNegative);
+                    u.expect (isSimilar (expected.getData(), actual.getData(), ignoreNegative ? n / 2 + 1 : n));
+                }
+
+                memcpy (input.getData(), actual.getData(), n * sizeof (Complex<float>));
+                stockham->performRealOnlyInverseTransform (reinterpret_cast<float*> (actual.getData()));
+                fallback->performRealOnlyInverseTransform (reinterpret_cast<float*> (input.getData()));
+                u.expect (isSimilar (reinterpret_cast<float*> (input.getData()), reinterpret_cast<float*> (actual.getData()), n));
+            }
+        }
+    };
+   #endif
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -207,6 +263,10 @@ struct FFTUnitTest final : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+
+       #if JUCE_USE_SIMD
+        runTestForAllTypes<StockhamTest> ("Stockham engine matches the fallback engine");
+       #endif
     }
 };
 
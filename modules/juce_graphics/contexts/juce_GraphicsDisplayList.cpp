@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class GraphicsDisplayList::Recorder final  : public LowLevelGraphicsContext
+{
+public:
+    Recorder (std::vector<Command>& commandsToRecordInto, Rectangle<int> area, float scale)
+        : commands (commandsToRecordInto),
+          // This only keeps track of the clip region and transform, so it doesn't need an image
+          state (Image(), {}, (area.toFloat() * scale).getSmallestIntegerContainer())
+    {
+        state.addTransform (AffineTransform::scale (scale));
+    }
+
+    bool isVectorDevice() const override                    { return false; }
+
+    void setOrigin (Point<int> o) override
+    {
+        state.setOrigin (o);
+        record ([o] (LowLevelGraphicsContext& g) { g.setOrigin (o); });
+    }
+
+    void addTransform (const AffineTransform& t) override
+    {
+        state.addTransform (t);
+        record ([t] (LowLevelGraphicsContext& g) { g.addTransform (t); });
+    }
+
+    float getPhysicalPixelScaleFactor() override            { return state.getPhysicalPixelScaleFactor(); }
+
+    bool clipToRectangle (const Rectangle<int>& r) override
+    {
+        record ([r] (LowLevelGraphicsContext& g) { g.clipToRectangle (r); });
+        return state.clipToRectangle (r);
+    }
+
+    bool clipToRectangleList (const RectangleList<int>& list) override
+    {
+        record ([list] (LowLevelGraphicsContext& g) { g.clipToRectangleList (list); });
+        return state.clipToRectangleList (list);
+    }
+
+    void excludeClipRectangle (const Rectangle<int>& r) override
+    {
+        state.excludeClipRectangle (r);
+        record ([r] (LowLevelGraphicsContext& g) { g.excludeClipRectangle (r); });
+    }
+
+    void clipToPath (const Path& path, const AffineTransform& t) override
+    {
+        state.clipToPath (path, t);
+        record ([path, t] (LowLevelGraphicsContext& g) { g.clipToPath (path, t); });
+    }
+
+    void clipToImageAlpha (const Image& im, const AffineTransform& t) override
+    {
+        state.clipToImageAlpha (im, t);
+        record ([im = im.createCopy(), t] (LowLevelGraphicsContext& g) { g.clipToImageAlpha (im, t); });
+    }
+
+    bool clipRegionIntersects (const Rectangle<int>& r) override    { return state.clipRegionIntersects (r); }
+    Rectangle<int> getClipBounds() const override                   { return state.getClipBounds(); }
+    bool isClipEmpty() const override                               { return state.isClipEmpty(); }
+
+    void saveState() override
+    {
+        state.saveState();
+        record ([] (LowLevelGraphicsContext& g) { g.saveState(); });
+    }
+
+    void restoreState() override
+    {
+        state.restoreState();
+        record ([] (LowLevelGraphicsContext& g) { g.restoreState(); });
+    }
+
+    void beginTransparencyLayer (float opacity) override
+    {
+        state.saveState();
+        record ([opacity] (LowLevelGraphicsContext& g) { g.beginTransparencyLayer (opacity); });
+    }
+
+    void endTransparencyLayer() override
+    {
+        state.restoreState();
+        record ([] (LowLevelGraphicsContext& g) { g.endTransparencyLayer(); });
+    }
+
+    void setFill (const FillType& fill) override
+    {
+        state.setFill (fill);
+
+        auto copy = fill;
+
+        if (copy.isTiledImage())
+            copy.image = copy.image.createCopy();
+
+        record ([copy] (LowLevelGraphicsContext& g) { g.setFill (copy); });
+    }
+
+    void setOpacity (float opacity) override
+    {
+        state.setOpacity (opacity);
+        record ([opacity] (LowLevelGraphicsContext& g) { g.setOpacity (opacity); });
+    }
+
+    void setInterpolationQuality (Graphics::ResamplingQuality quality) override
+    {
+        state.setInterpolationQuality (quality);
+        record ([quality] (LowLevelGraphicsContext& g) { g.setInterpolationQuality (quality); });
+    }
+
+    void fillRect (const Rectangle<int>& r, bool replaceExistingContents) override
+    {
+        record ([r, replaceExistingContents] (LowLevelGraphicsContext& g) { g.fillRect (r, replaceExistingContents); });
+    }
+
+    void fillRect (const Rectangle<float>& r) override
+    {
+        record ([r] (LowLevelGraphicsContext& g) { g.fillRect (r); });
+    }
+
+    void fillRectList (const RectangleList<float>& list) override
+    {
+        record ([list] (LowLevelGraphicsContext& g) { g.fillRectList (list); });
+    }
+
+    void fillPath (const Path& path, const AffineTransform& t) override
+    {
+        record ([path, t, cache = detail::PathCache()] (LowLevelGraphicsContext& g) mutable { g.fillPathWithCache (path, t, cache); });
+    }
+
+    void drawImage (const Image& im, const AffineTransform& t) override
+    {
+        record ([im = im.createCopy(), t] (LowLevelGraphicsContext& g) { g.drawImage (im, t); });
+    }
+
+    void drawLine (const Line<float>& line) override
+    {
+        record ([line] (LowLevelGraphicsContext& g) { g.drawLine (line); });
+    }
+
+    void setFont (const Font& newFont) override
+    {
+        state.setFont (newFont);
+        record ([newFont] (LowLevelGraphicsContext& g) { g.setFont (newFont); });
+    }
+
+    const Font& getFont() override                          { return state.getFont(); }
+
+    void drawGlyph (int glyphNumber, const AffineTransform& t) override
+    {
+        record ([glyphNumber, t] (LowLevelGraphicsContext& g) { g.drawGlyph (glyphNumber, t); });
+    }
+
+private:
+    // A list that's replayed onto a recorder, e.g. by a component inside another one that's
+    // being recorded, doesn't pass its cache on
+    void fillPathWithCache (const Path& path, const AffineTransform& t, detail::PathCache&) override
+    {
+        fillPath (path, t);
+    }
+
+    template <typename CommandType>
+    void record (CommandType&& command)     { commands.emplace_back (std::forward<CommandType> (command)); }
+
+    std::vector<Command>& commands;
+    LowLevelGraphicsSoftwareRenderer state;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Recorder)
+};
+
+//==============================================================================
+GraphicsDisplayList::GraphicsDisplayList() = default;
+GraphicsDisplayList::~GraphicsDisplayList() = default;
+
+std::unique_ptr<LowLevelGraphicsContext> GraphicsDisplayList::createRecordingContext (Rectangle<int> area,
+                                                                                      float physicalPixelScaleFactor)
+{
+    clear();
+    return std::make_unique<Recorder> (commands, area, physicalPixelScaleFactor);
+}
+
+void GraphicsDisplayList::replay (LowLevelGraphicsContext& g)
+{
+    g.saveState();
+
+    for (auto& command : commands)
+        command (g);
+
+    g.restoreState();
+}
+
+void GraphicsDisplayList::clear()
+{
+    commands.clear();
+}
+
+} // namespace juce
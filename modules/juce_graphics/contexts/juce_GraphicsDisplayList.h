@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A recording of some drawing, which can be drawn again without repeating the
+    work that went into it.
+
+    To record into the list, draw onto the context returned by createRecordingContext(),
+    e.g. by wrapping it in a Graphics object. The recording keeps the low-level calls
+    that the drawing made, so anything that was worked out along the way, such as
+    the layout of some text or the outline of a stroked path, doesn't need to be
+    worked out again. When replayed onto a context that supports it, each filled
+    path also keeps the shape that it was flattened into, so that later replays
+    with the same transform, or one that's only been moved by whole pixels, can
+    skip flattening it.
+
+    Replaying draws exactly the same pixels as the original drawing would have, except
+    that a shape which is reused after being moved can differ by a couple of levels
+    (out of 255) along its anti-aliased edges. That's because flattening a path at a
+    different position rounds its coordinates slightly differently.
+
+    A display list uses far less memory than an image of the same drawing, and can
+    be replayed at any scale.
+
+    Any images that are drawn, or used as fills or clip masks, are copied when they're
+    recorded, so they can be changed afterwards without affecting the recording.
+
+    @see Component::setBufferedToDisplayList
+
+    @tags{Graphics}
+*/
+class JUCE_API  GraphicsDisplayList
+{
+public:
+    //==============================================================================
+    /** Creates an empty display list. */
+    GraphicsDisplayList();
+
+    /** Destructor. */
+    ~GraphicsDisplayList();
+
+    //==============================================================================
+    /** Clears the list, and returns a context that records anything that's drawn
+        with it into the list.
+
+        The context behaves as if it were drawing the given area onto a device with
+        the given physical pixel scale factor, so that painting code which checks the
+        clip region or the scale will record what it would have drawn there. The list
+        mustn't be replayed until the context has been deleted.
+    */
+    std::unique_ptr<LowLevelGraphicsContext> createRecordingContext (Rectangle<int> area,
+                                                                     float physicalPixelScaleFactor = 1.0f);
+
+    /** Draws everything that's been recorded onto a context.
+
+        The context's state is left as it was before.
+    */
+    void replay (LowLevelGraphicsContext&);
+
+    /** Discards everything that's been recorded. */
+    void clear();
+
+    /** Returns true if nothing has been recorded. */
+    bool isEmpty() const noexcept                   { return commands.empty(); }
+
+    /** Returns the number of low-level calls that have been recorded. */
+    int getNumCommands() const noexcept             { return (int) commands.size(); }
+
+private:
+    //==============================================================================
+    class Recorder;
+
+    using Command = std::function<void (LowLevelGraphicsContext&)>;
+    std::vector<Command> commands;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GraphicsDisplayList)
+};
+
+} // namespace juce
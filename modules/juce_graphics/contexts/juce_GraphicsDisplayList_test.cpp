@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct GraphicsDisplayListTest final : public UnitTest
+{
+    GraphicsDisplayListTest()
+        : UnitTest ("GraphicsDisplayList", UnitTestCategories::graphics)
+    {}
+
+    static constexpr int width = 300, height = 200;
+
+    // Something like a typical control, with curves, strokes and text
+    static void drawScene (Graphics& g, const Image& sprite)
+    {
+        g.setGradientFill (ColourGradient (Colours::lightgrey, 0.0f, 0.0f, Colours::darkgrey, 0.0f, (float) height, false));
+        g.fillRoundedRectangle (5.0f, 5.0f, width - 10.0f, height - 10.0f, 8.0f);
+
+        g.setColour (Colours::black);
+        g.drawRoundedRectangle (5.5f, 5.5f, width - 11.0f, height - 11.0f, 8.0f, 1.5f);
+
+        Path arc;
+        arc.addCentredArc (80.0f, 110.0f, 50.0f, 50.0f, 0.0f, -2.4f, 2.4f, true);
+        g.setColour (Colours::orange);
+        g.strokePath (arc, PathStrokeType (6.0f, PathStrokeType::curved, PathStrokeType::rounded));
+
+        Path pointer;
+        pointer.addTriangle (-4.0f, 0.0f, 4.0f, 0.0f, 0.0f, -45.0f);
+        g.setColour (Colours::white);
+        g.fillPath (pointer, AffineTransform::rotation (0.7f).translated (80.0f, 110.0f));
+
+        for (int i = 0; i < 20; ++i)
+        {
+            g.setColour (Colour::fromHSV ((float) i / 20.0f, 0.7f, 0.9f, 1.0f));
+            g.fillEllipse (150.0f + (float) (i % 5) * 27.0f, 40.0f + (float) (i / 5) * 27.0f, 20.0f, 20.0f);
+        }
+
+        g.drawLine (150.0f, 160.0f, 280.0f, 180.0f, 2.0f);
+        g.drawImageAt (sprite, 20, 15);
+
+        {
+            Graphics::ScopedSaveState save (g);
+            g.reduceClipRegion (160, 150, 100, 40);
+            g.beginTransparencyLayer (0.5f);
+            g.setColour (Colours::blue);
+            g.fillRect (150, 140, 80, 60);
+            g.endTransparencyLayer();
+        }
+
+        g.setColour (Colours::black);
+        g.setFont (15.0f);
+        g.drawText ("Display list", 20, 170, 120, 20, Justification::centredLeft);
+    }
+
+    static Image createSprite()
+    {
+        Image sprite (Image::ARGB, 24, 24, true);
+        Graphics g (sprite);
+        g.setColour (Colours::green.withAlpha (0.7f));
+        g.fillEllipse (sprite.getBounds().toFloat());
+        return sprite;
+    }
+
+    static Image drawDirectly (const Image& sprite, Point<int> origin)
+    {
+        Image image (Image::ARGB, width, height, true, SoftwareImageType());
+        Graphics g (image);
+        g.setOrigin (origin);
+        drawScene (g, sprite);
+        return image;
+    }
+
+    static Image replay (GraphicsDisplayList& list, Point<int> origin)
+    {
+        Image image (Image::ARGB, width, height, true, SoftwareImageType());
+        LowLevelGraphicsSoftwareRenderer context (image);
+        context.setOrigin (origin);
+        list.replay (context);
+        return image;
+    }
+
+    static void record (GraphicsDisplayList& list, const Image& sprite)
+    {
+        auto context = list.createRecordingContext ({ width, height });
+        Graphics g (*context);
+        drawScene (g, sprite);
+    }
+
+    static int getMaximumDifference (const Image& a, const Image& b)
+    {
+        int result = 0;
+
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            for (int x = 0; x < a.getWidth(); ++x)
+            {
+                const auto pa = a.getPixelAt (x, y), pb = b.getPixelAt (x, y);
+
+                result = jmax (result,
+                               std::abs ((int) pa.getAlpha() - (int) pb.getAlpha()),
+                               std::abs ((int) pa.getRed()   - (int) pb.getRed()),
+                               jmax (std::abs ((int) pa.getGreen() - (int) pb.getGreen()),
+                                     std::abs ((int) pa.getBlue()  - (int) pb.getBlue())));
+            }
+        }
+
+        return result;
+    }
+
+    void runTest() override
+    {
+        const auto sprite = createSprite();
+
+        beginTest ("Replaying matches drawing directly");
+        {
+            GraphicsDisplayList list;
+            record (list, sprite);
+            expect (! list.isEmpty());
+
+            const auto direct = drawDirectly (sprite, {});
+            expectEquals (getMaximumDifference (direct, replay (list, {})), 0);
+
+            // the second time uses the cached shapes
+            expectEquals (getMaximumDifference (direct, replay (list, {})), 0);
+        }
+
+        beginTest ("Cached shapes can be moved");
+        {
+            GraphicsDisplayList list;
+            record (list, sprite);
+            replay (list, {});
+
+            // Moving changes how the coordinates of the paths get rounded, so the edges of the
+            // reused shapes can differ slightly, as described in the GraphicsDisplayList docs
+            constexpr int maxEdgeDifference = 2;
+
+            expectLessOrEqual (getMaximumDifference (drawDirectly (sprite, { 13, -7 }), replay (list, { 13, -7 })), maxEdgeDifference);
+            expectLessOrEqual (getMaximumDifference (drawDirectly (sprite, { -40, 25 }), replay (list, { -40, 25 })), maxEdgeDifference);
+        }
+
+        beginTest ("The recording context behaves like the area it's recording");
+        {
+            GraphicsDisplayList list;
+            auto context = list.createRecordingContext ({ 10, 20, 100, 50 }, 2.0f);
+
+            expect (context->getClipBounds() == Rectangle<int> (10, 20, 100, 50));
+            expectEquals (context->getPhysicalPixelScaleFactor(), 2.0f);
+            expect (! context->clipRegionIntersects ({ 0, 0, 10, 10 }));
+
+            context->saveState();
+            context->setOrigin ({ 10, 20 });
+            expect (context->clipToRectangle ({ 50, 0, 100, 100 }));
+            expect (context->getClipBounds() == Rectangle<int> (50, 0, 50, 50));
+            context->restoreState();
+
+            expect (context->getClipBounds() == Rectangle<int> (10, 20, 100, 50));
+            expectEquals (list.getNumCommands(), 4);
+
+            context.reset();
+            list.clear();
+            expect (list.isEmpty());
+        }
+
+        beginTest ("Images are copied when they're recorded");
+        {
+            auto changingSprite = sprite.createCopy();
+            GraphicsDisplayList list;
+            record (list, changingSprite);
+
+            changingSprite.clear (changingSprite.getBounds(), Colours::red);
+            expectEquals (getMaximumDifference (drawDirectly (sprite, {}), replay (list, {})), 0);
+        }
+    }
+};
+
+static GraphicsDisplayListTest graphicsDisplayListTest;
+
+} // namespace juce
@@ -26,6 +26,21 @@
 namespace juce
 {
 
+#ifndef DOXYGEN
+namespace detail
+{
+    /*  Holds the shape that a path was flattened into when a GraphicsDisplayList filled
+        it, so that filling the same path again can reuse it. The contents are only
+        meaningful to the context that filled the path.
+    */
+    struct PathCache
+    {
+        std::optional<EdgeTable> edgeTable;
+        AffineTransform transform;
+    };
+} // namespace detail
+#endif
+
 //==============================================================================
 /**
     Interface class for graphics context objects, used internally by the Graphics class.
@@ -98,6 +113,18 @@ public:
     virtual const Font& getFont() = 0;
     virtual void drawGlyph (int glyphNumber, const AffineTransform&) = 0;
     virtual bool drawTextLayout (const AttributedString&, const Rectangle<float>&)  { return false; }
+
+private:
+    //==============================================================================
+    friend class GraphicsDisplayList;
+
+    // Fills a path, keeping the shape that it's flattened into in a cache that's owned by
+    // the caller, so that later calls with the same path and cache are quicker. The cache
+    // must only ever be used with one path. Contexts that can't reuse shapes just call fillPath().
+    virtual void fillPathWithCache (const Path& path, const AffineTransform& transform, detail::PathCache&)
+    {
+        fillPath (path, transform);
+    }
 };
 
 } // namespace juce
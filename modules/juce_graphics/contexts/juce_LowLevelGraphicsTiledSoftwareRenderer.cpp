@@ -0,0 +1,335 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  Gives the bands direct access to the pixels of the image being drawn on.
+
+    Creating a BitmapData for an image tells its listeners that it has changed, which
+    isn't safe to do from several threads at once, so the target image is opened once
+    by the thread that creates the renderer, and the bands draw on this instead.
+*/
+class LowLevelGraphicsTiledSoftwareRenderer::SharedPixelData final  : public ImagePixelData
+{
+public:
+    explicit SharedPixelData (const Image::BitmapData& pixels)
+        : ImagePixelData (pixels.pixelFormat, pixels.width, pixels.height),
+          source (pixels)
+    {
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (*this));
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode) override
+    {
+        const auto offset = (size_t) x * (size_t) source.pixelStride + (size_t) y * (size_t) source.lineStride;
+        bitmap.data = source.data + offset;
+        bitmap.size = source.size - offset;
+        bitmap.pixelFormat = source.pixelFormat;
+        bitmap.lineStride = source.lineStride;
+        bitmap.pixelStride = source.pixelStride;
+    }
+
+    ImagePixelData::Ptr clone() override
+    {
+        Image newImage (SoftwareImageType().create (pixelFormat, width, height, false));
+
+        {
+            const Image::BitmapData dest (newImage, Image::BitmapData::writeOnly);
+
+            for (int y = 0; y < height; ++y)
+                memcpy (dest.getLinePointer (y), source.getLinePointer (y), (size_t) (width * source.pixelStride));
+        }
+
+        return *newImage.getPixelData();
+    }
+
+    std::unique_ptr<ImageType> createType() const override    { return std::make_unique<SoftwareImageType>(); }
+
+private:
+    const Image::BitmapData& source;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedPixelData)
+};
+
+//==============================================================================
+class LowLevelGraphicsTiledSoftwareRenderer::BandRenderer final
+    : public RenderingHelpers::StackBasedLowLevelGraphicsContext<RenderingHelpers::SoftwareRendererSavedState>
+{
+public:
+    BandRenderer (const Image& image, Point<int> origin, const RectangleList<int>& initialClip, Range<int> rows)
+        : StackBasedLowLevelGraphicsContext (new RenderingHelpers::SoftwareRendererSavedState (image, initialClip, origin))
+    {
+        stack->rowsToRender = rows;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BandRenderer)
+};
+
+//==============================================================================
+struct LowLevelGraphicsTiledSoftwareRenderer::SharedThreadPool
+{
+    ThreadPool pool { ThreadPoolOptions{}.withThreadName ("Tiled Renderer")
+                                         .withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)) };
+};
+
+//==============================================================================
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& image, int numBands,
+                                                                              ThreadPool* threadPoolToUse)
+    : LowLevelGraphicsTiledSoftwareRenderer (image, {}, image.getBounds(), numBands, threadPoolToUse)
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& image, Point<int> origin,
+                                                                              const RectangleList<int>& initialClip,
+                                                                              int numBands, ThreadPool* threadPoolToUse)
+    : target (image),
+      targetData (target, Image::BitmapData::readWrite),
+      bandImage (*new SharedPixelData (targetData)),
+      state (bandImage, origin, initialClip),
+      sharedThreadPool (threadPoolToUse == nullptr ? std::make_optional<SharedResourcePointer<SharedThreadPool>>()
+                                                   : std::nullopt),
+      threadPool (threadPoolToUse != nullptr ? *threadPoolToUse : (*sharedThreadPool)->pool)
+{
+    const auto rows = initialClip.getBounds().getIntersection (image.getBounds()).getVerticalRange();
+
+    if (numBands <= 0)
+        numBands = jmin (threadPool.getNumThreads() + 1, SystemStats::getNumCpus());
+
+    numBands = jlimit (1, jmax (1, rows.getLength() / 16), numBands);
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        const auto start = rows.getStart() + (int) ((int64) rows.getLength() * i / numBands);
+        const auto end   = rows.getStart() + (int) ((int64) rows.getLength() * (i + 1) / numBands);
+
+        bands.push_back (std::make_unique<BandRenderer> (bandImage, origin, initialClip, Range<int> (start, end)));
+    }
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    flush();
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    if (commands.empty())
+        return;
+
+    const auto numBands = (int) bands.size();
+
+    struct BandQueue
+    {
+        std::atomic<int> nextBand { 0 }, numBandsFinished { 0 };
+        WaitableEvent allBandsFinished;
+    };
+
+    auto queue = std::make_shared<BandQueue>();
+
+    // Each thread keeps taking bands until there are none left. A thread pool job that
+    // only starts once they've all been taken doesn't touch anything except the queue.
+    auto renderBands = [this, queue, numBands]
+    {
+        for (int i = queue->nextBand++; i < numBands; i = queue->nextBand++)
+        {
+            for (auto& command : commands)
+                command (*bands[(size_t) i]);
+
+            if (++queue->numBandsFinished == numBands)
+                queue->allBandsFinished.signal();
+        }
+    };
+
+    for (int i = 1; i < numBands; ++i)
+        threadPool.addJob (renderBands);
+
+    renderBands();
+    queue->allBandsFinished.wait();
+
+    commands.clear();
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    state.setOrigin (o);
+    record ([o] (LowLevelGraphicsContext& g) { g.setOrigin (o); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    state.addTransform (t);
+    record ([t] (LowLevelGraphicsContext& g) { g.addTransform (t); });
+}
+
+float LowLevelGraphicsTiledSoftwareRenderer::getPhysicalPixelScaleFactor()
+{
+    return state.getPhysicalPixelScaleFactor();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    record ([r] (LowLevelGraphicsContext& g) { g.clipToRectangle (r); });
+    return state.clipToRectangle (r);
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& list)
+{
+    record ([list] (LowLevelGraphicsContext& g) { g.clipToRectangleList (list); });
+    return state.clipToRectangleList (list);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    state.excludeClipRectangle (r);
+    record ([r] (LowLevelGraphicsContext& g) { g.excludeClipRectangle (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    state.clipToPath (path, t);
+    record ([path, t] (LowLevelGraphicsContext& g) { g.clipToPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    state.clipToImageAlpha (im, t);
+    record ([im, t] (LowLevelGraphicsContext& g) { g.clipToImageAlpha (im, t); });
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r)
+{
+    return state.clipRegionIntersects (r);
+}
+
+Rectangle<int> LowLevelGraphicsTiledSoftwareRenderer::getClipBounds() const
+{
+    return state.getClipBounds();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::isClipEmpty() const
+{
+    return state.isClipEmpty();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    state.saveState();
+    record ([] (LowLevelGraphicsContext& g) { g.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    state.restoreState();
+    record ([] (LowLevelGraphicsContext& g) { g.restoreState(); });
+}
+
+// A transparency layer only changes what gets drawn, so the state just needs to
+// remember where it started
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    state.saveState();
+    record ([opacity] (LowLevelGraphicsContext& g) { g.beginTransparencyLayer (opacity); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    state.restoreState();
+    record ([] (LowLevelGraphicsContext& g) { g.endTransparencyLayer(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fill)
+{
+    state.setFill (fill);
+    record ([fill] (LowLevelGraphicsContext& g) { g.setFill (fill); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float opacity)
+{
+    state.setOpacity (opacity);
+    record ([opacity] (LowLevelGraphicsContext& g) { g.setOpacity (opacity); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    state.setInterpolationQuality (quality);
+    record ([quality] (LowLevelGraphicsContext& g) { g.setInterpolationQuality (quality); });
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    record ([r, replaceExistingContents] (LowLevelGraphicsContext& g) { g.fillRect (r, replaceExistingContents); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    record ([r] (LowLevelGraphicsContext& g) { g.fillRect (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    record ([list] (LowLevelGraphicsContext& g) { g.fillRectList (list); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    record ([path, t] (LowLevelGraphicsContext& g) { g.fillPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
+{
+    record ([im, t] (LowLevelGraphicsContext& g) { g.drawImage (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    record ([line] (LowLevelGraphicsContext& g) { g.drawLine (line); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& newFont)
+{
+    state.setFont (newFont);
+    record ([newFont] (LowLevelGraphicsContext& g) { g.setFont (newFont); });
+}
+
+const Font& LowLevelGraphicsTiledSoftwareRenderer::getFont()
+{
+    return state.getFont();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    record ([glyphNumber, t] (LowLevelGraphicsContext& g) { g.drawGlyph (glyphNumber, t); });
+}
+
+} // namespace juce
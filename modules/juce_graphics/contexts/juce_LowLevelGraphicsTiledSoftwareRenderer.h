@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A version of LowLevelGraphicsSoftwareRenderer that shares the work of drawing
+    an image between several threads.
+
+    Rather than drawing straight away, this records everything that's drawn with it.
+    When flush() is called, or the context is deleted, the image is split into
+    horizontal bands, and each band replays the recorded drawing on its own thread,
+    only touching the pixels in its own rows. The results are exactly the same as
+    those of a LowLevelGraphicsSoftwareRenderer.
+
+    This pays off for large images, where most of the time goes on filling pixels.
+    For small ones, the extra work that each band does to replay the drawing may
+    cost more than it saves.
+
+    Because the drawing happens later, any images that are drawn must not be changed
+    until the drawing has been flushed, and the image being drawn on mustn't be drawn
+    onto itself. The image's contents are also only guaranteed to be up to date once
+    the context has been deleted.
+
+    Unlike the other contexts, this one is never created for you, so to use it, create
+    one for your image and draw on it with a Graphics object, e.g.
+    @code
+    {
+        LowLevelGraphicsTiledSoftwareRenderer context (image);
+        Graphics g (context);
+        drawEverything (g);
+    } // the image is finished once the context has been deleted
+    @endcode
+
+    @see LowLevelGraphicsSoftwareRenderer
+
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer    : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into an image.
+
+        @param imageToRenderOnto    the image to draw on
+        @param numBands             the number of bands to split the image into. If this is
+                                    zero, there'll be one band for each of the thread pool's
+                                    threads, plus one for the thread that calls flush(), up
+                                    to the number of CPUs. Bands are never less than 16 rows
+                                    high.
+        @param threadPoolToUse      the pool whose threads should draw the bands. If this is
+                                    nullptr, a pool that's shared by all tiled renderers is
+                                    used.
+    */
+    explicit LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto,
+                                                    int numBands = 0,
+                                                    ThreadPool* threadPoolToUse = nullptr);
+
+    /** Creates a context to render into a clipped subsection of an image.
+        The other parameters are the same as for the other constructor.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           int numBands = 0,
+                                           ThreadPool* threadPoolToUse = nullptr);
+
+    /** Destructor. This draws anything that hasn't been flushed yet. */
+    ~LowLevelGraphicsTiledSoftwareRenderer() override;
+
+    //==============================================================================
+    /** Draws everything that's been recorded since the last flush, and waits for
+        all the bands to finish.
+    */
+    void flush();
+
+    /** Returns the number of bands that the image is split into. */
+    int getNumBands() const noexcept                { return (int) bands.size(); }
+
+    //==============================================================================
+    bool isVectorDevice() const override            { return false; }
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+
+    void saveState() override;
+    void restoreState() override;
+
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    class SharedPixelData;
+    class BandRenderer;
+    struct SharedThreadPool;
+
+    using Command = std::function<void (LowLevelGraphicsContext&)>;
+
+    template <typename CommandType>
+    void record (CommandType&& command)     { commands.emplace_back (std::forward<CommandType> (command)); }
+
+    Image target;
+    const Image::BitmapData targetData;
+    const Image bandImage;
+
+    // This follows the clipping and transforms without ever drawing, so that queries
+    // can be answered straight away
+    LowLevelGraphicsSoftwareRenderer state;
+
+    std::optional<SharedResourcePointer<SharedThreadPool>> sharedThreadPool;
+    ThreadPool& threadPool;
+
+    std::vector<std::unique_ptr<BandRenderer>> bands;
+    std::vector<Command> commands;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
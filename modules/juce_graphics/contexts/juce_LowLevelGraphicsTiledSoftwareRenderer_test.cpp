@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct LowLevelGraphicsTiledSoftwareRendererTest final : public UnitTest
+{
+    LowLevelGraphicsTiledSoftwareRendererTest()
+        : UnitTest ("LowLevelGraphicsTiledSoftwareRenderer", UnitTestCategories::graphics)
+    {}
+
+    static Image createSprite()
+    {
+        Image sprite (Image::ARGB, 37, 29, true);
+        Graphics g (sprite);
+        g.setGradientFill (ColourGradient (Colours::red.withAlpha (0.8f), 0.0f, 0.0f,
+                                           Colours::blue.withAlpha (0.3f), 37.0f, 29.0f, false));
+        g.fillEllipse (sprite.getBounds().toFloat());
+        g.setColour (Colours::white);
+        g.drawRect (sprite.getBounds(), 2);
+        return sprite;
+    }
+
+    // Draws something that uses every kind of fill, clip and layer that the renderer has
+    static void drawScene (Graphics& g, int width, int height, const Image& sprite)
+    {
+        const auto w = (float) width, h = (float) height;
+
+        g.fillAll (Colours::darkgrey);
+
+        g.setGradientFill (ColourGradient (Colours::yellow, 0.0f, 0.0f, Colours::purple.withAlpha (0.5f), w, h, false));
+        g.fillRect (Rectangle<float> (w * 0.1f, h * 0.1f, w * 0.5f, h * 0.6f));
+
+        g.setGradientFill (ColourGradient (Colours::white, w * 0.5f, h * 0.5f, Colours::transparentBlack, w * 0.8f, h * 0.5f, true));
+        g.fillEllipse (w * 0.3f, h * 0.2f, w * 0.5f, h * 0.6f);
+
+        Path star;
+        star.addStar ({ w * 0.7f, h * 0.3f }, 7, h * 0.1f, h * 0.25f, 0.3f);
+
+        g.setColour (Colours::orange.withAlpha (0.7f));
+        g.fillPath (star);
+        g.setColour (Colours::black);
+        g.strokePath (star, PathStrokeType (3.5f));
+
+        for (int i = 0; i < 40; ++i)
+        {
+            g.setColour (Colour::fromHSV ((float) i / 40.0f, 0.8f, 0.9f, 0.6f));
+            g.drawLine (0.0f, (float) i * h / 40.0f, w, h - (float) i * h / 40.0f, 1.3f);
+        }
+
+        {
+            Graphics::ScopedSaveState save (g);
+            g.reduceClipRegion (Rectangle<int> (width / 8, height / 2, width / 2, height / 3));
+            g.excludeClipRegion (Rectangle<int> (width / 4, height * 3 / 5, width / 10, height / 10));
+            g.setTiledImageFill (sprite, 3, 5, 0.9f);
+            g.fillAll();
+        }
+
+        {
+            Graphics::ScopedSaveState save (g);
+            Path clipShape;
+            clipShape.addRoundedRectangle (w * 0.55f, h * 0.55f, w * 0.4f, h * 0.4f, h * 0.05f);
+            g.reduceClipRegion (clipShape);
+            g.addTransform (AffineTransform::rotation (0.3f, w * 0.75f, h * 0.75f));
+            g.drawImageTransformed (sprite, AffineTransform::scale (w / 200.0f).translated (w * 0.6f, h * 0.6f));
+
+            g.setImageResamplingQuality (Graphics::highResamplingQuality);
+            g.drawImageTransformed (sprite, AffineTransform::rotation (-0.7f).scaled (2.5f).translated (w * 0.7f, h * 0.8f));
+        }
+
+        g.drawImageAt (sprite, width / 3, height / 7);
+        g.drawImage (sprite, Rectangle<float> (w * 0.05f, h * 0.7f, w * 0.2f, h * 0.25f), RectanglePlacement::stretchToFit);
+
+        {
+            Graphics::ScopedSaveState save (g);
+            g.beginTransparencyLayer (0.6f);
+            g.setColour (Colours::cyan);
+            g.fillRoundedRectangle (w * 0.2f, h * 0.4f, w * 0.6f, h * 0.3f, 10.0f);
+            g.setColour (Colours::magenta);
+            g.fillEllipse (w * 0.4f, h * 0.35f, w * 0.2f, h * 0.4f);
+            g.endTransparencyLayer();
+        }
+
+        g.setColour (Colours::white);
+        g.setFont (h / 12.0f);
+        g.drawText ("The quick brown fox jumps over the lazy dog", 0, height / 20, width, height / 10, Justification::centred);
+
+        {
+            Graphics::ScopedSaveState save (g);
+            g.addTransform (AffineTransform::rotation (-0.2f, w * 0.5f, h * 0.9f));
+            g.setFont (Font (h / 15.0f, Font::bold));
+            g.drawText ("Rotated text", 0, height * 8 / 10, width, height / 10, Justification::centred);
+        }
+
+        g.setColour (Colours::green.withAlpha (0.4f));
+        RectangleList<float> list;
+
+        for (int i = 0; i < 10; ++i)
+            list.add ((float) i * w / 10.0f + 0.3f, h * 0.9f + 0.5f, w / 20.0f, h / 20.0f);
+
+        g.fillRectList (list);
+    }
+
+    static bool imagesAreIdentical (const Image& a, const Image& b)
+    {
+        const Image::BitmapData da (a, Image::BitmapData::readOnly);
+        const Image::BitmapData db (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            if (memcmp (da.getLinePointer (y), db.getLinePointer (y), (size_t) (a.getWidth() * da.pixelStride)) != 0)
+                return false;
+
+        return true;
+    }
+
+    void testMatchesSerialRenderer (Image::PixelFormat format, int width, int height, int numBands)
+    {
+        const auto sprite = createSprite();
+        Image serial (format, width, height, true, SoftwareImageType());
+        Image tiled (format, width, height, true, SoftwareImageType());
+
+        {
+            Graphics g (serial);
+            drawScene (g, width, height, sprite);
+        }
+
+        {
+            LowLevelGraphicsTiledSoftwareRenderer context (tiled, numBands);
+            Graphics g (context);
+            drawScene (g, width, height, sprite);
+        }
+
+        expect (imagesAreIdentical (serial, tiled));
+    }
+
+    static void drawBoth (Image& serial, Image& tiled, int numBands, Point<int> origin,
+                          const RectangleList<int>& clip, const Image& sprite)
+    {
+        {
+            LowLevelGraphicsSoftwareRenderer context (serial, origin, clip);
+            Graphics g (context);
+            drawScene (g, serial.getWidth(), serial.getHeight(), sprite);
+        }
+
+        {
+            LowLevelGraphicsTiledSoftwareRenderer context (tiled, origin, clip, numBands);
+            Graphics g (context);
+            drawScene (g, tiled.getWidth(), tiled.getHeight(), sprite);
+        }
+    }
+
+    void runTest() override
+    {
+        beginTest ("ARGB images match the serial renderer");
+        {
+            testMatchesSerialRenderer (Image::ARGB, 400, 300, 0);
+            testMatchesSerialRenderer (Image::ARGB, 400, 300, 1);
+            testMatchesSerialRenderer (Image::ARGB, 400, 300, 7);
+            testMatchesSerialRenderer (Image::ARGB, 123, 457, 5);
+        }
+
+        beginTest ("RGB images match the serial renderer");
+        {
+            testMatchesSerialRenderer (Image::RGB, 400, 300, 0);
+            testMatchesSerialRenderer (Image::RGB, 301, 199, 6);
+        }
+
+        beginTest ("Single channel images match the serial renderer");
+        {
+            testMatchesSerialRenderer (Image::SingleChannel, 400, 300, 0);
+            testMatchesSerialRenderer (Image::SingleChannel, 257, 263, 4);
+        }
+
+        beginTest ("Clipped contexts match the serial renderer");
+        {
+            const auto sprite = createSprite();
+            Image serial (Image::ARGB, 320, 240, true, SoftwareImageType());
+            Image tiled (Image::ARGB, 320, 240, true, SoftwareImageType());
+
+            RectangleList<int> clip;
+            clip.add (10, 20, 150, 100);
+            clip.add (200, 50, 100, 170);
+            clip.add (40, 180, 60, 40);
+
+            drawBoth (serial, tiled, 5, { 7, -3 }, clip, sprite);
+            expect (imagesAreIdentical (serial, tiled));
+        }
+
+        beginTest ("Bands are at least 16 rows high");
+        {
+            Image image (Image::ARGB, 100, 50, true, SoftwareImageType());
+            expectEquals (LowLevelGraphicsTiledSoftwareRenderer (image, 8).getNumBands(), 3);
+            expectEquals (LowLevelGraphicsTiledSoftwareRenderer (image, 2).getNumBands(), 2);
+
+            Image tiny (Image::ARGB, 10, 10, true, SoftwareImageType());
+            expectEquals (LowLevelGraphicsTiledSoftwareRenderer (tiny).getNumBands(), 1);
+        }
+
+        beginTest ("Drawing carries on after a flush");
+        {
+            Image serial (Image::ARGB, 200, 200, true, SoftwareImageType());
+            Image tiled (Image::ARGB, 200, 200, true, SoftwareImageType());
+
+            const auto draw = [] (LowLevelGraphicsContext& context, std::function<void()> flush)
+            {
+                Graphics g (context);
+                g.setColour (Colours::red);
+                g.addTransform (AffineTransform::rotation (0.4f, 100.0f, 100.0f));
+                g.reduceClipRegion (20, 20, 160, 160);
+                g.fillEllipse (10.0f, 30.0f, 150.0f, 90.0f);
+                flush();
+                g.setColour (Colours::blue.withAlpha (0.5f));
+                g.fillRect (50.0f, 50.0f, 100.5f, 100.5f);
+            };
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (serial);
+                draw (context, [] {});
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (tiled, 4);
+                draw (context, [&] { context.flush(); });
+            }
+
+            expect (imagesAreIdentical (serial, tiled));
+        }
+
+        beginTest ("Glyphs can be created by several bands at once");
+        {
+            // Drawing glyphs directly skips laying out any text, so the typeface hasn't
+            // loaded them before the bands ask for their shapes
+            const auto draw = [] (LowLevelGraphicsContext& context)
+            {
+                context.setFill (Colours::white);
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    context.setFont (Font (10.0f + (float) (i % 7) * 3.0f));
+                    context.drawGlyph (0x100 + i, AffineTransform::translation ((float) (i % 20) * 15.0f, (float) (i / 20) * 20.0f + 15.0f));
+                }
+
+                context.setFont (Font (150.0f));
+                context.drawGlyph (0x1f0, AffineTransform::translation (10.0f, 280.0f));
+            };
+
+            ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (4) };
+            Image serial (Image::ARGB, 300, 300, true, SoftwareImageType());
+            Image tiled (Image::ARGB, 300, 300, true, SoftwareImageType());
+
+            RenderingHelpers::SoftwareRendererSavedState::clearGlyphCache();
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (tiled, 8, &pool);
+                draw (context);
+            }
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (serial);
+                draw (context);
+            }
+
+            expect (imagesAreIdentical (serial, tiled));
+        }
+    }
+};
+
+static LowLevelGraphicsTiledSoftwareRendererTest lowLevelGraphicsTiledSoftwareRendererTest;
+
+} // namespace juce
@@ -118,6 +118,8 @@
 #include "contexts/juce_GraphicsContext.cpp"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.cpp"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.cpp"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.cpp"
+#include "contexts/juce_GraphicsDisplayList.cpp"
 #include "images/juce_Image.cpp"
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
@@ -133,9 +135,13 @@
 #include "fonts/juce_TextLayout.cpp"
 #include "effects/juce_DropShadowEffect.cpp"
 #include "effects/juce_GlowEffect.cpp"
+#include "native/juce_RenderingHelpers.cpp"
 
 #if JUCE_UNIT_TESTS
  #include "geometry/juce_Rectangle_test.cpp"
+ #include "native/juce_RenderingHelpers_test.cpp"
+ #include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer_test.cpp"
+ #include "contexts/juce_GraphicsDisplayList_test.cpp"
 #endif
 
 #if JUCE_USE_FREETYPE
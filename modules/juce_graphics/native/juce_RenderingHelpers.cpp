@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+// The kernels rely on the alpha being the last byte of each PixelARGB. Other CPUs use the
+// per-pixel versions.
+#if JUCE_INTEL && ! JUCE_BIG_ENDIAN && ! (JUCE_MINGW && ! defined (__SSE2__))
+ #define JUCE_PIXEL_SPANS_USE_SSE2 1
+ #include <emmintrin.h>
+ #include <immintrin.h>
+#endif
+
+namespace juce::RenderingHelpers::PixelSpans
+{
+
+namespace
+{
+   #if JUCE_PIXEL_SPANS_USE_SSE2
+    //==============================================================================
+    enum class InstructionSet
+    {
+        sse2,
+        avx2
+    };
+
+    // This is zero-initialised to InstructionSet::sse2 before the detection runs, so any calls
+    // made during static initialisation will safely use the SSE2 versions.
+    std::atomic<InstructionSet> activeInstructionSet { SystemStats::hasAVX2() ? InstructionSet::avx2
+                                                                              : InstructionSet::sse2 };
+
+    namespace SSE2
+    {
+        struct Ops
+        {
+            using Bytes = __m128i;
+            using Words = __m128i;
+            enum { numBytes = 16 };
+
+            static forcedinline Bytes load (const void* p) noexcept             { return _mm_loadu_si128 (static_cast<const __m128i*> (p)); }
+            static forcedinline void store (void* p, Bytes v) noexcept          { _mm_storeu_si128 (static_cast<__m128i*> (p), v); }
+            static forcedinline Words splat16 (uint16 v) noexcept               { return _mm_set1_epi16 ((short) v); }
+
+            static forcedinline Words lowWords (Bytes v) noexcept               { return _mm_unpacklo_epi8 (v, _mm_setzero_si128()); }
+            static forcedinline Words highWords (Bytes v) noexcept              { return _mm_unpackhi_epi8 (v, _mm_setzero_si128()); }
+            static forcedinline Bytes pack (Words low, Words high) noexcept     { return _mm_packus_epi16 (low, high); }
+
+            static forcedinline Words add (Words a, Words b) noexcept           { return _mm_add_epi16 (a, b); }
+            static forcedinline Words sub (Words a, Words b) noexcept           { return _mm_sub_epi16 (a, b); }
+            static forcedinline Words mul (Words a, Words b) noexcept           { return _mm_mullo_epi16 (a, b); }
+            static forcedinline Words shr8 (Words a) noexcept                   { return _mm_srli_epi16 (a, 8); }
+
+            static forcedinline Words broadcastAlpha (Words v) noexcept         { return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, 0xff), 0xff); }
+
+            static forcedinline Bytes loadAlphas (const uint8* src) noexcept
+            {
+                const auto ab = _mm_packs_epi32 (_mm_srli_epi32 (load (src),      24), _mm_srli_epi32 (load (src + 16), 24));
+                const auto cd = _mm_packs_epi32 (_mm_srli_epi32 (load (src + 32), 24), _mm_srli_epi32 (load (src + 48), 24));
+                return _mm_packus_epi16 (ab, cd);
+            }
+        };
+
+        #include "juce_RenderingHelpers_Impl.h"
+    }
+
+    JUCE_BEGIN_TARGET_INSTRUCTION_SET ("avx2")
+
+    namespace AVX2
+    {
+        struct Ops
+        {
+            using Bytes = __m256i;
+            using Words = __m256i;
+            enum { numBytes = 32 };
+
+            static forcedinline Bytes load (const void* p) noexcept             { return _mm256_loadu_si256 (static_cast<const __m256i*> (p)); }
+            static forcedinline void store (void* p, Bytes v) noexcept          { _mm256_storeu_si256 (static_cast<__m256i*> (p), v); }
+            static forcedinline Words splat16 (uint16 v) noexcept               { return _mm256_set1_epi16 ((short) v); }
+
+            // These work within each 128-bit half, so pack() puts the bytes back where lowWords()
+            // and highWords() found them
+            static forcedinline Words lowWords (Bytes v) noexcept               { return _mm256_unpacklo_epi8 (v, _mm256_setzero_si256()); }
+            static forcedinline Words highWords (Bytes v) noexcept              { return _mm256_unpackhi_epi8 (v, _mm256_setzero_si256()); }
+            static forcedinline Bytes pack (Words low, Words high) noexcept     { return _mm256_packus_epi16 (low, high); }
+
+            static forcedinline Words add (Words a, Words b) noexcept           { return _mm256_add_epi16 (a, b); }
+            static forcedinline Words sub (Words a, Words b) noexcept           { return _mm256_sub_epi16 (a, b); }
+            static forcedinline Words mul (Words a, Words b) noexcept           { return _mm256_mullo_epi16 (a, b); }
+            static forcedinline Words shr8 (Words a) noexcept                   { return _mm256_srli_epi16 (a, 8); }
+
+            static forcedinline Words broadcastAlpha (Words v) noexcept         { return _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (v, 0xff), 0xff); }
+
+            static forcedinline Bytes loadAlphas (const uint8* src) noexcept
+            {
+                const auto ab = _mm256_packs_epi32 (_mm256_srli_epi32 (load (src),      24), _mm256_srli_epi32 (load (src + 32), 24));
+                const auto cd = _mm256_packs_epi32 (_mm256_srli_epi32 (load (src + 64), 24), _mm256_srli_epi32 (load (src + 96), 24));
+
+                // packing works within each 128-bit half, so the groups of four alphas need reordering
+                return _mm256_permutevar8x32_epi32 (_mm256_packus_epi16 (ab, cd), _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7));
+            }
+        };
+
+        #include "juce_RenderingHelpers_Impl.h"
+    }
+
+    JUCE_END_TARGET_INSTRUCTION_SET
+
+    #define JUCE_DISPATCH_SPAN_OP(functionCall) \
+        (activeInstructionSet.load (std::memory_order_relaxed) == InstructionSet::avx2 ? AVX2::functionCall \
+                                                                                       : SSE2::functionCall)
+
+   #endif
+
+    //==============================================================================
+    constexpr int solidPatternSize = 96; // a whole number of registers, and of pixels of every format
+
+    template <class PixelType>
+    void blendSolidColour (PixelType* dest, PixelARGB colour, int numPixels) noexcept
+    {
+        const auto inverseAlpha = (uint16) (0x100 - colour.getAlpha());
+        const auto numBytes = numPixels * (int) sizeof (PixelType);
+        auto* destBytes = reinterpret_cast<uint8*> (dest);
+
+        PixelType pattern[solidPatternSize / sizeof (PixelType)];
+
+        for (auto& p : pattern)
+            p.set (colour);
+
+        auto* patternBytes = reinterpret_cast<const uint8*> (pattern);
+        int i = 0;
+
+       #ifdef JUCE_DISPATCH_SPAN_OP
+        i = JUCE_DISPATCH_SPAN_OP (blendSolidBytes (destBytes, patternBytes, solidPatternSize, inverseAlpha, numBytes));
+       #endif
+
+        // Each pixel format applies the same sum to each of its components, so the
+        // remaining bytes can be blended individually, even if a pixel is split
+        for (; i < numBytes; ++i)
+            destBytes[i] = (uint8) jmin (255, patternBytes[i % solidPatternSize] + ((destBytes[i] * inverseAlpha) >> 8));
+    }
+}
+
+//==============================================================================
+void blendSolid (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept    { blendSolidColour (dest, colour, numPixels); }
+void blendSolid (PixelRGB* dest, PixelARGB colour, int numPixels) noexcept     { blendSolidColour (dest, colour, numPixels); }
+void blendSolid (PixelAlpha* dest, PixelARGB colour, int numPixels) noexcept   { blendSolidColour (dest, colour, numPixels); }
+
+void blend (PixelARGB* dest, const PixelARGB* src, int numPixels) noexcept
+{
+    int i = 0;
+
+   #ifdef JUCE_DISPATCH_SPAN_OP
+    i = JUCE_DISPATCH_SPAN_OP (blendARGB<false> (reinterpret_cast<uint8*> (dest), reinterpret_cast<const uint8*> (src), numPixels, 0));
+   #endif
+
+    for (; i < numPixels; ++i)
+        dest[i].blend (src[i]);
+}
+
+void blend (PixelARGB* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept
+{
+    jassert (extraAlpha <= 0x100);
+    int i = 0;
+
+   #ifdef JUCE_DISPATCH_SPAN_OP
+    i = JUCE_DISPATCH_SPAN_OP (blendARGB<true> (reinterpret_cast<uint8*> (dest), reinterpret_cast<const uint8*> (src), numPixels, (uint16) extraAlpha));
+   #endif
+
+    for (; i < numPixels; ++i)
+        dest[i].blend (src[i], extraAlpha);
+}
+
+void blend (PixelAlpha* dest, const PixelARGB* src, int numPixels) noexcept
+{
+    int i = 0;
+
+   #ifdef JUCE_DISPATCH_SPAN_OP
+    i = JUCE_DISPATCH_SPAN_OP (blendAlphaFromARGB<false> (reinterpret_cast<uint8*> (dest), reinterpret_cast<const uint8*> (src), numPixels, 0));
+   #endif
+
+    for (; i < numPixels; ++i)
+        dest[i].blend (src[i]);
+}
+
+void blend (PixelAlpha* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept
+{
+    jassert (extraAlpha < 0x100);
+    int i = 0;
+
+   #ifdef JUCE_DISPATCH_SPAN_OP
+    i = JUCE_DISPATCH_SPAN_OP (blendAlphaFromARGB<true> (reinterpret_cast<uint8*> (dest), reinterpret_cast<const uint8*> (src), numPixels, (uint16) (extraAlpha + 1)));
+   #endif
+
+    for (; i < numPixels; ++i)
+        dest[i].blend (src[i], extraAlpha);
+}
+
+#undef JUCE_DISPATCH_SPAN_OP
+
+} // namespace juce::RenderingHelpers::PixelSpans
@@ -133,9 +133,29 @@ public:
     bool isOnlyTranslated = true, isRotated = false;
 };
 
+//==============================================================================
+/** Returns the lock that the renderers hold while they ask a typeface for the shape
+    of a glyph.
+
+    Typefaces can't be asked for glyph shapes from more than one thread at a time, so
+    anything that does this while other threads may be drawing text should hold this
+    lock while it does so.
+*/
+inline const CriticalSection& getGlyphGenerationLock() noexcept
+{
+    static CriticalSection lock;
+    return lock;
+}
+
 //==============================================================================
 /** Holds a cache of recently-used glyph objects of some type.
 
+    The glyphs are spread over a number of shards, each with its own lock, and found
+    by hashing the font and glyph number, so threads drawing text at the same time
+    rarely wait for each other, and looking up a glyph doesn't depend on how many
+    others are cached. When the cache is full, the least recently used glyph that
+    isn't currently being drawn is replaced.
+
     @tags{Graphics}
 */
 template <class CachedGlyphType, class RenderTargetType>
@@ -149,7 +169,8 @@ public:
 
     ~GlyphCache() override
     {
-        getSingletonPointer() = nullptr;
+        if (getSingletonPointer() == this)
+            getSingletonPointer() = nullptr;
     }
 
     static GlyphCache& getInstance()
@@ -162,88 +183,206 @@ public:
         return *g;
     }
 
+    //==============================================================================
+    /** Holds the number of lookups that found, or had to create, a glyph. */
+    struct Statistics
+    {
+        int64 hits = 0, misses = 0;
+        int numGlyphs = 0;
+
+        /** Returns the proportion of lookups that found an existing glyph. */
+        double getHitRate() const noexcept      { return hits + misses > 0 ? (double) hits / (double) (hits + misses) : 0.0; }
+    };
+
+    /** Returns the number of hits and misses since the cache or its statistics were
+        last reset, and the number of glyphs that it currently holds.
+    */
+    Statistics getStatistics() const
+    {
+        Statistics result;
+
+        for (auto& shard : shards)
+        {
+            const ScopedLock sl (shard.lock);
+            result.hits += shard.hits;
+            result.misses += shard.misses;
+            result.numGlyphs += shard.glyphs.size();
+        }
+
+        return result;
+    }
+
+    /** Sets the hit and miss counts back to zero. */
+    void resetStatistics()
+    {
+        for (auto& shard : shards)
+        {
+            const ScopedLock sl (shard.lock);
+            shard.hits = 0;
+            shard.misses = 0;
+        }
+    }
+
+    /** Changes the number of glyphs that the cache can hold, discarding the least
+        recently used ones if it now holds too many.
+
+        The cache may briefly hold more than this if every glyph it has is being
+        drawn at the same time.
+    */
+    void setMaxNumGlyphs (int newMaxNumGlyphs)
+    {
+        maxNumGlyphsPerShard = jmax (1, (newMaxNumGlyphs + numShards - 1) / numShards);
+
+        for (auto& shard : shards)
+        {
+            const ScopedLock sl (shard.lock);
+
+            while (shard.glyphs.size() > maxNumGlyphsPerShard)
+            {
+                auto* g = findLeastRecentlyUsedGlyph (shard);
+
+                if (g == nullptr)
+                    break;
+
+                removeFromIndex (shard, *g);
+                shard.glyphs.removeObject (g);
+            }
+        }
+    }
+
+    /** Returns the number of glyphs that the cache can hold. */
+    int getMaxNumGlyphs() const noexcept        { return maxNumGlyphsPerShard * numShards; }
+
     //==============================================================================
     void reset()
     {
-        const ScopedLock sl (lock);
-        glyphs.clear();
-        addNewGlyphSlots (120);
-        hits = 0;
-        misses = 0;
+        for (auto& shard : shards)
+        {
+            const ScopedLock sl (shard.lock);
+            shard.glyphs.clear();
+            shard.index.clear();
+            shard.hits = 0;
+            shard.misses = 0;
+        }
     }
 
     void drawGlyph (RenderTargetType& target, const Font& font, const int glyphNumber, Point<float> pos)
     {
         if (auto glyph = findOrCreateGlyph (font, glyphNumber))
-        {
-            glyph->lastAccessCount = ++accessCounter;
             glyph->draw (target, pos);
-        }
     }
 
     ReferenceCountedObjectPtr<CachedGlyphType> findOrCreateGlyph (const Font& font, int glyphNumber)
     {
-        const ScopedLock sl (lock);
+        const auto hash = getGlyphHash (font, glyphNumber);
+        auto& shard = shards[hash % (size_t) numShards];
+
+        {
+            const ScopedLock sl (shard.lock);
+
+            if (auto g = findExistingGlyph (shard, hash, font, glyphNumber))
+            {
+                ++shard.hits;
+                g->lastAccessCount = ++accessCounter;
+                return g;
+            }
+
+            ++shard.misses;
+        }
+
+        // Generating a glyph can be slow, so it's done without holding the shard's lock, which
+        // lets other threads carry on finding glyphs that are already cached. If another
+        // thread has added the same glyph in the meantime, that one is used instead.
+        ReferenceCountedObjectPtr<CachedGlyphType> newGlyph (new CachedGlyphType());
+
+        {
+            const ScopedLock generationSl (getGlyphGenerationLock());
+            newGlyph->generate (font, glyphNumber);
+        }
 
-        if (auto g = findExistingGlyph (font, glyphNumber))
+        const ScopedLock sl (shard.lock);
+
+        if (auto g = findExistingGlyph (shard, hash, font, glyphNumber))
         {
-            ++hits;
+            g->lastAccessCount = ++accessCounter;
             return g;
         }
 
-        ++misses;
-        auto g = getGlyphForReuse();
-        jassert (g != nullptr);
-        g->generate (font, glyphNumber);
-        return g;
+        newGlyph->lastAccessCount = ++accessCounter;
+        makeRoomForGlyph (shard);
+        shard.glyphs.add (newGlyph);
+        shard.index.emplace (hash, newGlyph.get());
+        return newGlyph;
     }
 
 private:
-    ReferenceCountedArray<CachedGlyphType> glyphs;
-    Atomic<int> accessCounter, hits, misses;
-    CriticalSection lock;
+    static constexpr int numShards = 16;
 
-    ReferenceCountedObjectPtr<CachedGlyphType> findExistingGlyph (const Font& font, int glyphNumber) const noexcept
+    struct Shard
     {
-        for (auto g : glyphs)
-            if (g->glyph == glyphNumber && g->font == font)
-                return *g;
+        CriticalSection lock;
+        ReferenceCountedArray<CachedGlyphType> glyphs;
+        std::unordered_multimap<size_t, CachedGlyphType*> index;
+        int64 hits = 0, misses = 0;
+    };
 
-        return {};
+    std::array<Shard, numShards> shards;
+    std::atomic<int> maxNumGlyphsPerShard { 2048 / numShards };
+    Atomic<int> accessCounter;
+
+    // This must give the same result for any two fonts that compare as equal
+    static size_t getGlyphHash (const Font& font, int glyphNumber) noexcept
+    {
+        auto hash = (size_t) font.getTypefaceName().hashCode64();
+        hash = hash * 101 + (size_t) font.getTypefaceStyle().hashCode64();
+        hash = hash * 101 + std::hash<float>() (font.getHeight());
+        hash = hash * 101 + std::hash<float>() (font.getHorizontalScale());
+        hash = hash * 101 + std::hash<float>() (font.getExtraKerningFactor());
+        hash = hash * 101 + (size_t) font.isUnderlined();
+        return hash * 101 + (size_t) glyphNumber;
     }
 
-    ReferenceCountedObjectPtr<CachedGlyphType> getGlyphForReuse()
+    static ReferenceCountedObjectPtr<CachedGlyphType> findExistingGlyph (const Shard& shard, size_t hash,
+                                                                         const Font& font, int glyphNumber) noexcept
     {
-        if (hits.get() + misses.get() > glyphs.size() * 16)
-        {
-            if (misses.get() * 2 > hits.get())
-                addNewGlyphSlots (32);
+        for (auto [i, end] = shard.index.equal_range (hash); i != end; ++i)
+            if (i->second->glyph == glyphNumber && i->second->font == font)
+                return i->second;
 
-            hits = 0;
-            misses = 0;
-        }
+        return {};
+    }
 
-        if (auto g = findLeastRecentlyUsedGlyph())
-            return *g;
+    void makeRoomForGlyph (Shard& shard)
+    {
+        if (shard.glyphs.size() < maxNumGlyphsPerShard)
+            return;
 
-        addNewGlyphSlots (32);
-        return glyphs.getLast();
+        // if every glyph in this shard is being drawn, the cache has to grow
+        if (auto* g = findLeastRecentlyUsedGlyph (shard))
+        {
+            removeFromIndex (shard, *g);
+            shard.glyphs.removeObject (g);
+        }
     }
 
-    void addNewGlyphSlots (int num)
+    static void removeFromIndex (Shard& shard, CachedGlyphType& glyph)
     {
-        glyphs.ensureStorageAllocated (glyphs.size() + num);
-
-        while (--num >= 0)
-            glyphs.add (new CachedGlyphType());
+        for (auto [i, end] = shard.index.equal_range (getGlyphHash (glyph.font, glyph.glyph)); i != end; ++i)
+        {
+            if (i->second == &glyph)
+            {
+                shard.index.erase (i);
+                return;
+            }
+        }
     }
 
-    CachedGlyphType* findLeastRecentlyUsedGlyph() const noexcept
+    static CachedGlyphType* findLeastRecentlyUsedGlyph (const Shard& shard) noexcept
     {
         CachedGlyphType* oldest = nullptr;
         auto oldestCounter = std::numeric_limits<int>::max();
 
-        for (auto* g : glyphs)
+        for (auto* g : shard.glyphs)
         {
             if (g->lastAccessCount <= oldestCounter
                  && g->getReferenceCount() == 1)
@@ -554,6 +693,62 @@ namespace GradientPixelIterators
     };
 }
 
+//==============================================================================
+/** Functions that blend whole spans of contiguous pixels at once.
+
+    Each of these gives exactly the same results as calling the equivalent blend()
+    method on every pixel, but the common combinations of pixel formats use SIMD
+    instructions (SSE2 or AVX2, chosen at runtime) to process many pixels at a time
+    on Intel CPUs. There are no NEON versions yet, so ARM CPUs blend one pixel at a
+    time.
+*/
+namespace PixelSpans
+{
+    /** Blends a colour onto each pixel of a span. */
+    JUCE_API void blendSolid (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept;
+    /** Blends a colour onto each pixel of a span. */
+    JUCE_API void blendSolid (PixelRGB* dest, PixelARGB colour, int numPixels) noexcept;
+    /** Blends a colour onto each pixel of a span. */
+    JUCE_API void blendSolid (PixelAlpha* dest, PixelARGB colour, int numPixels) noexcept;
+
+    /** Blends each pixel of a source span onto the corresponding destination pixel. */
+    JUCE_API void blend (PixelARGB* dest, const PixelARGB* src, int numPixels) noexcept;
+    /** Blends each pixel of a source span onto the corresponding destination pixel. */
+    JUCE_API void blend (PixelAlpha* dest, const PixelARGB* src, int numPixels) noexcept;
+
+    /** Blends each pixel of a source span onto the corresponding destination pixel,
+        applying an extra opacity in the same way as the pixel classes' blend() methods.
+    */
+    JUCE_API void blend (PixelARGB* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept;
+    /** Blends each pixel of a source span onto the corresponding destination pixel,
+        applying an extra opacity in the same way as the pixel classes' blend() methods.
+    */
+    JUCE_API void blend (PixelAlpha* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept;
+
+    /** Blends each pixel of a source span onto the corresponding destination pixel,
+        for combinations of pixel formats without a vectorised version.
+    */
+    template <class DestPixelType, class SrcPixelType>
+    void blend (DestPixelType* dest, const SrcPixelType* src, int numPixels) noexcept
+    {
+        for (int i = 0; i < numPixels; ++i)
+            dest[i].blend (src[i]);
+    }
+
+    /** Blends each pixel of a source span onto the corresponding destination pixel with
+        an extra opacity, for combinations of pixel formats without a vectorised version.
+    */
+    template <class DestPixelType, class SrcPixelType>
+    void blend (DestPixelType* dest, const SrcPixelType* src, int numPixels, uint32 extraAlpha) noexcept
+    {
+        for (int i = 0; i < numPixels; ++i)
+            dest[i].blend (src[i], extraAlpha);
+    }
+
+    /** Spans shorter than this are quicker to blend one pixel at a time. */
+    constexpr int minimumSpanLength = 8;
+}
+
 #define JUCE_PERFORM_PIXEL_OP_LOOP(op) \
 { \
     const int destStride = destData.pixelStride;  \
@@ -666,7 +861,10 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
         {
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+            if (width >= PixelSpans::minimumSpanLength && (size_t) destData.pixelStride == sizeof (PixelType))
+                PixelSpans::blendSolid (dest, colour, width);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
         forcedinline void replaceLine (PixelRGB* dest, PixelARGB colour, int width) const noexcept
@@ -725,7 +923,9 @@ namespace EdgeTableFillers
         {
             auto* dest = getPixel (x);
 
-            if (alphaLevel < 0xff)
+            if (width >= PixelSpans::minimumSpanLength && (size_t) destData.pixelStride == sizeof (PixelType))
+                blendSpan (dest, x, width, (uint32) alphaLevel);
+            else if (alphaLevel < 0xff)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
             else
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
@@ -734,7 +934,11 @@ namespace EdgeTableFillers
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             auto* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+
+            if (width >= PixelSpans::minimumSpanLength && (size_t) destData.pixelStride == sizeof (PixelType))
+                blendSpan (dest, x, width, 0xff);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
         void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
@@ -764,6 +968,28 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        // Looks up the colours a chunk at a time, so that they can be blended together
+        void blendSpan (PixelType* dest, int x, int width, uint32 alphaLevel) const noexcept
+        {
+            PixelARGB colours[64];
+
+            while (width > 0)
+            {
+                const auto num = jmin (width, (int) numElementsInArray (colours));
+
+                for (int i = 0; i < num; ++i)
+                    colours[i] = GradientType::getPixel (x++);
+
+                if (alphaLevel < 0xff)
+                    PixelSpans::blend (dest, colours, num, alphaLevel);
+                else
+                    PixelSpans::blend (dest, colours, num);
+
+                dest += num;
+                width -= num;
+            }
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -825,7 +1051,12 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                {
+                    if (canBlendSpans (width))
+                        PixelSpans::blend (dest, getSrcPixel (x), width, (uint32) alphaLevel);
+                    else
+                        JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                }
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -848,7 +1079,12 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                {
+                    if (canBlendSpans (width))
+                        PixelSpans::blend (dest, getSrcPixel (x), width, (uint32) extraAlpha);
+                    else
+                        JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                }
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -901,6 +1137,13 @@ namespace EdgeTableFillers
             return addBytesToPointer (sourceLineStart, x * srcData.pixelStride);
         }
 
+        forcedinline bool canBlendSpans (int width) const noexcept
+        {
+            return width >= PixelSpans::minimumSpanLength
+                && (size_t) destData.pixelStride == sizeof (DestPixelType)
+                && (size_t) srcData.pixelStride  == sizeof (SrcPixelType);
+        }
+
         forcedinline void copyRow (DestPixelType* dest, SrcPixelType const* src, int width) const noexcept
         {
             auto destStride = destData.pixelStride;
@@ -912,6 +1155,10 @@ namespace EdgeTableFillers
             {
                 memcpy ((void*) dest, src, (size_t) (width * srcStride));
             }
+            else if (canBlendSpans (width))
+            {
+                PixelSpans::blend (dest, src, width);
+            }
             else
             {
                 do
@@ -983,7 +1230,14 @@ namespace EdgeTableFillers
             alphaLevel *= extraAlpha;
             alphaLevel >>= 8;
 
-            if (alphaLevel < 0xfe)
+            if (width >= PixelSpans::minimumSpanLength && (size_t) destData.pixelStride == sizeof (DestPixelType))
+            {
+                if (alphaLevel < 0xfe)
+                    PixelSpans::blend (dest, span, width, (uint32) alphaLevel);
+                else
+                    PixelSpans::blend (dest, span, width);
+            }
+            else if (alphaLevel < 0xfe)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
             else
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++))
@@ -2324,13 +2578,56 @@ public:
         if (clip != nullptr)
         {
             auto trans = transform.getTransformWith (t);
-            auto clipRect = clip->getClipBounds();
+            auto clipRect = clip->getClipBounds().getIntersection (getThis().getMaximumBounds());
 
             if (path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
                 fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
         }
     }
 
+    void fillPathWithCache (const Path& path, const AffineTransform& t, detail::PathCache& cache)
+    {
+        if (clip != nullptr)
+        {
+            auto trans = transform.getTransformWith (t);
+
+            // The cached shape covers the whole path rather than just the clip region, so that it
+            // can still be used when the clip changes. The extra pixel stops the right-hand edge
+            // being clamped.
+            auto area = path.getBoundsTransformed (trans).getSmallestIntegerContainer().expanded (1)
+                            .getIntersection (getThis().getMaximumBounds());
+
+            if (area.intersects (clip->getClipBounds()))
+                fillShape (getCachedShape (path, trans, area, cache), false);
+        }
+    }
+
+    // If the path was last flattened with the same transform, apart from being moved by a whole
+    // number of pixels, its shape can just be moved too
+    static typename BaseRegionType::Ptr getCachedShape (const Path& path, const AffineTransform& trans, Rectangle<int> area,
+                                                        detail::PathCache& cache)
+    {
+        if (cache.edgeTable.has_value()
+             && trans.withAbsoluteTranslation (0, 0) == cache.transform.withAbsoluteTranslation (0, 0))
+        {
+            const auto dx = trans.getTranslationX() - cache.transform.getTranslationX();
+            const auto dy = trans.getTranslationY() - cache.transform.getTranslationY();
+            const auto offset = Point<float> (dx, dy).roundToInt();
+
+            if (exactlyEqual (dx, (float) offset.x) && exactlyEqual (dy, (float) offset.y)
+                 && (cache.edgeTable->getMaximumBounds() + offset).contains (area))
+            {
+                auto* shape = new EdgeTableRegionType (*cache.edgeTable);
+                shape->edgeTable.translate ((float) offset.x, offset.y);
+                return *shape;
+            }
+        }
+
+        cache.edgeTable.emplace (area, path, trans);
+        cache.transform = trans;
+        return *new EdgeTableRegionType (*cache.edgeTable);
+    }
+
     void fillEdgeTable (const EdgeTable& edgeTable, float x, int y)
     {
         if (clip != nullptr)
@@ -2417,9 +2714,10 @@ public:
                 Path p;
                 p.addRectangle (sourceImage.getBounds());
 
-                if (auto c = clip->clone()->clipToPath (p, t))
-                    c->renderImageTransformed (getThis(), sourceImage, alpha,
-                                               t, interpolationQuality, false);
+                if (auto c = clip->clone()->clipToRectangle (getThis().getMaximumBounds()))
+                    if (auto c2 = c->clipToPath (p, t))
+                        c2->renderImageTransformed (getThis(), sourceImage, alpha,
+                                                    t, interpolationQuality, false);
             }
         }
     }
@@ -2427,7 +2725,16 @@ public:
     void fillShape (typename BaseRegionType::Ptr shapeToFill, bool replaceContents)
     {
         jassert (clip != nullptr);
-        shapeToFill = clip->applyClipTo (shapeToFill);
+
+        // Trimming the shape first means that only the rows that can be drawn on get clipped
+        // and filled, when the state only draws on some of the image
+        const auto maximumBounds = getThis().getMaximumBounds();
+
+        if (! maximumBounds.contains (shapeToFill->getClipBounds()))
+            shapeToFill = shapeToFill->clipToRectangle (maximumBounds);
+
+        if (shapeToFill != nullptr)
+            shapeToFill = clip->applyClipTo (shapeToFill);
 
         if (shapeToFill != nullptr)
         {
@@ -2475,6 +2782,63 @@ public:
     float transparencyLayerAlpha;
 };
 
+//==============================================================================
+/** Wraps an edge-table iterator, only passing on the parts of it that lie within a
+    range of rows.
+
+    @tags{Graphics}
+*/
+template <class IteratorType>
+struct RowRangeIterator
+{
+    template <class Renderer>
+    struct RowFilter
+    {
+        forcedinline void setEdgeTableYPos (int y) noexcept
+        {
+            isInRange = rows.contains (y);
+
+            if (isInRange)
+                renderer.setEdgeTableYPos (y);
+        }
+
+        forcedinline void handleEdgeTablePixel (int x, int alphaLevel) noexcept         { if (isInRange) renderer.handleEdgeTablePixel (x, alphaLevel); }
+        forcedinline void handleEdgeTablePixelFull (int x) noexcept                     { if (isInRange) renderer.handleEdgeTablePixelFull (x); }
+        forcedinline void handleEdgeTableLine (int x, int width, int alphaLevel) noexcept   { if (isInRange) renderer.handleEdgeTableLine (x, width, alphaLevel); }
+        forcedinline void handleEdgeTableLineFull (int x, int width) noexcept           { if (isInRange) renderer.handleEdgeTableLineFull (x, width); }
+
+        void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
+        {
+            const auto clipped = rows.getIntersectionWith ({ y, y + height });
+
+            if (! clipped.isEmpty())
+                renderer.handleEdgeTableRectangle (x, clipped.getStart(), width, clipped.getLength(), alphaLevel);
+        }
+
+        void handleEdgeTableRectangleFull (int x, int y, int width, int height) noexcept
+        {
+            const auto clipped = rows.getIntersectionWith ({ y, y + height });
+
+            if (! clipped.isEmpty())
+                renderer.handleEdgeTableRectangleFull (x, clipped.getStart(), width, clipped.getLength());
+        }
+
+        Renderer& renderer;
+        const Range<int> rows;
+        bool isInRange = false;
+    };
+
+    template <class Renderer>
+    void iterate (Renderer& r) const noexcept
+    {
+        RowFilter<Renderer> filter { r, rows };
+        iterator.iterate (filter);
+    }
+
+    const IteratorType& iterator;
+    const Range<int> rows;
+};
+
 //==============================================================================
 class SoftwareRendererSavedState  : public SavedStateBase<SoftwareRendererSavedState>
 {
@@ -2501,8 +2865,16 @@ public:
         {
             auto layerBounds = clip->getClipBounds();
 
-            s->image = Image (Image::ARGB, layerBounds.getWidth(), layerBounds.getHeight(), true);
+            s->image = Image (Image::ARGB, layerBounds.getWidth(), layerBounds.getHeight(), ! rowsToRender.has_value());
             s->transparencyLayerAlpha = opacity;
+
+            if (rowsToRender.has_value())
+            {
+                // the other rows of the layer are never touched, so there's no need to clear them
+                s->rowsToRender = *rowsToRender - layerBounds.getY();
+                s->image.clear ({ 0, s->rowsToRender->getStart(), layerBounds.getWidth(), s->rowsToRender->getLength() });
+            }
+
             s->transform.moveOriginInDeviceSpace (-layerBounds.getPosition());
             s->cloneClipIfMultiplyReferenced();
             s->clip->translate (-layerBounds.getPosition());
@@ -2518,6 +2890,10 @@ public:
             auto layerBounds = clip->getClipBounds();
 
             auto g = image.createLowLevelContext();
+
+            if (rowsToRender.has_value())
+                g->clipToRectangle ({ layerBounds.getX(), rowsToRender->getStart(), layerBounds.getWidth(), rowsToRender->getLength() });
+
             g->setOpacity (finishedLayerState.transparencyLayerAlpha);
             g->drawImage (finishedLayerState.image, AffineTransform::translation (layerBounds.getPosition()));
         }
@@ -2566,7 +2942,12 @@ public:
                 auto t = transform.getTransformWith (AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight)
                                                                      .followedBy (trans));
 
-                std::unique_ptr<EdgeTable> et (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
+                std::unique_ptr<EdgeTable> et;
+
+                {
+                    const ScopedLock sl (getGlyphGenerationLock());
+                    et.reset (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
+                }
 
                 if (et != nullptr)
                     fillShape (*new EdgeTableRegionType (*et), false);
@@ -2574,7 +2955,15 @@ public:
         }
     }
 
-    Rectangle<int> getMaximumBounds() const     { return image.getBounds(); }
+    Rectangle<int> getMaximumBounds() const
+    {
+        auto bounds = image.getBounds();
+
+        if (rowsToRender.has_value())
+            bounds.setVerticalRange (bounds.getVerticalRange().getIntersectionWith (*rowsToRender));
+
+        return bounds;
+    }
 
     //==============================================================================
     template <typename IteratorType>
@@ -2582,7 +2971,11 @@ public:
     {
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
         const Image::BitmapData srcData (src, Image::BitmapData::readOnly);
-        EdgeTableFillers::renderImageTransformed (iter, destData, srcData, alpha, trans, quality, tiledFill);
+
+        renderRows (iter, [&] (auto& rows)
+        {
+            EdgeTableFillers::renderImageTransformed (rows, destData, srcData, alpha, trans, quality, tiledFill);
+        });
     }
 
     template <typename IteratorType>
@@ -2590,7 +2983,11 @@ public:
     {
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
         const Image::BitmapData srcData (src, Image::BitmapData::readOnly);
-        EdgeTableFillers::renderImageUntransformed (iter, destData, srcData, alpha, x, y, tiledFill);
+
+        renderRows (iter, [&] (auto& rows)
+        {
+            EdgeTableFillers::renderImageUntransformed (rows, destData, srcData, alpha, x, y, tiledFill);
+        });
     }
 
     template <typename IteratorType>
@@ -2598,14 +2995,17 @@ public:
     {
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
 
-        switch (destData.pixelFormat)
+        renderRows (iter, [&] (auto& rows)
         {
-            case Image::ARGB:   EdgeTableFillers::renderSolidFill (iter, destData, colour, replaceContents, (PixelARGB*) nullptr); break;
-            case Image::RGB:    EdgeTableFillers::renderSolidFill (iter, destData, colour, replaceContents, (PixelRGB*) nullptr); break;
-            case Image::SingleChannel:
-            case Image::UnknownFormat:
-            default:            EdgeTableFillers::renderSolidFill (iter, destData, colour, replaceContents, (PixelAlpha*) nullptr); break;
-        }
+            switch (destData.pixelFormat)
+            {
+                case Image::ARGB:   EdgeTableFillers::renderSolidFill (rows, destData, colour, replaceContents, (PixelARGB*) nullptr); break;
+                case Image::RGB:    EdgeTableFillers::renderSolidFill (rows, destData, colour, replaceContents, (PixelRGB*) nullptr); break;
+                case Image::SingleChannel:
+                case Image::UnknownFormat:
+                default:            EdgeTableFillers::renderSolidFill (rows, destData, colour, replaceContents, (PixelAlpha*) nullptr); break;
+            }
+        });
     }
 
     template <typename IteratorType>
@@ -2617,21 +3017,45 @@ public:
 
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
 
-        switch (destData.pixelFormat)
+        renderRows (iter, [&] (auto& rows)
         {
-            case Image::ARGB:   EdgeTableFillers::renderGradient (iter, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelARGB*) nullptr); break;
-            case Image::RGB:    EdgeTableFillers::renderGradient (iter, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelRGB*) nullptr); break;
-            case Image::SingleChannel:
-            case Image::UnknownFormat:
-            default:            EdgeTableFillers::renderGradient (iter, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelAlpha*) nullptr); break;
-        }
+            switch (destData.pixelFormat)
+            {
+                case Image::ARGB:   EdgeTableFillers::renderGradient (rows, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelARGB*) nullptr); break;
+                case Image::RGB:    EdgeTableFillers::renderGradient (rows, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelRGB*) nullptr); break;
+                case Image::SingleChannel:
+                case Image::UnknownFormat:
+                default:            EdgeTableFillers::renderGradient (rows, destData, gradient, trans, lookupTable, numLookupEntries, isIdentity, (PixelAlpha*) nullptr); break;
+            }
+        });
     }
 
     //==============================================================================
     Image image;
     Font font;
 
+    /** If this is set, only these rows of the image are drawn on, although everything else
+        is worked out in the same way as for the whole image. This lets several renderers
+        share the work of drawing one image, and get exactly the same results as one
+        renderer would.
+    */
+    std::optional<Range<int>> rowsToRender;
+
 private:
+    template <typename IteratorType, typename RenderFn>
+    void renderRows (IteratorType& iter, RenderFn&& render) const
+    {
+        if (rowsToRender.has_value())
+        {
+            RowRangeIterator<IteratorType> rows { iter, *rowsToRender };
+            render (rows);
+        }
+        else
+        {
+            render (iter);
+        }
+    }
+
     SoftwareRendererSavedState& operator= (const SoftwareRendererSavedState&) = delete;
 };
 
@@ -2731,6 +3155,9 @@ protected:
     StackBasedLowLevelGraphicsContext() = default;
 
     RenderingHelpers::SavedStateStack<SavedStateType> stack;
+
+private:
+    void fillPathWithCache (const Path& path, const AffineTransform& t, detail::PathCache& cache) override   { stack->fillPathWithCache (path, t, cache); }
 };
 
 JUCE_END_IGNORE_WARNINGS_MSVC
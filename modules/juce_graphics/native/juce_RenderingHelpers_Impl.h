@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  This file is included by juce_RenderingHelpers.cpp once for each instruction set that the
+    span blending functions can use. Each time, the surrounding namespace provides an Ops struct
+    which wraps that instruction set's integer operations on a register of bytes, and on the
+    16-bit words that half a register of bytes expands to.
+
+    Every kernel processes as many whole registers as it can, and returns the number of pixels
+    or bytes that it processed, leaving the rest for the caller.
+*/
+
+    using Bytes = Ops::Bytes;
+    using Words = Ops::Words;
+
+    // Does the same as PixelARGB::blend() on the expanded components of some pixels
+    static forcedinline Words blendWords (Words src, Words dest) noexcept
+    {
+        const auto inverseAlpha = Ops::sub (Ops::splat16 (256), Ops::broadcastAlpha (src));
+        return Ops::add (src, Ops::shr8 (Ops::mul (dest, inverseAlpha)));
+    }
+
+    // Blends a repeating pattern of premultiplied bytes which all have the same alpha, which is
+    // how PixelARGB, PixelRGB and PixelAlpha all blend a single colour
+    static int blendSolidBytes (uint8* dest, const uint8* pattern, int patternSize,
+                                uint16 inverseAlpha, int numBytes) noexcept
+    {
+        jassert (patternSize % Ops::numBytes == 0);
+
+        const auto inverse = Ops::splat16 (inverseAlpha);
+        int i = 0;
+
+        for (; i + Ops::numBytes <= numBytes; i += Ops::numBytes)
+        {
+            const auto p = Ops::load (pattern + i % patternSize);
+            const auto d = Ops::load (dest + i);
+
+            Ops::store (dest + i, Ops::pack (Ops::add (Ops::lowWords (p),  Ops::shr8 (Ops::mul (Ops::lowWords (d),  inverse))),
+                                             Ops::add (Ops::highWords (p), Ops::shr8 (Ops::mul (Ops::highWords (d), inverse)))));
+        }
+
+        return i;
+    }
+
+    template <bool applyExtraAlpha>
+    static int blendARGB (uint8* dest, const uint8* src, int numPixels, uint16 extraAlpha) noexcept
+    {
+        constexpr int pixelsPerRegister = Ops::numBytes / 4;
+        const auto extra = Ops::splat16 (extraAlpha);
+        int i = 0;
+
+        for (; i + pixelsPerRegister <= numPixels; i += pixelsPerRegister)
+        {
+            const auto s = Ops::load (src  + i * 4);
+            const auto d = Ops::load (dest + i * 4);
+
+            auto sLow  = Ops::lowWords (s);
+            auto sHigh = Ops::highWords (s);
+
+            if (applyExtraAlpha)
+            {
+                sLow  = Ops::shr8 (Ops::mul (sLow,  extra));
+                sHigh = Ops::shr8 (Ops::mul (sHigh, extra));
+            }
+
+            Ops::store (dest + i * 4, Ops::pack (blendWords (sLow,  Ops::lowWords (d)),
+                                                 blendWords (sHigh, Ops::highWords (d))));
+        }
+
+        return i;
+    }
+
+    // Does the same as PixelAlpha::blend() with a PixelARGB source, whose extraAlpha is one
+    // higher than the one that PixelARGB::blend() takes
+    template <bool applyExtraAlpha>
+    static int blendAlphaFromARGB (uint8* dest, const uint8* src, int numPixels, uint16 extraAlpha) noexcept
+    {
+        const auto extra = Ops::splat16 (extraAlpha);
+        const auto full  = Ops::splat16 (256);
+        int i = 0;
+
+        for (; i + Ops::numBytes <= numPixels; i += Ops::numBytes)
+        {
+            const auto s = Ops::loadAlphas (src + i * 4);
+            const auto d = Ops::load (dest + i);
+
+            auto sLow  = Ops::lowWords (s);
+            auto sHigh = Ops::highWords (s);
+
+            if (applyExtraAlpha)
+            {
+                sLow  = Ops::shr8 (Ops::mul (sLow,  extra));
+                sHigh = Ops::shr8 (Ops::mul (sHigh, extra));
+            }
+
+            Ops::store (dest + i, Ops::pack (Ops::add (sLow,  Ops::shr8 (Ops::mul (Ops::lowWords (d),  Ops::sub (full, sLow)))),
+                                             Ops::add (sHigh, Ops::shr8 (Ops::mul (Ops::highWords (d), Ops::sub (full, sHigh))))));
+        }
+
+        return i;
+    }
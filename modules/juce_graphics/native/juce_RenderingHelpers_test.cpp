@@ -0,0 +1,346 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct GlyphCacheUnitTest final : public UnitTest
+{
+    GlyphCacheUnitTest() : UnitTest ("GlyphCache", UnitTestCategories::graphics) {}
+
+    // Stands in for a real glyph type, so that the tests don't depend on any fonts being installed
+    struct TestGlyph final : public ReferenceCountedObject
+    {
+        void draw (int& numDrawn, Point<float>) const   { ++numDrawn; }
+        void generate (const Font& newFont, int glyphNumber)  { font = newFont; glyph = glyphNumber; }
+
+        Font font;
+        int glyph = 0, lastAccessCount = 0;
+    };
+
+    using Cache = RenderingHelpers::GlyphCache<TestGlyph, int>;
+
+    static Array<Font> createFonts()
+    {
+        return { Font ("Test A", 12.0f, Font::plain),
+                 Font ("Test A", 13.0f, Font::plain),
+                 Font ("Test A", 12.0f, Font::bold),
+                 Font ("Test B", 12.0f, Font::plain),
+                 Font ("Test B", 12.0f, Font::plain).withHorizontalScale (0.8f) };
+    }
+
+    void runTest() override
+    {
+        const auto fonts = createFonts();
+
+        beginTest ("Glyphs are found again");
+        {
+            Cache cache;
+            auto first = cache.findOrCreateGlyph (fonts[0], 65);
+
+            expect (first->font == fonts[0]);
+            expectEquals (first->glyph, 65);
+            expect (cache.findOrCreateGlyph (Font ("Test A", 12.0f, Font::plain), 65) == first);
+
+            for (auto& font : fonts)
+                for (int glyph = 65; glyph < 70; ++glyph)
+                    cache.findOrCreateGlyph (font, glyph);
+
+            auto stats = cache.getStatistics();
+            expectEquals (stats.hits, (int64) 2);
+            expectEquals (stats.misses, (int64) fonts.size() * 5);
+            expectEquals (stats.numGlyphs, fonts.size() * 5);
+
+            int numDrawn = 0;
+            cache.drawGlyph (numDrawn, fonts[4], 66, {});
+            expectEquals (numDrawn, 1);
+            expectEquals (cache.getStatistics().hits, (int64) 3);
+
+            cache.resetStatistics();
+            expectEquals (cache.getStatistics().hits + cache.getStatistics().misses, (int64) 0);
+
+            cache.reset();
+            expectEquals (cache.getStatistics().numGlyphs, 0);
+        }
+
+        beginTest ("Capacity");
+        {
+            Cache cache;
+            cache.setMaxNumGlyphs (64);
+            expectEquals (cache.getMaxNumGlyphs(), 64);
+
+            auto held = cache.findOrCreateGlyph (fonts[0], 1);
+
+            for (int glyph = 0; glyph < 1000; ++glyph)
+                cache.findOrCreateGlyph (fonts[glyph % fonts.size()], glyph);
+
+            expect (cache.getStatistics().numGlyphs <= 64);
+            expect (cache.findOrCreateGlyph (fonts[0], 1) == held);
+            expectEquals (held->glyph, 1);
+
+            cache.setMaxNumGlyphs (16);
+            expect (cache.getStatistics().numGlyphs <= 16);
+
+            for (int glyph = 0; glyph < 100; ++glyph)
+            {
+                auto g = cache.findOrCreateGlyph (fonts[1], glyph);
+                expect (g->font == fonts[1] && g->glyph == glyph);
+            }
+        }
+
+        beginTest ("Concurrent lookups");
+        {
+            Cache cache;
+            cache.setMaxNumGlyphs (128);
+            std::atomic<int> numWrongGlyphs { 0 };
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < 4; ++t)
+            {
+                threads.emplace_back ([&, t]
+                {
+                    Random r (t);
+
+                    for (int i = 0; i < 20000; ++i)
+                    {
+                        const auto& font = fonts.getReference (r.nextInt (fonts.size()));
+                        const auto glyph = r.nextInt (64);
+                        auto g = cache.findOrCreateGlyph (font, glyph);
+
+                        if (g->glyph != glyph || ! (g->font == font))
+                            ++numWrongGlyphs;
+                    }
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+
+            expectEquals (numWrongGlyphs.load(), 0);
+            expectEquals (cache.getStatistics().hits + cache.getStatistics().misses, (int64) 80000);
+        }
+
+        beginTest ("Each glyph is only generated once");
+        {
+            Cache cache;
+            constexpr int numLookups = 20000;
+            Random r (1);
+
+            for (int i = 0; i < numLookups; ++i)
+                cache.findOrCreateGlyph (fonts.getReference (i % fonts.size()), 32 + r.nextInt (95));
+
+            const auto stats = cache.getStatistics();
+            expectEquals (stats.numGlyphs, fonts.size() * 95);
+            expectEquals (stats.misses, (int64) stats.numGlyphs);
+            expectEquals (stats.hits + stats.misses, (int64) numLookups);
+        }
+    }
+};
+
+static GlyphCacheUnitTest glyphCacheUnitTest;
+
+
+//==============================================================================
+struct PixelSpansUnitTest final : public UnitTest
+{
+    PixelSpansUnitTest() : UnitTest ("PixelSpans", UnitTestCategories::graphics) {}
+
+    static PixelARGB createPixel (Random& r)
+    {
+        // use a few fully opaque and fully transparent pixels too, as they're the edge cases
+        const auto alpha = (uint8) jlimit (0, 255, r.nextInt (300) - 20);
+        PixelARGB p (alpha, (uint8) r.nextInt (256), (uint8) r.nextInt (256), (uint8) r.nextInt (256));
+        p.premultiply();
+        return p;
+    }
+
+    template <class PixelType>
+    static std::vector<PixelType> createPixels (Random& r, int num)
+    {
+        std::vector<PixelType> pixels ((size_t) num);
+
+        for (auto& p : pixels)
+            p.set (createPixel (r));
+
+        return pixels;
+    }
+
+    template <class PixelType>
+    static bool areIdentical (const std::vector<PixelType>& a, const std::vector<PixelType>& b)
+    {
+        return a.size() == b.size() && memcmp (a.data(), b.data(), a.size() * sizeof (PixelType)) == 0;
+    }
+
+    // Compares a span function against the per-pixel blend() methods for lots of lengths and
+    // starting points, so that every combination of whole registers and leftover pixels is used
+    template <class DestPixelType, class SpanFn, class PixelFn>
+    bool matchesPixelByPixel (Random& r, SpanFn&& spanFn, PixelFn&& pixelFn)
+    {
+        for (int numPixels = 0; numPixels < 150; ++numPixels)
+        {
+            for (int offset = 0; offset < 4; ++offset)
+            {
+                const auto src = createPixels<PixelARGB> (r, numPixels + offset);
+                auto expected = createPixels<DestPixelType> (r, numPixels + offset);
+                auto actual = expected;
+
+                for (int i = offset; i < numPixels + offset; ++i)
+                    pixelFn (expected[(size_t) i], src[(size_t) i]);
+
+                spanFn (actual.data() + offset, src.data() + offset, numPixels);
+
+                if (! areIdentical (expected, actual))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <class DestPixelType>
+    void testPixelType (Random& r)
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            const auto colour = createPixel (r);
+
+            expect (matchesPixelByPixel<DestPixelType> (r,
+                        [&] (auto* dest, auto*, int num) { RenderingHelpers::PixelSpans::blendSolid (dest, colour, num); },
+                        [&] (auto& dest, auto&) { dest.blend (colour); }));
+
+            const auto extraAlpha = (uint32) r.nextInt (256);
+
+            expect (matchesPixelByPixel<DestPixelType> (r,
+                        [] (auto* dest, auto* src, int num) { RenderingHelpers::PixelSpans::blend (dest, src, num); },
+                        [] (auto& dest, auto& src) { dest.blend (src); }));
+
+            expect (matchesPixelByPixel<DestPixelType> (r,
+                        [&] (auto* dest, auto* src, int num) { RenderingHelpers::PixelSpans::blend (dest, src, num, extraAlpha); },
+                        [&] (auto& dest, auto& src) { dest.blend (src, extraAlpha); }));
+        }
+    }
+
+    static Image createRandomImage (Random& r, Image::PixelFormat format, int width)
+    {
+        Image image (format, width, 1, false, SoftwareImageType());
+
+        for (int x = 0; x < width; ++x)
+            image.setPixelAt (x, 0, Colour (createPixel (r).getUnpremultiplied()));
+
+        return image;
+    }
+
+    // Checks that a filler gives the same results for a whole line, which blends it as a span,
+    // as it does for a line of single pixels, which are each blended on their own
+    template <class CreateFiller>
+    bool lineMatchesSinglePixels (const Image& image, int alphaLevel, CreateFiller&& createFiller)
+    {
+        auto expected = image.createCopy();
+        auto actual = image.createCopy();
+
+        {
+            Image::BitmapData data (expected, Image::BitmapData::readWrite);
+            auto filler = createFiller (data);
+            filler.setEdgeTableYPos (0);
+
+            for (int x = 0; x < image.getWidth(); ++x)
+                filler.handleEdgeTableLine (x, 1, alphaLevel);
+        }
+
+        {
+            Image::BitmapData data (actual, Image::BitmapData::readWrite);
+            auto filler = createFiller (data);
+            filler.setEdgeTableYPos (0);
+            filler.handleEdgeTableLine (0, image.getWidth(), alphaLevel);
+        }
+
+        for (int x = 0; x < image.getWidth(); ++x)
+            if (expected.getPixelAt (x, 0) != actual.getPixelAt (x, 0))
+                return false;
+
+        return true;
+    }
+
+    template <class PixelType>
+    void testFillers (Random& r, Image::PixelFormat format)
+    {
+        using namespace RenderingHelpers;
+
+        constexpr int width = 77;
+        const auto image = createRandomImage (r, format, width);
+        const auto source = createRandomImage (r, Image::ARGB, width);
+        const Image::BitmapData sourceData (source, Image::BitmapData::readOnly);
+
+        const ColourGradient gradient (Colour (0xc0ff0000), 0.0f, 0.0f, Colour (0x400000ff), (float) width, 0.0f, false);
+        HeapBlock<PixelARGB> lookupTable;
+        const auto numLookupEntries = gradient.createLookupTable ({}, lookupTable);
+
+        for (auto alphaLevel : { 255, 200, 17 })
+        {
+            expect (lineMatchesSinglePixels (image, alphaLevel, [&] (const Image::BitmapData& data)
+            {
+                return EdgeTableFillers::SolidColour<PixelType> (data, PixelARGB (0x80, 0x40, 0x60, 0x10));
+            }));
+
+            expect (lineMatchesSinglePixels (image, alphaLevel, [&] (const Image::BitmapData& data)
+            {
+                return EdgeTableFillers::Gradient<PixelType, GradientPixelIterators::Linear> (data, gradient, {}, lookupTable, numLookupEntries);
+            }));
+
+            for (auto extraAlpha : { 255, 100 })
+            {
+                expect (lineMatchesSinglePixels (image, alphaLevel, [&] (const Image::BitmapData& data)
+                {
+                    return EdgeTableFillers::ImageFill<PixelType, PixelARGB, false> (data, sourceData, extraAlpha, 0, 0);
+                }));
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("ARGB spans match the per-pixel blends");
+        testPixelType<PixelARGB> (r);
+
+        beginTest ("RGB spans match the per-pixel blends");
+        testPixelType<PixelRGB> (r);
+
+        beginTest ("Alpha spans match the per-pixel blends");
+        testPixelType<PixelAlpha> (r);
+
+        beginTest ("Edge table fillers");
+        {
+            testFillers<PixelARGB> (r, Image::ARGB);
+            testFillers<PixelRGB> (r, Image::RGB);
+            testFillers<PixelAlpha> (r, Image::SingleChannel);
+        }
+    }
+};
+
+static PixelSpansUnitTest pixelSpansUnitTest;
+
+} // namespace juce
@@ -557,6 +557,103 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StandardCachedComponentImage)
 };
 
+//==============================================================================
+struct DisplayListCachedComponentImage final : public CachedComponentImage
+{
+    DisplayListCachedComponentImage (Component& c) noexcept : owner (c)  {}
+
+    void paint (Graphics& g) override
+    {
+        auto& lg = g.getInternalContext();
+        const auto scale = lg.getPhysicalPixelScaleFactor();
+        const auto compBounds = owner.getLocalBounds();
+
+        if (! exactlyEqual (scale, recordedScale))
+        {
+            recordings.clear();
+            recordedScale = scale;
+        }
+
+        RectangleList<int> invalidArea (compBounds);
+
+        for (auto* r : recordings)
+            invalidArea.subtract (r->validArea);
+
+        if (! invalidArea.isEmpty())
+        {
+            if (recordings.size() >= maxNumRecordings)
+            {
+                recordings.clear();
+                invalidArea = compBounds;
+            }
+
+            // Only the area that's been repainted is recorded again, whatever part of the
+            // component is being painted now, so that the recordings can be used for any part
+            // of it later
+            auto* r = recordings.add (new Recording());
+            r->validArea = invalidArea;
+
+            auto context = r->displayList.createRecordingContext (compBounds, scale);
+            context->clipToRectangleList (invalidArea);
+
+            Graphics recordingG (*context);
+            owner.paintEntireComponent (recordingG, false);
+        }
+
+        for (auto* r : recordings)
+        {
+            if (r->validArea.containsRectangle (compBounds))
+            {
+                r->displayList.replay (lg);
+            }
+            else
+            {
+                lg.saveState();
+
+                if (lg.clipToRectangleList (r->validArea))
+                    r->displayList.replay (lg);
+
+                lg.restoreState();
+            }
+        }
+    }
+
+    bool invalidateAll() override                            { recordings.clear(); return true; }
+    void releaseResources() override                         { recordings.clear(); }
+
+    bool invalidate (const Rectangle<int>& area) override
+    {
+        for (int i = recordings.size(); --i >= 0;)
+        {
+            auto& validArea = recordings.getUnchecked (i)->validArea;
+            validArea.subtract (area);
+
+            if (validArea.isEmpty())
+                recordings.remove (i);
+        }
+
+        return true;
+    }
+
+private:
+    // Each recording is only replayed over the part of the component that hasn't been
+    // repainted since it was made
+    struct Recording
+    {
+        GraphicsDisplayList displayList;
+        RectangleList<int> validArea;
+    };
+
+    // Once an area's been repainted this many times, the whole component is recorded again
+    static constexpr int maxNumRecordings = 8;
+
+    OwnedArray<Recording> recordings;
+    Component& owner;
+    float recordedScale = 1.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisplayListCachedComponentImage)
+};
+
 void Component::setCachedComponentImage (CachedComponentImage* newCachedImage)
 {
     if (cachedImage.get() != newCachedImage)
@@ -572,11 +669,12 @@ void Component::setBufferedToImage (bool shouldBeBuffered)
     // so by calling setBufferedToImage, you'll be deleting the custom one - this is almost certainly
     // not what you wanted to happen... If you really do know what you're doing here, and want to
     // avoid this assertion, just call setCachedComponentImage (nullptr) before setBufferedToImage().
-    jassert (cachedImage == nullptr || dynamic_cast<StandardCachedComponentImage*> (cachedImage.get()) != nullptr);
+    jassert (cachedImage == nullptr || dynamic_cast<StandardCachedComponentImage*> (cachedImage.get()) != nullptr
+                                    || dynamic_cast<DisplayListCachedComponentImage*> (cachedImage.get()) != nullptr);
 
     if (shouldBeBuffered)
     {
-        if (cachedImage == nullptr)
+        if (cachedImage == nullptr || dynamic_cast<DisplayListCachedComponentImage*> (cachedImage.get()) != nullptr)
             cachedImage.reset (new StandardCachedComponentImage (*this));
     }
     else
@@ -585,6 +683,25 @@ void Component::setBufferedToImage (bool shouldBeBuffered)
     }
 }
 
+void Component::setBufferedToDisplayList (bool shouldBeBuffered)
+{
+    // This assertion means that this component is already using a custom CachedComponentImage,
+    // so by calling setBufferedToDisplayList, you'll be deleting the custom one - see the
+    // comment in setBufferedToImage() for more details.
+    jassert (cachedImage == nullptr || dynamic_cast<StandardCachedComponentImage*> (cachedImage.get()) != nullptr
+                                    || dynamic_cast<DisplayListCachedComponentImage*> (cachedImage.get()) != nullptr);
+
+    if (shouldBeBuffered)
+    {
+        if (cachedImage == nullptr || dynamic_cast<StandardCachedComponentImage*> (cachedImage.get()) != nullptr)
+            cachedImage.reset (new DisplayListCachedComponentImage (*this));
+    }
+    else if (dynamic_cast<DisplayListCachedComponentImage*> (cachedImage.get()) != nullptr)
+    {
+        cachedImage.reset();
+    }
+}
+
 //==============================================================================
 void Component::reorderChildInternal (int sourceIndex, int destIndex)
 {
@@ -1064,10 +1064,33 @@ public:
         Parts of the buffer are invalidated when repaint() is called on this component
         or its children. The buffer is then repainted at the next paint() callback.
 
-        @see repaint, paint, createComponentSnapshot
+        @see repaint, paint, createComponentSnapshot, setBufferedToDisplayList
     */
     void setBufferedToImage (bool shouldBeBuffered);
 
+    /** Makes the component record its painting, so that it can be redrawn without
+        calling paint() again.
+
+        Setting this flag to true will cause the component to record the drawing done
+        by its paint() method and those of its child components in a GraphicsDisplayList,
+        and replay that when asked to redraw itself. Text doesn't have to be laid out again,
+        and the shapes of filled paths are kept, so this is much cheaper than painting.
+        Unlike setBufferedToImage(), it costs far less memory than an image of the
+        component, and the result is as sharp as painting at any scale.
+
+        When repaint() is called on this component or its children, the area being
+        repainted is recorded again at the next paint() callback, and the rest of the
+        component still replays what was recorded before. Buffering an image instead is
+        likely to be quicker for components that use drawing operations which have to be
+        done in full every time, such as large images or gradients.
+
+        Using this replaces any buffer set up by setBufferedToImage(), and vice versa.
+        A custom CachedComponentImage set with setCachedComponentImage() is left alone.
+
+        @see repaint, paint, setBufferedToImage, GraphicsDisplayList
+    */
+    void setBufferedToDisplayList (bool shouldBeBuffered);
+
     /** Generates a snapshot of part of this component.
 
         This will return a new Image, the size of the rectangle specified,
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+struct RepaintRegionHelpers
+{
+    RepaintRegionHelpers() = delete;
+
+    /*  Every rectangle that's painted separately has a cost on top of the cost of its pixels,
+        e.g. for blitting it to the screen and for clipping the drawing to it. This is roughly
+        how many pixels could be painted in the same time.
+    */
+    static constexpr int64 defaultCostPerRectangle = 4096;
+
+    /*  Beyond this many rectangles, merging them one pair at a time gets too slow, and
+        handling them separately will cost more than painting their bounds anyway.
+    */
+    static constexpr int maxRectanglesToMerge = 128;
+
+    static int64 getArea (Rectangle<int> r) noexcept
+    {
+        return (int64) r.getWidth() * (int64) r.getHeight();
+    }
+
+    /*  Returns a region that covers the given one, with rectangles merged together wherever
+        painting the extra pixels that their union adds costs less than painting them separately.
+
+        The result never has more rectangles than the original region.
+    */
+    static RectangleList<int> mergeForPainting (const RectangleList<int>& region,
+                                                int64 costPerRectangle = defaultCostPerRectangle)
+    {
+        if (region.getNumRectangles() > maxRectanglesToMerge)
+            return region.getBounds();
+
+        std::vector<Rectangle<int>> rects (region.begin(), region.end());
+
+        for (bool anyMerged = true; anyMerged;)
+        {
+            anyMerged = false;
+
+            for (size_t i = 0; i < rects.size(); ++i)
+            {
+                for (size_t j = i + 1; j < rects.size(); ++j)
+                {
+                    const auto combined = rects[i].getUnion (rects[j]);
+                    const auto extraArea = getArea (combined) - getArea (rects[i]) - getArea (rects[j])
+                                             + getArea (rects[i].getIntersection (rects[j]));
+
+                    if (extraArea < costPerRectangle)
+                    {
+                        rects[i] = combined;
+                        rects.erase (rects.begin() + (std::ptrdiff_t) j);
+
+                        // the grown rectangle needs checking against all the others again
+                        j = i;
+                        anyMerged = true;
+                    }
+                }
+            }
+        }
+
+        RectangleList<int> result;
+
+        for (auto& r : rects)
+            result.add (r);
+
+        result.consolidate();
+
+        // merged rectangles that overlap can be split into more pieces than the region had
+        // to begin with, in which case the merging hasn't saved anything
+        if (result.getNumRectangles() > region.getNumRectangles())
+            return region;
+
+        return result;
+    }
+};
+
+} // namespace juce::detail
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+struct RepaintRegionHelpersTest final : public UnitTest
+{
+    RepaintRegionHelpersTest()
+        : UnitTest ("RepaintRegionHelpers", UnitTestCategories::gui) {}
+
+    static bool covers (const RectangleList<int>& merged, const RectangleList<int>& original)
+    {
+        auto uncovered = original;
+        uncovered.subtract (merged);
+        return uncovered.isEmpty();
+    }
+
+    void runTest() override
+    {
+        using RRH = RepaintRegionHelpers;
+
+        beginTest ("Nearby rectangles are merged");
+        {
+            // a row of meters, each repainting its own small area
+            RectangleList<int> region;
+
+            for (int i = 0; i < 16; ++i)
+                region.add ({ 10 + i * 20, 50, 12, 100 });
+
+            const auto merged = RRH::mergeForPainting (region);
+            expectEquals (merged.getNumRectangles(), 1);
+            expect (merged.getBounds() == region.getBounds());
+        }
+
+        beginTest ("Distant rectangles are kept apart");
+        {
+            RectangleList<int> region;
+            region.add ({ 0, 0, 50, 50 });
+            region.add ({ 1000, 700, 50, 50 });
+
+            const auto merged = RRH::mergeForPainting (region);
+            expectEquals (merged.getNumRectangles(), 2);
+            expect (covers (merged, region));
+        }
+
+        beginTest ("The cost decides what's merged");
+        {
+            RectangleList<int> region;
+            region.add ({ 0, 0, 10, 10 });
+            region.add ({ 20, 0, 10, 10 });
+
+            // merging adds a 10x10 gap
+            expectEquals (RRH::mergeForPainting (region, 101).getNumRectangles(), 1);
+            expectEquals (RRH::mergeForPainting (region, 100).getNumRectangles(), 2);
+        }
+
+        beginTest ("Merged regions always cover the original");
+        {
+            // this seed produces regions whose merged rectangles overlap, which used to split
+            // into more rectangles than the original region had
+            Random r (0);
+
+            for (int i = 0; i < 50; ++i)
+            {
+                RectangleList<int> region;
+
+                for (int j = r.nextInt (40); --j >= 0;)
+                    region.add ({ r.nextInt (1500), r.nextInt (1000), 1 + r.nextInt (200), 1 + r.nextInt (200) });
+
+                const auto merged = RRH::mergeForPainting (region);
+
+                expect (covers (merged, region));
+                expect (merged.getBounds() == region.getBounds());
+                expectLessOrEqual (merged.getNumRectangles(), jmax (1, region.getNumRectangles()));
+            }
+        }
+
+        beginTest ("Very complex regions are painted as their bounds");
+        {
+            RectangleList<int> region;
+
+            for (int i = 0; i < RRH::maxRectanglesToMerge + 1; ++i)
+                region.add ({ i * 100, (i % 2) * 100, 10, 10 });
+
+            const auto merged = RRH::mergeForPainting (region);
+            expectEquals (merged.getNumRectangles(), 1);
+            expect (merged.getBounds() == region.getBounds());
+        }
+    }
+};
+
+static RepaintRegionHelpersTest repaintRegionHelpersTest;
+
+} // namespace juce::detail
@@ -124,6 +124,7 @@
 #include "detail/juce_ScopedContentSharerInterface.h"
 #include "detail/juce_ScopedContentSharerImpl.h"
 #include "detail/juce_WindowingHelpers.h"
+#include "detail/juce_RepaintRegionHelpers.h"
 #include "detail/juce_AlertWindowHelpers.h"
 #include "detail/juce_TopLevelWindowManager.h"
 
@@ -222,6 +223,7 @@
 
 #if JUCE_UNIT_TESTS
  #include "native/accessibility/juce_AccessibilityTextHelpers_test.cpp"
+ #include "detail/juce_RepaintRegionHelpers_test.cpp"
 #endif
 
 //==============================================================================
@@ -305,6 +305,17 @@ public:
             repainter->performAnyPendingRepaintsNow();
     }
 
+    RepaintStatistics getRepaintStatistics() const override
+    {
+        return repainter != nullptr ? repainter->getStatistics() : RepaintStatistics{};
+    }
+
+    void resetRepaintStatistics() override
+    {
+        if (repainter != nullptr)
+            repainter->resetStatistics();
+    }
+
     void setIcon (const Image& newIcon) override
     {
         XWindowSystem::getInstance()->setIcon (windowH, newIcon);
@@ -427,8 +438,14 @@ private:
                 return;
 
             if (! regionsNeedingRepaint.isEmpty())
+            {
                 performAnyPendingRepaintsNow();
-            else if (Time::getApproximateMillisecondCounter() > lastTimeImageUsed + 3000)
+                return;
+            }
+
+            ++statistics.numFramesSkipped;
+
+            if (Time::getApproximateMillisecondCounter() > lastTimeImageUsed + 3000)
                 image = Image();
         }
 
@@ -442,12 +459,15 @@ private:
             if (XWindowSystem::getInstance()->getNumPaintsPendingForWindow (peer.windowH) > 0)
                 return;
 
-            auto originalRepaintRegion = regionsNeedingRepaint;
+            // Lots of small areas that are close together, e.g. from many meters repainting
+            // themselves, are quicker to paint and blit as fewer, larger rectangles
+            auto regionToPaint = detail::RepaintRegionHelpers::mergeForPainting (regionsNeedingRepaint);
             regionsNeedingRepaint.clear();
-            auto totalArea = originalRepaintRegion.getBounds();
+            auto totalArea = regionToPaint.getBounds();
 
             if (! totalArea.isEmpty())
             {
+                const auto startTicks = Time::getHighResolutionTicks();
                 const auto wasImageNull = image.isNull();
 
                 if (wasImageNull || image.getWidth() < totalArea.getWidth()
@@ -474,11 +494,11 @@ private:
                     }
                 }
 
-                RectangleList<int> adjustedList (originalRepaintRegion);
+                RectangleList<int> adjustedList (regionToPaint);
                 adjustedList.offsetAll (-totalArea.getX(), -totalArea.getY());
 
                 if (XWindowSystem::getInstance()->canUseARGBImages())
-                    for (auto& i : originalRepaintRegion)
+                    for (auto& i : regionToPaint)
                         image.clear (i - totalArea.getPosition());
 
                 {
@@ -489,19 +509,41 @@ private:
                     peer.handlePaint (*context);
                 }
 
-                for (auto& i : originalRepaintRegion)
+                for (auto& i : regionToPaint)
                    XWindowSystem::getInstance()->blitToWindow (peer.windowH, image, i, totalArea);
+
+                addFrameToStatistics (regionToPaint, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks));
             }
 
             lastTimeImageUsed = Time::getApproximateMillisecondCounter();
         }
 
+        RepaintStatistics getStatistics() const noexcept    { return statistics; }
+        void resetStatistics() noexcept                     { statistics = {}; }
+
     private:
+        void addFrameToStatistics (const RectangleList<int>& paintedRegion, double seconds) noexcept
+        {
+            int64 numPixels = 0;
+
+            for (auto& r : paintedRegion)
+                numPixels += detail::RepaintRegionHelpers::getArea (r);
+
+            ++statistics.numFramesPainted;
+            statistics.lastNumRectangles = paintedRegion.getNumRectangles();
+            statistics.lastNumPixels = numPixels;
+            statistics.totalNumPixels += numPixels;
+            statistics.lastPaintSeconds = seconds;
+            statistics.maxPaintSeconds = jmax (statistics.maxPaintSeconds, seconds);
+            statistics.totalPaintSeconds += seconds;
+        }
+
         LinuxComponentPeer& peer;
         const bool isSemiTransparentWindow;
         Image image;
         uint32 lastTimeImageUsed = 0;
         RectangleList<int> regionsNeedingRepaint;
+        RepaintStatistics statistics;
 
         bool useARGBImagesForRendering = XWindowSystem::getInstance()->canUseARGBImages();
 
@@ -394,6 +394,42 @@ public:
     */
     virtual void performAnyPendingRepaintsNow() = 0;
 
+    /** Statistics about how a peer has been repainting its window.
+
+        A frame is one of the peer's chances to repaint, which are usually in time with
+        the display's refresh rate. Pixel counts are in physical pixels.
+
+        @see getRepaintStatistics
+    */
+    struct JUCE_API  RepaintStatistics
+    {
+        int64 numFramesPainted = 0;         /**< The number of frames in which something was repainted. */
+        int64 numFramesSkipped = 0;         /**< The number of frames in which nothing needed repainting. */
+        int lastNumRectangles = 0;          /**< The number of separate rectangles painted in the last frame. */
+        int64 lastNumPixels = 0;            /**< The number of pixels painted in the last frame. */
+        int64 totalNumPixels = 0;           /**< The number of pixels painted in all the frames. */
+        double lastPaintSeconds = 0.0;      /**< How long the last frame took to paint, including copying it to the window. */
+        double maxPaintSeconds = 0.0;       /**< The longest time that any frame took to paint. */
+        double totalPaintSeconds = 0.0;     /**< The time taken to paint all the frames. */
+
+        /** Returns the average time that a frame took to paint. */
+        double getAveragePaintSeconds() const noexcept
+        {
+            return numFramesPainted > 0 ? totalPaintSeconds / (double) numFramesPainted : 0.0;
+        }
+    };
+
+    /** Returns statistics about the frames that this peer has repainted since it was created,
+        or since resetRepaintStatistics() was called.
+
+        Only some platforms keep these statistics - currently just Linux. On others, this
+        returns an empty object.
+    */
+    virtual RepaintStatistics getRepaintStatistics() const      { return {}; }
+
+    /** Resets the statistics returned by getRepaintStatistics(). */
+    virtual void resetRepaintStatistics() {}
+
     /** Changes the window's transparency. */
     virtual void setAlpha (float newAlpha) = 0;
 
@@ -572,14 +572,14 @@ struct ShaderPrograms final : public ReferenceCountedObject
     #define JUCE_DECLARE_LINEAR_UNIFORMS  "uniform sampler2D gradientTexture;" \
                                           "uniform " JUCE_MEDIUMP " vec4 gradientInfo;" \
                                           JUCE_DECLARE_VARYING_COLOUR JUCE_DECLARE_VARYING_PIXELPOS
-    #define JUCE_DITHER \
-        JUCE_MEDIUMP " float dither = (mod(3.1415 * pixelPos.x + 2.71828 * pixelPos.y, 8.0)-4.0)/1400.0;"
-
-    #define JUCE_CALC_LINEAR_GRAD_POS1 \
-        JUCE_DITHER \
+    #define JUCE_DITHER \
+        JUCE_MEDIUMP " float dither = (mod(3.1415 * pixelPos.x + 2.71828 * pixelPos.y, 8.0)-4.0)/1400.0;"
+
+    #define JUCE_CALC_LINEAR_GRAD_POS1 \
+        JUCE_DITHER \
         JUCE_MEDIUMP " float gradientPos = (pixelPos.y - (gradientInfo.y + (gradientInfo.z * (pixelPos.x - gradientInfo.x)))) / gradientInfo.w;"
-    #define JUCE_CALC_LINEAR_GRAD_POS2 \
-        JUCE_DITHER \
+    #define JUCE_CALC_LINEAR_GRAD_POS2 \
+        JUCE_DITHER \
         JUCE_MEDIUMP " float gradientPos = (pixelPos.x - (gradientInfo.x + (gradientInfo.z * (pixelPos.y - gradientInfo.y)))) / gradientInfo.w;"
 
     struct LinearGradient1Program final : public ShaderBase
@@ -1795,7 +1795,12 @@ struct SavedState final : public RenderingHelpers::SavedStateBase<SavedState>
                 auto t = transform.getTransformWith (AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight)
                                                                      .followedBy (trans));
 
-                const std::unique_ptr<EdgeTable> et (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
+                std::unique_ptr<EdgeTable> et;
+
+                {
+                    const ScopedLock sl (RenderingHelpers::getGlyphGenerationLock());
+                    et.reset (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
+                }
 
                 if (et != nullptr)
                     fillShape (*new EdgeTableRegionType (*et), false);